@@ -0,0 +1,12 @@
+# Copyright (c) 2023 The Orbit Authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+
+# Google Benchmark is optional. Benchmark targets are only defined when it is
+# found, and they are not registered with ctest: run them manually, e.g.,
+# `LinuxTracingBenchmarks --benchmark_filter=PerfEventQueue`.
+find_package(benchmark CONFIG)
+
+if(NOT benchmark_FOUND)
+  message(STATUS "Google Benchmark not found, benchmark targets will not be built.")
+endif()
@@ -52,6 +52,7 @@ class OrbitConan(ConanFile):
         self.build_requires('grpc/1.48.0')
         self.build_requires('protobuf/3.21.4')
         self.build_requires('gtest/1.11.0', force_host_context=True)
+        self.build_requires('benchmark/1.7.1', force_host_context=True)
 
     def requirements(self):
         if self.options.with_system_deps: return
@@ -4,10 +4,20 @@
 
 #include "LockFreeApiEventProducer.h"
 
+#include <string>
+#include <utility>
 #include <variant>
 
+#include "OrbitBase/Logging.h"
+
 namespace orbit_api {
 
+void LockFreeApiEventProducer::OnCaptureStart(orbit_grpc_protos::CaptureOptions capture_options) {
+  // This happens before the superclass lets the forwarder thread send events of the new capture.
+  ++capture_count_;
+  LockFreeBufferCaptureEventProducer::OnCaptureStart(std::move(capture_options));
+}
+
 orbit_grpc_protos::ProducerCaptureEvent* LockFreeApiEventProducer::TranslateIntermediateEvent(
     ApiEventVariant&& raw_api_event, google::protobuf::Arena* arena) {
   auto* capture_event =
@@ -22,4 +32,33 @@ orbit_grpc_protos::ProducerCaptureEvent* LockFreeApiEventProducer::TranslateInte
   return capture_event;
 }
 
-}  // namespace orbit_api
\ No newline at end of file
+void LockFreeApiEventProducer::AddEventsRequiredByIntermediateEvent(
+    const ApiEventVariant& raw_api_event, google::protobuf::Arena* arena,
+    google::protobuf::RepeatedPtrField<orbit_grpc_protos::ProducerCaptureEvent>* capture_events) {
+  uint64_t name_key = 0;
+  if (const auto* scope_start = std::get_if<ApiInternedScopeStart>(&raw_api_event)) {
+    name_key = scope_start->name_key;
+  } else if (const auto* scope_start_async =
+                 std::get_if<ApiInternedScopeStartAsync>(&raw_api_event)) {
+    name_key = scope_start_async->name_key;
+  } else {
+    return;
+  }
+
+  if (const uint64_t capture_count = capture_count_; capture_count != capture_count_of_sent_keys_) {
+    keys_sent_in_current_capture_.clear();
+    capture_count_of_sent_keys_ = capture_count;
+  }
+  if (!keys_sent_in_current_capture_.insert(name_key).second) return;
+
+  const std::string* name = string_interner_.GetString(name_key);
+  ORBIT_CHECK(name != nullptr);
+  auto* capture_event =
+      google::protobuf::Arena::CreateMessage<orbit_grpc_protos::ProducerCaptureEvent>(arena);
+  orbit_grpc_protos::InternedString* interned_string = capture_event->mutable_interned_string();
+  interned_string->set_key(name_key);
+  interned_string->set_intern(*name);
+  capture_events->AddAllocated(capture_event);
+}
+
+}  // namespace orbit_api
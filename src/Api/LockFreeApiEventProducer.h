@@ -5,11 +5,15 @@
 #ifndef API_LOCK_FREE_API_EVENT_PRODUCER_H_
 #define API_LOCK_FREE_API_EVENT_PRODUCER_H_
 
+#include <absl/container/flat_hash_set.h>
 #include <google/protobuf/arena.h>
 
+#include <atomic>
+#include <cstdint>
 #include <utility>
 #include <variant>
 
+#include "ApiUtils/ApiStringInterner.h"
 #include "ApiUtils/Event.h"
 #include "CaptureEventProducer/LockFreeBufferCaptureEventProducer.h"
 #include "GrpcProtos/capture.pb.h"
@@ -19,18 +23,45 @@ namespace orbit_api {
 
 // This class is used to enqueue orbit_api::ApiEvent events from multiple threads and relay them to
 // OrbitService in the form of orbit_grpc_protos::ApiEvent events.
+//
+// Scope names can be interned with GetStringInterner(), in which case ApiInternedScopeStart(Async)
+// events only carry the key of the name. The InternedString for a key is sent right before the
+// first event of each capture that refers to it.
 class LockFreeApiEventProducer
     : public orbit_capture_event_producer::LockFreeBufferCaptureEventProducer<ApiEventVariant> {
  public:
-  LockFreeApiEventProducer() {
+  // Events are buffered per thread, as many threads can be emitting scopes at a high rate. Waiting
+  // for space instead of dropping events guarantees that no start or stop of a scope is lost.
+  LockFreeApiEventProducer()
+      : LockFreeBufferCaptureEventProducer{
+            orbit_capture_event_producer::PerThreadRingBufferOptions{}} {
     BuildAndStart(orbit_producer_side_channel::CreateProducerSideChannel());
   }
 
   ~LockFreeApiEventProducer() override { ShutdownAndWait(); }
 
+  [[nodiscard]] ApiStringInterner* GetStringInterner() { return &string_interner_; }
+
  protected:
+  void OnCaptureStart(orbit_grpc_protos::CaptureOptions capture_options) override;
+
   [[nodiscard]] orbit_grpc_protos::ProducerCaptureEvent* TranslateIntermediateEvent(
       ApiEventVariant&& raw_api_event, google::protobuf::Arena* arena) override;
+
+  void AddEventsRequiredByIntermediateEvent(
+      const ApiEventVariant& raw_api_event, google::protobuf::Arena* arena,
+      google::protobuf::RepeatedPtrField<orbit_grpc_protos::ProducerCaptureEvent>* capture_events)
+      override;
+
+ private:
+  ApiStringInterner string_interner_;
+
+  // Incremented at the start of every capture, so that the forwarder thread knows when to send the
+  // InternedStrings again.
+  std::atomic<uint64_t> capture_count_ = 0;
+  // Only accessed by the forwarder thread.
+  uint64_t capture_count_of_sent_keys_ = 0;
+  absl::flat_hash_set<uint64_t> keys_sent_in_current_capture_;
 };
 
 }  // namespace orbit_api
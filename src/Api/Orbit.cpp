@@ -5,9 +5,11 @@
 #include "ApiInterface/Orbit.h"
 
 #include <absl/base/casts.h>
+#include <absl/container/flat_hash_map.h>
 
 #include <utility>
 
+#include "ApiUtils/ApiStringInterner.h"
 #include "ApiUtils/Event.h"
 #include "LockFreeApiEventProducer.h"
 #include "OrbitApiVersions.h"
@@ -38,17 +40,43 @@ void EnqueueApiEvent(Types... args) {
   producer.EnqueueIntermediateEvent(event);
 }
 
+// Returns the key of the scope name `name`, so that scope events don't need to encode the name.
+// Names are usually string literals, so the keys are cached per thread by the address of the name
+// alone, which keeps the common case free of any string comparison. Only names seen for the first
+// time on a thread are compared with the interned strings. As documented in Orbit.h, a buffer that
+// is reused for a different name hence keeps the first name.
+uint64_t InternScopeName(const char* name) {
+  // Unlike for orbit_api_async_string, the event can't simply be dropped, as the matching stop
+  // event would then close the wrong scope. Use an empty name instead.
+  if (name == nullptr) name = "";
+
+  thread_local absl::flat_hash_map<const char*, uint64_t> cached_key_by_name_address;
+
+  auto [it, inserted] = cached_key_by_name_address.try_emplace(name, 0);
+  if (inserted) {
+    it->second = GetCaptureEventProducer().GetStringInterner()->GetOrAssignKey(name).key;
+  }
+  return it->second;
+}
+
+template <typename Event, typename... Types>
+void EnqueueApiScopeStartEvent(const char* name, Types... args) {
+  if (!GetCaptureEventProducer().IsCapturing()) return;
+  EnqueueApiEvent<Event>(InternScopeName(name), args...);
+}
+
 void orbit_api_start_v1(const char* name, orbit_api_color color, uint64_t group_id,
                         uint64_t caller_address) {
   if (caller_address == kOrbitCallerAddressAuto) {
     caller_address = ORBIT_GET_CALLER_PC();
   }
-  EnqueueApiEvent<orbit_api::ApiScopeStart>(name, color, group_id, caller_address);
+  EnqueueApiScopeStartEvent<orbit_api::ApiInternedScopeStart>(name, color, group_id,
+                                                              caller_address);
 }
 
 [[deprecated]] void orbit_api_start(const char* name, orbit_api_color color) {
   uint64_t return_address = ORBIT_GET_CALLER_PC();
-  EnqueueApiEvent<orbit_api::ApiScopeStart>(
+  EnqueueApiScopeStartEvent<orbit_api::ApiInternedScopeStart>(
       name, color, static_cast<uint64_t>(kOrbitDefaultGroupId), return_address);
 }
 
@@ -59,12 +87,12 @@ void orbit_api_start_async_v1(const char* name, uint64_t id, orbit_api_color col
   if (caller_address == kOrbitCallerAddressAuto) {
     caller_address = ORBIT_GET_CALLER_PC();
   }
-  EnqueueApiEvent<orbit_api::ApiScopeStartAsync>(name, id, color, caller_address);
+  EnqueueApiScopeStartEvent<orbit_api::ApiInternedScopeStartAsync>(name, id, color, caller_address);
 }
 
 [[deprecated]] void orbit_api_start_async(const char* name, uint64_t id, orbit_api_color color) {
   uint64_t return_address = ORBIT_GET_CALLER_PC();
-  EnqueueApiEvent<orbit_api::ApiScopeStartAsync>(name, id, color, return_address);
+  EnqueueApiScopeStartEvent<orbit_api::ApiInternedScopeStartAsync>(name, id, color, return_address);
 }
 
 void orbit_api_stop_async(uint64_t id) { EnqueueApiEvent<orbit_api::ApiScopeStopAsync>(id); }
@@ -76,6 +76,8 @@
 //
 // Parameters:
 // name: [const char*] Label to be displayed on current time slice.
+//       Names are identified by their address. Don't reuse a buffer for a different name, as the
+//       first name stored at an address is displayed for all time slices using that address.
 // col: [orbit_api_color] User-defined color for the current time slice (see orbit_api_color below).
 // group_id: [uint64_t] User-defined non-zero id that associates the current time slice with all the
 //           other time slices with the same id.
@@ -114,6 +116,8 @@
 //
 // Parameters of ORBIT_START:
 // name: [const char*] Label to be displayed on the current time slice.
+//       Names are identified by their address. Don't reuse a buffer for a different name, as the
+//       first name stored at an address is displayed for all time slices using that address.
 // col: [orbit_api_color] User-defined color for the current time slice (see orbit_api_color below).
 // group_id: [uint64_t] User-defined non-zero id that associates the current time slice with all the
 //           other time slices with the same id.
@@ -140,6 +144,8 @@
 //
 // Parameters of ORBIT_START_ASYNC:
 // name: [const char*] Name of the *track* that will display the async events in Orbit.
+//       Names are identified by their address. Don't reuse a buffer for a different name, as the
+//       first name stored at an address is displayed for all time slices using that address.
 // id: [uint64_t] User-provided globally *unique* id for the time slice. This id is used to match
 //     the ORBIT_START_ASYNC and ORBIT_STOP_ASYNC calls. An id needs to be unique across all tracks.
 // col: [orbit_api_color] User-defined color for the current time slice (see orbit_api_color below).
@@ -0,0 +1,27 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ApiUtils/ApiStringInterner.h"
+
+namespace orbit_api {
+
+ApiStringInterner::InternedString ApiStringInterner::GetOrAssignKey(const char* str) {
+  absl::MutexLock lock{&mutex_};
+  if (auto it = key_by_string_.find(std::string_view{str}); it != key_by_string_.end()) {
+    return {it->second, &strings_[it->second - 1]};
+  }
+
+  const std::string& interned_str = strings_.emplace_back(str);
+  const uint64_t key = strings_.size();
+  key_by_string_.emplace(interned_str, key);
+  return {key, &interned_str};
+}
+
+const std::string* ApiStringInterner::GetString(uint64_t key) const {
+  absl::MutexLock lock{&mutex_};
+  if (key == 0 || key > strings_.size()) return nullptr;
+  return &strings_[key - 1];
+}
+
+}  // namespace orbit_api
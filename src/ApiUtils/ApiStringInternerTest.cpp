@@ -0,0 +1,42 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "ApiUtils/ApiStringInterner.h"
+
+namespace orbit_api {
+
+TEST(ApiStringInterner, AssignsOneKeyPerDistinctString) {
+  ApiStringInterner interner;
+
+  ApiStringInterner::InternedString first = interner.GetOrAssignKey("first");
+  ApiStringInterner::InternedString second = interner.GetOrAssignKey("second");
+  EXPECT_NE(first.key, 0);
+  EXPECT_NE(second.key, 0);
+  EXPECT_NE(first.key, second.key);
+  EXPECT_EQ(*first.str, "first");
+  EXPECT_EQ(*second.str, "second");
+
+  // The key only depends on the content of the string, not on its address.
+  std::string first_copy{"first"};
+  ApiStringInterner::InternedString first_again = interner.GetOrAssignKey(first_copy.c_str());
+  EXPECT_EQ(first_again.key, first.key);
+  EXPECT_EQ(first_again.str, first.str);
+}
+
+TEST(ApiStringInterner, GetString) {
+  ApiStringInterner interner;
+  EXPECT_EQ(interner.GetString(0), nullptr);
+  EXPECT_EQ(interner.GetString(1), nullptr);
+
+  const uint64_t key = interner.GetOrAssignKey("name").key;
+  ASSERT_NE(interner.GetString(key), nullptr);
+  EXPECT_EQ(*interner.GetString(key), "name");
+  EXPECT_EQ(interner.GetString(key + 1), nullptr);
+}
+
+}  // namespace orbit_api
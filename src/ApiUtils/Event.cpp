@@ -41,6 +41,14 @@ void ApiScopeStart::CopyToGrpcProto(orbit_grpc_protos::ApiScopeStart* grpc_proto
   grpc_proto->set_address_in_function(address_in_function);
 }
 
+void ApiInternedScopeStart::CopyToGrpcProto(orbit_grpc_protos::ApiScopeStart* grpc_proto) const {
+  SetMetaData(meta_data, grpc_proto);
+  grpc_proto->set_name_key(name_key);
+  grpc_proto->set_color_rgba(color_rgba);
+  grpc_proto->set_group_id(group_id);
+  grpc_proto->set_address_in_function(address_in_function);
+}
+
 void ApiScopeStop::CopyToGrpcProto(orbit_grpc_protos::ApiScopeStop* grpc_proto) const {
   SetMetaData(meta_data, grpc_proto);
 }
@@ -53,6 +61,15 @@ void ApiScopeStartAsync::CopyToGrpcProto(orbit_grpc_protos::ApiScopeStartAsync*
   grpc_proto->set_address_in_function(address_in_function);
 }
 
+void ApiInternedScopeStartAsync::CopyToGrpcProto(
+    orbit_grpc_protos::ApiScopeStartAsync* grpc_proto) const {
+  SetMetaData(meta_data, grpc_proto);
+  grpc_proto->set_name_key(name_key);
+  grpc_proto->set_color_rgba(color_rgba);
+  grpc_proto->set_id(id);
+  grpc_proto->set_address_in_function(address_in_function);
+}
+
 void ApiScopeStopAsync::CopyToGrpcProto(orbit_grpc_protos::ApiScopeStopAsync* grpc_proto) const {
   SetMetaData(meta_data, grpc_proto);
   grpc_proto->set_id(id);
@@ -113,6 +130,12 @@ void FillProducerCaptureEventFromApiEvent(const ApiScopeStart& scope_start,
   scope_start.CopyToGrpcProto(api_event);
 }
 
+void FillProducerCaptureEventFromApiEvent(const ApiInternedScopeStart& interned_scope_start,
+                                          orbit_grpc_protos::ProducerCaptureEvent* capture_event) {
+  auto* api_event = capture_event->mutable_api_scope_start();
+  interned_scope_start.CopyToGrpcProto(api_event);
+}
+
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStop& scope_stop,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event) {
   auto* api_event = capture_event->mutable_api_scope_stop();
@@ -125,6 +148,13 @@ void FillProducerCaptureEventFromApiEvent(const ApiScopeStartAsync& scope_start_
   scope_start_async.CopyToGrpcProto(api_event);
 }
 
+void FillProducerCaptureEventFromApiEvent(
+    const ApiInternedScopeStartAsync& interned_scope_start_async,
+    orbit_grpc_protos::ProducerCaptureEvent* capture_event) {
+  auto* api_event = capture_event->mutable_api_scope_start_async();
+  interned_scope_start_async.CopyToGrpcProto(api_event);
+}
+
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStopAsync& scope_stop_async,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event) {
   auto* api_event = capture_event->mutable_api_scope_stop_async();
@@ -0,0 +1,45 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_API_UTILS_API_STRING_INTERNER_H_
+#define ORBIT_API_UTILS_API_STRING_INTERNER_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+
+namespace orbit_api {
+
+// Assigns keys to the names passed to the Orbit API, so that the producer can send each name once
+// as an InternedString and then only refer to it by its key. Keys start at 1, as 0 stands for "no
+// key" in orbit_grpc_protos::ApiScopeStart::name_key. This class is thread-safe.
+class ApiStringInterner {
+ public:
+  struct InternedString {
+    uint64_t key;
+    // The interned copy of the string, which stays valid as long as the ApiStringInterner.
+    const std::string* str;
+  };
+
+  // Returns the key of `str`, which is assigned when `str` is interned for the first time.
+  [[nodiscard]] InternedString GetOrAssignKey(const char* str);
+
+  // Returns the string with key `key`, or nullptr if no string has been assigned this key.
+  [[nodiscard]] const std::string* GetString(uint64_t key) const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  // std::deque doesn't move its elements when growing, so `key_by_string_` can reference them.
+  std::deque<std::string> strings_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<std::string_view, uint64_t> key_by_string_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace orbit_api
+
+#endif  // ORBIT_API_UTILS_API_STRING_INTERNER_H_
@@ -70,6 +70,27 @@ struct ApiScopeStart {
   uint32_t color_rgba = 0;
 };
 
+// Like ApiScopeStart, but for a name that the producer has interned, i.e., that it sends as an
+// InternedString. The event only carries the key of the name, so the name is never encoded.
+struct ApiInternedScopeStart {
+  ApiInternedScopeStart(uint32_t pid, uint32_t tid, uint64_t timestamp_ns, uint64_t name_key,
+                        orbit_api_color color_rgba = kOrbitColorAuto, uint64_t group_id = 0,
+                        uint64_t address_in_function = 0)
+      : meta_data(pid, tid, timestamp_ns),
+        name_key(name_key),
+        group_id(group_id),
+        address_in_function(address_in_function),
+        color_rgba(color_rgba) {}
+
+  void CopyToGrpcProto(orbit_grpc_protos::ApiScopeStart* grpc_proto) const;
+
+  ApiEventMetaData meta_data;
+  uint64_t name_key = 0;
+  uint64_t group_id = 0;
+  uint64_t address_in_function = 0;
+  uint32_t color_rgba = 0;
+};
+
 struct ApiScopeStop {
   ApiScopeStop(uint32_t pid, uint32_t tid, uint64_t timestamp_ns)
       : meta_data(pid, tid, timestamp_ns) {}
@@ -98,6 +119,27 @@ struct ApiScopeStartAsync {
   uint32_t color_rgba = 0;
 };
 
+// Like ApiScopeStartAsync, but for a name that the producer has interned, see
+// ApiInternedScopeStart.
+struct ApiInternedScopeStartAsync {
+  ApiInternedScopeStartAsync(uint32_t pid, uint32_t tid, uint64_t timestamp_ns, uint64_t name_key,
+                             uint64_t id, orbit_api_color color_rgba = kOrbitColorAuto,
+                             uint64_t address_in_function = 0)
+      : meta_data(pid, tid, timestamp_ns),
+        name_key(name_key),
+        id(id),
+        address_in_function(address_in_function),
+        color_rgba(color_rgba) {}
+
+  void CopyToGrpcProto(orbit_grpc_protos::ApiScopeStartAsync* grpc_proto) const;
+
+  ApiEventMetaData meta_data;
+  uint64_t name_key = 0;
+  uint64_t id = 0;
+  uint64_t address_in_function = 0;
+  uint32_t color_rgba = 0;
+};
+
 struct ApiScopeStopAsync {
   ApiScopeStopAsync(uint32_t pid, uint32_t tid, uint64_t timestamp_ns, uint64_t id)
       : meta_data(pid, tid, timestamp_ns), id(id) {}
@@ -202,19 +244,27 @@ struct ApiTrackFloat {
 // Used in `LockFreeApiEventProducer`. The `std::monostate` is required make this variant default
 // constructable. However, real (fully instantiated) values will never be of type `std::monostate`.
 using ApiEventVariant =
-    std::variant<std::monostate, ApiScopeStart, ApiScopeStop, ApiScopeStartAsync, ApiScopeStopAsync,
-                 ApiStringEvent, ApiTrackDouble, ApiTrackFloat, ApiTrackInt, ApiTrackInt64,
-                 ApiTrackUint, ApiTrackUint64>;
+    std::variant<std::monostate, ApiScopeStart, ApiInternedScopeStart, ApiScopeStop,
+                 ApiScopeStartAsync, ApiInternedScopeStartAsync, ApiScopeStopAsync, ApiStringEvent,
+                 ApiTrackDouble, ApiTrackFloat, ApiTrackInt, ApiTrackInt64, ApiTrackUint,
+                 ApiTrackUint64>;
 
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStart& scope_start,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event);
 
+void FillProducerCaptureEventFromApiEvent(const ApiInternedScopeStart& interned_scope_start,
+                                          orbit_grpc_protos::ProducerCaptureEvent* capture_event);
+
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStop& scope_stop,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event);
 
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStartAsync& scope_start_async,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event);
 
+void FillProducerCaptureEventFromApiEvent(
+    const ApiInternedScopeStartAsync& interned_scope_start_async,
+    orbit_grpc_protos::ProducerCaptureEvent* capture_event);
+
 void FillProducerCaptureEventFromApiEvent(const ApiScopeStopAsync& scope_stop_async,
                                           orbit_grpc_protos::ProducerCaptureEvent* capture_event);
 
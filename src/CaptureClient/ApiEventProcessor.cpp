@@ -13,6 +13,7 @@
 #include "ApiUtils/EncodedString.h"
 #include "ClientData/ApiStringEvent.h"
 #include "ClientData/ApiTrackValue.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientProtos/capture_data.pb.h"
 #include "OrbitBase/Logging.h"
 
@@ -20,7 +21,7 @@ namespace orbit_capture_client {
 
 using orbit_client_data::ApiStringEvent;
 using orbit_client_data::ApiTrackValue;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using orbit_grpc_protos::ApiScopeStart;
 using orbit_grpc_protos::ApiScopeStartAsync;
 
@@ -43,10 +44,29 @@ void EncodedColorToColor(uint32_t encoded_color, orbit_client_protos::Color* col
 }
 }  // namespace
 
-ApiEventProcessor::ApiEventProcessor(CaptureListener* listener) : capture_listener_(listener) {
+ApiEventProcessor::ApiEventProcessor(
+    CaptureListener* listener,
+    const absl::flat_hash_map<uint64_t, std::string>* string_intern_pool)
+    : capture_listener_(listener), string_intern_pool_(string_intern_pool) {
   ORBIT_CHECK(listener != nullptr);
 }
 
+template <typename ScopeStart>
+std::string ApiEventProcessor::GetApiScopeName(const ScopeStart& start_event) const {
+  if (start_event.name_key() == 0) return DecodeString(start_event);
+  if (string_intern_pool_ == nullptr) {
+    ORBIT_ERROR("Orbit API scope with name key %u but no string intern pool",
+                start_event.name_key());
+    return "";
+  }
+  auto it = string_intern_pool_->find(start_event.name_key());
+  if (it == string_intern_pool_->end()) {
+    ORBIT_ERROR("Orbit API scope with unknown name key %u", start_event.name_key());
+    return "";
+  }
+  return it->second;
+}
+
 void ApiEventProcessor::ProcessApiScopeStart(
     const orbit_grpc_protos::ApiScopeStart& api_scope_start) {
   synchronous_scopes_stack_by_tid_[api_scope_start.tid()].emplace_back(api_scope_start);
@@ -79,7 +99,7 @@ void ApiEventProcessor::ProcessApiScopeStop(
   timer_info.set_group_id(start_event.group_id());
   timer_info.set_address_in_function(start_event.address_in_function());
 
-  timer_info.set_api_scope_name(DecodeString(start_event));
+  timer_info.set_api_scope_name(GetApiScopeName(start_event));
 
   capture_listener_->OnTimer(timer_info);
   event_stack.pop_back();
@@ -116,7 +136,7 @@ void ApiEventProcessor::ProcessApiScopeStopAsync(
   timer_info.set_api_async_scope_id(event_id);
   timer_info.set_address_in_function(start_event.address_in_function());
 
-  timer_info.set_api_scope_name(DecodeString(start_event));
+  timer_info.set_api_scope_name(GetApiScopeName(start_event));
 
   capture_listener_->OnTimer(timer_info);
   asynchronous_scopes_by_id_.erase(event_id);
@@ -2,8 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/container/flat_hash_map.h>
 #include <gmock/gmock.h>
-#include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
 
 #include <algorithm>
@@ -19,7 +19,7 @@
 #include "ClientData/ApiStringEvent.h"
 #include "ClientData/ApiTrackValue.h"
 #include "ClientData/CallstackInfo.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 #include "MockCaptureListener.h"
 
@@ -29,9 +29,8 @@ using orbit_client_data::ApiStringEvent;
 using orbit_client_data::ApiTrackValue;
 using orbit_client_data::CallstackInfo;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
-using google::protobuf::util::MessageDifferencer;
 using ::testing::AllOf;
 using ::testing::DoubleEq;
 using ::testing::Invoke;
@@ -44,7 +43,7 @@ namespace {
 
 class ApiEventProcessorTest : public ::testing::Test {
  public:
-  ApiEventProcessorTest() : api_event_processor_{&capture_listener_} {}
+  ApiEventProcessorTest() : api_event_processor_{&capture_listener_, &string_intern_pool_} {}
 
  protected:
   void SetUp() override {}
@@ -132,13 +131,13 @@ class ApiEventProcessorTest : public ::testing::Test {
     return result;
   }
 
-  static orbit_client_protos::TimerInfo CreateTimerInfo(uint64_t start, uint64_t end,
-                                                        int32_t process_id, int32_t thread_id,
-                                                        const char* name, uint32_t depth,
-                                                        uint64_t group_id, uint64_t async_scope_id,
-                                                        uint64_t address_in_function,
-                                                        TimerInfo::Type type) {
-    orbit_client_protos::TimerInfo timer;
+  static orbit_client_data::TimerInfo CreateTimerInfo(uint64_t start, uint64_t end,
+                                                      int32_t process_id, int32_t thread_id,
+                                                      const char* name, uint32_t depth,
+                                                      uint64_t group_id, uint64_t async_scope_id,
+                                                      uint64_t address_in_function,
+                                                      TimerInfo::Type type) {
+    orbit_client_data::TimerInfo timer;
     timer.set_start(start);
     timer.set_end(end);
     timer.set_process_id(process_id);
@@ -154,6 +153,7 @@ class ApiEventProcessorTest : public ::testing::Test {
   }
 
   MockCaptureListener capture_listener_;
+  absl::flat_hash_map<uint64_t, std::string> string_intern_pool_;
   ApiEventProcessor api_event_processor_;
 
   static constexpr int32_t kProcessId = 42;
@@ -200,7 +200,7 @@ TEST_F(ApiEventProcessorTest, ScopesFromSameThread) {
 
   ::testing::Mock::VerifyAndClearExpectations(&capture_listener_);
 
-  std::vector<orbit_client_protos::TimerInfo> actual_timers;
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
 
   EXPECT_CALL(capture_listener_, OnTimer)
       .Times(3)
@@ -220,9 +220,9 @@ TEST_F(ApiEventProcessorTest, ScopesFromSameThread) {
 
   ASSERT_THAT(actual_timers.size(), 3);
 
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_2, actual_timers[0]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_1, actual_timers[1]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_0, actual_timers[2]));
+  EXPECT_EQ(expected_timer_2, actual_timers[0]);
+  EXPECT_EQ(expected_timer_1, actual_timers[1]);
+  EXPECT_EQ(expected_timer_0, actual_timers[2]);
 }
 
 TEST_F(ApiEventProcessorTest, ScopesFromDifferentThreads) {
@@ -239,7 +239,7 @@ TEST_F(ApiEventProcessorTest, ScopesFromDifferentThreads) {
 
   ::testing::Mock::VerifyAndClearExpectations(&capture_listener_);
 
-  std::vector<orbit_client_protos::TimerInfo> actual_timers;
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
 
   EXPECT_CALL(capture_listener_, OnTimer)
       .Times(2)
@@ -256,8 +256,63 @@ TEST_F(ApiEventProcessorTest, ScopesFromDifferentThreads) {
 
   ASSERT_THAT(actual_timers.size(), 2);
 
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_0, actual_timers[0]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_1, actual_timers[1]));
+  EXPECT_EQ(expected_timer_0, actual_timers[0]);
+  EXPECT_EQ(expected_timer_1, actual_timers[1]);
+}
+
+TEST_F(ApiEventProcessorTest, ScopesWithInternedNames) {
+  constexpr uint64_t kSyncNameKey = 5;
+  constexpr uint64_t kAsyncNameKey = 6;
+  string_intern_pool_.emplace(kSyncNameKey, "SyncScope");
+  string_intern_pool_.emplace(kAsyncNameKey, "AsyncScope");
+
+  auto start_sync = CreateStartScope("", 1, kProcessId, kThreadId1, kGroupId, kAddressInFunction);
+  start_sync.set_name_key(kSyncNameKey);
+  auto start_async = CreateStartScopeAsync("", 2, kProcessId, kThreadId1, kId1, kAddressInFunction);
+  start_async.set_name_key(kAsyncNameKey);
+  auto stop_sync = CreateStopScope(3, kProcessId, kThreadId1);
+  auto stop_async = CreateStopScopeAsync(4, kProcessId, kThreadId1, kId1);
+
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
+  EXPECT_CALL(capture_listener_, OnTimer)
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&actual_timers](const TimerInfo& timer) { actual_timers.push_back(timer); }));
+
+  api_event_processor_.ProcessApiScopeStart(start_sync);
+  api_event_processor_.ProcessApiScopeStartAsync(start_async);
+  api_event_processor_.ProcessApiScopeStop(stop_sync);
+  api_event_processor_.ProcessApiScopeStopAsync(stop_async);
+
+  ASSERT_THAT(actual_timers.size(), 2);
+  EXPECT_EQ(actual_timers[0].api_scope_name(), "SyncScope");
+  EXPECT_EQ(actual_timers[1].api_scope_name(), "AsyncScope");
+}
+
+TEST_F(ApiEventProcessorTest, ScopesWithUnknownNameKeysGetEmptyNames) {
+  constexpr uint64_t kUnknownNameKey = 7;
+
+  auto start_sync = CreateStartScope("", 1, kProcessId, kThreadId1, kGroupId, kAddressInFunction);
+  start_sync.set_name_key(kUnknownNameKey);
+  auto start_async = CreateStartScopeAsync("", 2, kProcessId, kThreadId1, kId1, kAddressInFunction);
+  start_async.set_name_key(kUnknownNameKey);
+  auto stop_sync = CreateStopScope(3, kProcessId, kThreadId1);
+  auto stop_async = CreateStopScopeAsync(4, kProcessId, kThreadId1, kId1);
+
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
+  EXPECT_CALL(capture_listener_, OnTimer)
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&actual_timers](const TimerInfo& timer) { actual_timers.push_back(timer); }));
+
+  api_event_processor_.ProcessApiScopeStart(start_sync);
+  api_event_processor_.ProcessApiScopeStartAsync(start_async);
+  api_event_processor_.ProcessApiScopeStop(stop_sync);
+  api_event_processor_.ProcessApiScopeStopAsync(stop_async);
+
+  ASSERT_THAT(actual_timers.size(), 2);
+  EXPECT_EQ(actual_timers[0].api_scope_name(), "");
+  EXPECT_EQ(actual_timers[1].api_scope_name(), "");
 }
 
 TEST_F(ApiEventProcessorTest, AsyncScopes) {
@@ -278,7 +333,7 @@ TEST_F(ApiEventProcessorTest, AsyncScopes) {
 
   ::testing::Mock::VerifyAndClearExpectations(&capture_listener_);
 
-  std::vector<orbit_client_protos::TimerInfo> actual_timers;
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
 
   EXPECT_CALL(capture_listener_, OnTimer)
       .Times(3)
@@ -298,9 +353,9 @@ TEST_F(ApiEventProcessorTest, AsyncScopes) {
 
   ASSERT_THAT(actual_timers.size(), 3);
 
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_2, actual_timers[0]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_1, actual_timers[1]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_timer_0, actual_timers[2]));
+  EXPECT_EQ(expected_timer_2, actual_timers[0]);
+  EXPECT_EQ(expected_timer_1, actual_timers[1]);
+  EXPECT_EQ(expected_timer_0, actual_timers[2]);
 }
 
 TEST_F(ApiEventProcessorTest, AsyncScopesOverwrittenStartAndRepeatedStop) {
@@ -311,7 +366,7 @@ TEST_F(ApiEventProcessorTest, AsyncScopesOverwrittenStartAndRepeatedStop) {
   auto stop0 = CreateStopScopeAsync(3, kProcessId, kThreadId1, kId1);
   auto stop1 = CreateStopScopeAsync(4, kProcessId, kThreadId1, kId1);
 
-  orbit_client_protos::TimerInfo actual_timer;
+  orbit_client_data::TimerInfo actual_timer;
   EXPECT_CALL(capture_listener_, OnTimer)
       .Times(1)
       .WillRepeatedly(Invoke([&actual_timer](const TimerInfo& timer) { actual_timer = timer; }));
@@ -321,9 +376,8 @@ TEST_F(ApiEventProcessorTest, AsyncScopesOverwrittenStartAndRepeatedStop) {
   api_event_processor_.ProcessApiScopeStopAsync(stop0);
   api_event_processor_.ProcessApiScopeStopAsync(stop1);
 
-  EXPECT_TRUE(MessageDifferencer::Equivalent(
-      actual_timer, CreateTimerInfo(2, 3, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kId1,
-                                    kAddressInFunction, TimerInfo::kApiScopeAsync)));
+  EXPECT_EQ(actual_timer, CreateTimerInfo(2, 3, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kId1,
+                                          kAddressInFunction, TimerInfo::kApiScopeAsync));
 }
 
 TEST_F(ApiEventProcessorTest, AsyncScopesWithIdsDifferingOnlyInUpperHalf) {
@@ -336,7 +390,7 @@ TEST_F(ApiEventProcessorTest, AsyncScopesWithIdsDifferingOnlyInUpperHalf) {
   auto stop1 = CreateStopScopeAsync(3, kProcessId, kThreadId1, kLongId);
   auto stop0 = CreateStopScopeAsync(4, kProcessId, kThreadId1, kShortId);
 
-  std::vector<orbit_client_protos::TimerInfo> actual_timers;
+  std::vector<orbit_client_data::TimerInfo> actual_timers;
   EXPECT_CALL(capture_listener_, OnTimer)
       .Times(2)
       .WillRepeatedly(
@@ -349,12 +403,12 @@ TEST_F(ApiEventProcessorTest, AsyncScopesWithIdsDifferingOnlyInUpperHalf) {
   api_event_processor_.ProcessApiScopeStopAsync(stop0);
 
   ASSERT_THAT(actual_timers.size(), 2);
-  EXPECT_TRUE(MessageDifferencer::Equivalent(
-      actual_timers[0], CreateTimerInfo(2, 3, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kLongId,
-                                        kAddressInFunction, TimerInfo::kApiScopeAsync)));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(
-      actual_timers[1], CreateTimerInfo(1, 4, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kShortId,
-                                        kAddressInFunction, TimerInfo::kApiScopeAsync)));
+  EXPECT_EQ(actual_timers[0],
+            CreateTimerInfo(2, 3, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kLongId,
+                            kAddressInFunction, TimerInfo::kApiScopeAsync));
+  EXPECT_EQ(actual_timers[1],
+            CreateTimerInfo(1, 4, kProcessId, kThreadId1, "AsyncTrack", 0, 0, kShortId,
+                            kAddressInFunction, TimerInfo::kApiScopeAsync));
 }
 
 TEST_F(ApiEventProcessorTest, StringEvent) {
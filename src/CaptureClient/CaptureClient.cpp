@@ -112,6 +112,11 @@ std::vector<ApiFunction> FindApiFunctions(const orbit_client_data::ModuleManager
   ORBIT_CHECK(options.unwinding_method != CaptureOptions::kUndefined);
   capture_options.set_unwinding_method(options.unwinding_method);
   capture_options.set_stack_dump_size(options.stack_dump_size);
+  capture_options.set_dwarf_unwinding_thread_count(options.dwarf_unwinding_thread_count);
+  capture_options.set_event_driven_ring_buffer_reading(options.event_driven_ring_buffer_reading);
+  capture_options.set_ring_buffer_reader_thread_count(options.ring_buffer_reader_thread_count);
+  capture_options.set_compress_capture_responses(options.compress_capture_responses);
+  capture_options.set_intern_callstacks(options.intern_callstacks);
   capture_options.set_thread_state_change_callstack_stack_dump_size(
       options.thread_state_change_callstack_stack_dump_size);
   capture_options.set_samples_per_second(options.samples_per_second);
@@ -27,9 +27,9 @@
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
@@ -43,7 +43,7 @@ using orbit_client_data::LinuxAddressInfo;
 using orbit_client_data::ThreadStateSliceInfo;
 using orbit_client_data::TracepointInfo;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_grpc_protos::AddressInfo;
 using orbit_grpc_protos::Callstack;
@@ -67,7 +67,7 @@ class CaptureEventProcessorForListener : public CaptureEventProcessor {
       : file_path_{std::move(file_path)},
         frame_track_function_ids_(std::move(frame_track_function_ids)),
         capture_listener_(capture_listener),
-        api_event_processor_{capture_listener} {}
+        api_event_processor_{capture_listener, &string_intern_pool_} {}
   ~CaptureEventProcessorForListener() override = default;
 
   void ProcessEvent(const orbit_grpc_protos::ClientCaptureEvent& event) override;
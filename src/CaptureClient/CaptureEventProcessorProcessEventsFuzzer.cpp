@@ -24,9 +24,9 @@
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "FuzzingUtils/ProtoFuzzer.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
@@ -37,7 +37,7 @@ namespace orbit_capture_client {
 using orbit_client_data::CallstackEvent;
 using orbit_client_data::CallstackInfo;
 using orbit_client_data::LinuxAddressInfo;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_grpc_protos::CaptureResponse;
 
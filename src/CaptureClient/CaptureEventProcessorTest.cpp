@@ -24,9 +24,9 @@
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
 #include "MockCaptureListener.h"
@@ -42,7 +42,7 @@ using orbit_client_data::SystemMemoryInfo;
 using orbit_client_data::ThreadStateSliceInfo;
 using orbit_client_data::TracepointEventInfo;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_grpc_protos::AddressInfo;
 using orbit_grpc_protos::Callstack;
@@ -11,12 +11,13 @@
 #include <tuple>
 #include <utility>
 
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
 namespace orbit_capture_client {
 
+using orbit_client_data::TimerInfo;
 using orbit_client_protos::Color;
-using orbit_client_protos::TimerInfo;
 
 using orbit_grpc_protos::GpuCommandBuffer;
 using orbit_grpc_protos::GpuJob;
@@ -64,7 +65,7 @@ std::vector<TimerInfo> GpuQueueSubmissionProcessor::ProcessGpuQueueSubmission(
   }
   return result;
 }
-std::vector<orbit_client_protos::TimerInfo> GpuQueueSubmissionProcessor::ProcessGpuJob(
+std::vector<orbit_client_data::TimerInfo> GpuQueueSubmissionProcessor::ProcessGpuJob(
     const GpuJob& gpu_job, const absl::flat_hash_map<uint64_t, std::string>& string_intern_pool,
     const std::function<uint64_t(std::string_view str)>&
         get_string_hash_and_send_to_listener_if_necessary) {
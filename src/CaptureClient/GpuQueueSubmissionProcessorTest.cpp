@@ -4,7 +4,6 @@
 
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
-#include <google/protobuf/util/message_differencer.h>
 #include <gtest/gtest.h>
 
 #include <cstdint>
@@ -13,12 +12,11 @@
 #include <vector>
 
 #include "CaptureClient/GpuQueueSubmissionProcessor.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 
-using google::protobuf::util::MessageDifferencer;
-using orbit_client_protos::TimerInfo;
-using orbit_client_protos::TimerInfo_Type_kGpuCommandBuffer;
+using orbit_client_data::TimerInfo;
 using orbit_grpc_protos::Color;
 using orbit_grpc_protos::GpuCommandBuffer;
 using orbit_grpc_protos::GpuDebugMarker;
@@ -55,11 +53,11 @@ class GpuQueueSubmissionProcessorTest : public ::testing::Test {
     return gpu_job;
   }
 
-  static orbit_client_protos::TimerInfo CreateTimerInfo(
+  static orbit_client_data::TimerInfo CreateTimerInfo(
       uint64_t start, uint64_t end, int32_t process_id, int32_t processor, int32_t thread_id,
       uint64_t timeline_hash, uint64_t user_data_key, uint32_t depth, uint64_t group_id,
-      float alpha, float red, float green, float blue, orbit_client_protos::TimerInfo::Type type) {
-    orbit_client_protos::TimerInfo timer;
+      float alpha, float red, float green, float blue, orbit_client_data::TimerInfo::Type type) {
+    orbit_client_data::TimerInfo timer;
     timer.set_start(start);
     timer.set_end(end);
     timer.set_process_id(process_id);
@@ -154,7 +152,7 @@ TEST_F(GpuQueueSubmissionProcessorTest, DXVKVulkanDebugMarkerEncodesGroupId) {
     return kCommandBufferTextKey;
   };
 
-  std::vector<orbit_client_protos::TimerInfo> actual_timers =
+  std::vector<orbit_client_data::TimerInfo> actual_timers =
       gpu_queue_submission_processor_.ProcessGpuJob(gpu_job, string_intern_pool_,
                                                     get_string_hash_and_send_if_necessary_fake);
 
@@ -178,15 +176,15 @@ TEST_F(GpuQueueSubmissionProcessorTest, DXVKVulkanDebugMarkerEncodesGroupId) {
 
   TimerInfo expected_command_buffer_timer =
       CreateTimerInfo(30, 39, kPid, -1, kTid, kTimelineKey, kCommandBufferTextKey, kDepth, 0, 0.f,
-                      0.f, 0.f, 0.f, TimerInfo_Type_kGpuCommandBuffer);
+                      0.f, 0.f, 0.f, TimerInfo::kGpuCommandBuffer);
 
   TimerInfo expected_debug_marker = CreateTimerInfo(
       31, 38, kPid, -1, kTid, kTimelineKey, kDXVKGpuLabelKey, kGpuDebugMarkerDepth, kDXVKGpuGroupId,
       kGpuDebugMarkerAlpha, kGpuDebugMarkerRed, kGpuDebugMarkerGreen, kGpuDebugMarkerBlue,
-      orbit_client_protos::TimerInfo_Type_kGpuDebugMarker);
+      orbit_client_data::TimerInfo::kGpuDebugMarker);
 
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_command_buffer_timer, actual_timers[0]));
-  EXPECT_TRUE(MessageDifferencer::Equivalent(expected_debug_marker, actual_timers[1]));
+  EXPECT_EQ(expected_command_buffer_timer, actual_timers[0]);
+  EXPECT_EQ(expected_debug_marker, actual_timers[1]);
 }
 
 TEST_F(GpuQueueSubmissionProcessorTest, TryExtractDXVKVulkanGroupIdFromDebugLabel) {
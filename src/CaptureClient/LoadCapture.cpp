@@ -6,58 +6,338 @@
 
 #include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
+#include <absl/types/span.h>
+#include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/stubs/port.h>
+#include <google/protobuf/wire_format_lite.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 #include "CaptureClient/CaptureEventProcessor.h"
+#include "CaptureFile/CaptureEventTimeRange.h"
+#include "CaptureFile/CaptureFile.h"
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+#include "ClientProtos/capture_section_block_index.pb.h"
 #include "ClientProtos/user_defined_capture_info.pb.h"
 #include "GrpcProtos/capture.pb.h"
+#include "Introspection/Introspection.h"
+#include "OrbitBase/Future.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitBase/ThreadPool.h"
 
 namespace orbit_capture_client {
 
-[[nodiscard]] ErrorMessageOr<CaptureListener::CaptureOutcome> LoadCapture(
-    CaptureListener* listener, orbit_capture_file::CaptureFile* capture_file,
+namespace {
+
+using orbit_capture_file::CaptureEventTimeRange;
+using orbit_grpc_protos::ClientCaptureEvent;
+
+// Number of consecutive messages of the capture section that a single task parses.
+constexpr size_t kMessagesPerBatch = 1024;
+// Maximum number of batches that have been scheduled but not yet processed. This bounds the memory
+// used by parsed events that are waiting to be processed in order.
+constexpr size_t kMaxBatchesInFlight = 64;
+
+struct EventBatch {
+  // Only used for block-compressed capture sections: the decompressed block, which `messages`
+  // point into.
+  std::vector<uint8_t> block;
+  std::vector<absl::Span<const uint8_t>> messages;
+  // Only holds the events up to the first message that failed to parse, if any.
+  std::vector<ClientCaptureEvent> events;
+  std::optional<ErrorMessage> parse_error;
+  // The error found by the scanner right after `messages`, if any.
+  std::optional<ErrorMessage> scan_error;
+  orbit_base::Future<void> parsed;
+};
+
+void ParseEventBatch(EventBatch* batch) {
+  batch->events.resize(batch->messages.size());
+  for (size_t i = 0; i < batch->messages.size(); ++i) {
+    ErrorMessageOr<void> parse_result =
+        orbit_capture_file::ProtoSectionMessageScanner::ParseMessage(batch->messages[i],
+                                                                     &batch->events[i]);
+    if (parse_result.has_error()) {
+      batch->events.resize(i);
+      batch->parse_error = std::move(parse_result.error());
+      return;
+    }
+  }
+}
+
+// Returns the type of the serialized event without parsing it. A serialized ClientCaptureEvent only
+// consists of the field of its `event` oneof, whose field number is the value of the EventCase.
+[[nodiscard]] ClientCaptureEvent::EventCase PeekEventCase(absl::Span<const uint8_t> message) {
+  google::protobuf::io::CodedInputStream input{message.data(), static_cast<int>(message.size())};
+  return static_cast<ClientCaptureEvent::EventCase>(
+      google::protobuf::internal::WireFormatLite::GetTagFieldNumber(input.ReadTag()));
+}
+
+[[nodiscard]] bool BlockOverlapsWithTimeRange(
+    const orbit_client_protos::CaptureSectionBlockInfo& block_info,
+    const CaptureEventTimeRange& time_range) {
+  return block_info.max_timestamp_ns() >= time_range.min_timestamp_ns &&
+         block_info.min_timestamp_ns() <= time_range.max_timestamp_ns;
+}
+
+// Returns the timestamp of the CaptureStarted event, which is the first event of every capture.
+ErrorMessageOr<uint64_t> ReadCaptureStartTimestampNs(
+    orbit_capture_file::CaptureFile* capture_file) {
+  auto capture_section_input_stream = capture_file->CreateCaptureSectionInputStream();
+  ClientCaptureEvent event;
+  OUTCOME_TRY(capture_section_input_stream->ReadMessage(&event));
+  if (event.event_case() != ClientCaptureEvent::kCaptureStarted) {
+    return ErrorMessage{"The capture section does not start with a CaptureStarted event"};
+  }
+  return event.capture_started().capture_start_timestamp_ns();
+}
+
+// Reads the capture section by event, through the ProtoSectionInputStream.
+ErrorMessageOr<CaptureListener::CaptureOutcome> ProcessCaptureSectionStream(
+    orbit_capture_file::CaptureFile* capture_file, CaptureEventProcessor* capture_event_processor,
     std::atomic<bool>* capture_loading_cancellation_requested) {
-  {
-    ORBIT_SCOPED_TIMED_LOG("Loading capture from \"%s\"", capture_file->GetFilePath().string());
-    absl::flat_hash_set<uint64_t> frame_track_function_ids;
-
-    std::optional<uint64_t> section_index =
-        capture_file->FindSectionByType(orbit_capture_file::kSectionTypeUserData);
-    if (section_index.has_value()) {
-      orbit_client_protos::UserDefinedCaptureInfo user_defined_capture_info;
-      auto proto_input_stream = capture_file->CreateProtoSectionInputStream(section_index.value());
-      OUTCOME_TRY(proto_input_stream->ReadMessage(&user_defined_capture_info));
-      const auto& loaded_frame_track_function_ids =
-          user_defined_capture_info.frame_tracks_info().frame_track_function_ids();
-      frame_track_function_ids = {loaded_frame_track_function_ids.begin(),
-                                  loaded_frame_track_function_ids.end()};
+  auto capture_section_input_stream = capture_file->CreateCaptureSectionInputStream();
+  while (true) {
+    if (*capture_loading_cancellation_requested) {
+      return CaptureListener::CaptureOutcome::kCancelled;
+    }
+    ClientCaptureEvent event;
+    OUTCOME_TRY(capture_section_input_stream->ReadMessage(&event));
+    capture_event_processor->ProcessEvent(event);
+    if (event.event_case() == ClientCaptureEvent::kCaptureFinished) {
+      return CaptureListener::CaptureOutcome::kComplete;
     }
+  }
+}
 
-    std::unique_ptr<CaptureEventProcessor> capture_event_processor =
-        CaptureEventProcessor::CreateForCaptureListener(listener, capture_file->GetFilePath(),
-                                                        frame_track_function_ids);
+// Processes the events of the batches in the order in which `schedule_next_batch` fills them in, so
+// the CaptureEventProcessor receives the events in the same order as when reading them through the
+// ProtoSectionInputStream. `schedule_next_batch` fills in the batch it gets passed, schedules its
+// parsing, and returns false once there are no more batches. Errors are only reported when the
+// processing reaches them, as anything after the CaptureFinished event is just padding.
+ErrorMessageOr<CaptureListener::CaptureOutcome> ProcessEventBatchesInOrder(
+    const std::function<bool(EventBatch*)>& schedule_next_batch,
+    CaptureEventProcessor* capture_event_processor,
+    std::atomic<bool>* capture_loading_cancellation_requested) {
+  bool all_batches_scheduled = false;
+  // References to the elements of a std::deque stay valid when adding and removing elements at
+  // either end, so the parsing tasks can keep a reference to their batch.
+  std::deque<EventBatch> batches;
 
-    auto capture_section_input_stream = capture_file->CreateCaptureSectionInputStream();
+  auto process_batches = [&]() -> ErrorMessageOr<CaptureListener::CaptureOutcome> {
     while (true) {
+      while (!all_batches_scheduled && batches.size() < kMaxBatchesInFlight) {
+        all_batches_scheduled = !schedule_next_batch(&batches.emplace_back());
+      }
+      if (batches.empty()) {
+        return ErrorMessage{"Unexpected end of section while reading message size"};
+      }
+
+      EventBatch& batch = batches.front();
+      batch.parsed.Wait();
+      for (const ClientCaptureEvent& event : batch.events) {
+        capture_event_processor->ProcessEvent(event);
+        if (event.event_case() == ClientCaptureEvent::kCaptureFinished) {
+          return CaptureListener::CaptureOutcome::kComplete;
+        }
+      }
+      if (batch.parse_error.has_value()) return batch.parse_error.value();
+      if (batch.scan_error.has_value()) return batch.scan_error.value();
+      batches.pop_front();
+
       if (*capture_loading_cancellation_requested) {
         return CaptureListener::CaptureOutcome::kCancelled;
       }
-      orbit_grpc_protos::ClientCaptureEvent event;
-      OUTCOME_TRY(capture_section_input_stream->ReadMessage(&event));
-      capture_event_processor->ProcessEvent(event);
-      if (event.event_case() == orbit_grpc_protos::ClientCaptureEvent::kCaptureFinished) {
-        return CaptureListener::CaptureOutcome::kComplete;
+    }
+  };
+
+  ErrorMessageOr<CaptureListener::CaptureOutcome> outcome = process_batches();
+  // The tasks of the remaining batches reference them, so they need to complete before returning.
+  for (const EventBatch& batch : batches) {
+    batch.parsed.Wait();
+  }
+  return outcome;
+}
+
+// Reads the memory-mapped capture section. The message boundaries are found on this thread, then
+// batches of consecutive messages are parsed in parallel on the default thread pool.
+ErrorMessageOr<CaptureListener::CaptureOutcome> ProcessMappedCaptureSection(
+    absl::Span<const uint8_t> capture_section, CaptureEventProcessor* capture_event_processor,
+    std::atomic<bool>* capture_loading_cancellation_requested) {
+  orbit_capture_file::ProtoSectionMessageScanner scanner{capture_section};
+  orbit_base::ThreadPool* thread_pool = orbit_base::ThreadPool::GetDefaultThreadPool();
+
+  auto scan_and_schedule_batch = [&](EventBatch* batch) {
+    batch->messages.reserve(kMessagesPerBatch);
+    while (batch->messages.size() < kMessagesPerBatch) {
+      if (scanner.IsAtEnd()) {
+        batch->scan_error = ErrorMessage{"Unexpected end of section while reading message size"};
+        break;
+      }
+      ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+      if (message_or_error.has_error()) {
+        batch->scan_error = std::move(message_or_error.error());
+        break;
+      }
+      batch->messages.push_back(message_or_error.value());
+    }
+
+    batch->parsed = thread_pool->Schedule([batch]() {
+      ORBIT_SCOPE("ParseCaptureEventBatch");
+      ParseEventBatch(batch);
+    });
+    return !batch->scan_error.has_value();
+  };
+
+  return ProcessEventBatchesInOrder(scan_and_schedule_batch, capture_event_processor,
+                                    capture_loading_cancellation_requested);
+}
+
+// Reads a block-compressed capture section. Each block is read, decompressed, scanned and parsed by
+// its own task on the default thread pool. If `time_range` is set, blocks that do not overlap with
+// it are skipped if they only contain events filterable by time. Otherwise, only their events that
+// are not filterable by time are parsed.
+ErrorMessageOr<CaptureListener::CaptureOutcome> ProcessCaptureSectionBlocks(
+    orbit_capture_file::CaptureFile* capture_file,
+    absl::Span<const orbit_client_protos::CaptureSectionBlockInfo> block_index,
+    const std::optional<CaptureEventTimeRange>& time_range,
+    CaptureEventProcessor* capture_event_processor,
+    std::atomic<bool>* capture_loading_cancellation_requested) {
+  orbit_base::ThreadPool* thread_pool = orbit_base::ThreadPool::GetDefaultThreadPool();
+  size_t next_block_index = 0;
+
+  auto is_outside_of_time_range = [&time_range](
+                                      const orbit_client_protos::CaptureSectionBlockInfo& block) {
+    return time_range.has_value() && !BlockOverlapsWithTimeRange(block, time_range.value());
+  };
+
+  auto schedule_block = [&](EventBatch* batch) {
+    while (next_block_index < block_index.size() &&
+           is_outside_of_time_range(block_index[next_block_index]) &&
+           block_index[next_block_index].only_events_filterable_by_time()) {
+      ++next_block_index;
+    }
+    // A default-constructed EventBatch is an empty batch that has already been parsed.
+    if (next_block_index == block_index.size()) return false;
+
+    const orbit_client_protos::CaptureSectionBlockInfo* block_info =
+        &block_index[next_block_index++];
+    const bool only_events_not_filterable_by_time = is_outside_of_time_range(*block_info);
+    batch->parsed = thread_pool->Schedule([capture_file, block_info,
+                                           only_events_not_filterable_by_time, batch]() {
+      ORBIT_SCOPE("DecompressAndParseCaptureSectionBlock");
+      ErrorMessageOr<std::vector<uint8_t>> block_or_error =
+          capture_file->ReadCaptureSectionBlock(*block_info);
+      if (block_or_error.has_error()) {
+        batch->scan_error = std::move(block_or_error.error());
+        return;
+      }
+      batch->block = std::move(block_or_error.value());
+
+      batch->messages.reserve(block_info->number_of_events());
+      orbit_capture_file::ProtoSectionMessageScanner scanner{absl::MakeConstSpan(batch->block)};
+      while (!scanner.IsAtEnd()) {
+        ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+        if (message_or_error.has_error()) {
+          batch->scan_error = std::move(message_or_error.error());
+          break;
+        }
+        if (only_events_not_filterable_by_time &&
+            orbit_capture_file::IsCaptureEventFilterableByTime(
+                PeekEventCase(message_or_error.value()))) {
+          continue;
+        }
+        batch->messages.push_back(message_or_error.value());
       }
+      ParseEventBatch(batch);
+    });
+    return next_block_index < block_index.size();
+  };
+
+  return ProcessEventBatchesInOrder(schedule_block, capture_event_processor,
+                                    capture_loading_cancellation_requested);
+}
+
+}  // namespace
+
+[[nodiscard]] ErrorMessageOr<CaptureListener::CaptureOutcome> LoadCapture(
+    CaptureListener* listener, orbit_capture_file::CaptureFile* capture_file,
+    std::atomic<bool>* capture_loading_cancellation_requested,
+    std::optional<CaptureTimeRange> time_range) {
+  ORBIT_SCOPED_TIMED_LOG("Loading capture from \"%s\"", capture_file->GetFilePath().string());
+  absl::flat_hash_set<uint64_t> frame_track_function_ids;
+
+  std::optional<uint64_t> section_index =
+      capture_file->FindSectionByType(orbit_capture_file::kSectionTypeUserData);
+  if (section_index.has_value()) {
+    orbit_client_protos::UserDefinedCaptureInfo user_defined_capture_info;
+    auto proto_input_stream = capture_file->CreateProtoSectionInputStream(section_index.value());
+    OUTCOME_TRY(proto_input_stream->ReadMessage(&user_defined_capture_info));
+    const auto& loaded_frame_track_function_ids =
+        user_defined_capture_info.frame_tracks_info().frame_track_function_ids();
+    frame_track_function_ids = {loaded_frame_track_function_ids.begin(),
+                                loaded_frame_track_function_ids.end()};
+  }
+
+  std::unique_ptr<CaptureEventProcessor> capture_event_processor =
+      CaptureEventProcessor::CreateForCaptureListener(listener, capture_file->GetFilePath(),
+                                                      frame_track_function_ids);
+
+  std::optional<CaptureEventTimeRange> absolute_time_range;
+  if (time_range.has_value()) {
+    ORBIT_CHECK(time_range->start_ns <= time_range->end_ns);
+    OUTCOME_TRY(const uint64_t capture_start_timestamp_ns,
+                ReadCaptureStartTimestampNs(capture_file));
+    constexpr uint64_t kMaxTimestampNs = std::numeric_limits<uint64_t>::max();
+    absolute_time_range = CaptureEventTimeRange{
+        capture_start_timestamp_ns + std::min(time_range->start_ns,
+                                              kMaxTimestampNs - capture_start_timestamp_ns),
+        capture_start_timestamp_ns + std::min(time_range->end_ns,
+                                              kMaxTimestampNs - capture_start_timestamp_ns)};
+    ORBIT_LOG("Only loading the events between %u ns and %u ns after the start of the capture",
+              time_range->start_ns, time_range->end_ns);
+    capture_event_processor = CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+        std::move(capture_event_processor), absolute_time_range->min_timestamp_ns,
+        absolute_time_range->max_timestamp_ns);
+  }
+
+  if (capture_file->IsCaptureSectionBlockCompressed()) {
+    ErrorMessageOr<std::vector<orbit_client_protos::CaptureSectionBlockInfo>> block_index_or_error =
+        capture_file->ReadCaptureSectionBlockIndex();
+    if (block_index_or_error.has_error() || block_index_or_error.value().empty()) {
+      ORBIT_LOG("Reading the capture section sequentially: %s",
+                block_index_or_error.has_error() ? block_index_or_error.error().message()
+                                                 : "The capture section block index is missing");
+      return ProcessCaptureSectionStream(capture_file, capture_event_processor.get(),
+                                         capture_loading_cancellation_requested);
     }
+    return ProcessCaptureSectionBlocks(capture_file, block_index_or_error.value(),
+                                       absolute_time_range, capture_event_processor.get(),
+                                       capture_loading_cancellation_requested);
+  }
+
+  ErrorMessageOr<absl::Span<const uint8_t>> capture_section_or_error =
+      capture_file->MapCaptureSection();
+  if (capture_section_or_error.has_error()) {
+    ORBIT_LOG("Reading the capture section sequentially: %s",
+              capture_section_or_error.error().message());
+    return ProcessCaptureSectionStream(capture_file, capture_event_processor.get(),
+                                       capture_loading_cancellation_requested);
   }
+  return ProcessMappedCaptureSection(capture_section_or_error.value(),
+                                     capture_event_processor.get(),
+                                     capture_loading_cancellation_requested);
 }
 
-}  // namespace orbit_capture_client
\ No newline at end of file
+}  // namespace orbit_capture_client
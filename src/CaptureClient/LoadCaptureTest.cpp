@@ -0,0 +1,86 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CaptureClient/CaptureListener.h"
+#include "CaptureClient/LoadCapture.h"
+#include "CaptureFile/CaptureFile.h"
+#include "GrpcProtos/capture.pb.h"
+#include "MockCaptureListener.h"
+#include "OrbitBase/Result.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
+#include "TestUtils/TemporaryDirectory.h"
+#include "TestUtils/TestUtils.h"
+
+namespace orbit_capture_client {
+
+using orbit_capture_file::CaptureFile;
+using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_producer_event_processor::CaptureFileClientCaptureEventCollector;
+using orbit_test_utils::HasNoError;
+using orbit_test_utils::HasValue;
+using ::testing::AnyNumber;
+
+TEST(LoadCapture, LoadsEachFileOfARotatedCapture) {
+  constexpr uint64_t kSchedulingSliceCount = 10'000;
+
+  auto temporary_dir_or_error = orbit_test_utils::TemporaryDirectory::Create();
+  ASSERT_THAT(temporary_dir_or_error, HasNoError());
+  auto collector_or_error = CaptureFileClientCaptureEventCollector::Create(
+      {.directory = temporary_dir_or_error.value().GetDirectoryPath(),
+       .max_file_size_bytes = 16 * 1024});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+
+  ClientCaptureEvent capture_started;
+  capture_started.mutable_capture_started()->set_process_id(1);
+  collector->AddEvent(std::move(capture_started));
+  for (uint64_t i = 1; i <= kSchedulingSliceCount; ++i) {
+    ClientCaptureEvent scheduling_slice;
+    scheduling_slice.mutable_scheduling_slice()->set_tid(2);
+    scheduling_slice.mutable_scheduling_slice()->set_duration_ns(1);
+    scheduling_slice.mutable_scheduling_slice()->set_out_timestamp_ns(i);
+    collector->AddEvent(std::move(scheduling_slice));
+  }
+  ClientCaptureEvent capture_finished;
+  capture_finished.mutable_capture_finished()->set_status(
+      orbit_grpc_protos::CaptureFinished::kSuccessful);
+  collector->AddEvent(std::move(capture_finished));
+  collector->StopAndWait();
+
+  const std::vector<std::filesystem::path>& file_paths = collector->file_paths();
+  ASSERT_GT(file_paths.size(), 1);
+
+  uint64_t timer_count = 0;
+  for (const std::filesystem::path& file_path : file_paths) {
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(file_path);
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+
+    ::testing::NiceMock<MockCaptureListener> listener;
+    EXPECT_CALL(listener, OnCaptureStarted).Times(1);
+    EXPECT_CALL(listener, OnCaptureFinished).Times(1);
+    EXPECT_CALL(listener, OnTimer).Times(AnyNumber()).WillRepeatedly([&timer_count](auto&&) {
+      ++timer_count;
+    });
+
+    std::atomic<bool> cancellation_requested = false;
+    ErrorMessageOr<CaptureListener::CaptureOutcome> outcome_or_error =
+        LoadCapture(&listener, capture_file_or_error.value().get(), &cancellation_requested);
+    ASSERT_THAT(outcome_or_error, HasValue(CaptureListener::CaptureOutcome::kComplete))
+        << file_path;
+  }
+  EXPECT_EQ(timer_count, kSchedulingSliceCount);
+}
+
+}  // namespace orbit_capture_client
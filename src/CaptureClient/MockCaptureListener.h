@@ -8,6 +8,7 @@
 #include <gmock/gmock.h>
 
 #include "CaptureClient/CaptureListener.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_capture_client {
 
@@ -18,7 +19,7 @@ class MockCaptureListener : public CaptureListener {
                absl::flat_hash_set<uint64_t>),
               (override));
   MOCK_METHOD(void, OnCaptureFinished, (const orbit_grpc_protos::CaptureFinished&), (override));
-  MOCK_METHOD(void, OnTimer, (const orbit_client_protos::TimerInfo&), (override));
+  MOCK_METHOD(void, OnTimer, (const orbit_client_data::TimerInfo&), (override));
   MOCK_METHOD(void, OnCgroupAndProcessMemoryInfo,
               (const orbit_client_data::CgroupAndProcessMemoryInfo&), (override));
   MOCK_METHOD(void, OnPageFaultsInfo, (const orbit_client_data::PageFaultsInfo&), (override));
@@ -0,0 +1,101 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureClient/ShardedTimerProcessor.h"
+
+#include <absl/strings/str_format.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/Profiling.h"
+#include "OrbitBase/ThreadUtils.h"
+
+namespace orbit_capture_client {
+
+using orbit_client_data::TimerInfo;
+
+ShardedTimerProcessor::ShardedTimerProcessor(size_t num_shards, TimerProcessor timer_processor)
+    : timer_processor_{std::move(timer_processor)} {
+  ORBIT_CHECK(num_shards > 0);
+  ORBIT_CHECK(timer_processor_ != nullptr);
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    shards_.push_back(std::make_unique<Shard>());
+  }
+  for (size_t i = 0; i < num_shards; ++i) {
+    Shard* shard = shards_[i].get();
+    shard->thread = std::thread{[this, shard, i] {
+      orbit_base::SetCurrentThreadName(absl::StrFormat("Timers#%u", i).c_str());
+      RunShard(shard);
+    }};
+  }
+}
+
+ShardedTimerProcessor::~ShardedTimerProcessor() {
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    absl::MutexLock lock{&shard->mutex};
+    shard->exit_requested = true;
+  }
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    shard->thread.join();
+  }
+}
+
+void ShardedTimerProcessor::ProcessTimer(TimerInfo timer_info) {
+  Shard& shard = *shards_[timer_info.thread_id() % shards_.size()];
+  absl::MutexLock lock{&shard.mutex};
+  shard.mutex.Await(absl::Condition(
+      +[](std::vector<TimerInfo>* pending_timers) {
+        return pending_timers->size() < kMaxPendingTimersPerShard;
+      },
+      &shard.pending_timers));
+  shard.pending_timers.push_back(std::move(timer_info));
+}
+
+void ShardedTimerProcessor::Flush() {
+  ORBIT_SCOPE_FUNCTION;
+  for (const std::unique_ptr<Shard>& shard : shards_) {
+    absl::MutexLock lock{&shard->mutex};
+    shard->mutex.Await(absl::Condition(
+        +[](Shard* shard) {
+          return shard->pending_timers.empty() && !shard->is_processing;
+        },
+        shard.get()));
+  }
+}
+
+size_t ShardedTimerProcessor::GetDefaultNumberOfShards() {
+  const size_t num_cores = std::thread::hardware_concurrency();
+  return std::clamp<size_t>(num_cores / 2, 1, kMaxNumberOfShards);
+}
+
+void ShardedTimerProcessor::RunShard(Shard* shard) {
+  std::vector<TimerInfo> timers;
+  while (true) {
+    {
+      absl::MutexLock lock{&shard->mutex};
+      shard->is_processing = false;
+      shard->mutex.Await(absl::Condition(
+          +[](Shard* shard) {
+            return !shard->pending_timers.empty() || shard->exit_requested;
+          },
+          shard));
+      // Pending timers are still processed when exiting.
+      if (shard->pending_timers.empty()) return;
+      // Take all the pending timers at once, so that the producer only contends for the lock once
+      // per batch rather than once per timer.
+      timers.clear();
+      std::swap(timers, shard->pending_timers);
+      shard->is_processing = true;
+    }
+
+    for (const TimerInfo& timer_info : timers) {
+      timer_processor_(timer_info);
+    }
+  }
+}
+
+}  // namespace orbit_capture_client
@@ -0,0 +1,135 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <thread>
+#include <vector>
+
+#include "CaptureClient/ShardedTimerProcessor.h"
+#include "ClientData/TimerInfo.h"
+
+namespace orbit_capture_client {
+
+using orbit_client_data::TimerInfo;
+
+namespace {
+
+[[nodiscard]] TimerInfo CreateTimer(uint32_t thread_id, uint64_t start_ns) {
+  TimerInfo timer_info;
+  timer_info.set_thread_id(thread_id);
+  timer_info.set_start(start_ns);
+  timer_info.set_end(start_ns + 1);
+  return timer_info;
+}
+
+// Records the start timestamps of the processed timers of each thread.
+class TimerRecorder {
+ public:
+  void Record(const TimerInfo& timer_info) {
+    absl::MutexLock lock{&mutex_};
+    thread_id_to_starts_[timer_info.thread_id()].push_back(timer_info.start());
+    processing_thread_ids_[timer_info.thread_id()].push_back(std::this_thread::get_id());
+  }
+
+  [[nodiscard]] absl::flat_hash_map<uint32_t, std::vector<uint64_t>> GetStarts() const {
+    absl::MutexLock lock{&mutex_};
+    return thread_id_to_starts_;
+  }
+
+  [[nodiscard]] absl::flat_hash_map<uint32_t, std::vector<std::thread::id>>
+  GetProcessingThreadIds() const {
+    absl::MutexLock lock{&mutex_};
+    return processing_thread_ids_;
+  }
+
+ private:
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<uint32_t, std::vector<uint64_t>> thread_id_to_starts_
+      ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<uint32_t, std::vector<std::thread::id>> processing_thread_ids_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+constexpr uint32_t kNumThreadIds = 13;
+constexpr uint64_t kNumTimersPerThreadId = 10'000;
+
+}  // namespace
+
+TEST(ShardedTimerProcessor, ProcessesTheTimersOfEachThreadInOrderOnASingleShard) {
+  TimerRecorder recorder;
+  ShardedTimerProcessor processor{
+      4, [&recorder](const TimerInfo& timer_info) { recorder.Record(timer_info); }};
+  EXPECT_EQ(processor.GetNumberOfShards(), 4);
+
+  for (uint64_t start_ns = 0; start_ns < kNumTimersPerThreadId; ++start_ns) {
+    for (uint32_t thread_id = 0; thread_id < kNumThreadIds; ++thread_id) {
+      processor.ProcessTimer(CreateTimer(thread_id, start_ns));
+    }
+  }
+  processor.Flush();
+
+  const absl::flat_hash_map<uint32_t, std::vector<uint64_t>> starts = recorder.GetStarts();
+  ASSERT_EQ(starts.size(), kNumThreadIds);
+  std::vector<uint64_t> expected_starts;
+  for (uint64_t start_ns = 0; start_ns < kNumTimersPerThreadId; ++start_ns) {
+    expected_starts.push_back(start_ns);
+  }
+  for (const auto& [unused_thread_id, thread_starts] : starts) {
+    EXPECT_EQ(thread_starts, expected_starts);
+  }
+
+  for (const auto& [unused_thread_id, processing_thread_ids] : recorder.GetProcessingThreadIds()) {
+    EXPECT_THAT(processing_thread_ids, testing::Each(processing_thread_ids.front()));
+    EXPECT_NE(processing_thread_ids.front(), std::this_thread::get_id());
+  }
+}
+
+TEST(ShardedTimerProcessor, FlushWaitsForTimersBeingProcessed) {
+  absl::Mutex mutex;
+  bool processing_allowed = false;
+  uint64_t num_processed_timers = 0;
+  ShardedTimerProcessor processor{1, [&](const TimerInfo& /*timer_info*/) {
+                                    absl::MutexLock lock{&mutex};
+                                    mutex.Await(absl::Condition(&processing_allowed));
+                                    ++num_processed_timers;
+                                  }};
+  processor.ProcessTimer(CreateTimer(1, 0));
+  processor.ProcessTimer(CreateTimer(2, 0));
+
+  std::thread unblocking_thread{[&] {
+    absl::MutexLock lock{&mutex};
+    processing_allowed = true;
+  }};
+  processor.Flush();
+  unblocking_thread.join();
+
+  absl::MutexLock lock{&mutex};
+  EXPECT_EQ(num_processed_timers, 2);
+}
+
+TEST(ShardedTimerProcessor, DestructorProcessesPendingTimers) {
+  TimerRecorder recorder;
+  {
+    ShardedTimerProcessor processor{
+        2, [&recorder](const TimerInfo& timer_info) { recorder.Record(timer_info); }};
+    for (uint64_t start_ns = 0; start_ns < kNumTimersPerThreadId; ++start_ns) {
+      processor.ProcessTimer(CreateTimer(/*thread_id=*/42, start_ns));
+    }
+  }
+  EXPECT_EQ(recorder.GetStarts().at(42).size(), kNumTimersPerThreadId);
+}
+
+TEST(ShardedTimerProcessor, DefaultNumberOfShardsIsInRange) {
+  EXPECT_GE(ShardedTimerProcessor::GetDefaultNumberOfShards(), 1);
+  EXPECT_LE(ShardedTimerProcessor::GetDefaultNumberOfShards(),
+            ShardedTimerProcessor::kMaxNumberOfShards);
+}
+
+}  // namespace orbit_capture_client
@@ -0,0 +1,176 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
+#include <stdint.h>
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "CaptureClient/CaptureEventProcessor.h"
+#include "CaptureFile/CaptureEventTimeRange.h"
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_capture_client {
+
+namespace {
+
+// Forwards to `event_processor_` all events that are not filterable by time, like interned strings
+// and module snapshots, and the events that are filterable by time only if their time range
+// overlaps with [min_timestamp_ns_, max_timestamp_ns_].
+// The start and the stop of an Orbit API scope are forwarded if the scope, from its start to its
+// stop, overlaps with the range, even when one of the two events lies outside of it. Otherwise, the
+// client would wrongly pair the starts and stops of scopes that cross the boundaries of the range.
+// As whether a scope that starts before the range overlaps with it is only known at its stop, the
+// starts of such scopes are held back until then.
+class TimeRangeFilterEventProcessor : public CaptureEventProcessor {
+ public:
+  explicit TimeRangeFilterEventProcessor(std::unique_ptr<CaptureEventProcessor> event_processor,
+                                         uint64_t min_timestamp_ns, uint64_t max_timestamp_ns)
+      : event_processor_{std::move(event_processor)},
+        min_timestamp_ns_{min_timestamp_ns},
+        max_timestamp_ns_{max_timestamp_ns} {
+    ORBIT_CHECK(event_processor_ != nullptr);
+    ORBIT_CHECK(min_timestamp_ns_ <= max_timestamp_ns_);
+  }
+
+  void ProcessEvent(const orbit_grpc_protos::ClientCaptureEvent& event) override {
+    switch (event.event_case()) {
+      case orbit_grpc_protos::ClientCaptureEvent::kApiScopeStart:
+        ProcessApiScopeStart(event);
+        return;
+      case orbit_grpc_protos::ClientCaptureEvent::kApiScopeStop:
+        ProcessApiScopeStop(event);
+        return;
+      case orbit_grpc_protos::ClientCaptureEvent::kApiScopeStartAsync:
+        ProcessApiScopeStartAsync(event);
+        return;
+      case orbit_grpc_protos::ClientCaptureEvent::kApiScopeStopAsync:
+        ProcessApiScopeStopAsync(event);
+        return;
+      default:
+        break;
+    }
+
+    if (orbit_capture_file::IsCaptureEventFilterableByTime(event.event_case())) {
+      std::optional<orbit_capture_file::CaptureEventTimeRange> time_range =
+          orbit_capture_file::GetCaptureEventTimeRange(event);
+      if (time_range.has_value() && !OverlapsWithTimeRange(time_range->min_timestamp_ns,
+                                                           time_range->max_timestamp_ns)) {
+        return;
+      }
+    }
+    event_processor_->ProcessEvent(event);
+  }
+
+ private:
+  struct OpenScope {
+    orbit_grpc_protos::ClientCaptureEvent start_event;
+    bool forwarded;
+  };
+
+  [[nodiscard]] bool OverlapsWithTimeRange(uint64_t min_timestamp_ns,
+                                           uint64_t max_timestamp_ns) const {
+    return max_timestamp_ns >= min_timestamp_ns_ && min_timestamp_ns <= max_timestamp_ns_;
+  }
+
+  // The scopes of a thread are nested: if a scope overlaps with the range, so do all the scopes
+  // that enclose it, i.e., that are below it on the stack.
+  void ForwardHeldBackStarts(std::vector<OpenScope>* scope_stack) {
+    for (OpenScope& open_scope : *scope_stack) {
+      if (open_scope.forwarded) continue;
+      event_processor_->ProcessEvent(open_scope.start_event);
+      open_scope.forwarded = true;
+    }
+  }
+
+  void ProcessApiScopeStart(const orbit_grpc_protos::ClientCaptureEvent& event) {
+    std::vector<OpenScope>& scope_stack = open_scopes_by_tid_[event.api_scope_start().tid()];
+    scope_stack.push_back({event, false});
+    const uint64_t start_timestamp_ns = event.api_scope_start().timestamp_ns();
+    if (start_timestamp_ns >= min_timestamp_ns_ && start_timestamp_ns <= max_timestamp_ns_) {
+      ForwardHeldBackStarts(&scope_stack);
+    }
+  }
+
+  void ProcessApiScopeStop(const orbit_grpc_protos::ClientCaptureEvent& event) {
+    const uint64_t stop_timestamp_ns = event.api_scope_stop().timestamp_ns();
+    auto scope_stack_it = open_scopes_by_tid_.find(event.api_scope_stop().tid());
+    if (scope_stack_it == open_scopes_by_tid_.end() || scope_stack_it->second.empty()) {
+      // A stop without start, which the client ignores anyway.
+      if (OverlapsWithTimeRange(stop_timestamp_ns, stop_timestamp_ns)) {
+        event_processor_->ProcessEvent(event);
+      }
+      return;
+    }
+
+    std::vector<OpenScope>& scope_stack = scope_stack_it->second;
+    const uint64_t start_timestamp_ns =
+        scope_stack.back().start_event.api_scope_start().timestamp_ns();
+    if (scope_stack.back().forwarded ||
+        OverlapsWithTimeRange(start_timestamp_ns, stop_timestamp_ns)) {
+      ForwardHeldBackStarts(&scope_stack);
+      event_processor_->ProcessEvent(event);
+    }
+    scope_stack.pop_back();
+  }
+
+  void ProcessApiScopeStartAsync(const orbit_grpc_protos::ClientCaptureEvent& event) {
+    const orbit_grpc_protos::ApiScopeStartAsync& start = event.api_scope_start_async();
+    if (start.timestamp_ns() > max_timestamp_ns_) return;
+    if (start.timestamp_ns() >= min_timestamp_ns_) {
+      forwarded_async_scope_ids_.insert(start.id());
+      event_processor_->ProcessEvent(event);
+      return;
+    }
+    held_back_async_scope_starts_by_id_.insert_or_assign(start.id(), event);
+  }
+
+  void ProcessApiScopeStopAsync(const orbit_grpc_protos::ClientCaptureEvent& event) {
+    const orbit_grpc_protos::ApiScopeStopAsync& stop = event.api_scope_stop_async();
+    if (forwarded_async_scope_ids_.erase(stop.id()) > 0) {
+      event_processor_->ProcessEvent(event);
+      return;
+    }
+
+    auto held_back_start_it = held_back_async_scope_starts_by_id_.find(stop.id());
+    if (held_back_start_it == held_back_async_scope_starts_by_id_.end()) {
+      // Either the start was after the range, and so is the stop, or there was no start.
+      if (OverlapsWithTimeRange(stop.timestamp_ns(), stop.timestamp_ns())) {
+        event_processor_->ProcessEvent(event);
+      }
+      return;
+    }
+    // The start is before the range, so the scope overlaps with it if it ends after its start.
+    if (stop.timestamp_ns() >= min_timestamp_ns_) {
+      event_processor_->ProcessEvent(held_back_start_it->second);
+      event_processor_->ProcessEvent(event);
+    }
+    held_back_async_scope_starts_by_id_.erase(held_back_start_it);
+  }
+
+  std::unique_ptr<CaptureEventProcessor> event_processor_;
+  uint64_t min_timestamp_ns_;
+  uint64_t max_timestamp_ns_;
+
+  absl::flat_hash_map<uint32_t, std::vector<OpenScope>> open_scopes_by_tid_;
+  absl::flat_hash_map<uint64_t, orbit_grpc_protos::ClientCaptureEvent>
+      held_back_async_scope_starts_by_id_;
+  absl::flat_hash_set<uint64_t> forwarded_async_scope_ids_;
+};
+
+}  // namespace
+
+std::unique_ptr<CaptureEventProcessor> CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+    std::unique_ptr<CaptureEventProcessor> event_processor, uint64_t min_timestamp_ns,
+    uint64_t max_timestamp_ns) {
+  return std::make_unique<TimeRangeFilterEventProcessor>(std::move(event_processor),
+                                                         min_timestamp_ns, max_timestamp_ns);
+}
+
+}  // namespace orbit_capture_client
@@ -0,0 +1,216 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "CaptureClient/CaptureEventProcessor.h"
+#include "GrpcProtos/capture.pb.h"
+
+namespace orbit_capture_client {
+
+namespace {
+
+using orbit_grpc_protos::ClientCaptureEvent;
+
+class RecordingEventProcessor : public CaptureEventProcessor {
+ public:
+  explicit RecordingEventProcessor(std::vector<ClientCaptureEvent>* events) : events_{events} {}
+
+  void ProcessEvent(const ClientCaptureEvent& event) override { events_->push_back(event); }
+
+ private:
+  std::vector<ClientCaptureEvent>* events_;
+};
+
+ClientCaptureEvent CreateFunctionCallEvent(uint64_t end_timestamp_ns, uint64_t duration_ns) {
+  ClientCaptureEvent event;
+  event.mutable_function_call()->set_end_timestamp_ns(end_timestamp_ns);
+  event.mutable_function_call()->set_duration_ns(duration_ns);
+  return event;
+}
+
+ClientCaptureEvent CreateApiScopeStartEvent(uint64_t timestamp_ns, uint32_t tid = 1) {
+  ClientCaptureEvent event;
+  event.mutable_api_scope_start()->set_tid(tid);
+  event.mutable_api_scope_start()->set_timestamp_ns(timestamp_ns);
+  return event;
+}
+
+ClientCaptureEvent CreateApiScopeStopEvent(uint64_t timestamp_ns, uint32_t tid = 1) {
+  ClientCaptureEvent event;
+  event.mutable_api_scope_stop()->set_tid(tid);
+  event.mutable_api_scope_stop()->set_timestamp_ns(timestamp_ns);
+  return event;
+}
+
+ClientCaptureEvent CreateApiScopeStartAsyncEvent(uint64_t timestamp_ns, uint64_t id) {
+  ClientCaptureEvent event;
+  event.mutable_api_scope_start_async()->set_timestamp_ns(timestamp_ns);
+  event.mutable_api_scope_start_async()->set_id(id);
+  return event;
+}
+
+ClientCaptureEvent CreateApiScopeStopAsyncEvent(uint64_t timestamp_ns, uint64_t id) {
+  ClientCaptureEvent event;
+  event.mutable_api_scope_stop_async()->set_timestamp_ns(timestamp_ns);
+  event.mutable_api_scope_stop_async()->set_id(id);
+  return event;
+}
+
+// Returns the timestamps of the ApiScopeStart and ApiScopeStop events, in the order in which they
+// were processed. Starts are positive, stops negative.
+std::vector<int64_t> GetApiScopeTimestamps(const std::vector<ClientCaptureEvent>& events) {
+  std::vector<int64_t> timestamps;
+  for (const ClientCaptureEvent& event : events) {
+    if (event.has_api_scope_start()) {
+      timestamps.push_back(static_cast<int64_t>(event.api_scope_start().timestamp_ns()));
+    } else if (event.has_api_scope_stop()) {
+      timestamps.push_back(-static_cast<int64_t>(event.api_scope_stop().timestamp_ns()));
+    }
+  }
+  return timestamps;
+}
+
+}  // namespace
+
+TEST(TimeRangeFilterEventProcessor, ForwardsEventsOverlappingWithTimeRange) {
+  std::vector<ClientCaptureEvent> processed_events;
+  std::unique_ptr<CaptureEventProcessor> filter_processor =
+      CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+          std::make_unique<RecordingEventProcessor>(&processed_events), 100, 200);
+
+  // Before, overlapping with the start, inside, overlapping with the end, and after the time range.
+  filter_processor->ProcessEvent(CreateFunctionCallEvent(90, 10));
+  filter_processor->ProcessEvent(CreateFunctionCallEvent(110, 20));
+  filter_processor->ProcessEvent(CreateFunctionCallEvent(150, 10));
+  filter_processor->ProcessEvent(CreateFunctionCallEvent(220, 30));
+  filter_processor->ProcessEvent(CreateFunctionCallEvent(230, 10));
+
+  ClientCaptureEvent callstack_sample;
+  callstack_sample.mutable_callstack_sample()->set_timestamp_ns(300);
+  filter_processor->ProcessEvent(callstack_sample);
+
+  ASSERT_EQ(processed_events.size(), 3);
+  EXPECT_EQ(processed_events[0].function_call().end_timestamp_ns(), 110);
+  EXPECT_EQ(processed_events[1].function_call().end_timestamp_ns(), 150);
+  EXPECT_EQ(processed_events[2].function_call().end_timestamp_ns(), 220);
+}
+
+TEST(TimeRangeFilterEventProcessor, ForwardsEventsNotFilterableByTime) {
+  std::vector<ClientCaptureEvent> processed_events;
+  std::unique_ptr<CaptureEventProcessor> filter_processor =
+      CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+          std::make_unique<RecordingEventProcessor>(&processed_events), 100, 200);
+
+  ClientCaptureEvent capture_started;
+  capture_started.mutable_capture_started()->set_capture_start_timestamp_ns(10);
+  filter_processor->ProcessEvent(capture_started);
+
+  ClientCaptureEvent interned_string;
+  interned_string.mutable_interned_string()->set_key(1);
+  filter_processor->ProcessEvent(interned_string);
+
+  ClientCaptureEvent thread_name;
+  thread_name.mutable_thread_name()->set_timestamp_ns(300);
+  filter_processor->ProcessEvent(thread_name);
+
+  ClientCaptureEvent capture_finished;
+  capture_finished.mutable_capture_finished();
+  filter_processor->ProcessEvent(capture_finished);
+
+  ASSERT_EQ(processed_events.size(), 4);
+  EXPECT_TRUE(processed_events[0].has_capture_started());
+  EXPECT_TRUE(processed_events[1].has_interned_string());
+  EXPECT_TRUE(processed_events[2].has_thread_name());
+  EXPECT_TRUE(processed_events[3].has_capture_finished());
+}
+
+TEST(TimeRangeFilterEventProcessor, ForwardsStartAndStopOfScopesCrossingTheBoundaries) {
+  std::vector<ClientCaptureEvent> processed_events;
+  std::unique_ptr<CaptureEventProcessor> filter_processor =
+      CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+          std::make_unique<RecordingEventProcessor>(&processed_events), 100, 200);
+
+  // Thread 1:
+  // [10                                              250]  crosses both boundaries
+  //    [20 30]                                             before the range
+  //            [40            150]                         crosses the start
+  //               [50  60]                                 before the range
+  //                      [90  120]                         crosses the start
+  //                                 [160       230]        crosses the end
+  //                                       [210 220]        after the range
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(10));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(20));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(30));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(40));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(50));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(60));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(90));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(120));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(150));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(160));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(210));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(220));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(230));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(250));
+
+  EXPECT_EQ(GetApiScopeTimestamps(processed_events),
+            (std::vector<int64_t>{10, 40, 90, -120, -150, 160, -230, -250}));
+}
+
+TEST(TimeRangeFilterEventProcessor, PairsScopesOfEachThreadSeparately) {
+  std::vector<ClientCaptureEvent> processed_events;
+  std::unique_ptr<CaptureEventProcessor> filter_processor =
+      CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+          std::make_unique<RecordingEventProcessor>(&processed_events), 100, 200);
+
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(10, 1));
+  filter_processor->ProcessEvent(CreateApiScopeStartEvent(20, 2));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(30, 1));
+  filter_processor->ProcessEvent(CreateApiScopeStopEvent(110, 2));
+
+  ASSERT_EQ(processed_events.size(), 2);
+  EXPECT_EQ(processed_events[0].api_scope_start().tid(), 2);
+  EXPECT_EQ(processed_events[0].api_scope_start().timestamp_ns(), 20);
+  EXPECT_EQ(processed_events[1].api_scope_stop().tid(), 2);
+  EXPECT_EQ(processed_events[1].api_scope_stop().timestamp_ns(), 110);
+}
+
+TEST(TimeRangeFilterEventProcessor, ForwardsStartAndStopOfAsyncScopesCrossingTheBoundaries) {
+  std::vector<ClientCaptureEvent> processed_events;
+  std::unique_ptr<CaptureEventProcessor> filter_processor =
+      CaptureEventProcessor::CreateTimeRangeFilterProcessor(
+          std::make_unique<RecordingEventProcessor>(&processed_events), 100, 200);
+
+  // Before, crossing the start, inside, crossing the end, and after the range.
+  filter_processor->ProcessEvent(CreateApiScopeStartAsyncEvent(10, 1));
+  filter_processor->ProcessEvent(CreateApiScopeStartAsyncEvent(20, 2));
+  filter_processor->ProcessEvent(CreateApiScopeStopAsyncEvent(30, 1));
+  filter_processor->ProcessEvent(CreateApiScopeStartAsyncEvent(120, 3));
+  filter_processor->ProcessEvent(CreateApiScopeStopAsyncEvent(130, 2));
+  filter_processor->ProcessEvent(CreateApiScopeStartAsyncEvent(190, 4));
+  filter_processor->ProcessEvent(CreateApiScopeStopAsyncEvent(195, 3));
+  filter_processor->ProcessEvent(CreateApiScopeStartAsyncEvent(210, 5));
+  filter_processor->ProcessEvent(CreateApiScopeStopAsyncEvent(220, 5));
+  filter_processor->ProcessEvent(CreateApiScopeStopAsyncEvent(250, 4));
+
+  std::vector<std::pair<bool, uint64_t>> start_and_id;
+  for (const ClientCaptureEvent& event : processed_events) {
+    if (event.has_api_scope_start_async()) {
+      start_and_id.emplace_back(true, event.api_scope_start_async().id());
+    } else {
+      start_and_id.emplace_back(false, event.api_scope_stop_async().id());
+    }
+  }
+  const std::vector<std::pair<bool, uint64_t>> expected_start_and_id{
+      {true, 3}, {true, 2}, {false, 2}, {true, 4}, {false, 3}, {false, 4}};
+  EXPECT_EQ(start_and_id, expected_start_and_id);
+}
+
+}  // namespace orbit_capture_client
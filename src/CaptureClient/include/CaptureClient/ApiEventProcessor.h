@@ -8,9 +8,11 @@
 #include <absl/container/flat_hash_map.h>
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "CaptureClient/CaptureListener.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_capture_client {
@@ -20,9 +22,13 @@ namespace orbit_capture_client {
 // is maintained to cache "start" events until a corresponding "stop" event is received. The pair
 // is then used to create a single TimerInfo object. "Tracking" events don't need to be cached
 // however, they are translated to TimerInfo objects that are directly passed to the listener.
+// Scope names can be sent as a key into `string_intern_pool` instead of as an encoded string, in
+// which case the pool needs to outlive this object and contain the key when the scope is stopped.
 class ApiEventProcessor {
  public:
-  explicit ApiEventProcessor(CaptureListener* listener);
+  explicit ApiEventProcessor(
+      CaptureListener* listener,
+      const absl::flat_hash_map<uint64_t, std::string>* string_intern_pool = nullptr);
 
   void ProcessApiScopeStart(const orbit_grpc_protos::ApiScopeStart& api_scope_start);
   void ProcessApiScopeStartAsync(
@@ -39,7 +45,11 @@ class ApiEventProcessor {
   void ProcessApiTrackUint64(const orbit_grpc_protos::ApiTrackUint64& grpc_api_track_uint64);
 
  private:
+  template <typename ScopeStart>
+  [[nodiscard]] std::string GetApiScopeName(const ScopeStart& start_event) const;
+
   CaptureListener* capture_listener_ = nullptr;
+  const absl::flat_hash_map<uint64_t, std::string>* string_intern_pool_ = nullptr;
   absl::flat_hash_map<int32_t, std::vector<orbit_grpc_protos::ApiScopeStart>>
       synchronous_scopes_stack_by_tid_;
   absl::flat_hash_map<uint64_t, orbit_grpc_protos::ApiScopeStartAsync> asynchronous_scopes_by_id_;
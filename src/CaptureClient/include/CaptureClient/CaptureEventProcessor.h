@@ -38,6 +38,15 @@ class CaptureEventProcessor {
 
   static std::unique_ptr<CaptureEventProcessor> CreateCompositeProcessor(
       std::vector<std::unique_ptr<CaptureEventProcessor>> event_processors);
+
+  // Creates a processor that drops the events that are filterable by time (see
+  // orbit_capture_file::IsCaptureEventFilterableByTime) and fall outside of
+  // [min_timestamp_ns, max_timestamp_ns], and forwards all other events to `event_processor`. The
+  // start and the stop of an Orbit API scope are forwarded if the whole scope overlaps with the
+  // range.
+  static std::unique_ptr<CaptureEventProcessor> CreateTimeRangeFilterProcessor(
+      std::unique_ptr<CaptureEventProcessor> event_processor, uint64_t min_timestamp_ns,
+      uint64_t max_timestamp_ns);
 };
 
 }  // namespace orbit_capture_client
@@ -18,9 +18,9 @@
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Result.h"
 
@@ -45,7 +45,7 @@ class CaptureListener {
                                 absl::flat_hash_set<uint64_t> frame_track_function_ids) = 0;
   virtual void OnCaptureFinished(const orbit_grpc_protos::CaptureFinished& capture_finished) = 0;
 
-  virtual void OnTimer(const orbit_client_protos::TimerInfo& timer_info) = 0;
+  virtual void OnTimer(const orbit_client_data::TimerInfo& timer_info) = 0;
   virtual void OnCgroupAndProcessMemoryInfo(
       const orbit_client_data::CgroupAndProcessMemoryInfo& cgroup_and_process_memory_info) = 0;
   virtual void OnPageFaultsInfo(const orbit_client_data::PageFaultsInfo& page_faults_info) = 0;
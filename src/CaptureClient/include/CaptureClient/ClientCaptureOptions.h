@@ -36,6 +36,8 @@ struct ClientCaptureOptions {
   uint16_t stack_dump_size = 0;
   uint16_t thread_state_change_callstack_stack_dump_size = 0;
   uint64_t max_local_marker_depth_per_command_buffer = 0;
+  uint32_t dwarf_unwinding_thread_count = 0;
+  uint32_t ring_buffer_reader_thread_count = 0;
   uint64_t memory_sampling_period_ms = 0;
   double samples_per_second = 0;
 
@@ -48,6 +50,9 @@ struct ClientCaptureOptions {
   bool record_arguments = false;
   bool record_return_values = false;
   bool enable_auto_frame_track = false;
+  bool event_driven_ring_buffer_reading = false;
+  bool compress_capture_responses = false;
+  bool intern_callstacks = false;
 };
 
 }  // namespace orbit_capture_client
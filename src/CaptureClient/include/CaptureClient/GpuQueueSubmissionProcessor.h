@@ -19,7 +19,7 @@
 #include <string_view>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_capture_client {
@@ -42,7 +42,7 @@ class GpuQueueSubmissionProcessor {
   // If the matching `GpuJob` has already been processed, it converts the command buffer and debug
   // marker information from the `GpuQueueSubmission` event into `TimerInfo`s. Otherwise, it
   // returns an empty vector and stores the submission for later processing.
-  [[nodiscard]] std::vector<orbit_client_protos::TimerInfo> ProcessGpuQueueSubmission(
+  [[nodiscard]] std::vector<orbit_client_data::TimerInfo> ProcessGpuQueueSubmission(
       const orbit_grpc_protos::GpuQueueSubmission& gpu_queue_submission,
       const absl::flat_hash_map<uint64_t, std::string>& string_intern_pool,
       const std::function<uint64_t(std::string_view str)>&
@@ -52,7 +52,7 @@ class GpuQueueSubmissionProcessor {
   // command buffer and debug marker information from this `GpuQueueSubmission` event into
   // `TimerInfo`s. Otherwise, it returns an empty vector and stores the `GpuJob for later
   // processing.
-  [[nodiscard]] std::vector<orbit_client_protos::TimerInfo> ProcessGpuJob(
+  [[nodiscard]] std::vector<orbit_client_data::TimerInfo> ProcessGpuJob(
       const orbit_grpc_protos::GpuJob& gpu_job,
       const absl::flat_hash_map<uint64_t, std::string>& string_intern_pool,
       const std::function<uint64_t(std::string_view str)>&
@@ -74,7 +74,7 @@ class GpuQueueSubmissionProcessor {
                                                         uint64_t* out_group_id);
 
  private:
-  [[nodiscard]] std::vector<orbit_client_protos::TimerInfo>
+  [[nodiscard]] std::vector<orbit_client_data::TimerInfo>
   ProcessGpuQueueSubmissionWithMatchingGpuJob(
       const orbit_grpc_protos::GpuQueueSubmission& gpu_queue_submission,
       const orbit_grpc_protos::GpuJob& matching_gpu_job,
@@ -82,7 +82,7 @@ class GpuQueueSubmissionProcessor {
       const std::function<uint64_t(std::string_view str)>&
           get_string_hash_and_send_to_listener_if_necessary);
 
-  [[nodiscard]] std::vector<orbit_client_protos::TimerInfo> ProcessGpuCommandBuffers(
+  [[nodiscard]] std::vector<orbit_client_data::TimerInfo> ProcessGpuCommandBuffers(
       const orbit_grpc_protos::GpuQueueSubmission& gpu_queue_submission,
       const orbit_grpc_protos::GpuJob& matching_gpu_job,
       const std::optional<orbit_grpc_protos::GpuCommandBuffer>& first_command_buffer,
@@ -90,7 +90,7 @@ class GpuQueueSubmissionProcessor {
       const std::function<uint64_t(std::string_view str)>&
           get_string_hash_and_send_to_listener_if_necessary) const;
 
-  [[nodiscard]] std::vector<orbit_client_protos::TimerInfo> ProcessGpuDebugMarkers(
+  [[nodiscard]] std::vector<orbit_client_data::TimerInfo> ProcessGpuDebugMarkers(
       const orbit_grpc_protos::GpuQueueSubmission& gpu_queue_submission,
       const orbit_grpc_protos::GpuJob& matching_gpu_job,
       const std::optional<orbit_grpc_protos::GpuCommandBuffer>& first_command_buffer,
@@ -5,7 +5,10 @@
 #ifndef CAPTURE_CLIENT_LOAD_CAPTURE_H_
 #define CAPTURE_CLIENT_LOAD_CAPTURE_H_
 
+#include <stdint.h>
+
 #include <atomic>
+#include <optional>
 
 #include "CaptureClient/CaptureListener.h"
 #include "CaptureFile/CaptureFile.h"
@@ -13,10 +16,21 @@
 
 namespace orbit_capture_client {
 
+// A window of time, relative to the start of the capture, i.e., to the timestamp of the
+// CaptureStarted event.
+struct CaptureTimeRange {
+  uint64_t start_ns;
+  uint64_t end_ns;
+};
+
+// If `time_range` is set, only the events overlapping with it are loaded, in addition to the events
+// that are needed regardless of their timestamps, like interned strings and callstacks, module
+// snapshots and thread names (see orbit_capture_file::IsCaptureEventFilterableByTime).
 // TODO(b/234110675) Add a smoke test
 [[nodiscard]] ErrorMessageOr<CaptureListener::CaptureOutcome> LoadCapture(
     CaptureListener* listener, orbit_capture_file::CaptureFile* capture_file,
-    std::atomic<bool>* capture_loading_cancellation_requested);
+    std::atomic<bool>* capture_loading_cancellation_requested,
+    std::optional<CaptureTimeRange> time_range = std::nullopt);
 
 }  // namespace orbit_capture_client
 #endif  // CAPTURE_CLIENT_LOAD_CAPTURE_H_
@@ -0,0 +1,76 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_CLIENT_SHARDED_TIMER_PROCESSOR_H_
+#define CAPTURE_CLIENT_SHARDED_TIMER_PROCESSOR_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ClientData/TimerInfo.h"
+
+namespace orbit_capture_client {
+
+// Second stage of the client ingest path: while the capture thread decodes the events and resolves
+// interned data, the insertion of timers into their tracks, which is the most expensive part of
+// processing a timer, runs on `num_shards` worker threads.
+//
+// Timers are sharded by thread id: all the timers of a thread are processed by the same worker, in
+// the order in which they were passed to ProcessTimer, so the order of the timers of each track is
+// the same as with a single thread, while timers of different threads are processed in parallel.
+// `timer_processor` must be safe to call concurrently for timers of different threads.
+//
+// ProcessTimer blocks while the queue of the shard is full, which applies backpressure to the
+// producer (and in turn to the gRPC stream) instead of buffering an unbounded number of timers.
+class ShardedTimerProcessor {
+ public:
+  using TimerProcessor = std::function<void(const orbit_client_data::TimerInfo&)>;
+
+  explicit ShardedTimerProcessor(size_t num_shards, TimerProcessor timer_processor);
+  // Processes the pending timers before returning.
+  ~ShardedTimerProcessor();
+
+  ShardedTimerProcessor(const ShardedTimerProcessor&) = delete;
+  ShardedTimerProcessor& operator=(const ShardedTimerProcessor&) = delete;
+  ShardedTimerProcessor(ShardedTimerProcessor&&) = delete;
+  ShardedTimerProcessor& operator=(ShardedTimerProcessor&&) = delete;
+
+  void ProcessTimer(orbit_client_data::TimerInfo timer_info);
+
+  // Blocks until all the timers passed to ProcessTimer so far have been processed.
+  void Flush();
+
+  [[nodiscard]] size_t GetNumberOfShards() const { return shards_.size(); }
+
+  // Uses half of the cores, leaving the others to the capture thread and to the UI, up to
+  // kMaxNumberOfShards.
+  [[nodiscard]] static size_t GetDefaultNumberOfShards();
+
+  static constexpr size_t kMaxNumberOfShards = 8;
+  static constexpr size_t kMaxPendingTimersPerShard = 64 * 1024;
+
+ private:
+  struct Shard {
+    absl::Mutex mutex;
+    std::vector<orbit_client_data::TimerInfo> pending_timers ABSL_GUARDED_BY(mutex);
+    bool is_processing ABSL_GUARDED_BY(mutex) = false;
+    bool exit_requested ABSL_GUARDED_BY(mutex) = false;
+    std::thread thread;
+  };
+
+  void RunShard(Shard* shard);
+
+  TimerProcessor timer_processor_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace orbit_capture_client
+
+#endif  // CAPTURE_CLIENT_SHARDED_TIMER_PROCESSOR_H_
@@ -12,11 +12,13 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 #include "CaptureEventProducer/LockFreeBufferCaptureEventProducer.h"
 #include "FakeProducerSideService/FakeProducerSideService.h"
@@ -28,6 +30,12 @@ namespace {
 
 class LockFreeBufferCaptureEventProducerImpl
     : public LockFreeBufferCaptureEventProducer<std::string> {
+ public:
+  LockFreeBufferCaptureEventProducerImpl() = default;
+  explicit LockFreeBufferCaptureEventProducerImpl(
+      PerThreadRingBufferOptions per_thread_ring_buffers)
+      : LockFreeBufferCaptureEventProducer{per_thread_ring_buffers} {}
+
  protected:
   orbit_grpc_protos::ProducerCaptureEvent* TranslateIntermediateEvent(
       std::string&& /*intermediate_event*/, google::protobuf::Arena* arena) override {
@@ -48,7 +56,11 @@ class LockFreeBufferCaptureEventProducerTest : public ::testing::Test {
     std::shared_ptr<grpc::Channel> channel =
         fake_server_->InProcessChannel(grpc::ChannelArguments{});
 
-    buffer_producer_.emplace();
+    if (per_thread_ring_buffer_options_.has_value()) {
+      buffer_producer_.emplace(per_thread_ring_buffer_options_.value());
+    } else {
+      buffer_producer_.emplace();
+    }
     buffer_producer_->BuildAndStart(channel);
 
     // Leave some time for the ReceiveCommandsAndSendEvents RPC to actually happen.
@@ -72,6 +84,28 @@ class LockFreeBufferCaptureEventProducerTest : public ::testing::Test {
   std::optional<orbit_fake_producer_side_service::FakeProducerSideService> fake_service_;
   std::unique_ptr<grpc::Server> fake_server_;
   std::optional<LockFreeBufferCaptureEventProducerImpl> buffer_producer_;
+  std::optional<PerThreadRingBufferOptions> per_thread_ring_buffer_options_;
+};
+
+class LockFreeBufferCaptureEventProducerWithRingBuffersTest
+    : public LockFreeBufferCaptureEventProducerTest {
+ protected:
+  static constexpr size_t kCapacityPerThread = 4;
+
+  explicit LockFreeBufferCaptureEventProducerWithRingBuffersTest(
+      PerThreadRingBufferOptions::OverflowPolicy overflow_policy =
+          PerThreadRingBufferOptions::OverflowPolicy::kWaitForSpace) {
+    per_thread_ring_buffer_options_ =
+        PerThreadRingBufferOptions{kCapacityPerThread, overflow_policy};
+  }
+};
+
+class LockFreeBufferCaptureEventProducerWithDroppingRingBuffersTest
+    : public LockFreeBufferCaptureEventProducerWithRingBuffersTest {
+ protected:
+  LockFreeBufferCaptureEventProducerWithDroppingRingBuffersTest()
+      : LockFreeBufferCaptureEventProducerWithRingBuffersTest{
+            PerThreadRingBufferOptions::OverflowPolicy::kDropEvent} {}
 };
 
 constexpr std::chrono::milliseconds kWaitMessagesSentDuration{25};
@@ -405,4 +439,82 @@ TEST_F(LockFreeBufferCaptureEventProducerTest, DisconnectAndReconnect) {
   EXPECT_FALSE(buffer_producer_->IsCapturing());
 }
 
+TEST_F(LockFreeBufferCaptureEventProducerWithRingBuffersTest, EnqueueFromMultipleThreads) {
+  fake_service_->SendStartCaptureCommand(orbit_grpc_protos::CaptureOptions{});
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  EXPECT_TRUE(buffer_producer_->IsCapturing());
+
+  std::atomic<uint64_t> capture_events_received_count = 0;
+  ON_CALL(*fake_service_, OnCaptureEventsReceived)
+      .WillByDefault([&capture_events_received_count](
+                         absl::Span<const orbit_grpc_protos::ProducerCaptureEvent> events) {
+        capture_events_received_count += events.size();
+      });
+  EXPECT_CALL(*fake_service_, OnCaptureEventsReceived).Times(::testing::AtLeast(1));
+  EXPECT_CALL(*fake_service_, OnAllEventsSentReceived).Times(0);
+
+  // Each thread enqueues many more events than fit in its ring buffer, so it will have to wait for
+  // the forwarder thread to make space. Some threads exit while others are still enqueuing.
+  constexpr size_t kThreadCount = 8;
+  std::vector<std::thread> threads;
+  for (size_t thread_index = 0; thread_index < kThreadCount; ++thread_index) {
+    threads.emplace_back([this, event_count = (thread_index + 1) * 10 * kCapacityPerThread] {
+      for (size_t i = 0; i < event_count; ++i) {
+        buffer_producer_->EnqueueIntermediateEvent("");
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  constexpr uint64_t kExpectedEventCount =
+      10 * kCapacityPerThread * kThreadCount * (kThreadCount + 1) / 2;
+  EXPECT_EQ(capture_events_received_count, kExpectedEventCount);
+  EXPECT_EQ(buffer_producer_->GetDroppedEventCount(), 0);
+
+  ::testing::Mock::VerifyAndClearExpectations(&*fake_service_);
+
+  EXPECT_CALL(*fake_service_, OnCaptureEventsReceived).Times(0);
+  EXPECT_CALL(*fake_service_, OnAllEventsSentReceived).Times(1);
+  fake_service_->SendStopCaptureCommand();
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  EXPECT_FALSE(buffer_producer_->IsCapturing());
+}
+
+TEST_F(LockFreeBufferCaptureEventProducerWithDroppingRingBuffersTest, DropsEventsWhenFull) {
+  fake_service_->SendStartCaptureCommand(orbit_grpc_protos::CaptureOptions{});
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  EXPECT_TRUE(buffer_producer_->IsCapturing());
+
+  std::atomic<uint64_t> capture_events_received_count = 0;
+  ON_CALL(*fake_service_, OnCaptureEventsReceived)
+      .WillByDefault([&capture_events_received_count](
+                         absl::Span<const orbit_grpc_protos::ProducerCaptureEvent> events) {
+        capture_events_received_count += events.size();
+      });
+  EXPECT_CALL(*fake_service_, OnCaptureEventsReceived).Times(::testing::AtLeast(1));
+  EXPECT_CALL(*fake_service_, OnAllEventsSentReceived).Times(0);
+
+  constexpr uint64_t kEnqueuedEventCount = 100'000;
+  for (uint64_t i = 0; i < kEnqueuedEventCount; ++i) {
+    buffer_producer_->EnqueueIntermediateEvent("");
+  }
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  // Without waiting for the forwarder thread, some events must have been dropped, but not more
+  // than those that didn't fit into the ring buffer.
+  EXPECT_GT(buffer_producer_->GetDroppedEventCount(), 0);
+  EXPECT_EQ(capture_events_received_count + buffer_producer_->GetDroppedEventCount(),
+            kEnqueuedEventCount);
+  EXPECT_GE(capture_events_received_count, kCapacityPerThread);
+
+  ::testing::Mock::VerifyAndClearExpectations(&*fake_service_);
+
+  EXPECT_CALL(*fake_service_, OnCaptureEventsReceived).Times(0);
+  EXPECT_CALL(*fake_service_, OnAllEventsSentReceived).Times(1);
+  fake_service_->SendStopCaptureCommand();
+  std::this_thread::sleep_for(kWaitMessagesSentDuration);
+  EXPECT_FALSE(buffer_producer_->IsCapturing());
+}
+
 }  // namespace orbit_capture_event_producer
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CaptureEventProducer/SpscRingBuffer.h"
+
+namespace orbit_capture_event_producer {
+
+TEST(SpscRingBuffer, CapacityIsRoundedUpToPowerOfTwo) {
+  EXPECT_EQ(SpscRingBuffer<int>{1}.capacity(), 1);
+  EXPECT_EQ(SpscRingBuffer<int>{5}.capacity(), 8);
+  EXPECT_EQ(SpscRingBuffer<int>{16}.capacity(), 16);
+}
+
+TEST(SpscRingBuffer, PushAndPopInOrder) {
+  SpscRingBuffer<std::string> ring_buffer{4};
+  EXPECT_TRUE(ring_buffer.TryPush("a"));
+  std::string b = "b";
+  EXPECT_TRUE(ring_buffer.TryPush(b));
+  EXPECT_EQ(b, "b");
+  EXPECT_TRUE(ring_buffer.TryPush(std::string{"c"}));
+
+  std::vector<std::string> popped(4);
+  EXPECT_EQ(ring_buffer.TryPopBulk(popped.begin(), 2), 2);
+  EXPECT_EQ(popped[0], "a");
+  EXPECT_EQ(popped[1], "b");
+
+  EXPECT_EQ(ring_buffer.TryPopBulk(popped.begin(), 4), 1);
+  EXPECT_EQ(popped[0], "c");
+
+  EXPECT_EQ(ring_buffer.TryPopBulk(popped.begin(), 4), 0);
+}
+
+TEST(SpscRingBuffer, PushFailsWhenFull) {
+  SpscRingBuffer<int> ring_buffer{2};
+  EXPECT_TRUE(ring_buffer.TryPush(1));
+  EXPECT_TRUE(ring_buffer.TryPush(2));
+  EXPECT_FALSE(ring_buffer.TryPush(3));
+
+  std::vector<int> popped(1);
+  EXPECT_EQ(ring_buffer.TryPopBulk(popped.begin(), 1), 1);
+  EXPECT_EQ(popped[0], 1);
+
+  // The indices wrap around the end of the buffer.
+  EXPECT_TRUE(ring_buffer.TryPush(3));
+  EXPECT_FALSE(ring_buffer.TryPush(4));
+
+  popped.resize(2);
+  EXPECT_EQ(ring_buffer.TryPopBulk(popped.begin(), 2), 2);
+  EXPECT_THAT(popped, testing::ElementsAre(2, 3));
+}
+
+TEST(SpscRingBuffer, FailedPushDoesNotMoveFromValue) {
+  SpscRingBuffer<std::unique_ptr<int>> ring_buffer{1};
+  EXPECT_TRUE(ring_buffer.TryPush(std::make_unique<int>(1)));
+
+  auto value = std::make_unique<int>(2);
+  EXPECT_FALSE(ring_buffer.TryPush(std::move(value)));
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 2);
+}
+
+TEST(SpscRingBuffer, ProducerAndConsumerThreads) {
+  constexpr uint64_t kValueCount = 1'000'000;
+  SpscRingBuffer<uint64_t> ring_buffer{64};
+
+  std::thread producer{[&ring_buffer] {
+    for (uint64_t value = 0; value < kValueCount; ++value) {
+      while (!ring_buffer.TryPush(value)) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+
+  std::vector<uint64_t> popped(16);
+  uint64_t expected_value = 0;
+  while (expected_value < kValueCount) {
+    const size_t count = ring_buffer.TryPopBulk(popped.begin(), popped.size());
+    for (size_t i = 0; i < count; ++i) {
+      EXPECT_EQ(popped[i], expected_value);
+      ++expected_value;
+    }
+  }
+
+  producer.join();
+}
+
+}  // namespace orbit_capture_event_producer
@@ -5,9 +5,21 @@
 #ifndef CAPTURE_EVENT_PRODUCER_LOCK_FREE_BUFFER_CAPTURE_EVENT_PRODUCER_H_
 #define CAPTURE_EVENT_PRODUCER_LOCK_FREE_BUFFER_CAPTURE_EVENT_PRODUCER_H_
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/container/flat_hash_set.h>
 #include <google/protobuf/arena.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
 #include "CaptureEventProducer/CaptureEventProducer.h"
+#include "CaptureEventProducer/SpscRingBuffer.h"
+#include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
 #include "OrbitBase/ThreadUtils.h"
@@ -15,6 +27,22 @@
 
 namespace orbit_capture_event_producer {
 
+// When passed to the constructor of LockFreeBufferCaptureEventProducer, the events of each thread
+// are buffered in a separate SpscRingBuffer of `capacity_per_thread` events, instead of in a
+// lock-free queue shared by all threads. This makes enqueuing cheaper and allocation-free, except
+// for the first event of each thread, at the cost of a fixed amount of memory per thread.
+struct PerThreadRingBufferOptions {
+  enum class OverflowPolicy {
+    // The event is dropped and counted in GetDroppedEventCount(). Enqueuing never waits.
+    kDropEvent,
+    // Enqueuing waits for the forwarder thread to make space. No event is lost.
+    kWaitForSpace,
+  };
+
+  size_t capacity_per_thread = 4 * 1024;
+  OverflowPolicy overflow_policy = OverflowPolicy::kWaitForSpace;
+};
+
 // This still abstract implementation of CaptureEventProducer provides a lock-free queue where to
 // write events with low overhead from the fast path where they are produced.
 // Events are enqueued using the methods EnqueueIntermediateEvent(IfCapturing).
@@ -31,9 +59,16 @@ namespace orbit_capture_event_producer {
 // In particular, when hundreds of thousands of events are produced per second, it is recommended
 // that IntermediateEventT not be a protobuf or another type that involves heap allocations, as the
 // cost of dynamic allocations and de-allocations can add up quickly.
+//
+// Alternatively, events can be buffered in one ring buffer per thread, see
+// PerThreadRingBufferOptions. Note that IntermediateEventT then needs to be default-constructible.
 template <typename IntermediateEventT>
 class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
  public:
+  LockFreeBufferCaptureEventProducer() = default;
+  explicit LockFreeBufferCaptureEventProducer(PerThreadRingBufferOptions per_thread_ring_buffers)
+      : per_thread_ring_buffer_options_{per_thread_ring_buffers} {}
+
   void BuildAndStart(const std::shared_ptr<grpc::Channel>& channel) final {
     CaptureEventProducer::BuildAndStart(channel);
 
@@ -49,30 +84,35 @@ class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
     CaptureEventProducer::ShutdownAndWait();
   }
 
-  void EnqueueIntermediateEvent(const IntermediateEventT& event) {
-    lock_free_queue_.enqueue(event);
-  }
+  void EnqueueIntermediateEvent(const IntermediateEventT& event) { Enqueue(event); }
 
-  void EnqueueIntermediateEvent(IntermediateEventT&& event) {
-    lock_free_queue_.enqueue(std::move(event));
-  }
+  void EnqueueIntermediateEvent(IntermediateEventT&& event) { Enqueue(std::move(event)); }
 
   bool EnqueueIntermediateEventIfCapturing(
       const std::function<IntermediateEventT()>& event_builder_if_capturing) {
     if (IsCapturing()) {
-      lock_free_queue_.enqueue(event_builder_if_capturing());
+      Enqueue(event_builder_if_capturing());
       return true;
     }
     return false;
   }
 
+  // Returns the number of events dropped since the start of the last capture because the ring
+  // buffer of their thread was full. Only relevant with PerThreadRingBufferOptions.
+  [[nodiscard]] uint64_t GetDroppedEventCount() const { return dropped_event_count_; }
+
  protected:
   void OnCaptureStart(orbit_grpc_protos::CaptureOptions /*capture_options*/) override {
+    dropped_event_count_ = 0;
     absl::MutexLock lock{&status_mutex_};
     status_ = ProducerStatus::kShouldSendEvents;
   }
 
   void OnCaptureStop() override {
+    if (uint64_t dropped_event_count = dropped_event_count_; dropped_event_count > 0) {
+      ORBIT_ERROR("Dropped %u events because a per-thread ring buffer was full",
+                  dropped_event_count);
+    }
     absl::MutexLock lock{&status_mutex_};
     status_ = ProducerStatus::kShouldNotifyAllEventsSent;
   }
@@ -95,7 +135,128 @@ class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
   [[nodiscard]] virtual orbit_grpc_protos::ProducerCaptureEvent* TranslateIntermediateEvent(
       IntermediateEventT&& intermediate_event, google::protobuf::Arena* arena) = 0;
 
+  // Subclasses can override this method to send, right before the event translated from
+  // `intermediate_event`, the events that it depends on and that have not been sent yet in the
+  // current capture, e.g., the InternedString for a key it refers to. Such events need to be added
+  // to `capture_events`, allocated in `arena` in the same way as in TranslateIntermediateEvent.
+  virtual void AddEventsRequiredByIntermediateEvent(
+      const IntermediateEventT& /*intermediate_event*/, google::protobuf::Arena* /*arena*/,
+      google::protobuf::RepeatedPtrField<orbit_grpc_protos::ProducerCaptureEvent>*
+      /*capture_events*/) {}
+
  private:
+  struct ThreadRingBuffer {
+    explicit ThreadRingBuffer(size_t capacity) : ring_buffer{capacity} {}
+
+    SpscRingBuffer<IntermediateEventT> ring_buffer;
+    // Set when the producing thread exits, after which the ring buffer can be removed once empty.
+    std::atomic<bool> thread_exited = false;
+  };
+
+  // The ring buffers of the current thread, one for each producer the thread has enqueued events
+  // to. As the object is thread_local, its destructor runs when the thread exits.
+  struct CurrentThreadRingBuffers {
+    ~CurrentThreadRingBuffers() {
+      for (auto& [unused_producer_id, thread_ring_buffer] : ring_buffer_by_producer_id) {
+        thread_ring_buffer->thread_exited = true;
+      }
+    }
+
+    absl::flat_hash_map<uint64_t, std::shared_ptr<ThreadRingBuffer>> ring_buffer_by_producer_id;
+    // Caches the last entry used, as a thread usually only enqueues to a single producer.
+    uint64_t last_producer_id = 0;
+    ThreadRingBuffer* last_ring_buffer = nullptr;
+  };
+
+  // Producers are identified by an id instead of by their address, as addresses can be reused.
+  static uint64_t GenerateProducerId() {
+    static std::atomic<uint64_t> next_producer_id = 1;
+    return next_producer_id++;
+  }
+
+  template <typename EventT>
+  void Enqueue(EventT&& event) {
+    if (!per_thread_ring_buffer_options_.has_value()) {
+      lock_free_queue_.enqueue(std::forward<EventT>(event));
+      return;
+    }
+
+    SpscRingBuffer<IntermediateEventT>& ring_buffer = GetCurrentThreadRingBuffer();
+    while (!ring_buffer.TryPush(std::forward<EventT>(event))) {
+      if (per_thread_ring_buffer_options_->overflow_policy ==
+              PerThreadRingBufferOptions::OverflowPolicy::kDropEvent ||
+          shutdown_requested_) {
+        ++dropped_event_count_;
+        return;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  SpscRingBuffer<IntermediateEventT>& GetCurrentThreadRingBuffer() {
+    thread_local CurrentThreadRingBuffers current_thread_ring_buffers;
+    if (current_thread_ring_buffers.last_producer_id == producer_id_) {
+      return current_thread_ring_buffers.last_ring_buffer->ring_buffer;
+    }
+
+    std::shared_ptr<ThreadRingBuffer>& thread_ring_buffer =
+        current_thread_ring_buffers.ring_buffer_by_producer_id[producer_id_];
+    if (thread_ring_buffer == nullptr) {
+      thread_ring_buffer =
+          std::make_shared<ThreadRingBuffer>(per_thread_ring_buffer_options_->capacity_per_thread);
+      absl::MutexLock lock{&thread_ring_buffers_mutex_};
+      thread_ring_buffers_.push_back(thread_ring_buffer);
+    }
+    current_thread_ring_buffers.last_producer_id = producer_id_;
+    current_thread_ring_buffers.last_ring_buffer = thread_ring_buffer.get();
+    return thread_ring_buffer->ring_buffer;
+  }
+
+  // Moves up to `max_count` events to `dequeued_events` and returns their number. Events enqueued
+  // by the same thread keep their order.
+  size_t DequeueEvents(std::vector<IntermediateEventT>* dequeued_events, size_t max_count) {
+    if (!per_thread_ring_buffer_options_.has_value()) {
+      return lock_free_queue_.try_dequeue_bulk(dequeued_events->begin(), max_count);
+    }
+
+    {
+      absl::MutexLock lock{&thread_ring_buffers_mutex_};
+      // Remove the ring buffers of exited threads that have been emptied in a previous call.
+      thread_ring_buffers_.erase(
+          std::remove_if(thread_ring_buffers_.begin(), thread_ring_buffers_.end(),
+                         [this](const std::shared_ptr<ThreadRingBuffer>& thread_ring_buffer) {
+                           return emptied_thread_ring_buffers_.contains(thread_ring_buffer.get());
+                         }),
+          thread_ring_buffers_.end());
+      ring_buffers_to_drain_.clear();
+      for (const std::shared_ptr<ThreadRingBuffer>& thread_ring_buffer : thread_ring_buffers_) {
+        ring_buffers_to_drain_.push_back(thread_ring_buffer.get());
+      }
+    }
+    emptied_thread_ring_buffers_.clear();
+    if (ring_buffers_to_drain_.empty()) return 0;
+
+    // Start from a different ring buffer every time, so that no thread is starved when the events
+    // don't all fit into `dequeued_events`.
+    ++first_ring_buffer_to_drain_;
+    size_t dequeued_event_count = 0;
+    for (size_t i = 0; i < ring_buffers_to_drain_.size() && dequeued_event_count < max_count;
+         ++i) {
+      ThreadRingBuffer* thread_ring_buffer =
+          ring_buffers_to_drain_[(first_ring_buffer_to_drain_ + i) % ring_buffers_to_drain_.size()];
+      // Read this before draining, so that no event enqueued before the thread exited is missed.
+      const bool thread_exited = thread_ring_buffer->thread_exited;
+      const size_t remaining_count = max_count - dequeued_event_count;
+      const size_t count = thread_ring_buffer->ring_buffer.TryPopBulk(
+          dequeued_events->begin() + dequeued_event_count, remaining_count);
+      dequeued_event_count += count;
+      if (thread_exited && count < remaining_count) {
+        emptied_thread_ring_buffers_.insert(thread_ring_buffer);
+      }
+    }
+    return dequeued_event_count;
+  }
+
   void ForwarderThread() {
     orbit_base::SetCurrentThreadName("ForwarderThread");
 
@@ -117,8 +278,7 @@ class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
 
     while (!shutdown_requested_) {
       while (true) {
-        size_t dequeued_event_count =
-            lock_free_queue_.try_dequeue_bulk(dequeued_events.begin(), kMaxEventsPerRequest);
+        size_t dequeued_event_count = DequeueEvents(&dequeued_events, kMaxEventsPerRequest);
         bool queue_was_emptied = dequeued_event_count < kMaxEventsPerRequest;
 
         ProducerStatus current_status;
@@ -142,6 +302,7 @@ class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
           capture_events->Reserve(dequeued_event_count);
 
           for (size_t i = 0; i < dequeued_event_count; ++i) {
+            AddEventsRequiredByIntermediateEvent(dequeued_events[i], &arena, capture_events);
             capture_events->AddAllocated(
                 TranslateIntermediateEvent(std::move(dequeued_events[i]), &arena));
           }
@@ -177,6 +338,17 @@ class LockFreeBufferCaptureEventProducer : public CaptureEventProducer {
 
   moodycamel::ConcurrentQueue<IntermediateEventT> lock_free_queue_;
 
+  const std::optional<PerThreadRingBufferOptions> per_thread_ring_buffer_options_;
+  const uint64_t producer_id_ = GenerateProducerId();
+  absl::Mutex thread_ring_buffers_mutex_;
+  std::vector<std::shared_ptr<ThreadRingBuffer>> thread_ring_buffers_
+      ABSL_GUARDED_BY(thread_ring_buffers_mutex_);
+  // Only accessed by the forwarder thread.
+  std::vector<ThreadRingBuffer*> ring_buffers_to_drain_;
+  absl::flat_hash_set<ThreadRingBuffer*> emptied_thread_ring_buffers_;
+  size_t first_ring_buffer_to_drain_ = 0;
+  std::atomic<uint64_t> dropped_event_count_ = 0;
+
   std::thread forwarder_thread_;
   std::atomic<bool> shutdown_requested_ = false;
 
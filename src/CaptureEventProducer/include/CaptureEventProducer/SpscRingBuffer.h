@@ -0,0 +1,92 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_EVENT_PRODUCER_SPSC_RING_BUFFER_H_
+#define CAPTURE_EVENT_PRODUCER_SPSC_RING_BUFFER_H_
+
+#include <absl/numeric/bits.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_capture_event_producer {
+
+// Fixed-capacity ring buffer for a single producer thread and a single consumer thread. Both
+// TryPush and TryPopBulk are wait-free and never allocate: all the slots are allocated, and
+// default-constructed, in the constructor. The capacity is rounded up to a power of two.
+//
+// TryPush must only be called by the producer thread, and TryPopBulk only by the consumer thread.
+template <typename T>
+class SpscRingBuffer {
+ public:
+  explicit SpscRingBuffer(size_t capacity)
+      : capacity_{absl::bit_ceil(capacity)},
+        index_mask_{capacity_ - 1},
+        slots_{std::make_unique<T[]>(capacity_)} {
+    ORBIT_CHECK(capacity > 0);
+  }
+
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+  SpscRingBuffer(SpscRingBuffer&&) = delete;
+  SpscRingBuffer& operator=(SpscRingBuffer&&) = delete;
+
+  // Returns false, and leaves `value` untouched, if the buffer is full.
+  template <typename U>
+  [[nodiscard]] bool TryPush(U&& value) {
+    const uint64_t write_index = write_index_.load(std::memory_order_relaxed);
+    if (write_index - read_index_cached_by_producer_ == capacity_) {
+      // Only read the index shared with the consumer when the buffer looks full.
+      read_index_cached_by_producer_ = read_index_.load(std::memory_order_acquire);
+      if (write_index - read_index_cached_by_producer_ == capacity_) return false;
+    }
+    slots_[write_index & index_mask_] = std::forward<U>(value);
+    write_index_.store(write_index + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves up to `max_count` elements, in the order in which they were pushed, to `output`. Returns
+  // the number of elements moved.
+  template <typename OutputIt>
+  size_t TryPopBulk(OutputIt output, size_t max_count) {
+    const uint64_t read_index = read_index_.load(std::memory_order_relaxed);
+    if (write_index_cached_by_consumer_ - read_index < max_count) {
+      write_index_cached_by_consumer_ = write_index_.load(std::memory_order_acquire);
+    }
+    const size_t count =
+        std::min<uint64_t>(write_index_cached_by_consumer_ - read_index, max_count);
+    for (size_t i = 0; i < count; ++i) {
+      *output = std::move(slots_[(read_index + i) & index_mask_]);
+      ++output;
+    }
+    read_index_.store(read_index + count, std::memory_order_release);
+    return count;
+  }
+
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+ private:
+  // Keep the indices written by the producer and by the consumer on different cache lines.
+  static constexpr size_t kCacheLineSize = 64;
+
+  const size_t capacity_;
+  const size_t index_mask_;
+  const std::unique_ptr<T[]> slots_;
+
+  alignas(kCacheLineSize) std::atomic<uint64_t> write_index_ = 0;
+  uint64_t read_index_cached_by_producer_ = 0;
+
+  alignas(kCacheLineSize) std::atomic<uint64_t> read_index_ = 0;
+  uint64_t write_index_cached_by_consumer_ = 0;
+};
+
+}  // namespace orbit_capture_event_producer
+
+#endif  // CAPTURE_EVENT_PRODUCER_SPSC_RING_BUFFER_H_
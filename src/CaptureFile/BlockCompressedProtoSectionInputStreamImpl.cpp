@@ -0,0 +1,38 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "BlockCompressedProtoSectionInputStreamImpl.h"
+
+#include <absl/types/span.h>
+
+#include <utility>
+
+#include "CaptureSectionBlock.h"
+
+namespace orbit_capture_file_internal {
+
+using orbit_capture_file::ProtoSectionMessageScanner;
+
+ErrorMessageOr<void> BlockCompressedProtoSectionInputStreamImpl::ReadMessage(
+    google::protobuf::Message* message) {
+  while (!current_block_scanner_.has_value() || current_block_scanner_->IsAtEnd()) {
+    // The padding at the end of the section is shorter than a block header.
+    if (section_size_ - next_block_offset_ < sizeof(CaptureSectionBlockHeader)) {
+      return ErrorMessage{"Unexpected end of section while reading message size"};
+    }
+
+    const uint64_t block_offset_in_file = section_offset_ + next_block_offset_;
+    OUTCOME_TRY(const CaptureSectionBlockHeader header,
+                ReadCaptureSectionBlockHeader(fd_, block_offset_in_file,
+                                              section_size_ - next_block_offset_));
+    OUTCOME_TRY(current_block_, ReadCaptureSectionBlockData(fd_, block_offset_in_file, header));
+    next_block_offset_ += sizeof(CaptureSectionBlockHeader) + header.compressed_size;
+    current_block_scanner_.emplace(absl::MakeConstSpan(current_block_));
+  }
+
+  OUTCOME_TRY(const absl::Span<const uint8_t> message_bytes, current_block_scanner_->NextMessage());
+  return ProtoSectionMessageScanner::ParseMessage(message_bytes, message);
+}
+
+}  // namespace orbit_capture_file_internal
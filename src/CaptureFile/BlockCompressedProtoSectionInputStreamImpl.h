@@ -0,0 +1,45 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BLOCK_COMPRESSED_PROTO_SECTION_INPUT_STREAM_IMPL_H_
+#define BLOCK_COMPRESSED_PROTO_SECTION_INPUT_STREAM_IMPL_H_
+
+#include <google/protobuf/message.h>
+#include <stdint.h>
+
+#include <optional>
+#include <vector>
+
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+#include "OrbitBase/File.h"
+#include "OrbitBase/Result.h"
+
+namespace orbit_capture_file_internal {
+
+// This class is used to read proto messages from a block-compressed capture section. The blocks
+// are decompressed one at a time, as the messages are read.
+class BlockCompressedProtoSectionInputStreamImpl
+    : public orbit_capture_file::ProtoSectionInputStream {
+ public:
+  explicit BlockCompressedProtoSectionInputStreamImpl(const orbit_base::UniqueFd& fd,
+                                                      uint64_t section_offset,
+                                                      uint64_t section_size)
+      : fd_{fd}, section_offset_{section_offset}, section_size_{section_size} {}
+
+  ErrorMessageOr<void> ReadMessage(google::protobuf::Message* message) override;
+
+ private:
+  const orbit_base::UniqueFd& fd_;
+  uint64_t section_offset_;
+  uint64_t section_size_;
+  // The offset of the next block to decompress, relative to the start of the section.
+  uint64_t next_block_offset_ = 0;
+  std::vector<uint8_t> current_block_;
+  std::optional<orbit_capture_file::ProtoSectionMessageScanner> current_block_scanner_;
+};
+
+}  // namespace orbit_capture_file_internal
+
+#endif  // BLOCK_COMPRESSED_PROTO_SECTION_INPUT_STREAM_IMPL_H_
@@ -0,0 +1,166 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureFile/CaptureEventTimeRange.h"
+
+namespace orbit_capture_file {
+
+using orbit_grpc_protos::ClientCaptureEvent;
+
+[[nodiscard]] static CaptureEventTimeRange Timestamp(uint64_t timestamp_ns) {
+  return {timestamp_ns, timestamp_ns};
+}
+
+[[nodiscard]] static CaptureEventTimeRange EndAndDuration(uint64_t end_timestamp_ns,
+                                                          uint64_t duration_ns) {
+  return {end_timestamp_ns - duration_ns, end_timestamp_ns};
+}
+
+std::optional<CaptureEventTimeRange> GetCaptureEventTimeRange(const ClientCaptureEvent& event) {
+  switch (event.event_case()) {
+    case ClientCaptureEvent::kApiScopeStart:
+      return Timestamp(event.api_scope_start().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStartAsync:
+      return Timestamp(event.api_scope_start_async().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStop:
+      return Timestamp(event.api_scope_stop().timestamp_ns());
+    case ClientCaptureEvent::kApiScopeStopAsync:
+      return Timestamp(event.api_scope_stop_async().timestamp_ns());
+    case ClientCaptureEvent::kApiStringEvent:
+      return Timestamp(event.api_string_event().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackDouble:
+      return Timestamp(event.api_track_double().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackFloat:
+      return Timestamp(event.api_track_float().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackInt:
+      return Timestamp(event.api_track_int().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackInt64:
+      return Timestamp(event.api_track_int64().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackUint:
+      return Timestamp(event.api_track_uint().timestamp_ns());
+    case ClientCaptureEvent::kApiTrackUint64:
+      return Timestamp(event.api_track_uint64().timestamp_ns());
+    case ClientCaptureEvent::kCallstackSample:
+      return Timestamp(event.callstack_sample().timestamp_ns());
+    case ClientCaptureEvent::kCaptureStarted:
+      return Timestamp(event.capture_started().capture_start_timestamp_ns());
+    case ClientCaptureEvent::kClockResolutionEvent:
+      return Timestamp(event.clock_resolution_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorEnablingOrbitApiEvent:
+      return Timestamp(event.error_enabling_orbit_api_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorEnablingUserSpaceInstrumentationEvent:
+      return Timestamp(event.error_enabling_user_space_instrumentation_event().timestamp_ns());
+    case ClientCaptureEvent::kErrorsWithPerfEventOpenEvent:
+      return Timestamp(event.errors_with_perf_event_open_event().timestamp_ns());
+    case ClientCaptureEvent::kFunctionCall:
+      return EndAndDuration(event.function_call().end_timestamp_ns(),
+                            event.function_call().duration_ns());
+    case ClientCaptureEvent::kGpuJob: {
+      const orbit_grpc_protos::GpuJob& gpu_job = event.gpu_job();
+      return CaptureEventTimeRange{gpu_job.amdgpu_cs_ioctl_time_ns(),
+                                   gpu_job.dma_fence_signaled_time_ns()};
+    }
+    case ClientCaptureEvent::kGpuQueueSubmission: {
+      const orbit_grpc_protos::GpuQueueSubmissionMetaInfo& meta_info =
+          event.gpu_queue_submission().meta_info();
+      return CaptureEventTimeRange{meta_info.pre_submission_cpu_timestamp(),
+                                   meta_info.post_submission_cpu_timestamp()};
+    }
+    case ClientCaptureEvent::kLostPerfRecordsEvent:
+      return EndAndDuration(event.lost_perf_records_event().end_timestamp_ns(),
+                            event.lost_perf_records_event().duration_ns());
+    case ClientCaptureEvent::kMemoryUsageEvent:
+      return Timestamp(event.memory_usage_event().timestamp_ns());
+    case ClientCaptureEvent::kModulesSnapshot:
+      return Timestamp(event.modules_snapshot().timestamp_ns());
+    case ClientCaptureEvent::kModuleUpdateEvent:
+      return Timestamp(event.module_update_event().timestamp_ns());
+    case ClientCaptureEvent::kOutOfOrderEventsDiscardedEvent:
+      return EndAndDuration(event.out_of_order_events_discarded_event().end_timestamp_ns(),
+                            event.out_of_order_events_discarded_event().duration_ns());
+    case ClientCaptureEvent::kPresentEvent:
+      return CaptureEventTimeRange{
+          event.present_event().begin_timestamp_ns(),
+          event.present_event().begin_timestamp_ns() + event.present_event().duration_ns()};
+    case ClientCaptureEvent::kSchedulingSlice:
+      return EndAndDuration(event.scheduling_slice().out_timestamp_ns(),
+                            event.scheduling_slice().duration_ns());
+    case ClientCaptureEvent::kThreadName:
+      return Timestamp(event.thread_name().timestamp_ns());
+    case ClientCaptureEvent::kThreadNamesSnapshot:
+      return Timestamp(event.thread_names_snapshot().timestamp_ns());
+    case ClientCaptureEvent::kThreadStateSlice:
+      return EndAndDuration(event.thread_state_slice().end_timestamp_ns(),
+                            event.thread_state_slice().duration_ns());
+    case ClientCaptureEvent::kTracepointEvent:
+      return Timestamp(event.tracepoint_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningEvent:
+      return Timestamp(event.warning_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningInstrumentingWithUprobesEvent:
+      return Timestamp(event.warning_instrumenting_with_uprobes_event().timestamp_ns());
+    case ClientCaptureEvent::kWarningInstrumentingWithUserSpaceInstrumentationEvent:
+      return Timestamp(
+          event.warning_instrumenting_with_user_space_instrumentation_event().timestamp_ns());
+    case ClientCaptureEvent::kAddressInfo:
+    case ClientCaptureEvent::kCaptureFinished:
+    case ClientCaptureEvent::kInternedCallstack:
+    case ClientCaptureEvent::kInternedString:
+    case ClientCaptureEvent::kInternedTracepointInfo:
+    case ClientCaptureEvent::EVENT_NOT_SET:
+      return std::nullopt;
+  }
+  return std::nullopt;
+}
+
+bool IsCaptureEventFilterableByTime(ClientCaptureEvent::EventCase event_case) {
+  switch (event_case) {
+    case ClientCaptureEvent::kApiStringEvent:
+    case ClientCaptureEvent::kApiTrackDouble:
+    case ClientCaptureEvent::kApiTrackFloat:
+    case ClientCaptureEvent::kApiTrackInt:
+    case ClientCaptureEvent::kApiTrackInt64:
+    case ClientCaptureEvent::kApiTrackUint:
+    case ClientCaptureEvent::kApiTrackUint64:
+    case ClientCaptureEvent::kCallstackSample:
+    case ClientCaptureEvent::kFunctionCall:
+    case ClientCaptureEvent::kGpuJob:
+    case ClientCaptureEvent::kGpuQueueSubmission:
+    case ClientCaptureEvent::kLostPerfRecordsEvent:
+    case ClientCaptureEvent::kMemoryUsageEvent:
+    case ClientCaptureEvent::kOutOfOrderEventsDiscardedEvent:
+    case ClientCaptureEvent::kPresentEvent:
+    case ClientCaptureEvent::kSchedulingSlice:
+    case ClientCaptureEvent::kThreadStateSlice:
+    case ClientCaptureEvent::kTracepointEvent:
+      return true;
+    // The start and the stop of a scope are paired by the client, so they can only be left out
+    // together, depending on the time range of the whole scope.
+    case ClientCaptureEvent::kApiScopeStart:
+    case ClientCaptureEvent::kApiScopeStartAsync:
+    case ClientCaptureEvent::kApiScopeStop:
+    case ClientCaptureEvent::kApiScopeStopAsync:
+    case ClientCaptureEvent::kAddressInfo:
+    case ClientCaptureEvent::kCaptureFinished:
+    case ClientCaptureEvent::kCaptureStarted:
+    case ClientCaptureEvent::kClockResolutionEvent:
+    case ClientCaptureEvent::kErrorEnablingOrbitApiEvent:
+    case ClientCaptureEvent::kErrorEnablingUserSpaceInstrumentationEvent:
+    case ClientCaptureEvent::kErrorsWithPerfEventOpenEvent:
+    case ClientCaptureEvent::kInternedCallstack:
+    case ClientCaptureEvent::kInternedString:
+    case ClientCaptureEvent::kInternedTracepointInfo:
+    case ClientCaptureEvent::kModulesSnapshot:
+    case ClientCaptureEvent::kModuleUpdateEvent:
+    case ClientCaptureEvent::kThreadName:
+    case ClientCaptureEvent::kThreadNamesSnapshot:
+    case ClientCaptureEvent::kWarningEvent:
+    case ClientCaptureEvent::kWarningInstrumentingWithUprobesEvent:
+    case ClientCaptureEvent::kWarningInstrumentingWithUserSpaceInstrumentationEvent:
+    case ClientCaptureEvent::EVENT_NOT_SET:
+      return false;
+  }
+  return false;
+}
+
+}  // namespace orbit_capture_file
@@ -0,0 +1,70 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <optional>
+
+#include "CaptureFile/CaptureEventTimeRange.h"
+#include "GrpcProtos/capture.pb.h"
+
+namespace orbit_capture_file {
+
+using orbit_grpc_protos::ClientCaptureEvent;
+
+TEST(CaptureEventTimeRange, EventWithTimestamp) {
+  ClientCaptureEvent event;
+  event.mutable_callstack_sample()->set_timestamp_ns(42);
+
+  std::optional<CaptureEventTimeRange> time_range = GetCaptureEventTimeRange(event);
+  ASSERT_TRUE(time_range.has_value());
+  EXPECT_EQ(time_range->min_timestamp_ns, 42);
+  EXPECT_EQ(time_range->max_timestamp_ns, 42);
+}
+
+TEST(CaptureEventTimeRange, EventWithEndTimestampAndDuration) {
+  ClientCaptureEvent event;
+  event.mutable_scheduling_slice()->set_out_timestamp_ns(100);
+  event.mutable_scheduling_slice()->set_duration_ns(30);
+
+  std::optional<CaptureEventTimeRange> time_range = GetCaptureEventTimeRange(event);
+  ASSERT_TRUE(time_range.has_value());
+  EXPECT_EQ(time_range->min_timestamp_ns, 70);
+  EXPECT_EQ(time_range->max_timestamp_ns, 100);
+}
+
+TEST(CaptureEventTimeRange, EventWithBeginTimestampAndDuration) {
+  ClientCaptureEvent event;
+  event.mutable_present_event()->set_begin_timestamp_ns(100);
+  event.mutable_present_event()->set_duration_ns(30);
+
+  std::optional<CaptureEventTimeRange> time_range = GetCaptureEventTimeRange(event);
+  ASSERT_TRUE(time_range.has_value());
+  EXPECT_EQ(time_range->min_timestamp_ns, 100);
+  EXPECT_EQ(time_range->max_timestamp_ns, 130);
+}
+
+TEST(CaptureEventTimeRange, EventWithoutTimestamp) {
+  ClientCaptureEvent event;
+  event.mutable_interned_string()->set_key(1);
+  EXPECT_FALSE(GetCaptureEventTimeRange(event).has_value());
+
+  EXPECT_FALSE(GetCaptureEventTimeRange(ClientCaptureEvent{}).has_value());
+}
+
+TEST(CaptureEventTimeRange, IsCaptureEventFilterableByTime) {
+  EXPECT_TRUE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kFunctionCall));
+  EXPECT_TRUE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kSchedulingSlice));
+  EXPECT_TRUE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kCallstackSample));
+
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kCaptureStarted));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kInternedCallstack));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kModulesSnapshot));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kThreadName));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kApiScopeStart));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::kApiScopeStopAsync));
+  EXPECT_FALSE(IsCaptureEventFilterableByTime(ClientCaptureEvent::EVENT_NOT_SET));
+}
+
+}  // namespace orbit_capture_file
@@ -17,13 +17,19 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
+#include "BlockCompressedProtoSectionInputStreamImpl.h"
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
+#include "CaptureFile/ProtoSectionMessageScanner.h"
 #include "CaptureFileConstants.h"
+#include "CaptureSectionBlock.h"
+#include "ClientProtos/capture_section_block_index.pb.h"
 #include "OrbitBase/Align.h"
 #include "OrbitBase/File.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitBase/MakeUniqueForOverwrite.h"
 #include "OrbitBase/Result.h"
 #include "OrbitBase/SafeStrerror.h"
 #include "ProtoSectionInputStreamImpl.h"
@@ -31,6 +37,7 @@
 #ifdef __linux
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 
@@ -54,7 +61,7 @@ struct CaptureFileHeader {
 class CaptureFileImpl : public CaptureFile {
  public:
   explicit CaptureFileImpl(std::filesystem::path file_path) : file_path_{std::move(file_path)} {}
-  ~CaptureFileImpl() override = default;
+  ~CaptureFileImpl() override;
 
   ErrorMessageOr<void> Initialize();
 
@@ -78,6 +85,18 @@ class CaptureFileImpl : public CaptureFile {
 
   std::unique_ptr<ProtoSectionInputStream> CreateCaptureSectionInputStream() override;
 
+  ErrorMessageOr<absl::Span<const uint8_t>> MapCaptureSection() override;
+
+  [[nodiscard]] bool IsCaptureSectionBlockCompressed() const override {
+    return version_ == kFileVersionBlockCompressed;
+  }
+
+  ErrorMessageOr<std::vector<orbit_client_protos::CaptureSectionBlockInfo>>
+  ReadCaptureSectionBlockIndex() override;
+
+  [[nodiscard]] ErrorMessageOr<std::vector<uint8_t>> ReadCaptureSectionBlock(
+      const orbit_client_protos::CaptureSectionBlockInfo& block_info) const override;
+
   [[nodiscard]] const std::filesystem::path& GetFilePath() const override;
 
   std::unique_ptr<ProtoSectionInputStream> CreateProtoSectionInputStream(
@@ -108,6 +127,7 @@ class CaptureFileImpl : public CaptureFile {
 
   std::filesystem::path file_path_;
   UniqueFd fd_;
+  uint32_t version_ = 0;
   CaptureFileHeader header_{};
 
   // This is used for boundary checks so that we do not end up
@@ -121,8 +141,23 @@ class CaptureFileImpl : public CaptureFile {
   // section. The section_list is ordered by section offset. Meaning a section with lower offset
   // will come before a section with higher offset.
   std::vector<CaptureFileSection> section_list_;
+
+  // The memory mapping created by MapCaptureSection, which starts at the beginning of the file, as
+  // the offset of a mapping needs to be a multiple of the page size.
+  void* mapped_address_ = nullptr;
+  size_t mapped_size_ = 0;
 };
 
+CaptureFileImpl::~CaptureFileImpl() {
+#ifdef __linux
+  if (mapped_address_ != nullptr) {
+    if (munmap(mapped_address_, mapped_size_) != 0) {
+      ORBIT_ERROR("Unmapping capture file \"%s\": %s", file_path_.string(), SafeStrerror(errno));
+    }
+  }
+#endif
+}
+
 ErrorMessageOr<uint64_t> GetEndOfFileOffset(const UniqueFd& fd) {
 #if defined(_WIN32)
   int64_t end_of_file = _lseeki64(fd.get(), 0, SEEK_END);
@@ -220,8 +255,9 @@ ErrorMessageOr<void> ValidateSignature(google::protobuf::io::CodedInputStream* c
   return outcome::success();
 }
 
-ErrorMessageOr<void> ValidateFileVersion(google::protobuf::io::CodedInputStream* coded_input,
-                                         google::protobuf::io::FileInputStream* raw_input) {
+ErrorMessageOr<uint32_t> ReadAndValidateFileVersion(
+    google::protobuf::io::CodedInputStream* coded_input,
+    google::protobuf::io::FileInputStream* raw_input) {
   uint32_t version{};
   if (!coded_input->ReadLittleEndian32(&version)) {
     return ErrorMessage{
@@ -229,12 +265,12 @@ ErrorMessageOr<void> ValidateFileVersion(google::protobuf::io::CodedInputStream*
                         SafeStrerror(raw_input->GetErrno()))};
   }
 
-  if (version != kFileVersion) {
-    return ErrorMessage{
-        absl::StrFormat("Incompatible version %d, expected %d", version, kFileVersion)};
+  if (version != kFileVersion && version != kFileVersionBlockCompressed) {
+    return ErrorMessage{absl::StrFormat("Incompatible version %d, expected %d or %d", version,
+                                        kFileVersion, kFileVersionBlockCompressed)};
   }
 
-  return outcome::success();
+  return version;
 }
 
 // Calculates how large (bytes) a section list (with `number_of_sections` sections) is when written
@@ -248,7 +284,7 @@ ErrorMessageOr<void> CaptureFileImpl::ReadHeader() {
   google::protobuf::io::CodedInputStream coded_input{&raw_input};
 
   OUTCOME_TRY(ValidateSignature(&coded_input, &raw_input));
-  OUTCOME_TRY(ValidateFileVersion(&coded_input, &raw_input));
+  OUTCOME_TRY(version_, ReadAndValidateFileVersion(&coded_input, &raw_input));
 
   CaptureFileHeader header{};
 
@@ -368,10 +404,102 @@ ErrorMessageOr<void> CaptureFileImpl::ReadFromSection(uint64_t section_number,
 }
 
 std::unique_ptr<ProtoSectionInputStream> CaptureFileImpl::CreateCaptureSectionInputStream() {
+  if (IsCaptureSectionBlockCompressed()) {
+    return std::make_unique<
+        orbit_capture_file_internal::BlockCompressedProtoSectionInputStreamImpl>(
+        fd_, header_.capture_section_offset, capture_section_size_);
+  }
   return std::make_unique<orbit_capture_file_internal::ProtoSectionInputStreamImpl>(
       fd_, header_.capture_section_offset, capture_section_size_);
 }
 
+ErrorMessageOr<absl::Span<const uint8_t>> CaptureFileImpl::MapCaptureSection() {
+  if (IsCaptureSectionBlockCompressed()) {
+    return ErrorMessage{"The capture section is block-compressed"};
+  }
+
+#ifdef __linux
+  if (capture_section_size_ == 0) {
+    return ErrorMessage{"The capture section is empty"};
+  }
+
+  if (mapped_address_ == nullptr) {
+    const size_t mapped_size = header_.capture_section_offset + capture_section_size_;
+    void* mapped_address = mmap(nullptr, mapped_size, PROT_READ, MAP_SHARED, fd_.get(), 0);
+    if (mapped_address == MAP_FAILED) {
+      return ErrorMessage{absl::StrFormat("Unable to map capture file \"%s\": %s",
+                                          file_path_.string(), SafeStrerror(errno))};
+    }
+    // The capture section is read from start to end, so aggressive read-ahead pays off.
+    if (madvise(mapped_address, mapped_size, MADV_SEQUENTIAL) != 0) {
+      ORBIT_ERROR("Advising sequential access to capture file \"%s\": %s", file_path_.string(),
+                  SafeStrerror(errno));
+    }
+    mapped_address_ = mapped_address;
+    mapped_size_ = mapped_size;
+  }
+
+  return absl::MakeConstSpan(
+      static_cast<const uint8_t*>(mapped_address_) + header_.capture_section_offset,
+      capture_section_size_);
+#else
+  return ErrorMessage{"Memory mapping capture files is not supported on this platform"};
+#endif
+}
+
+ErrorMessageOr<std::vector<orbit_client_protos::CaptureSectionBlockInfo>>
+CaptureFileImpl::ReadCaptureSectionBlockIndex() {
+  std::optional<uint64_t> section_number = FindSectionByType(kSectionTypeCaptureSectionBlockIndex);
+  if (!IsCaptureSectionBlockCompressed() || !section_number.has_value()) {
+    return std::vector<orbit_client_protos::CaptureSectionBlockInfo>{};
+  }
+
+  // Since file input is not trusted, check that the section fits in the file before allocating
+  // memory for it.
+  const CaptureFileSection& section = section_list_[section_number.value()];
+  OUTCOME_TRY(const uint64_t end_of_file_offset, GetEndOfFileOffset(fd_));
+  if (section.offset > end_of_file_offset || section.size > end_of_file_offset - section.offset) {
+    return ErrorMessage{"The capture section block index extends past the end of the file"};
+  }
+
+  auto section_data = make_unique_for_overwrite<uint8_t[]>(section.size);
+  OUTCOME_TRY(ReadFromSection(section_number.value(), 0, section_data.get(), section.size));
+
+  // Unlike for other sections, the size of the index section is exact, so the messages end exactly
+  // at the end of the section.
+  std::vector<orbit_client_protos::CaptureSectionBlockInfo> block_index;
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section_data.get(), section.size)};
+  while (!scanner.IsAtEnd()) {
+    OUTCOME_TRY(const absl::Span<const uint8_t> message_bytes, scanner.NextMessage());
+    OUTCOME_TRY(
+        ProtoSectionMessageScanner::ParseMessage(message_bytes, &block_index.emplace_back()));
+  }
+  return block_index;
+}
+
+ErrorMessageOr<std::vector<uint8_t>> CaptureFileImpl::ReadCaptureSectionBlock(
+    const orbit_client_protos::CaptureSectionBlockInfo& block_info) const {
+  ORBIT_CHECK(IsCaptureSectionBlockCompressed());
+  if (block_info.offset() >= capture_section_size_) {
+    return ErrorMessage{absl::StrFormat("The block at offset %d is outside of the capture section",
+                                        block_info.offset())};
+  }
+
+  const uint64_t block_offset_in_file = header_.capture_section_offset + block_info.offset();
+  OUTCOME_TRY(const orbit_capture_file_internal::CaptureSectionBlockHeader block_header,
+              orbit_capture_file_internal::ReadCaptureSectionBlockHeader(
+                  fd_, block_offset_in_file, capture_section_size_ - block_info.offset()));
+  if (block_header.compressed_size != block_info.compressed_size() ||
+      block_header.uncompressed_size != block_info.uncompressed_size()) {
+    return ErrorMessage{
+        absl::StrFormat("The block at offset %d does not match the capture section block index",
+                        block_info.offset())};
+  }
+
+  return orbit_capture_file_internal::ReadCaptureSectionBlockData(fd_, block_offset_in_file,
+                                                                  block_header);
+}
+
 std::unique_ptr<ProtoSectionInputStream> CaptureFileImpl::CreateProtoSectionInputStream(
     uint64_t section_number) {
   ORBIT_CHECK(section_number < section_list_.size());
@@ -16,6 +16,22 @@
 constexpr std::string_view kFileSignature = "ORBT";
 static_assert(kFileSignature.size() == 4);
 
+// Version 1 files store the capture events directly in the capture section. Version 2 files store
+// them in independently compressed blocks, and index these blocks in an additional section.
 constexpr uint32_t kFileVersion = 1;
+constexpr uint32_t kFileVersionBlockCompressed = 2;
+
+// Since file input is not trusted, the size of the messages in proto sections is limited to avoid
+// out-of-memory allocations when reading them.
+constexpr uint64_t kMaximumMessageSize = 1024 * 1024;  // 1Mb
+
+// A block of a block-compressed capture section is closed as soon as its uncompressed size reaches
+// this value. Deflate only looks back 32Kb, so larger blocks would barely compress better, while
+// smaller blocks make it possible to decompress in parallel and to skip parts of the capture.
+constexpr uint64_t kCaptureSectionBlockSize = 256 * 1024;  // 256Kb
+// A block is closed after the message that makes it reach kCaptureSectionBlockSize, and a message
+// is preceded by its size, encoded as a varint of at most 10 bytes.
+constexpr uint64_t kMaximumCaptureSectionBlockSize =
+    kCaptureSectionBlockSize + kMaximumMessageSize + 10;
 
 #endif  // CAPTURE_FILE_CONSTANTS_H_
@@ -14,13 +14,20 @@
 #include <stdint.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "CaptureFile/BufferOutputStream.h"
+#include "CaptureFile/CaptureEventTimeRange.h"
+#include "CaptureFile/CaptureFile.h"
+#include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFileConstants.h"
+#include "CaptureSectionBlock.h"
+#include "ClientProtos/capture_section_block_index.pb.h"
 #include "OrbitBase/File.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/SafeStrerror.h"
@@ -31,10 +38,12 @@ namespace {
 
 class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
  public:
-  explicit CaptureFileOutputStreamImpl(std::filesystem::path path)
-      : output_type_(OutputType::kFile), path_{std::move(path)} {}
+  explicit CaptureFileOutputStreamImpl(std::filesystem::path path, Format format)
+      : output_type_(OutputType::kFile), format_(format), path_{std::move(path)} {}
   explicit CaptureFileOutputStreamImpl(BufferOutputStream* output_buffer)
-      : output_type_(OutputType::kBuffer), output_buffer_(output_buffer) {}
+      : output_type_(OutputType::kBuffer),
+        format_(Format::kUncompressed),
+        output_buffer_(output_buffer) {}
   ~CaptureFileOutputStreamImpl() override;
 
   [[nodiscard]] ErrorMessageOr<void> Initialize();
@@ -46,6 +55,9 @@ class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
  private:
   void Reset();
   [[nodiscard]] ErrorMessageOr<void> WriteHeader();
+  void AppendToCurrentBlock(const orbit_grpc_protos::ClientCaptureEvent& event);
+  [[nodiscard]] ErrorMessageOr<void> WriteCurrentBlock();
+  [[nodiscard]] ErrorMessageOr<void> AddBlockIndexSection();
   [[nodiscard]] std::string_view GetErrorFromOutputStream() const;
   // Handles write error by cleaning up the file and generating error message.
   [[nodiscard]] ErrorMessage HandleWriteError(const char* section_name,
@@ -55,15 +67,32 @@ class CaptureFileOutputStreamImpl final : public CaptureFileOutputStream {
 
   enum class OutputType { kFile, kBuffer };
   OutputType output_type_;
+  Format format_;
 
   std::filesystem::path path_;
   orbit_base::UniqueFd fd_;
   BufferOutputStream* output_buffer_ = nullptr;
   std::unique_ptr<google::protobuf::io::ZeroCopyOutputStream> zero_copy_output_stream_;
   std::optional<google::protobuf::io::CodedOutputStream> coded_output_;
+
+  // Only used with Format::kBlockCompressed.
+  std::string current_block_;
+  orbit_client_protos::CaptureSectionBlockInfo current_block_info_;
+  bool current_block_has_timestamps_ = false;
+  bool current_block_has_events_not_filterable_by_time_ = false;
+  std::string compressed_block_;
+  std::vector<orbit_client_protos::CaptureSectionBlockInfo> block_index_;
+  uint64_t capture_section_size_ = 0;
 };
 
 CaptureFileOutputStreamImpl::~CaptureFileOutputStreamImpl() {
+  // With Format::kBlockCompressed, the events of the current block would get lost without
+  // explicitly closing the stream.
+  if (format_ == Format::kBlockCompressed && IsOpen()) {
+    if (ErrorMessageOr<void> result = Close(); result.has_error()) {
+      ORBIT_ERROR("Closing capture file output stream: %s", result.error().message());
+    }
+  }
   // The destructor is not default to make sure close for streams and the file are called in
   // the correct order.
   Reset();
@@ -101,12 +130,22 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::Initialize() {
 }
 
 ErrorMessageOr<void> CaptureFileOutputStreamImpl::Close() {
+  if (format_ == Format::kBlockCompressed) {
+    OUTCOME_TRY(WriteCurrentBlock());
+  }
+
   coded_output_->Trim();
   if (coded_output_->HadError()) {
     return HandleWriteError("Unknown", GetErrorFromOutputStream());
   }
   Reset();
 
+  if (format_ == Format::kBlockCompressed) {
+    if (ErrorMessageOr<void> result = AddBlockIndexSection(); result.has_error()) {
+      return HandleWriteError("Capture Section Block Index", result.error().message());
+    }
+  }
+
   return outcome::success();
 }
 
@@ -162,6 +201,14 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteCaptureEvent(
   ORBIT_CHECK(coded_output_.has_value());
   ORBIT_CHECK(zero_copy_output_stream_ != nullptr);
 
+  if (format_ == Format::kBlockCompressed) {
+    AppendToCurrentBlock(event);
+    if (current_block_.size() >= kCaptureSectionBlockSize) {
+      return WriteCurrentBlock();
+    }
+    return outcome::success();
+  }
+
   uint32_t event_size = event.ByteSizeLong();
   coded_output_->WriteVarint32(event_size);
   if (!event.SerializeToCodedStream(&coded_output_.value()) || coded_output_->HadError()) {
@@ -171,16 +218,97 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteCaptureEvent(
   return outcome::success();
 }
 
+void CaptureFileOutputStreamImpl::AppendToCurrentBlock(
+    const orbit_grpc_protos::ClientCaptureEvent& event) {
+  // ByteSizeLong caches the sizes of the messages, which SerializeWithCachedSizesToArray relies on.
+  const size_t event_size = event.ByteSizeLong();
+  const size_t event_offset = current_block_.size();
+  const size_t size_of_event_size =
+      google::protobuf::io::CodedOutputStream::VarintSize32(static_cast<uint32_t>(event_size));
+  current_block_.resize(event_offset + size_of_event_size + event_size);
+  auto* target = reinterpret_cast<uint8_t*>(current_block_.data() + event_offset);
+  target = google::protobuf::io::CodedOutputStream::WriteVarint32ToArray(
+      static_cast<uint32_t>(event_size), target);
+  event.SerializeWithCachedSizesToArray(target);
+
+  current_block_info_.set_number_of_events(current_block_info_.number_of_events() + 1);
+  if (!IsCaptureEventFilterableByTime(event.event_case())) {
+    current_block_has_events_not_filterable_by_time_ = true;
+  }
+  std::optional<CaptureEventTimeRange> time_range = GetCaptureEventTimeRange(event);
+  if (!time_range.has_value()) return;
+  if (!current_block_has_timestamps_) {
+    current_block_info_.set_min_timestamp_ns(time_range->min_timestamp_ns);
+    current_block_info_.set_max_timestamp_ns(time_range->max_timestamp_ns);
+    current_block_has_timestamps_ = true;
+    return;
+  }
+  current_block_info_.set_min_timestamp_ns(
+      std::min(current_block_info_.min_timestamp_ns(), time_range->min_timestamp_ns));
+  current_block_info_.set_max_timestamp_ns(
+      std::max(current_block_info_.max_timestamp_ns(), time_range->max_timestamp_ns));
+}
+
+ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteCurrentBlock() {
+  if (current_block_.empty()) return outcome::success();
+
+  compressed_block_.clear();
+  orbit_capture_file_internal::AppendCompressedCaptureSectionBlock(current_block_,
+                                                                   &compressed_block_);
+  coded_output_->WriteString(compressed_block_);
+  if (coded_output_->HadError()) {
+    return HandleWriteError("Capture", GetErrorFromOutputStream());
+  }
+
+  current_block_info_.set_offset(capture_section_size_);
+  current_block_info_.set_compressed_size(
+      compressed_block_.size() - sizeof(orbit_capture_file_internal::CaptureSectionBlockHeader));
+  current_block_info_.set_uncompressed_size(current_block_.size());
+  current_block_info_.set_only_events_filterable_by_time(
+      !current_block_has_events_not_filterable_by_time_);
+  block_index_.push_back(std::move(current_block_info_));
+  capture_section_size_ += compressed_block_.size();
+
+  current_block_.clear();
+  current_block_info_.Clear();
+  current_block_has_timestamps_ = false;
+  current_block_has_events_not_filterable_by_time_ = false;
+  return outcome::success();
+}
+
+ErrorMessageOr<void> CaptureFileOutputStreamImpl::AddBlockIndexSection() {
+  ORBIT_CHECK(output_type_ == OutputType::kFile);
+
+  std::string block_index;
+  {
+    google::protobuf::io::StringOutputStream string_output_stream{&block_index};
+    google::protobuf::io::CodedOutputStream coded_output_stream{&string_output_stream};
+    for (const orbit_client_protos::CaptureSectionBlockInfo& block_info : block_index_) {
+      coded_output_stream.WriteVarint32(block_info.ByteSizeLong());
+      block_info.SerializeToCodedStream(&coded_output_stream);
+    }
+  }
+
+  // The capture section is complete at this point, so the section can be added in the same way as
+  // any other additional section.
+  OUTCOME_TRY(auto&& capture_file, CaptureFile::OpenForReadWrite(path_));
+  OUTCOME_TRY(const uint64_t section_number,
+              capture_file->AddAdditionalSectionOfType(kSectionTypeCaptureSectionBlockIndex,
+                                                       block_index.size()));
+  return capture_file->WriteToSection(section_number, 0, block_index.data(), block_index.size());
+}
+
 ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteHeader() {
   ORBIT_CHECK(coded_output_.has_value());
 
+  const uint32_t version =
+      format_ == Format::kBlockCompressed ? kFileVersionBlockCompressed : kFileVersion;
   std::string header{kFileSignature};
-  header.append(std::string_view(absl::bit_cast<char*>(&kFileVersion), sizeof(kFileVersion)));
+  header.append(std::string_view(absl::bit_cast<const char*>(&version), sizeof(version)));
   // signature - 4bytes, version - 4bytes
   // capture section offset - 8 bytes
   // additional section offset - 8 bytes
-  uint64_t capture_section_offset =
-      kFileSignature.size() + sizeof(kFileVersion) + 2 * sizeof(uint64_t);
+  uint64_t capture_section_offset = kFileSignature.size() + sizeof(version) + 2 * sizeof(uint64_t);
   header.append(std::string_view(absl::bit_cast<char*>(&capture_section_offset),
                                  sizeof(capture_section_offset)));
   uint64_t additional_section_list_offset =
@@ -201,8 +329,8 @@ ErrorMessageOr<void> CaptureFileOutputStreamImpl::WriteHeader() {
 }  // namespace
 
 ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>> CaptureFileOutputStream::Create(
-    std::filesystem::path path) {
-  auto implementation = std::make_unique<CaptureFileOutputStreamImpl>(std::move(path));
+    std::filesystem::path path, Format format) {
+  auto implementation = std::make_unique<CaptureFileOutputStreamImpl>(std::move(path), format);
   auto init_result = implementation->Initialize();
   if (init_result.has_error()) {
     return init_result.error();
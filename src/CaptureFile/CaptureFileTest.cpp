@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <absl/base/casts.h>
+#include <absl/types/span.h>
 #include <gmock/gmock.h>
 #include <google/protobuf/io/coded_stream.h>
 #include <google/protobuf/io/zero_copy_stream_impl_lite.h>
@@ -23,8 +24,11 @@
 #include "CaptureFile/CaptureFileOutputStream.h"
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+#include "ClientProtos/capture_section_block_index.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
+#include "OrbitBase/ReadFileToString.h"
 #include "OrbitBase/Result.h"
 #include "OrbitBase/WriteStringToFile.h"
 #include "Test/Path.h"
@@ -118,6 +122,18 @@ class CaptureFileTest : public CaptureFileHeaderTest {
     }
   }
 
+  void VerifyMappedCaptureSectionContent(absl::Span<const uint8_t> capture_section) {
+    ProtoSectionMessageScanner scanner{capture_section};
+    for (const ClientCaptureEvent* expected_event : {&test_event_1, &test_event_2}) {
+      ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+      ASSERT_THAT(message_or_error, HasNoError());
+      ClientCaptureEvent event;
+      ASSERT_THAT(ProtoSectionMessageScanner::ParseMessage(message_or_error.value(), &event),
+                  HasNoError());
+      VerifyEventEquals(event, *expected_event);
+    }
+  }
+
   void OpenTemporayFileAsCaptureFile() {
     auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
     ASSERT_THAT(capture_file_or_error, HasNoError());
@@ -227,6 +243,14 @@ TEST_F(CaptureFileTest, CreateCaptureFileWriteAdditionalSectionAndReadMainSectio
   FAIL() << "More empty messages at end of section than expected.";
 }
 
+TEST_F(CaptureFileTest, MapCaptureSectionAndScanMessages) {
+  ErrorMessageOr<absl::Span<const uint8_t>> capture_section_or_error =
+      capture_file_->MapCaptureSection();
+  ASSERT_THAT(capture_section_or_error, HasNoError());
+
+  VerifyMappedCaptureSectionContent(capture_section_or_error.value());
+}
+
 TEST_F(CaptureFileTest, CreateCaptureFileAndAddUserDataSection) {
   EXPECT_EQ(capture_file_->GetSectionList().size(), 0);
 
@@ -451,4 +475,141 @@ TEST_F(CaptureFileHeaderTest, ModifyExisting) {
   EXPECT_EQ(capture_file->FindAllSectionsByType(kSectionType).size(), number_of_type_sections + 1);
 }
 
-}  // namespace orbit_capture_file
\ No newline at end of file
+TEST_F(CaptureFileHeaderTest, WriteAndReadBlockCompressedCaptureFile) {
+  // Enough events for the capture section to consist of several blocks.
+  constexpr uint64_t kNumberOfFunctionCalls = 50'000;
+  std::vector<ClientCaptureEvent> events;
+  events.push_back(CreateInternedStringCaptureEvent(kAnswerKey, kAnswerString));
+  for (uint64_t i = 0; i < kNumberOfFunctionCalls; ++i) {
+    ClientCaptureEvent& event = events.emplace_back();
+    orbit_grpc_protos::FunctionCall* function_call = event.mutable_function_call();
+    function_call->set_function_id(i % 7);
+    function_call->set_end_timestamp_ns(1'000 + 10 * i);
+    function_call->set_duration_ns(5);
+  }
+  events.emplace_back().mutable_capture_finished();
+
+  {
+    auto output_stream_or_error = CaptureFileOutputStream::Create(
+        GetCaptureFilePath(), CaptureFileOutputStream::Format::kBlockCompressed);
+    ASSERT_THAT(output_stream_or_error, HasNoError());
+    for (const ClientCaptureEvent& event : events) {
+      ASSERT_THAT(output_stream_or_error.value()->WriteCaptureEvent(event), HasNoError());
+    }
+    ASSERT_THAT(output_stream_or_error.value()->Close(), HasNoError());
+  }
+
+  auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
+  ASSERT_THAT(capture_file_or_error, HasNoError());
+  std::unique_ptr<CaptureFile> capture_file = std::move(capture_file_or_error.value());
+  EXPECT_TRUE(capture_file->IsCaptureSectionBlockCompressed());
+  EXPECT_THAT(capture_file->MapCaptureSection(), HasErrorWithMessage("block-compressed"));
+
+  // The whole capture section can be read sequentially.
+  {
+    auto capture_section = capture_file->CreateCaptureSectionInputStream();
+    for (const ClientCaptureEvent& expected_event : events) {
+      ClientCaptureEvent event;
+      ASSERT_THAT(capture_section->ReadMessage(&event), HasNoError());
+      ASSERT_EQ(event.SerializeAsString(), expected_event.SerializeAsString());
+    }
+    ClientCaptureEvent event;
+    EXPECT_THAT(capture_section->ReadMessage(&event), HasErrorWithMessage("Unexpected end"));
+  }
+
+  // The blocks can be read independently through the index.
+  ErrorMessageOr<std::vector<orbit_client_protos::CaptureSectionBlockInfo>> block_index_or_error =
+      capture_file->ReadCaptureSectionBlockIndex();
+  ASSERT_THAT(block_index_or_error, HasNoError());
+  const std::vector<orbit_client_protos::CaptureSectionBlockInfo>& block_index =
+      block_index_or_error.value();
+  ASSERT_GT(block_index.size(), 1);
+
+  size_t event_index = 0;
+  uint64_t expected_block_offset = 0;
+  for (const orbit_client_protos::CaptureSectionBlockInfo& block_info : block_index) {
+    EXPECT_EQ(block_info.offset(), expected_block_offset);
+    expected_block_offset += 8 + block_info.compressed_size();
+    EXPECT_LT(block_info.compressed_size(), block_info.uncompressed_size());
+    EXPECT_LE(block_info.min_timestamp_ns(), block_info.max_timestamp_ns());
+
+    ErrorMessageOr<std::vector<uint8_t>> block_or_error =
+        capture_file->ReadCaptureSectionBlock(block_info);
+    ASSERT_THAT(block_or_error, HasNoError());
+    ASSERT_EQ(block_or_error.value().size(), block_info.uncompressed_size());
+
+    ProtoSectionMessageScanner scanner{absl::MakeConstSpan(block_or_error.value())};
+    uint64_t number_of_events = 0;
+    while (!scanner.IsAtEnd()) {
+      ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+      ASSERT_THAT(message_or_error, HasNoError());
+      ClientCaptureEvent event;
+      ASSERT_THAT(ProtoSectionMessageScanner::ParseMessage(message_or_error.value(), &event),
+                  HasNoError());
+      ASSERT_LT(event_index, events.size());
+      EXPECT_EQ(event.SerializeAsString(), events[event_index].SerializeAsString());
+      if (event.has_function_call()) {
+        EXPECT_GE(event.function_call().end_timestamp_ns() - event.function_call().duration_ns(),
+                  block_info.min_timestamp_ns());
+        EXPECT_LE(event.function_call().end_timestamp_ns(), block_info.max_timestamp_ns());
+      }
+      ++event_index;
+      ++number_of_events;
+    }
+    EXPECT_EQ(number_of_events, block_info.number_of_events());
+  }
+  EXPECT_EQ(event_index, events.size());
+  EXPECT_EQ(block_index.front().min_timestamp_ns(), 995);
+  EXPECT_EQ(block_index.back().max_timestamp_ns(), 1'000 + 10 * (kNumberOfFunctionCalls - 1));
+  // Only the first and the last block contain an event that is not filterable by time, the
+  // InternedString and the CaptureFinished event, respectively.
+  ASSERT_GT(block_index.size(), 2);
+  EXPECT_FALSE(block_index.front().only_events_filterable_by_time());
+  EXPECT_TRUE(block_index[1].only_events_filterable_by_time());
+  EXPECT_FALSE(block_index.back().only_events_filterable_by_time());
+
+  // A user data section can still be added.
+  EXPECT_THAT(capture_file->AddUserDataSection(100), HasNoError());
+}
+
+TEST_F(CaptureFileHeaderTest, ReadBlockCompressedCaptureFileWithoutIndex) {
+  {
+    auto output_stream_or_error = CaptureFileOutputStream::Create(
+        GetCaptureFilePath(), CaptureFileOutputStream::Format::kBlockCompressed);
+    ASSERT_THAT(output_stream_or_error, HasNoError());
+    ASSERT_THAT(output_stream_or_error.value()->WriteCaptureEvent(
+                    CreateInternedStringCaptureEvent(kAnswerKey, kAnswerString)),
+                HasNoError());
+    ASSERT_THAT(output_stream_or_error.value()->Close(), HasNoError());
+  }
+
+  // Drop the index and the section list, as if the capture had not been saved completely.
+  {
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+    const CaptureFileSection& index_section = capture_file_or_error.value()->GetSectionList()[0];
+    ASSERT_EQ(index_section.type, kSectionTypeCaptureSectionBlockIndex);
+    ErrorMessageOr<std::string> content_or_error =
+        orbit_base::ReadFileToString(GetCaptureFilePath());
+    ASSERT_THAT(content_or_error, HasNoError());
+    std::string content = content_or_error.value().substr(0, index_section.offset);
+    constexpr uint64_t kNoSectionList = 0;
+    content.replace(
+        16, sizeof(kNoSectionList),
+        std::string_view{absl::bit_cast<const char*>(&kNoSectionList), sizeof(kNoSectionList)});
+    capture_file_or_error.value().reset();
+    ASSERT_THAT(orbit_base::WriteStringToFile(GetCaptureFilePath(), content), HasNoError());
+  }
+
+  auto capture_file_or_error = CaptureFile::OpenForReadWrite(GetCaptureFilePath());
+  ASSERT_THAT(capture_file_or_error, HasNoError());
+  EXPECT_THAT(capture_file_or_error.value()->ReadCaptureSectionBlockIndex(), HasValue());
+  EXPECT_TRUE(capture_file_or_error.value()->ReadCaptureSectionBlockIndex().value().empty());
+
+  auto capture_section = capture_file_or_error.value()->CreateCaptureSectionInputStream();
+  ClientCaptureEvent event;
+  ASSERT_THAT(capture_section->ReadMessage(&event), HasNoError());
+  EXPECT_EQ(event.interned_string().intern(), kAnswerString);
+}
+
+}  // namespace orbit_capture_file
@@ -0,0 +1,82 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureSectionBlock.h"
+
+#include <absl/strings/str_format.h>
+#include <zlib.h>
+
+#include <cstring>
+
+#include "CaptureFileConstants.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/MakeUniqueForOverwrite.h"
+
+namespace orbit_capture_file_internal {
+
+// Favor the speed of compression, as blocks are compressed while the capture is being taken.
+static constexpr int kCompressionLevel = Z_BEST_SPEED;
+
+void AppendCompressedCaptureSectionBlock(std::string_view uncompressed_block, std::string* output) {
+  const size_t header_offset = output->size();
+  uLongf compressed_size = compressBound(uncompressed_block.size());
+  output->resize(header_offset + sizeof(CaptureSectionBlockHeader) + compressed_size);
+  auto* compressed_data =
+      reinterpret_cast<Bytef*>(output->data() + header_offset + sizeof(CaptureSectionBlockHeader));
+  const int result = compress2(compressed_data, &compressed_size,
+                               reinterpret_cast<const Bytef*>(uncompressed_block.data()),
+                               uncompressed_block.size(), kCompressionLevel);
+  // Compressing into a buffer of compressBound bytes can only fail when running out of memory.
+  ORBIT_CHECK(result == Z_OK);
+  output->resize(header_offset + sizeof(CaptureSectionBlockHeader) + compressed_size);
+
+  const CaptureSectionBlockHeader header{static_cast<uint32_t>(compressed_size),
+                                         static_cast<uint32_t>(uncompressed_block.size())};
+  std::memcpy(output->data() + header_offset, &header, sizeof(header));
+}
+
+ErrorMessageOr<CaptureSectionBlockHeader> ReadCaptureSectionBlockHeader(
+    const orbit_base::UniqueFd& fd, uint64_t offset, uint64_t bytes_left_in_section) {
+  if (bytes_left_in_section < sizeof(CaptureSectionBlockHeader)) {
+    return ErrorMessage{"Unexpected end of section while reading block header"};
+  }
+
+  OUTCOME_TRY(auto&& header, orbit_base::ReadFullyAtOffset<CaptureSectionBlockHeader>(fd, offset));
+
+  // Since file input is not trusted, the sizes are validated before allocating memory for the
+  // block.
+  if (header.uncompressed_size > kMaximumCaptureSectionBlockSize) {
+    return ErrorMessage{
+        absl::StrFormat("The block size %d is too big (maximum allowed block size is %d)",
+                        header.uncompressed_size, kMaximumCaptureSectionBlockSize)};
+  }
+  if (header.compressed_size > bytes_left_in_section - sizeof(CaptureSectionBlockHeader)) {
+    return ErrorMessage{"Unexpected end of section while reading the block"};
+  }
+
+  return header;
+}
+
+ErrorMessageOr<std::vector<uint8_t>> ReadCaptureSectionBlockData(
+    const orbit_base::UniqueFd& fd, uint64_t offset, const CaptureSectionBlockHeader& header) {
+  auto compressed_data = make_unique_for_overwrite<uint8_t[]>(header.compressed_size);
+  OUTCOME_TRY(auto&& bytes_read,
+              orbit_base::ReadFullyAtOffset(fd, compressed_data.get(), header.compressed_size,
+                                            offset + sizeof(CaptureSectionBlockHeader)));
+  if (bytes_read < header.compressed_size) {
+    return ErrorMessage{"Unexpected end of file while reading the block"};
+  }
+
+  std::vector<uint8_t> uncompressed_data(header.uncompressed_size);
+  uLongf uncompressed_size = header.uncompressed_size;
+  const int result = uncompress(uncompressed_data.data(), &uncompressed_size, compressed_data.get(),
+                                header.compressed_size);
+  if (result != Z_OK || uncompressed_size != header.uncompressed_size) {
+    return ErrorMessage{absl::StrFormat("Unable to decompress the block at offset %d", offset)};
+  }
+
+  return uncompressed_data;
+}
+
+}  // namespace orbit_capture_file_internal
@@ -0,0 +1,45 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_SECTION_BLOCK_H_
+#define CAPTURE_SECTION_BLOCK_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "OrbitBase/File.h"
+#include "OrbitBase/Result.h"
+
+namespace orbit_capture_file_internal {
+
+// Every block of a block-compressed capture section starts with this header, followed by
+// `compressed_size` bytes of zlib-compressed data. Once decompressed, a block is a sequence of
+// complete length-delimited messages, just like the capture section of a version 1 file.
+struct CaptureSectionBlockHeader {
+  uint32_t compressed_size;
+  uint32_t uncompressed_size;
+};
+static_assert(sizeof(CaptureSectionBlockHeader) == 8);
+
+// Compresses `uncompressed_block` and appends the resulting block, including its header, to
+// `output`.
+void AppendCompressedCaptureSectionBlock(std::string_view uncompressed_block, std::string* output);
+
+// Reads and validates the header of the block at `offset` in the file. `bytes_left_in_section` is
+// the number of bytes from `offset` to the end of the capture section, as the block must not
+// extend past it.
+ErrorMessageOr<CaptureSectionBlockHeader> ReadCaptureSectionBlockHeader(
+    const orbit_base::UniqueFd& fd, uint64_t offset, uint64_t bytes_left_in_section);
+
+// Reads and decompresses the data of the block at `offset` in the file, whose header was returned
+// by ReadCaptureSectionBlockHeader.
+ErrorMessageOr<std::vector<uint8_t>> ReadCaptureSectionBlockData(
+    const orbit_base::UniqueFd& fd, uint64_t offset, const CaptureSectionBlockHeader& header);
+
+}  // namespace orbit_capture_file_internal
+
+#endif  // CAPTURE_SECTION_BLOCK_H_
@@ -5,15 +5,16 @@
 #include "ProtoSectionInputStreamImpl.h"
 
 #include <absl/strings/str_format.h>
+#include <absl/types/span.h>
 
 #include <memory>
 
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+#include "CaptureFileConstants.h"
 #include "OrbitBase/MakeUniqueForOverwrite.h"
 
 namespace orbit_capture_file_internal {
 
-constexpr uint64_t kMaximumMessageSize = 1024 * 1024;  // 1Mb
-
 ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessage(google::protobuf::Message* message) {
   // CodedInputStream imposes a hard limit on the total number of bytes it will read. It's INT_MAX
   // by default and it cannot be increased past that. To work around the limitation, reinitialize
@@ -49,15 +50,8 @@ ErrorMessageOr<void> ProtoSectionInputStreamImpl::ReadMessage(google::protobuf::
         ErrorMessage{"Unexpected end of section while reading the message"});
   }
 
-  message->ParseFromArray(buf.get(), message_size);
-
-  if (message->ByteSizeLong() != message_size) {
-    return ErrorMessage{absl::StrFormat(
-        "The message size %d of the parsed message is different from the parsed size %d",
-        message->ByteSizeLong(), message_size)};
-  }
-
-  return outcome::success();
+  return orbit_capture_file::ProtoSectionMessageScanner::ParseMessage(
+      absl::MakeConstSpan(buf.get(), message_size), message);
 }
 
 }  // namespace orbit_capture_file_internal
\ No newline at end of file
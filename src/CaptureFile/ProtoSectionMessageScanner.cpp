@@ -0,0 +1,59 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+
+#include <absl/strings/str_format.h>
+
+#include "CaptureFileConstants.h"
+
+namespace orbit_capture_file {
+
+// A varint encodes 7 bits per byte, so a uint64_t takes at most 10 bytes.
+static constexpr size_t kMaxVarintSize = 10;
+
+ErrorMessageOr<absl::Span<const uint8_t>> ProtoSectionMessageScanner::NextMessage() {
+  uint64_t message_size = 0;
+  size_t varint_size = 0;
+  while (true) {
+    if (position_ + varint_size >= section_.size() || varint_size == kMaxVarintSize) {
+      return ErrorMessage{"Unexpected end of section while reading message size"};
+    }
+    const uint8_t byte = section_[position_ + varint_size];
+    message_size |= static_cast<uint64_t>(byte & 0x7f) << (7 * varint_size);
+    ++varint_size;
+    if ((byte & 0x80) == 0) break;
+  }
+
+  // Since file input is not trusted, having too big value here may lead to out-of-memory allocation
+  // when parsing the message. We limit our messages to 1Mb maximum size.
+  if (message_size > kMaximumMessageSize) {
+    return ErrorMessage{
+        absl::StrFormat("The message size %d is too big (maximum allowed message size is %d)",
+                        message_size, kMaximumMessageSize)};
+  }
+
+  if (message_size > section_.size() - position_ - varint_size) {
+    return ErrorMessage{"Unexpected end of section while reading the message"};
+  }
+
+  absl::Span<const uint8_t> message_bytes = section_.subspan(position_ + varint_size, message_size);
+  position_ += varint_size + message_size;
+  return message_bytes;
+}
+
+ErrorMessageOr<void> ProtoSectionMessageScanner::ParseMessage(
+    absl::Span<const uint8_t> message_bytes, google::protobuf::Message* message) {
+  message->ParseFromArray(message_bytes.data(), static_cast<int>(message_bytes.size()));
+
+  if (message->ByteSizeLong() != message_bytes.size()) {
+    return ErrorMessage{absl::StrFormat(
+        "The message size %d of the parsed message is different from the parsed size %d",
+        message->ByteSizeLong(), message_bytes.size())};
+  }
+
+  return outcome::success();
+}
+
+}  // namespace orbit_capture_file
@@ -0,0 +1,107 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/types/span.h>
+#include <gmock/gmock.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CaptureFile/ProtoSectionMessageScanner.h"
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Result.h"
+#include "TestUtils/TestUtils.h"
+
+namespace orbit_capture_file {
+
+using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_test_utils::HasErrorWithMessage;
+using orbit_test_utils::HasNoError;
+
+static ClientCaptureEvent CreateInternedStringCaptureEvent(uint64_t key, std::string str) {
+  ClientCaptureEvent event;
+  orbit_grpc_protos::InternedString* interned_string = event.mutable_interned_string();
+  interned_string->set_key(key);
+  interned_string->set_intern(std::move(str));
+  return event;
+}
+
+static std::vector<uint8_t> SerializeDelimited(const std::vector<ClientCaptureEvent>& events) {
+  std::string buffer;
+  {
+    google::protobuf::io::StringOutputStream string_stream{&buffer};
+    google::protobuf::io::CodedOutputStream coded_stream{&string_stream};
+    for (const ClientCaptureEvent& event : events) {
+      coded_stream.WriteVarint32(event.ByteSizeLong());
+      event.SerializeToCodedStream(&coded_stream);
+    }
+  }
+  return {buffer.begin(), buffer.end()};
+}
+
+TEST(ProtoSectionMessageScanner, ScansAndParsesAllMessages) {
+  const std::vector<ClientCaptureEvent> events{CreateInternedStringCaptureEvent(1, "one"),
+                                               CreateInternedStringCaptureEvent(2, "two"),
+                                               CreateInternedStringCaptureEvent(3, "three")};
+  const std::vector<uint8_t> section = SerializeDelimited(events);
+
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section)};
+  for (const ClientCaptureEvent& expected_event : events) {
+    ASSERT_FALSE(scanner.IsAtEnd());
+    ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+    ASSERT_THAT(message_or_error, HasNoError());
+
+    ClientCaptureEvent event;
+    ASSERT_THAT(ProtoSectionMessageScanner::ParseMessage(message_or_error.value(), &event),
+                HasNoError());
+    EXPECT_EQ(event.interned_string().key(), expected_event.interned_string().key());
+    EXPECT_EQ(event.interned_string().intern(), expected_event.interned_string().intern());
+  }
+  EXPECT_TRUE(scanner.IsAtEnd());
+  EXPECT_THAT(scanner.NextMessage(),
+              HasErrorWithMessage("Unexpected end of section while reading message size"));
+}
+
+TEST(ProtoSectionMessageScanner, TruncatedMessageSize) {
+  // The continuation bit of the only byte is set, but the section ends.
+  const std::vector<uint8_t> section{0x80};
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section)};
+  EXPECT_THAT(scanner.NextMessage(),
+              HasErrorWithMessage("Unexpected end of section while reading message size"));
+}
+
+TEST(ProtoSectionMessageScanner, TruncatedMessage) {
+  std::vector<uint8_t> section =
+      SerializeDelimited({CreateInternedStringCaptureEvent(1, "truncated")});
+  section.pop_back();
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section)};
+  EXPECT_THAT(scanner.NextMessage(),
+              HasErrorWithMessage("Unexpected end of section while reading the message"));
+}
+
+TEST(ProtoSectionMessageScanner, MessageTooBig) {
+  // Varint encoding of 2^21, which is bigger than the maximum message size of 1Mb.
+  const std::vector<uint8_t> section{0x80, 0x80, 0x80, 0x01};
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section)};
+  EXPECT_THAT(scanner.NextMessage(), HasErrorWithMessage("is too big"));
+}
+
+TEST(ProtoSectionMessageScanner, EmptyMessages) {
+  // Zero padding after the last message scans as empty messages.
+  const std::vector<uint8_t> section{0, 0};
+  ProtoSectionMessageScanner scanner{absl::MakeConstSpan(section)};
+  for (int i = 0; i < 2; ++i) {
+    ErrorMessageOr<absl::Span<const uint8_t>> message_or_error = scanner.NextMessage();
+    ASSERT_THAT(message_or_error, HasNoError());
+    EXPECT_TRUE(message_or_error.value().empty());
+  }
+  EXPECT_TRUE(scanner.IsAtEnd());
+}
+
+}  // namespace orbit_capture_file
@@ -0,0 +1,37 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_FILE_CAPTURE_EVENT_TIME_RANGE_H_
+#define CAPTURE_FILE_CAPTURE_EVENT_TIME_RANGE_H_
+
+#include <stdint.h>
+
+#include <optional>
+
+#include "GrpcProtos/capture.pb.h"
+
+namespace orbit_capture_file {
+
+struct CaptureEventTimeRange {
+  uint64_t min_timestamp_ns;
+  uint64_t max_timestamp_ns;
+};
+
+// Returns the range covered by the timestamps of the event, e.g., from the start to the end of a
+// FunctionCall, or std::nullopt if the event carries no timestamp, like InternedString.
+[[nodiscard]] std::optional<CaptureEventTimeRange> GetCaptureEventTimeRange(
+    const orbit_grpc_protos::ClientCaptureEvent& event);
+
+// Returns whether events of this type can be left out when only loading the events of a window of
+// time, which is the case if their time range does not overlap with the window. All other events,
+// like InternedString, ModulesSnapshot or ThreadName, are needed to make sense of the events in
+// the window, and need to be loaded regardless of their timestamps. This also applies to the starts
+// and stops of Orbit API scopes, which cannot be filtered one by one, as a scope can overlap with
+// the window while its start and stop are both outside of it.
+[[nodiscard]] bool IsCaptureEventFilterableByTime(
+    orbit_grpc_protos::ClientCaptureEvent::EventCase event_case);
+
+}  // namespace orbit_capture_file
+
+#endif  // CAPTURE_FILE_CAPTURE_EVENT_TIME_RANGE_H_
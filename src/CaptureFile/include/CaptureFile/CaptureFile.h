@@ -5,6 +5,7 @@
 #ifndef CAPTURE_FILE_CAPTURE_FILE_H_
 #define CAPTURE_FILE_CAPTURE_FILE_H_
 
+#include <absl/types/span.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -15,6 +16,7 @@
 
 #include "CaptureFile/CaptureFileSection.h"
 #include "CaptureFile/ProtoSectionInputStream.h"
+#include "ClientProtos/capture_section_block_index.pb.h"
 #include "OrbitBase/Result.h"
 
 namespace orbit_capture_file {
@@ -71,6 +73,29 @@ class CaptureFile {
 
   virtual std::unique_ptr<ProtoSectionInputStream> CreateCaptureSectionInputStream() = 0;
 
+  // Maps the capture section into memory, so that its messages can be found with a
+  // ProtoSectionMessageScanner and parsed without first copying them. The mapping stays valid as
+  // long as this object. Returns an error if memory mapping is not supported on this platform or if
+  // the capture section is block-compressed, in which case CreateCaptureSectionInputStream can
+  // still be used.
+  virtual ErrorMessageOr<absl::Span<const uint8_t>> MapCaptureSection() = 0;
+
+  // Returns whether the capture section consists of independently compressed blocks, which is the
+  // case for files of version 2 of the format. CreateCaptureSectionInputStream transparently
+  // decompresses these blocks.
+  [[nodiscard]] virtual bool IsCaptureSectionBlockCompressed() const = 0;
+
+  // Reads the index of the blocks of a block-compressed capture section, in the order of the
+  // blocks. Returns an empty vector if the file has no such index, for example because the capture
+  // was not saved completely.
+  virtual ErrorMessageOr<std::vector<orbit_client_protos::CaptureSectionBlockInfo>>
+  ReadCaptureSectionBlockIndex() = 0;
+
+  // Reads and decompresses a block of the capture section, as returned by
+  // ReadCaptureSectionBlockIndex. This can be called from multiple threads concurrently.
+  [[nodiscard]] virtual ErrorMessageOr<std::vector<uint8_t>> ReadCaptureSectionBlock(
+      const orbit_client_protos::CaptureSectionBlockInfo& block_info) const = 0;
+
   static ErrorMessageOr<std::unique_ptr<CaptureFile>> OpenForReadWrite(
       const std::filesystem::path& file_path);
 
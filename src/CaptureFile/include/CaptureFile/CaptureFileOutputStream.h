@@ -44,6 +44,12 @@ namespace orbit_capture_file {
 // Note: Write after close or error will result in CHECK failure.
 class CaptureFileOutputStream {
  public:
+  // kUncompressed (version 1 of the format) writes each event to the capture section as it comes.
+  // kBlockCompressed (version 2) collects the events in blocks that are compressed independently
+  // of each other, and adds an index of the blocks to the file when the stream is closed. This
+  // makes files much smaller and allows to decompress them in parallel when loading them.
+  enum class Format { kUncompressed, kBlockCompressed };
+
   virtual ~CaptureFileOutputStream() = default;
   [[nodiscard]] virtual ErrorMessageOr<void> WriteCaptureEvent(
       const orbit_grpc_protos::ClientCaptureEvent& event) = 0;
@@ -54,7 +60,9 @@ class CaptureFileOutputStream {
   // Create new capture file output stream. If the file exists it is going to be
   // overwritten.
   [[nodiscard]] static ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>> Create(
-      std::filesystem::path path);
+      std::filesystem::path path, Format format = Format::kUncompressed);
+  // The buffer is consumed while the capture is being written, so the header cannot be updated
+  // anymore when the stream is closed. Hence, this always uses Format::kUncompressed.
   [[nodiscard]] static std::unique_ptr<CaptureFileOutputStream> Create(
       BufferOutputStream* output_buffer);
 };
@@ -10,6 +10,7 @@
 namespace orbit_capture_file {
 
 constexpr uint64_t kSectionTypeUserData = 1;
+constexpr uint64_t kSectionTypeCaptureSectionBlockIndex = 2;
 
 struct CaptureFileSection {
   uint64_t type;
@@ -0,0 +1,45 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_FILE_PROTO_SECTION_MESSAGE_SCANNER_H_
+#define CAPTURE_FILE_PROTO_SECTION_MESSAGE_SCANNER_H_
+
+#include <absl/types/span.h>
+#include <google/protobuf/message.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "OrbitBase/Result.h"
+
+namespace orbit_capture_file {
+
+// This class finds the boundaries of the length-delimited messages of a proto section that is
+// entirely in memory, e.g., the capture section returned by CaptureFile::MapCaptureSection(),
+// without parsing them. The messages can then be parsed independently of each other, for example
+// in parallel, with ParseMessage.
+class ProtoSectionMessageScanner {
+ public:
+  explicit ProtoSectionMessageScanner(absl::Span<const uint8_t> section) : section_{section} {}
+
+  // Returns the bytes of the next message, without its size prefix. The same caveat as for
+  // ProtoSectionInputStream::ReadMessage applies: the caller should not rely on what follows the
+  // orbit_grpc_protos::CaptureFinished message in the capture section, which is padding that
+  // scans as empty messages until finally causing an end of section error.
+  ErrorMessageOr<absl::Span<const uint8_t>> NextMessage();
+
+  [[nodiscard]] bool IsAtEnd() const { return position_ == section_.size(); }
+
+  // Parses a message returned by NextMessage into `message`, validating it in the same way as
+  // ProtoSectionInputStream::ReadMessage does.
+  static ErrorMessageOr<void> ParseMessage(absl::Span<const uint8_t> message_bytes,
+                                           google::protobuf::Message* message);
+
+ private:
+  absl::Span<const uint8_t> section_;
+  size_t position_ = 0;
+};
+
+}  // namespace orbit_capture_file
+
+#endif  // CAPTURE_FILE_PROTO_SECTION_MESSAGE_SCANNER_H_
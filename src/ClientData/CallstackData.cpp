@@ -23,8 +23,8 @@ void CallstackData::AddCallstackEvent(CallstackEvent callstack_event) {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   ORBIT_CHECK(unique_callstacks_.contains(callstack_event.callstack_id()));
   RegisterTime(callstack_event.timestamp_ns());
-  callstack_events_by_tid_[callstack_event.thread_id()].emplace(callstack_event.timestamp_ns(),
-                                                                callstack_event);
+  callstack_events_by_tid_[callstack_event.thread_id()].Insert(callstack_event.timestamp_ns(),
+                                                               callstack_event.callstack_id());
 }
 
 void CallstackData::RegisterTime(uint64_t time) {
@@ -50,16 +50,10 @@ std::vector<orbit_client_data::CallstackEvent> CallstackData::GetCallstackEvents
     uint64_t time_begin, uint64_t time_end) const {
   std::lock_guard<std::recursive_mutex> lock(mutex_);
   std::vector<CallstackEvent> callstack_events;
-  for (const auto& tid_and_events : callstack_events_by_tid_) {
-    const absl::btree_map<uint64_t, CallstackEvent>& events = tid_and_events.second;
-    for (auto event_it = events.lower_bound(time_begin); event_it != events.end(); ++event_it) {
-      uint64_t time = event_it->first;
-      if (time < time_end) {
-        callstack_events.push_back(event_it->second);
-      } else {
-        break;
-      }
-    }
+  for (const auto& [tid, events] : callstack_events_by_tid_) {
+    ForEachCallstackEventInIndexRange(
+        tid, events, events.LowerBound(time_begin), events.LowerBound(time_end),
+        [&callstack_events](const CallstackEvent& event) { callstack_events.push_back(event); });
   }
   return callstack_events;
 }
@@ -83,15 +77,14 @@ std::vector<CallstackEvent> CallstackData::GetCallstackEventsOfTidInTimeRange(
     return callstack_events;
   }
 
-  const absl::btree_map<uint64_t, CallstackEvent>& events = tid_and_events_it->second;
-  for (auto event_it = events.lower_bound(time_begin); event_it != events.end(); ++event_it) {
-    uint64_t time = event_it->first;
-    if (time < time_end) {
-      callstack_events.push_back(event_it->second);
-    } else {
-      break;
-    }
-  }
+  const CallstackEventColumns& events = tid_and_events_it->second;
+  if (time_begin >= time_end) return callstack_events;
+  const size_t begin_index = events.LowerBound(time_begin);
+  const size_t end_index = events.LowerBound(time_end);
+  callstack_events.reserve(end_index - begin_index);
+  ForEachCallstackEventInIndexRange(
+      tid, events, begin_index, end_index,
+      [&callstack_events](const CallstackEvent& event) { callstack_events.push_back(event); });
   return callstack_events;
 }
 
@@ -107,7 +100,7 @@ void CallstackData::AddCallstackFromKnownCallstackData(const CallstackEvent& eve
 
   // The insertion only happens if the hash isn't already present.
   unique_callstacks_.emplace(callstack_id, std::move(unique_callstack));
-  callstack_events_by_tid_[event.thread_id()].emplace(event.timestamp_ns(), event);
+  callstack_events_by_tid_[event.thread_id()].Insert(event.timestamp_ns(), callstack_id);
 }
 
 const CallstackInfo* CallstackData::GetCallstack(uint64_t callstack_id) const {
@@ -155,13 +148,13 @@ void CallstackData::UpdateCallstackTypeBasedOnMajorityStart(
 
   absl::flat_hash_set<uint64_t> callstack_ids_to_filter;
 
-  for (auto& [tid, timestamps_and_callstack_events] : callstack_events_by_tid_) {
+  for (auto& [tid, events] : callstack_events_by_tid_) {
     uint64_t count_for_this_thread = 0;
 
     // Count the number of occurrences of each outer frame for this thread.
     absl::flat_hash_map<uint64_t, uint64_t> count_by_outer_frame;
-    for (const auto& [unused_timestamp_ns, event] : timestamps_and_callstack_events) {
-      const CallstackInfo& callstack = *unique_callstacks_.at(event.callstack_id());
+    for (uint64_t callstack_id : events.callstack_ids()) {
+      const CallstackInfo& callstack = *unique_callstacks_.at(callstack_id);
       ORBIT_CHECK(callstack.type() != CallstackType::kFilteredByMajorityOutermostFrame);
       if (callstack.type() != CallstackType::kComplete) {
         continue;
@@ -206,20 +199,20 @@ void CallstackData::UpdateCallstackTypeBasedOnMajorityStart(
     // doesn't match the (super)majority outer frame.
     // Note that if a CallstackEvent from another thread references a filtered CallstackInfo, that
     // CallstackEvent will also be affected.
-    for (const auto& [unused_timestamp_ns, event] : timestamps_and_callstack_events) {
-      const CallstackInfo& callstack = *unique_callstacks_.at(event.callstack_id());
+    for (uint64_t callstack_id : events.callstack_ids()) {
+      const CallstackInfo& callstack = *unique_callstacks_.at(callstack_id);
       ORBIT_CHECK(callstack.type() != CallstackType::kFilteredByMajorityOutermostFrame);
       if (callstack.type() != CallstackType::kComplete) {
         continue;
       }
 
-      const auto& frames = unique_callstacks_.at(event.callstack_id())->frames();
+      const auto& frames = callstack.frames();
       ORBIT_CHECK(!frames.empty());
       uint64_t outermost_frame = *frames.rbegin();
       if (outermost_frame != majority_outer_frame &&
           !IsPcInFunctionsToStopUnwindingAt(
               absolute_address_to_size_of_functions_to_stop_unwinding_at, outermost_frame)) {
-        callstack_ids_to_filter.insert(event.callstack_id());
+        callstack_ids_to_filter.insert(callstack_id);
       }
     }
   }
@@ -233,9 +226,9 @@ void CallstackData::UpdateCallstackTypeBasedOnMajorityStart(
 
   // Count how many CallstackEvents had their CallstackInfo affected by the type change.
   uint64_t affected_event_count = 0;
-  for (auto& [tid, timestamps_and_callstack_events] : callstack_events_by_tid_) {
-    for (const auto& [unused_timestamp_ns, event] : timestamps_and_callstack_events) {
-      if (unique_callstacks_.at(event.callstack_id())->type() ==
+  for (const auto& [unused_tid, events] : callstack_events_by_tid_) {
+    for (uint64_t callstack_id : events.callstack_ids()) {
+      if (unique_callstacks_.at(callstack_id)->type() ==
           CallstackType::kFilteredByMajorityOutermostFrame) {
         ++affected_event_count;
       }
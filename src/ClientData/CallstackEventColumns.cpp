@@ -0,0 +1,36 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/CallstackEventColumns.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace orbit_client_data {
+
+bool CallstackEventColumns::Insert(uint64_t timestamp_ns, uint64_t callstack_id) {
+  if (timestamps_ns_.empty() || timestamps_ns_.back() < timestamp_ns) {
+    timestamps_ns_.push_back(timestamp_ns);
+    callstack_ids_.push_back(callstack_id);
+    return true;
+  }
+
+  const size_t index = LowerBound(timestamp_ns);
+  if (timestamps_ns_[index] == timestamp_ns) return false;
+  timestamps_ns_.insert(timestamps_ns_.begin() + index, timestamp_ns);
+  callstack_ids_.insert(callstack_ids_.begin() + index, callstack_id);
+  return true;
+}
+
+size_t CallstackEventColumns::LowerBound(uint64_t timestamp_ns) const {
+  auto it = std::lower_bound(timestamps_ns_.begin(), timestamps_ns_.end(), timestamp_ns);
+  return std::distance(timestamps_ns_.begin(), it);
+}
+
+size_t CallstackEventColumns::UpperBound(uint64_t timestamp_ns) const {
+  auto it = std::upper_bound(timestamps_ns_.begin(), timestamps_ns_.end(), timestamp_ns);
+  return std::distance(timestamps_ns_.begin(), it);
+}
+
+}  // namespace orbit_client_data
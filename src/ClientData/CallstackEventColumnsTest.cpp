@@ -0,0 +1,70 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "ClientData/CallstackEventColumns.h"
+
+using ::testing::ElementsAre;
+
+namespace orbit_client_data {
+
+TEST(CallstackEventColumns, AppendsEventsInTimestampOrder) {
+  CallstackEventColumns events;
+  EXPECT_TRUE(events.empty());
+
+  EXPECT_TRUE(events.Insert(10, 1));
+  EXPECT_TRUE(events.Insert(20, 2));
+  EXPECT_TRUE(events.Insert(30, 1));
+
+  EXPECT_EQ(events.size(), 3);
+  EXPECT_THAT(events.timestamps_ns(), ElementsAre(10, 20, 30));
+  EXPECT_THAT(events.callstack_ids(), ElementsAre(1, 2, 1));
+  EXPECT_EQ(events.timestamp_ns(1), 20);
+  EXPECT_EQ(events.callstack_id(1), 2);
+}
+
+TEST(CallstackEventColumns, InsertsOutOfOrderEventsAtTheirPosition) {
+  CallstackEventColumns events;
+  EXPECT_TRUE(events.Insert(30, 3));
+  EXPECT_TRUE(events.Insert(10, 1));
+  EXPECT_TRUE(events.Insert(20, 2));
+
+  EXPECT_THAT(events.timestamps_ns(), ElementsAre(10, 20, 30));
+  EXPECT_THAT(events.callstack_ids(), ElementsAre(1, 2, 3));
+}
+
+TEST(CallstackEventColumns, KeepsTheFirstEventOfATimestamp) {
+  CallstackEventColumns events;
+  EXPECT_TRUE(events.Insert(10, 1));
+  EXPECT_TRUE(events.Insert(20, 2));
+  EXPECT_FALSE(events.Insert(20, 3));
+  EXPECT_FALSE(events.Insert(10, 4));
+
+  EXPECT_THAT(events.timestamps_ns(), ElementsAre(10, 20));
+  EXPECT_THAT(events.callstack_ids(), ElementsAre(1, 2));
+}
+
+TEST(CallstackEventColumns, LowerAndUpperBound) {
+  CallstackEventColumns events;
+  events.Insert(10, 1);
+  events.Insert(20, 2);
+  events.Insert(30, 3);
+
+  EXPECT_EQ(events.LowerBound(0), 0);
+  EXPECT_EQ(events.LowerBound(10), 0);
+  EXPECT_EQ(events.LowerBound(15), 1);
+  EXPECT_EQ(events.LowerBound(30), 2);
+  EXPECT_EQ(events.LowerBound(31), 3);
+
+  EXPECT_EQ(events.UpperBound(0), 0);
+  EXPECT_EQ(events.UpperBound(10), 1);
+  EXPECT_EQ(events.UpperBound(15), 1);
+  EXPECT_EQ(events.UpperBound(30), 3);
+}
+
+}  // namespace orbit_client_data
@@ -8,8 +8,10 @@
 #include <absl/hash/hash.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <optional>
@@ -22,9 +24,12 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeInfo.h"
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/ScopeStatsIndex.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/process.pb.h"
 #include "OrbitBase/ThreadConstants.h"
 #include "OrbitBase/Typedef.h"
+#include "Statistics/QuantileSketch.h"
 
 using orbit_client_data::ModuleIdentifier;
 using orbit_grpc_protos::CaptureStarted;
@@ -62,7 +67,16 @@ CaptureData::CaptureData(CaptureStarted capture_started,
       scope_id_provider_(NameEqualityScopeIdProvider::Create(capture_started_.capture_options())),
       thread_track_data_provider_(
           std::make_unique<ThreadTrackDataProvider>(data_source == DataSource::kLoadedCapture)),
-      all_scopes_(std::make_shared<ScopeStatsCollection>()) {
+      // The durations are computed from the stored timers when needed, e.g., for a histogram,
+      // rather than keeping a copy of the duration of every timer.
+      all_scopes_(std::make_shared<ScopeStatsCollection>([this](ScopeId scope_id) {
+        std::vector<uint64_t> durations;
+        for (const TimerInfo* timer : GetTimersForScope(scope_id)) {
+          durations.push_back(timer->end() - timer->start());
+        }
+        std::sort(durations.begin(), durations.end());
+        return durations;
+      })) {
   for (const auto& instrumented_function :
        capture_started_.capture_options().instrumented_functions()) {
     instrumented_functions_.insert_or_assign(instrumented_function.function_id(),
@@ -70,6 +84,12 @@ CaptureData::CaptureData(CaptureStarted capture_started,
   }
 }
 
+CaptureData::~CaptureData() {
+  // The collection can outlive this object, e.g., as it is shared with the live functions tab,
+  // but its provider of sorted durations refers to the timers owned by this object.
+  all_scopes_->DetachProviders();
+}
+
 void CaptureData::ForEachThreadStateSliceIntersectingTimeRange(
     uint32_t thread_id, uint64_t min_timestamp, uint64_t max_timestamp,
     const std::function<void(const ThreadStateSliceInfo&)>& action) const {
@@ -254,8 +274,7 @@ bool CaptureData::IsFrameTrackEnabled(uint64_t instrumented_function_id) const {
   return frame_track_function_ids_.contains(instrumented_function_id);
 }
 
-std::optional<ScopeId> CaptureData::ProvideScopeId(
-    const orbit_client_protos::TimerInfo& timer_info) const {
+std::optional<ScopeId> CaptureData::ProvideScopeId(const TimerInfo& timer_info) const {
   ORBIT_CHECK(scope_id_provider_);
   return scope_id_provider_->ProvideId(timer_info);
 }
@@ -294,9 +313,115 @@ std::unique_ptr<const ScopeStatsCollection> CaptureData::CreateScopeStatsCollect
   std::vector<uint32_t> thread_ids = thread_id == orbit_base::kAllProcessThreadsTid
                                          ? GetThreadTrackDataProvider()->GetAllThreadIds()
                                          : std::vector<uint32_t>{thread_id};
-  auto timers = GetAllScopeTimersByTids(thread_ids, kAllValidScopeTypes, min_tick, max_tick,
-                                        /*exclusive=*/true);
-  return std::make_unique<ScopeStatsCollection>(*scope_id_provider_, timers);
+  std::vector<ScopeStatsIndexSnapshot> index_snapshots;
+  for (const uint32_t tid : thread_ids) {
+    index_snapshots.push_back(GetOrCreateThreadScopeStatsIndex(tid));
+  }
+  index_snapshots.push_back(GetOrCreateAsyncScopeStatsIndex());
+
+  absl::flat_hash_map<ScopeId, ScopeStats> scope_stats;
+  for (const ScopeStatsIndexSnapshot& snapshot : index_snapshots) {
+    const uint64_t snapshot_max_tick = std::min(max_tick, snapshot.max_end_ns);
+    for (const ScopeId scope_id : snapshot.index->GetAllProvidedScopeIds()) {
+      const ScopeStats stats =
+          snapshot.index->ComputeScopeStats(scope_id, min_tick, snapshot_max_tick);
+      if (stats.count() == 0) continue;
+      scope_stats[scope_id].MergeStats(stats);
+    }
+  }
+
+  // The durations are only needed for the histogram of the selected scope.
+  auto sorted_timer_durations_provider = [index_snapshots, min_tick, max_tick](ScopeId scope_id) {
+    std::vector<uint64_t> durations;
+    for (const ScopeStatsIndexSnapshot& snapshot : index_snapshots) {
+      std::vector<uint64_t> index_durations = snapshot.index->ComputeSortedTimerDurations(
+          scope_id, min_tick, std::min(max_tick, snapshot.max_end_ns));
+      const auto middle = static_cast<std::ptrdiff_t>(durations.size());
+      durations.insert(durations.end(), index_durations.begin(), index_durations.end());
+      std::inplace_merge(durations.begin(), durations.begin() + middle, durations.end());
+    }
+    return durations;
+  };
+  // Quantiles are requested for every scope shown, hence they are estimated from sketches rather
+  // than computed from sorted durations.
+  auto duration_sketch_provider = [index_snapshots = std::move(index_snapshots), min_tick,
+                                   max_tick](ScopeId scope_id) {
+    orbit_statistics::QuantileSketch sketch;
+    for (const ScopeStatsIndexSnapshot& snapshot : index_snapshots) {
+      sketch.Merge(snapshot.index->ComputeDurationSketch(scope_id, min_tick,
+                                                         std::min(max_tick, snapshot.max_end_ns)));
+    }
+    return sketch;
+  };
+  return std::make_unique<ScopeStatsCollection>(std::move(scope_stats),
+                                                std::move(sorted_timer_durations_provider),
+                                                std::move(duration_sketch_provider));
+}
+
+template <typename GetTimersT, typename IsIndexedT>
+CaptureData::ScopeStatsIndexSnapshot CaptureData::UpdateScopeStatsIndex(
+    ScopeStatsIndexEntry* entry, size_t num_timers, GetTimersT&& get_timers,
+    IsIndexedT&& is_indexed) const {
+  if (entry->index != nullptr && entry->num_timers == num_timers) {
+    return {entry->index, entry->max_end_ns};
+  }
+
+  // Timers are usually added in order of end timestamp, so the new ones are those that end after
+  // all the timers in the index.
+  std::vector<const TimerInfo*> new_timers;
+  if (entry->index != nullptr) {
+    for (const TimerInfo* timer : get_timers(entry->max_end_ns)) {
+      if (timer->end() > entry->max_end_ns) new_timers.push_back(timer);
+    }
+  }
+  // If they don't account for all the timers that were added, the index is rebuilt. There can be
+  // more of them than expected, as timers can be added concurrently.
+  if (entry->index == nullptr || entry->num_timers + new_timers.size() < num_timers) {
+    *entry = ScopeStatsIndexEntry{};
+    new_timers = get_timers(std::numeric_limits<uint64_t>::min());
+  }
+
+  std::vector<const TimerInfo*> indexed_timers;
+  for (const TimerInfo* timer : new_timers) {
+    entry->max_end_ns = std::max(entry->max_end_ns, timer->end());
+    if (is_indexed(*timer)) indexed_timers.push_back(timer);
+  }
+  entry->num_timers += new_timers.size();
+  if (entry->index == nullptr) {
+    entry->index = std::make_shared<ScopeStatsIndex>(*scope_id_provider_, indexed_timers);
+  } else {
+    entry->index->AddTimers(*scope_id_provider_, indexed_timers);
+  }
+  return {entry->index, entry->max_end_ns};
+}
+
+CaptureData::ScopeStatsIndexSnapshot CaptureData::GetOrCreateThreadScopeStatsIndex(
+    uint32_t thread_id) const {
+  const ThreadTrackDataProvider* thread_track_data_provider = GetThreadTrackDataProvider();
+  const size_t num_timers = thread_track_data_provider->GetNumberOfTimers(thread_id);
+  absl::MutexLock lock(&scope_stats_indices_mutex_);
+  return UpdateScopeStatsIndex(
+      &thread_scope_stats_indices_[thread_id], num_timers,
+      [thread_track_data_provider, thread_id](uint64_t min_tick) {
+        return thread_track_data_provider->GetTimers(thread_id, min_tick);
+      },
+      [this](const TimerInfo& timer) {
+        const std::optional<ScopeId> scope_id = ProvideScopeId(timer);
+        if (!scope_id.has_value()) return false;
+        const ScopeType type = GetScopeInfo(scope_id.value()).GetType();
+        return type == ScopeType::kApiScope || type == ScopeType::kDynamicallyInstrumentedFunction;
+      });
+}
+
+CaptureData::ScopeStatsIndexSnapshot CaptureData::GetOrCreateAsyncScopeStatsIndex() const {
+  const size_t num_timers = timer_data_manager_.GetNumberOfTimersOfType(TimerInfo::kApiScopeAsync);
+  absl::MutexLock lock(&scope_stats_indices_mutex_);
+  return UpdateScopeStatsIndex(
+      &async_scope_stats_index_, num_timers,
+      [this](uint64_t min_tick) {
+        return timer_data_manager_.GetTimers(TimerInfo::kApiScopeAsync, min_tick);
+      },
+      [](const TimerInfo& /*timer*/) { return true; });
 }
 
 [[nodiscard]] std::vector<const TimerInfo*> CaptureData::GetAllScopeTimers(
@@ -327,8 +452,8 @@ std::unique_ptr<const ScopeStatsCollection> CaptureData::CreateScopeStatsCollect
   }
 
   if (types.contains(ScopeType::kApiScopeAsync)) {
-    std::vector<const TimerInfo*> async_timer_infos = timer_data_manager_.GetTimers(
-        orbit_client_protos::TimerInfo::kApiScopeAsync, min_tick, max_tick, exclusive);
+    std::vector<const TimerInfo*> async_timer_infos =
+        timer_data_manager_.GetTimers(TimerInfo::kApiScopeAsync, min_tick, max_tick, exclusive);
 
     result.insert(std::end(result), std::begin(async_timer_infos), std::end(async_timer_infos));
   }
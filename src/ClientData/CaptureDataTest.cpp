@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
 #include <absl/strings/numbers.h>
 #include <absl/strings/str_split.h>
@@ -17,6 +18,7 @@
 #include <filesystem>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <string>
@@ -29,12 +31,14 @@
 #include "ClientData/ModuleIdentifierProvider.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeStats.h"
+#include "ClientData/ScopeStatsCollection.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/ReadFileToString.h"
 #include "OrbitBase/Result.h"
+#include "OrbitBase/ThreadConstants.h"
 #include "OrbitBase/Typedef.h"
 #include "Test/Path.h"
 
@@ -276,7 +280,10 @@ TEST_F(CaptureDataTest, VarianceIsCorrectOnRepeatedScimitarDataset) {
 }
 
 TEST_F(CaptureDataTest, UpdateTimerDurationsIsCorrect) {
-  for (const TimerInfo& timer : kTimerInfos) {
+  // The durations are computed from the timers stored in the capture data.
+  for (TimerInfo timer : kTimerInfos) {
+    timer.set_thread_id(kFirstTid);
+    capture_data_.GetThreadTrackDataProvider()->AddTimer(timer);
     capture_data_.UpdateScopeStats(timer);
   }
 
@@ -293,6 +300,133 @@ TEST_F(CaptureDataTest, UpdateTimerDurationsIsCorrect) {
                                            std::end(kSortedDurationsForSecondId)));
 
   EXPECT_THAT(capture_data_.GetSortedTimerDurationsForScopeId(kNotIssuedId), testing::IsNull());
+
+  std::shared_ptr<const ScopeStatsCollection> all_scopes =
+      capture_data_.GetAllScopeStatsCollection();
+  EXPECT_EQ(all_scopes->GetDurationQuantileNs(kFirstId, 0.0), kSortedDurationsForFirstId[0]);
+  EXPECT_EQ(all_scopes->GetDurationQuantileNs(kFirstId, 1.0), kSortedDurationsForFirstId[2]);
+  EXPECT_EQ(all_scopes->GetDurationQuantileNs(kNotIssuedId, 0.5), std::nullopt);
+}
+
+TEST_F(CaptureDataTest, CreateScopeStatsCollectionIsCorrect) {
+  for (size_t i = 0; i < kTimerCount; ++i) {
+    TimerInfo timer = kTimerInfos[i];
+    timer.set_thread_id(i < kTimersForFirstId ? kFirstTid : kSecondTid);
+    capture_data_.GetThreadTrackDataProvider()->AddTimer(timer);
+  }
+
+  std::unique_ptr<const ScopeStatsCollection> all_threads_collection =
+      capture_data_.CreateScopeStatsCollection(orbit_base::kAllProcessThreadsTid, 0,
+                                               std::numeric_limits<uint64_t>::max());
+  ExpectStatsEqual(all_threads_collection->GetScopeStatsOrDefault(kFirstId),
+                   GetStats(kDurationsForFirstId, kFirstVariance));
+  ExpectStatsEqual(all_threads_collection->GetScopeStatsOrDefault(kSecondId),
+                   GetStats(kDurationsForSecondId, kSecondVariance));
+  EXPECT_EQ(*all_threads_collection->GetSortedTimerDurationsForScopeId(kFirstId),
+            std::vector(std::begin(kSortedDurationsForFirstId),
+                        std::end(kSortedDurationsForFirstId)));
+  EXPECT_THAT(all_threads_collection->GetSortedTimerDurationsForScopeId(kNotIssuedId),
+              testing::IsNull());
+
+  std::unique_ptr<const ScopeStatsCollection> second_thread_collection =
+      capture_data_.CreateScopeStatsCollection(kSecondTid, 0,
+                                               std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(second_thread_collection->GetScopeStatsOrDefault(kFirstId).count(), 0);
+  ExpectStatsEqual(second_thread_collection->GetScopeStatsOrDefault(kSecondId),
+                   GetStats(kDurationsForSecondId, kSecondVariance));
+
+  // Only the timers of the first scope starting at 20 and 30 are entirely inside the range.
+  std::unique_ptr<const ScopeStatsCollection> time_range_collection =
+      capture_data_.CreateScopeStatsCollection(kFirstTid, 15, 250);
+  EXPECT_EQ(time_range_collection->GetScopeStatsOrDefault(kFirstId).count(), 2);
+  EXPECT_EQ(time_range_collection->GetScopeStatsOrDefault(kFirstId).total_time_ns(), 300);
+  EXPECT_EQ(*time_range_collection->GetSortedTimerDurationsForScopeId(kFirstId),
+            std::vector<uint64_t>({100, 200}));
+  EXPECT_EQ(time_range_collection->GetDurationQuantileNs(kFirstId, 0.0), 100);
+  EXPECT_EQ(time_range_collection->GetDurationQuantileNs(kFirstId, 1.0), 200);
+  EXPECT_EQ(time_range_collection->GetDurationQuantileNs(kSecondId, 0.5), std::nullopt);
+
+  // Timers added after a collection was created are taken into account by the next one.
+  TimerInfo new_timer = kTimerInfos[0];
+  new_timer.set_thread_id(kFirstTid);
+  new_timer.set_start(1000);
+  new_timer.set_end(1100);
+  capture_data_.GetThreadTrackDataProvider()->AddTimer(new_timer);
+  EXPECT_EQ(capture_data_
+                .CreateScopeStatsCollection(kFirstTid, 0, std::numeric_limits<uint64_t>::max())
+                ->GetScopeStatsOrDefault(kFirstId)
+                .count(),
+            kTimersForFirstId + 1);
+}
+
+TEST_F(CaptureDataTest, ScopeStatsCollectionsOnlyIncludeTimersAddedBeforeTheirCreation) {
+  for (size_t i = 0; i < kTimersForFirstId; ++i) {
+    TimerInfo timer = kTimerInfos[i];
+    timer.set_thread_id(kFirstTid);
+    capture_data_.GetThreadTrackDataProvider()->AddTimer(timer);
+  }
+  std::unique_ptr<const ScopeStatsCollection> initial_collection =
+      capture_data_.CreateScopeStatsCollection(kFirstTid, 0,
+                                               std::numeric_limits<uint64_t>::max());
+
+  // Timers usually end after all the timers that were added before, so they are added to the index.
+  TimerInfo later_timer = kTimerInfos[0];
+  later_timer.set_thread_id(kFirstTid);
+  later_timer.set_start(1000);
+  later_timer.set_end(1100);
+  capture_data_.GetThreadTrackDataProvider()->AddTimer(later_timer);
+  std::unique_ptr<const ScopeStatsCollection> collection_with_later_timer =
+      capture_data_.CreateScopeStatsCollection(kFirstTid, 0,
+                                               std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(*collection_with_later_timer->GetSortedTimerDurationsForScopeId(kFirstId),
+            std::vector<uint64_t>({100, 100, 200, 300}));
+
+  // If they don't, the index is rebuilt.
+  TimerInfo earlier_timer = kTimerInfos[0];
+  earlier_timer.set_thread_id(kFirstTid);
+  earlier_timer.set_start(21);
+  earlier_timer.set_end(71);
+  capture_data_.GetThreadTrackDataProvider()->AddTimer(earlier_timer);
+  std::unique_ptr<const ScopeStatsCollection> collection_with_earlier_timer =
+      capture_data_.CreateScopeStatsCollection(kFirstTid, 0,
+                                               std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(collection_with_earlier_timer->GetScopeStatsOrDefault(kFirstId).count(),
+            kTimersForFirstId + 2);
+  EXPECT_EQ(*collection_with_earlier_timer->GetSortedTimerDurationsForScopeId(kFirstId),
+            std::vector<uint64_t>({50, 100, 100, 200, 300}));
+
+  EXPECT_EQ(initial_collection->GetScopeStatsOrDefault(kFirstId).count(), kTimersForFirstId);
+  EXPECT_EQ(*initial_collection->GetSortedTimerDurationsForScopeId(kFirstId),
+            std::vector(std::begin(kSortedDurationsForFirstId),
+                        std::end(kSortedDurationsForFirstId)));
+}
+
+TEST_F(CaptureDataTest, AllScopeStatsCollectionCanOutliveCaptureData) {
+  auto capture_data = std::make_unique<CaptureData>(CreateCaptureStarted(), std::nullopt,
+                                                    absl::flat_hash_set<uint64_t>{},
+                                                    CaptureData::DataSource::kLiveCapture,
+                                                    &module_identifier_provider_);
+  for (TimerInfo timer : kTimerInfos) {
+    timer.set_thread_id(kFirstTid);
+    capture_data->GetThreadTrackDataProvider()->AddTimer(timer);
+    capture_data->UpdateScopeStats(timer);
+  }
+  capture_data->OnCaptureComplete();
+
+  std::shared_ptr<const ScopeStatsCollection> all_scopes =
+      capture_data->GetAllScopeStatsCollection();
+  const std::vector<uint64_t>* durations_first =
+      all_scopes->GetSortedTimerDurationsForScopeId(kFirstId);
+  capture_data.reset();
+
+  // The durations that were already computed stay available, the others can no longer be computed.
+  EXPECT_EQ(all_scopes->GetSortedTimerDurationsForScopeId(kFirstId), durations_first);
+  EXPECT_EQ(*durations_first, std::vector(std::begin(kSortedDurationsForFirstId),
+                                          std::end(kSortedDurationsForFirstId)));
+  EXPECT_THAT(all_scopes->GetSortedTimerDurationsForScopeId(kSecondId), testing::IsNull());
+  ExpectStatsEqual(all_scopes->GetScopeStatsOrDefault(kSecondId),
+                   GetStats(kDurationsForSecondId, kSecondVariance));
+  EXPECT_EQ(all_scopes->GetDurationQuantileNs(kSecondId, 0.0), kSortedDurationsForSecondId[0]);
 }
 
 struct ForEachThreadStateSliceIntersectingTimeRangeDiscretizedTestCase {
@@ -8,7 +8,7 @@
 
 #include <utility>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Typedef.h"
 
@@ -66,7 +66,7 @@ void DataManager::set_hovered_thread_state_slice(
   hovered_thread_state_slice_ = hovered_thread_state_slice;
 }
 
-void DataManager::set_selected_timer(const orbit_client_protos::TimerInfo* timer_info) {
+void DataManager::set_selected_timer(const TimerInfo* timer_info) {
   ORBIT_CHECK(std::this_thread::get_id() == main_thread_id_);
   selected_timer_ = timer_info;
 }
@@ -111,7 +111,7 @@ std::optional<ThreadStateSliceInfo> DataManager::hovered_thread_state_slice() co
   return hovered_thread_state_slice_;
 }
 
-const orbit_client_protos::TimerInfo* DataManager::selected_timer() const {
+const TimerInfo* DataManager::selected_timer() const {
   ORBIT_CHECK(std::this_thread::get_id() == main_thread_id_);
   return selected_timer_;
 }
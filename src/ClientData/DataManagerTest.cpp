@@ -17,12 +17,12 @@
 #include "ClientData/DataManager.h"
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ScopeId.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/WineSyscallHandlingMethod.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using testing::Optional;
 
 constexpr uint64_t kBeforeStart = 2;
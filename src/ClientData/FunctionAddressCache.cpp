@@ -0,0 +1,42 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/FunctionAddressCache.h"
+
+namespace orbit_client_data {
+
+std::optional<uint64_t> FunctionAddressCache::Find(uint64_t absolute_address) const {
+  absl::MutexLock lock(&mutex_);
+  auto it = absolute_address_to_function_address_.find(absolute_address);
+  if (it == absolute_address_to_function_address_.end()) return std::nullopt;
+  return it->second;
+}
+
+uint64_t FunctionAddressCache::GetGeneration() const {
+  absl::MutexLock lock(&mutex_);
+  return generation_;
+}
+
+void FunctionAddressCache::Insert(
+    uint64_t generation,
+    absl::Span<const std::pair<uint64_t, uint64_t>> absolute_and_function_addresses) {
+  absl::MutexLock lock(&mutex_);
+  if (generation != generation_) return;
+  for (const auto& [absolute_address, function_address] : absolute_and_function_addresses) {
+    absolute_address_to_function_address_.insert_or_assign(absolute_address, function_address);
+  }
+}
+
+void FunctionAddressCache::Clear() {
+  absl::MutexLock lock(&mutex_);
+  absolute_address_to_function_address_.clear();
+  ++generation_;
+}
+
+size_t FunctionAddressCache::size() const {
+  absl::MutexLock lock(&mutex_);
+  return absolute_address_to_function_address_.size();
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,66 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ClientData/FunctionAddressCache.h"
+
+using ::testing::Optional;
+
+namespace orbit_client_data {
+
+TEST(FunctionAddressCache, FindReturnsInsertedFunctionAddresses) {
+  FunctionAddressCache cache;
+  EXPECT_EQ(cache.Find(0x1010), std::nullopt);
+
+  const std::vector<std::pair<uint64_t, uint64_t>> mappings{{0x1010, 0x1000}, {0x2020, 0x2020}};
+  cache.Insert(cache.GetGeneration(), mappings);
+  EXPECT_EQ(cache.size(), 2);
+  EXPECT_THAT(cache.Find(0x1010), Optional(0x1000));
+  EXPECT_THAT(cache.Find(0x2020), Optional(0x2020));
+  EXPECT_EQ(cache.Find(0x3030), std::nullopt);
+}
+
+TEST(FunctionAddressCache, ClearRemovesAllMappings) {
+  FunctionAddressCache cache;
+  const std::vector<std::pair<uint64_t, uint64_t>> mappings{{0x1010, 0x1000}};
+  cache.Insert(cache.GetGeneration(), mappings);
+
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.Find(0x1010), std::nullopt);
+
+  // Mappings resolved after Clear() are inserted as usual.
+  const std::vector<std::pair<uint64_t, uint64_t>> new_mappings{{0x1010, 0x1008}};
+  cache.Insert(cache.GetGeneration(), new_mappings);
+  EXPECT_THAT(cache.Find(0x1010), Optional(0x1008));
+}
+
+TEST(FunctionAddressCache, InsertAfterClearDropsMappingsOfEarlierGeneration) {
+  FunctionAddressCache cache;
+
+  // A post-processing run starts and records the generation before resolving its addresses...
+  const uint64_t generation_of_stale_run = cache.GetGeneration();
+  // ...then new symbols are loaded and the cache is cleared...
+  cache.Clear();
+  // ...and a run that started after that inserts the mappings resolved with the new symbols...
+  const std::vector<std::pair<uint64_t, uint64_t>> new_mappings{{0x1010, 0x1000}};
+  cache.Insert(cache.GetGeneration(), new_mappings);
+  // ...before the stale run finishes and inserts the mappings resolved with the old symbols.
+  const std::vector<std::pair<uint64_t, uint64_t>> stale_mappings{{0x1010, 0x1010},
+                                                                  {0x2020, 0x2020}};
+  cache.Insert(generation_of_stale_run, stale_mappings);
+
+  EXPECT_EQ(cache.size(), 1);
+  EXPECT_THAT(cache.Find(0x1010), Optional(0x1000));
+  EXPECT_EQ(cache.Find(0x2020), std::nullopt);
+}
+
+}  // namespace orbit_client_data
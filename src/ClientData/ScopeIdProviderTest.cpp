@@ -22,8 +22,8 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeIdProvider.h"
 #include "ClientData/ScopeInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/Constants.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Typedef.h"
@@ -32,24 +32,23 @@ namespace orbit_client_data {
 
 const std::vector<std::string> kNames{"A", "B", "C", "D", "A", "B", "B"};
 
-[[nodiscard]] static orbit_client_protos::TimerInfo MakeTimerInfo(
-    std::string name, orbit_client_protos::TimerInfo_Type type) {
-  orbit_client_protos::TimerInfo timer_info;
+[[nodiscard]] static TimerInfo MakeTimerInfo(std::string name, TimerInfo::Type type) {
+  TimerInfo timer_info;
   timer_info.set_api_scope_name(std::move(name));
   timer_info.set_type(type);
   timer_info.set_function_id(orbit_grpc_protos::kInvalidFunctionId);
   return timer_info;
 }
 
-[[nodiscard]] static std::vector<orbit_client_protos::TimerInfo> MakeTimerInfos(
-    absl::Span<const std::string> names, orbit_client_protos::TimerInfo_Type type) {
-  std::vector<orbit_client_protos::TimerInfo> timer_infos;
+[[nodiscard]] static std::vector<TimerInfo> MakeTimerInfos(absl::Span<const std::string> names,
+                                                           TimerInfo::Type type) {
+  std::vector<TimerInfo> timer_infos;
   std::transform(std::begin(names), std::end(names), std::back_inserter(timer_infos),
                  [type](const auto& name) { return MakeTimerInfo(name, type); });
   return timer_infos;
 }
 
-static void AssertNameToIdIsBijective(absl::Span<const orbit_client_protos::TimerInfo> timers,
+static void AssertNameToIdIsBijective(absl::Span<const TimerInfo> timers,
                                       absl::Span<const ScopeId> ids) {
   absl::flat_hash_map<std::string, ScopeId> name_to_id;
   for (size_t i = 0; i < timers.size(); ++i) {
@@ -65,7 +64,7 @@ static void AssertNameToIdIsBijective(absl::Span<const orbit_client_protos::Time
 }
 
 static std::vector<ScopeId> GetIds(ScopeIdProvider* id_provider,
-                                   absl::Span<const orbit_client_protos::TimerInfo> timers) {
+                                   absl::Span<const TimerInfo> timers) {
   std::vector<ScopeId> ids;
   std::transform(
       std::begin(timers), std::end(timers), std::back_inserter(ids),
@@ -73,7 +72,7 @@ static std::vector<ScopeId> GetIds(ScopeIdProvider* id_provider,
   return ids;
 }
 
-static void TestProvideId(std::vector<orbit_client_protos::TimerInfo>& timer_infos) {
+static void TestProvideId(std::vector<TimerInfo>& timer_infos) {
   orbit_grpc_protos::CaptureOptions capture_options;
   auto id_provider = NameEqualityScopeIdProvider::Create(capture_options);
 
@@ -100,19 +99,18 @@ TEST(NameEqualityScopeIdProviderTest, ProvideIdReturnsNullOptForTimeOfInvalidTyp
 }
 
 TEST(NameEqualityScopeIdProviderTest, ProvideIdIsCorrectForApiScope) {
-  auto timer_infos = MakeTimerInfos(kNames, orbit_client_protos::TimerInfo_Type_kApiScope);
+  auto timer_infos = MakeTimerInfos(kNames, TimerInfo::kApiScope);
   TestProvideId(timer_infos);
 }
 
 TEST(NameEqualityScopeIdProviderTest, ProvideIdIsCorrectForApiScopeAsync) {
-  auto async_timer_infos =
-      MakeTimerInfos(kNames, orbit_client_protos::TimerInfo_Type_kApiScopeAsync);
+  auto async_timer_infos = MakeTimerInfos(kNames, TimerInfo::kApiScopeAsync);
   TestProvideId(async_timer_infos);
 }
 
 TEST(NameEqualityScopeIdProviderTest, SyncAndAsyncScopesOfTheSameNameGetDifferentIds) {
-  TimerInfo sync = MakeTimerInfo("A", orbit_client_protos::TimerInfo_Type_kApiScope);
-  TimerInfo async = MakeTimerInfo("A", orbit_client_protos::TimerInfo_Type_kApiScopeAsync);
+  TimerInfo sync = MakeTimerInfo("A", TimerInfo::kApiScope);
+  TimerInfo async = MakeTimerInfo("A", TimerInfo::kApiScopeAsync);
 
   orbit_grpc_protos::CaptureOptions capture_options;
   auto id_provider = NameEqualityScopeIdProvider::Create(capture_options);
@@ -4,6 +4,8 @@
 
 #include "ClientData/ScopeStats.h"
 
+#include <algorithm>
+
 namespace orbit_client_data {
 void ScopeStats::UpdateStats(uint64_t elapsed_nanos) {
   auto old_avg = static_cast<double>(ComputeAverageTimeNs());
@@ -27,6 +29,30 @@ void ScopeStats::UpdateStats(uint64_t elapsed_nanos) {
   }
 }
 
+void ScopeStats::MergeStats(const ScopeStats& other) {
+  if (other.count_ == 0) return;
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+
+  const auto count_double = static_cast<double>(count_);
+  const auto other_count_double = static_cast<double>(other.count_);
+  const double merged_count_double = count_double + other_count_double;
+  const double average_delta = static_cast<double>(other.total_time_ns_) / other_count_double -
+                               static_cast<double>(total_time_ns_) / count_double;
+
+  // Chan et al.: M2 = M2_a + M2_b + delta^2 * N_a * N_b / N, where M2 = variance * N.
+  variance_ns_ = (variance_ns_ * count_double + other.variance_ns_ * other_count_double +
+                  average_delta * average_delta * count_double * other_count_double /
+                      merged_count_double) /
+                 merged_count_double;
+  count_ += other.count_;
+  total_time_ns_ += other.total_time_ns_;
+  min_ns_ = std::min(min_ns_, other.min_ns_);
+  max_ns_ = std::max(max_ns_, other.max_ns_);
+}
+
 uint64_t ScopeStats::ComputeAverageTimeNs() const {
   if (count_ == 0) {
     return 0;
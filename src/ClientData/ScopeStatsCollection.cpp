@@ -8,11 +8,14 @@
 #include <absl/algorithm/container.h>
 #include <absl/types/span.h>
 
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <utility>
 
 #include "ApiInterface/Orbit.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Typedef.h"
 
@@ -33,12 +36,28 @@ ScopeStatsCollection::ScopeStatsCollection(ScopeIdProvider& scope_id_provider,
   OnCaptureComplete();
 }
 
+ScopeStatsCollection::ScopeStatsCollection(
+    absl::flat_hash_map<ScopeId, ScopeStats> scope_stats,
+    SortedTimerDurationsProvider sorted_timer_durations_provider,
+    DurationSketchProvider duration_sketch_provider)
+    : scope_stats_{std::move(scope_stats)},
+      sorted_timer_durations_provider_{std::move(sorted_timer_durations_provider)},
+      duration_sketch_provider_{std::move(duration_sketch_provider)} {}
+
+ScopeStatsCollection::ScopeStatsCollection(
+    SortedTimerDurationsProvider sorted_timer_durations_provider)
+    : ScopeStatsCollection({}, std::move(sorted_timer_durations_provider), nullptr) {}
+
 void ScopeStatsCollection::UpdateScopeStats(ScopeId scope_id, const TimerInfo& timer) {
   ScopeStats& stats = scope_stats_[scope_id];
   const uint64_t elapsed_nanos = timer.end() - timer.start();
   stats.UpdateStats(elapsed_nanos);
-  scope_id_to_timer_durations_[scope_id].push_back(elapsed_nanos);
   timer_durations_are_sorted_ = false;
+  if (sorted_timer_durations_provider_ != nullptr) {
+    scope_id_to_duration_sketch_[scope_id].Add(elapsed_nanos);
+    return;
+  }
+  scope_id_to_timer_durations_[scope_id].push_back(elapsed_nanos);
 }
 
 void ScopeStatsCollection::SetScopeStats(ScopeId scope_id, const ScopeStats stats) {
@@ -67,6 +86,19 @@ const std::vector<uint64_t>* ScopeStatsCollection::GetSortedTimerDurationsForSco
         "first.");
     return nullptr;
   }
+  if (sorted_timer_durations_provider_ != nullptr) {
+    if (!scope_stats_.contains(scope_id)) return nullptr;
+    absl::MutexLock lock(&lazy_timer_durations_mutex_);
+    auto durations_it = lazy_scope_id_to_timer_durations_.find(scope_id);
+    if (durations_it == lazy_scope_id_to_timer_durations_.end()) {
+      if (providers_are_detached_) return nullptr;
+      auto durations =
+          std::make_unique<std::vector<uint64_t>>(sorted_timer_durations_provider_(scope_id));
+      durations_it =
+          lazy_scope_id_to_timer_durations_.emplace(scope_id, std::move(durations)).first;
+    }
+    return durations_it->second.get();
+  }
   if (const auto durations_it = scope_id_to_timer_durations_.find(scope_id);
       durations_it != scope_id_to_timer_durations_.end()) {
     return &durations_it->second;
@@ -74,14 +106,55 @@ const std::vector<uint64_t>* ScopeStatsCollection::GetSortedTimerDurationsForSco
   return nullptr;
 }
 
+std::optional<uint64_t> ScopeStatsCollection::GetDurationQuantileNs(ScopeId scope_id,
+                                                                    double quantile) const {
+  if (const auto sketch_it = scope_id_to_duration_sketch_.find(scope_id);
+      sketch_it != scope_id_to_duration_sketch_.end()) {
+    return sketch_it->second.GetQuantile(quantile);
+  }
+
+  if (duration_sketch_provider_ != nullptr) {
+    if (!scope_stats_.contains(scope_id)) return std::nullopt;
+    absl::MutexLock lock(&lazy_timer_durations_mutex_);
+    if (const auto sketch_it = lazy_scope_id_to_duration_sketch_.find(scope_id);
+        sketch_it != lazy_scope_id_to_duration_sketch_.end()) {
+      return sketch_it->second.GetQuantile(quantile);
+    }
+    if (providers_are_detached_) return std::nullopt;
+    const auto [sketch_it, unused_inserted] =
+        lazy_scope_id_to_duration_sketch_.emplace(scope_id, duration_sketch_provider_(scope_id));
+    return sketch_it->second.GetQuantile(quantile);
+  }
+
+  const std::vector<uint64_t>* durations = GetSortedTimerDurationsForScopeId(scope_id);
+  if (durations == nullptr || durations->empty()) return std::nullopt;
+  const auto index = static_cast<size_t>(quantile * static_cast<double>(durations->size() - 1));
+  return (*durations)[index];
+}
+
 void ScopeStatsCollection::OnCaptureComplete() {
   ORBIT_SCOPE_WITH_COLOR("ScopeStatsCollection::OnCaptureComplete", kOrbitColorDeepOrange);
   if (timer_durations_are_sorted_) return;
 
+  if (sorted_timer_durations_provider_ != nullptr) {
+    // Update the durations that were already requested in place, as they are returned by pointer.
+    absl::MutexLock lock(&lazy_timer_durations_mutex_);
+    if (!providers_are_detached_) {
+      for (auto& [scope_id, durations] : lazy_scope_id_to_timer_durations_) {
+        *durations = sorted_timer_durations_provider_(scope_id);
+      }
+    }
+  }
+
   for (auto& [unused_id, timer_durations] : scope_id_to_timer_durations_) {
     absl::c_sort(timer_durations);
   }
   timer_durations_are_sorted_ = true;
 }
 
-}  // namespace orbit_client_data
\ No newline at end of file
+void ScopeStatsCollection::DetachProviders() {
+  absl::MutexLock lock(&lazy_timer_durations_mutex_);
+  providers_are_detached_ = true;
+}
+
+}  // namespace orbit_client_data
@@ -17,8 +17,9 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeStats.h"
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "Statistics/QuantileSketch.h"
 
 namespace orbit_client_data {
 
@@ -115,4 +116,111 @@ TEST(ScopeStatsCollectionTest, CreateWithTimers) {
   EXPECT_THAT(*timer_durations, ElementsAre(kOrderedDiffs[0], kOrderedDiffs[1], kOrderedDiffs[2]));
 }
 
+TEST(ScopeStatsCollectionTest, GetDurationQuantileNsFromSortedDurations) {
+  ScopeStatsCollection collection = ScopeStatsCollection();
+  for (const TimerInfo& timer : kTimersScopeId1) {
+    collection.UpdateScopeStats(kScopeId1, timer);
+  }
+  collection.OnCaptureComplete();
+
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.0), kOrderedDiffs[0]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.5), kOrderedDiffs[1]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.99), kOrderedDiffs[1]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 1.0), kOrderedDiffs[2]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId2, 0.5), std::nullopt);
+}
+
+TEST(ScopeStatsCollectionTest, UsesProviderForDurationsAndSketchForQuantiles) {
+  std::vector<const TimerInfo*> stored_timers;
+  int provider_call_count = 0;
+  ScopeStatsCollection collection{[&](ScopeId scope_id) {
+    ++provider_call_count;
+    std::vector<uint64_t> durations;
+    for (const TimerInfo* timer : stored_timers) {
+      if (ScopeId(timer->function_id()) == scope_id) {
+        durations.push_back(timer->end() - timer->start());
+      }
+    }
+    std::sort(durations.begin(), durations.end());
+    return durations;
+  }};
+
+  stored_timers.push_back(&kTimersScopeId1[0]);
+  collection.UpdateScopeStats(kScopeId1, kTimersScopeId1[0]);
+  stored_timers.push_back(&kTimersScopeId1[1]);
+  collection.UpdateScopeStats(kScopeId1, kTimersScopeId1[1]);
+
+  // Quantiles are available during the capture.
+  EXPECT_THAT(collection.GetSortedTimerDurationsForScopeId(kScopeId1), IsNull());
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.0), kOrderedDiffs[0]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 1.0), kOrderedDiffs[1]);
+
+  collection.OnCaptureComplete();
+  const std::vector<uint64_t>* timer_durations =
+      collection.GetSortedTimerDurationsForScopeId(kScopeId1);
+  ASSERT_NE(timer_durations, nullptr);
+  EXPECT_THAT(*timer_durations, ElementsAre(kOrderedDiffs[0], kOrderedDiffs[1]));
+  EXPECT_EQ(collection.GetSortedTimerDurationsForScopeId(kScopeId1), timer_durations);
+  EXPECT_EQ(provider_call_count, 1);
+
+  // The durations already returned are updated in place.
+  stored_timers.push_back(&kTimersScopeId1[2]);
+  collection.UpdateScopeStats(kScopeId1, kTimersScopeId1[2]);
+  collection.OnCaptureComplete();
+  EXPECT_EQ(collection.GetSortedTimerDurationsForScopeId(kScopeId1), timer_durations);
+  EXPECT_THAT(*timer_durations, ElementsAre(kOrderedDiffs[0], kOrderedDiffs[1], kOrderedDiffs[2]));
+  ExpectStatsAreEqual(collection.GetScopeStatsOrDefault(kScopeId1), kScope1Stats);
+
+  const std::optional<uint64_t> median = collection.GetDurationQuantileNs(kScopeId1, 0.5);
+  ASSERT_TRUE(median.has_value());
+  EXPECT_NEAR(static_cast<double>(median.value()), static_cast<double>(kOrderedDiffs[1]),
+              orbit_statistics::QuantileSketch::kDefaultRelativeAccuracy *
+                  static_cast<double>(kOrderedDiffs[1]));
+}
+
+TEST(ScopeStatsCollectionTest, ComputesSketchesForQuantilesLazily) {
+  int sketch_provider_call_count = 0;
+  ScopeStatsCollection collection{
+      {{kScopeId1, kScope1Stats}},
+      [](ScopeId /*scope_id*/) {
+        return std::vector<uint64_t>(kOrderedDiffs.begin(), kOrderedDiffs.end());
+      },
+      [&](ScopeId /*scope_id*/) {
+        ++sketch_provider_call_count;
+        orbit_statistics::QuantileSketch sketch;
+        for (uint64_t duration : kOrderedDiffs) sketch.Add(duration);
+        return sketch;
+      }};
+  EXPECT_EQ(sketch_provider_call_count, 0);
+
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.0), kOrderedDiffs[0]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 1.0), kOrderedDiffs[2]);
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId2, 0.5), std::nullopt);
+  EXPECT_EQ(sketch_provider_call_count, 1);
+}
+
+TEST(ScopeStatsCollectionTest, DetachedProvidersAreNoLongerCalled) {
+  int provider_call_count = 0;
+  ScopeStatsCollection collection{
+      {{kScopeId1, kScope1Stats}, {kScopeId2, ScopeStats{}}},
+      [&](ScopeId /*scope_id*/) {
+        ++provider_call_count;
+        return std::vector<uint64_t>(kOrderedDiffs.begin(), kOrderedDiffs.end());
+      },
+      [&](ScopeId /*scope_id*/) {
+        ++provider_call_count;
+        return orbit_statistics::QuantileSketch{};
+      }};
+  const std::vector<uint64_t>* timer_durations =
+      collection.GetSortedTimerDurationsForScopeId(kScopeId1);
+  EXPECT_EQ(provider_call_count, 1);
+
+  collection.DetachProviders();
+  EXPECT_EQ(collection.GetSortedTimerDurationsForScopeId(kScopeId1), timer_durations);
+  EXPECT_THAT(*timer_durations, ElementsAre(kOrderedDiffs[0], kOrderedDiffs[1], kOrderedDiffs[2]));
+  EXPECT_THAT(collection.GetSortedTimerDurationsForScopeId(kScopeId2), IsNull());
+  EXPECT_EQ(collection.GetDurationQuantileNs(kScopeId1, 0.5), std::nullopt);
+  EXPECT_EQ(provider_call_count, 1);
+}
+
 }  // namespace orbit_client_data
\ No newline at end of file
@@ -0,0 +1,234 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/ScopeStatsIndex.h"
+
+#include <absl/algorithm/container.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+#include "ApiInterface/Orbit.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_client_data {
+
+ScopeStatsIndex::ScopeStatsIndex(ScopeIdProvider& scope_id_provider,
+                                 absl::Span<const TimerInfo* const> timers) {
+  AddTimers(scope_id_provider, timers);
+}
+
+void ScopeStatsIndex::AddTimers(ScopeIdProvider& scope_id_provider,
+                                absl::Span<const TimerInfo* const> timers) {
+  ORBIT_SCOPE_WITH_COLOR("ScopeStatsIndex::AddTimers", kOrbitColorDeepPurple);
+
+  absl::flat_hash_map<ScopeId, std::vector<std::pair<uint64_t, uint64_t>>> scope_id_to_intervals;
+  for (const TimerInfo* timer : timers) {
+    std::optional<ScopeId> scope_id = scope_id_provider.ProvideId(*timer);
+    if (!scope_id.has_value()) continue;
+    scope_id_to_intervals[scope_id.value()].emplace_back(timer->start(), timer->end());
+  }
+
+  absl::MutexLock lock(&mutex_);
+  for (auto& [scope_id, intervals] : scope_id_to_intervals) {
+    absl::c_sort(intervals);
+    scope_timers_[scope_id].AddIntervals(intervals);
+  }
+}
+
+std::vector<ScopeId> ScopeStatsIndex::GetAllProvidedScopeIds() const {
+  absl::ReaderMutexLock lock(&mutex_);
+  std::vector<ScopeId> ids;
+  absl::c_transform(scope_timers_, std::back_inserter(ids),
+                    [](const auto& entry) { return entry.first; });
+  return ids;
+}
+
+ScopeStats ScopeStatsIndex::ComputeScopeStats(ScopeId scope_id, uint64_t min_tick,
+                                              uint64_t max_tick) const {
+  absl::ReaderMutexLock lock(&mutex_);
+  const auto scope_timers_it = scope_timers_.find(scope_id);
+  if (scope_timers_it == scope_timers_.end()) return ScopeStats{};
+  const ScopeTimers& scope_timers = scope_timers_it->second;
+
+  const auto [first_timer, end_timer] = scope_timers.GetTimerIndexRange(min_tick, max_tick);
+  Aggregate result;
+  if (first_timer < end_timer) {
+    scope_timers.Accumulate(1, 0, scope_timers.block_capacity, first_timer, end_timer, max_tick,
+                            &result);
+  }
+  return result.ToScopeStats();
+}
+
+template <typename ConsumerT>
+void ScopeStatsIndex::ForEachTimerDuration(ScopeId scope_id, uint64_t min_tick, uint64_t max_tick,
+                                           ConsumerT&& consumer) const {
+  absl::ReaderMutexLock lock(&mutex_);
+  const auto scope_timers_it = scope_timers_.find(scope_id);
+  if (scope_timers_it == scope_timers_.end()) return;
+  const ScopeTimers& scope_timers = scope_timers_it->second;
+
+  const auto [first_timer, end_timer] = scope_timers.GetTimerIndexRange(min_tick, max_tick);
+  for (size_t i = first_timer; i < end_timer; ++i) {
+    if (scope_timers.ends_ns[i] > max_tick) continue;
+    consumer(scope_timers.ends_ns[i] - scope_timers.starts_ns[i]);
+  }
+}
+
+std::vector<uint64_t> ScopeStatsIndex::ComputeSortedTimerDurations(ScopeId scope_id,
+                                                                   uint64_t min_tick,
+                                                                   uint64_t max_tick) const {
+  std::vector<uint64_t> durations;
+  ForEachTimerDuration(scope_id, min_tick, max_tick,
+                       [&durations](uint64_t duration_ns) { durations.push_back(duration_ns); });
+  absl::c_sort(durations);
+  return durations;
+}
+
+orbit_statistics::QuantileSketch ScopeStatsIndex::ComputeDurationSketch(ScopeId scope_id,
+                                                                        uint64_t min_tick,
+                                                                        uint64_t max_tick) const {
+  orbit_statistics::QuantileSketch sketch;
+  ForEachTimerDuration(scope_id, min_tick, max_tick,
+                       [&sketch](uint64_t duration_ns) { sketch.Add(duration_ns); });
+  return sketch;
+}
+
+void ScopeStatsIndex::Aggregate::Add(uint64_t start_ns, uint64_t end_ns) {
+  const uint64_t duration_ns = end_ns - start_ns;
+  ++count;
+  total_time_ns += duration_ns;
+  sum_of_squares_ns += static_cast<double>(duration_ns) * static_cast<double>(duration_ns);
+  min_ns = std::min(min_ns, duration_ns);
+  max_ns = std::max(max_ns, duration_ns);
+  max_end_ns = std::max(max_end_ns, end_ns);
+}
+
+void ScopeStatsIndex::Aggregate::Add(const Aggregate& other) {
+  count += other.count;
+  total_time_ns += other.total_time_ns;
+  sum_of_squares_ns += other.sum_of_squares_ns;
+  min_ns = std::min(min_ns, other.min_ns);
+  max_ns = std::max(max_ns, other.max_ns);
+  max_end_ns = std::max(max_end_ns, other.max_end_ns);
+}
+
+ScopeStats ScopeStatsIndex::Aggregate::ToScopeStats() const {
+  ScopeStats stats;
+  if (count == 0) return stats;
+
+  stats.set_count(count);
+  stats.set_total_time_ns(total_time_ns);
+  stats.set_min_ns(min_ns);
+  stats.set_max_ns(max_ns);
+  // variance = E[x^2] - E[x]^2
+  const double average_ns = static_cast<double>(total_time_ns) / static_cast<double>(count);
+  const double variance_ns =
+      sum_of_squares_ns / static_cast<double>(count) - average_ns * average_ns;
+  stats.set_variance_ns(std::max(variance_ns, 0.0));
+  return stats;
+}
+
+void ScopeStatsIndex::ScopeTimers::AddIntervals(
+    absl::Span<const std::pair<uint64_t, uint64_t>> intervals) {
+  ORBIT_CHECK(!intervals.empty());
+  // The timers that sort after the first new interval are merged with the new intervals. Usually,
+  // there are none, and the new intervals are just appended.
+  size_t first_changed_timer = starts_ns.size();
+  while (first_changed_timer > 0 &&
+         std::make_pair(starts_ns[first_changed_timer - 1], ends_ns[first_changed_timer - 1]) >
+             intervals.front()) {
+    --first_changed_timer;
+  }
+
+  std::vector<std::pair<uint64_t, uint64_t>> merged_intervals;
+  merged_intervals.reserve(starts_ns.size() - first_changed_timer + intervals.size());
+  for (size_t i = first_changed_timer; i < starts_ns.size(); ++i) {
+    merged_intervals.emplace_back(starts_ns[i], ends_ns[i]);
+  }
+  const auto middle = static_cast<std::ptrdiff_t>(merged_intervals.size());
+  merged_intervals.insert(merged_intervals.end(), intervals.begin(), intervals.end());
+  std::inplace_merge(merged_intervals.begin(), merged_intervals.begin() + middle,
+                     merged_intervals.end());
+
+  starts_ns.resize(first_changed_timer);
+  ends_ns.resize(first_changed_timer);
+  for (const auto& [start_ns, end_ns] : merged_intervals) {
+    starts_ns.push_back(start_ns);
+    ends_ns.push_back(end_ns);
+  }
+  UpdateTree(first_changed_timer / kBlockSize);
+}
+
+void ScopeStatsIndex::ScopeTimers::UpdateTree(size_t first_changed_block) {
+  const size_t num_blocks = (starts_ns.size() + kBlockSize - 1) / kBlockSize;
+  if (num_blocks > block_capacity) {
+    // Growing the tree moves all the blocks to other nodes, so all of them are recomputed. As the
+    // capacity doubles, this only adds a constant amortized cost per block.
+    block_capacity = std::max<size_t>(block_capacity, 1);
+    while (block_capacity < num_blocks) block_capacity *= 2;
+    tree.assign(2 * block_capacity, Aggregate{});
+    first_changed_block = 0;
+  }
+
+  for (size_t block = first_changed_block; block < num_blocks; ++block) {
+    Aggregate& aggregate = tree[block_capacity + block];
+    aggregate = Aggregate{};
+    const size_t end_timer = std::min((block + 1) * kBlockSize, starts_ns.size());
+    for (size_t i = block * kBlockSize; i < end_timer; ++i) {
+      aggregate.Add(starts_ns[i], ends_ns[i]);
+    }
+  }
+
+  // The ancestors of the changed blocks, level by level up to the root.
+  for (size_t first_node = (block_capacity + first_changed_block) / 2,
+              last_node = (block_capacity + num_blocks - 1) / 2;
+       first_node >= 1; first_node /= 2, last_node /= 2) {
+    for (size_t node = first_node; node <= last_node; ++node) {
+      Aggregate& aggregate = tree[node];
+      aggregate = Aggregate{};
+      aggregate.Add(tree[2 * node]);
+      aggregate.Add(tree[2 * node + 1]);
+    }
+  }
+}
+
+void ScopeStatsIndex::ScopeTimers::Accumulate(size_t node, size_t first_block, size_t end_block,
+                                              size_t first_timer, size_t end_timer,
+                                              uint64_t max_tick, Aggregate* result) const {
+  const size_t node_first_timer = first_block * kBlockSize;
+  const size_t node_end_timer = std::min(end_block * kBlockSize, starts_ns.size());
+  if (node_end_timer <= first_timer || node_first_timer >= end_timer) return;
+
+  // All the timers of the node start in the range, and none of them ends after it.
+  if (first_timer <= node_first_timer && node_end_timer <= end_timer &&
+      tree[node].max_end_ns <= max_tick) {
+    result->Add(tree[node]);
+    return;
+  }
+
+  if (end_block - first_block == 1) {
+    const size_t block_end_timer = std::min(end_timer, node_end_timer);
+    for (size_t i = std::max(first_timer, node_first_timer); i < block_end_timer; ++i) {
+      if (ends_ns[i] <= max_tick) result->Add(starts_ns[i], ends_ns[i]);
+    }
+    return;
+  }
+
+  const size_t middle_block = first_block + (end_block - first_block) / 2;
+  Accumulate(2 * node, first_block, middle_block, first_timer, end_timer, max_tick, result);
+  Accumulate(2 * node + 1, middle_block, end_block, first_timer, end_timer, max_tick, result);
+}
+
+std::pair<size_t, size_t> ScopeStatsIndex::ScopeTimers::GetTimerIndexRange(
+    uint64_t min_tick, uint64_t max_tick) const {
+  const auto first_it = std::lower_bound(starts_ns.begin(), starts_ns.end(), min_tick);
+  const auto end_it = std::upper_bound(first_it, starts_ns.end(), max_tick);
+  return {static_cast<size_t>(first_it - starts_ns.begin()),
+          static_cast<size_t>(end_it - starts_ns.begin())};
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,224 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/algorithm/container.h>
+#include <absl/types/span.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stddef.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "ClientData/MockScopeIdProvider.h"
+#include "ClientData/ScopeId.h"
+#include "ClientData/ScopeStats.h"
+#include "ClientData/ScopeStatsIndex.h"
+#include "ClientData/TimerInfo.h"
+#include "Statistics/QuantileSketch.h"
+
+namespace orbit_client_data {
+
+using ::testing::Invoke;
+
+namespace {
+
+class ScopeStatsIndexTest : public testing::Test {
+ protected:
+  ScopeStatsIndexTest() {
+    EXPECT_CALL(mock_scope_id_provider_, ProvideId)
+        .WillRepeatedly(Invoke([](const TimerInfo& timer) -> std::optional<ScopeId> {
+          if (timer.function_id() == 0) return std::nullopt;
+          return ScopeId(timer.function_id());
+        }));
+  }
+
+  void AddTimer(uint64_t function_id, uint64_t start_ns, uint64_t end_ns) {
+    auto timer = std::make_unique<TimerInfo>();
+    timer->set_function_id(function_id);
+    timer->set_start(start_ns);
+    timer->set_end(end_ns);
+    timers_.push_back(std::move(timer));
+  }
+
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimers() const {
+    std::vector<const TimerInfo*> timers;
+    for (const std::unique_ptr<TimerInfo>& timer : timers_) timers.push_back(timer.get());
+    return timers;
+  }
+
+  // The sorted durations of the timers of `function_id` entirely inside [min_tick, max_tick].
+  [[nodiscard]] std::vector<uint64_t> GetExpectedDurations(uint64_t function_id, uint64_t min_tick,
+                                                           uint64_t max_tick) const {
+    std::vector<uint64_t> durations;
+    for (const std::unique_ptr<TimerInfo>& timer : timers_) {
+      if (timer->function_id() != function_id || timer->start() < min_tick ||
+          timer->end() > max_tick) {
+        continue;
+      }
+      durations.push_back(timer->end() - timer->start());
+    }
+    absl::c_sort(durations);
+    return durations;
+  }
+
+  static void ExpectStatsMatchDurations(const ScopeStats& stats,
+                                        const std::vector<uint64_t>& durations) {
+    ASSERT_EQ(stats.count(), durations.size());
+    if (durations.empty()) return;
+
+    uint64_t total_time_ns = 0;
+    for (uint64_t duration : durations) total_time_ns += duration;
+    const double average_ns =
+        static_cast<double>(total_time_ns) / static_cast<double>(durations.size());
+    double variance_ns = 0.0;
+    for (uint64_t duration : durations) {
+      variance_ns += (static_cast<double>(duration) - average_ns) *
+                     (static_cast<double>(duration) - average_ns);
+    }
+    variance_ns /= static_cast<double>(durations.size());
+
+    EXPECT_EQ(stats.total_time_ns(), total_time_ns);
+    EXPECT_EQ(stats.min_ns(), durations.front());
+    EXPECT_EQ(stats.max_ns(), durations.back());
+    EXPECT_NEAR(stats.variance_ns(), variance_ns, 1e-6 * variance_ns + 1e-6);
+  }
+
+  MockScopeIdProvider mock_scope_id_provider_;
+  std::vector<std::unique_ptr<TimerInfo>> timers_;
+};
+
+constexpr uint64_t kFunctionId = 1;
+constexpr uint64_t kRecursiveFunctionId = 2;
+constexpr uint64_t kUnknownFunctionId = 3;
+
+}  // namespace
+
+TEST_F(ScopeStatsIndexTest, Empty) {
+  ScopeStatsIndex index{mock_scope_id_provider_, {}};
+  EXPECT_TRUE(index.GetAllProvidedScopeIds().empty());
+  EXPECT_EQ(index.ComputeScopeStats(ScopeId(kFunctionId), 0, 100).count(), 0);
+  EXPECT_TRUE(index.ComputeSortedTimerDurations(ScopeId(kFunctionId), 0, 100).empty());
+  EXPECT_EQ(index.ComputeDurationSketch(ScopeId(kFunctionId), 0, 100).count(), 0);
+}
+
+TEST_F(ScopeStatsIndexTest, OnlyCountsTimersEntirelyInTheRange) {
+  AddTimer(kFunctionId, 10, 20);
+  AddTimer(kFunctionId, 30, 45);
+  AddTimer(kFunctionId, 50, 80);
+  AddTimer(/*function_id=*/0, 20, 30);
+  ScopeStatsIndex index{mock_scope_id_provider_, GetTimers()};
+
+  EXPECT_THAT(index.GetAllProvidedScopeIds(), testing::ElementsAre(ScopeId(kFunctionId)));
+
+  ScopeStats stats = index.ComputeScopeStats(ScopeId(kFunctionId), 10, 45);
+  EXPECT_EQ(stats.count(), 2);
+  EXPECT_EQ(stats.total_time_ns(), 25);
+  EXPECT_EQ(stats.min_ns(), 10);
+  EXPECT_EQ(stats.max_ns(), 15);
+  EXPECT_DOUBLE_EQ(stats.variance_ns(), 6.25);
+  EXPECT_THAT(index.ComputeSortedTimerDurations(ScopeId(kFunctionId), 10, 45),
+              testing::ElementsAre(10, 15));
+  const orbit_statistics::QuantileSketch sketch =
+      index.ComputeDurationSketch(ScopeId(kFunctionId), 10, 45);
+  EXPECT_EQ(sketch.count(), 2);
+  EXPECT_EQ(sketch.GetQuantile(0.0), 10);
+  EXPECT_EQ(sketch.GetQuantile(1.0), 15);
+
+  EXPECT_EQ(index.ComputeScopeStats(ScopeId(kFunctionId), 11, 79).count(), 1);
+  EXPECT_EQ(index.ComputeScopeStats(ScopeId(kFunctionId), 21, 29).count(), 0);
+  EXPECT_EQ(index.ComputeScopeStats(ScopeId(kUnknownFunctionId), 0, 100).count(), 0);
+}
+
+TEST_F(ScopeStatsIndexTest, MatchesBruteForceWithRecursiveTimers) {
+  std::mt19937 random_engine{42};
+  std::uniform_int_distribution<uint64_t> duration_distribution{1, 1000};
+  std::uniform_int_distribution<int> recursion_distribution{0, 3};
+
+  uint64_t timestamp_ns = 0;
+  for (size_t i = 0; i < 5000; ++i) {
+    const uint64_t start_ns = timestamp_ns;
+    const uint64_t end_ns = start_ns + duration_distribution(random_engine);
+    AddTimer(kFunctionId, start_ns, end_ns);
+
+    // Nested calls of a recursive function inside the timer, some of them spanning several blocks
+    // of the index.
+    const int recursion_depth = recursion_distribution(random_engine);
+    for (int depth = 0; depth < recursion_depth; ++depth) {
+      AddTimer(kRecursiveFunctionId, start_ns + depth, end_ns - depth);
+    }
+    timestamp_ns = end_ns + duration_distribution(random_engine);
+  }
+  AddTimer(kRecursiveFunctionId, 0, timestamp_ns);
+  ScopeStatsIndex index{mock_scope_id_provider_, GetTimers()};
+
+  std::uniform_int_distribution<uint64_t> tick_distribution{0, timestamp_ns};
+  for (size_t i = 0; i < 100; ++i) {
+    uint64_t min_tick = tick_distribution(random_engine);
+    uint64_t max_tick = tick_distribution(random_engine);
+    if (min_tick > max_tick) std::swap(min_tick, max_tick);
+
+    for (uint64_t function_id : {kFunctionId, kRecursiveFunctionId}) {
+      const std::vector<uint64_t> expected_durations =
+          GetExpectedDurations(function_id, min_tick, max_tick);
+      ExpectStatsMatchDurations(index.ComputeScopeStats(ScopeId(function_id), min_tick, max_tick),
+                                expected_durations);
+      EXPECT_EQ(index.ComputeSortedTimerDurations(ScopeId(function_id), min_tick, max_tick),
+                expected_durations);
+      EXPECT_EQ(index.ComputeDurationSketch(ScopeId(function_id), min_tick, max_tick).count(),
+                expected_durations.size());
+    }
+  }
+
+  ExpectStatsMatchDurations(index.ComputeScopeStats(ScopeId(kRecursiveFunctionId), 0, timestamp_ns),
+                            GetExpectedDurations(kRecursiveFunctionId, 0, timestamp_ns));
+}
+
+TEST_F(ScopeStatsIndexTest, AddingTimersMatchesBruteForce) {
+  std::mt19937 random_engine{42};
+  std::uniform_int_distribution<uint64_t> duration_distribution{1, 1000};
+  std::uniform_int_distribution<size_t> batch_size_distribution{1, 300};
+
+  ScopeStatsIndex index{mock_scope_id_provider_, {}};
+  uint64_t timestamp_ns = 0;
+  for (size_t batch = 0; batch < 50; ++batch) {
+    const size_t first_new_timer = timers_.size();
+    const uint64_t batch_start_ns = timestamp_ns;
+    const size_t batch_size = batch_size_distribution(random_engine);
+    for (size_t i = 0; i < batch_size; ++i) {
+      const uint64_t start_ns = timestamp_ns;
+      const uint64_t end_ns = start_ns + duration_distribution(random_engine);
+      AddTimer(kFunctionId, start_ns, end_ns);
+      timestamp_ns = end_ns + duration_distribution(random_engine);
+    }
+    // Timers that start before other timers of their scope, in the same batch and in the index.
+    AddTimer(kRecursiveFunctionId, batch_start_ns, timestamp_ns);
+    if (batch % 10 == 9) AddTimer(kRecursiveFunctionId, 0, timestamp_ns);
+
+    const std::vector<const TimerInfo*> timers = GetTimers();
+    index.AddTimers(mock_scope_id_provider_, absl::MakeConstSpan(timers).subspan(first_new_timer));
+
+    std::uniform_int_distribution<uint64_t> tick_distribution{0, timestamp_ns};
+    for (size_t i = 0; i < 10; ++i) {
+      uint64_t min_tick = tick_distribution(random_engine);
+      uint64_t max_tick = tick_distribution(random_engine);
+      if (min_tick > max_tick) std::swap(min_tick, max_tick);
+
+      for (uint64_t function_id : {kFunctionId, kRecursiveFunctionId}) {
+        const std::vector<uint64_t> expected_durations =
+            GetExpectedDurations(function_id, min_tick, max_tick);
+        ExpectStatsMatchDurations(
+            index.ComputeScopeStats(ScopeId(function_id), min_tick, max_tick), expected_durations);
+        EXPECT_EQ(index.ComputeSortedTimerDurations(ScopeId(function_id), min_tick, max_tick),
+                  expected_durations);
+      }
+    }
+  }
+}
+
+}  // namespace orbit_client_data
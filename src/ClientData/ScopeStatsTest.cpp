@@ -0,0 +1,37 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "ClientData/ScopeStats.h"
+
+namespace orbit_client_data {
+
+TEST(ScopeStats, MergeStats) {
+  constexpr std::array<uint64_t, 6> kDurations = {100, 300, 200, 1000, 50, 70};
+  ScopeStats all_stats;
+  ScopeStats first_half_stats;
+  ScopeStats second_half_stats;
+  for (size_t i = 0; i < kDurations.size(); ++i) {
+    all_stats.UpdateStats(kDurations[i]);
+    (i < kDurations.size() / 2 ? first_half_stats : second_half_stats).UpdateStats(kDurations[i]);
+  }
+
+  ScopeStats merged_stats;
+  merged_stats.MergeStats(first_half_stats);
+  merged_stats.MergeStats(ScopeStats{});
+  merged_stats.MergeStats(second_half_stats);
+
+  EXPECT_EQ(merged_stats.count(), all_stats.count());
+  EXPECT_EQ(merged_stats.total_time_ns(), all_stats.total_time_ns());
+  EXPECT_EQ(merged_stats.min_ns(), all_stats.min_ns());
+  EXPECT_EQ(merged_stats.max_ns(), all_stats.max_ns());
+  // UpdateStats uses integer averages, so the variances are only approximately equal.
+  EXPECT_NEAR(merged_stats.variance_ns(), all_stats.variance_ns(), 1e-3 * all_stats.variance_ns());
+}
+
+}  // namespace orbit_client_data
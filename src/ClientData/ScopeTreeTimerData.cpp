@@ -11,12 +11,12 @@
 #include "ApiInterface/Orbit.h"
 #include "ClientData/FastRenderingUtils.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
 namespace orbit_client_data {
 
-const orbit_client_protos::TimerInfo& ScopeTreeTimerData::AddTimer(
-    orbit_client_protos::TimerInfo timer_info, uint32_t /*depth*/) {
+const TimerInfo& ScopeTreeTimerData::AddTimer(TimerInfo timer_info, uint32_t /*depth*/) {
   // We don't need to have one TimerChain per depth because it's managed by ScopeTree.
   const auto& timer_info_ref = timer_data_.AddTimer(std::move(timer_info), /*unused_depth=*/0);
 
@@ -43,16 +43,16 @@ void ScopeTreeTimerData::OnCaptureComplete() {
   }
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers(
-    uint64_t start_ns, uint64_t end_ns, bool exclusive) const {
+std::vector<const TimerInfo*> ScopeTreeTimerData::GetTimers(uint64_t start_ns, uint64_t end_ns,
+                                                            bool exclusive) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimers", kOrbitColorAmber);
   // The query is for the interval [start_ns, end_ns], but it's easier to work with the close-open
   // interval [start_ns, end_ns+1). We have to be careful with overflowing.
   end_ns = std::max(end_ns, end_ns + 1);
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers;
+  std::vector<const TimerInfo*> all_timers;
 
   for (uint32_t depth = 0; depth < GetDepth(); ++depth) {
-    std::vector<const orbit_client_protos::TimerInfo*> timers_at_depth =
+    std::vector<const TimerInfo*> timers_at_depth =
         exclusive ? GetTimersAtDepthExclusive(depth, start_ns, end_ns)
                   : GetTimersAtDepth(depth, start_ns, end_ns);
     all_timers.insert(all_timers.end(), timers_at_depth.begin(), timers_at_depth.end());
@@ -61,10 +61,11 @@ std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers
   return all_timers;
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthExclusive(
-    uint32_t depth, uint64_t start_ns, uint64_t end_ns) const {
+std::vector<const TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthExclusive(uint32_t depth,
+                                                                            uint64_t start_ns,
+                                                                            uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthExclusive", kOrbitColorGreen);
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers_at_depth;
+  std::vector<const TimerInfo*> all_timers_at_depth;
   absl::MutexLock lock(&scope_tree_mutex_);
 
   const auto& ordered_nodes = scope_tree_.GetOrderedNodesAtDepth(depth);
@@ -82,9 +83,10 @@ std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers
   return all_timers_at_depth;
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepth(
-    uint32_t depth, uint64_t start_ns, uint64_t end_ns) const {
-  std::vector<const orbit_client_protos::TimerInfo*> all_timers_at_depth;
+std::vector<const TimerInfo*> ScopeTreeTimerData::GetTimersAtDepth(uint32_t depth,
+                                                                   uint64_t start_ns,
+                                                                   uint64_t end_ns) const {
+  std::vector<const TimerInfo*> all_timers_at_depth;
   absl::MutexLock lock(&scope_tree_mutex_);
 
   const auto& ordered_nodes = scope_tree_.GetOrderedNodesAtDepth(depth);
@@ -103,7 +105,7 @@ std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers
   return all_timers_at_depth;
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthDiscretized(
+std::vector<const TimerInfo*> ScopeTreeTimerData::GetTimersAtDepthDiscretized(
     uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorAmber);
   if (resolution == 0) return {};
@@ -112,9 +114,8 @@ std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers
   // interval [start_ns, end_ns+1). We have to be careful with overflowing.
   end_ns = std::max(end_ns, end_ns + 1);
 
-  std::vector<const orbit_client_protos::TimerInfo*> discretized_timers;
-  const orbit_client_protos::TimerInfo* timer_info =
-      scope_tree_.FindFirstScopeAtOrAfterTime(depth, start_ns);
+  std::vector<const TimerInfo*> discretized_timers;
+  const TimerInfo* timer_info = scope_tree_.FindFirstScopeAtOrAfterTime(depth, start_ns);
 
   while (timer_info != nullptr && timer_info->start() < end_ns) {
     discretized_timers.push_back(timer_info);
@@ -128,26 +129,22 @@ std::vector<const orbit_client_protos::TimerInfo*> ScopeTreeTimerData::GetTimers
   return discretized_timers;
 }
 
-const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetLeft(
-    const orbit_client_protos::TimerInfo& timer) const {
+const TimerInfo* ScopeTreeTimerData::GetLeft(const TimerInfo& timer) const {
   absl::MutexLock lock(&scope_tree_mutex_);
   return scope_tree_.FindPreviousScopeAtDepth(timer);
 }
 
-const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetRight(
-    const orbit_client_protos::TimerInfo& timer) const {
+const TimerInfo* ScopeTreeTimerData::GetRight(const TimerInfo& timer) const {
   absl::MutexLock lock(&scope_tree_mutex_);
   return scope_tree_.FindNextScopeAtDepth(timer);
 }
 
-const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetUp(
-    const orbit_client_protos::TimerInfo& timer) const {
+const TimerInfo* ScopeTreeTimerData::GetUp(const TimerInfo& timer) const {
   absl::MutexLock lock(&scope_tree_mutex_);
   return scope_tree_.FindParent(timer);
 }
 
-const orbit_client_protos::TimerInfo* ScopeTreeTimerData::GetDown(
-    const orbit_client_protos::TimerInfo& timer) const {
+const TimerInfo* ScopeTreeTimerData::GetDown(const TimerInfo& timer) const {
   absl::MutexLock lock(&scope_tree_mutex_);
   return scope_tree_.FindFirstChild(timer);
 }
@@ -9,9 +9,7 @@
 #include <vector>
 
 #include "ClientData/ScopeTreeTimerData.h"
-#include "ClientProtos/capture_data.pb.h"
-
-using orbit_client_protos::TimerInfo;
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
@@ -70,7 +68,7 @@ TEST(ScopeTreeTimerData, EmptyWhenCreated) {
 TEST(ScopeTreeTimerData, AddTimer) {
   static constexpr uint32_t kThreadId = 2;
   ScopeTreeTimerData scope_tree_timer_data(kThreadId);
-  orbit_client_protos::TimerInfo timer_info;
+  TimerInfo timer_info;
 
   scope_tree_timer_data.AddTimer(timer_info);
   EXPECT_FALSE(scope_tree_timer_data.IsEmpty());
@@ -82,7 +80,7 @@ TEST(ScopeTreeTimerData, AddTimer) {
 TEST(ScopeTreeTimerData, OnCaptureComplete) {
   ScopeTreeTimerData scope_tree_timer_data(
       -1, ScopeTreeTimerData::ScopeTreeUpdateType::kOnCaptureComplete);
-  orbit_client_protos::TimerInfo timer_info;
+  TimerInfo timer_info;
 
   scope_tree_timer_data.AddTimer(timer_info);
 
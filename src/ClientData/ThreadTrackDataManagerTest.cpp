@@ -5,16 +5,15 @@
 #include <gtest/gtest.h>
 #include <stdint.h>
 
+#include <thread>
 #include <vector>
 
 #include "ClientData/ScopeTreeTimerData.h"
 #include "ClientData/ThreadTrackDataManager.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
-using orbit_client_protos::TimerInfo;
-
 constexpr uint32_t kThreadId1 = 1;
 constexpr uint32_t kThreadId2 = 2;
 constexpr uint32_t kNotUsedThreadId = 3;
@@ -55,4 +54,31 @@ TEST(ThreadTrackDataManager, AddTimer) {
   EXPECT_FALSE(thread_track_data_manager.GetScopeTreeTimerData(kThreadId2)->IsEmpty());
 }
 
+TEST(ThreadTrackDataManager, AddTimerFromDifferentThreads) {
+  ThreadTrackDataManager thread_track_data_manager;
+  constexpr uint32_t kNumThreads = 8;
+  constexpr size_t kNumTimersPerThread = 1000;
+
+  // Each thread adds the timers of a different thread id, like the shards of the client ingest.
+  std::vector<std::thread> threads;
+  for (uint32_t thread_id = 1; thread_id <= kNumThreads; ++thread_id) {
+    threads.emplace_back([&thread_track_data_manager, thread_id] {
+      TimerInfo timer_info;
+      timer_info.set_thread_id(thread_id);
+      for (size_t i = 0; i < kNumTimersPerThread; ++i) {
+        timer_info.set_start(2 * i);
+        timer_info.set_end(2 * i + 1);
+        thread_track_data_manager.AddTimer(timer_info);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+
+  EXPECT_EQ(thread_track_data_manager.GetAllScopeTreeTimerData().size(), kNumThreads);
+  for (uint32_t thread_id = 1; thread_id <= kNumThreads; ++thread_id) {
+    EXPECT_EQ(thread_track_data_manager.GetScopeTreeTimerData(thread_id)->GetNumberOfTimers(),
+              kNumTimersPerThread);
+  }
+}
+
 }  // namespace orbit_client_data
\ No newline at end of file
@@ -4,12 +4,11 @@
 
 #include "ClientData/ThreadTrackDataProvider.h"
 
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Append.h"
 
 namespace orbit_client_data {
 
-using orbit_client_protos::TimerInfo;
-
 std::vector<uint32_t> ThreadTrackDataProvider::GetAllThreadIds() const {
   std::vector<uint32_t> all_thread_id;
   for (const ScopeTreeTimerData* scope_tree_timer_data :
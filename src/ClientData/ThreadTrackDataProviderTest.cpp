@@ -11,11 +11,10 @@
 
 #include "ClientData/ThreadTrackDataProvider.h"
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
-using orbit_client_protos::TimerInfo;
 using ::testing::UnorderedElementsAre;
 
 namespace {
@@ -87,7 +86,7 @@ TEST(ThreadTrackDataProvider, InsertAndGetTimer) {
   std::vector<const TimerInfo*> all_timers = thread_track_data_provider.GetTimers(kThreadId1);
   EXPECT_EQ(all_timers.size(), 1);
 
-  const orbit_client_protos::TimerInfo* inserted_timer_info = all_timers[0];
+  const TimerInfo* inserted_timer_info = all_timers[0];
   EXPECT_EQ(inserted_timer_info->thread_id(), kThreadId1);
   EXPECT_EQ(inserted_timer_info->start(), kTimerStart);
   EXPECT_EQ(inserted_timer_info->end(), kTimerEnd);
@@ -111,7 +110,7 @@ TEST(ThreadTrackDataProvider, OnCaptureComplete) {
 
   std::vector<const TimerInfo*> all_timers = thread_track_data_provider.GetTimers(kThreadId1);
   EXPECT_EQ(all_timers.size(), 1);
-  const orbit_client_protos::TimerInfo* inserted_timer_info = all_timers[0];
+  const TimerInfo* inserted_timer_info = all_timers[0];
   EXPECT_EQ(inserted_timer_info->thread_id(), 1);
   EXPECT_EQ(inserted_timer_info->start(), kTimerStart);
   EXPECT_EQ(inserted_timer_info->end(), kTimerEnd);
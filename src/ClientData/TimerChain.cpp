@@ -6,9 +6,7 @@
 
 #include <algorithm>
 
-#include "ClientProtos/capture_data.pb.h"
-
-using orbit_client_protos::TimerInfo;
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
@@ -16,11 +14,10 @@ bool TimerBlock::Intersects(uint64_t min, uint64_t max) const {
   return (min <= max_timestamp_ && max >= min_timestamp_);
 }
 
-const orbit_client_protos::TimerInfo* TimerBlock::LowerBound(uint64_t min_ns) const {
-  auto it = std::lower_bound(data_.begin(), data_.end(), min_ns,
-                             [](const orbit_client_protos::TimerInfo& timer_info, uint64_t value) {
-                               return timer_info.end() < value;
-                             });
+const TimerInfo* TimerBlock::LowerBound(uint64_t min_ns) const {
+  auto it = std::lower_bound(
+      data_.begin(), data_.end(), min_ns,
+      [](const TimerInfo& timer_info, uint64_t value) { return timer_info.end() < value; });
   if (it == data_.end()) return nullptr;
   return &*it;
 }
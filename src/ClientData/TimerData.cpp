@@ -7,13 +7,10 @@
 #include <utility>
 
 #include "ApiInterface/Orbit.h"
-#include "ClientData/FastRenderingUtils.h"
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
-using orbit_client_protos::TimerInfo;
-
 namespace orbit_client_data {
 
 const TimerInfo& TimerData::AddTimer(TimerInfo timer_info, uint32_t depth) {
@@ -21,13 +18,23 @@ const TimerInfo& TimerData::AddTimer(TimerInfo timer_info, uint32_t depth) {
     process_id_ = timer_info.process_id();
   }
 
-  TimerChain* timer_chain = GetOrCreateTimerChain(depth);
   UpdateMinTime(timer_info.start());
   UpdateMaxTime(timer_info.end());
   ++num_timers_;
   UpdateDepth(timer_info.depth() + 1);
 
-  return timer_chain->emplace_back(std::move(timer_info));
+  absl::MutexLock lock(&mutex_);
+  ++num_timers_per_type_[timer_info.type()];
+  TimerChain* timer_chain = GetOrCreateTimerChain(depth);
+  const TimerInfo& added_timer_info = timer_chain->emplace_back(std::move(timer_info));
+  lod_pyramids_[depth].Add(timer_chain->GetLastBlock(), added_timer_info);
+  return added_timer_info;
+}
+
+size_t TimerData::GetNumberOfTimersOfType(TimerInfo::Type type) const {
+  absl::MutexLock lock(&mutex_);
+  const auto it = num_timers_per_type_.find(type);
+  return it != num_timers_per_type_.end() ? it->second : 0;
 }
 
 std::vector<const TimerChain*> TimerData::GetChains() const {
@@ -50,19 +57,18 @@ const TimerChain* TimerData::GetChain(uint64_t depth) const {
   return nullptr;
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimers(uint64_t min_tick,
-                                                                        uint64_t max_tick,
-                                                                        bool exclusive) const {
+std::vector<const TimerInfo*> TimerData::GetTimers(uint64_t min_tick, uint64_t max_tick,
+                                                   bool exclusive) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorBlueGrey);
   // TODO(b/204173236): use it in TimerTracks.
   absl::MutexLock lock(&mutex_);
-  std::vector<const orbit_client_protos::TimerInfo*> timers;
+  std::vector<const TimerInfo*> timers;
   for (const auto& [depth, chain] : timers_) {
     ORBIT_CHECK(chain != nullptr);
     for (const auto& block : *chain) {
       if (!block.Intersects(min_tick, max_tick)) continue;
       for (uint64_t i = 0; i < block.size(); i++) {
-        const orbit_client_protos::TimerInfo* timer = &block[i];
+        const TimerInfo* timer = &block[i];
         if (exclusive) {
           if (timer->end() <= max_tick && timer->start() >= min_tick) timers.push_back(timer);
         } else {
@@ -75,8 +81,10 @@ std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimers(uint64_t
   return timers;
 }
 
-std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimersAtDepthDiscretized(
-    uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const {
+std::vector<const TimerInfo*> TimerData::GetTimersAtDepthDiscretized(uint32_t depth,
+                                                                     uint32_t resolution,
+                                                                     uint64_t start_ns,
+                                                                     uint64_t end_ns) const {
   ORBIT_SCOPE_WITH_COLOR("GetTimersAtDepthDiscretized", kOrbitColorBlueGrey);
   absl::MutexLock lock(&mutex_);
   // The query is for the interval [start_ns, end_ns], but it's easier to work with the close-open
@@ -84,28 +92,9 @@ std::vector<const orbit_client_protos::TimerInfo*> TimerData::GetTimersAtDepthDi
   // unsigned value. In that case, we will just ignore this max_timestamp for simplicity.
   end_ns = std::max(end_ns, end_ns + 1);
 
-  if (timers_.find(depth) == timers_.end()) return {};
-
-  std::vector<const orbit_client_protos::TimerInfo*> discretized_timers;
-  uint64_t next_pixel_start_ns = start_ns;
-
-  // We are iterating through all blocks until we are after end_ns.
-  for (const auto& block : *timers_.at(depth)) {
-    if (block.MinTimestamp() >= end_ns) break;
-
-    // Several candidate timers might be in the same block.
-    while (block.Intersects(next_pixel_start_ns, end_ns) && next_pixel_start_ns < end_ns) {
-      // First timer for which the end timestamp isn't smaller than the start of the next pixel.
-      const orbit_client_protos::TimerInfo* timer = block.LowerBound(next_pixel_start_ns);
-      if (timer == nullptr || timer->start() >= end_ns) break;
-      discretized_timers.push_back(timer);
-
-      // Use the time of next pixel boundary as a threshold to avoid returning several timers
-      // for the same pixel that will overlap after.
-      next_pixel_start_ns = GetNextPixelBoundaryTimeNs(timer->end(), resolution, start_ns, end_ns);
-    }
-  }
-  return discretized_timers;
+  auto it = lod_pyramids_.find(depth);
+  if (it == lod_pyramids_.end()) return {};
+  return it->second.GetTimersDiscretized(resolution, start_ns, end_ns);
 }
 
 const TimerInfo* TimerData::GetFirstAfterStartTime(uint64_t time, uint32_t depth) const {
@@ -115,7 +104,7 @@ const TimerInfo* TimerData::GetFirstAfterStartTime(uint64_t time, uint32_t depth
   // TODO(b/201044462): do better than linear search...
   for (const auto& it : *chain) {
     for (size_t k = 0; k < it.size(); ++k) {
-      const orbit_client_protos::TimerInfo& timer_info = it[k];
+      const TimerInfo& timer_info = it[k];
       if (timer_info.start() > time) {
         return &timer_info;
       }
@@ -128,12 +117,12 @@ const TimerInfo* TimerData::GetFirstBeforeStartTime(uint64_t time, uint32_t dept
   const orbit_client_data::TimerChain* chain = GetChain(depth);
   if (chain == nullptr) return nullptr;
 
-  const orbit_client_protos::TimerInfo* first_timer_before_time = nullptr;
+  const TimerInfo* first_timer_before_time = nullptr;
 
   // TODO(b/201044462): do better than linear search...
   for (const auto& it : *chain) {
     for (size_t k = 0; k < it.size(); ++k) {
-      const orbit_client_protos::TimerInfo* timer_info = &it[k];
+      const TimerInfo* timer_info = &it[k];
       if (timer_info->start() >= time) {
         return first_timer_before_time;
       }
@@ -157,7 +146,6 @@ void TimerData::UpdateMaxTime(uint64_t max_time) {
 }
 
 TimerChain* TimerData::GetOrCreateTimerChain(uint64_t depth) {
-  absl::MutexLock lock(&mutex_);
   auto it = timers_.find(depth);
   if (it != timers_.end()) {
     return it->second.get();
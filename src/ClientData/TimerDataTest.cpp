@@ -12,12 +12,10 @@
 
 #include "ClientData/TimerChain.h"
 #include "ClientData/TimerData.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
-using orbit_client_protos::TimerInfo;
-
 TEST(TimerData, IsEmpty) {
   TimerData timer_data;
   EXPECT_TRUE(timer_data.GetChains().empty());
@@ -217,6 +215,26 @@ TEST(TimerData, FindTimers) {
   }
 }
 
+TEST(TimerData, GetNumberOfTimersOfType) {
+  TimerData timer_data;
+  EXPECT_EQ(timer_data.GetNumberOfTimersOfType(TimerInfo::kApiScopeAsync), 0);
+
+  TimerInfo async_timer = GetLeftTimer();
+  async_timer.set_type(TimerInfo::kApiScopeAsync);
+  timer_data.AddTimer(async_timer, 0);
+  TimerInfo other_timer = GetRightTimer();
+  other_timer.set_type(TimerInfo::kApiEvent);
+  timer_data.AddTimer(other_timer, 0);
+  async_timer = GetDownTimer();
+  async_timer.set_type(TimerInfo::kApiScopeAsync);
+  timer_data.AddTimer(async_timer, 1);
+
+  EXPECT_EQ(timer_data.GetNumberOfTimers(), 3);
+  EXPECT_EQ(timer_data.GetNumberOfTimersOfType(TimerInfo::kApiScopeAsync), 2);
+  EXPECT_EQ(timer_data.GetNumberOfTimersOfType(TimerInfo::kApiEvent), 1);
+  EXPECT_EQ(timer_data.GetNumberOfTimersOfType(TimerInfo::kGpuActivity), 0);
+}
+
 void CheckGetTimers(std::unique_ptr<TimerData> timer_data) {
   EXPECT_EQ(timer_data->GetTimers(0, kLeftTimerStart - 1).size(), 0);
   EXPECT_EQ(timer_data->GetTimers(kRightTimerEnd + 1, kRightTimerEnd + 10).size(), 0);
@@ -0,0 +1,80 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/TimerInfo.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_client_data {
+
+TimerInfo::TimerInfo(const TimerInfo& other)
+    : start_{other.start_},
+      end_{other.end_},
+      function_id_{other.function_id_},
+      user_data_key_{other.user_data_key_},
+      process_id_{other.process_id_},
+      thread_id_{other.thread_id_},
+      depth_{other.depth_},
+      processor_{other.processor_},
+      type_{other.type_},
+      rare_fields_{other.rare_fields_ != nullptr ? std::make_unique<RareFields>(*other.rare_fields_)
+                                                 : nullptr} {}
+
+TimerInfo& TimerInfo::operator=(const TimerInfo& other) {
+  if (this == &other) return *this;
+  TimerInfo copy{other};
+  *this = std::move(copy);
+  return *this;
+}
+
+uint64_t TimerInfo::registers(int index) const {
+  ORBIT_CHECK(index >= 0 && index < registers_size());
+  return rare_fields_->registers[static_cast<size_t>(index)];
+}
+
+const orbit_client_protos::Color& TimerInfo::color() const {
+  if (!has_color()) return orbit_client_protos::Color::default_instance();
+  return rare_fields_->color.value();
+}
+
+orbit_client_protos::Color* TimerInfo::mutable_color() {
+  RareFields* rare_fields = mutable_rare_fields();
+  if (!rare_fields->color.has_value()) rare_fields->color.emplace();
+  return &rare_fields->color.value();
+}
+
+const std::string& TimerInfo::api_scope_name() const {
+  static const std::string kEmptyString;
+  return rare_fields_ != nullptr ? rare_fields_->api_scope_name : kEmptyString;
+}
+
+bool operator==(const TimerInfo& lhs, const TimerInfo& rhs) {
+  if (lhs.start() != rhs.start() || lhs.end() != rhs.end() ||
+      lhs.process_id() != rhs.process_id() || lhs.thread_id() != rhs.thread_id() ||
+      lhs.depth() != rhs.depth() || lhs.type() != rhs.type() ||
+      lhs.processor() != rhs.processor() || lhs.callstack_id() != rhs.callstack_id() ||
+      lhs.function_id() != rhs.function_id() || lhs.user_data_key() != rhs.user_data_key() ||
+      lhs.timeline_hash() != rhs.timeline_hash() || lhs.group_id() != rhs.group_id() ||
+      lhs.api_async_scope_id() != rhs.api_async_scope_id() ||
+      lhs.address_in_function() != rhs.address_in_function() ||
+      lhs.api_scope_name() != rhs.api_scope_name() ||
+      lhs.registers_size() != rhs.registers_size()) {
+    return false;
+  }
+  for (int i = 0; i < lhs.registers_size(); ++i) {
+    if (lhs.registers(i) != rhs.registers(i)) return false;
+  }
+  // As for the protobuf message, a missing color is equivalent to a default-constructed one.
+  const orbit_client_protos::Color& lhs_color = lhs.color();
+  const orbit_client_protos::Color& rhs_color = rhs.color();
+  return lhs_color.red() == rhs_color.red() && lhs_color.green() == rhs_color.green() &&
+         lhs_color.blue() == rhs_color.blue() && lhs_color.alpha() == rhs_color.alpha();
+}
+
+}  // namespace orbit_client_data
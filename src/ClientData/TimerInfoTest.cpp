@@ -0,0 +1,109 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "ClientData/TimerInfo.h"
+#include "ClientProtos/capture_data.pb.h"
+
+namespace orbit_client_data {
+
+TEST(TimerInfo, InlineFieldsDefaultToZero) {
+  TimerInfo timer_info;
+  EXPECT_EQ(timer_info.start(), 0);
+  EXPECT_EQ(timer_info.end(), 0);
+  EXPECT_EQ(timer_info.type(), TimerInfo::kNone);
+  EXPECT_EQ(timer_info.callstack_id(), 0);
+  EXPECT_EQ(timer_info.registers_size(), 0);
+  EXPECT_TRUE(timer_info.api_scope_name().empty());
+  EXPECT_FALSE(timer_info.has_color());
+  EXPECT_EQ(timer_info.color().alpha(), 0);
+}
+
+TEST(TimerInfo, SettersAndGetters) {
+  TimerInfo timer_info;
+  timer_info.set_start(1);
+  timer_info.set_end(2);
+  timer_info.set_process_id(3);
+  timer_info.set_thread_id(4);
+  timer_info.set_depth(5);
+  timer_info.set_type(TimerInfo::kApiScopeAsync);
+  timer_info.set_processor(-1);
+  timer_info.set_function_id(6);
+  timer_info.set_user_data_key(7);
+  timer_info.set_callstack_id(8);
+  timer_info.set_timeline_hash(9);
+  timer_info.set_group_id(10);
+  timer_info.set_api_async_scope_id(11);
+  timer_info.set_address_in_function(12);
+  timer_info.add_registers(13);
+  timer_info.add_registers(14);
+  timer_info.mutable_color()->set_red(15);
+  timer_info.set_api_scope_name("name");
+
+  EXPECT_EQ(timer_info.start(), 1);
+  EXPECT_EQ(timer_info.end(), 2);
+  EXPECT_EQ(timer_info.process_id(), 3);
+  EXPECT_EQ(timer_info.thread_id(), 4);
+  EXPECT_EQ(timer_info.depth(), 5);
+  EXPECT_EQ(timer_info.type(), TimerInfo::kApiScopeAsync);
+  EXPECT_EQ(timer_info.processor(), -1);
+  EXPECT_EQ(timer_info.function_id(), 6);
+  EXPECT_EQ(timer_info.user_data_key(), 7);
+  EXPECT_EQ(timer_info.callstack_id(), 8);
+  EXPECT_EQ(timer_info.timeline_hash(), 9);
+  EXPECT_EQ(timer_info.group_id(), 10);
+  EXPECT_EQ(timer_info.api_async_scope_id(), 11);
+  EXPECT_EQ(timer_info.address_in_function(), 12);
+  ASSERT_EQ(timer_info.registers_size(), 2);
+  EXPECT_EQ(timer_info.registers(0), 13);
+  EXPECT_EQ(timer_info.registers(1), 14);
+  EXPECT_TRUE(timer_info.has_color());
+  EXPECT_EQ(timer_info.color().red(), 15);
+  EXPECT_EQ(timer_info.api_scope_name(), "name");
+}
+
+TEST(TimerInfo, CopyIsDeep) {
+  TimerInfo timer_info;
+  timer_info.set_start(1);
+  timer_info.set_api_scope_name("name");
+
+  TimerInfo copy{timer_info};
+  EXPECT_EQ(copy, timer_info);
+  copy.set_api_scope_name("other");
+  EXPECT_EQ(timer_info.api_scope_name(), "name");
+  EXPECT_NE(copy, timer_info);
+
+  copy = timer_info;
+  EXPECT_EQ(copy, timer_info);
+  timer_info.add_registers(2);
+  EXPECT_EQ(copy.registers_size(), 0);
+}
+
+TEST(TimerInfo, Move) {
+  TimerInfo timer_info;
+  timer_info.set_end(1);
+  timer_info.set_callstack_id(2);
+
+  TimerInfo moved{std::move(timer_info)};
+  EXPECT_EQ(moved.end(), 1);
+  EXPECT_EQ(moved.callstack_id(), 2);
+}
+
+TEST(TimerInfo, MissingColorEqualsDefaultColor) {
+  TimerInfo without_color;
+  TimerInfo with_default_color;
+  (void)with_default_color.mutable_color();
+  EXPECT_FALSE(without_color.has_color());
+  EXPECT_TRUE(with_default_color.has_color());
+  EXPECT_EQ(without_color, with_default_color);
+
+  with_default_color.mutable_color()->set_blue(1);
+  EXPECT_NE(without_color, with_default_color);
+}
+
+}  // namespace orbit_client_data
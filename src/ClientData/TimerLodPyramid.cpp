@@ -0,0 +1,105 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ClientData/TimerLodPyramid.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "ClientData/FastRenderingUtils.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_client_data {
+
+void TimerLodPyramid::Add(const TimerBlock& block, const TimerInfo& timer) {
+  if (blocks_.empty() || blocks_.back() != &block) blocks_.push_back(&block);
+
+  size_t index = blocks_.size() - 1;
+  for (size_t level = 0;; ++level) {
+    if (level == levels_.size()) levels_.emplace_back();
+    std::vector<Bucket>& buckets = levels_[level];
+    if (index == buckets.size()) buckets.emplace_back();
+    ORBIT_CHECK(index < buckets.size());
+    UpdateBucket(buckets[index], timer);
+
+    if (level + 1 == levels_.size()) {
+      if (buckets.size() == 1) break;
+      // The top level just got its second bucket: add a new top level whose only bucket summarizes
+      // the first bucket of the current level. The loop will add `timer` to it next.
+      Bucket first_bucket = buckets.front();
+      levels_.push_back({first_bucket});
+    }
+    index /= kFanout;
+  }
+}
+
+std::vector<const TimerInfo*> TimerLodPyramid::GetTimersDiscretized(uint32_t resolution,
+                                                                    uint64_t start_ns,
+                                                                    uint64_t end_ns) const {
+  Query query{resolution, start_ns, end_ns, start_ns, {}};
+  if (!levels_.empty() && start_ns < end_ns) {
+    CollectFromBucket(levels_.size() - 1, 0, query);
+  }
+  return std::move(query.timers);
+}
+
+void TimerLodPyramid::UpdateBucket(Bucket& bucket, const TimerInfo& timer) {
+  bucket.min_start_ns = std::min(bucket.min_start_ns, timer.start());
+  bucket.max_end_ns = std::max(bucket.max_end_ns, timer.end());
+  auto duration_ns = [](const TimerInfo& timer_info) {
+    return timer_info.end() - timer_info.start();
+  };
+  if (bucket.longest_timer == nullptr || duration_ns(timer) > duration_ns(*bucket.longest_timer)) {
+    bucket.longest_timer = &timer;
+  }
+}
+
+void TimerLodPyramid::CollectFromBucket(size_t level, size_t index, Query& query) const {
+  if (query.next_pixel_start_ns >= query.end_ns) return;
+
+  const Bucket& bucket = levels_[level][index];
+  // Nothing visible that isn't already covered by a previous timer. We don't stop at the first
+  // bucket starting after the interval, as timers are not guaranteed to be sorted.
+  if (bucket.max_end_ns < query.next_pixel_start_ns || bucket.min_start_ns >= query.end_ns) return;
+
+  // All the timers of the bucket fall into the same pixel, which isn't occupied yet: the longest
+  // timer represents all of them.
+  if (bucket.min_start_ns >= query.next_pixel_start_ns && bucket.max_end_ns < query.end_ns &&
+      GetPixelNumber(bucket.min_start_ns, query.resolution, query.start_ns, query.end_ns) ==
+          GetPixelNumber(bucket.max_end_ns, query.resolution, query.start_ns, query.end_ns)) {
+    query.timers.push_back(bucket.longest_timer);
+    query.next_pixel_start_ns = GetNextPixelBoundaryTimeNs(bucket.max_end_ns, query.resolution,
+                                                           query.start_ns, query.end_ns);
+    return;
+  }
+
+  if (level == 0) {
+    CollectFromBlock(*blocks_[index], query);
+    return;
+  }
+
+  const size_t first_child = index * kFanout;
+  const size_t last_child = std::min(first_child + kFanout, levels_[level - 1].size());
+  for (size_t child = first_child; child < last_child; ++child) {
+    CollectFromBucket(level - 1, child, query);
+  }
+}
+
+void TimerLodPyramid::CollectFromBlock(const TimerBlock& block, Query& query) {
+  // Several candidate timers might be in the same block.
+  while (query.next_pixel_start_ns < query.end_ns &&
+         block.Intersects(query.next_pixel_start_ns, query.end_ns)) {
+    // First timer for which the end timestamp isn't smaller than the start of the next pixel.
+    const TimerInfo* timer = block.LowerBound(query.next_pixel_start_ns);
+    if (timer == nullptr || timer->start() >= query.end_ns) break;
+    query.timers.push_back(timer);
+
+    // Use the time of next pixel boundary as a threshold to avoid returning several timers for the
+    // same pixel that will overlap after.
+    query.next_pixel_start_ns = GetNextPixelBoundaryTimeNs(timer->end(), query.resolution,
+                                                           query.start_ns, query.end_ns);
+  }
+}
+
+}  // namespace orbit_client_data
@@ -0,0 +1,138 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ClientData/FastRenderingUtils.h"
+#include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
+#include "ClientData/TimerLodPyramid.h"
+
+namespace orbit_client_data {
+
+namespace {
+
+class TimerLodPyramidTest : public testing::Test {
+ protected:
+  void AddTimer(uint64_t start_ns, uint64_t end_ns) {
+    TimerInfo timer_info;
+    timer_info.set_start(start_ns);
+    timer_info.set_end(end_ns);
+    const TimerInfo& added_timer_info = chain_.emplace_back(timer_info);
+    pyramid_.Add(chain_.GetLastBlock(), added_timer_info);
+  }
+
+  // Pixels in [start_ns, end_ns) covered by at least one of `timers`.
+  [[nodiscard]] static std::set<uint64_t> GetOccupiedPixels(
+      const std::vector<const TimerInfo*>& timers, uint32_t resolution, uint64_t start_ns,
+      uint64_t end_ns) {
+    std::set<uint64_t> pixels;
+    for (const TimerInfo* timer : timers) {
+      if (timer->end() < start_ns || timer->start() >= end_ns) continue;
+      const uint64_t first_pixel =
+          GetPixelNumber(std::max(timer->start(), start_ns), resolution, start_ns, end_ns);
+      const uint64_t last_pixel =
+          GetPixelNumber(std::min(timer->end(), end_ns - 1), resolution, start_ns, end_ns);
+      for (uint64_t pixel = first_pixel; pixel <= last_pixel; ++pixel) pixels.insert(pixel);
+    }
+    return pixels;
+  }
+
+  [[nodiscard]] std::vector<const TimerInfo*> GetAllTimers() const {
+    std::vector<const TimerInfo*> timers;
+    for (const TimerBlock& block : chain_) {
+      for (size_t i = 0; i < block.size(); ++i) timers.push_back(&block[i]);
+    }
+    return timers;
+  }
+
+  TimerChain chain_;
+  TimerLodPyramid pyramid_;
+};
+
+constexpr size_t kTimersPerBlock = 1024;
+
+}  // namespace
+
+TEST_F(TimerLodPyramidTest, Empty) {
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 0);
+  EXPECT_TRUE(pyramid_.GetTimersDiscretized(100, 0, 1000).empty());
+}
+
+TEST_F(TimerLodPyramidTest, LevelsGrowWithTheNumberOfBlocks) {
+  AddTimer(0, 1);
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 1);
+
+  uint64_t timestamp_ns = 2;
+  auto add_timers = [&](size_t count) {
+    for (size_t i = 0; i < count; ++i, timestamp_ns += 2) AddTimer(timestamp_ns, timestamp_ns + 1);
+  };
+
+  add_timers(kTimersPerBlock - 1);
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 1);
+
+  add_timers(1);
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 2);
+
+  // Fill the first kFanout blocks, which are all summarized by the only bucket of level 1.
+  add_timers((TimerLodPyramid::kFanout - 1) * kTimersPerBlock - 1);
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 2);
+
+  add_timers(1);
+  EXPECT_EQ(pyramid_.GetNumberOfLevels(), 3);
+
+  // All timers are still found when zoomed in enough.
+  const std::vector<const TimerInfo*> timers =
+      pyramid_.GetTimersDiscretized(static_cast<uint32_t>(timestamp_ns), 0, timestamp_ns);
+  EXPECT_EQ(timers.size(), chain_.size());
+}
+
+TEST_F(TimerLodPyramidTest, LongestTimerRepresentsASinglePixel) {
+  for (uint64_t i = 0; i < 3 * kTimersPerBlock; ++i) AddTimer(10 * i, 10 * i + 1);
+  AddTimer(30 * kTimersPerBlock, 30 * kTimersPerBlock + 5);
+  for (uint64_t i = 0; i < kTimersPerBlock; ++i) {
+    AddTimer(30 * kTimersPerBlock + 10 + i, 30 * kTimersPerBlock + 11 + i);
+  }
+
+  const std::vector<const TimerInfo*> timers = pyramid_.GetTimersDiscretized(1, 0, 1'000'000);
+  ASSERT_EQ(timers.size(), 1);
+  EXPECT_EQ(timers[0]->end() - timers[0]->start(), 5);
+}
+
+TEST_F(TimerLodPyramidTest, OccupiesTheSamePixelsAsAllTimers) {
+  std::mt19937 random_engine{42};
+  std::uniform_int_distribution<uint64_t> gap_distribution{0, 2'000};
+  std::uniform_int_distribution<uint64_t> duration_distribution{0, 5'000};
+  uint64_t timestamp_ns = 0;
+  for (size_t i = 0; i < 40 * kTimersPerBlock; ++i) {
+    timestamp_ns += gap_distribution(random_engine);
+    const uint64_t end_ns = timestamp_ns + duration_distribution(random_engine);
+    AddTimer(timestamp_ns, end_ns);
+    timestamp_ns = end_ns;
+  }
+
+  const std::vector<const TimerInfo*> all_timers = GetAllTimers();
+  const std::vector<std::pair<uint64_t, uint64_t>> time_ranges{
+      {0, timestamp_ns + 1},
+      {timestamp_ns / 3, timestamp_ns / 2},
+      {timestamp_ns / 2, timestamp_ns / 2 + 100'000}};
+  for (uint32_t resolution : {1u, 100u, 4000u}) {
+    for (const auto& [start_ns, end_ns] : time_ranges) {
+      const std::vector<const TimerInfo*> timers =
+          pyramid_.GetTimersDiscretized(resolution, start_ns, end_ns);
+      EXPECT_LE(timers.size(), resolution);
+      EXPECT_EQ(GetOccupiedPixels(timers, resolution, start_ns, end_ns),
+                GetOccupiedPixels(all_timers, resolution, start_ns, end_ns));
+    }
+  }
+}
+
+}  // namespace orbit_client_data
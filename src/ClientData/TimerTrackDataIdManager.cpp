@@ -7,11 +7,9 @@
 #include <absl/hash/hash.h>
 #include <absl/meta/type_traits.h>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
-using orbit_client_protos::TimerInfo;
-
 namespace orbit_client_data {
 
 TimerTrackDataIdManager::TimerTrackDataIdManager() : scheduler_track_id_(next_track_id_++) {
@@ -34,9 +32,6 @@ uint32_t TimerTrackDataIdManager::GenerateTrackIdFromTimerInfo(const TimerInfo&
       return GenerateGpuTrackId(timer_info.timeline_hash());
     case TimerInfo::kApiScopeAsync:
       return GenerateAsyncTrackId(timer_info.api_scope_name());
-    case orbit_client_protos::TimerInfo_Type_TimerInfo_Type_INT_MIN_SENTINEL_DO_NOT_USE_:
-    case orbit_client_protos::TimerInfo_Type_TimerInfo_Type_INT_MAX_SENTINEL_DO_NOT_USE_:
-      ORBIT_UNREACHABLE();
   }
   return -1;
 }
@@ -8,8 +8,8 @@
 #include <set>
 #include <string>
 
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 
 namespace orbit_client_data {
 
@@ -5,11 +5,11 @@
 #ifndef CLIENT_DATA_CALLSTACK_DATA_H_
 #define CLIENT_DATA_CALLSTACK_DATA_H_
 
-#include <absl/container/btree_map.h>
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
 #include <stdint.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <limits>
@@ -23,8 +23,8 @@
 
 #include "CallstackType.h"
 #include "ClientData/CallstackEvent.h"
+#include "ClientData/CallstackEventColumns.h"
 #include "ClientData/CallstackInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "FastRenderingUtils.h"
 #include "ModuleManager.h"
 #include "OrbitBase/Logging.h"
@@ -62,10 +62,8 @@ class CallstackData {
   template <typename Action>
   void ForEachCallstackEvent(Action&& action) const {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
-    for (const auto& [unused_tid, events] : callstack_events_by_tid_) {
-      for (const auto& [unused_timestamp, event] : events) {
-        std::invoke(action, event);
-      }
+    for (const auto& [tid, events] : callstack_events_by_tid_) {
+      ForEachCallstackEventInIndexRange(tid, events, 0, events.size(), action);
     }
   }
 
@@ -74,11 +72,9 @@ class CallstackData {
                                         Action&& action) const {
     std::lock_guard<std::recursive_mutex> lock(mutex_);
     ORBIT_CHECK(min_timestamp <= max_timestamp);
-    for (const auto& [unused_tid, events] : callstack_events_by_tid_) {
-      for (auto event_it = events.lower_bound(min_timestamp);
-           event_it != events.upper_bound(max_timestamp); ++event_it) {
-        std::invoke(action, event_it->second);
-      }
+    for (const auto& [tid, events] : callstack_events_by_tid_) {
+      ForEachCallstackEventInIndexRange(tid, events, events.LowerBound(min_timestamp),
+                                        events.UpperBound(max_timestamp), action);
     }
   }
 
@@ -89,25 +85,28 @@ class CallstackData {
   template <typename Action>
   void ForEachCallstackEventInTimeRangeDiscretized(uint64_t min_timestamp, uint64_t max_timestamp,
                                                    uint32_t resolution, Action&& action) const {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     auto get_next_callstack = [&](uint64_t timestamp) -> std::optional<CallstackEvent> {
       std::optional<CallstackEvent> next_callstack;
       const uint32_t current_pixel =
           GetPixelNumber(timestamp, resolution, min_timestamp, max_timestamp);
-      for (const auto& [unused_tid, events] : callstack_events_by_tid_) {
-        auto next_callstack_of_tid = events.lower_bound(timestamp);
-        if (next_callstack_of_tid == events.end() ||
+      for (const auto& [tid, events] : callstack_events_by_tid_) {
+        const size_t next_index_of_tid = events.LowerBound(timestamp);
+        if (next_index_of_tid == events.size() ||
             (next_callstack.has_value() &&
-             next_callstack.value().timestamp_ns() <= next_callstack_of_tid->second.timestamp_ns()))
+             next_callstack.value().timestamp_ns() <= events.timestamp_ns(next_index_of_tid)))
           continue;
 
+        const CallstackEvent next_callstack_of_tid{events.timestamp_ns(next_index_of_tid),
+                                                   events.callstack_id(next_index_of_tid), tid};
         // If this callstack will be drawn in the current_pixel, we don't need to search for more of
         // them. Otherwise there could be a callstack in another thread_id that will be draw before,
         // so we need to keep looking.
-        if (GetPixelNumber(next_callstack_of_tid->first, resolution, min_timestamp,
+        if (GetPixelNumber(next_callstack_of_tid.timestamp_ns(), resolution, min_timestamp,
                            max_timestamp) == current_pixel) {
-          return next_callstack_of_tid->second;
+          return next_callstack_of_tid;
         }
-        next_callstack = next_callstack_of_tid->second;
+        next_callstack = next_callstack_of_tid;
       }
       return next_callstack;
     };
@@ -129,11 +128,9 @@ class CallstackData {
     if (tid_and_events_it == callstack_events_by_tid_.end()) {
       return;
     }
-    const auto& events = tid_and_events_it->second;
-    for (auto event_it = events.lower_bound(min_timestamp);
-         event_it != events.upper_bound(max_timestamp); ++event_it) {
-      std::invoke(action, event_it->second);
-    }
+    const CallstackEventColumns& events = tid_and_events_it->second;
+    ForEachCallstackEventInIndexRange(tid, events, events.LowerBound(min_timestamp),
+                                      events.UpperBound(max_timestamp), action);
   }
 
   // Do a particular action for all callstacks in a thread but skipping callstacks that will be
@@ -149,12 +146,13 @@ class CallstackData {
     if (tid_and_events_it == callstack_events_by_tid_.end()) {
       return;
     }
-    const auto& events = tid_and_events_it->second;
-    for (auto event_it = events.lower_bound(min_timestamp);
-         event_it != events.end() && event_it->first < max_timestamp;
-         event_it = events.lower_bound(GetNextPixelBoundaryTimeNs(event_it->first, resolution,
-                                                                  min_timestamp, max_timestamp))) {
-      std::invoke(action, event_it->second);
+    const CallstackEventColumns& events = tid_and_events_it->second;
+    for (size_t index = events.LowerBound(min_timestamp);
+         index < events.size() && events.timestamp_ns(index) < max_timestamp;
+         index = events.LowerBound(GetNextPixelBoundaryTimeNs(
+             events.timestamp_ns(index), resolution, min_timestamp, max_timestamp))) {
+      std::invoke(action,
+                  CallstackEvent{events.timestamp_ns(index), events.callstack_id(index), tid});
     }
   }
 
@@ -191,13 +189,26 @@ class CallstackData {
  private:
   [[nodiscard]] std::shared_ptr<CallstackInfo> GetCallstackPtr(uint64_t callstack_id) const;
 
+  // Calls `action` on the events of `events` with index in [begin_index, end_index), sweeping
+  // through the columns in order.
+  template <typename Action>
+  static void ForEachCallstackEventInIndexRange(uint32_t tid, const CallstackEventColumns& events,
+                                                size_t begin_index, size_t end_index,
+                                                Action&& action) {
+    const std::vector<uint64_t>& timestamps_ns = events.timestamps_ns();
+    const std::vector<uint64_t>& callstack_ids = events.callstack_ids();
+    for (size_t index = begin_index; index < end_index; ++index) {
+      std::invoke(action, CallstackEvent{timestamps_ns[index], callstack_ids[index], tid});
+    }
+  }
+
   void RegisterTime(uint64_t time);
 
   // Use a reentrant mutex so that calls to the ForEach... methods can be nested.
   // E.g., one might want to nest ForEachCallstackEvent and ForEachFrameInCallstack.
   mutable std::recursive_mutex mutex_;
   absl::flat_hash_map<uint64_t, std::shared_ptr<CallstackInfo>> unique_callstacks_;
-  absl::flat_hash_map<uint32_t, absl::btree_map<uint64_t, CallstackEvent>> callstack_events_by_tid_;
+  absl::flat_hash_map<uint32_t, CallstackEventColumns> callstack_events_by_tid_;
 
   uint64_t max_time_ = 0;
   uint64_t min_time_ = std::numeric_limits<uint64_t>::max();
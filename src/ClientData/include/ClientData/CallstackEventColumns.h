@@ -0,0 +1,55 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_CALLSTACK_EVENT_COLUMNS_H_
+#define CLIENT_DATA_CALLSTACK_EVENT_COLUMNS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_client_data {
+
+// The callstack events of a single thread, sorted by timestamp, with at most one event per
+// timestamp. Timestamps and callstack ids are stored in two separate arrays, which takes 16 bytes
+// per event (instead of the node and per-entry overhead of a tree), turns time range queries into a
+// binary search and lets scans sweep sequentially through memory.
+//
+// Events are appended in constant time when they arrive in timestamp order, which is the common
+// case. Out-of-order events are inserted at their position in linear time. Not thread-safe.
+class CallstackEventColumns {
+ public:
+  // Returns false, and doesn't add the event, if there already is an event at `timestamp_ns`.
+  bool Insert(uint64_t timestamp_ns, uint64_t callstack_id);
+
+  [[nodiscard]] size_t size() const { return timestamps_ns_.size(); }
+  [[nodiscard]] bool empty() const { return timestamps_ns_.empty(); }
+
+  [[nodiscard]] uint64_t timestamp_ns(size_t index) const {
+    ORBIT_CHECK(index < timestamps_ns_.size());
+    return timestamps_ns_[index];
+  }
+  [[nodiscard]] uint64_t callstack_id(size_t index) const {
+    ORBIT_CHECK(index < callstack_ids_.size());
+    return callstack_ids_[index];
+  }
+
+  [[nodiscard]] const std::vector<uint64_t>& timestamps_ns() const { return timestamps_ns_; }
+  [[nodiscard]] const std::vector<uint64_t>& callstack_ids() const { return callstack_ids_; }
+
+  // Index of the first event with a timestamp not less than (LowerBound), or greater than
+  // (UpperBound), `timestamp_ns`. Returns size() if there is none.
+  [[nodiscard]] size_t LowerBound(uint64_t timestamp_ns) const;
+  [[nodiscard]] size_t UpperBound(uint64_t timestamp_ns) const;
+
+ private:
+  std::vector<uint64_t> timestamps_ns_;
+  std::vector<uint64_t> callstack_ids_;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_CALLSTACK_EVENT_COLUMNS_H_
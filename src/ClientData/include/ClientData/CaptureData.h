@@ -28,6 +28,7 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/CallstackEvent.h"
 #include "ClientData/CallstackInfo.h"
+#include "ClientData/FunctionAddressCache.h"
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/LinuxAddressInfo.h"
 #include "ClientData/ModuleIdentifierProvider.h"
@@ -39,16 +40,17 @@
 #include "ClientData/ScopeInfo.h"
 #include "ClientData/ScopeStats.h"
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/ScopeStatsIndex.h"
 #include "ClientData/ThreadStateSliceInfo.h"
 #include "ClientData/ThreadTrackDataProvider.h"
 #include "ClientData/TimerData.h"
 #include "ClientData/TimerDataManager.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
 #include "ClientData/TimestampIntervalSet.h"
 #include "ClientData/TracepointData.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/process.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
@@ -64,6 +66,7 @@ class CaptureData {
                        absl::flat_hash_set<uint64_t> frame_track_function_ids,
                        DataSource data_source,
                        const ModuleIdentifierProvider* module_identifier_provider);
+  ~CaptureData();
 
   // We cannot copy the unique_ptr, so we cannot copy this object.
   CaptureData(const CaptureData& other) = delete;
@@ -250,8 +253,7 @@ class CaptureData {
     return thread_track_data_provider_.get();
   }
 
-  [[nodiscard]] std::optional<ScopeId> ProvideScopeId(
-      const orbit_client_protos::TimerInfo& timer_info) const;
+  [[nodiscard]] std::optional<ScopeId> ProvideScopeId(const TimerInfo& timer_info) const;
   [[nodiscard]] std::vector<ScopeId> GetAllProvidedScopeIds() const;
   [[nodiscard]] ScopeId GetMaxId() const { return scope_id_provider_->GetMaxId(); }
   [[nodiscard]] const ScopeInfo& GetScopeInfo(ScopeId scope_id) const;
@@ -283,11 +285,47 @@ class CaptureData {
   [[nodiscard]] std::optional<ThreadStateSliceInfo> FindThreadStateSliceInfoFromTimestamp(
       int64_t thread_id, uint64_t timestamp) const;
 
+  // Uses a ScopeStatsIndex per thread, built on first use and extended with the timers that the
+  // thread got since, so that changing the time range only costs logarithmic time per scope.
   [[nodiscard]] std::unique_ptr<const ScopeStatsCollection> CreateScopeStatsCollection(
       uint32_t thread_id, uint64_t min_tick, uint64_t max_tick) const;
   [[nodiscard]] std::shared_ptr<const ScopeStatsCollection> GetAllScopeStatsCollection() const;
 
+  // Memoizes the function addresses of the sampled addresses across post-processing runs. Has to
+  // be cleared when symbols are loaded.
+  [[nodiscard]] FunctionAddressCache& GetFunctionAddressCache() const {
+    return function_address_cache_;
+  }
+
  private:
+  struct ScopeStatsIndexEntry {
+    // The number of timers the index was built from, and the maximum end timestamp among them, also
+    // counting the timers that the index filters out. Timers are expected to be added in order of
+    // end timestamp, so the ones that end later are those to add to the index.
+    size_t num_timers = 0;
+    uint64_t max_end_ns = 0;
+    std::shared_ptr<ScopeStatsIndex> index;
+  };
+
+  // An index, and the maximum end timestamp of its timers when it was returned. Queries whose
+  // max_tick is clamped to max_end_ns give the same results after timers were added to the index.
+  struct ScopeStatsIndexSnapshot {
+    std::shared_ptr<const ScopeStatsIndex> index;
+    uint64_t max_end_ns;
+  };
+
+  [[nodiscard]] ScopeStatsIndexSnapshot GetOrCreateThreadScopeStatsIndex(uint32_t thread_id) const;
+  [[nodiscard]] ScopeStatsIndexSnapshot GetOrCreateAsyncScopeStatsIndex() const;
+  // Brings `entry` up to date, given that its source has at least `num_timers` timers and that
+  // `get_timers(min_tick)` returns those of them that end at or after min_tick. `is_indexed`
+  // selects the timers to add to the index.
+  template <typename GetTimersT, typename IsIndexedT>
+  [[nodiscard]] ScopeStatsIndexSnapshot UpdateScopeStatsIndex(ScopeStatsIndexEntry* entry,
+                                                              size_t num_timers,
+                                                              GetTimersT&& get_timers,
+                                                              IsIndexedT&& is_indexed) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(scope_stats_indices_mutex_);
+
   orbit_grpc_protos::CaptureStarted capture_started_;
 
   orbit_client_data::ProcessData process_;
@@ -306,6 +344,7 @@ class CaptureData {
   TracepointData tracepoint_data_;
 
   absl::flat_hash_map<uint64_t, LinuxAddressInfo> address_infos_;
+  mutable FunctionAddressCache function_address_cache_;
 
   absl::flat_hash_map<uint32_t, std::string> thread_names_;
 
@@ -329,6 +368,11 @@ class CaptureData {
   std::unique_ptr<ThreadTrackDataProvider> thread_track_data_provider_;
 
   std::shared_ptr<ScopeStatsCollection> all_scopes_;
+
+  mutable absl::Mutex scope_stats_indices_mutex_;
+  mutable absl::flat_hash_map<uint32_t, ScopeStatsIndexEntry> thread_scope_stats_indices_
+      ABSL_GUARDED_BY(scope_stats_indices_mutex_);
+  mutable ScopeStatsIndexEntry async_scope_stats_index_ ABSL_GUARDED_BY(scope_stats_indices_mutex_);
 };
 
 }  // namespace orbit_client_data
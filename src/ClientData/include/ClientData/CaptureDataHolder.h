@@ -10,6 +10,7 @@
 #include <optional>
 
 #include "ClientData/CaptureData.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
 namespace orbit_client_data {
@@ -43,8 +44,7 @@ class CaptureDataHolder {
     return capture_data_.get();
   }
 
-  [[nodiscard]] std::optional<ScopeId> ProvideScopeId(
-      const orbit_client_protos::TimerInfo& timer_info) const {
+  [[nodiscard]] std::optional<ScopeId> ProvideScopeId(const TimerInfo& timer_info) const {
     if (capture_data_ == nullptr) return std::nullopt;
     return capture_data_->ProvideScopeId(timer_info);
   }
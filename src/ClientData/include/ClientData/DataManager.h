@@ -19,10 +19,10 @@
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointCustom.h"
 #include "ClientData/UserDefinedCaptureData.h"
 #include "ClientData/WineSyscallHandlingMethod.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
 #include "OrbitBase/Logging.h"
@@ -34,7 +34,7 @@ namespace orbit_client_data {
 // it is fully enclosed in it.
 struct TimeRange {
   TimeRange(uint64_t start, uint64_t end) : start(start), end(end) { ORBIT_CHECK(start <= end); }
-  [[nodiscard]] bool IsTimerInRange(const orbit_client_protos::TimerInfo& timer) const {
+  [[nodiscard]] bool IsTimerInRange(const TimerInfo& timer) const {
     return start <= timer.start() && timer.end() <= end;
   }
   uint64_t start;
@@ -59,7 +59,7 @@ class DataManager final {
       std::optional<ThreadStateSliceInfo> selected_thread_state_slice);
   void set_hovered_thread_state_slice(
       std::optional<ThreadStateSliceInfo> hovered_thread_state_slice);
-  void set_selected_timer(const orbit_client_protos::TimerInfo* timer_info);
+  void set_selected_timer(const TimerInfo* timer_info);
 
   [[nodiscard]] bool IsFunctionSelected(const FunctionInfo& function) const;
   [[nodiscard]] std::vector<FunctionInfo> GetSelectedFunctions() const;
@@ -69,7 +69,7 @@ class DataManager final {
   [[nodiscard]] uint32_t selected_thread_id() const;
   [[nodiscard]] std::optional<ThreadStateSliceInfo> selected_thread_state_slice() const;
   [[nodiscard]] std::optional<ThreadStateSliceInfo> hovered_thread_state_slice() const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* selected_timer() const;
+  [[nodiscard]] const TimerInfo* selected_timer() const;
 
   void SelectTracepoint(const orbit_grpc_protos::TracepointInfo& info);
   void DeselectTracepoint(const orbit_grpc_protos::TracepointInfo& info);
@@ -155,7 +155,7 @@ class DataManager final {
   TracepointInfoSet selected_tracepoints_;
 
   uint32_t selected_thread_id_ = orbit_base::kInvalidThreadId;
-  const orbit_client_protos::TimerInfo* selected_timer_ = nullptr;
+  const TimerInfo* selected_timer_ = nullptr;
   std::optional<orbit_client_data::ThreadStateSliceInfo> selected_thread_state_slice_;
   std::optional<orbit_client_data::ThreadStateSliceInfo> hovered_thread_state_slice_;
 
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_FUNCTION_ADDRESS_CACHE_H_
+#define CLIENT_DATA_FUNCTION_ADDRESS_CACHE_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
+#include <absl/types/span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+namespace orbit_client_data {
+
+// Memoizes the mapping from the absolute address of an instruction to the absolute address of the
+// function containing it, so that the sampling data post-processing only resolves each address once
+// across runs, e.g., across selections. Addresses whose function is not known are not inserted, as
+// they can become known as modules and address infos are added. The mapping depends on the symbols
+// that are loaded, so the cache has to be cleared when symbols change. Thread-safe.
+// Post-processing can run concurrently with Clear(): a run that resolved its addresses with the
+// symbols from before Clear() must not insert them afterwards. So Clear() starts a new generation,
+// a run records the generation before resolving any address, and Insert drops mappings that were
+// resolved in an earlier generation.
+class FunctionAddressCache {
+ public:
+  [[nodiscard]] std::optional<uint64_t> Find(uint64_t absolute_address) const;
+
+  [[nodiscard]] uint64_t GetGeneration() const;
+
+  // Does nothing if `generation` is not the current generation, i.e., if Clear() was called since
+  // `generation` was obtained from GetGeneration().
+  void Insert(uint64_t generation,
+              absl::Span<const std::pair<uint64_t, uint64_t>> absolute_and_function_addresses);
+
+  void Clear();
+
+  [[nodiscard]] size_t size() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  uint64_t generation_ ABSL_GUARDED_BY(mutex_) = 0;
+  absl::flat_hash_map<uint64_t, uint64_t> absolute_address_to_function_address_
+      ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_FUNCTION_ADDRESS_CACHE_H_
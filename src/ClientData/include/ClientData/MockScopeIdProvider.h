@@ -10,6 +10,7 @@
 #include <stdint.h>
 
 #include "ClientData/ScopeIdProvider.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_client_data {
@@ -8,7 +8,10 @@
 #include <gmock/gmock.h>
 #include <stdint.h>
 
+#include <optional>
+
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_client_data {
@@ -19,6 +22,8 @@ class MockScopeStatsCollection : public ScopeStatsCollectionInterface {
   MOCK_METHOD(const ScopeStats&, GetScopeStatsOrDefault, (ScopeId), (const, override));
   MOCK_METHOD(const std::vector<uint64_t>*, GetSortedTimerDurationsForScopeId, (ScopeId),
               (const, override));
+  MOCK_METHOD(std::optional<uint64_t>, GetDurationQuantileNs, (ScopeId, double),
+              (const, override));
 
   MOCK_METHOD(void, UpdateScopeStats, (ScopeId, const TimerInfo& timer), (override));
   MOCK_METHOD(void, SetScopeStats, (ScopeId, ScopeStats), (override));
@@ -23,7 +23,6 @@
 #include "ClientData/ModuleIdentifierProvider.h"
 #include "ClientData/ModuleInMemory.h"
 #include "ClientData/ModulePathAndBuildId.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "OrbitBase/Logging.h"
 #include "absl/container/node_hash_map.h"
@@ -19,6 +19,8 @@ class ScopeStats {
   explicit ScopeStats() = default;
 
   void UpdateStats(uint64_t elapsed_nanos);
+  // Combines the stats of two disjoint sets of occurrences of the same scope.
+  void MergeStats(const ScopeStats& other);
 
   [[nodiscard]] uint64_t ComputeAverageTimeNs() const;
 
@@ -6,18 +6,24 @@
 #ifndef CLIENT_DATA_SCOPE_STATS_COLLECTION_H_
 #define CLIENT_DATA_SCOPE_STATS_COLLECTION_H_
 
+#include <absl/base/thread_annotations.h>
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
+#include <absl/synchronization/mutex.h>
 #include <absl/types/span.h>
 
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeIdProvider.h"
 #include "ClientData/ScopeStats.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "Statistics/QuantileSketch.h"
 
 namespace orbit_client_data {
 
@@ -31,6 +37,10 @@ class ScopeStatsCollectionInterface {
   [[nodiscard]] virtual const ScopeStats& GetScopeStatsOrDefault(ScopeId scope_id) const = 0;
   [[nodiscard]] virtual const std::vector<uint64_t>* GetSortedTimerDurationsForScopeId(
       ScopeId scope_id) const = 0;
+  // Returns the `quantile`-quantile, with `quantile` in [0, 1], of the durations of the timers of
+  // `scope_id`, or std::nullopt if it's not known, e.g., as there are no such timers.
+  [[nodiscard]] virtual std::optional<uint64_t> GetDurationQuantileNs(ScopeId scope_id,
+                                                                      double quantile) const = 0;
 
   // Calling this function causes the timer durations to no longer be sorted. OnCaptureComplete()
   // *must* be called after UpdateScopeStats and before GetSortedTimerDurationsForScopeId().
@@ -46,19 +56,53 @@ class ScopeStatsCollection : public ScopeStatsCollectionInterface {
   explicit ScopeStatsCollection(ScopeIdProvider& scope_id_provider,
                                 absl::Span<const TimerInfo* const> timers);
 
+  // Creates the collection from already computed stats, e.g., from ScopeStatsIndex. The sorted
+  // timer durations of a scope are only computed, by `sorted_timer_durations_provider`, the first
+  // time they are requested. Likewise, the QuantileSketch of the durations of a scope is only
+  // computed, by `duration_sketch_provider`, the first time a quantile of the scope is requested,
+  // e.g., for the visible rows of a table.
+  using SortedTimerDurationsProvider = std::function<std::vector<uint64_t>(ScopeId)>;
+  using DurationSketchProvider = std::function<orbit_statistics::QuantileSketch(ScopeId)>;
+  explicit ScopeStatsCollection(absl::flat_hash_map<ScopeId, ScopeStats> scope_stats,
+                                SortedTimerDurationsProvider sorted_timer_durations_provider,
+                                DurationSketchProvider duration_sketch_provider);
+  // Creates an empty collection to be filled with UpdateScopeStats that doesn't keep the duration
+  // of each timer, e.g., as the timers are stored anyway. The sorted durations of a scope are
+  // computed by `sorted_timer_durations_provider` when requested after OnCaptureComplete, and
+  // quantiles are estimated from a QuantileSketch per scope, which is also available during a
+  // live capture.
+  explicit ScopeStatsCollection(SortedTimerDurationsProvider sorted_timer_durations_provider);
+
   [[nodiscard]] std::vector<ScopeId> GetAllProvidedScopeIds() const override;
   [[nodiscard]] const ScopeStats& GetScopeStatsOrDefault(ScopeId scope_id) const override;
   [[nodiscard]] const std::vector<uint64_t>* GetSortedTimerDurationsForScopeId(
       ScopeId scope_id) const override;
+  [[nodiscard]] std::optional<uint64_t> GetDurationQuantileNs(ScopeId scope_id,
+                                                              double quantile) const override;
 
   void UpdateScopeStats(ScopeId scope_id, const TimerInfo& timer) override;
   void SetScopeStats(ScopeId scope_id, ScopeStats stats) override;
   void OnCaptureComplete() override;
 
+  // The providers are no longer called after this, e.g., as the data they refer to is about to be
+  // destroyed. The durations and sketches that were already computed stay available.
+  void DetachProviders();
+
  private:
   absl::flat_hash_map<ScopeId, ScopeStats> scope_stats_;
   absl::flat_hash_map<ScopeId, std::vector<uint64_t>> scope_id_to_timer_durations_;
   bool timer_durations_are_sorted_ = true;
+  absl::flat_hash_map<ScopeId, orbit_statistics::QuantileSketch> scope_id_to_duration_sketch_;
+
+  SortedTimerDurationsProvider sorted_timer_durations_provider_;
+  DurationSketchProvider duration_sketch_provider_;
+  // The vectors are owned through pointers as GetSortedTimerDurationsForScopeId returns them.
+  mutable absl::flat_hash_map<ScopeId, std::unique_ptr<std::vector<uint64_t>>>
+      lazy_scope_id_to_timer_durations_ ABSL_GUARDED_BY(lazy_timer_durations_mutex_);
+  mutable absl::flat_hash_map<ScopeId, orbit_statistics::QuantileSketch>
+      lazy_scope_id_to_duration_sketch_ ABSL_GUARDED_BY(lazy_timer_durations_mutex_);
+  bool providers_are_detached_ ABSL_GUARDED_BY(lazy_timer_durations_mutex_) = false;
+  mutable absl::Mutex lazy_timer_durations_mutex_;
 };
 
 }  // namespace orbit_client_data
@@ -0,0 +1,113 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_SCOPE_STATS_INDEX_H_
+#define CLIENT_DATA_SCOPE_STATS_INDEX_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
+#include <absl/types/span.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ClientData/ScopeId.h"
+#include "ClientData/ScopeIdProvider.h"
+#include "ClientData/ScopeStats.h"
+#include "ClientData/TimerInfo.h"
+#include "Statistics/QuantileSketch.h"
+
+namespace orbit_client_data {
+
+// Index over a set of timers (e.g., those of a thread) that computes the ScopeStats of each scope
+// for any time range without going through all the timers in the range.
+//
+// For each scope, the timers are sorted by start timestamp and grouped in blocks of kBlockSize
+// timers. A segment tree over the blocks stores count, sum, sum of squares, min and max of the
+// durations, and the maximum end timestamp. A query only visits O(log(number of blocks)) nodes,
+// the (at most two) partial blocks at the borders of the range, and the blocks of timers that start
+// in the range but end after it, which are rare as timers of the same scope can only overlap in
+// case of recursion.
+//
+// Timers can be added after construction, e.g., during a live capture. Only the blocks from the
+// first one whose timers change are recomputed, together with their ancestors in the tree. As new
+// timers of a scope usually start after the ones already in the index, these are the last block and
+// the new ones. The methods can be called concurrently.
+class ScopeStatsIndex {
+ public:
+  explicit ScopeStatsIndex(ScopeIdProvider& scope_id_provider,
+                           absl::Span<const TimerInfo* const> timers);
+
+  void AddTimers(ScopeIdProvider& scope_id_provider, absl::Span<const TimerInfo* const> timers);
+
+  [[nodiscard]] std::vector<ScopeId> GetAllProvidedScopeIds() const;
+
+  // Stats of the timers of `scope_id` that are entirely inside [min_tick, max_tick], the same
+  // timers that `exclusive` queries of TimerData return.
+  [[nodiscard]] ScopeStats ComputeScopeStats(ScopeId scope_id, uint64_t min_tick,
+                                             uint64_t max_tick) const;
+
+  // Sorted durations of the same timers as ComputeScopeStats. This is linear in the number of
+  // timers in the range and is meant to be called for a few scopes only, e.g., for a histogram.
+  [[nodiscard]] std::vector<uint64_t> ComputeSortedTimerDurations(ScopeId scope_id,
+                                                                  uint64_t min_tick,
+                                                                  uint64_t max_tick) const;
+
+  // Sketch of the durations of the same timers as ComputeScopeStats, to estimate their quantiles.
+  // This is also linear in the number of timers in the range, but doesn't sort nor copy them.
+  [[nodiscard]] orbit_statistics::QuantileSketch ComputeDurationSketch(ScopeId scope_id,
+                                                                       uint64_t min_tick,
+                                                                       uint64_t max_tick) const;
+
+  static constexpr size_t kBlockSize = 64;
+
+ private:
+  struct Aggregate {
+    uint64_t count = 0;
+    uint64_t total_time_ns = 0;
+    double sum_of_squares_ns = 0.0;
+    uint64_t min_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t max_ns = 0;
+    uint64_t max_end_ns = 0;
+
+    void Add(uint64_t start_ns, uint64_t end_ns);
+    void Add(const Aggregate& other);
+    [[nodiscard]] ScopeStats ToScopeStats() const;
+  };
+
+  struct ScopeTimers {
+    // Sorted by start timestamp, then by end timestamp.
+    std::vector<uint64_t> starts_ns;
+    std::vector<uint64_t> ends_ns;
+    // Segment tree over `block_capacity` blocks, a power of two, so that blocks can be appended
+    // without changing the shape of the tree: node 1 is the root, the children of node i are 2i
+    // and 2i+1, and block b is node block_capacity + b.
+    std::vector<Aggregate> tree;
+    size_t block_capacity = 0;
+
+    // `intervals` are sorted pairs of start and end timestamp.
+    void AddIntervals(absl::Span<const std::pair<uint64_t, uint64_t>> intervals);
+    void UpdateTree(size_t first_changed_block);
+    void Accumulate(size_t node, size_t first_block, size_t end_block, size_t first_timer,
+                    size_t end_timer, uint64_t max_tick, Aggregate* result) const;
+    [[nodiscard]] std::pair<size_t, size_t> GetTimerIndexRange(uint64_t min_tick,
+                                                               uint64_t max_tick) const;
+  };
+
+  // Calls `consumer(duration_ns)` for each of the timers of ComputeScopeStats.
+  template <typename ConsumerT>
+  void ForEachTimerDuration(ScopeId scope_id, uint64_t min_tick, uint64_t max_tick,
+                            ConsumerT&& consumer) const;
+
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_map<ScopeId, ScopeTimers> scope_timers_ ABSL_GUARDED_BY(mutex_);
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_SCOPE_STATS_INDEX_H_
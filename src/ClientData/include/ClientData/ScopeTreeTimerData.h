@@ -14,7 +14,7 @@
 #include <vector>
 
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "Containers/ScopeTree.h"
 #include "TimerData.h"
 #include "TimerDataInterface.h"
@@ -32,24 +32,23 @@ class ScopeTreeTimerData final : public TimerDataInterface {
 
   // We are using a ScopeTree to automatically manage timers and their depth, no need to set it
   // here.
-  const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                 uint32_t /*unused_depth*/ = 0) override;
+  const TimerInfo& AddTimer(TimerInfo timer_info, uint32_t /*unused_depth*/ = 0) override;
   // Timers queries
   [[nodiscard]] std::vector<const TimerChain*> GetChains() const override {
     return timer_data_.GetChains();
   }
 
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimers(
       uint64_t start_ns = std::numeric_limits<uint64_t>::min(),
       uint64_t end_ns = std::numeric_limits<uint64_t>::max(),
       bool exclusive = false) const override;
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepth(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersAtDepth(
       uint32_t depth, uint64_t start_ns = std::numeric_limits<uint64_t>::min(),
       uint64_t end_ns = std::numeric_limits<uint64_t>::max()) const;
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthExclusive(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersAtDepthExclusive(
       uint32_t depth, uint64_t start_ns = std::numeric_limits<uint64_t>::min(),
       uint64_t end_ns = std::numeric_limits<uint64_t>::max()) const;
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthDiscretized(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersAtDepthDiscretized(
       uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const override;
 
   // Metadata queries
@@ -69,22 +68,17 @@ class ScopeTreeTimerData final : public TimerDataInterface {
   [[nodiscard]] int64_t GetThreadId() const override { return thread_id_; }
 
   // Relative timers queries
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] const TimerInfo* GetLeft(const TimerInfo& timer) const override;
+  [[nodiscard]] const TimerInfo* GetRight(const TimerInfo& timer) const override;
+  [[nodiscard]] const TimerInfo* GetUp(const TimerInfo& timer) const override;
+  [[nodiscard]] const TimerInfo* GetDown(const TimerInfo& timer) const override;
 
   void OnCaptureComplete() override;
 
  private:
   const int64_t thread_id_;
   mutable absl::Mutex scope_tree_mutex_;
-  orbit_containers::ScopeTree<const orbit_client_protos::TimerInfo> scope_tree_
-      ABSL_GUARDED_BY(scope_tree_mutex_);
+  orbit_containers::ScopeTree<const TimerInfo> scope_tree_ ABSL_GUARDED_BY(scope_tree_mutex_);
   ScopeTreeUpdateType scope_tree_update_type_;
 
   TimerData timer_data_;
@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Append.h"
 #include "ScopeTreeTimerData.h"
 #include "TimerDataManager.h"
@@ -25,16 +26,22 @@ class ThreadTrackDataManager final {
                                     ? ScopeTreeTimerData::ScopeTreeUpdateType::kOnCaptureComplete
                                     : ScopeTreeTimerData::ScopeTreeUpdateType::kAlways){};
 
-  const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info) {
-    absl::MutexLock lock(&mutex_);
-    uint32_t thread_id = timer_info.thread_id();
-    // Get or create ScopeTreeTimerData optimized to only make one query to the map, as AddTimer
-    // will be executed many times.
-    auto [it, inserted] = scope_tree_timer_data_map_.try_emplace(thread_id, nullptr);
-    if (inserted) {
-      it->second = std::make_unique<ScopeTreeTimerData>(thread_id, scope_tree_update_type_);
+  // Timers of different threads can be added concurrently, as the lock is only held to find the
+  // ScopeTreeTimerData of the thread, which is itself thread-safe.
+  const TimerInfo& AddTimer(TimerInfo timer_info) {
+    ScopeTreeTimerData* scope_tree_timer_data = nullptr;
+    {
+      absl::MutexLock lock(&mutex_);
+      uint32_t thread_id = timer_info.thread_id();
+      // Get or create ScopeTreeTimerData optimized to only make one query to the map, as AddTimer
+      // will be executed many times.
+      auto [it, inserted] = scope_tree_timer_data_map_.try_emplace(thread_id, nullptr);
+      if (inserted) {
+        it->second = std::make_unique<ScopeTreeTimerData>(thread_id, scope_tree_update_type_);
+      }
+      scope_tree_timer_data = it->second.get();
     }
-    return it->second->AddTimer(std::move(timer_info));
+    return scope_tree_timer_data->AddTimer(std::move(timer_info));
   }
 
   const ScopeTreeTimerData* GetScopeTreeTimerData(uint32_t thread_id) const {
@@ -18,7 +18,7 @@
 #include "ClientData/ThreadTrackDataManager.h"
 #include "ClientData/TimerChain.h"
 #include "ClientData/TimerData.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
@@ -30,7 +30,7 @@ class ThreadTrackDataProvider final {
       : thread_track_data_manager_{
             std::make_unique<ThreadTrackDataManager>(is_data_from_saved_capture)} {};
 
-  const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info) {
+  const TimerInfo& AddTimer(TimerInfo timer_info) {
     return thread_track_data_manager_->AddTimer(std::move(timer_info));
   }
 
@@ -47,7 +47,7 @@ class ThreadTrackDataProvider final {
     return GetScopeTreeTimerData(thread_id)->GetChains();
   }
 
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimers(
       uint32_t thread_id, uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
       uint64_t max_tick = std::numeric_limits<uint64_t>::max(), bool exclusive = false) const {
     const auto* scope_tree_timer_data = GetScopeTreeTimerData(thread_id);
@@ -59,9 +59,11 @@ class ThreadTrackDataProvider final {
   // when many timers map to the same pixel (zooming-out for example). The overall complexity is
   // O(log(num_timers) * resolution). Resolution should be the pixel width of the area where timers
   // will be drawn.
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthDiscretized(
-      uint32_t thread_id, uint32_t depth, uint32_t resolution, uint64_t start_ns,
-      uint64_t end_ns) const {
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersAtDepthDiscretized(uint32_t thread_id,
+                                                                          uint32_t depth,
+                                                                          uint32_t resolution,
+                                                                          uint64_t start_ns,
+                                                                          uint64_t end_ns) const {
     return GetScopeTreeTimerData(thread_id)->GetTimersAtDepthDiscretized(depth, resolution,
                                                                          start_ns, end_ns);
   }
@@ -71,7 +73,9 @@ class ThreadTrackDataProvider final {
     return GetScopeTreeTimerData(thread_id)->IsEmpty();
   };
   [[nodiscard]] size_t GetNumberOfTimers(uint32_t thread_id) const {
-    return GetScopeTreeTimerData(thread_id)->GetNumberOfTimers();
+    const auto* scope_tree_timer_data = GetScopeTreeTimerData(thread_id);
+    if (scope_tree_timer_data == nullptr) return 0;
+    return scope_tree_timer_data->GetNumberOfTimers();
   };
   [[nodiscard]] uint64_t GetMinTime(uint32_t thread_id) const {
     return GetScopeTreeTimerData(thread_id)->GetMinTime();
@@ -87,14 +91,10 @@ class ThreadTrackDataProvider final {
   };
 
   // Relative Timers query
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer) const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer) const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer) const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer) const;
+  [[nodiscard]] const TimerInfo* GetLeft(const TimerInfo& timer) const;
+  [[nodiscard]] const TimerInfo* GetRight(const TimerInfo& timer) const;
+  [[nodiscard]] const TimerInfo* GetUp(const TimerInfo& timer) const;
+  [[nodiscard]] const TimerInfo* GetDown(const TimerInfo& timer) const;
 
   void OnCaptureComplete();
 
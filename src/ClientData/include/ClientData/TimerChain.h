@@ -14,7 +14,7 @@
 #include <utility>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 
 namespace orbit_client_data {
@@ -39,10 +39,9 @@ class TimerBlock {
 
   // Append a new element to the end of the block using placement-new.
   template <class... Args>
-  const orbit_client_protos::TimerInfo& emplace_back(Args&&... args) {
+  const TimerInfo& emplace_back(Args&&... args) {
     ORBIT_CHECK(size() < kBlockSize);
-    const orbit_client_protos::TimerInfo& timer_info =
-        data_.emplace_back(std::forward<Args>(args)...);
+    const TimerInfo& timer_info = data_.emplace_back(std::forward<Args>(args)...);
     min_timestamp_ = std::min(timer_info.start(), min_timestamp_);
     max_timestamp_ = std::max(timer_info.end(), max_timestamp_);
     return timer_info;
@@ -57,20 +56,18 @@ class TimerBlock {
   [[nodiscard]] size_t size() const { return data_.size(); }
   [[nodiscard]] bool at_capacity() const { return size() == kBlockSize; }
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo& operator[](std::size_t idx) const {
-    return data_[idx];
-  }
+  [[nodiscard]] const TimerInfo& operator[](std::size_t idx) const { return data_[idx]; }
 
   // Assuming timers are sorted, returns the first one for which the end timestamp isn't smaller
   // than min_ns. Return nullptr if there is none.
-  [[nodiscard]] const orbit_client_protos::TimerInfo* LowerBound(uint64_t min_ns) const;
+  [[nodiscard]] const TimerInfo* LowerBound(uint64_t min_ns) const;
 
  private:
   static constexpr size_t kBlockSize = 1024;
 
   TimerBlock* prev_;
   TimerBlock* next_;
-  std::vector<orbit_client_protos::TimerInfo> data_;
+  std::vector<TimerInfo> data_;
 
   uint64_t min_timestamp_;
   uint64_t max_timestamp_;
@@ -113,10 +110,9 @@ class TimerChain {
   // Append an item to the end of the current block. If capacity of the current block is reached, a
   // new blocked is allocated and the item is added to the new block.
   template <class... Args>
-  const orbit_client_protos::TimerInfo& emplace_back(Args&&... args) {
+  const TimerInfo& emplace_back(Args&&... args) {
     if (current_->at_capacity()) AllocateNewBlock();
-    const orbit_client_protos::TimerInfo& timer_info =
-        current_->emplace_back(std::forward<Args>(args)...);
+    const TimerInfo& timer_info = current_->emplace_back(std::forward<Args>(args)...);
     ++num_items_;
     return timer_info;
   }
@@ -124,14 +120,14 @@ class TimerChain {
   [[nodiscard]] bool empty() const { return num_items_ == 0; }
   [[nodiscard]] uint64_t size() const { return num_items_; }
 
-  [[nodiscard]] const TimerBlock* GetBlockContaining(
-      const orbit_client_protos::TimerInfo& element) const;
+  [[nodiscard]] const TimerBlock* GetBlockContaining(const TimerInfo& element) const;
+
+  // Returns the block the last item was added to.
+  [[nodiscard]] const TimerBlock& GetLastBlock() const { return *current_; }
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetElementAfter(
-      const orbit_client_protos::TimerInfo& element) const;
+  [[nodiscard]] const TimerInfo* GetElementAfter(const TimerInfo& element) const;
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetElementBefore(
-      const orbit_client_protos::TimerInfo& element) const;
+  [[nodiscard]] const TimerInfo* GetElementBefore(const TimerInfo& element) const;
 
   [[nodiscard]] TimerChainIterator begin() const { return TimerChainIterator(root_); }
 
@@ -6,6 +6,7 @@
 #define CLIENT_DATA_TIMER_DATA_H_
 
 #include <absl/base/thread_annotations.h>
+#include <absl/container/flat_hash_map.h>
 #include <absl/synchronization/mutex.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -17,7 +18,8 @@
 #include <memory>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
+#include "ClientData/TimerLodPyramid.h"
 #include "OrbitBase/ThreadConstants.h"
 #include "TimerChain.h"
 #include "TimerDataInterface.h"
@@ -28,8 +30,7 @@ namespace orbit_client_data {
 // certain range as well as metadata from them. Timers might be divided in different depths.
 class TimerData final : public TimerDataInterface {
  public:
-  const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                 uint32_t depth = 0) override;
+  const TimerInfo& AddTimer(TimerInfo timer_info, uint32_t depth = 0) override;
 
   // Timers queries
   [[nodiscard]] std::vector<const TimerChain*> GetChains() const override;
@@ -37,20 +38,22 @@ class TimerData final : public TimerDataInterface {
 
   // The method is not optimized. The complexity is linear in the total number of timer_infos,
   // sortedness is not made use of.
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimers(
       uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
       uint64_t max_tick = std::numeric_limits<uint64_t>::max(),
       bool exclusive = false) const override;
   // Returns timers in a particular depth avoiding completely overlapped timers that map to the
   // same pixels in the screen. It assures to return at least one timer in each occupied pixel. The
-  // overall complexity is faster than GetTimers since it doesn't require going through all timers.
+  // query uses the TimerLodPyramid of the depth, so its complexity depends on the number of pixels
+  // rather than on the number of timers.
   // TODO(b/200692451): Provide a better solution for TimerTrack with intersecting timers.
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimersAtDepthDiscretized(
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersAtDepthDiscretized(
       uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const override;
 
   // Metadata queries
   [[nodiscard]] bool IsEmpty() const override { return GetNumberOfTimers() == 0; }
   [[nodiscard]] size_t GetNumberOfTimers() const override { return num_timers_; }
+  [[nodiscard]] size_t GetNumberOfTimersOfType(TimerInfo::Type type) const;
   [[nodiscard]] uint64_t GetMinTime() const override { return min_time_; }
   [[nodiscard]] uint64_t GetMaxTime() const override { return max_time_; }
   // TODO(b/204173036): Test depth and process_id.
@@ -60,28 +63,22 @@ class TimerData final : public TimerDataInterface {
   // Relative timers queries.
   // TODO(b/221024788): These queries assume Timers are inserted in order and don't work for
   // GpuSubmissionTrack.
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetFirstAfterStartTime(uint64_t time,
-                                                                             uint32_t depth) const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetFirstBeforeStartTime(uint64_t time,
-                                                                              uint32_t depth) const;
+  [[nodiscard]] const TimerInfo* GetFirstAfterStartTime(uint64_t time, uint32_t depth) const;
+  [[nodiscard]] const TimerInfo* GetFirstBeforeStartTime(uint64_t time, uint32_t depth) const;
 
-  const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer_info) const override {
+  const TimerInfo* GetLeft(const TimerInfo& timer_info) const override {
     return GetFirstBeforeStartTime(timer_info.start(), timer_info.depth());
   }
 
-  const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer_info) const override {
+  const TimerInfo* GetRight(const TimerInfo& timer_info) const override {
     return GetFirstAfterStartTime(timer_info.start(), timer_info.depth());
   }
 
-  const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer_info) const override {
+  const TimerInfo* GetUp(const TimerInfo& timer_info) const override {
     return GetFirstBeforeStartTime(timer_info.start(), timer_info.depth() - 1);
   }
 
-  const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer_info) const override {
+  const TimerInfo* GetDown(const TimerInfo& timer_info) const override {
     return GetFirstAfterStartTime(timer_info.start(), timer_info.depth() + 1);
   }
 
@@ -93,11 +90,14 @@ class TimerData final : public TimerDataInterface {
   void UpdateMinTime(uint64_t min_time);
   void UpdateMaxTime(uint64_t max_time);
   void UpdateDepth(uint32_t depth) { depth_ = std::max(depth_, depth); }
-  [[nodiscard]] TimerChain* GetOrCreateTimerChain(uint64_t depth);
+  [[nodiscard]] TimerChain* GetOrCreateTimerChain(uint64_t depth)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
   uint32_t depth_ = 0;
   mutable absl::Mutex mutex_;
   std::map<uint32_t, std::unique_ptr<TimerChain>> timers_ ABSL_GUARDED_BY(mutex_);
+  std::map<uint32_t, TimerLodPyramid> lod_pyramids_ ABSL_GUARDED_BY(mutex_);
+  absl::flat_hash_map<TimerInfo::Type, size_t> num_timers_per_type_ ABSL_GUARDED_BY(mutex_);
   std::atomic<size_t> num_timers_{0};
   std::atomic<uint64_t> min_time_{std::numeric_limits<uint64_t>::max()};
   std::atomic<uint64_t> max_time_{std::numeric_limits<uint64_t>::min()};
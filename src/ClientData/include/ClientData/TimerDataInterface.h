@@ -5,7 +5,7 @@
 #ifndef CLIENT_DATA_TIMER_DATA_INTERFACE_H_
 #define CLIENT_DATA_TIMER_DATA_INTERFACE_H_
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "FastRenderingUtils.h"
 #include "TimerChain.h"
 
@@ -16,22 +16,21 @@ class TimerDataInterface {
  public:
   virtual ~TimerDataInterface() = default;
 
-  virtual const orbit_client_protos::TimerInfo& AddTimer(orbit_client_protos::TimerInfo timer_info,
-                                                         uint32_t depth) = 0;
+  virtual const TimerInfo& AddTimer(TimerInfo timer_info, uint32_t depth) = 0;
 
   // Timers queries
   [[nodiscard]] virtual std::vector<const TimerChain*> GetChains() const = 0;
   // Returns all timers contained in [min_tick, max_tick] (always inclusive).
   // if exclusive=true, excludes timers that start or end outside of the time range.
   // if exclusive=false, includes all timers that intersect with the time range.
-  [[nodiscard]] virtual std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
-      uint64_t min_tick, uint64_t max_tick, bool exclusive) const = 0;
+  [[nodiscard]] virtual std::vector<const TimerInfo*> GetTimers(uint64_t min_tick,
+                                                                uint64_t max_tick,
+                                                                bool exclusive) const = 0;
   // Returns timers in a particular depth avoiding completely overlapped timers that map to the
   // same pixels in the screen. It assures to return at least one timer in each occupied pixel. The
   // overall complexity is faster than GetTimers since it doesn't require going through all timers.
-  [[nodiscard]] virtual std::vector<const orbit_client_protos::TimerInfo*>
-  GetTimersAtDepthDiscretized(uint32_t depth, uint32_t resolution, uint64_t start_ns,
-                              uint64_t end_ns) const = 0;
+  [[nodiscard]] virtual std::vector<const TimerInfo*> GetTimersAtDepthDiscretized(
+      uint32_t depth, uint32_t resolution, uint64_t start_ns, uint64_t end_ns) const = 0;
 
   // Metadata queries
   [[nodiscard]] virtual bool IsEmpty() const = 0;
@@ -42,14 +41,10 @@ class TimerDataInterface {
   [[nodiscard]] virtual uint32_t GetProcessId() const = 0;
 
   // Relative timers queries
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer) const = 0;
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer) const = 0;
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer) const = 0;
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer) const = 0;
+  [[nodiscard]] virtual const TimerInfo* GetLeft(const TimerInfo& timer) const = 0;
+  [[nodiscard]] virtual const TimerInfo* GetRight(const TimerInfo& timer) const = 0;
+  [[nodiscard]] virtual const TimerInfo* GetUp(const TimerInfo& timer) const = 0;
+  [[nodiscard]] virtual const TimerInfo* GetDown(const TimerInfo& timer) const = 0;
 
   // Only used in ScopeTreeTimerData
   [[nodiscard]] virtual int64_t GetThreadId() const = 0;
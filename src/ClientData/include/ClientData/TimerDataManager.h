@@ -10,7 +10,7 @@
 #include <vector>
 
 #include "ClientData/TimerData.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
 namespace orbit_client_data {
 
@@ -27,21 +27,37 @@ class TimerDataManager final {
     return std::make_pair(id, timer_data_.at(id).get());
   }
 
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetTimers(
-      orbit_client_protos::TimerInfo_Type type,
-      uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimers(
+      TimerInfo::Type type, uint64_t min_tick = std::numeric_limits<uint64_t>::min(),
       uint64_t max_tick = std::numeric_limits<uint64_t>::max(), bool exclusive = false) const {
-    std::vector<const orbit_client_protos::TimerInfo*> timers;
+    std::vector<const TimerInfo*> timers;
     absl::MutexLock lock(&mutex_);
     for (const std::unique_ptr<TimerData>& timer_datum : timer_data_) {
-      for (const orbit_client_protos::TimerInfo* timer :
-           timer_datum->GetTimers(min_tick, max_tick, exclusive)) {
+      for (const TimerInfo* timer : timer_datum->GetTimers(min_tick, max_tick, exclusive)) {
         if (timer->type() == type) timers.push_back(timer);
       }
     }
     return timers;
   }
 
+  [[nodiscard]] size_t GetNumberOfTimers() const {
+    size_t num_timers = 0;
+    absl::MutexLock lock(&mutex_);
+    for (const std::unique_ptr<TimerData>& timer_datum : timer_data_) {
+      num_timers += timer_datum->GetNumberOfTimers();
+    }
+    return num_timers;
+  }
+
+  [[nodiscard]] size_t GetNumberOfTimersOfType(TimerInfo::Type type) const {
+    size_t num_timers = 0;
+    absl::MutexLock lock(&mutex_);
+    for (const std::unique_ptr<TimerData>& timer_datum : timer_data_) {
+      num_timers += timer_datum->GetNumberOfTimersOfType(type);
+    }
+    return num_timers;
+  }
+
  private:
   mutable absl::Mutex mutex_;
   std::vector<std::unique_ptr<TimerData>> timer_data_ ABSL_GUARDED_BY(mutex_);
@@ -0,0 +1,158 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_TIMER_INFO_H_
+#define CLIENT_DATA_TIMER_INFO_H_
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ClientProtos/capture_data.pb.h"
+
+namespace orbit_client_data {
+
+// This class represents a timer (a time interval on a thread or a track) on the client. Captures
+// contain many millions of timers, so instead of a protobuf message this is a compact value type:
+// the fields every timer needs are stored inline, while the fields that only some types of timers
+// set (callstacks, registers, colors, API scope names, ...) are allocated on first write. The
+// accessors mirror the ones of the protobuf message this class replaces.
+class TimerInfo {
+ public:
+  enum Type : uint8_t {
+    kNone = 0,
+    kCoreActivity = 1,
+    kGpuActivity = 3,
+    kFrame = 4,
+    kGpuCommandBuffer = 5,
+    kGpuDebugMarker = 6,
+    kApiEvent = 7,
+    kApiScope = 11,
+    kApiScopeAsync = 12,
+  };
+
+  TimerInfo() = default;
+  TimerInfo(const TimerInfo& other);
+  TimerInfo& operator=(const TimerInfo& other);
+  TimerInfo(TimerInfo&& other) = default;
+  TimerInfo& operator=(TimerInfo&& other) = default;
+  ~TimerInfo() = default;
+
+  [[nodiscard]] uint64_t start() const { return start_; }
+  void set_start(uint64_t start) { start_ = start; }
+  [[nodiscard]] uint64_t end() const { return end_; }
+  void set_end(uint64_t end) { end_ = end; }
+  [[nodiscard]] uint32_t process_id() const { return process_id_; }
+  void set_process_id(uint32_t process_id) { process_id_ = process_id; }
+  [[nodiscard]] uint32_t thread_id() const { return thread_id_; }
+  void set_thread_id(uint32_t thread_id) { thread_id_ = thread_id; }
+  [[nodiscard]] uint32_t depth() const { return depth_; }
+  void set_depth(uint32_t depth) { depth_ = depth; }
+  [[nodiscard]] Type type() const { return type_; }
+  void set_type(Type type) { type_ = type; }
+  [[nodiscard]] int32_t processor() const { return processor_; }
+  void set_processor(int32_t processor) { processor_ = processor; }
+  [[nodiscard]] uint64_t function_id() const { return function_id_; }
+  void set_function_id(uint64_t function_id) { function_id_ = function_id; }
+  [[nodiscard]] uint64_t user_data_key() const { return user_data_key_; }
+  void set_user_data_key(uint64_t user_data_key) { user_data_key_ = user_data_key; }
+
+  [[nodiscard]] uint64_t callstack_id() const {
+    return rare_fields_ != nullptr ? rare_fields_->callstack_id : 0;
+  }
+  void set_callstack_id(uint64_t callstack_id) {
+    if (callstack_id != 0 || rare_fields_ != nullptr) {
+      mutable_rare_fields()->callstack_id = callstack_id;
+    }
+  }
+  [[nodiscard]] uint64_t timeline_hash() const {
+    return rare_fields_ != nullptr ? rare_fields_->timeline_hash : 0;
+  }
+  void set_timeline_hash(uint64_t timeline_hash) {
+    if (timeline_hash != 0 || rare_fields_ != nullptr) {
+      mutable_rare_fields()->timeline_hash = timeline_hash;
+    }
+  }
+  [[nodiscard]] uint64_t group_id() const {
+    return rare_fields_ != nullptr ? rare_fields_->group_id : 0;
+  }
+  void set_group_id(uint64_t group_id) {
+    if (group_id != 0 || rare_fields_ != nullptr) {
+      mutable_rare_fields()->group_id = group_id;
+    }
+  }
+  [[nodiscard]] uint64_t api_async_scope_id() const {
+    return rare_fields_ != nullptr ? rare_fields_->api_async_scope_id : 0;
+  }
+  void set_api_async_scope_id(uint64_t api_async_scope_id) {
+    if (api_async_scope_id != 0 || rare_fields_ != nullptr) {
+      mutable_rare_fields()->api_async_scope_id = api_async_scope_id;
+    }
+  }
+  [[nodiscard]] uint64_t address_in_function() const {
+    return rare_fields_ != nullptr ? rare_fields_->address_in_function : 0;
+  }
+  void set_address_in_function(uint64_t address_in_function) {
+    if (address_in_function != 0 || rare_fields_ != nullptr) {
+      mutable_rare_fields()->address_in_function = address_in_function;
+    }
+  }
+
+  [[nodiscard]] int registers_size() const {
+    return rare_fields_ != nullptr ? static_cast<int>(rare_fields_->registers.size()) : 0;
+  }
+  [[nodiscard]] uint64_t registers(int index) const;
+  void add_registers(uint64_t value) { mutable_rare_fields()->registers.push_back(value); }
+
+  [[nodiscard]] bool has_color() const {
+    return rare_fields_ != nullptr && rare_fields_->color.has_value();
+  }
+  [[nodiscard]] const orbit_client_protos::Color& color() const;
+  [[nodiscard]] orbit_client_protos::Color* mutable_color();
+
+  [[nodiscard]] const std::string& api_scope_name() const;
+  void set_api_scope_name(std::string api_scope_name) {
+    if (!api_scope_name.empty() || rare_fields_ != nullptr) {
+      mutable_rare_fields()->api_scope_name = std::move(api_scope_name);
+    }
+  }
+
+  friend bool operator==(const TimerInfo& lhs, const TimerInfo& rhs);
+  friend bool operator!=(const TimerInfo& lhs, const TimerInfo& rhs) { return !(lhs == rhs); }
+
+ private:
+  struct RareFields {
+    uint64_t callstack_id = 0;
+    uint64_t timeline_hash = 0;
+    uint64_t group_id = 0;
+    uint64_t api_async_scope_id = 0;
+    uint64_t address_in_function = 0;
+    std::vector<uint64_t> registers;
+    std::optional<orbit_client_protos::Color> color;
+    std::string api_scope_name;
+  };
+
+  [[nodiscard]] RareFields* mutable_rare_fields() {
+    if (rare_fields_ == nullptr) rare_fields_ = std::make_unique<RareFields>();
+    return rare_fields_.get();
+  }
+
+  uint64_t start_ = 0;
+  uint64_t end_ = 0;
+  uint64_t function_id_ = 0;
+  uint64_t user_data_key_ = 0;
+  uint32_t process_id_ = 0;
+  uint32_t thread_id_ = 0;
+  uint32_t depth_ = 0;
+  int32_t processor_ = 0;
+  Type type_ = kNone;
+  std::unique_ptr<RareFields> rare_fields_;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_TIMER_INFO_H_
@@ -0,0 +1,71 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CLIENT_DATA_TIMER_LOD_PYRAMID_H_
+#define CLIENT_DATA_TIMER_LOD_PYRAMID_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
+
+namespace orbit_client_data {
+
+// Multi-resolution summary of the timers of a single TimerChain (i.e., of a single depth), used to
+// answer discretized queries in time proportional to the number of pixels rather than to the
+// number of timers. Level 0 has one bucket per TimerBlock; each bucket of level `l + 1` summarizes
+// `kFanout` consecutive buckets of level `l`. Each bucket stores the time span covered by its
+// timers and its longest timer, which is drawn in place of all of them when the whole bucket falls
+// into a single pixel.
+//
+// The pyramid is updated incrementally on each Add, so it's always up to date during a live
+// capture as well as after loading a capture. It holds pointers to the blocks and timers of the
+// chain, which are stable, and it's not thread-safe: the owner must synchronize Add with queries.
+class TimerLodPyramid {
+ public:
+  // `timer` must be the timer that was just added to `block`, which must be the last block of the
+  // chain.
+  void Add(const TimerBlock& block, const TimerInfo& timer);
+
+  // Same contract as TimerDataInterface::GetTimersAtDepthDiscretized, for the closed-open interval
+  // [start_ns, end_ns).
+  [[nodiscard]] std::vector<const TimerInfo*> GetTimersDiscretized(uint32_t resolution,
+                                                                   uint64_t start_ns,
+                                                                   uint64_t end_ns) const;
+
+  [[nodiscard]] size_t GetNumberOfLevels() const { return levels_.size(); }
+
+  static constexpr size_t kFanout = 16;
+
+ private:
+  struct Bucket {
+    uint64_t min_start_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t max_end_ns = std::numeric_limits<uint64_t>::min();
+    const TimerInfo* longest_timer = nullptr;
+  };
+
+  struct Query {
+    uint32_t resolution;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    uint64_t next_pixel_start_ns;
+    std::vector<const TimerInfo*> timers;
+  };
+
+  static void UpdateBucket(Bucket& bucket, const TimerInfo& timer);
+
+  void CollectFromBucket(size_t level, size_t index, Query& query) const;
+  static void CollectFromBlock(const TimerBlock& block, Query& query);
+
+  std::vector<const TimerBlock*> blocks_;
+  // levels_[0][i] summarizes blocks_[i]. The top level always has a single bucket.
+  std::vector<std::vector<Bucket>> levels_;
+};
+
+}  // namespace orbit_client_data
+
+#endif  // CLIENT_DATA_TIMER_LOD_PYRAMID_H_
@@ -15,9 +15,9 @@
 #include <string>
 #include <string_view>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 namespace orbit_client_data {
 
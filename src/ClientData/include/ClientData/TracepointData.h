@@ -20,7 +20,6 @@
 
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/tracepoint.pb.h"
 
 namespace orbit_client_data {
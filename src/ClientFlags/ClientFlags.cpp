@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,12 @@ ABSL_FLAG(std::string, instance_symbols_folder, "",
 ABSL_FLAG(bool, enforce_full_redraw, false,
           "Enforce full redraw every frame (used for performance measurements)");
 
+ABSL_FLAG(bool, parallel_track_primitives, true,
+          "Update the primitives of the tracks of the capture window on multiple threads");
+
+ABSL_FLAG(bool, compress_capture_stream, false,
+          "Have OrbitService compress the capture data it sends with gzip (for slow connections)");
+
 ABSL_FLAG(std::vector<std::string>, additional_symbol_paths, {},
           "Additional local symbol locations (comma-separated)");
 
@@ -64,6 +71,13 @@ ABSL_FLAG(bool, auto_frame_track, true, "Automatically add the default Frame Tra
 
 ABSL_FLAG(bool, time_range_selection, false, "Enable time range selection feature.");
 
+ABSL_FLAG(std::optional<uint64_t>, load_capture_start_ms, std::nullopt,
+          "When loading a capture, skip the events that end earlier than this many milliseconds "
+          "after the start of the capture. If not set, load from the start of the capture.");
+ABSL_FLAG(std::optional<uint64_t>, load_capture_end_ms, std::nullopt,
+          "When loading a capture, skip the events that start later than this many milliseconds "
+          "after the start of the capture. If not set, load until the end of the capture.");
+
 ABSL_FLAG(bool, symbol_store_support, false, "Enable experimental symbol store support.");
 
 // Disables retrieving symbols from the instance. This is intended for symbol store e2e tests.
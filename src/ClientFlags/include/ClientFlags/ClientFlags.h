@@ -8,6 +8,7 @@
 #include <absl/flags/declare.h>
 
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,9 @@ ABSL_DECLARE_FLAG(std::string, instance_symbols_folder);
 
 ABSL_DECLARE_FLAG(bool, enforce_full_redraw);
 
+ABSL_DECLARE_FLAG(bool, parallel_track_primitives);
+ABSL_DECLARE_FLAG(bool, compress_capture_stream);
+
 ABSL_DECLARE_FLAG(std::vector<std::string>, additional_symbol_paths);
 
 // Clears QSettings. This is intended for e2e tests.
@@ -59,6 +63,10 @@ ABSL_DECLARE_FLAG(bool, auto_frame_track);
 // Enables time range selection feature.
 ABSL_DECLARE_FLAG(bool, time_range_selection);
 
+// Restrict loading a capture to the events of a window of time.
+ABSL_DECLARE_FLAG(std::optional<uint64_t>, load_capture_start_ms);
+ABSL_DECLARE_FLAG(std::optional<uint64_t>, load_capture_end_ms);
+
 // Enables experimental symbol store support.
 ABSL_DECLARE_FLAG(bool, symbol_store_support);
 
@@ -9,6 +9,7 @@
 #include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
 #include <absl/meta/type_traits.h>
+#include <absl/types/span.h>
 #include <stddef.h>
 
 #include <algorithm>
@@ -20,11 +21,15 @@
 #include <utility>
 #include <vector>
 
+#include "ApiInterface/Orbit.h"
 #include "ClientData/CallstackEvent.h"
 #include "ClientData/CallstackInfo.h"
 #include "ClientData/CallstackType.h"
+#include "ClientData/FunctionAddressCache.h"
 #include "ClientData/ModuleAndFunctionLookup.h"
+#include "OrbitBase/Chunk.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitBase/TaskGroup.h"
 #include "OrbitBase/ThreadConstants.h"
 
 using orbit_client_data::CallstackData;
@@ -32,6 +37,7 @@ using orbit_client_data::CallstackEvent;
 using orbit_client_data::CallstackInfo;
 using orbit_client_data::CallstackType;
 using orbit_client_data::CaptureData;
+using orbit_client_data::FunctionAddressCache;
 using orbit_client_data::ModuleManager;
 using orbit_client_data::PostProcessedSamplingData;
 using orbit_client_data::SampledFunction;
@@ -88,14 +94,22 @@ class SamplingDataPostProcessor {
                                            const ModuleManager& module_manager);
 
  private:
+  static void CountSampledAddresses(
+      const absl::flat_hash_map<uint64_t, const CallstackInfo*>& id_to_callstack,
+      ThreadSampleData* thread_sample_data);
+
   void ResolveCallstacks(const CallstackData& callstack_data, const CaptureData& capture_data,
                          const ModuleManager& module_manager);
 
-  void MapAddressToFunctionAddress(uint64_t absolute_address, const CaptureData& capture_data,
-                                   const ModuleManager& module_manager);
+  void MapAddressesToFunctionAddresses(const CallstackData& callstack_data,
+                                       const CaptureData& capture_data,
+                                       const ModuleManager& module_manager);
+
+  void CountResolvedAddresses(ThreadSampleData* thread_sample_data) const;
 
-  void FillThreadSampleDataSampleReports(const CaptureData& capture_data,
-                                         const ModuleManager& module_manager);
+  static void FillThreadSampleDataSampleReport(const CaptureData& capture_data,
+                                               const ModuleManager& module_manager,
+                                               ThreadSampleData* thread_sample_data);
 
   // Filled by ProcessSamples.
   absl::flat_hash_map<ThreadID, ThreadSampleData> thread_id_to_sample_data_;
@@ -122,39 +136,13 @@ namespace {
 PostProcessedSamplingData SamplingDataPostProcessor::ProcessSamples(
     const CallstackData& callstack_data, const CaptureData& capture_data,
     const ModuleManager& module_manager) {
-  // Unique call stacks and per thread data
-  callstack_data.ForEachCallstackEvent([this, &callstack_data](const CallstackEvent& event) {
-    const CallstackInfo* callstack_info = callstack_data.GetCallstack(event.callstack_id());
-    ORBIT_CHECK(callstack_info != nullptr);
-
-    std::vector<uint64_t> sorted_frames;
-    ORBIT_CHECK(!callstack_info->frames().empty());
-    if (callstack_info->type() == CallstackType::kComplete) {
-      for (uint64_t frame : callstack_info->frames()) {
-        sorted_frames.push_back(frame);
-      }
-    } else {
-      // For non-kComplete callstacks, only use the innermost frame for statistics, as it's the only
-      // one known to be correct. Note that, in the vast majority of cases, the innermost frame is
-      // also the only one available.
-      sorted_frames.push_back(callstack_info->frames()[0]);
-    }
-
-    // We need to consider duplicated frames (because of recursion) only once. We should use a set
-    // for better time complexity but sorting and comparing adjacent elements is faster in practice
-    // for a number of elements in the order of the number of frames in a callstack.
-    std::sort(sorted_frames.begin(), sorted_frames.end());
-
+  // Group the events by thread and by callstack in a single sweep over the events. Everything that
+  // depends on the frames is then computed once per callstack and thread, in parallel.
+  callstack_data.ForEachCallstackEvent([this](const CallstackEvent& event) {
     ThreadSampleData* thread_sample_data = &thread_id_to_sample_data_[event.thread_id()];
     thread_sample_data->thread_id = event.thread_id();
     thread_sample_data->samples_count++;
     thread_sample_data->sampled_callstack_id_to_events[event.callstack_id()].emplace_back(event);
-    for (size_t i = 0; i < sorted_frames.size(); ++i) {
-      if (i != 0 && sorted_frames[i] == sorted_frames[i - 1]) {
-        continue;
-      }
-      thread_sample_data->sampled_address_to_count[sorted_frames[i]]++;
-    }
 
     ThreadSampleData* all_thread_sample_data =
         &thread_id_to_sample_data_[orbit_base::kAllProcessThreadsTid];
@@ -162,85 +150,104 @@ PostProcessedSamplingData SamplingDataPostProcessor::ProcessSamples(
     all_thread_sample_data->samples_count++;
     all_thread_sample_data->sampled_callstack_id_to_events[event.callstack_id()].emplace_back(
         event);
-    for (size_t i = 0; i < sorted_frames.size(); ++i) {
-      if (i != 0 && sorted_frames[i] == sorted_frames[i - 1]) {
-        continue;
-      }
-      all_thread_sample_data->sampled_address_to_count[sorted_frames[i]]++;
-    }
   });
   // Only include the summary if there is more than 1 thread in the data.
   if (thread_id_to_sample_data_.size() == 2) {
     thread_id_to_sample_data_.erase(orbit_base::kAllProcessThreadsTid);
   }
 
-  ResolveCallstacks(callstack_data, capture_data, module_manager);
-
-  for (auto& sample_data_it : thread_id_to_sample_data_) {
-    ThreadSampleData* thread_sample_data = &sample_data_it.second;
+  std::vector<ThreadSampleData*> thread_sample_datas;
+  thread_sample_datas.reserve(thread_id_to_sample_data_.size());
+  for (auto& [unused_thread_id, thread_sample_data] : thread_id_to_sample_data_) {
+    thread_sample_datas.push_back(&thread_sample_data);
+  }
 
-    // Address count per sample per thread
-    for (const auto& [sampled_callstack_id, callstack_events] :
-         thread_sample_data->sampled_callstack_id_to_events) {
-      uint64_t callstack_count = callstack_events.size();
-      uint64_t resolved_callstack_id = original_id_to_resolved_callstack_id_[sampled_callstack_id];
-      const CallstackInfo& resolved_callstack = id_to_resolved_callstack_.at(resolved_callstack_id);
+  {
+    absl::flat_hash_map<uint64_t, const CallstackInfo*> id_to_callstack;
+    callstack_data.ForEachUniqueCallstack(
+        [&id_to_callstack](uint64_t callstack_id, const CallstackInfo& callstack) {
+          id_to_callstack.emplace(callstack_id, &callstack);
+        });
+
+    orbit_base::TaskGroup task_group;
+    for (ThreadSampleData* thread_sample_data : thread_sample_datas) {
+      task_group.AddTask([&id_to_callstack, thread_sample_data]() {
+        ORBIT_SCOPE("SamplingDataPostProcessor::CountSampledAddresses");
+        CountSampledAddresses(id_to_callstack, thread_sample_data);
+      });
+    }
+    task_group.Wait();
+  }
 
-      // "Exclusive" stat.
-      ORBIT_CHECK(!resolved_callstack.frames().empty());
-      thread_sample_data->resolved_address_to_exclusive_count[resolved_callstack.frames()[0]] +=
-          callstack_count;
+  ResolveCallstacks(callstack_data, capture_data, module_manager);
 
-      absl::flat_hash_set<uint64_t> unique_resolved_addresses;
-      if (resolved_callstack.type() == CallstackType::kComplete) {
-        for (uint64_t resolved_address : resolved_callstack.frames()) {
-          unique_resolved_addresses.insert(resolved_address);
-        }
-      } else {
-        // For non-kComplete callstacks, only use the innermost frame for statistics.
-        unique_resolved_addresses.insert(resolved_callstack.frames()[0]);
-      }
+  {
+    orbit_base::TaskGroup task_group;
+    for (ThreadSampleData* thread_sample_data : thread_sample_datas) {
+      task_group.AddTask([this, &capture_data, &module_manager, thread_sample_data]() {
+        ORBIT_SCOPE("SamplingDataPostProcessor::FillThreadSampleData");
+        CountResolvedAddresses(thread_sample_data);
+        FillThreadSampleDataSampleReport(capture_data, module_manager, thread_sample_data);
+      });
+    }
+    task_group.Wait();
+  }
 
-      // "Inclusive" stat.
-      for (uint64_t resolved_address : unique_resolved_addresses) {
-        thread_sample_data->resolved_address_to_count[resolved_address] += callstack_count;
-      }
+  return {std::move(thread_id_to_sample_data_), std::move(id_to_resolved_callstack_),
+          std::move(original_id_to_resolved_callstack_id_),
+          std::move(function_address_to_sampled_callstack_ids_)};
+}
 
-      // "Unwind errors" stat.
-      if (resolved_callstack.type() != CallstackType::kComplete) {
-        thread_sample_data->resolved_address_to_error_count[resolved_callstack.frames()[0]] +=
-            callstack_count;
+void SamplingDataPostProcessor::CountSampledAddresses(
+    const absl::flat_hash_map<uint64_t, const CallstackInfo*>& id_to_callstack,
+    ThreadSampleData* thread_sample_data) {
+  std::vector<uint64_t> sorted_frames;
+  for (const auto& [callstack_id, callstack_events] :
+       thread_sample_data->sampled_callstack_id_to_events) {
+    auto callstack_it = id_to_callstack.find(callstack_id);
+    ORBIT_CHECK(callstack_it != id_to_callstack.end());
+    const CallstackInfo* callstack_info = callstack_it->second;
+
+    sorted_frames.clear();
+    ORBIT_CHECK(!callstack_info->frames().empty());
+    if (callstack_info->type() == CallstackType::kComplete) {
+      for (uint64_t frame : callstack_info->frames()) {
+        sorted_frames.push_back(frame);
       }
+    } else {
+      // For non-kComplete callstacks, only use the innermost frame for statistics, as it's the only
+      // one known to be correct. Note that, in the vast majority of cases, the innermost frame is
+      // also the only one available.
+      sorted_frames.push_back(callstack_info->frames()[0]);
     }
 
-    // For each thread, sort resolved (function) addresses by inclusive count.
-    for (const auto& address_count_it : thread_sample_data->resolved_address_to_count) {
-      const uint64_t address = address_count_it.first;
-      const uint32_t count = address_count_it.second;
-      thread_sample_data->sorted_count_to_resolved_address.insert(std::make_pair(count, address));
+    // We need to consider duplicated frames (because of recursion) only once. We should use a set
+    // for better time complexity but sorting and comparing adjacent elements is faster in practice
+    // for a number of elements in the order of the number of frames in a callstack.
+    std::sort(sorted_frames.begin(), sorted_frames.end());
+
+    const uint32_t callstack_count = callstack_events.size();
+    for (size_t i = 0; i < sorted_frames.size(); ++i) {
+      if (i != 0 && sorted_frames[i] == sorted_frames[i - 1]) {
+        continue;
+      }
+      thread_sample_data->sampled_address_to_count[sorted_frames[i]] += callstack_count;
     }
   }
-
-  FillThreadSampleDataSampleReports(capture_data, module_manager);
-
-  return {std::move(thread_id_to_sample_data_), std::move(id_to_resolved_callstack_),
-          std::move(original_id_to_resolved_callstack_id_),
-          std::move(function_address_to_sampled_callstack_ids_)};
 }
 
 void SamplingDataPostProcessor::ResolveCallstacks(const CallstackData& callstack_data,
                                                   const CaptureData& capture_data,
                                                   const ModuleManager& module_manager) {
-  callstack_data.ForEachUniqueCallstack([this, &capture_data, &module_manager](
-                                            uint64_t callstack_id, const CallstackInfo& callstack) {
+  MapAddressesToFunctionAddresses(callstack_data, capture_data, module_manager);
+
+  callstack_data.ForEachUniqueCallstack([this](uint64_t callstack_id,
+                                               const CallstackInfo& callstack) {
     // A "resolved callstack" is a callstack where every address is replaced by the start address of
     // the function (if known).
     std::vector<uint64_t> resolved_callstack_frames;
 
     for (uint64_t address : callstack.frames()) {
-      if (!exact_address_to_function_address_.contains(address)) {
-        MapAddressToFunctionAddress(address, capture_data, module_manager);
-      }
       auto function_address_it = exact_address_to_function_address_.find(address);
       ORBIT_CHECK(function_address_it != exact_address_to_function_address_.end());
       resolved_callstack_frames.push_back(function_address_it->second);
@@ -282,63 +289,158 @@ void SamplingDataPostProcessor::ResolveCallstacks(const CallstackData& callstack
   });
 }
 
-void SamplingDataPostProcessor::MapAddressToFunctionAddress(uint64_t absolute_address,
-                                                            const CaptureData& capture_data,
-                                                            const ModuleManager& module_manager) {
+void SamplingDataPostProcessor::MapAddressesToFunctionAddresses(
+    const CallstackData& callstack_data, const CaptureData& capture_data,
+    const ModuleManager& module_manager) {
   // SamplingDataPostProcessor relies heavily on the association between address and function
   // address held by exact_address_to_function_address_, otherwise each address is considered a
-  // different function. We are storing this mapping for faster lookup.
-  std::optional<uint64_t> absolute_function_address_option =
-      orbit_client_data::FindFunctionAbsoluteAddressByInstructionAbsoluteAddress(
-          module_manager, capture_data, absolute_address);
-  uint64_t absolute_function_address = absolute_function_address_option.value_or(absolute_address);
+  // different function. The association is memoized in the FunctionAddressCache of the capture, so
+  // that only addresses that were never seen before are looked up in the modules. The generation
+  // is recorded before any lookup, so that if the cache is cleared while this runs, the addresses
+  // resolved with the old symbols are not inserted.
+  FunctionAddressCache& cache = capture_data.GetFunctionAddressCache();
+  const uint64_t cache_generation = cache.GetGeneration();
+  absl::flat_hash_set<uint64_t> uncached_addresses;
+  callstack_data.ForEachUniqueCallstack(
+      [this, &cache, &uncached_addresses](uint64_t /*callstack_id*/,
+                                          const CallstackInfo& callstack) {
+        for (uint64_t address : callstack.frames()) {
+          if (exact_address_to_function_address_.contains(address) ||
+              uncached_addresses.contains(address)) {
+            continue;
+          }
+          std::optional<uint64_t> function_address = cache.Find(address);
+          if (function_address.has_value()) {
+            exact_address_to_function_address_.emplace(address, function_address.value());
+          } else {
+            uncached_addresses.insert(address);
+          }
+        }
+      });
+  if (uncached_addresses.empty()) return;
 
-  exact_address_to_function_address_[absolute_address] = absolute_function_address;
+  std::vector<std::pair<uint64_t, std::optional<uint64_t>>> absolute_and_function_addresses;
+  absolute_and_function_addresses.reserve(uncached_addresses.size());
+  for (uint64_t address : uncached_addresses) {
+    absolute_and_function_addresses.emplace_back(address, std::nullopt);
+  }
+
+  constexpr size_t kNumAddressesPerTask = 1024;
+  {
+    orbit_base::TaskGroup task_group;
+    for (absl::Span<std::pair<uint64_t, std::optional<uint64_t>>> chunk :
+         orbit_base::CreateChunksOfSize(absolute_and_function_addresses, kNumAddressesPerTask)) {
+      task_group.AddTask([chunk, &capture_data, &module_manager]() {
+        ORBIT_SCOPE("SamplingDataPostProcessor::MapAddressesToFunctionAddresses Task");
+        for (auto& [absolute_address, function_address] : chunk) {
+          function_address =
+              orbit_client_data::FindFunctionAbsoluteAddressByInstructionAbsoluteAddress(
+                  module_manager, capture_data, absolute_address);
+        }
+      });
+    }
+    task_group.Wait();
+  }
+
+  // Addresses that couldn't be resolved are considered functions of their own, but this is not
+  // cached: the modules and the address infos of the capture keep growing during a live capture, so
+  // a later run might resolve them.
+  std::vector<std::pair<uint64_t, uint64_t>> resolved_absolute_and_function_addresses;
+  for (const auto& [absolute_address, function_address] : absolute_and_function_addresses) {
+    if (function_address.has_value()) {
+      resolved_absolute_and_function_addresses.emplace_back(absolute_address,
+                                                            function_address.value());
+    }
+    exact_address_to_function_address_.emplace(absolute_address,
+                                               function_address.value_or(absolute_address));
+  }
+  cache.Insert(cache_generation, resolved_absolute_and_function_addresses);
 }
 
-void SamplingDataPostProcessor::FillThreadSampleDataSampleReports(
-    const CaptureData& capture_data, const ModuleManager& module_manager) {
-  for (auto& data : thread_id_to_sample_data_) {
-    ThreadSampleData* thread_sample_data = &data.second;
-    std::vector<SampledFunction>* sampled_functions = &thread_sample_data->sampled_functions;
+void SamplingDataPostProcessor::CountResolvedAddresses(ThreadSampleData* thread_sample_data) const {
+  // Address count per sample per thread
+  for (const auto& [sampled_callstack_id, callstack_events] :
+       thread_sample_data->sampled_callstack_id_to_events) {
+    uint64_t callstack_count = callstack_events.size();
+    uint64_t resolved_callstack_id = original_id_to_resolved_callstack_id_.at(sampled_callstack_id);
+    const CallstackInfo& resolved_callstack = id_to_resolved_callstack_.at(resolved_callstack_id);
+
+    // "Exclusive" stat.
+    ORBIT_CHECK(!resolved_callstack.frames().empty());
+    thread_sample_data->resolved_address_to_exclusive_count[resolved_callstack.frames()[0]] +=
+        callstack_count;
+
+    absl::flat_hash_set<uint64_t> unique_resolved_addresses;
+    if (resolved_callstack.type() == CallstackType::kComplete) {
+      for (uint64_t resolved_address : resolved_callstack.frames()) {
+        unique_resolved_addresses.insert(resolved_address);
+      }
+    } else {
+      // For non-kComplete callstacks, only use the innermost frame for statistics.
+      unique_resolved_addresses.insert(resolved_callstack.frames()[0]);
+    }
+
+    // "Inclusive" stat.
+    for (uint64_t resolved_address : unique_resolved_addresses) {
+      thread_sample_data->resolved_address_to_count[resolved_address] += callstack_count;
+    }
+
+    // "Unwind errors" stat.
+    if (resolved_callstack.type() != CallstackType::kComplete) {
+      thread_sample_data->resolved_address_to_error_count[resolved_callstack.frames()[0]] +=
+          callstack_count;
+    }
+  }
+
+  // For each thread, sort resolved (function) addresses by inclusive count.
+  for (const auto& address_count_it : thread_sample_data->resolved_address_to_count) {
+    const uint64_t address = address_count_it.first;
+    const uint32_t count = address_count_it.second;
+    thread_sample_data->sorted_count_to_resolved_address.insert(std::make_pair(count, address));
+  }
+}
 
-    for (auto sorted_it = thread_sample_data->sorted_count_to_resolved_address.rbegin();
-         sorted_it != thread_sample_data->sorted_count_to_resolved_address.rend(); ++sorted_it) {
-      uint32_t num_occurrences = sorted_it->first;
-      uint64_t absolute_address = sorted_it->second;
+void SamplingDataPostProcessor::FillThreadSampleDataSampleReport(
+    const CaptureData& capture_data, const ModuleManager& module_manager,
+    ThreadSampleData* thread_sample_data) {
+  std::vector<SampledFunction>* sampled_functions = &thread_sample_data->sampled_functions;
 
-      SampledFunction function;
-      function.name = orbit_client_data::GetFunctionNameByAddress(module_manager, capture_data,
-                                                                  absolute_address);
+  for (auto sorted_it = thread_sample_data->sorted_count_to_resolved_address.rbegin();
+       sorted_it != thread_sample_data->sorted_count_to_resolved_address.rend(); ++sorted_it) {
+    uint32_t num_occurrences = sorted_it->first;
+    uint64_t absolute_address = sorted_it->second;
 
-      function.inclusive = num_occurrences;
-      function.inclusive_percent = 100.f * num_occurrences / thread_sample_data->samples_count;
+    SampledFunction function;
+    function.name = orbit_client_data::GetFunctionNameByAddress(module_manager, capture_data,
+                                                                absolute_address);
 
-      function.exclusive = 0;
-      function.exclusive_percent = 0.f;
+    function.inclusive = num_occurrences;
+    function.inclusive_percent = 100.f * num_occurrences / thread_sample_data->samples_count;
 
-      if (auto it = thread_sample_data->resolved_address_to_exclusive_count.find(absolute_address);
-          it != thread_sample_data->resolved_address_to_exclusive_count.end()) {
-        function.exclusive = it->second;
-        function.exclusive_percent = 100.f * it->second / thread_sample_data->samples_count;
-      }
+    function.exclusive = 0;
+    function.exclusive_percent = 0.f;
 
-      function.unwind_errors = 0;
-      function.unwind_errors_percent = 0.f;
-      if (auto it = thread_sample_data->resolved_address_to_error_count.find(absolute_address);
-          it != thread_sample_data->resolved_address_to_error_count.end()) {
-        function.unwind_errors = it->second;
-        // We only write the innermost frame into "resolved_address_to_error_count", so we get the
-        // sum of all samples with unwinding errors by computing the sum of errors per function.
-        thread_sample_data->unwinding_errors_count += function.unwind_errors;
-        function.unwind_errors_percent = 100.f * it->second / thread_sample_data->samples_count;
-      }
-      function.absolute_address = absolute_address;
-      function.module_path =
-          orbit_client_data::GetModulePathByAddress(module_manager, capture_data, absolute_address);
+    if (auto it = thread_sample_data->resolved_address_to_exclusive_count.find(absolute_address);
+        it != thread_sample_data->resolved_address_to_exclusive_count.end()) {
+      function.exclusive = it->second;
+      function.exclusive_percent = 100.f * it->second / thread_sample_data->samples_count;
+    }
 
-      sampled_functions->push_back(function);
+    function.unwind_errors = 0;
+    function.unwind_errors_percent = 0.f;
+    if (auto it = thread_sample_data->resolved_address_to_error_count.find(absolute_address);
+        it != thread_sample_data->resolved_address_to_error_count.end()) {
+      function.unwind_errors = it->second;
+      // We only write the innermost frame into "resolved_address_to_error_count", so we get the
+      // sum of all samples with unwinding errors by computing the sum of errors per function.
+      thread_sample_data->unwinding_errors_count += function.unwind_errors;
+      function.unwind_errors_percent = 100.f * it->second / thread_sample_data->samples_count;
     }
+    function.absolute_address = absolute_address;
+    function.module_path =
+        orbit_client_data::GetModulePathByAddress(module_manager, capture_data, absolute_address);
+
+    sampled_functions->push_back(function);
   }
 }
 
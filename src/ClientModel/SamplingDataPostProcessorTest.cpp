@@ -1690,4 +1690,59 @@ TEST_F(SamplingDataPostProcessorTest, TwoThreadsWithMixedCallstackTypes) {
   VerifyEmptySortedCallstackReport(kThreadIdNotSampled);
 }
 
+TEST_F(SamplingDataPostProcessorTest, RunsAgainWithCachedFunctionAddresses) {
+  AddAllCallstackInfos(CallstackType::kComplete);
+  AddAllAddressInfos();
+
+  AddCallstackEventsInThreadId1And2();
+
+  SetPostProcessedSamplingData();
+  const size_t cached_function_addresses_count = capture_data_.GetFunctionAddressCache().size();
+  EXPECT_GT(cached_function_addresses_count, 0);
+
+  SetPostProcessedSamplingData();
+  EXPECT_EQ(capture_data_.GetFunctionAddressCache().size(), cached_function_addresses_count);
+
+  VerifyAllCallstackInfos(CallstackType::kComplete);
+
+  ASSERT_NE(ppsd_.GetSummary(), nullptr);
+  ASSERT_NE(ppsd_.GetThreadSampleDataByThreadId(kThreadId1), nullptr);
+  ASSERT_NE(ppsd_.GetThreadSampleDataByThreadId(kThreadId2), nullptr);
+  VerifySummaryThreadSampleDataForCallstackEventsInThreadId1And2(*ppsd_.GetSummary(),
+                                                                 orbit_base::kAllProcessThreadsTid);
+  VerifyThreadSampleDataForCallstackEventsInThreadId1(
+      *ppsd_.GetThreadSampleDataByThreadId(kThreadId1));
+  VerifyThreadSampleDataForCallstackEventsInThreadId2(
+      *ppsd_.GetThreadSampleDataByThreadId(kThreadId2));
+
+  VerifyGetCountOfFunction();
+}
+
+TEST_F(SamplingDataPostProcessorTest, ResolvesAddressesWhoseAddressInfosAreAddedLater) {
+  AddAllCallstackInfos(CallstackType::kComplete);
+  AddCallstackEventsInThreadId1And2();
+
+  // E.g., a selection during a live capture, before the address infos have arrived.
+  SetPostProcessedSamplingData();
+  EXPECT_EQ(capture_data_.GetFunctionAddressCache().size(), 0);
+
+  AddAllAddressInfos();
+  SetPostProcessedSamplingData();
+  EXPECT_GT(capture_data_.GetFunctionAddressCache().size(), 0);
+
+  VerifyAllCallstackInfos(CallstackType::kComplete);
+
+  ASSERT_NE(ppsd_.GetSummary(), nullptr);
+  ASSERT_NE(ppsd_.GetThreadSampleDataByThreadId(kThreadId1), nullptr);
+  ASSERT_NE(ppsd_.GetThreadSampleDataByThreadId(kThreadId2), nullptr);
+  VerifySummaryThreadSampleDataForCallstackEventsInThreadId1And2(*ppsd_.GetSummary(),
+                                                                 orbit_base::kAllProcessThreadsTid);
+  VerifyThreadSampleDataForCallstackEventsInThreadId1(
+      *ppsd_.GetThreadSampleDataByThreadId(kThreadId1));
+  VerifyThreadSampleDataForCallstackEventsInThreadId2(
+      *ppsd_.GetThreadSampleDataByThreadId(kThreadId2));
+
+  VerifyGetCountOfFunction();
+}
+
 }  // namespace orbit_client_model
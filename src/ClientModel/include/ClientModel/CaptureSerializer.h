@@ -17,7 +17,6 @@
 #include <string_view>
 
 #include "ClientData/CaptureData.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitBase/File.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Result.h"
@@ -17,7 +17,6 @@
 
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/PostProcessedSamplingData.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "CodeReport/CodeReport.h"
 #include "ObjectUtils/ElfFile.h"
 
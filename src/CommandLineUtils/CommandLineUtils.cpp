@@ -38,7 +38,9 @@ QStringList RemoveFlagsNotPassedToMainWindow(const QStringList& flags) {
       absl::GetFlagReflectionHandle(FLAGS_ssh_user).Name(),
       absl::GetFlagReflectionHandle(FLAGS_ssh_known_host_path).Name(),
       absl::GetFlagReflectionHandle(FLAGS_ssh_key_path).Name(),
-      absl::GetFlagReflectionHandle(FLAGS_ssh_target_process).Name()};
+      absl::GetFlagReflectionHandle(FLAGS_ssh_target_process).Name(),
+      absl::GetFlagReflectionHandle(FLAGS_load_capture_start_ms).Name(),
+      absl::GetFlagReflectionHandle(FLAGS_load_capture_end_ms).Name()};
 
   for (const auto& flag : flags) {
     bool ignore_this_flag = false;
@@ -22,7 +22,9 @@ TEST(CommandLineUtils, RemoveFlagsNotPassedToMainWindow) {
                      "--ssh_port=300",
                      "--ssh_user=username",
                      "--ssh_known_host_path=path_placeholder",
-                     "--ssh_key_path=another_path"};
+                     "--ssh_key_path=another_path",
+                     "--load_capture_start_ms=1000",
+                     "--load_capture_end_ms=2000"};
   QStringList expected{"--some_bool", "-b", "--some_flag"};
   QStringList result = RemoveFlagsNotPassedToMainWindow(params);
   EXPECT_EQ(expected, result);
@@ -16,6 +16,7 @@
 #include <filesystem>
 #include <functional>
 #include <optional>
+#include <string_view>
 
 #include "ApiInterface/Orbit.h"
 #include "ClientData/CaptureData.h"
@@ -219,18 +220,15 @@ void FunctionsDataView::DoFilter() {
     task_group.AddTask([&chunk = chunks[i], &result = task_results[i], this]() {
       ORBIT_SCOPE("FunctionsDataView::DoFilter Task");
       for (const FunctionInfo*& function : chunk) {
-        ORBIT_CHECK(function != nullptr);
-        std::string name = absl::AsciiStrToLower(function->pretty_name());
-        std::string module = absl::AsciiStrToLower(
-            std::filesystem::path(function->module_path()).filename().string());
+        size_t function_index = &function - functions_.data();
+        ORBIT_CHECK(function_index < functions_.size());
+        std::string_view search_entry = GetSearchEntry(function_index);
 
-        const auto is_token_found = [&name, &module](std::string_view token) {
-          return name.find(token) != std::string::npos || module.find(token) != std::string::npos;
+        const auto is_token_found = [search_entry](std::string_view token) {
+          return search_entry.find(token) != std::string_view::npos;
         };
 
         if (std::all_of(filter_tokens_.begin(), filter_tokens_.end(), is_token_found)) {
-          size_t function_index = &function - functions_.data();
-          ORBIT_CHECK(function_index < functions_.size());
           result.push_back(function_index);
         }
       }
@@ -248,6 +246,10 @@ void FunctionsDataView::AddFunctions(
     std::vector<const orbit_client_data::FunctionInfo*> functions) {
   ORBIT_SCOPE_FUNCTION;
   functions_.insert(functions_.end(), functions.begin(), functions.end());
+  for (const FunctionInfo* function : functions) {
+    ORBIT_CHECK(function != nullptr);
+    AppendSearchEntry(*function);
+  }
 }
 
 void FunctionsDataView::RemoveFunctionsOfModule(std::string_view module_path) {
@@ -257,12 +259,38 @@ void FunctionsDataView::RemoveFunctionsOfModule(std::string_view module_path) {
                                     return function_info->module_path() == module_path;
                                   }),
                    functions_.end());
+
+  // The remaining entries are rebuilt, as they need to stay parallel to `functions_`.
+  search_entries_.clear();
+  search_entry_ends_.clear();
+  for (const FunctionInfo* function : functions_) {
+    AppendSearchEntry(*function);
+  }
 }
 
 void FunctionsDataView::ClearFunctions() {
   ORBIT_SCOPE_FUNCTION;
   functions_.clear();
+  search_entries_.clear();
+  search_entry_ends_.clear();
   OnDataChanged();
 }
 
+void FunctionsDataView::AppendSearchEntry(const FunctionInfo& function) {
+  // Filter tokens are split at spaces and come from a single-line text field, so they can't contain
+  // the null separator, and a token can never match across the function name and the module name.
+  search_entries_.append(absl::AsciiStrToLower(function.pretty_name()));
+  search_entries_.push_back('\0');
+  search_entries_.append(absl::AsciiStrToLower(
+      std::filesystem::path(function.module_path()).filename().string()));
+  search_entry_ends_.push_back(search_entries_.size());
+}
+
+std::string_view FunctionsDataView::GetSearchEntry(size_t function_index) const {
+  ORBIT_CHECK(function_index < search_entry_ends_.size());
+  const size_t begin = function_index == 0 ? 0 : search_entry_ends_[function_index - 1];
+  const size_t end = search_entry_ends_[function_index];
+  return std::string_view{search_entries_}.substr(begin, end - begin);
+}
+
 }  // namespace orbit_data_views
@@ -800,3 +800,48 @@ TEST_F(FunctionsDataViewTest, FilteringByFunctionAndModuleName) {
   view_.OnFilter("ffindCapitalizedModule");
   EXPECT_EQ(view_.GetNumElements(), 0);
 }
+
+TEST_F(FunctionsDataViewTest, FilteringAfterRemovingFunctionsOfModule) {
+  // This functionality is not tested in this test case.
+  EXPECT_CALL(app_, IsFunctionSelected(testing::A<const FunctionInfo&>()))
+      .Times(testing::AnyNumber())
+      .WillRepeatedly(testing::Return(false));
+
+  // This functionality is not tested in this test case.
+  EXPECT_CALL(app_, IsFrameTrackEnabled)
+      .Times(testing::AnyNumber())
+      .WillRepeatedly(testing::Return(false));
+
+  // This functionality is not tested in this test case.
+  EXPECT_CALL(app_, HasCaptureData)
+      .Times(testing::AnyNumber())
+      .WillRepeatedly(testing::Return(false));
+
+  view_.AddFunctions(
+      {&functions_[0], &functions_[1], &functions_[2], &functions_[3], &functions_[4]});
+  view_.OnDataChanged();
+
+  view_.OnFilter("module");
+  EXPECT_EQ(view_.GetNumElements(), 4);
+
+  view_.RemoveFunctionsOfModule(functions_[2].module_path());
+  view_.OnDataChanged();
+
+  view_.OnFilter("module");
+  EXPECT_EQ(view_.GetNumElements(), 3);
+
+  view_.OnFilter("ffind");
+  EXPECT_EQ(view_.GetNumElements(), 1);
+  EXPECT_EQ(view_.GetValue(0, 1), functions_[3].pretty_name());
+
+  view_.OnFilter("bar uppercase");
+  EXPECT_EQ(view_.GetNumElements(), 1);
+  EXPECT_EQ(view_.GetValue(0, 1), functions_[4].pretty_name());
+
+  view_.ClearFunctions();
+  view_.AddFunctions({&functions_[1]});
+  view_.OnDataChanged();
+  view_.OnFilter("main other");
+  EXPECT_EQ(view_.GetNumElements(), 1);
+  EXPECT_EQ(view_.GetValue(0, 1), functions_[1].pretty_name());
+}
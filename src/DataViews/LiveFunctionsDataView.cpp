@@ -33,7 +33,7 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeInfo.h"
 #include "ClientData/ScopeStats.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DataViews/CompareAscendingOrDescending.h"
 #include "DataViews/DataView.h"
 #include "DataViews/DataViewType.h"
@@ -53,7 +53,7 @@ using orbit_client_data::ModuleManager;
 using orbit_client_data::ScopeId;
 using orbit_client_data::ScopeStats;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_grpc_protos::InstrumentedFunction;
 
@@ -79,6 +79,9 @@ const std::vector<DataView::Column>& LiveFunctionsDataView::GetColumns() {
     columns[kColumnTimeMin] = {"Min", .075f, SortingOrder::kDescending};
     columns[kColumnTimeMax] = {"Max", .075f, SortingOrder::kDescending};
     columns[kColumnStdDev] = {"Std Dev", .075f, SortingOrder::kDescending};
+    columns[kColumnP50] = {"P50", .075f, SortingOrder::kDescending};
+    columns[kColumnP95] = {"P95", .075f, SortingOrder::kDescending};
+    columns[kColumnP99] = {"P99", .075f, SortingOrder::kDescending};
     columns[kColumnModule] = {"Module", .1f, SortingOrder::kAscending};
     columns[kColumnAddress] = {"Address", .1f, SortingOrder::kAscending};
     return columns;
@@ -100,6 +103,19 @@ const std::vector<DataView::Column>& LiveFunctionsDataView::GetColumns() {
   }
 }
 
+std::optional<double> LiveFunctionsDataView::GetQuantileOfColumn(int column) {
+  switch (column) {
+    case kColumnP50:
+      return 0.5;
+    case kColumnP95:
+      return 0.95;
+    case kColumnP99:
+      return 0.99;
+    default:
+      return std::nullopt;
+  }
+}
+
 std::string LiveFunctionsDataView::GetValue(int row, int column) {
   if (!app_->HasCaptureData()) {
     return "";
@@ -137,6 +153,14 @@ std::string LiveFunctionsDataView::GetValue(int row, int column) {
       return orbit_display_formats::GetDisplayTime(absl::Nanoseconds(stats.max_ns()));
     case kColumnStdDev:
       return orbit_display_formats::GetDisplayTime(absl::Nanoseconds(stats.ComputeStdDevNs()));
+    case kColumnP50:
+    case kColumnP95:
+    case kColumnP99: {
+      const std::optional<uint64_t> quantile_ns = scope_stats_collection_->GetDurationQuantileNs(
+          scope_id, GetQuantileOfColumn(column).value());
+      if (!quantile_ns.has_value()) return "";
+      return orbit_display_formats::GetDisplayTime(absl::Nanoseconds(quantile_ns.value()));
+    }
     case kColumnModule:
       return function == nullptr
                  ? ""
@@ -259,6 +283,17 @@ void LiveFunctionsDataView::DoSort() {
     case kColumnStdDev:
       sorter = ORBIT_STAT_SORT(ComputeStdDevNs());
       break;
+    case kColumnP50:
+    case kColumnP95:
+    case kColumnP99: {
+      const double quantile = GetQuantileOfColumn(sorting_column_).value();
+      sorter = MakeSorter(
+          [this, quantile](ScopeId id) {
+            return scope_stats_collection_->GetDurationQuantileNs(id, quantile).value_or(0);
+          },
+          ascending);
+      break;
+    }
     case kColumnModule: {
       sorter = MakeFunctionSorter(
           [](const FunctionInfo& function_info) {
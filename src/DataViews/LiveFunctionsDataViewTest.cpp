@@ -38,7 +38,7 @@
 #include "ClientData/ScopeStats.h"
 #include "ClientData/ThreadTrackDataProvider.h"
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DataViewTestUtils.h"
 #include "DataViews/AppInterface.h"
 #include "DataViews/DataView.h"
@@ -61,7 +61,7 @@ using orbit_client_data::MockScopeStatsCollection;
 using orbit_client_data::ScopeId;
 using orbit_client_data::ScopeStats;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_data_views::CheckCopySelectionIsInvoked;
 using orbit_data_views::CheckExportToCsvIsInvoked;
@@ -119,6 +119,9 @@ constexpr std::array<uint64_t, kNumFunctions> kAvgTimeNs{3000, 10000, 0};
 constexpr std::array<uint64_t, kNumFunctions> kMinNs{2000, 3000, 0};
 constexpr std::array<uint64_t, kNumFunctions> kMaxNs{4000, 12000, 0};
 constexpr std::array<uint64_t, kNumFunctions> kStdDevNs{1000, 6000, 0};
+constexpr std::array<std::optional<uint64_t>, kNumFunctions> kP50Ns{2900, 9500, std::nullopt};
+constexpr std::array<std::optional<uint64_t>, kNumFunctions> kP95Ns{3800, 11500, std::nullopt};
+constexpr std::array<std::optional<uint64_t>, kNumFunctions> kP99Ns{3950, 11900, std::nullopt};
 
 constexpr int kColumnSelected = 0;
 constexpr int kColumnName = 1;
@@ -128,9 +131,12 @@ constexpr int kColumnTimeAvg = 4;
 constexpr int kColumnTimeMin = 5;
 constexpr int kColumnTimeMax = 6;
 constexpr int kColumnStdDev = 7;
-constexpr int kColumnModule = 8;
-constexpr int kColumnAddress = 9;
-constexpr int kNumColumns = 10;
+constexpr int kColumnP50 = 8;
+constexpr int kColumnP95 = 9;
+constexpr int kColumnP99 = 10;
+constexpr int kColumnModule = 11;
+constexpr int kColumnAddress = 12;
+constexpr int kNumColumns = 13;
 
 constexpr size_t kNumThreads = 2;
 constexpr std::array<uint32_t, kNumThreads> kThreadIds = {111, 222};
@@ -292,6 +298,12 @@ class LiveFunctionsDataViewTest : public testing::Test {
     for (size_t index : index_set) {
       EXPECT_CALL(*scope_stats_collection, GetScopeStatsOrDefault(kScopeIds[index]))
           .WillRepeatedly(ReturnRef(kScopeStats[index]));
+      EXPECT_CALL(*scope_stats_collection, GetDurationQuantileNs(kScopeIds[index], 0.5))
+          .WillRepeatedly(Return(kP50Ns[index]));
+      EXPECT_CALL(*scope_stats_collection, GetDurationQuantileNs(kScopeIds[index], 0.95))
+          .WillRepeatedly(Return(kP95Ns[index]));
+      EXPECT_CALL(*scope_stats_collection, GetDurationQuantileNs(kScopeIds[index], 0.99))
+          .WillRepeatedly(Return(kP99Ns[index]));
     }
     EXPECT_CALL(*scope_stats_collection, GetSortedTimerDurationsForScopeId(kScopeIds[0]))
         .WillRepeatedly(Return(&kDurations));
@@ -337,6 +349,17 @@ TEST_F(LiveFunctionsDataViewTest, ColumnValuesAreCorrect) {
   EXPECT_EQ(view_.GetValue(0, kColumnTimeMin), GetExpectedDisplayTime(kMinNs[0]));
   EXPECT_EQ(view_.GetValue(0, kColumnTimeMax), GetExpectedDisplayTime(kMaxNs[0]));
   EXPECT_EQ(view_.GetValue(0, kColumnStdDev), GetExpectedDisplayTime(kStdDevNs[0]));
+  EXPECT_EQ(view_.GetValue(0, kColumnP50), GetExpectedDisplayTime(kP50Ns[0].value()));
+  EXPECT_EQ(view_.GetValue(0, kColumnP95), GetExpectedDisplayTime(kP95Ns[0].value()));
+  EXPECT_EQ(view_.GetValue(0, kColumnP99), GetExpectedDisplayTime(kP99Ns[0].value()));
+}
+
+TEST_F(LiveFunctionsDataViewTest, QuantileColumnsAreEmptyWhenUnknown) {
+  AddFunctionsByIndices({2});
+
+  EXPECT_EQ(view_.GetValue(0, kColumnP50), "");
+  EXPECT_EQ(view_.GetValue(0, kColumnP95), "");
+  EXPECT_EQ(view_.GetValue(0, kColumnP99), "");
 }
 
 TEST_F(LiveFunctionsDataViewTest, ColumnSelectedShowsRightResults) {
@@ -515,13 +538,14 @@ TEST_F(LiveFunctionsDataViewTest, ContextMenuActionsAreInvoked) {
   // Copy Selection
   {
     std::string expected_clipboard = absl::StrFormat(
-        "Type\tName\tCount\tTotal\tAvg\tMin\tMax\tStd Dev\tModule\tAddress\n"
-        "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
+        "Type\tName\tCount\tTotal\tAvg\tMin\tMax\tStd Dev\tP50\tP95\tP99\tModule\tAddress\n"
+        "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\n",
         orbit_data_views::FunctionsDataView::kDynamicallyInstrumentedFunctionTypeString,
         kPrettyNames[0], GetExpectedDisplayCount(kCounts[0]),
         GetExpectedDisplayTime(kTotalTimeNs[0]), GetExpectedDisplayTime(kAvgTimeNs[0]),
         GetExpectedDisplayTime(kMinNs[0]), GetExpectedDisplayTime(kMaxNs[0]),
-        GetExpectedDisplayTime(kStdDevNs[0]),
+        GetExpectedDisplayTime(kStdDevNs[0]), GetExpectedDisplayTime(kP50Ns[0].value()),
+        GetExpectedDisplayTime(kP95Ns[0].value()), GetExpectedDisplayTime(kP99Ns[0].value()),
         std::filesystem::path(kModulePaths[0]).filename().string(),
         GetExpectedDisplayAddress(kAddresses[0]));
     CheckCopySelectionIsInvoked(context_menu, app_, view_, expected_clipboard);
@@ -530,15 +554,17 @@ TEST_F(LiveFunctionsDataViewTest, ContextMenuActionsAreInvoked) {
   // Export to CSV
   {
     std::string expected_contents = absl::StrFormat(
-        R"("Type","Name","Count","Total","Avg","Min","Max","Std Dev","Module","Address")"
+        R"("Type","Name","Count","Total","Avg","Min","Max","Std Dev","P50","P95","P99","Module",)"
+        R"("Address")"
         "\r\n"
-        R"("%s","%s","%s","%s","%s","%s","%s","%s","%s","%s")"
+        R"("%s","%s","%s","%s","%s","%s","%s","%s","%s","%s","%s","%s","%s")"
         "\r\n",
         orbit_data_views::FunctionsDataView::kDynamicallyInstrumentedFunctionTypeString,
         kPrettyNames[0], GetExpectedDisplayCount(kCounts[0]),
         GetExpectedDisplayTime(kTotalTimeNs[0]), GetExpectedDisplayTime(kAvgTimeNs[0]),
         GetExpectedDisplayTime(kMinNs[0]), GetExpectedDisplayTime(kMaxNs[0]),
-        GetExpectedDisplayTime(kStdDevNs[0]),
+        GetExpectedDisplayTime(kStdDevNs[0]), GetExpectedDisplayTime(kP50Ns[0].value()),
+        GetExpectedDisplayTime(kP95Ns[0].value()), GetExpectedDisplayTime(kP99Ns[0].value()),
         std::filesystem::path(kModulePaths[0]).filename().string(),
         GetExpectedDisplayAddress(kAddresses[0]));
     CheckExportToCsvIsInvoked(context_menu, app_, view_, expected_contents);
@@ -806,6 +832,8 @@ TEST_F(LiveFunctionsDataViewTest, ColumnSortingShowsRightResults) {
   absl::flat_hash_map<std::string, uint64_t> string_to_raw_value;
   for (const auto& [function_id, function] : functions_) {
     const ScopeStats& stats = capture_data_->GetScopeStatsOrDefault(function_id);
+    const auto function_index = static_cast<size_t>(
+        std::distance(kScopeIds.begin(), absl::c_find(kScopeIds, function_id)));
 
     ViewRowEntry entry;
     entry[kColumnName] = function.pretty_name();
@@ -823,6 +851,13 @@ TEST_F(LiveFunctionsDataViewTest, ColumnSortingShowsRightResults) {
     string_to_raw_value.insert_or_assign(entry[kColumnTimeMax], stats.max_ns());
     entry[kColumnStdDev] = GetExpectedDisplayTime(stats.ComputeStdDevNs());
     string_to_raw_value.insert_or_assign(entry[kColumnStdDev], stats.ComputeStdDevNs());
+    for (const auto& [column, quantile_ns] :
+         {std::make_pair(kColumnP50, kP50Ns[function_index]),
+          std::make_pair(kColumnP95, kP95Ns[function_index]),
+          std::make_pair(kColumnP99, kP99Ns[function_index])}) {
+      entry[column] = quantile_ns.has_value() ? GetExpectedDisplayTime(quantile_ns.value()) : "";
+      string_to_raw_value.insert_or_assign(entry[column], quantile_ns.value_or(0));
+    }
 
     view_entries.push_back(entry);
   }
@@ -853,6 +888,9 @@ TEST_F(LiveFunctionsDataViewTest, ColumnSortingShowsRightResults) {
       case kColumnTimeMin:
       case kColumnTimeMax:
       case kColumnStdDev:
+      case kColumnP50:
+      case kColumnP95:
+      case kColumnP99:
         // Columns of count and time statistics are sorted by raw values (i.e., uint64_t).
         std::sort(
             view_entries.begin(), view_entries.end(),
@@ -17,7 +17,7 @@
 #include "ClientData/ModuleIdentifier.h"
 #include "ClientData/ProcessData.h"
 #include "ClientData/ScopeId.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DataViews/AppInterface.h"
 #include "DataViews/PresetLoadState.h"
 #include "DataViews/SymbolLoadingState.h"
@@ -114,8 +114,7 @@ class MockAppInterface : public AppInterface {
                std::optional<ScopeId> scope_id),
               (override));
 
-  MOCK_METHOD(uint64_t, ProvideScopeId, (const orbit_client_protos::TimerInfo& timer_info),
-              (const));
+  MOCK_METHOD(uint64_t, ProvideScopeId, (const orbit_client_data::TimerInfo& timer_info), (const));
 
   MOCK_METHOD(bool, IsModuleDownloading, (const orbit_client_data::ModuleData* module),
               (const, override));
@@ -19,7 +19,6 @@
 #include "ClientData/ModulePathAndBuildId.h"
 #include "ClientData/PostProcessedSamplingData.h"
 #include "ClientData/ProcessData.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "DataViews/PresetLoadState.h"
 #include "DataViews/SymbolLoadingState.h"
 #include "GrpcProtos/tracepoint.pb.h"
@@ -20,7 +20,6 @@
 #include "ClientData/CallstackInfo.h"
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ModuleData.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "DataViews/AppInterface.h"
 #include "DataViews/DataView.h"
 
@@ -7,6 +7,7 @@
 
 #include <absl/types/span.h>
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -66,7 +67,18 @@ class FunctionsDataView : public DataView {
     return functions_[indices_[row]];
   }
 
+  // Appends the lowercase function name and module file name of `function`, which is matched
+  // against the filter tokens, to `search_entries_`.
+  void AppendSearchEntry(const orbit_client_data::FunctionInfo& function);
+  [[nodiscard]] std::string_view GetSearchEntry(size_t function_index) const;
+
   std::vector<const orbit_client_data::FunctionInfo*> functions_;
+
+  // The search entries of all functions in `functions_`, in the same order and stored contiguously,
+  // so that filtering neither allocates nor lowercases strings on each keystroke.
+  // `search_entry_ends_[i]` is the end offset of the entry of `functions_[i]` in `search_entries_`.
+  std::string search_entries_;
+  std::vector<size_t> search_entry_ends_;
 };
 
 }  // namespace orbit_data_views
@@ -104,6 +104,9 @@ class LiveFunctionsDataView : public DataView {
     kColumnTimeMin,
     kColumnTimeMax,
     kColumnStdDev,
+    kColumnP50,
+    kColumnP95,
+    kColumnP99,
     kColumnModule,
     kColumnAddress,
     kNumColumns
@@ -119,6 +122,9 @@ class LiveFunctionsDataView : public DataView {
 
   void UpdateHistogramWithIndices(absl::Span<const int> visible_selected_indices);
 
+  // The duration quantile shown in `column`, or std::nullopt if it's not a quantile column.
+  [[nodiscard]] static std::optional<double> GetQuantileOfColumn(int column);
+
   template <typename ValueGetterType>
   [[nodiscard]] std::function<bool(ScopeId, ScopeId)> MakeSorter(ValueGetterType getter,
                                                                  bool ascending) {
@@ -336,6 +336,16 @@ int main(int argc, char* argv[]) {
   ORBIT_LOG("unwinding_method=%s", options.unwinding_method == CaptureOptions::kFramePointers
                                        ? "Frame pointers"
                                        : "DWARF");
+  options.dwarf_unwinding_thread_count = absl::GetFlag(FLAGS_unwinding_threads);
+  ORBIT_LOG("dwarf_unwinding_thread_count=%u", options.dwarf_unwinding_thread_count);
+  options.event_driven_ring_buffer_reading = absl::GetFlag(FLAGS_event_driven_ring_buffers);
+  ORBIT_LOG("event_driven_ring_buffer_reading=%d", options.event_driven_ring_buffer_reading);
+  options.ring_buffer_reader_thread_count = absl::GetFlag(FLAGS_ring_buffer_reader_threads);
+  ORBIT_LOG("ring_buffer_reader_thread_count=%u", options.ring_buffer_reader_thread_count);
+  options.compress_capture_responses = absl::GetFlag(FLAGS_compress_capture_responses);
+  ORBIT_LOG("compress_capture_responses=%d", options.compress_capture_responses);
+  options.intern_callstacks = absl::GetFlag(FLAGS_intern_callstacks);
+  ORBIT_LOG("intern_callstacks=%d", options.intern_callstacks);
 
   std::string file_path = absl::GetFlag(FLAGS_instrument_path);
   uint64_t file_offset = absl::GetFlag(FLAGS_instrument_offset);
@@ -42,6 +42,16 @@ ABSL_FLAG(uint32_t, duration, std::numeric_limits<uint32_t>::max(),
 ABSL_FLAG(uint16_t, sampling_rate, 1000,
           "Callstack sampling rate in samples per second (0: no sampling)");
 ABSL_FLAG(bool, frame_pointers, false, "Use frame pointers for unwinding");
+ABSL_FLAG(uint32_t, unwinding_threads, 0,
+          "Number of threads to perform DWARF unwinding on (0: unwind on the processing thread)");
+ABSL_FLAG(bool, event_driven_ring_buffers, false,
+          "Wait for the perf_event_open ring buffers with epoll instead of polling them");
+ABSL_FLAG(uint32_t, ring_buffer_reader_threads, 0,
+          "Number of threads to read the perf_event_open ring buffers on (0: a single thread)");
+ABSL_FLAG(bool, compress_capture_responses, false,
+          "Have the service compress the capture data it sends with gzip");
+ABSL_FLAG(bool, intern_callstacks, false,
+          "Have the service send each distinct callstack only once and refer to it by id");
 ABSL_FLAG(std::string, instrument_path, "", "Path of the binary of the function to instrument");
 ABSL_FLAG(std::string, instrument_name, "", "Name of the function to instrument");
 ABSL_FLAG(uint64_t, instrument_offset, 0, "Offset in the binary of the function to instrument");
@@ -36,12 +36,19 @@ namespace {
 inline int32_t RetrieveThreadId(const orbit_api::ApiScopeStart& scope_start) {
   return scope_start.meta_data.tid;
 }
+inline int32_t RetrieveThreadId(const orbit_api::ApiInternedScopeStart& /*interned_scope_start*/) {
+  ORBIT_UNREACHABLE();
+}
 inline int32_t RetrieveThreadId(const orbit_api::ApiScopeStop& scope_stop) {
   return scope_stop.meta_data.tid;
 }
 inline int32_t RetrieveThreadId(const orbit_api::ApiScopeStartAsync& /*scope_start_async*/) {
   ORBIT_UNREACHABLE();
 }
+inline int32_t RetrieveThreadId(
+    const orbit_api::ApiInternedScopeStartAsync& /*interned_scope_start_async*/) {
+  ORBIT_UNREACHABLE();
+}
 inline int32_t RetrieveThreadId(const orbit_api::ApiScopeStopAsync& /*scope_stop_async*/) {
   ORBIT_UNREACHABLE();
 }
@@ -5,29 +5,53 @@
 #include "LinuxCaptureService/LinuxCaptureService.h"
 
 #include <memory>
+#include <utility>
 
 #include "CaptureServiceBase/CaptureServiceBase.h"
 #include "CaptureServiceBase/GrpcStartStopCaptureRequestWaiter.h"
 #include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/Result.h"
 #include "OrbitBase/ThreadUtils.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
+#include "ProducerEventProcessor/ClientCaptureEventCollector.h"
 #include "ProducerEventProcessor/GrpcClientCaptureEventCollector.h"
 
 namespace orbit_linux_capture_service {
 
 grpc::Status LinuxCaptureService::Capture(
-    grpc::ServerContext* /*context*/,
+    grpc::ServerContext* context,
     grpc::ServerReaderWriter<orbit_grpc_protos::CaptureResponse, orbit_grpc_protos::CaptureRequest>*
         reader_writer) {
   orbit_base::SetCurrentThreadName("CSImpl::Capture");
 
-  orbit_producer_event_processor::GrpcClientCaptureEventCollector
-      grpc_client_capture_event_collector{reader_writer};
+  std::unique_ptr<orbit_producer_event_processor::ClientCaptureEventCollector>
+      client_capture_event_collector;
+  if (capture_file_options_.has_value()) {
+    ErrorMessageOr<
+        std::unique_ptr<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector>>
+        collector_or_error =
+            orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Create(
+                capture_file_options_.value());
+    if (collector_or_error.has_error()) {
+      ORBIT_ERROR("Creating capture directory: %s", collector_or_error.error().message());
+      return {grpc::StatusCode::INTERNAL, collector_or_error.error().message()};
+    }
+    client_capture_event_collector = std::move(collector_or_error.value());
+  } else {
+    client_capture_event_collector =
+        std::make_unique<orbit_producer_event_processor::GrpcClientCaptureEventCollector>(
+            reader_writer);
+  }
+
   CaptureServiceBase::CaptureInitializationResult initialization_result =
-      InitializeCapture(&grpc_client_capture_event_collector);
+      InitializeCapture(client_capture_event_collector.get());
   switch (initialization_result) {
     case CaptureInitializationResult::kSuccess:
       break;
     case CaptureInitializationResult::kAlreadyInProgress:
+      // The collector's thread has to be joined before the collector is destroyed.
+      client_capture_event_collector->StopAndWait();
       return {grpc::StatusCode::ALREADY_EXISTS,
               "Cannot start capture because another capture is already in progress"};
   }
@@ -37,6 +61,8 @@ grpc::Status LinuxCaptureService::Capture(
           reader_writer);
   const orbit_grpc_protos::CaptureOptions& capture_options =
       grpc_start_stop_capture_request_waiter->WaitForStartCaptureRequest();
+  orbit_producer_event_processor::GrpcClientCaptureEventCollector::SetUpCompression(
+      context, capture_options);
   DoCapture(capture_options, grpc_start_stop_capture_request_waiter);
 
   return grpc::Status::OK;
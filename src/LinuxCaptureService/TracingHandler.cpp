@@ -13,11 +13,13 @@
 
 namespace orbit_linux_capture_service {
 
+using orbit_grpc_protos::CallstackSample;
 using orbit_grpc_protos::CaptureOptions;
 using orbit_grpc_protos::FullAddressInfo;
 using orbit_grpc_protos::FullCallstackSample;
 using orbit_grpc_protos::FullGpuJob;
 using orbit_grpc_protos::FunctionCall;
+using orbit_grpc_protos::InternedCallstack;
 using orbit_grpc_protos::ProducerCaptureEvent;
 using orbit_grpc_protos::SchedulingSlice;
 using orbit_grpc_protos::ThreadName;
@@ -63,6 +65,18 @@ void TracingHandler::OnCallstackSample(FullCallstackSample callstack_sample) {
   producer_event_processor_->ProcessEvent(kLinuxTracingProducerId, std::move(event));
 }
 
+void TracingHandler::OnInternedCallstackSample(CallstackSample callstack_sample) {
+  ProducerCaptureEvent event;
+  *event.mutable_callstack_sample() = std::move(callstack_sample);
+  producer_event_processor_->ProcessEvent(kLinuxTracingProducerId, std::move(event));
+}
+
+void TracingHandler::OnInternedCallstack(InternedCallstack interned_callstack) {
+  ProducerCaptureEvent event;
+  *event.mutable_interned_callstack() = std::move(interned_callstack);
+  producer_event_processor_->ProcessEvent(kLinuxTracingProducerId, std::move(event));
+}
+
 void TracingHandler::OnFunctionCall(FunctionCall function_call) {
   ProducerCaptureEvent event;
   *event.mutable_function_call() = std::move(function_call);
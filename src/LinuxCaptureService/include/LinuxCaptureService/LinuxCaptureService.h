@@ -7,9 +7,13 @@
 
 #include <grpcpp/grpcpp.h>
 
+#include <optional>
+#include <utility>
+
 #include "GrpcProtos/services.grpc.pb.h"
 #include "GrpcProtos/services.pb.h"
 #include "LinuxCaptureService/LinuxCaptureServiceBase.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
 
 namespace orbit_linux_capture_service {
 
@@ -21,6 +25,18 @@ class LinuxCaptureService final : public LinuxCaptureServiceBase,
       grpc::ServerContext* context,
       grpc::ServerReaderWriter<orbit_grpc_protos::CaptureResponse,
                                orbit_grpc_protos::CaptureRequest>* reader_writer) override;
+
+  // When set, captures are written to capture files in a directory of the machine the service runs
+  // on, instead of being sent to the client. The client still starts and stops the capture.
+  void SetCaptureFileOptions(
+      std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+          capture_file_options) {
+    capture_file_options_ = std::move(capture_file_options);
+  }
+
+ private:
+  std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+      capture_file_options_;
 };
 
 }  // namespace orbit_linux_capture_service
@@ -0,0 +1,26 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_BENCHMARK_UTILS_H_
+#define LINUX_TRACING_BENCHMARK_UTILS_H_
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace orbit_linux_tracing {
+
+// Reports both the throughput ("items_per_second") and the cost of a single event ("ns_per_event")
+// of a benchmark that has processed `event_count` events over all its iterations.
+inline void SetEventCounters(benchmark::State& state, int64_t event_count) {
+  state.SetItemsProcessed(event_count);
+  // The rate is in events per nanosecond, which inverted gives nanoseconds per event.
+  state.counters["ns_per_event"] =
+      benchmark::Counter(static_cast<double>(event_count) * 1e-9,
+                         benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_BENCHMARK_UTILS_H_
@@ -0,0 +1,26 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "CallstackTrie.h"
+
+namespace orbit_linux_tracing {
+
+uint64_t CallstackTrie::GetOrInsertChild(uint64_t parent_node_id, uint64_t key) {
+  auto [it, inserted] =
+      children_.try_emplace(std::make_pair(parent_node_id, key), node_is_callstack_.size());
+  if (inserted) {
+    node_is_callstack_.push_back(false);
+  }
+  return it->second;
+}
+
+bool CallstackTrie::MarkAsCallstack(uint64_t node_id) {
+  ORBIT_CHECK(node_id != kRootNodeId);
+  ORBIT_CHECK(node_id < node_is_callstack_.size());
+  if (node_is_callstack_[node_id]) return false;
+  node_is_callstack_[node_id] = true;
+  return true;
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,105 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_CALLSTACK_TRIE_H_
+#define LINUX_TRACING_CALLSTACK_TRIE_H_
+
+#include <absl/container/flat_hash_map.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Logging.h"
+
+namespace orbit_linux_tracing {
+
+// Hash-conses callstacks into the nodes of a prefix trie, so that each distinct callstack (the
+// sequence of its pcs together with its type) gets a unique id, without the callstack ever being
+// copied into a container to be hashed as a whole.
+// The children of the root correspond to the callstack types, every other node to a frame. The
+// path from the root to a node goes from the outermost frame to the innermost one, so callstacks
+// that share their outermost frames share the nodes for those frames. The id of a callstack is the
+// id of the node of its innermost frame.
+// A Cursor remembers the path of the last callstack looked up through it. Consecutive callstacks
+// of the same thread usually only differ in their innermost frames, hence only the frames after
+// the common prefix need to be looked up in the trie. This class is not thread-safe.
+class CallstackTrie {
+ public:
+  struct Cursor {
+    uint64_t type_node_id = kRootNodeId;
+    std::vector<uint64_t> pcs_from_outermost;
+    std::vector<uint64_t> node_ids_from_outermost;
+  };
+
+  struct Result {
+    uint64_t callstack_id;
+    // Whether this is the first time this callstack was looked up, i.e., whether the callstack has
+    // to be sent along with its id.
+    bool is_new;
+  };
+
+  // Returns the id of the callstack of type `type` with `pc_count` frames. `get_pc(index)` returns
+  // the pcs from the innermost frame at index zero to the outermost one, i.e., in the order of
+  // Callstack::pcs. `cursor` can be nullptr.
+  template <typename GetPcT>
+  [[nodiscard]] Result GetOrInsert(orbit_grpc_protos::Callstack::CallstackType type,
+                                   size_t pc_count, GetPcT&& get_pc, Cursor* cursor);
+
+  // The number of nodes in the trie, not counting the root.
+  [[nodiscard]] size_t GetNodeCount() const { return node_is_callstack_.size() - 1; }
+
+ private:
+  static constexpr uint64_t kRootNodeId = 0;
+
+  [[nodiscard]] uint64_t GetOrInsertChild(uint64_t parent_node_id, uint64_t key);
+  [[nodiscard]] bool MarkAsCallstack(uint64_t node_id);
+
+  // <parent_node_id, pc> -> node_id. For the children of the root, the key is the callstack type.
+  absl::flat_hash_map<std::pair<uint64_t, uint64_t>, uint64_t> children_;
+  // Indexed by node id. Inner nodes only become callstacks when a callstack ends there.
+  std::vector<bool> node_is_callstack_{false};
+};
+
+template <typename GetPcT>
+CallstackTrie::Result CallstackTrie::GetOrInsert(orbit_grpc_protos::Callstack::CallstackType type,
+                                                 size_t pc_count, GetPcT&& get_pc,
+                                                 Cursor* cursor) {
+  ORBIT_CHECK(pc_count > 0);
+  const uint64_t type_node_id = GetOrInsertChild(kRootNodeId, static_cast<uint64_t>(type));
+
+  uint64_t node_id = type_node_id;
+  size_t depth = 0;
+  if (cursor != nullptr) {
+    if (cursor->type_node_id == type_node_id) {
+      const size_t max_depth = std::min(pc_count, cursor->pcs_from_outermost.size());
+      while (depth < max_depth &&
+             cursor->pcs_from_outermost[depth] == get_pc(pc_count - 1 - depth)) {
+        ++depth;
+      }
+      if (depth > 0) node_id = cursor->node_ids_from_outermost[depth - 1];
+    }
+    cursor->type_node_id = type_node_id;
+    cursor->pcs_from_outermost.resize(depth);
+    cursor->node_ids_from_outermost.resize(depth);
+  }
+
+  for (; depth < pc_count; ++depth) {
+    const uint64_t pc = get_pc(pc_count - 1 - depth);
+    node_id = GetOrInsertChild(node_id, pc);
+    if (cursor != nullptr) {
+      cursor->pcs_from_outermost.push_back(pc);
+      cursor->node_ids_from_outermost.push_back(node_id);
+    }
+  }
+
+  return {node_id, MarkAsCallstack(node_id)};
+}
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_CALLSTACK_TRIE_H_
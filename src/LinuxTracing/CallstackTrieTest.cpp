@@ -0,0 +1,106 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <tuple>
+#include <vector>
+
+#include "CallstackTrie.h"
+#include "GrpcProtos/capture.pb.h"
+
+using orbit_grpc_protos::Callstack;
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+[[nodiscard]] CallstackTrie::Result GetOrInsert(CallstackTrie* trie, Callstack::CallstackType type,
+                                                const std::vector<uint64_t>& pcs,
+                                                CallstackTrie::Cursor* cursor = nullptr) {
+  return trie->GetOrInsert(
+      type, pcs.size(), [&pcs](size_t index) { return pcs[index]; }, cursor);
+}
+
+}  // namespace
+
+TEST(CallstackTrie, SameCallstackGetsSameId) {
+  CallstackTrie trie;
+
+  CallstackTrie::Result first = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 3});
+  EXPECT_TRUE(first.is_new);
+
+  CallstackTrie::Result second = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 3});
+  EXPECT_FALSE(second.is_new);
+  EXPECT_EQ(second.callstack_id, first.callstack_id);
+}
+
+TEST(CallstackTrie, DifferentCallstacksGetDifferentIds) {
+  CallstackTrie trie;
+
+  CallstackTrie::Result callstack = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 3});
+  CallstackTrie::Result different_leaf = GetOrInsert(&trie, Callstack::kComplete, {4, 2, 3});
+  CallstackTrie::Result different_root = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 4});
+  CallstackTrie::Result different_type =
+      GetOrInsert(&trie, Callstack::kDwarfUnwindingError, {1, 2, 3});
+
+  EXPECT_TRUE(different_leaf.is_new);
+  EXPECT_TRUE(different_root.is_new);
+  EXPECT_TRUE(different_type.is_new);
+  EXPECT_NE(different_leaf.callstack_id, callstack.callstack_id);
+  EXPECT_NE(different_root.callstack_id, callstack.callstack_id);
+  EXPECT_NE(different_type.callstack_id, callstack.callstack_id);
+}
+
+TEST(CallstackTrie, PrefixOfCallstackIsNewWhenFirstSeen) {
+  CallstackTrie trie;
+
+  CallstackTrie::Result callstack = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 3});
+  EXPECT_TRUE(callstack.is_new);
+
+  // {2, 3} shares the node of its innermost frame with the inner node of {1, 2, 3} for frame 2,
+  // but it is a different callstack that hasn't been seen before.
+  CallstackTrie::Result outer_frames = GetOrInsert(&trie, Callstack::kComplete, {2, 3});
+  EXPECT_TRUE(outer_frames.is_new);
+  EXPECT_NE(outer_frames.callstack_id, callstack.callstack_id);
+
+  EXPECT_FALSE(GetOrInsert(&trie, Callstack::kComplete, {2, 3}).is_new);
+}
+
+TEST(CallstackTrie, CallstacksShareNodesOfOutermostFrames) {
+  CallstackTrie trie;
+
+  std::ignore = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 3});
+  // One node for the type, and one for each frame.
+  EXPECT_EQ(trie.GetNodeCount(), 4);
+
+  std::ignore = GetOrInsert(&trie, Callstack::kComplete, {4, 2, 3});
+  EXPECT_EQ(trie.GetNodeCount(), 5);
+
+  std::ignore = GetOrInsert(&trie, Callstack::kComplete, {1, 2, 5});
+  EXPECT_EQ(trie.GetNodeCount(), 8);
+}
+
+TEST(CallstackTrie, CursorGivesSameIdsAsLookupsWithoutCursor) {
+  CallstackTrie trie_with_cursor;
+  CallstackTrie::Cursor cursor;
+  CallstackTrie trie_without_cursor;
+
+  const std::vector<std::vector<uint64_t>> callstacks{
+      {1, 2, 3}, {4, 2, 3}, {1, 2, 3}, {5, 3}, {3}, {6, 7, 8, 9}, {1, 2, 3}, {6, 7, 8, 9},
+  };
+  for (const std::vector<uint64_t>& pcs : callstacks) {
+    for (Callstack::CallstackType type : {Callstack::kComplete, Callstack::kInUprobes}) {
+      CallstackTrie::Result result_with_cursor = GetOrInsert(&trie_with_cursor, type, pcs, &cursor);
+      CallstackTrie::Result result_without_cursor = GetOrInsert(&trie_without_cursor, type, pcs);
+      EXPECT_EQ(result_with_cursor.callstack_id, result_without_cursor.callstack_id);
+      EXPECT_EQ(result_with_cursor.is_new, result_without_cursor.is_new);
+    }
+  }
+  EXPECT_EQ(trie_with_cursor.GetNodeCount(), trie_without_cursor.GetNodeCount());
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,97 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <asm/perf_regs.h>
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "LibunwindstackMaps.h"
+#include "LibunwindstackMultipleOfflineAndProcessMemory.h"
+#include "LibunwindstackUnwinder.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/ReadFileToString.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+// The registers and the stack of this process at some point, like in a stack sample.
+struct StackSample {
+  std::array<uint64_t, PERF_REG_X86_64_MAX> perf_regs{};
+  uint64_t stack_start_address = 0;
+  std::vector<uint8_t> stack_data;
+};
+
+// Copies the stack between the current stack pointer and `stack_end_address`.
+[[gnu::noinline]] void TakeStackSample(uint64_t stack_end_address, StackSample* sample) {
+  uint64_t rsp;
+  uint64_t rbp;
+  uint64_t rip;
+  asm volatile(
+      "movq %%rsp, %0\n\t"
+      "movq %%rbp, %1\n\t"
+      "leaq (%%rip), %2"
+      : "=r"(rsp), "=r"(rbp), "=r"(rip));
+  sample->perf_regs[PERF_REG_X86_SP] = rsp;
+  sample->perf_regs[PERF_REG_X86_BP] = rbp;
+  sample->perf_regs[PERF_REG_X86_IP] = rip;
+  sample->stack_start_address = rsp;
+  sample->stack_data.assign(reinterpret_cast<const uint8_t*>(rsp),
+                            reinterpret_cast<const uint8_t*>(stack_end_address));
+}
+
+[[gnu::noinline]] void RecurseAndTakeStackSample(int depth, uint64_t stack_end_address,
+                                                 StackSample* sample) {
+  if (depth == 0) {
+    TakeStackSample(stack_end_address, sample);
+  } else {
+    RecurseAndTakeStackSample(depth - 1, stack_end_address, sample);
+  }
+  // Prevent the recursive call from becoming a tail call, which would remove the frame.
+  benchmark::DoNotOptimize(depth);
+}
+
+// Measures DWARF-unwinding a sample of this process' own stack with `state.range(0)` frames
+// between the sampled function and this function, using only the copy of the stack.
+void BM_LibunwindstackUnwinderUnwind(benchmark::State& state) {
+  const auto depth = static_cast<int>(state.range(0));
+
+  ErrorMessageOr<std::string> maps_buffer = orbit_base::ReadFileToString("/proc/self/maps");
+  ORBIT_CHECK(maps_buffer.has_value());
+  std::unique_ptr<LibunwindstackMaps> maps = LibunwindstackMaps::ParseMaps(maps_buffer.value());
+  ORBIT_CHECK(maps != nullptr);
+
+  StackSample sample;
+  RecurseAndTakeStackSample(depth, reinterpret_cast<uint64_t>(__builtin_frame_address(0)),
+                            &sample);
+  const std::vector<StackSliceView> stack_slices{StackSliceView{
+      sample.stack_start_address, sample.stack_data.size(), sample.stack_data.data()}};
+
+  std::unique_ptr<LibunwindstackUnwinder> unwinder = LibunwindstackUnwinder::Create();
+  const pid_t pid = getpid();
+  size_t frame_count = 0;
+  for (auto _ : state) {
+    LibunwindstackResult result = unwinder->Unwind(pid, maps->Get(), sample.perf_regs,
+                                                   stack_slices, /*offline_memory_only=*/true);
+    frame_count = result.frames().size();
+    benchmark::DoNotOptimize(result);
+  }
+  ORBIT_CHECK(frame_count > static_cast<size_t>(depth));
+
+  SetEventCounters(state, state.iterations());
+  state.counters["frames"] = static_cast<double>(frame_count);
+}
+
+}  // namespace
+
+BENCHMARK(BM_LibunwindstackUnwinderUnwind)->Arg(8)->Arg(64);
+
+}  // namespace orbit_linux_tracing
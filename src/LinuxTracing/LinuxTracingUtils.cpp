@@ -167,6 +167,17 @@ std::vector<int> GetCpusetCpus(pid_t pid) {
   return ParseCpusetCpus(cpuset_cpus_content_or_error.value());
 }
 
+std::vector<std::vector<int32_t>> PartitionCpusIntoContiguousRanges(
+    absl::Span<const int32_t> cpus, size_t max_range_count) {
+  ORBIT_CHECK(std::is_sorted(cpus.begin(), cpus.end()));
+  const size_t range_count = std::min(max_range_count, cpus.size());
+  std::vector<std::vector<int32_t>> ranges(range_count);
+  for (size_t cpu_index = 0; cpu_index < cpus.size() && range_count > 0; ++cpu_index) {
+    ranges[cpu_index * range_count / cpus.size()].push_back(cpus[cpu_index]);
+  }
+  return ranges;
+}
+
 int GetTracepointId(const char* tracepoint_category, const char* tracepoint_name) {
   std::string filename = absl::StrFormat("/sys/kernel/debug/tracing/events/%s/%s/id",
                                          tracepoint_category, tracepoint_name);
@@ -35,6 +35,11 @@ std::vector<int> ParseCpusetCpus(std::string_view cpuset_cpus_content);
 
 std::vector<int> GetCpusetCpus(pid_t pid);
 
+// Splits the sorted `cpus` into at most `max_range_count` ranges of consecutive elements, whose
+// sizes differ by at most one. There are fewer ranges only if there are fewer cpus.
+[[nodiscard]] std::vector<std::vector<int32_t>> PartitionCpusIntoContiguousRanges(
+    absl::Span<const int32_t> cpus, size_t max_range_count);
+
 // Looks up the tracepoint id for the given category (example: "sched")
 // and name (example: "sched_waking"). Returns the tracepoint id or
 // -1 in case of any errors.
@@ -10,6 +10,7 @@
 #include <sys/syscall.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <chrono>
 #include <map>
 #include <optional>
@@ -130,6 +131,60 @@ TEST(ParseCpusetCpus, SingleValuesAndRanges) {
   EXPECT_THAT(returned_cpus, ::testing::ElementsAre(0, 1, 2, 4, 7, 12, 13, 14));
 }
 
+TEST(PartitionCpusIntoContiguousRanges, NoCpus) {
+  EXPECT_TRUE(PartitionCpusIntoContiguousRanges({}, 4).empty());
+}
+
+TEST(PartitionCpusIntoContiguousRanges, SingleRange) {
+  EXPECT_THAT(PartitionCpusIntoContiguousRanges({0, 1, 2, 3}, 1),
+              ::testing::ElementsAre(::testing::ElementsAre(0, 1, 2, 3)));
+}
+
+TEST(PartitionCpusIntoContiguousRanges, RangesDifferInSizeByAtMostOne) {
+  EXPECT_THAT(PartitionCpusIntoContiguousRanges({0, 1, 2, 3, 4, 5, 6, 7}, 3),
+              ::testing::ElementsAre(::testing::ElementsAre(0, 1, 2),
+                                     ::testing::ElementsAre(3, 4, 5),
+                                     ::testing::ElementsAre(6, 7)));
+  EXPECT_THAT(PartitionCpusIntoContiguousRanges({0, 1, 2, 3, 4, 5, 6, 7}, 4),
+              ::testing::ElementsAre(::testing::ElementsAre(0, 1), ::testing::ElementsAre(2, 3),
+                                     ::testing::ElementsAre(4, 5), ::testing::ElementsAre(6, 7)));
+}
+
+TEST(PartitionCpusIntoContiguousRanges, NonConsecutiveCpus) {
+  EXPECT_THAT(PartitionCpusIntoContiguousRanges({1, 3, 4, 9, 12}, 2),
+              ::testing::ElementsAre(::testing::ElementsAre(1, 3, 4),
+                                     ::testing::ElementsAre(9, 12)));
+}
+
+TEST(PartitionCpusIntoContiguousRanges, FewerCpusThanRanges) {
+  EXPECT_THAT(PartitionCpusIntoContiguousRanges({2, 5}, 4),
+              ::testing::ElementsAre(::testing::ElementsAre(2), ::testing::ElementsAre(5)));
+}
+
+TEST(PartitionCpusIntoContiguousRanges, EveryCpuIsInExactlyOneRange) {
+  std::vector<int32_t> cpus;
+  for (int32_t cpu = 0; cpu < 64; ++cpu) {
+    cpus.push_back(cpu);
+    for (size_t max_range_count = 1; max_range_count <= 70; ++max_range_count) {
+      std::vector<std::vector<int32_t>> ranges =
+          PartitionCpusIntoContiguousRanges(cpus, max_range_count);
+      ASSERT_EQ(ranges.size(), std::min(max_range_count, cpus.size()));
+
+      std::vector<int32_t> concatenated_ranges;
+      size_t min_range_size = cpus.size();
+      size_t max_range_size = 0;
+      for (const std::vector<int32_t>& range : ranges) {
+        concatenated_ranges.insert(concatenated_ranges.end(), range.begin(), range.end());
+        min_range_size = std::min(min_range_size, range.size());
+        max_range_size = std::max(max_range_size, range.size());
+      }
+      EXPECT_EQ(concatenated_ranges, cpus);
+      EXPECT_GE(min_range_size, 1);
+      EXPECT_LE(max_range_size - min_range_size, 1);
+    }
+  }
+}
+
 static ModuleInfo MakeModuleInfo(std::string file_path, uint64_t address_start, uint64_t load_bias,
                                  uint64_t executable_segment_offset,
                                  ModuleInfo::ObjectFileType object_file_type) {
@@ -15,6 +15,8 @@ class MockTracerListener : public TracerListener {
  public:
   MOCK_METHOD(void, OnSchedulingSlice, (orbit_grpc_protos::SchedulingSlice), (override));
   MOCK_METHOD(void, OnCallstackSample, (orbit_grpc_protos::FullCallstackSample), (override));
+  MOCK_METHOD(void, OnInternedCallstackSample, (orbit_grpc_protos::CallstackSample), (override));
+  MOCK_METHOD(void, OnInternedCallstack, (orbit_grpc_protos::InternedCallstack), (override));
   MOCK_METHOD(void, OnFunctionCall, (orbit_grpc_protos::FunctionCall), (override));
   MOCK_METHOD(void, OnThreadStateSliceCallstack, (orbit_grpc_protos::ThreadStateSliceCallstack),
               (override));
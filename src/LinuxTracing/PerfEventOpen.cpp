@@ -17,7 +17,7 @@
 
 namespace orbit_linux_tracing {
 namespace {
-perf_event_attr generic_event_attr() {
+perf_event_attr generic_event_attr(bool wakeup_on_watermark) {
   perf_event_attr pe{};
   pe.size = sizeof(struct perf_event_attr);
   pe.sample_period = 1;
@@ -26,6 +26,10 @@ perf_event_attr generic_event_attr() {
   pe.sample_id_all = 1;  // Also include timestamps for lost events.
   pe.disabled = 1;
   pe.sample_type = kSampleTypeTidTimeStreamidCpu;
+  if (wakeup_on_watermark) {
+    pe.watermark = 1;
+    pe.wakeup_watermark = kRingBufferWakeupWatermarkBytes;
+  }
 
   return pe;
 }
@@ -38,8 +42,9 @@ int generic_event_open(perf_event_attr* attr, pid_t pid, int32_t cpu) {
   return fd;
 }
 
-perf_event_attr uprobe_event_attr(const char* module, uint64_t function_offset) {
-  perf_event_attr pe = generic_event_attr();
+perf_event_attr uprobe_event_attr(const char* module, uint64_t function_offset,
+                                  bool wakeup_on_watermark) {
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
 
   pe.type = 7;                                    // TODO: should be read from
                                                   //  "/sys/bus/event_source/devices/uprobe/type"
@@ -50,8 +55,8 @@ perf_event_attr uprobe_event_attr(const char* module, uint64_t function_offset)
 }
 }  // namespace
 
-int context_switch_event_open(pid_t pid, int32_t cpu) {
-  perf_event_attr pe = generic_event_attr();
+int context_switch_event_open(pid_t pid, int32_t cpu, bool wakeup_on_watermark) {
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_DUMMY;
   pe.context_switch = 1;
@@ -59,8 +64,8 @@ int context_switch_event_open(pid_t pid, int32_t cpu) {
   return generic_event_open(&pe, pid, cpu);
 }
 
-int mmap_task_event_open(pid_t pid, int32_t cpu) {
-  perf_event_attr pe = generic_event_attr();
+int mmap_task_event_open(pid_t pid, int32_t cpu, bool wakeup_on_watermark) {
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_DUMMY;
   // Generate events for mmap (and mprotect) calls with the PROT_EXEC flag set.
@@ -72,8 +77,9 @@ int mmap_task_event_open(pid_t pid, int32_t cpu) {
   return generic_event_open(&pe, pid, cpu);
 }
 
-int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size) {
-  perf_event_attr pe = generic_event_attr();
+int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                            bool wakeup_on_watermark) {
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_CPU_CLOCK;
   pe.sample_period = period_ns;
@@ -86,8 +92,8 @@ int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t
 }
 
 int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
-                                uint16_t stack_dump_size) {
-  perf_event_attr pe = generic_event_attr();
+                                uint16_t stack_dump_size, bool wakeup_on_watermark) {
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_SOFTWARE;
   pe.config = PERF_COUNT_SW_CPU_CLOCK;
   pe.sample_period = period_ns;
@@ -106,8 +112,8 @@ int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
 }
 
 int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                               int32_t cpu) {
-  perf_event_attr pe = uprobe_event_attr(module, function_offset);
+                               int32_t cpu, bool wakeup_on_watermark) {
+  perf_event_attr pe = uprobe_event_attr(module, function_offset, wakeup_on_watermark);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
   pe.sample_regs_user = kSampleRegsUserSpIp;
@@ -120,8 +126,9 @@ int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid
 }
 
 int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                         int32_t cpu, uint16_t stack_dump_size) {
-  perf_event_attr pe = uprobe_event_attr(module, function_offset);
+                                         int32_t cpu, uint16_t stack_dump_size,
+                                         bool wakeup_on_watermark) {
+  perf_event_attr pe = uprobe_event_attr(module, function_offset, wakeup_on_watermark);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
   pe.sample_regs_user = kSampleRegsUserSp;
@@ -132,8 +139,8 @@ int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_o
 }
 
 int uprobes_retaddr_args_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                    int32_t cpu) {
-  perf_event_attr pe = uprobe_event_attr(module, function_offset);
+                                    int32_t cpu, bool wakeup_on_watermark) {
+  perf_event_attr pe = uprobe_event_attr(module, function_offset, wakeup_on_watermark);
   pe.config &= ~1ULL;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER;
   pe.sample_regs_user = kSampleRegsUserSpIpArguments;
@@ -142,16 +149,17 @@ int uprobes_retaddr_args_event_open(const char* module, uint64_t function_offset
   return generic_event_open(&pe, pid, cpu);
 }
 
-int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu) {
-  perf_event_attr pe = uprobe_event_attr(module, function_offset);
+int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu,
+                          bool wakeup_on_watermark) {
+  perf_event_attr pe = uprobe_event_attr(module, function_offset, wakeup_on_watermark);
   pe.config |= 1;  // Set bit 0 of config for uretprobe.
 
   return generic_event_open(&pe, pid, cpu);
 }
 
 int uretprobes_retval_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                 int32_t cpu) {
-  perf_event_attr pe = uprobe_event_attr(module, function_offset);
+                                 int32_t cpu, bool wakeup_on_watermark) {
+  perf_event_attr pe = uprobe_event_attr(module, function_offset, wakeup_on_watermark);
   pe.config |= 1;  // Set bit 0 of config for uretprobe.
 
   pe.sample_type |= PERF_SAMPLE_REGS_USER;
@@ -179,12 +187,12 @@ void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length) {
 }
 
 int tracepoint_event_open(const char* tracepoint_category, const char* tracepoint_name, pid_t pid,
-                          int32_t cpu) {
+                          int32_t cpu, bool wakeup_on_watermark) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
   }
-  perf_event_attr pe = generic_event_attr();
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_TRACEPOINT;
   pe.config = tp_id;
   pe.sample_type |= PERF_SAMPLE_RAW;
@@ -194,12 +202,12 @@ int tracepoint_event_open(const char* tracepoint_category, const char* tracepoin
 
 int tracepoint_with_callchain_event_open(const char* tracepoint_category,
                                          const char* tracepoint_name, pid_t pid, int32_t cpu,
-                                         uint16_t stack_dump_size) {
+                                         uint16_t stack_dump_size, bool wakeup_on_watermark) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
   }
-  perf_event_attr pe = generic_event_attr();
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_TRACEPOINT;
   pe.config = tp_id;
   pe.sample_type |= PERF_SAMPLE_CALLCHAIN | PERF_SAMPLE_RAW;
@@ -217,12 +225,13 @@ int tracepoint_with_callchain_event_open(const char* tracepoint_category,
 }
 
 int tracepoint_with_stack_event_open(const char* tracepoint_category, const char* tracepoint_name,
-                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size) {
+                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                                     bool wakeup_on_watermark) {
   int tp_id = GetTracepointId(tracepoint_category, tracepoint_name);
   if (tp_id == -1) {
     return -1;
   }
-  perf_event_attr pe = generic_event_attr();
+  perf_event_attr pe = generic_event_attr(wakeup_on_watermark);
   pe.type = PERF_TYPE_TRACEPOINT;
   pe.config = tp_id;
   pe.sample_type |= PERF_SAMPLE_REGS_USER | PERF_SAMPLE_STACK_USER | PERF_SAMPLE_RAW;
@@ -103,6 +103,13 @@ static constexpr uint64_t kSampleRegsUserSpIpArguments =
 static_assert(sizeof(void*) == 8);
 static constexpr uint16_t kSampleStackUserSize8Bytes = 8;
 
+// Number of bytes a ring buffer needs to contain for epoll (or poll) to report its file descriptor
+// as readable. Without this, the kernel only notifies when a ring buffer is half full, which for
+// the smaller ring buffers leaves little room to read them before they overflow. The kernel caps
+// this at the size of the ring buffer. The functions below only set this, through their
+// `wakeup_on_watermark` parameter, when the ring buffers are waited on with epoll.
+static constexpr uint32_t kRingBufferWakeupWatermarkBytes = 16 * 1024;
+
 // Max to pass to perf_event_open without getting an error is (1u << 16u) - 8,
 // because the kernel stores this in a short and because of alignment reasons.
 // But the size the kernel actually returns is smaller, because the maximum size
@@ -114,32 +121,35 @@ static constexpr uint16_t kSampleStackUserSize8Bytes = 8;
 static constexpr uint16_t kMaxStackSampleUserSize = 65000;
 
 // perf_event_open for context switches.
-int context_switch_event_open(pid_t pid, int32_t cpu);
+int context_switch_event_open(pid_t pid, int32_t cpu, bool wakeup_on_watermark);
 
 // perf_event_open for task (fork and exit) and mmap records in the same buffer.
-int mmap_task_event_open(pid_t pid, int32_t cpu);
+int mmap_task_event_open(pid_t pid, int32_t cpu, bool wakeup_on_watermark);
 
 // perf_event_open for stack sampling.
-int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size);
+int stack_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                            bool wakeup_on_watermark);
 
 // perf_event_open for stack sampling using frame pointers.
 int callchain_sample_event_open(uint64_t period_ns, pid_t pid, int32_t cpu,
-                                uint16_t stack_dump_size);
+                                uint16_t stack_dump_size, bool wakeup_on_watermark);
 
 // perf_event_open for uprobes and uretprobes.
 int uprobes_retaddr_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                               int32_t cpu);
+                               int32_t cpu, bool wakeup_on_watermark);
 
 int uprobes_with_stack_and_sp_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                         int32_t cpu, uint16_t stack_dump_size);
+                                         int32_t cpu, uint16_t stack_dump_size,
+                                         bool wakeup_on_watermark);
 
 int uprobes_retaddr_args_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                    int32_t cpu);
+                                    int32_t cpu, bool wakeup_on_watermark);
 
-int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu);
+int uretprobes_event_open(const char* module, uint64_t function_offset, pid_t pid, int32_t cpu,
+                          bool wakeup_on_watermark);
 
 int uretprobes_retval_event_open(const char* module, uint64_t function_offset, pid_t pid,
-                                 int32_t cpu);
+                                 int32_t cpu, bool wakeup_on_watermark);
 
 // Create the ring buffer to use perf_event_open in sampled mode.
 void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length);
@@ -149,14 +159,15 @@ void* perf_event_open_mmap_ring_buffer(int fd, uint64_t mmap_length);
 // (for example, "sched_waking"). Returns the file descriptor for the
 // perf event or -1 in case of any errors.
 int tracepoint_event_open(const char* tracepoint_category, const char* tracepoint_name, pid_t pid,
-                          int32_t cpu);
+                          int32_t cpu, bool wakeup_on_watermark);
 
 int tracepoint_with_stack_event_open(const char* tracepoint_category, const char* tracepoint_name,
-                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size);
+                                     pid_t pid, int32_t cpu, uint16_t stack_dump_size,
+                                     bool wakeup_on_watermark);
 
 int tracepoint_with_callchain_event_open(const char* tracepoint_category,
                                          const char* tracepoint_name, pid_t pid, int32_t cpu,
-                                         uint16_t stack_dump_size);
+                                         uint16_t stack_dump_size, bool wakeup_on_watermark);
 
 }  // namespace orbit_linux_tracing
 
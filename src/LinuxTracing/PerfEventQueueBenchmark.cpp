@@ -0,0 +1,78 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "PerfEvent.h"
+#include "PerfEventOrderedStream.h"
+#include "PerfEventQueue.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+// Simulates perf_event_open records coming from `state.range(0)` ring buffers, each of which is
+// already sorted by timestamp, with the timestamps of the different ring buffers interleaved.
+void BM_PerfEventQueuePushAndPopOrderedInFd(benchmark::State& state) {
+  const int fd_count = static_cast<int>(state.range(0));
+  constexpr uint64_t kEventsPerFd = 10'000;
+
+  PerfEventQueue event_queue;
+  uint64_t timestamp = 0;
+  for (auto _ : state) {
+    for (uint64_t i = 0; i < kEventsPerFd; ++i) {
+      for (int fd = 0; fd < fd_count; ++fd) {
+        event_queue.PushEvent(ForkPerfEvent{
+            .timestamp = ++timestamp,
+            .ordered_stream = PerfEventOrderedStream::FileDescriptor(fd),
+        });
+      }
+    }
+    while (event_queue.HasEvent()) {
+      benchmark::DoNotOptimize(event_queue.TopEvent().timestamp);
+      event_queue.PopEvent();
+    }
+  }
+
+  SetEventCounters(state, state.iterations() * static_cast<int64_t>(kEventsPerFd) * fd_count);
+}
+
+// Simulates events that are not known to be in order with respect to any other event, e.g.,
+// dma_fence_signaled, which all go through a single priority queue.
+void BM_PerfEventQueuePushAndPopNotOrdered(benchmark::State& state) {
+  const auto event_count = static_cast<uint64_t>(state.range(0));
+
+  // Timestamps that are not monotonic, but deterministic.
+  std::vector<uint64_t> timestamps(event_count);
+  for (uint64_t i = 0; i < event_count; ++i) {
+    timestamps[i] = (i * 7919) % event_count;
+  }
+
+  PerfEventQueue event_queue;
+  for (auto _ : state) {
+    for (uint64_t timestamp : timestamps) {
+      event_queue.PushEvent(ForkPerfEvent{
+          .timestamp = timestamp,
+          .ordered_stream = PerfEventOrderedStream::kNone,
+      });
+    }
+    while (event_queue.HasEvent()) {
+      benchmark::DoNotOptimize(event_queue.TopEvent().timestamp);
+      event_queue.PopEvent();
+    }
+  }
+
+  SetEventCounters(state, state.iterations() * static_cast<int64_t>(event_count));
+}
+
+}  // namespace
+
+BENCHMARK(BM_PerfEventQueuePushAndPopOrderedInFd)->Arg(1)->Arg(8)->Arg(64);
+BENCHMARK(BM_PerfEventQueuePushAndPopNotOrdered)->Arg(1'000)->Arg(100'000);
+
+}  // namespace orbit_linux_tracing
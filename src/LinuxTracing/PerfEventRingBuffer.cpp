@@ -36,13 +36,15 @@ static inline void WriteRingBufferTail(perf_event_mmap_page* base, uint64_t tail
   smp_store_release(&base->data_tail, tail);
 }
 
-PerfEventRingBuffer::PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name) {
+PerfEventRingBuffer::PerfEventRingBuffer(int perf_event_fd, uint64_t size_kb, std::string name,
+                                         int32_t cpu) {
   if (perf_event_fd < 0) {
     return;
   }
 
   file_descriptor_ = perf_event_fd;
   name_ = std::move(name);
+  cpu_ = cpu;
 
   // The size of a perf_event_open ring buffer is required to be a power of two
   // memory pages (from perf_event_open's manpage: "The mmap size should be
@@ -76,6 +78,7 @@ PerfEventRingBuffer::PerfEventRingBuffer(PerfEventRingBuffer&& o) {
   std::swap(ring_buffer_size_log2_, o.ring_buffer_size_log2_);
   std::swap(file_descriptor_, o.file_descriptor_);
   std::swap(name_, o.name_);
+  std::swap(cpu_, o.cpu_);
 }
 
 PerfEventRingBuffer& PerfEventRingBuffer::operator=(PerfEventRingBuffer&& o) {
@@ -87,6 +90,7 @@ PerfEventRingBuffer& PerfEventRingBuffer::operator=(PerfEventRingBuffer&& o) {
     std::swap(ring_buffer_size_log2_, o.ring_buffer_size_log2_);
     std::swap(file_descriptor_, o.file_descriptor_);
     std::swap(name_, o.name_);
+    std::swap(cpu_, o.cpu_);
   }
   return *this;
 }
@@ -108,6 +112,13 @@ bool PerfEventRingBuffer::HasNewData() {
   return head > metadata_page_->data_tail;
 }
 
+uint64_t PerfEventRingBuffer::GetNewDataSize() {
+  ORBIT_DCHECK(IsOpen());
+  uint64_t head = ReadRingBufferHead(metadata_page_);
+  ORBIT_DCHECK(head >= metadata_page_->data_tail);
+  return head - metadata_page_->data_tail;
+}
+
 void PerfEventRingBuffer::ReadHeader(perf_event_header* header) {
   ReadAtTail(header, sizeof(perf_event_header));
   ORBIT_DCHECK(header->type != 0);
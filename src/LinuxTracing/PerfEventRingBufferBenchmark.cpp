@@ -0,0 +1,110 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include "BenchmarkUtils.h"
+#include "LinuxTracingUtils.h"
+#include "OrbitBase/File.h"
+#include "OrbitBase/Logging.h"
+#include "PerfEventRecords.h"
+#include "PerfEventRingBuffer.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+// Plays the role of the kernel for a PerfEventRingBuffer: instead of a perf_event_open file
+// descriptor, a memfd is mapped by both the PerfEventRingBuffer and this class, which writes
+// records into it and advances `data_head`.
+class FakeKernelRingBufferWriter {
+ public:
+  FakeKernelRingBufferWriter(int fd, uint64_t ring_buffer_size)
+      : ring_buffer_size_{ring_buffer_size}, mmap_length_{GetPageSize() + ring_buffer_size} {
+    ORBIT_CHECK(ftruncate(fd, static_cast<off_t>(mmap_length_)) == 0);
+    mmap_address_ = mmap(nullptr, mmap_length_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ORBIT_CHECK(mmap_address_ != MAP_FAILED);
+    metadata_page_ = static_cast<perf_event_mmap_page*>(mmap_address_);
+    metadata_page_->data_offset = GetPageSize();
+    metadata_page_->data_size = ring_buffer_size_;
+    ring_buffer_ = static_cast<char*>(mmap_address_) + GetPageSize();
+  }
+
+  ~FakeKernelRingBufferWriter() { munmap(mmap_address_, mmap_length_); }
+
+  FakeKernelRingBufferWriter(const FakeKernelRingBufferWriter&) = delete;
+  FakeKernelRingBufferWriter& operator=(const FakeKernelRingBufferWriter&) = delete;
+
+  // Writes `record` as many times as it fits in the free space of the ring buffer, wrapping around
+  // its end like the kernel does. Returns the number of records written.
+  template <typename RecordT>
+  uint64_t FillWithRecords(const RecordT& record) {
+    uint64_t head = metadata_page_->data_head;
+    const uint64_t tail = smp_load_acquire(&metadata_page_->data_tail);
+    uint64_t record_count = 0;
+    while (head + sizeof(RecordT) - tail <= ring_buffer_size_) {
+      const auto* record_bytes = reinterpret_cast<const char*>(&record);
+      for (uint64_t i = 0; i < sizeof(RecordT); ++i) {
+        ring_buffer_[(head + i) % ring_buffer_size_] = record_bytes[i];
+      }
+      head += sizeof(RecordT);
+      ++record_count;
+    }
+    smp_store_release(&metadata_page_->data_head, head);
+    return record_count;
+  }
+
+ private:
+  uint64_t ring_buffer_size_;
+  uint64_t mmap_length_;
+  void* mmap_address_ = nullptr;
+  perf_event_mmap_page* metadata_page_ = nullptr;
+  char* ring_buffer_ = nullptr;
+};
+
+// Measures reading fork records, which are small and fixed-size, from a PerfEventRingBuffer in the
+// same way as PerfEventReaders does.
+void BM_PerfEventRingBufferConsumeRecord(benchmark::State& state) {
+  const auto ring_buffer_size_kb = static_cast<uint64_t>(state.range(0));
+
+  orbit_base::UniqueFd fd{memfd_create("PerfEventRingBufferBenchmark", MFD_CLOEXEC)};
+  ORBIT_CHECK(fd.valid());
+  FakeKernelRingBufferWriter writer{fd.get(), ring_buffer_size_kb * 1024};
+  PerfEventRingBuffer ring_buffer{fd.get(), ring_buffer_size_kb, "benchmark", 0};
+  ORBIT_CHECK(ring_buffer.IsOpen());
+
+  RingBufferForkExit fork_record{};
+  fork_record.header.type = PERF_RECORD_FORK;
+  fork_record.header.size = sizeof(RingBufferForkExit);
+  fork_record.pid = 42;
+  fork_record.tid = 42;
+
+  int64_t record_count = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    record_count += static_cast<int64_t>(writer.FillWithRecords(fork_record));
+    state.ResumeTiming();
+
+    while (ring_buffer.HasNewData()) {
+      perf_event_header header;
+      ring_buffer.ReadHeader(&header);
+      RingBufferForkExit consumed_record;
+      ring_buffer.ConsumeRecord(header, &consumed_record);
+      benchmark::DoNotOptimize(consumed_record);
+    }
+  }
+
+  SetEventCounters(state, record_count);
+}
+
+}  // namespace
+
+BENCHMARK(BM_PerfEventRingBufferConsumeRecord)->Arg(64)->Arg(1024);
+
+}  // namespace orbit_linux_tracing
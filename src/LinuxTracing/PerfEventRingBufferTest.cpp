@@ -0,0 +1,135 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <linux/perf_event.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "LinuxTracingUtils.h"
+#include "OrbitBase/Logging.h"
+#include "PerfEventRingBuffer.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+constexpr uint64_t kRingBufferSizeKb = 8;
+constexpr uint64_t kRingBufferSize = kRingBufferSizeKb * 1024;
+
+// An anonymous file that PerfEventRingBuffer can map in place of the ring buffer of a
+// perf_event_open file descriptor. The test plays the role of the kernel, writing records at
+// data_head.
+class FakeRingBufferFile {
+ public:
+  FakeRingBufferFile() {
+    fd_ = memfd_create("FakeRingBuffer", MFD_CLOEXEC);
+    ORBIT_CHECK(fd_ != -1);
+    ORBIT_CHECK(ftruncate(fd_, GetMmapLength()) == 0);
+    void* mapping = mmap(nullptr, GetMmapLength(), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    ORBIT_CHECK(mapping != MAP_FAILED);
+    metadata_page_ = static_cast<perf_event_mmap_page*>(mapping);
+    metadata_page_->data_offset = GetPageSize();
+    metadata_page_->data_size = kRingBufferSize;
+  }
+
+  ~FakeRingBufferFile() {
+    munmap(metadata_page_, GetMmapLength());
+    close(fd_);
+  }
+
+  FakeRingBufferFile(const FakeRingBufferFile&) = delete;
+  FakeRingBufferFile& operator=(const FakeRingBufferFile&) = delete;
+
+  [[nodiscard]] int GetFileDescriptor() const { return fd_; }
+
+  // Sets both data_head and data_tail, before any record is written.
+  void SetPosition(uint64_t position) {
+    metadata_page_->data_head = position;
+    metadata_page_->data_tail = position;
+  }
+
+  // Writes a record of `size` bytes, consisting of a perf_event_header and zeros, at data_head.
+  void WriteRecord(uint16_t size) {
+    ORBIT_CHECK(size >= sizeof(perf_event_header));
+    perf_event_header header{};
+    header.type = PERF_RECORD_SAMPLE;
+    header.size = size;
+    char* ring_buffer = reinterpret_cast<char*>(metadata_page_) + GetPageSize();
+    const uint64_t head = metadata_page_->data_head;
+    for (uint64_t i = 0; i < size; ++i) {
+      char byte = i < sizeof(header) ? reinterpret_cast<const char*>(&header)[i] : 0;
+      ring_buffer[(head + i) % kRingBufferSize] = byte;
+    }
+    metadata_page_->data_head = head + size;
+  }
+
+ private:
+  [[nodiscard]] static uint64_t GetMmapLength() { return GetPageSize() + kRingBufferSize; }
+
+  int fd_ = -1;
+  perf_event_mmap_page* metadata_page_ = nullptr;
+};
+
+}  // namespace
+
+TEST(PerfEventRingBuffer, EmptyRingBufferHasNoNewData) {
+  FakeRingBufferFile file;
+  PerfEventRingBuffer ring_buffer{file.GetFileDescriptor(), kRingBufferSizeKb, "fake", 0};
+  ASSERT_TRUE(ring_buffer.IsOpen());
+
+  EXPECT_FALSE(ring_buffer.HasNewData());
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 0);
+}
+
+TEST(PerfEventRingBuffer, GetNewDataSizeReturnsSizeOfUnreadRecords) {
+  FakeRingBufferFile file;
+  PerfEventRingBuffer ring_buffer{file.GetFileDescriptor(), kRingBufferSizeKb, "fake", 0};
+  ASSERT_TRUE(ring_buffer.IsOpen());
+
+  file.WriteRecord(16);
+  file.WriteRecord(24);
+  EXPECT_TRUE(ring_buffer.HasNewData());
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 40);
+
+  perf_event_header header{};
+  ring_buffer.ReadHeader(&header);
+  EXPECT_EQ(header.size, 16);
+  ring_buffer.SkipRecord(header);
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 24);
+
+  file.WriteRecord(32);
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 56);
+
+  ring_buffer.ReadHeader(&header);
+  EXPECT_EQ(header.size, 24);
+  ring_buffer.SkipRecord(header);
+  ring_buffer.ReadHeader(&header);
+  EXPECT_EQ(header.size, 32);
+  ring_buffer.SkipRecord(header);
+  EXPECT_FALSE(ring_buffer.HasNewData());
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 0);
+}
+
+TEST(PerfEventRingBuffer, GetNewDataSizeWithRecordWrappingAround) {
+  FakeRingBufferFile file;
+  // data_head and data_tail only ever grow, so they exceed the size of the ring buffer.
+  file.SetPosition(3 * kRingBufferSize - 8);
+  PerfEventRingBuffer ring_buffer{file.GetFileDescriptor(), kRingBufferSizeKb, "fake", 0};
+  ASSERT_TRUE(ring_buffer.IsOpen());
+
+  file.WriteRecord(24);
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 24);
+
+  perf_event_header header{};
+  ring_buffer.ReadHeader(&header);
+  EXPECT_EQ(header.type, PERF_RECORD_SAMPLE);
+  EXPECT_EQ(header.size, 24);
+  ring_buffer.SkipRecord(header);
+  EXPECT_EQ(ring_buffer.GetNewDataSize(), 0);
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,151 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "StackUnwindingWorkerPool.h"
+
+#include <absl/strings/str_format.h>
+
+#include <utility>
+
+#include "Introspection/Introspection.h"
+#include "LibunwindstackMultipleOfflineAndProcessMemory.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/ThreadUtils.h"
+
+namespace orbit_linux_tracing {
+
+StackUnwindingWorkerPool::StackUnwindingWorkerPool(
+    size_t thread_count, const std::function<std::unique_ptr<LibunwindstackMaps>()>& maps_factory,
+    const std::function<std::unique_ptr<LibunwindstackUnwinder>()>& unwinder_factory) {
+  ORBIT_CHECK(thread_count > 0);
+  workers_.reserve(thread_count);
+  for (size_t i = 0; i < thread_count; ++i) {
+    auto worker = std::make_unique<Worker>();
+    worker->maps = maps_factory();
+    ORBIT_CHECK(worker->maps != nullptr);
+    worker->unwinder = unwinder_factory();
+    ORBIT_CHECK(worker->unwinder != nullptr);
+    workers_.emplace_back(std::move(worker));
+  }
+  for (size_t i = 0; i < thread_count; ++i) {
+    workers_[i]->thread = std::thread(&StackUnwindingWorkerPool::RunWorker, this, i);
+  }
+}
+
+StackUnwindingWorkerPool::~StackUnwindingWorkerPool() {
+  {
+    absl::MutexLock lock{&mutex_};
+    for (std::unique_ptr<Worker>& worker : workers_) {
+      worker->stop_requested = true;
+    }
+  }
+  for (std::unique_ptr<Worker>& worker : workers_) {
+    worker->thread.join();
+  }
+}
+
+void StackUnwindingWorkerPool::AddAndSortMaps(uint64_t start, uint64_t end, uint64_t offset,
+                                              uint64_t flags, std::string_view name) {
+  absl::MutexLock lock{&mutex_};
+  for (std::unique_ptr<Worker>& worker : workers_) {
+    worker->work_items.emplace_back(MapsUpdate{
+        .start = start, .end = end, .offset = offset, .flags = flags, .name = std::string{name}});
+  }
+}
+
+void StackUnwindingWorkerPool::ScheduleUnwinding(UnwindingRequest request,
+                                                 ResultCallback callback) {
+  while (pending_requests_.size() >= kMaxRequestsInFlightPerThread * workers_.size()) {
+    ORBIT_SCOPE("StackUnwindingWorkerPool waiting for worker");
+    ProcessOldestRequest();
+  }
+
+  Worker* worker = workers_[static_cast<uint32_t>(request.tid) % workers_.size()].get();
+  auto pending_request = std::make_unique<PendingRequest>(
+      PendingRequest{.request = std::move(request), .callback = std::move(callback)});
+  absl::MutexLock lock{&mutex_};
+  worker->work_items.emplace_back(pending_request.get());
+  pending_requests_.emplace_back(std::move(pending_request));
+}
+
+void StackUnwindingWorkerPool::ProcessFinishedRequests() {
+  while (!pending_requests_.empty()) {
+    {
+      absl::MutexLock lock{&mutex_};
+      if (!pending_requests_.front()->result.has_value()) {
+        return;
+      }
+    }
+    ProcessOldestRequest();
+  }
+}
+
+void StackUnwindingWorkerPool::WaitForAndProcessAllRequests() {
+  ORBIT_SCOPE_FUNCTION;
+  while (!pending_requests_.empty()) {
+    ProcessOldestRequest();
+  }
+}
+
+void StackUnwindingWorkerPool::ProcessOldestRequest() {
+  ORBIT_CHECK(!pending_requests_.empty());
+  std::unique_ptr<PendingRequest> oldest_request = std::move(pending_requests_.front());
+  pending_requests_.pop_front();
+
+  {
+    absl::MutexLock lock{&mutex_};
+    mutex_.Await(absl::Condition(
+        +[](PendingRequest* request) { return request->result.has_value(); },
+        oldest_request.get()));
+  }
+  // The worker no longer references the request once the result has been set.
+  oldest_request->callback(oldest_request->result.value());
+}
+
+void StackUnwindingWorkerPool::RunWorker(size_t worker_index) {
+  Worker* worker = workers_[worker_index].get();
+  orbit_base::SetCurrentThreadName(absl::StrFormat("Unwinding#%u", worker_index).c_str());
+
+  while (true) {
+    WorkItem work_item;
+    {
+      absl::MutexLock lock{&mutex_};
+      mutex_.Await(absl::Condition(
+          +[](Worker* worker) { return !worker->work_items.empty() || worker->stop_requested; },
+          worker));
+      if (worker->stop_requested) {
+        return;
+      }
+      work_item = std::move(worker->work_items.front());
+      worker->work_items.pop_front();
+    }
+
+    if (std::holds_alternative<MapsUpdate>(work_item)) {
+      const MapsUpdate& maps_update = std::get<MapsUpdate>(work_item);
+      worker->maps->AddAndSort(maps_update.start, maps_update.end, maps_update.offset,
+                               maps_update.flags, maps_update.name);
+      continue;
+    }
+
+    PendingRequest* pending_request = std::get<PendingRequest*>(work_item);
+    const UnwindingRequest& request = pending_request->request;
+    std::vector<StackSliceView> stack_slice_views;
+    stack_slice_views.reserve(request.stack_slices.size());
+    for (const StackSlice& stack_slice : request.stack_slices) {
+      stack_slice_views.emplace_back(stack_slice.start_address, stack_slice.size,
+                                     stack_slice.data.get());
+    }
+
+    LibunwindstackResult result = [&] {
+      ORBIT_SCOPE("StackUnwindingWorkerPool Unwind");
+      return worker->unwinder->Unwind(request.pid, worker->maps->Get(), request.registers,
+                                      stack_slice_views, request.offline_memory_only);
+    }();
+
+    absl::MutexLock lock{&mutex_};
+    pending_request->result.emplace(std::move(result));
+  }
+}
+
+}  // namespace orbit_linux_tracing
@@ -0,0 +1,144 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef LINUX_TRACING_STACK_UNWINDING_WORKER_POOL_H_
+#define LINUX_TRACING_STACK_UNWINDING_WORKER_POOL_H_
+
+#include <absl/synchronization/mutex.h>
+#include <asm/perf_regs.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <variant>
+#include <vector>
+
+#include "LibunwindstackMaps.h"
+#include "LibunwindstackUnwinder.h"
+#include "OrbitBase/AnyInvocable.h"
+
+namespace orbit_linux_tracing {
+
+// StackUnwindingWorkerPool moves the expensive part of DWARF-based unwinding, i.e., the call to
+// LibunwindstackUnwinder::Unwind, off the thread that processes the PerfEvents in order.
+//
+// Each worker thread owns its own LibunwindstackMaps and LibunwindstackUnwinder, as neither is
+// thread-safe. Changes to the memory maps are broadcast to all workers through the same queues as
+// the unwinding requests, so that every request is unwound against the maps as they were when the
+// request was scheduled. Requests are sharded by thread id, so that all the stacks of a thread are
+// unwound by the same worker.
+//
+// The callback associated with each request is not called on the worker, but by
+// ProcessFinishedRequests or WaitForAndProcessAllRequests, by the thread that schedules the
+// requests, strictly in the order in which they were scheduled. As PerfEvents are processed in
+// order of timestamp, this means that results reach the TracerListener in timestamp order among
+// themselves, and that the callbacks can safely access the state of the caller without
+// synchronization. They are usually delivered after events that were processed later, though, so
+// only results that no other event depends on should be unwound here.
+//
+// The public methods must not be called concurrently with each other.
+class StackUnwindingWorkerPool {
+ public:
+  // A copy of (part of) the stack of a thread. The data is shared as the same stack slice can be
+  // used to unwind multiple samples, e.g., in the case of stacks recorded with uprobes.
+  struct StackSlice {
+    uint64_t start_address;
+    uint64_t size;
+    std::shared_ptr<const uint8_t[]> data;
+  };
+
+  struct UnwindingRequest {
+    pid_t pid;
+    pid_t tid;
+    std::array<uint64_t, PERF_REG_X86_64_MAX> registers;
+    std::vector<StackSlice> stack_slices;
+    bool offline_memory_only;
+  };
+
+  using ResultCallback = orbit_base::AnyInvocable<void(const LibunwindstackResult&)>;
+
+  explicit StackUnwindingWorkerPool(
+      size_t thread_count, const std::function<std::unique_ptr<LibunwindstackMaps>()>& maps_factory,
+      const std::function<std::unique_ptr<LibunwindstackUnwinder>()>& unwinder_factory);
+
+  StackUnwindingWorkerPool(const StackUnwindingWorkerPool&) = delete;
+  StackUnwindingWorkerPool& operator=(const StackUnwindingWorkerPool&) = delete;
+  StackUnwindingWorkerPool(StackUnwindingWorkerPool&&) = delete;
+  StackUnwindingWorkerPool& operator=(StackUnwindingWorkerPool&&) = delete;
+
+  // Stops and joins the worker threads. Callbacks of requests that have not been processed yet are
+  // discarded without being called.
+  ~StackUnwindingWorkerPool();
+
+  // Applies LibunwindstackMaps::AddAndSort to the maps of every worker. All requests scheduled
+  // afterwards will observe the change, all requests scheduled before will not.
+  void AddAndSortMaps(uint64_t start, uint64_t end, uint64_t offset, uint64_t flags,
+                      std::string_view name);
+
+  // Schedules the unwinding of `request` on the worker responsible for `request.tid`. If too many
+  // requests are in flight, this blocks until the oldest one has been unwound, and processes it.
+  void ScheduleUnwinding(UnwindingRequest request, ResultCallback callback);
+
+  // Calls the callbacks of the oldest requests that have already been unwound, stopping at the
+  // first request that has not been unwound yet. Does not block.
+  void ProcessFinishedRequests();
+
+  // Waits until all scheduled requests have been unwound and calls their callbacks.
+  void WaitForAndProcessAllRequests();
+
+  [[nodiscard]] size_t GetThreadCount() const { return workers_.size(); }
+
+  // This bounds the memory used by requests in flight, as each of them owns a copy of a stack.
+  static constexpr size_t kMaxRequestsInFlightPerThread = 256;
+
+ private:
+  struct PendingRequest {
+    UnwindingRequest request;
+    ResultCallback callback;
+    // Written by the worker and read by the scheduling thread, always with mutex_ held.
+    std::optional<LibunwindstackResult> result;
+  };
+
+  struct MapsUpdate {
+    uint64_t start;
+    uint64_t end;
+    uint64_t offset;
+    uint64_t flags;
+    std::string name;
+  };
+
+  using WorkItem = std::variant<MapsUpdate, PendingRequest*>;
+
+  struct Worker {
+    std::unique_ptr<LibunwindstackMaps> maps;
+    std::unique_ptr<LibunwindstackUnwinder> unwinder;
+    // Guarded by StackUnwindingWorkerPool::mutex_.
+    std::deque<WorkItem> work_items;
+    // Guarded by StackUnwindingWorkerPool::mutex_.
+    bool stop_requested = false;
+    std::thread thread;
+  };
+
+  void RunWorker(size_t worker_index);
+  void ProcessOldestRequest();
+
+  absl::Mutex mutex_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Requests in the order in which they were scheduled. Only accessed by the scheduling thread,
+  // except for PendingRequest::result.
+  std::deque<std::unique_ptr<PendingRequest>> pending_requests_;
+};
+
+}  // namespace orbit_linux_tracing
+
+#endif  // LINUX_TRACING_STACK_UNWINDING_WORKER_POOL_H_
@@ -0,0 +1,168 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <absl/synchronization/notification.h>
+#include <absl/types/span.h>
+#include <asm/perf_regs.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unwindstack/RegsX86_64.h>
+#include <unwindstack/Unwinder.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "LibunwindstackMaps.h"
+#include "LibunwindstackMultipleOfflineAndProcessMemory.h"
+#include "LibunwindstackUnwinder.h"
+#include "StackUnwindingWorkerPool.h"
+#include "UprobesUnwindingVisitorTestCommon.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+// Returns a single frame whose pc is the instruction pointer in the registers.
+LibunwindstackResult UnwindToInstructionPointer(
+    pid_t /*pid*/, unwindstack::Maps* /*maps*/,
+    const std::array<uint64_t, PERF_REG_X86_64_MAX>& perf_regs,
+    absl::Span<const StackSliceView> /*stack_slices*/, bool /*offline_memory_only*/,
+    size_t /*max_frames*/) {
+  return LibunwindstackResult{{unwindstack::FrameData{.pc = perf_regs[PERF_REG_X86_IP]}},
+                              unwindstack::RegsX86_64{}};
+}
+
+StackUnwindingWorkerPool::UnwindingRequest MakeRequest(pid_t tid, uint64_t ip) {
+  StackUnwindingWorkerPool::UnwindingRequest request{
+      .pid = 42, .tid = tid, .registers = {}, .stack_slices = {}, .offline_memory_only = false};
+  request.registers[PERF_REG_X86_IP] = ip;
+  constexpr uint64_t kStackSize = 8;
+  request.stack_slices.push_back({.start_address = 0x1000,
+                                  .size = kStackSize,
+                                  .data = std::make_unique<uint8_t[]>(kStackSize)});
+  return request;
+}
+
+}  // namespace
+
+TEST(StackUnwindingWorkerPool, CallbacksAreCalledInSchedulingOrder) {
+  absl::Notification unblock_first_worker;
+  size_t created_unwinders = 0;
+  StackUnwindingWorkerPool pool{
+      2, [] { return std::make_unique<::testing::NiceMock<MockLibunwindstackMaps>>(); },
+      [&] {
+        auto unwinder = std::make_unique<MockLibunwindstackUnwinder>();
+        if (created_unwinders++ == 0) {
+          // The first worker only unwinds after unblock_first_worker is notified.
+          EXPECT_CALL(*unwinder, Unwind).WillRepeatedly([&unblock_first_worker](auto&&... args) {
+            unblock_first_worker.WaitForNotification();
+            return UnwindToInstructionPointer(args...);
+          });
+        } else {
+          EXPECT_CALL(*unwinder, Unwind).WillRepeatedly(&UnwindToInstructionPointer);
+        }
+        return unwinder;
+      }};
+  ASSERT_EQ(pool.GetThreadCount(), 2);
+
+  std::vector<uint64_t> unwound_pcs;
+  auto save_pc = [&unwound_pcs](const LibunwindstackResult& result) {
+    ASSERT_EQ(result.frames().size(), 1);
+    unwound_pcs.push_back(result.frames()[0].pc);
+  };
+
+  // Tid 2 is handled by the first worker, tid 1 by the second.
+  pool.ScheduleUnwinding(MakeRequest(2, 0x10), StackUnwindingWorkerPool::ResultCallback{save_pc});
+  pool.ScheduleUnwinding(MakeRequest(1, 0x20), StackUnwindingWorkerPool::ResultCallback{save_pc});
+  pool.ScheduleUnwinding(MakeRequest(1, 0x30), StackUnwindingWorkerPool::ResultCallback{save_pc});
+
+  // The second worker can complete its requests, but the oldest request is still blocked.
+  pool.ProcessFinishedRequests();
+  EXPECT_TRUE(unwound_pcs.empty());
+
+  unblock_first_worker.Notify();
+  pool.WaitForAndProcessAllRequests();
+  EXPECT_THAT(unwound_pcs, ::testing::ElementsAre(0x10, 0x20, 0x30));
+}
+
+TEST(StackUnwindingWorkerPool, MapsUpdatesReachEveryWorkerBeforeLaterRequests) {
+  constexpr uint64_t kMapStart = 0x1000;
+  constexpr uint64_t kMapEnd = 0x2000;
+  constexpr uint64_t kMapOffset = 0x100;
+  const std::string kMapName = "/path/to/module.so";
+
+  // Expectations are verified when the mocks are destroyed with the pool.
+  std::vector<std::unique_ptr<::testing::Sequence>> sequences;
+  auto pool = std::make_unique<StackUnwindingWorkerPool>(
+      3,
+      [&] {
+        sequences.push_back(std::make_unique<::testing::Sequence>());
+        auto maps = std::make_unique<MockLibunwindstackMaps>();
+        EXPECT_CALL(*maps, Get).WillRepeatedly(::testing::Return(nullptr));
+        EXPECT_CALL(*maps, AddAndSort(kMapStart, kMapEnd, kMapOffset, PROT_READ | PROT_EXEC,
+                                      std::string_view{kMapName}))
+            .Times(1)
+            .InSequence(*sequences.back());
+        return maps;
+      },
+      [&] {
+        auto unwinder = std::make_unique<MockLibunwindstackUnwinder>();
+        // All requests are scheduled after the maps update.
+        EXPECT_CALL(*unwinder, Unwind)
+            .InSequence(*sequences.back())
+            .WillRepeatedly(&UnwindToInstructionPointer);
+        return unwinder;
+      });
+
+  pool->AddAndSortMaps(kMapStart, kMapEnd, kMapOffset, PROT_READ | PROT_EXEC, kMapName);
+
+  size_t callback_count = 0;
+  constexpr pid_t kThreadCount = 9;
+  for (pid_t tid = 0; tid < kThreadCount; ++tid) {
+    pool->ScheduleUnwinding(
+        MakeRequest(tid, tid),
+        StackUnwindingWorkerPool::ResultCallback{
+            [&callback_count](const LibunwindstackResult& /*result*/) { ++callback_count; }});
+  }
+  pool->WaitForAndProcessAllRequests();
+  EXPECT_EQ(callback_count, kThreadCount);
+
+  pool.reset();
+}
+
+TEST(StackUnwindingWorkerPool, DestructorDiscardsPendingRequests) {
+  absl::Notification unblock_worker;
+  bool callback_called = false;
+  {
+    StackUnwindingWorkerPool pool{
+        1, [] { return std::make_unique<::testing::NiceMock<MockLibunwindstackMaps>>(); },
+        [&unblock_worker] {
+          auto unwinder = std::make_unique<MockLibunwindstackUnwinder>();
+          EXPECT_CALL(*unwinder, Unwind).WillRepeatedly([&unblock_worker](auto&&... args) {
+            unblock_worker.WaitForNotification();
+            return UnwindToInstructionPointer(args...);
+          });
+          return unwinder;
+        }};
+    pool.ScheduleUnwinding(MakeRequest(1, 0x10),
+                           StackUnwindingWorkerPool::ResultCallback{
+                               [&callback_called](const LibunwindstackResult& /*result*/) {
+                                 callback_called = true;
+                               }});
+    pool.ScheduleUnwinding(MakeRequest(1, 0x20),
+                           StackUnwindingWorkerPool::ResultCallback{
+                               [&callback_called](const LibunwindstackResult& /*result*/) {
+                                 callback_called = true;
+                               }});
+    unblock_worker.Notify();
+  }
+  EXPECT_FALSE(callback_called);
+}
+
+}  // namespace orbit_linux_tracing
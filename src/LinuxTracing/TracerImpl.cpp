@@ -12,11 +12,15 @@
 #include <absl/strings/str_join.h>
 #include <absl/synchronization/mutex.h>
 #include <absl/types/span.h>
+#include <errno.h>
+#include <sched.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <unistd.h>
 
 #include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -38,6 +42,7 @@
 #include "OrbitBase/GetProcessIds.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Result.h"
+#include "OrbitBase/SafeStrerror.h"
 #include "OrbitBase/ThreadUtils.h"
 #include "PerfEventOpen.h"
 #include "PerfEventOrderedStream.h"
@@ -73,6 +78,10 @@ TracerImpl::TracerImpl(
       introspection_enabled_{capture_options.enable_introspection()},
       target_pid_{orbit_base::ToNativeProcessId(capture_options.pid())},
       unwinding_method_{capture_options.unwinding_method()},
+      dwarf_unwinding_thread_count_{capture_options.dwarf_unwinding_thread_count()},
+      event_driven_ring_buffer_reading_{capture_options.event_driven_ring_buffer_reading()},
+      ring_buffer_reader_thread_count_{capture_options.ring_buffer_reader_thread_count()},
+      intern_callstacks_{capture_options.intern_callstacks()},
       trace_thread_state_{capture_options.trace_thread_state()},
       trace_gpu_driver_{capture_options.trace_gpu_driver()},
       user_space_instrumentation_addresses_{std::move(user_space_instrumentation_addresses)},
@@ -213,7 +222,7 @@ static void OpenRingBuffersOrRedirectOnExisting(
       // Create a ring buffer for this cpu.
       int ring_buffer_fd = fd;
       std::string buffer_name = absl::StrFormat("%s_%d", buffer_name_prefix, cpu);
-      ring_buffers->emplace_back(ring_buffer_fd, ring_buffer_size_kb, buffer_name);
+      ring_buffers->emplace_back(ring_buffer_fd, ring_buffer_size_kb, buffer_name, cpu);
       ring_buffer_fds_per_cpu->emplace(cpu, ring_buffer_fd);
     }
   }
@@ -238,21 +247,40 @@ void TracerImpl::InitUprobesEventVisitor() {
       &absolute_address_to_size_of_functions_to_stop_unwinding_at_);
   uprobes_unwinding_visitor_->SetUnwindErrorsAndDiscardedSamplesCounters(
       &stats_.unwind_error_count, &stats_.samples_in_uretprobes_count);
+  uprobes_unwinding_visitor_->SetInternCallstacks(intern_callstacks_);
+
+  if (unwinding_method_ == CaptureOptions::kDwarf && dwarf_unwinding_thread_count_ > 0) {
+    const uint32_t thread_count =
+        std::min(dwarf_unwinding_thread_count_, std::max(std::thread::hardware_concurrency(), 1u));
+    ORBIT_LOG("Unwinding stacks on %u threads", thread_count);
+    // Each worker parses its own copy of the initial maps, which then receives the same updates as
+    // maps_ does.
+    std::string initial_maps = maps.has_value() ? maps.value() : "";
+    unwinding_worker_pool_ = std::make_unique<StackUnwindingWorkerPool>(
+        thread_count, [&initial_maps] { return LibunwindstackMaps::ParseMaps(initial_maps); },
+        [this] {
+          return LibunwindstackUnwinder::Create(
+              &absolute_address_to_size_of_functions_to_stop_unwinding_at_);
+        });
+    uprobes_unwinding_visitor_->SetStackUnwindingWorkerPool(unwinding_worker_pool_.get());
+  }
   event_processor_.AddVisitor(uprobes_unwinding_visitor_.get());
 }
 
 bool TracerImpl::OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& function,
                              absl::Span<const int32_t> cpus,
-                             absl::flat_hash_map<int32_t, int>* fds_per_cpu) {
+                             absl::flat_hash_map<int32_t, int>* fds_per_cpu) const {
   ORBIT_SCOPE_FUNCTION;
   const char* module = function.file_path().c_str();
   const uint64_t offset = function.file_offset();
   for (int32_t cpu : cpus) {
     int fd{};
     if (function.record_arguments()) {
-      fd = uprobes_retaddr_args_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uprobes_retaddr_args_event_open(module, offset, /*pid=*/-1, cpu,
+                                           event_driven_ring_buffer_reading_);
     } else {
-      fd = uprobes_retaddr_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uprobes_retaddr_event_open(module, offset, /*pid=*/-1, cpu,
+                                      event_driven_ring_buffer_reading_);
     }
     if (fd < 0) {
       ORBIT_ERROR("Opening uprobe %s+%#x on cpu %d", function.file_path(), function.file_offset(),
@@ -266,16 +294,18 @@ bool TracerImpl::OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& func
 
 bool TracerImpl::OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& function,
                                 absl::Span<const int32_t> cpus,
-                                absl::flat_hash_map<int32_t, int>* fds_per_cpu) {
+                                absl::flat_hash_map<int32_t, int>* fds_per_cpu) const {
   ORBIT_SCOPE_FUNCTION;
   const char* module = function.file_path().c_str();
   const uint64_t offset = function.file_offset();
   for (int32_t cpu : cpus) {
     int fd{};
     if (function.record_return_value()) {
-      fd = uretprobes_retval_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uretprobes_retval_event_open(module, offset, /*pid=*/-1, cpu,
+                                        event_driven_ring_buffer_reading_);
     } else {
-      fd = uretprobes_event_open(module, offset, /*pid=*/-1, cpu);
+      fd = uretprobes_event_open(module, offset, /*pid=*/-1, cpu,
+                                 event_driven_ring_buffer_reading_);
     }
     if (fd < 0) {
       ORBIT_ERROR("Opening uretprobe %s+%#x on cpu %d", function.file_path(),
@@ -360,8 +390,8 @@ bool TracerImpl::OpenUprobesWithStack(
   const char* module = function.file_path().c_str();
   const uint64_t offset = function.file_offset();
   for (int32_t cpu : cpus) {
-    int fd =
-        uprobes_with_stack_and_sp_event_open(module, offset, /*pid=*/-1, cpu, stack_dump_size_);
+    int fd = uprobes_with_stack_and_sp_event_open(module, offset, /*pid=*/-1, cpu, stack_dump_size_,
+                                                  event_driven_ring_buffer_reading_);
     if (fd < 0) {
       ORBIT_ERROR("Opening uprobe %s+%#x with stack on cpu %d", function.file_path(),
                   function.file_offset(), cpu);
@@ -404,9 +434,10 @@ bool TracerImpl::OpenMmapTask(absl::Span<const int32_t> cpus) {
   std::vector<int> mmap_task_tracing_fds;
   std::vector<PerfEventRingBuffer> mmap_task_ring_buffers;
   for (int32_t cpu : cpus) {
-    int mmap_task_fd = mmap_task_event_open(-1, cpu);
+    int mmap_task_fd = mmap_task_event_open(-1, cpu, event_driven_ring_buffer_reading_);
     std::string buffer_name = absl::StrFormat("mmap_task_%d", cpu);
-    PerfEventRingBuffer mmap_task_ring_buffer{mmap_task_fd, kMmapTaskRingBufferSizeKb, buffer_name};
+    PerfEventRingBuffer mmap_task_ring_buffer{mmap_task_fd, kMmapTaskRingBufferSizeKb, buffer_name,
+                                              cpu};
     if (mmap_task_ring_buffer.IsOpen()) {
       mmap_task_tracing_fds.push_back(mmap_task_fd);
       mmap_task_ring_buffers.push_back(std::move(mmap_task_ring_buffer));
@@ -438,12 +469,13 @@ bool TracerImpl::OpenSampling(absl::Span<const int32_t> cpus) {
     int sampling_fd{};
     switch (unwinding_method_) {
       case CaptureOptions::kFramePointers:
-        sampling_fd =
-            callchain_sample_event_open(sampling_period_ns_.value(), -1, cpu, stack_dump_size_);
+        sampling_fd = callchain_sample_event_open(sampling_period_ns_.value(), -1, cpu,
+                                                  stack_dump_size_,
+                                                  event_driven_ring_buffer_reading_);
         break;
       case CaptureOptions::kDwarf:
-        sampling_fd =
-            stack_sample_event_open(sampling_period_ns_.value(), -1, cpu, stack_dump_size_);
+        sampling_fd = stack_sample_event_open(sampling_period_ns_.value(), -1, cpu,
+                                              stack_dump_size_, event_driven_ring_buffer_reading_);
         break;
       case CaptureOptions::kUndefined:
       default:
@@ -453,7 +485,8 @@ bool TracerImpl::OpenSampling(absl::Span<const int32_t> cpus) {
     }
 
     std::string buffer_name = absl::StrFormat("sampling_%d", cpu);
-    PerfEventRingBuffer sampling_ring_buffer{sampling_fd, kSamplingRingBufferSizeKb, buffer_name};
+    PerfEventRingBuffer sampling_ring_buffer{sampling_fd, kSamplingRingBufferSizeKb, buffer_name,
+                                             cpu};
     if (sampling_ring_buffer.IsOpen()) {
       sampling_tracing_fds.push_back(sampling_fd);
       sampling_ring_buffers.push_back(std::move(sampling_ring_buffer));
@@ -500,7 +533,8 @@ static bool OpenFileDescriptorsAndRingBuffersForAllTracepoints(
     absl::flat_hash_map<std::string, std::vector<int>>* tracing_fds_by_type,
     uint64_t ring_buffer_size_kb,
     absl::flat_hash_map<int32_t, int>* tracepoint_ring_buffer_fds_per_cpu_for_redirection,
-    std::vector<PerfEventRingBuffer>* ring_buffers, uint32_t stack_dump_size = 0,
+    std::vector<PerfEventRingBuffer>* ring_buffers, bool wakeup_on_watermark,
+    uint32_t stack_dump_size = 0,
     const CaptureOptions::ThreadStateChangeCallStackCollection
         thread_state_change_callstack_collection =
             CaptureOptions::kNoThreadStateChangeCallStackCollection,
@@ -518,14 +552,15 @@ static bool OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       if (thread_state_change_callstack_collection ==
               CaptureOptions::kThreadStateChangeCallStackCollection &&
           unwinding_method == CaptureOptions::kFramePointers) {
-        tracepoint_fd = tracepoint_with_callchain_event_open(tracepoint_category, tracepoint_name,
-                                                             -1, cpu, stack_dump_size);
+        tracepoint_fd = tracepoint_with_callchain_event_open(
+            tracepoint_category, tracepoint_name, -1, cpu, stack_dump_size, wakeup_on_watermark);
       } else if (thread_state_change_callstack_collection ==
                  CaptureOptions::kThreadStateChangeCallStackCollection) {
         tracepoint_fd = tracepoint_with_stack_event_open(tracepoint_category, tracepoint_name, -1,
-                                                         cpu, stack_dump_size);
+                                                         cpu, stack_dump_size, wakeup_on_watermark);
       } else {
-        tracepoint_fd = tracepoint_event_open(tracepoint_category, tracepoint_name, -1, cpu);
+        tracepoint_fd = tracepoint_event_open(tracepoint_category, tracepoint_name, -1, cpu,
+                                              wakeup_on_watermark);
       }
       if (tracepoint_fd == -1) {
         ORBIT_ERROR("Opening %s:%s tracepoint for cpu %d", tracepoint_category, tracepoint_name,
@@ -580,7 +615,8 @@ bool TracerImpl::OpenThreadNameTracepoints(absl::Span<const int32_t> cpus) {
   return OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       {{"task", "task_newtask", &task_newtask_ids_}, {"task", "task_rename", &task_rename_ids_}},
       cpus, &tracing_fds_by_type_, kThreadNamesRingBufferSizeKb,
-      &thread_name_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
+      &thread_name_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_,
+      event_driven_ring_buffer_reading_);
 }
 
 void TracerImpl::InitSwitchesStatesNamesVisitor() {
@@ -638,8 +674,8 @@ bool TracerImpl::OpenContextSwitchAndThreadStateTracepoints(absl::Span<const int
   return OpenFileDescriptorsAndRingBuffersForAllTracepoints(
       tracepoints_to_open, cpus, &tracing_fds_by_type_, ring_buffer_size,
       &thread_state_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_,
-      thread_state_change_callstack_stack_dump_size_, thread_state_change_callstack_collection_,
-      unwinding_method_);
+      event_driven_ring_buffer_reading_, thread_state_change_callstack_stack_dump_size_,
+      thread_state_change_callstack_collection_, unwinding_method_);
 }
 
 void TracerImpl::InitGpuTracepointEventVisitor() {
@@ -668,7 +704,8 @@ bool TracerImpl::OpenGpuTracepoints(absl::Span<const int32_t> cpus) {
        {"amdgpu", "amdgpu_sched_run_job", &amdgpu_sched_run_job_ids_},
        {"dma_fence", "dma_fence_signaled", &dma_fence_signaled_ids_}},
       cpus, &tracing_fds_by_type_, kGpuTracingRingBufferSizeKb,
-      &gpu_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
+      &gpu_tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_,
+      event_driven_ring_buffer_reading_);
 }
 
 bool TracerImpl::OpenInstrumentedTracepoints(absl::Span<const int32_t> cpus) {
@@ -681,7 +718,7 @@ bool TracerImpl::OpenInstrumentedTracepoints(absl::Span<const int32_t> cpus) {
     tracepoint_event_open_errors |= !OpenFileDescriptorsAndRingBuffersForAllTracepoints(
         {{selected_tracepoint.category().c_str(), selected_tracepoint.name().c_str(), &stream_ids}},
         cpus, &tracing_fds_by_type_, kInstrumentedTracepointsRingBufferSizeKb,
-        &tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_);
+        &tracepoint_ring_buffer_fds_per_cpu, &ring_buffers_, event_driven_ring_buffer_reading_);
 
     for (const auto& stream_id : stream_ids) {
       ids_to_tracepoint_info_.emplace(stream_id, selected_tracepoint);
@@ -841,6 +878,10 @@ void TracerImpl::Startup() {
     listener_->OnErrorsWithPerfEventOpenEvent(std::move(errors_with_perf_event_open_event));
   }
 
+  for (const PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+    fds_to_last_timestamp_ns_.emplace(ring_buffer.GetFileDescriptor(), 0);
+  }
+
   // Start recording events.
   for (const auto& [unused_name, fds] : tracing_fds_by_type_) {
     for (int fd : fds) {
@@ -899,6 +940,7 @@ void TracerImpl::Startup() {
     RetrieveInitialThreadStatesOfTarget();
   }
 
+  absl::MutexLock lock{&stats_.mutex};
   stats_.Reset();
 }
 
@@ -937,7 +979,7 @@ void TracerImpl::Shutdown() {
   }
 }
 
-void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
+uint16_t TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
   uint64_t event_timestamp_ns = 0;
 
   perf_event_header header;
@@ -984,6 +1026,7 @@ void TracerImpl::ProcessOneRecord(PerfEventRingBuffer* ring_buffer) {
     fds_to_last_timestamp_ns_.insert_or_assign(ring_buffer->GetFileDescriptor(),
                                                event_timestamp_ns);
   }
+  return header.size;
 }
 
 void TracerImpl::Run() {
@@ -991,9 +1034,108 @@ void TracerImpl::Run() {
 
   Startup();
 
-  bool last_iteration_saw_events = false;
+  CreateRingBufferReaders();
   std::thread deferred_events_thread(&TracerImpl::ProcessDeferredEvents, this);
 
+  if (ring_buffer_readers_.empty()) {
+    std::vector<PerfEventRingBuffer*> ring_buffers;
+    ring_buffers.reserve(ring_buffers_.size());
+    for (PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+      ring_buffers.push_back(&ring_buffer);
+    }
+    ReadRingBuffers(ring_buffers);
+  } else {
+    for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+      reader->thread = std::thread(&TracerImpl::RunRingBufferReader, this, reader.get());
+    }
+    for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+      reader->thread.join();
+    }
+  }
+
+  // Finish processing all deferred events.
+  stop_deferred_thread_ = true;
+  deferred_events_thread.join();
+  event_processor_.ProcessAllEvents();
+  if (unwinding_worker_pool_ != nullptr) {
+    unwinding_worker_pool_->WaitForAndProcessAllRequests();
+  }
+
+  Shutdown();
+}
+
+void TracerImpl::ReadRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers) {
+  if (event_driven_ring_buffer_reading_) {
+    WaitForAndReadRingBuffers(ring_buffers);
+  } else {
+    PollRingBuffers(ring_buffers);
+  }
+}
+
+void TracerImpl::CreateRingBufferReaders() {
+  if (ring_buffer_reader_thread_count_ <= 1) {
+    return;
+  }
+
+  absl::flat_hash_map<int32_t, std::vector<PerfEventRingBuffer*>> ring_buffers_per_cpu;
+  for (PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+    ring_buffers_per_cpu[ring_buffer.GetCpu()].push_back(&ring_buffer);
+  }
+  std::vector<int32_t> cpus;
+  cpus.reserve(ring_buffers_per_cpu.size());
+  for (const auto& [cpu, unused_ring_buffers] : ring_buffers_per_cpu) {
+    cpus.push_back(cpu);
+  }
+  std::sort(cpus.begin(), cpus.end());
+
+  // Assign contiguous ranges of cpus to each reader, as neighboring cpus are more likely to share
+  // caches.
+  std::vector<std::vector<int32_t>> cpus_per_reader =
+      PartitionCpusIntoContiguousRanges(cpus, ring_buffer_reader_thread_count_);
+  if (cpus_per_reader.size() <= 1) {
+    return;
+  }
+  ORBIT_LOG("Reading ring buffers of %u cpus on %u threads", cpus.size(), cpus_per_reader.size());
+
+  ring_buffer_readers_.reserve(cpus_per_reader.size());
+  for (std::vector<int32_t>& cpus_of_reader : cpus_per_reader) {
+    auto reader = std::make_unique<RingBufferReader>();
+    for (int32_t cpu : cpus_of_reader) {
+      const std::vector<PerfEventRingBuffer*>& ring_buffers_of_cpu = ring_buffers_per_cpu.at(cpu);
+      reader->ring_buffers.insert(reader->ring_buffers.end(), ring_buffers_of_cpu.begin(),
+                                  ring_buffers_of_cpu.end());
+    }
+    reader->cpus = std::move(cpus_of_reader);
+    ring_buffer_readers_.emplace_back(std::move(reader));
+  }
+}
+
+// The queue to which DeferEvent adds PerfEvents, when called on one of the threads started by
+// TracerImpl::RunRingBufferReader.
+static thread_local moodycamel::ConcurrentQueue<PerfEvent>* ring_buffer_reader_deferred_events =
+    nullptr;
+
+void TracerImpl::RunRingBufferReader(RingBufferReader* reader) {
+  orbit_base::SetCurrentThreadName(absl::StrFormat("RingBuffers#%d", reader->cpus.front()).c_str());
+
+  // The ring buffers are written on these cpus, so reading them here keeps their content in the
+  // local caches.
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int32_t cpu : reader->cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    ORBIT_ERROR("Pinning ring buffer reader thread: %s", SafeStrerror(errno));
+  }
+
+  ring_buffer_reader_deferred_events = &reader->deferred_events;
+  ReadRingBuffers(reader->ring_buffers);
+  ring_buffer_reader_deferred_events = nullptr;
+}
+
+void TracerImpl::PollRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers) {
+  bool last_iteration_saw_events = false;
   while (!stop_run_thread_) {
     ORBIT_SCOPE("TracerThread::Run iteration");
 
@@ -1014,7 +1156,7 @@ void TracerImpl::Run() {
     // Read and process events from all ring buffers. In order to ensure that no
     // buffer is read constantly while others overflow, we schedule the reading
     // using round-robin like scheduling.
-    for (PerfEventRingBuffer& ring_buffer : ring_buffers_) {
+    for (PerfEventRingBuffer* ring_buffer : ring_buffers) {
       if (stop_run_thread_) {
         break;
       }
@@ -1028,22 +1170,98 @@ void TracerImpl::Run() {
         if (stop_run_thread_) {
           break;
         }
-        if (!ring_buffer.HasNewData()) {
+        if (!ring_buffer->HasNewData()) {
           break;
         }
 
         last_iteration_saw_events = true;
-        ProcessOneRecord(&ring_buffer);
+        ProcessOneRecord(ring_buffer);
       }
     }
   }
+}
 
-  // Finish processing all deferred events.
-  stop_deferred_thread_ = true;
-  deferred_events_thread.join();
-  event_processor_.ProcessAllEvents();
+void TracerImpl::WaitForAndReadRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers) {
+  int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd == -1) {
+    ORBIT_ERROR("epoll_create1: %s", SafeStrerror(errno));
+    PollRingBuffers(ring_buffers);
+    return;
+  }
 
-  Shutdown();
+  for (PerfEventRingBuffer* ring_buffer : ring_buffers) {
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = ring_buffer->GetFileDescriptor();
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, ring_buffer->GetFileDescriptor(), &event) != 0) {
+      // The ring buffer will still be read when waiting for another ring buffer times out.
+      ORBIT_ERROR("epoll_ctl adding ring buffer '%s': %s", ring_buffer->GetName(),
+                  SafeStrerror(errno));
+    }
+  }
+
+  std::vector<epoll_event> ready_events(std::max<size_t>(ring_buffers.size(), 1));
+  while (!stop_run_thread_) {
+    ORBIT_SCOPE("TracerThread::Run iteration");
+
+    // Periodically print event statistics.
+    PrintStatsIfTimerElapsed();
+
+    int ready_count = 0;
+    {
+      ORBIT_SCOPE("epoll_wait");
+      ready_count = epoll_wait(epoll_fd, ready_events.data(), static_cast<int>(ready_events.size()),
+                               kRingBufferEpollTimeoutMs);
+    }
+    if (ready_count == -1 && errno != EINTR) {
+      ORBIT_ERROR("epoll_wait: %s", SafeStrerror(errno));
+    }
+    for (int i = 0; i < ready_count; ++i) {
+      // The perf_event_open file descriptor keeps reporting EPOLLHUP once the event can no longer
+      // produce records, e.g., because the thread it was attached to exited. Stop waiting on it so
+      // that epoll_wait doesn't keep returning immediately. What is left in the ring buffer is
+      // still read below.
+      if ((ready_events[i].events & (EPOLLHUP | EPOLLERR)) != 0) {
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, ready_events[i].data.fd, nullptr);
+      }
+    }
+
+    // Read all ring buffers, not just the ones that reached the watermark: this way, ring buffers
+    // that receive few events are not delayed, even when epoll_wait doesn't time out. Under
+    // sustained load the ring buffers might never become empty, so the number of passes is
+    // limited, for the loop to still check for stop requests and print statistics.
+    DrainRingBuffers(ring_buffers, kMaxRingBufferDrainPassesPerWakeup);
+  }
+
+  close(epoll_fd);
+}
+
+void TracerImpl::DrainRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers,
+                                  uint32_t max_pass_count) {
+  ORBIT_SCOPE_FUNCTION;
+  bool last_pass_saw_events = true;
+  for (uint32_t pass = 0; pass < max_pass_count && last_pass_saw_events && !stop_run_thread_;
+       ++pass) {
+    last_pass_saw_events = false;
+    for (PerfEventRingBuffer* ring_buffer : ring_buffers) {
+      if (stop_run_thread_) {
+        break;
+      }
+      const uint64_t new_data_size = ring_buffer->GetNewDataSize();
+      if (new_data_size == 0) {
+        continue;
+      }
+      last_pass_saw_events = true;
+
+      // Read a share of the new data proportional to how much new data there is, so that no
+      // ring buffer overflows while others are being read.
+      const uint64_t size_to_read = new_data_size / kRingBufferDrainPasses;
+      uint64_t size_read = 0;
+      do {
+        size_read += ProcessOneRecord(ring_buffer);
+      } while (size_read < size_to_read && !stop_run_thread_);
+    }
+  }
 }
 
 uint64_t TracerImpl::ProcessForkEventAndReturnTimestamp(const perf_event_header& header,
@@ -1459,7 +1677,10 @@ uint64_t TracerImpl::ProcessLostEventAndReturnTimestamp(const perf_event_header&
   uint64_t timestamp = ring_buffer_record.sample_id.time;
 
   stats_.lost_count += ring_buffer_record.lost;
-  stats_.lost_count_per_buffer[ring_buffer] += ring_buffer_record.lost;
+  {
+    absl::MutexLock lock{&stats_.mutex};
+    stats_.lost_count_per_buffer[ring_buffer] += ring_buffer_record.lost;
+  }
 
   // Fetch the timestamp of the last event that preceded this PERF_RECORD_LOST in this same ring
   // buffer.
@@ -1514,6 +1735,10 @@ uint64_t TracerImpl::ProcessThrottleUnthrottleEventAndReturnTimestamp(
 }
 
 void TracerImpl::DeferEvent(PerfEvent&& event) {
+  if (ring_buffer_reader_deferred_events != nullptr) {
+    ring_buffer_reader_deferred_events->enqueue(std::move(event));
+    return;
+  }
   absl::MutexLock lock{&deferred_events_being_buffered_mutex_};
   deferred_events_being_buffered_.emplace_back(std::move(event));
 }
@@ -1531,8 +1756,15 @@ void TracerImpl::ProcessDeferredEvents() {
       absl::MutexLock lock{&deferred_events_being_buffered_mutex_};
       deferred_events_being_buffered_.swap(deferred_events_to_process_);
     }
+    for (std::unique_ptr<RingBufferReader>& reader : ring_buffer_readers_) {
+      reader->deferred_events.try_dequeue_bulk(std::back_inserter(deferred_events_to_process_),
+                                               reader->deferred_events.size_approx());
+    }
 
     if (deferred_events_to_process_.empty()) {
+      if (unwinding_worker_pool_ != nullptr) {
+        unwinding_worker_pool_->ProcessFinishedRequests();
+      }
       ORBIT_SCOPE("Sleep");
       usleep(kIdleTimeOnEmptyDeferredEventsUs);
       continue;
@@ -1552,6 +1784,10 @@ void TracerImpl::ProcessDeferredEvents() {
       ORBIT_SCOPE("ProcessOldEvents");
       event_processor_.ProcessOldEvents();
     }
+    if (unwinding_worker_pool_ != nullptr) {
+      ORBIT_SCOPE("ProcessFinishedUnwindingRequests");
+      unwinding_worker_pool_->ProcessFinishedRequests();
+    }
   }
 }
 
@@ -1577,6 +1813,7 @@ void TracerImpl::RetrieveInitialThreadStatesOfTarget() {
 void TracerImpl::Reset() {
   ORBIT_SCOPE_FUNCTION;
   tracing_fds_by_type_.clear();
+  ring_buffer_readers_.clear();
   ring_buffers_.clear();
   fds_to_last_timestamp_ns_.clear();
 
@@ -1608,6 +1845,8 @@ void TracerImpl::Reset() {
     deferred_events_being_buffered_.clear();
   }
   deferred_events_to_process_.clear();
+  // The callbacks of the requests still pending in the pool reference the visitor.
+  unwinding_worker_pool_.reset();
   uprobes_unwinding_visitor_.reset();
   leaf_function_call_manager_.reset();
   return_address_manager_.reset();
@@ -1618,6 +1857,8 @@ void TracerImpl::Reset() {
 
 void TracerImpl::PrintStatsIfTimerElapsed() {
   ORBIT_SCOPE_FUNCTION;
+  // With multiple RingBufferReaders, this can be called by any of them.
+  absl::MutexLock lock{&stats_.mutex};
   uint64_t timestamp_ns = orbit_base::CaptureTimestampNs();
   if (stats_.event_count_begin_ns + kEventStatsWindowS * kNsPerSecond >= timestamp_ns) {
     return;
@@ -1628,22 +1869,26 @@ void TracerImpl::PrintStatsIfTimerElapsed() {
   ORBIT_CHECK(actual_window_s > 0.0);
 
   ORBIT_LOG("Events per second (and total) last %.3f s:", actual_window_s);
-  ORBIT_LOG("  sched switches: %.0f/s (%lu)", stats_.sched_switch_count / actual_window_s,
-            stats_.sched_switch_count);
-  ORBIT_LOG("  samples: %.0f/s (%lu)", stats_.sample_count / actual_window_s, stats_.sample_count);
-  ORBIT_LOG("  u(ret)probes: %.0f/s (%lu)", stats_.uprobes_count / actual_window_s,
-            stats_.uprobes_count);
-  ORBIT_LOG("  uprobes with stack: %.0f/s (%lu)", stats_.uprobes_with_stack_count / actual_window_s,
-            stats_.uprobes_with_stack_count);
-  ORBIT_LOG("  gpu events: %.0f/s (%lu)", stats_.gpu_events_count / actual_window_s,
-            stats_.gpu_events_count);
-  ORBIT_LOG("  mmap events: %.0f/s (%lu)", stats_.mmap_count / actual_window_s, stats_.mmap_count);
-
+  uint64_t sched_switch_count = stats_.sched_switch_count;
+  ORBIT_LOG("  sched switches: %.0f/s (%lu)", sched_switch_count / actual_window_s,
+            sched_switch_count);
+  uint64_t sample_count = stats_.sample_count;
+  ORBIT_LOG("  samples: %.0f/s (%lu)", sample_count / actual_window_s, sample_count);
+  uint64_t uprobes_count = stats_.uprobes_count;
+  ORBIT_LOG("  u(ret)probes: %.0f/s (%lu)", uprobes_count / actual_window_s, uprobes_count);
+  uint64_t uprobes_with_stack_count = stats_.uprobes_with_stack_count;
+  ORBIT_LOG("  uprobes with stack: %.0f/s (%lu)", uprobes_with_stack_count / actual_window_s,
+            uprobes_with_stack_count);
+  uint64_t gpu_events_count = stats_.gpu_events_count;
+  ORBIT_LOG("  gpu events: %.0f/s (%lu)", gpu_events_count / actual_window_s, gpu_events_count);
+  uint64_t mmap_count = stats_.mmap_count;
+  ORBIT_LOG("  mmap events: %.0f/s (%lu)", mmap_count / actual_window_s, mmap_count);
+
+  uint64_t lost_count = stats_.lost_count;
   if (stats_.lost_count_per_buffer.empty()) {
-    ORBIT_LOG("  lost: %.0f/s (%lu)", stats_.lost_count / actual_window_s, stats_.lost_count);
+    ORBIT_LOG("  lost: %.0f/s (%lu)", lost_count / actual_window_s, lost_count);
   } else {
-    ORBIT_LOG("  LOST: %.0f/s (%lu), of which:", stats_.lost_count / actual_window_s,
-              stats_.lost_count);
+    ORBIT_LOG("  LOST: %.0f/s (%lu), of which:", lost_count / actual_window_s, lost_count);
     for (const auto& buffer_and_lost_count : stats_.lost_count_per_buffer) {
       ORBIT_LOG("    from %s: %.0f/s (%lu)", buffer_and_lost_count.first->GetName().c_str(),
                 buffer_and_lost_count.second / actual_window_s, buffer_and_lost_count.second);
@@ -1661,12 +1906,12 @@ void TracerImpl::PrintStatsIfTimerElapsed() {
 
   uint64_t unwind_error_count = stats_.unwind_error_count;
   ORBIT_LOG("  unwind errors: %.0f/s (%lu) [%.1f%%]", unwind_error_count / actual_window_s,
-            unwind_error_count, 100.0 * unwind_error_count / stats_.sample_count);
+            unwind_error_count, 100.0 * unwind_error_count / sample_count);
   uint64_t discarded_samples_in_uretprobes_count = stats_.samples_in_uretprobes_count;
   ORBIT_LOG("  samples in u(ret)probes: %.0f/s (%lu) [%.1f%%]",
             discarded_samples_in_uretprobes_count / actual_window_s,
             discarded_samples_in_uretprobes_count,
-            100.0 * discarded_samples_in_uretprobes_count / stats_.sample_count);
+            100.0 * discarded_samples_in_uretprobes_count / sample_count);
 
   uint64_t thread_state_count = stats_.thread_state_count;
   ORBIT_LOG("  target's thread states: %.0f/s (%lu)", thread_state_count / actual_window_s,
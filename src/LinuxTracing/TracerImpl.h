@@ -37,10 +37,12 @@
 #include "PerfEvent.h"
 #include "PerfEventProcessor.h"
 #include "PerfEventRingBuffer.h"
+#include "StackUnwindingWorkerPool.h"
 #include "SwitchesStatesNamesVisitor.h"
 #include "UprobesFunctionCallManager.h"
 #include "UprobesReturnAddressManager.h"
 #include "UprobesUnwindingVisitor.h"
+#include "concurrentqueue.h"
 
 namespace orbit_linux_tracing {
 
@@ -63,22 +65,43 @@ class TracerImpl : public Tracer {
   void ProcessFunctionExit(const orbit_grpc_protos::FunctionExit& function_exit) override;
 
  private:
+  // A thread that reads a subset of the ring buffers, when reading is spread across multiple
+  // threads. Each of these threads reads all the ring buffers of the cpus it is pinned to, and
+  // defers the resulting PerfEvents to its own queue. As every ring buffer, hence every
+  // PerfEventOrderedStream::FileDescriptor, is read by only one of these threads, and the queues
+  // are FIFO, the order of the events in each ordered stream is preserved.
+  struct RingBufferReader {
+    std::vector<int32_t> cpus;
+    std::vector<PerfEventRingBuffer*> ring_buffers;
+    moodycamel::ConcurrentQueue<PerfEvent> deferred_events;
+    std::thread thread;
+  };
+
   void Run();
+  void PollRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers);
+  void WaitForAndReadRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers);
+  // Reads the ring buffers in passes until they are empty, but in at most `max_pass_count` passes.
+  void DrainRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers,
+                        uint32_t max_pass_count);
+  void ReadRingBuffers(absl::Span<PerfEventRingBuffer* const> ring_buffers);
+  void CreateRingBufferReaders();
+  void RunRingBufferReader(RingBufferReader* reader);
   void Startup();
   void Shutdown();
-  void ProcessOneRecord(PerfEventRingBuffer* ring_buffer);
+  // Returns the size of the record that was processed.
+  uint16_t ProcessOneRecord(PerfEventRingBuffer* ring_buffer);
   void InitUprobesEventVisitor();
   [[nodiscard]] bool OpenUserSpaceProbes(absl::Span<const int32_t> cpus);
   [[nodiscard]] bool OpenUprobesToRecordAdditionalStackOn(absl::Span<const int32_t> cpus);
-  [[nodiscard]] static bool OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& function,
-                                        absl::Span<const int32_t> cpus,
-                                        absl::flat_hash_map<int32_t, int>* fds_per_cpu);
+  [[nodiscard]] bool OpenUprobes(const orbit_grpc_protos::InstrumentedFunction& function,
+                                 absl::Span<const int32_t> cpus,
+                                 absl::flat_hash_map<int32_t, int>* fds_per_cpu) const;
   [[nodiscard]] bool OpenUprobesWithStack(
       const orbit_grpc_protos::FunctionToRecordAdditionalStackOn& function,
       absl::Span<const int32_t> cpus, absl::flat_hash_map<int32_t, int>* fds_per_cpu) const;
-  [[nodiscard]] static bool OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& function,
-                                           absl::Span<const int32_t> cpus,
-                                           absl::flat_hash_map<int32_t, int>* fds_per_cpu);
+  [[nodiscard]] bool OpenUretprobes(const orbit_grpc_protos::InstrumentedFunction& function,
+                                    absl::Span<const int32_t> cpus,
+                                    absl::flat_hash_map<int32_t, int>* fds_per_cpu) const;
   [[nodiscard]] bool OpenMmapTask(absl::Span<const int32_t> cpus);
   [[nodiscard]] bool OpenSampling(absl::Span<const int32_t> cpus);
 
@@ -140,6 +163,17 @@ class TracerImpl : public Tracer {
   static constexpr uint64_t kUprobesWithStackRingBufferSizeKb = 64 * 1024;
 
   static constexpr uint32_t kIdleTimeOnEmptyRingBuffersUs = 5000;
+
+  // When the ring buffers are waited on with epoll, this is the maximum time to wait for one of
+  // them to reach kRingBufferWakeupWatermarkBytes. Ring buffers that receive few events are read at
+  // least this often. This needs to stay well below PerfEventProcessor::kProcessingDelayMs.
+  static constexpr int kRingBufferEpollTimeoutMs = 50;
+  // When the ring buffers are waited on with epoll, each pass over the ring buffers reads
+  // 1/kRingBufferDrainPasses of the data each of them contains (but at least one record), so that
+  // the ring buffers that are fuller are also drained faster.
+  static constexpr uint64_t kRingBufferDrainPasses = 4;
+  // The maximum number of such passes after each wakeup from epoll_wait.
+  static constexpr uint32_t kMaxRingBufferDrainPassesPerWakeup = 4 * kRingBufferDrainPasses;
   static constexpr uint32_t kIdleTimeOnEmptyDeferredEventsUs = 5000;
 
   bool trace_context_switches_;
@@ -148,6 +182,10 @@ class TracerImpl : public Tracer {
   std::optional<uint64_t> sampling_period_ns_;
   uint16_t stack_dump_size_;
   orbit_grpc_protos::CaptureOptions::UnwindingMethod unwinding_method_;
+  uint32_t dwarf_unwinding_thread_count_;
+  bool event_driven_ring_buffer_reading_;
+  uint32_t ring_buffer_reader_thread_count_;
+  bool intern_callstacks_;
   orbit_grpc_protos::CaptureOptions::ThreadStateChangeCallStackCollection
       thread_state_change_callstack_collection_;
   uint16_t thread_state_change_callstack_stack_dump_size_;
@@ -168,7 +206,11 @@ class TracerImpl : public Tracer {
 
   absl::flat_hash_map<std::string, std::vector<int>> tracing_fds_by_type_;
   std::vector<PerfEventRingBuffer> ring_buffers_;
+  // Contains an entry for each ring buffer before reading starts, so that it is never modified
+  // structurally while the ring buffers are read, possibly by multiple RingBufferReaders.
   absl::flat_hash_map<int, uint64_t> fds_to_last_timestamp_ns_;
+  // Empty unless ring buffer reading is spread across multiple threads.
+  std::vector<std::unique_ptr<RingBufferReader>> ring_buffer_readers_;
 
   absl::flat_hash_map<uint64_t, uint64_t> uprobes_uretprobes_ids_to_function_id_;
   absl::flat_hash_set<uint64_t> uprobes_ids_;
@@ -204,14 +246,16 @@ class TracerImpl : public Tracer {
   std::unique_ptr<LibunwindstackMaps> maps_;
   std::unique_ptr<LibunwindstackUnwinder> unwinder_;
   std::unique_ptr<LeafFunctionCallManager> leaf_function_call_manager_;
+  std::unique_ptr<StackUnwindingWorkerPool> unwinding_worker_pool_;
   std::unique_ptr<UprobesUnwindingVisitor> uprobes_unwinding_visitor_;
   std::unique_ptr<SwitchesStatesNamesVisitor> switches_states_names_visitor_;
   std::unique_ptr<GpuTracepointVisitor> gpu_event_visitor_;
   std::unique_ptr<LostAndDiscardedEventVisitor> lost_and_discarded_event_visitor_;
   PerfEventProcessor event_processor_;
 
+  // The counters can be incremented by multiple RingBufferReaders at the same time.
   struct EventStats {
-    void Reset() {
+    void Reset() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
       event_count_begin_ns = orbit_base::CaptureTimestampNs();
       sched_switch_count = 0;
       sample_count = 0;
@@ -227,15 +271,17 @@ class TracerImpl : public Tracer {
       thread_state_count = 0;
     }
 
-    uint64_t event_count_begin_ns = 0;
-    uint64_t sched_switch_count = 0;
-    uint64_t sample_count = 0;
-    uint64_t uprobes_count = 0;
-    uint64_t uprobes_with_stack_count = 0;
-    uint64_t gpu_events_count = 0;
-    uint64_t mmap_count = 0;
-    uint64_t lost_count = 0;
-    absl::flat_hash_map<PerfEventRingBuffer*, uint64_t> lost_count_per_buffer{};
+    absl::Mutex mutex;
+    uint64_t event_count_begin_ns ABSL_GUARDED_BY(mutex) = 0;
+    std::atomic<uint64_t> sched_switch_count = 0;
+    std::atomic<uint64_t> sample_count = 0;
+    std::atomic<uint64_t> uprobes_count = 0;
+    std::atomic<uint64_t> uprobes_with_stack_count = 0;
+    std::atomic<uint64_t> gpu_events_count = 0;
+    std::atomic<uint64_t> mmap_count = 0;
+    std::atomic<uint64_t> lost_count = 0;
+    absl::flat_hash_map<PerfEventRingBuffer*, uint64_t> lost_count_per_buffer
+        ABSL_GUARDED_BY(mutex){};
     std::atomic<uint64_t> discarded_out_of_order_count = 0;
     std::atomic<uint64_t> unwind_error_count = 0;
     std::atomic<uint64_t> samples_in_uretprobes_count = 0;
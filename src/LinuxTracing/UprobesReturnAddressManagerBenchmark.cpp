@@ -0,0 +1,80 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <benchmark/benchmark.h>
+#include <sys/types.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "BenchmarkUtils.h"
+#include "UprobesReturnAddressManager.h"
+
+namespace orbit_linux_tracing {
+
+namespace {
+
+constexpr uint64_t kStackTop = 0x7fff'ffff'0000;
+constexpr uint64_t kFrameSize = 128;
+
+// Simulates `state.range(0)` threads, each entering and then exiting `state.range(1)` nested
+// dynamically instrumented functions.
+void BM_UprobesReturnAddressManagerFunctionEntryAndExit(benchmark::State& state) {
+  const auto thread_count = static_cast<pid_t>(state.range(0));
+  const auto depth = static_cast<uint64_t>(state.range(1));
+
+  UprobesReturnAddressManager return_address_manager{nullptr};
+  for (auto _ : state) {
+    for (uint64_t level = 0; level < depth; ++level) {
+      for (pid_t tid = 1; tid <= thread_count; ++tid) {
+        return_address_manager.ProcessFunctionEntry(tid, kStackTop - level * kFrameSize,
+                                                    /*return_address=*/0x1000 + level);
+      }
+    }
+    for (uint64_t level = 0; level < depth; ++level) {
+      for (pid_t tid = 1; tid <= thread_count; ++tid) {
+        return_address_manager.ProcessFunctionExit(tid);
+      }
+    }
+  }
+
+  // Each iteration processes one entry and one exit per thread and level.
+  SetEventCounters(state, state.iterations() * 2 * thread_count * static_cast<int64_t>(depth));
+}
+
+// Measures patching the return addresses of `state.range(0)` open functions into a stack sample of
+// `state.range(1)` bytes, as done for every stack sample taken while instrumented functions run.
+void BM_UprobesReturnAddressManagerPatchSample(benchmark::State& state) {
+  const auto depth = static_cast<uint64_t>(state.range(0));
+  const auto stack_size = static_cast<uint64_t>(state.range(1));
+  constexpr pid_t kTid = 1;
+
+  UprobesReturnAddressManager return_address_manager{nullptr};
+  for (uint64_t level = 0; level < depth; ++level) {
+    return_address_manager.ProcessFunctionEntry(kTid, kStackTop - level * kFrameSize,
+                                                /*return_address=*/0x1000 + level);
+  }
+
+  const uint64_t stack_pointer = kStackTop - depth * kFrameSize;
+  std::vector<uint8_t> stack_data(stack_size);
+  for (auto _ : state) {
+    return_address_manager.PatchSample(kTid, stack_pointer, stack_data.data(), stack_data.size());
+    benchmark::ClobberMemory();
+  }
+
+  SetEventCounters(state, state.iterations());
+}
+
+}  // namespace
+
+BENCHMARK(BM_UprobesReturnAddressManagerFunctionEntryAndExit)
+    ->Args({1, 16})
+    ->Args({64, 16})
+    ->Args({64, 128});
+BENCHMARK(BM_UprobesReturnAddressManagerPatchSample)
+    ->Args({4, 64 * 1024})
+    ->Args({64, 64 * 1024})
+    ->Args({512, 64 * 1024});
+
+}  // namespace orbit_linux_tracing
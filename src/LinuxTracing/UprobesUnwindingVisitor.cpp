@@ -14,18 +14,21 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "LibunwindstackMultipleOfflineAndProcessMemory.h"
 #include "ModuleUtils/ReadLinuxModules.h"
 #include "OrbitBase/Logging.h"
+#include "OrbitBase/MakeUniqueForOverwrite.h"
 #include "OrbitBase/Result.h"
 #include "PerfEvent.h"
 #include "unwindstack/Arch.h"
@@ -35,9 +38,11 @@
 namespace orbit_linux_tracing {
 
 using orbit_grpc_protos::Callstack;
+using orbit_grpc_protos::CallstackSample;
 using orbit_grpc_protos::FullAddressInfo;
 using orbit_grpc_protos::FullCallstackSample;
 using orbit_grpc_protos::FunctionCall;
+using orbit_grpc_protos::InternedCallstack;
 using orbit_grpc_protos::ThreadStateSliceCallstack;
 
 static bool CallstackIsInUserSpaceInstrumentation(
@@ -138,6 +143,16 @@ void UprobesUnwindingVisitor::SendFullAddressInfoToListener(
   listener_->OnAddressInfo(std::move(address_info));
 }
 
+[[nodiscard]] static CallstackSample CreateCallstackSample(
+    const FullCallstackSample& sample_without_callstack, uint64_t callstack_id) {
+  CallstackSample callstack_sample;
+  callstack_sample.set_pid(sample_without_callstack.pid());
+  callstack_sample.set_tid(sample_without_callstack.tid());
+  callstack_sample.set_timestamp_ns(sample_without_callstack.timestamp_ns());
+  callstack_sample.set_callstack_id(callstack_id);
+  return callstack_sample;
+}
+
 static inline bool IsPcInFunctionsToStopAt(
     const std::map<uint64_t, uint64_t>* absolute_address_to_size_of_functions_to_stop_at,
     uint64_t pc) {
@@ -221,27 +236,23 @@ UprobesUnwindingVisitor::ComputeCallstackTypeFromStackSample(
   return Callstack::kComplete;
 }
 
-template <typename StackPerfEventDataT>
-bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
-                                          Callstack* resulting_callstack,
-                                          bool offline_memory_only) {
+// Unwinds the stack of `event_data` and calls `on_unwound` with the LibunwindstackResult. When
+// `offload_to_worker_pool` is true and unwinding_worker_pool_ is set, the actual unwinding happens
+// on one of its workers and `on_unwound` is called later, but still in the order in which the
+// events were visited. Everything that depends on the order of the events, i.e., patching the
+// stack, happens here, synchronously.
+template <typename StackPerfEventDataT, typename OnUnwoundT>
+void UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
+                                          bool offline_memory_only, bool offload_to_worker_pool,
+                                          OnUnwoundT&& on_unwound) {
   ORBIT_CHECK(listener_ != nullptr);
   ORBIT_CHECK(current_maps_ != nullptr);
 
   return_address_manager_->PatchSample(event_data.GetCallstackTid(), event_data.GetRegisters().sp,
                                        event_data.GetMutableStackData(), event_data.GetStackSize());
 
-  StackSliceView event_stack_slice{event_data.GetRegisters().sp, event_data.GetStackSize(),
-                                   event_data.GetStackData()};
-  std::vector<StackSliceView> stack_slices{event_stack_slice};
   const auto& stream_id_to_user_stack =
       thread_id_stream_id_to_stack_slices_.find(event_data.GetCallstackTid());
-  if (stream_id_to_user_stack != thread_id_stream_id_to_stack_slices_.end()) {
-    for (const auto& [unused_stream_id, user_stack_slice] : stream_id_to_user_stack->second) {
-      stack_slices.emplace_back(user_stack_slice.start_address, user_stack_slice.size,
-                                user_stack_slice.data.get());
-    }
-  }
 
   // There might be rare cases where the callstack's pid is "-1". This happens on callstacks on
   // "sched out" switches where the thread exits. This is not a big problem for unwinding, as
@@ -250,10 +261,52 @@ bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
   // But this is not likely to happen.
   // TODO(b/246519821) It would be possible to retrieve the information from
   //  SwitchesStatesNamesVisitor::GetPidOfTid, but this requires major refactoring.
+  if (offload_to_worker_pool && unwinding_worker_pool_ != nullptr) {
+    StackUnwindingWorkerPool::UnwindingRequest request{
+        .pid = event_data.GetCallstackPidOrMinusOne(),
+        .tid = event_data.GetCallstackTid(),
+        .registers = event_data.GetRegistersAsArray(),
+        .stack_slices = {},
+        .offline_memory_only = offline_memory_only};
+    // The request owns a copy of the stack data, as the event will be gone by the time a worker
+    // unwinds it. Copying is cheap compared to unwinding.
+    std::shared_ptr<uint8_t[]> stack_data =
+        make_unique_for_overwrite<uint8_t[]>(event_data.GetStackSize());
+    std::memcpy(stack_data.get(), event_data.GetStackData(), event_data.GetStackSize());
+    request.stack_slices.push_back({.start_address = event_data.GetRegisters().sp,
+                                    .size = event_data.GetStackSize(),
+                                    .data = std::move(stack_data)});
+    if (stream_id_to_user_stack != thread_id_stream_id_to_stack_slices_.end()) {
+      for (const auto& [unused_stream_id, user_stack_slice] : stream_id_to_user_stack->second) {
+        request.stack_slices.push_back({.start_address = user_stack_slice.start_address,
+                                        .size = user_stack_slice.size,
+                                        .data = user_stack_slice.data});
+      }
+    }
+    unwinding_worker_pool_->ScheduleUnwinding(
+        std::move(request),
+        StackUnwindingWorkerPool::ResultCallback{std::forward<OnUnwoundT>(on_unwound)});
+    return;
+  }
+
+  StackSliceView event_stack_slice{event_data.GetRegisters().sp, event_data.GetStackSize(),
+                                   event_data.GetStackData()};
+  std::vector<StackSliceView> stack_slices{event_stack_slice};
+  if (stream_id_to_user_stack != thread_id_stream_id_to_stack_slices_.end()) {
+    for (const auto& [unused_stream_id, user_stack_slice] : stream_id_to_user_stack->second) {
+      stack_slices.emplace_back(user_stack_slice.start_address, user_stack_slice.size,
+                                user_stack_slice.data.get());
+    }
+  }
+
   LibunwindstackResult libunwindstack_result =
       unwinder_->Unwind(event_data.GetCallstackPidOrMinusOne(), current_maps_->Get(),
                         event_data.GetRegistersAsArray(), stack_slices, offline_memory_only);
+  on_unwound(libunwindstack_result);
+}
 
+bool UprobesUnwindingVisitor::FillCallstackFromLibunwindstackResult(
+    const LibunwindstackResult& libunwindstack_result, Callstack* resulting_callstack) {
   if (libunwindstack_result.frames().empty()) {
     // Even with unwinding errors this is not expected because we should at least get the program
     // counter. Do nothing in case this doesn't hold for a reason we don't know.
@@ -271,6 +324,46 @@ bool UprobesUnwindingVisitor::UnwindStack(const StackPerfEventDataT& event_data,
   return true;
 }
 
+CallstackTrie::Cursor* UprobesUnwindingVisitor::GetCallstackTrieCursor(pid_t tid) {
+  if (callstack_trie_cursor_per_thread_.size() >= kMaxCallstackTrieCursorCount &&
+      !callstack_trie_cursor_per_thread_.contains(tid)) {
+    callstack_trie_cursor_per_thread_.clear();
+  }
+  return &callstack_trie_cursor_per_thread_[tid];
+}
+
+std::optional<uint64_t> UprobesUnwindingVisitor::InternCallstackFromLibunwindstackResult(
+    const LibunwindstackResult& libunwindstack_result, pid_t callstack_tid) {
+  const std::vector<unwindstack::FrameData>& frames = libunwindstack_result.frames();
+  if (frames.empty()) {
+    ORBIT_ERROR("Unwound callstack has no frames");
+    return std::nullopt;
+  }
+
+  const Callstack::CallstackType type = ComputeCallstackTypeFromStackSample(libunwindstack_result);
+  auto [callstack_id, is_new] = callstack_trie_.GetOrInsert(
+      type, frames.size(), [&frames](size_t index) { return frames[index].pc; },
+      GetCallstackTrieCursor(callstack_tid));
+  if (!is_new) {
+    // The FullAddressInfos for all the frames were already sent with the callstack. Note that
+    // callstacks from callchains, which come without FullAddressInfos, are not mixed with
+    // DWARF-unwound callstacks in the same capture.
+    return callstack_id;
+  }
+
+  InternedCallstack interned_callstack;
+  interned_callstack.set_key(callstack_id);
+  Callstack* callstack = interned_callstack.mutable_intern();
+  callstack->set_type(type);
+  callstack->mutable_pcs()->Reserve(static_cast<int>(frames.size()));
+  for (const unwindstack::FrameData& libunwindstack_frame : frames) {
+    SendFullAddressInfoToListener(libunwindstack_frame);
+    callstack->add_pcs(libunwindstack_frame.pc);
+  }
+  listener_->OnInternedCallstack(std::move(interned_callstack));
+  return callstack_id;
+}
+
 void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
                                     const StackSamplePerfEventData& event_data) {
   FullCallstackSample sample;
@@ -278,13 +371,30 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   sample.set_tid(event_data.tid);
   sample.set_timestamp_ns(event_timestamp);
 
-  const bool success = UnwindStack(event_data, sample.mutable_callstack());
-
-  if (!success) {
-    return;
-  }
-
-  listener_->OnCallstackSample(std::move(sample));
+  // Callstack samples are not needed by other events, so they can be delivered later than the
+  // events visited after them, see SetStackUnwindingWorkerPool.
+  UnwindStack(event_data, /*offline_memory_only=*/false, /*offload_to_worker_pool=*/true,
+              [this, sample = std::move(sample)](
+                  const LibunwindstackResult& libunwindstack_result) mutable {
+                if (intern_callstacks_) {
+                  std::optional<uint64_t> callstack_id =
+                      InternCallstackFromLibunwindstackResult(libunwindstack_result, sample.tid());
+                  if (!callstack_id.has_value()) {
+                    return;
+                  }
+                  listener_->OnInternedCallstackSample(
+                      CreateCallstackSample(sample, callstack_id.value()));
+                  return;
+                }
+
+                const bool success = FillCallstackFromLibunwindstackResult(
+                    libunwindstack_result, sample.mutable_callstack());
+                if (!success) {
+                  return;
+                }
+
+                listener_->OnCallstackSample(std::move(sample));
+              });
 }
 
 void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
@@ -293,14 +403,32 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   thread_state_slice_callstack.set_thread_state_slice_tid(event_data.woken_tid);
   thread_state_slice_callstack.set_timestamp_ns(event_timestamp);
 
-  const bool success = UnwindStack(event_data, thread_state_slice_callstack.mutable_callstack(),
-                                   /*offline_memory_only=*/true);
-
-  if (!success) {
-    return;
-  }
-
-  listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+  // Not offloaded: ProducerEventProcessor merges the ThreadStateSliceCallstack into the
+  // ThreadStateSlice that SwitchesStatesNamesVisitor emits when it visits a later event, so it must
+  // reach the listener first.
+  UnwindStack(event_data, /*offline_memory_only=*/true, /*offload_to_worker_pool=*/false,
+              [this, thread_state_slice_callstack = std::move(thread_state_slice_callstack),
+               callstack_tid = event_data.GetCallstackTid()](
+                  const LibunwindstackResult& libunwindstack_result) mutable {
+                if (intern_callstacks_) {
+                  std::optional<uint64_t> callstack_id =
+                      InternCallstackFromLibunwindstackResult(libunwindstack_result, callstack_tid);
+                  if (!callstack_id.has_value()) {
+                    return;
+                  }
+                  thread_state_slice_callstack.set_callstack_id(callstack_id.value());
+                  listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+                  return;
+                }
+
+                const bool success = FillCallstackFromLibunwindstackResult(
+                    libunwindstack_result, thread_state_slice_callstack.mutable_callstack());
+                if (!success) {
+                  return;
+                }
+
+                listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+              });
 }
 
 void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
@@ -309,14 +437,32 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   thread_state_slice_callstack.set_thread_state_slice_tid(event_data.prev_tid);
   thread_state_slice_callstack.set_timestamp_ns(event_timestamp);
 
-  const bool success = UnwindStack(event_data, thread_state_slice_callstack.mutable_callstack(),
-                                   /*offline_memory_only=*/true);
-
-  if (!success) {
-    return;
-  }
-
-  listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+  // Not offloaded: ProducerEventProcessor merges the ThreadStateSliceCallstack into the
+  // ThreadStateSlice that SwitchesStatesNamesVisitor emits when it visits a later event, so it must
+  // reach the listener first.
+  UnwindStack(event_data, /*offline_memory_only=*/true, /*offload_to_worker_pool=*/false,
+              [this, thread_state_slice_callstack = std::move(thread_state_slice_callstack),
+               callstack_tid = event_data.GetCallstackTid()](
+                  const LibunwindstackResult& libunwindstack_result) mutable {
+                if (intern_callstacks_) {
+                  std::optional<uint64_t> callstack_id =
+                      InternCallstackFromLibunwindstackResult(libunwindstack_result, callstack_tid);
+                  if (!callstack_id.has_value()) {
+                    return;
+                  }
+                  thread_state_slice_callstack.set_callstack_id(callstack_id.value());
+                  listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+                  return;
+                }
+
+                const bool success = FillCallstackFromLibunwindstackResult(
+                    libunwindstack_result, thread_state_slice_callstack.mutable_callstack());
+                if (!success) {
+                  return;
+                }
+
+                listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+              });
 }
 
 template <typename CallchainPerfEventDataT>
@@ -443,6 +589,42 @@ bool UprobesUnwindingVisitor::VisitCallchainEvent(const CallchainPerfEventDataT&
   return true;
 }
 
+template <typename CallchainPerfEventDataT>
+std::optional<uint64_t> UprobesUnwindingVisitor::InternCallstackFromCallchain(
+    const CallchainPerfEventDataT& event_data) {
+  if (event_data.GetCallchainSize() <= 1) {
+    ORBIT_ERROR("Callchain has only %lu frames", event_data.GetCallchainSize());
+    return std::nullopt;
+  }
+
+  // This patches the callchain, so it needs to happen before the pcs are read.
+  const Callstack::CallstackType type = ComputeCallstackTypeFromCallchainAndPatch(event_data);
+
+  // As in VisitCallchainEvent, the first frame (in the kernel) is skipped and the return addresses
+  // are decreased by one.
+  const uint64_t* callchain = event_data.GetCallchain();
+  const size_t pc_count = event_data.GetCallchainSize() - 1;
+  auto get_pc = [callchain](size_t index) {
+    return index == 0 ? callchain[1] : callchain[index + 1] - 1;
+  };
+  auto [callstack_id, is_new] = callstack_trie_.GetOrInsert(
+      type, pc_count, get_pc, GetCallstackTrieCursor(event_data.GetCallstackTid()));
+  if (!is_new) {
+    return callstack_id;
+  }
+
+  InternedCallstack interned_callstack;
+  interned_callstack.set_key(callstack_id);
+  Callstack* callstack = interned_callstack.mutable_intern();
+  callstack->set_type(type);
+  callstack->mutable_pcs()->Reserve(static_cast<int>(pc_count));
+  for (size_t index = 0; index < pc_count; ++index) {
+    callstack->add_pcs(get_pc(index));
+  }
+  listener_->OnInternedCallstack(std::move(interned_callstack));
+  return callstack_id;
+}
+
 void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
                                     const CallchainSamplePerfEventData& event_data) {
   ORBIT_CHECK(listener_ != nullptr);
@@ -452,6 +634,16 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   sample.set_pid(event_data.pid);
   sample.set_tid(event_data.tid);
   sample.set_timestamp_ns(event_timestamp);
+
+  if (intern_callstacks_) {
+    std::optional<uint64_t> callstack_id = InternCallstackFromCallchain(event_data);
+    if (!callstack_id.has_value()) {
+      return;
+    }
+    listener_->OnInternedCallstackSample(CreateCallstackSample(sample, callstack_id.value()));
+    return;
+  }
+
   Callstack* callstack = sample.mutable_callstack();
 
   bool success = VisitCallchainEvent(event_data, callstack);
@@ -469,6 +661,16 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   thread_state_slice_callstack.set_thread_state_slice_tid(event_data.woken_tid);
   thread_state_slice_callstack.set_timestamp_ns(event_timestamp);
 
+  if (intern_callstacks_) {
+    std::optional<uint64_t> callstack_id = InternCallstackFromCallchain(event_data);
+    if (!callstack_id.has_value()) {
+      return;
+    }
+    thread_state_slice_callstack.set_callstack_id(callstack_id.value());
+    listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+    return;
+  }
+
   const bool success =
       VisitCallchainEvent(event_data, thread_state_slice_callstack.mutable_callstack());
 
@@ -485,6 +687,16 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   thread_state_slice_callstack.set_thread_state_slice_tid(event_data.prev_tid);
   thread_state_slice_callstack.set_timestamp_ns(event_timestamp);
 
+  if (intern_callstacks_) {
+    std::optional<uint64_t> callstack_id = InternCallstackFromCallchain(event_data);
+    if (!callstack_id.has_value()) {
+      return;
+    }
+    thread_state_slice_callstack.set_callstack_id(callstack_id.value());
+    listener_->OnThreadStateSliceCallstack(std::move(thread_state_slice_callstack));
+    return;
+  }
+
   const bool success =
       VisitCallchainEvent(event_data, thread_state_slice_callstack.mutable_callstack());
 
@@ -597,6 +809,11 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp,
   return_address_manager_->ProcessFunctionExit(event_data.tid);
 }
 
+void UprobesUnwindingVisitor::Visit(uint64_t /*event_timestamp*/,
+                                    const ExitPerfEventData& event_data) {
+  callstack_trie_cursor_per_thread_.erase(event_data.tid);
+}
+
 void UprobesUnwindingVisitor::Visit(uint64_t /*event_timestamp*/,
                                     const UprobesWithStackPerfEventData& event_data) {
   StackSlice stack_slice{.start_address = event_data.GetRegisters().sp,
@@ -739,6 +956,11 @@ void UprobesUnwindingVisitor::Visit(uint64_t event_timestamp, const MmapPerfEven
     current_maps_->AddAndSort(event_data.address, event_data.address + event_data.length,
                               event_data.page_offset, PROT_READ | PROT_EXEC, event_data.filename);
   }
+  if (unwinding_worker_pool_ != nullptr) {
+    unwinding_worker_pool_->AddAndSortMaps(
+        event_data.address, event_data.address + event_data.length, event_data.page_offset,
+        event_data.executable ? PROT_READ | PROT_EXEC : PROT_READ, event_data.filename);
+  }
 
   if (!event_data.executable) {
     // Don't try to send a ModuleUpdateEvent when non-executable mappings are added.
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "CallstackTrie.h"
 #include "GrpcProtos/capture.pb.h"
 #include "LeafFunctionCallManager.h"
 #include "LibunwindstackMaps.h"
@@ -29,6 +30,7 @@
 #include "PerfEvent.h"
 #include "PerfEventRecords.h"
 #include "PerfEventVisitor.h"
+#include "StackUnwindingWorkerPool.h"
 #include "UprobesFunctionCallManager.h"
 #include "UprobesReturnAddressManager.h"
 #include "unwindstack/Unwinder.h"
@@ -85,6 +87,25 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
     samples_in_uretprobes_counter_ = samples_in_uretprobes_counter;
   }
 
+  // When a StackUnwindingWorkerPool is set, DWARF-based unwinding of stack samples is offloaded to
+  // its workers, and the resulting FullCallstackSamples (or InternedCallstacks and
+  // CallstackSamples) are sent to the listener when the pool's ProcessFinishedRequests or
+  // WaitForAndProcessAllRequests are called. So they are still sent in timestamp order among
+  // themselves, but usually after events that were visited later, e.g., by other visitors.
+  // The stacks of ThreadStateSliceCallstacks are still unwound synchronously, as they have to
+  // reach the listener before the matching ThreadStateSlice.
+  // Changes to the memory maps are forwarded to the pool. The pool needs to outlive this visitor.
+  void SetStackUnwindingWorkerPool(StackUnwindingWorkerPool* unwinding_worker_pool) {
+    unwinding_worker_pool_ = unwinding_worker_pool;
+  }
+
+  // When enabled, each distinct callstack is sent to the listener only once, as an
+  // InternedCallstack, the first time it is seen. Samples are then sent as CallstackSamples and
+  // ThreadStateSliceCallstacks only carry the id of their callstack. This avoids building and
+  // copying the full callstack of every sample, and hashing it again downstream. Otherwise,
+  // FullCallstackSamples and ThreadStateSliceCallstacks with the full callstacks are sent.
+  void SetInternCallstacks(bool intern_callstacks) { intern_callstacks_ = intern_callstacks; }
+
   void Visit(uint64_t event_timestamp, const StackSamplePerfEventData& event_data) override;
   void Visit(uint64_t event_timestamp,
              const SchedWakeupWithCallchainPerfEventData& event_data) override;
@@ -107,13 +128,15 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
   void Visit(uint64_t event_timestamp,
              const UserSpaceFunctionExitPerfEventData& event_data) override;
   void Visit(uint64_t event_timestamp, const MmapPerfEventData& event_data) override;
+  void Visit(uint64_t event_timestamp, const ExitPerfEventData& event_data) override;
 
  private:
-  // This struct holds a copy of some stack data collected from the target process.
+  // This struct holds a copy of some stack data collected from the target process. The data is
+  // shared with the requests to unwinding_worker_pool_ that use it.
   struct StackSlice {
     uint64_t start_address;
     uint64_t size;
-    std::unique_ptr<uint8_t[]> data;
+    std::shared_ptr<const uint8_t[]> data;
   };
 
   void OnUprobes(uint64_t timestamp_ns, pid_t tid, uint32_t cpu, uint64_t sp, uint64_t ip,
@@ -131,15 +154,29 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
 
   void SendFullAddressInfoToListener(const unwindstack::FrameData& libunwindstack_frame);
 
-  template <typename StackPerfEventDataT>
-  [[nodiscard]] bool UnwindStack(const StackPerfEventDataT& event,
-                                 orbit_grpc_protos::Callstack* resulting_callstack,
-                                 bool offline_memory_only = false);
+  template <typename StackPerfEventDataT, typename OnUnwoundT>
+  void UnwindStack(const StackPerfEventDataT& event_data, bool offline_memory_only,
+                   bool offload_to_worker_pool, OnUnwoundT&& on_unwound);
+
+  [[nodiscard]] bool FillCallstackFromLibunwindstackResult(
+      const LibunwindstackResult& libunwindstack_result,
+      orbit_grpc_protos::Callstack* resulting_callstack);
 
   template <typename CallchainPerfEventDataT>
   [[nodiscard]] bool VisitCallchainEvent(const CallchainPerfEventDataT& event_data,
                                          orbit_grpc_protos::Callstack* resulting_callstack);
 
+  // These return the id of the callstack in callstack_trie_, after sending the callstack to the
+  // listener as an InternedCallstack if it was not seen before, or std::nullopt on error.
+  [[nodiscard]] std::optional<uint64_t> InternCallstackFromLibunwindstackResult(
+      const LibunwindstackResult& libunwindstack_result, pid_t callstack_tid);
+
+  template <typename CallchainPerfEventDataT>
+  [[nodiscard]] std::optional<uint64_t> InternCallstackFromCallchain(
+      const CallchainPerfEventDataT& event_data);
+
+  [[nodiscard]] CallstackTrie::Cursor* GetCallstackTrieCursor(pid_t tid);
+
   TracerListener* listener_;
 
   UprobesFunctionCallManager* function_call_manager_;
@@ -147,6 +184,7 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
   LibunwindstackMaps* current_maps_;
   LibunwindstackUnwinder* unwinder_;
   LeafFunctionCallManager* leaf_function_call_manager_;
+  StackUnwindingWorkerPool* unwinding_worker_pool_ = nullptr;
 
   UserSpaceInstrumentationAddresses* user_space_instrumentation_addresses_;
 
@@ -159,6 +197,17 @@ class UprobesUnwindingVisitor : public PerfEventVisitor {
       uprobe_sps_ips_cpus_per_thread_{};
   absl::flat_hash_set<uint64_t> known_linux_address_infos_{};
 
+  bool intern_callstacks_ = false;
+  // A single trie is shared by all processes. This is safe as a callstack is identified by its type
+  // and its absolute pcs, which is also how the callstacks of all processes are interned together
+  // downstream, and as samples carry their pid alongside the id.
+  CallstackTrie callstack_trie_{};
+  // The cursors are only an optimization. They are erased when their thread exits, but events of a
+  // thread can still arrive afterwards, e.g., the switch out of the exiting thread or samples
+  // unwound on unwinding_worker_pool_, so the map is also cleared when it grows too large.
+  absl::flat_hash_map<pid_t, CallstackTrie::Cursor> callstack_trie_cursor_per_thread_{};
+  static constexpr size_t kMaxCallstackTrieCursorCount = 1024;
+
   absl::flat_hash_map<pid_t, absl::flat_hash_map<uint64_t, StackSlice>>
       thread_id_stream_id_to_stack_slices_{};
 };
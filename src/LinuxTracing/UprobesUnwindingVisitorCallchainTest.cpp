@@ -186,6 +186,99 @@ TEST_F(UprobesUnwindingVisitorCallchainTest,
   EXPECT_EQ(discarded_samples_in_uretprobes_counter, 0);
 }
 
+TEST_F(UprobesUnwindingVisitorCallchainTest,
+       VisitCallchainSamplesWithInternedCallstacksSendsEachCallstackOnce) {
+  const std::vector<uint64_t> callchain1{
+      kKernelAddress,
+      kTargetAddress1,
+      // Increment by one as the return address is the next address.
+      kTargetAddress2 + 1,
+      kTargetAddress3 + 1,
+  };
+  const std::vector<uint64_t> callchain2{
+      kKernelAddress,
+      kTargetAddress2,
+      kTargetAddress3 + 1,
+  };
+
+  EXPECT_CALL(maps_, Find).WillRepeatedly(Return(kTargetMapInfo));
+  EXPECT_CALL(return_address_manager_, PatchCallchain).Times(3).WillRepeatedly(Return(true));
+  EXPECT_CALL(leaf_function_call_manager_, PatchCallerOfLeafFunction)
+      .Times(3)
+      .WillRepeatedly(Return(Callstack::kComplete));
+
+  std::vector<orbit_grpc_protos::InternedCallstack> actual_interned_callstacks;
+  EXPECT_CALL(listener_, OnInternedCallstack)
+      .Times(2)
+      .WillRepeatedly(Invoke([&actual_interned_callstacks](
+                                 orbit_grpc_protos::InternedCallstack interned_callstack) {
+        actual_interned_callstacks.push_back(std::move(interned_callstack));
+      }));
+  std::vector<orbit_grpc_protos::CallstackSample> actual_callstack_samples;
+  EXPECT_CALL(listener_, OnInternedCallstackSample)
+      .Times(3)
+      .WillRepeatedly(
+          Invoke([&actual_callstack_samples](orbit_grpc_protos::CallstackSample callstack_sample) {
+            actual_callstack_samples.push_back(std::move(callstack_sample));
+          }));
+  EXPECT_CALL(listener_, OnCallstackSample).Times(0);
+
+  visitor_.SetInternCallstacks(true);
+  PerfEvent{BuildFakeCallchainSamplePerfEvent(callchain1)}.Accept(&visitor_);
+  PerfEvent{BuildFakeCallchainSamplePerfEvent(callchain1)}.Accept(&visitor_);
+  PerfEvent{BuildFakeCallchainSamplePerfEvent(callchain2)}.Accept(&visitor_);
+
+  ASSERT_EQ(actual_interned_callstacks.size(), 2);
+  EXPECT_THAT(actual_interned_callstacks[0].intern().pcs(),
+              ElementsAre(kTargetAddress1, kTargetAddress2, kTargetAddress3));
+  EXPECT_EQ(actual_interned_callstacks[0].intern().type(), Callstack::kComplete);
+  EXPECT_THAT(actual_interned_callstacks[1].intern().pcs(),
+              ElementsAre(kTargetAddress2, kTargetAddress3));
+  EXPECT_EQ(actual_interned_callstacks[1].intern().type(), Callstack::kComplete);
+  EXPECT_NE(actual_interned_callstacks[0].key(), actual_interned_callstacks[1].key());
+
+  ASSERT_EQ(actual_callstack_samples.size(), 3);
+  EXPECT_EQ(actual_callstack_samples[0].callstack_id(), actual_interned_callstacks[0].key());
+  EXPECT_EQ(actual_callstack_samples[1].callstack_id(), actual_interned_callstacks[0].key());
+  EXPECT_EQ(actual_callstack_samples[2].callstack_id(), actual_interned_callstacks[1].key());
+  EXPECT_EQ(actual_callstack_samples[0].pid(), 10);
+  EXPECT_EQ(actual_callstack_samples[0].tid(), 11);
+  EXPECT_EQ(actual_callstack_samples[0].timestamp_ns(), 15);
+}
+
+TEST_F(UprobesUnwindingVisitorCallchainTest,
+       VisitCallchainSamplesWithInternedCallstacksKeepsIdsAcrossThreadExit) {
+  const std::vector<uint64_t> callchain{
+      kKernelAddress,
+      kTargetAddress1,
+      // Increment by one as the return address is the next address.
+      kTargetAddress2 + 1,
+  };
+
+  EXPECT_CALL(maps_, Find).WillRepeatedly(Return(kTargetMapInfo));
+  EXPECT_CALL(return_address_manager_, PatchCallchain).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(leaf_function_call_manager_, PatchCallerOfLeafFunction)
+      .Times(2)
+      .WillRepeatedly(Return(Callstack::kComplete));
+  EXPECT_CALL(listener_, OnInternedCallstack).Times(1);
+  std::vector<orbit_grpc_protos::CallstackSample> actual_callstack_samples;
+  EXPECT_CALL(listener_, OnInternedCallstackSample)
+      .Times(2)
+      .WillRepeatedly(
+          Invoke([&actual_callstack_samples](orbit_grpc_protos::CallstackSample callstack_sample) {
+            actual_callstack_samples.push_back(std::move(callstack_sample));
+          }));
+
+  visitor_.SetInternCallstacks(true);
+  PerfEvent{BuildFakeCallchainSamplePerfEvent(callchain)}.Accept(&visitor_);
+  // The exit of the thread drops its cursor, but not the callstacks in the trie.
+  PerfEvent{ExitPerfEvent{.timestamp = 16, .data = {.pid = 10, .tid = 11}}}.Accept(&visitor_);
+  PerfEvent{BuildFakeCallchainSamplePerfEvent(callchain)}.Accept(&visitor_);
+
+  ASSERT_EQ(actual_callstack_samples.size(), 2);
+  EXPECT_EQ(actual_callstack_samples[1].callstack_id(), actual_callstack_samples[0].callstack_id());
+}
+
 TEST_F(UprobesUnwindingVisitorCallchainTest, VisitSingleFrameCallchainSampleDoesNothing) {
   std::vector<uint64_t> callchain{kKernelAddress};
 
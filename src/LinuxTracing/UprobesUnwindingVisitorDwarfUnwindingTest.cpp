@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/types/span.h>
+#include <asm/perf_regs.h>
 #include <gmock/gmock.h>
 #include <google/protobuf/stubs/port.h>
 #include <gtest/gtest.h>
@@ -11,6 +13,7 @@
 #include <unwindstack/Unwinder.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <cstring>
@@ -28,6 +31,7 @@
 #include "MockTracerListener.h"
 #include "PerfEvent.h"
 #include "PerfEventRecords.h"
+#include "StackUnwindingWorkerPool.h"
 #include "TestUtils/SaveRangeFromArg.h"
 #include "UprobesFunctionCallManager.h"
 #include "UprobesUnwindingVisitor.h"
@@ -1780,6 +1784,82 @@ TYPED_TEST_P(UprobesUnwindingVisitorDwarfUnwindingTest,
   EXPECT_EQ(discarded_samples_in_uretprobes_counter, 0);
 }
 
+TYPED_TEST_P(UprobesUnwindingVisitorDwarfUnwindingTest,
+             VisitWithStackUnwindingWorkerPoolOffloadsOnlyStackSamples) {
+  constexpr bool kIsStackSample =
+      std::is_same_v<StackSamplePerfEvent, typename TypeParam::PerfEventT>;
+  auto event = BuildFakePerfEventWithStack<typename TypeParam::PerfEventT>();
+  constexpr uint8_t kStackByte = 0x42;
+  std::memset(event.data.data.get(), kStackByte, event.data.dyn_size);
+  const uint64_t dyn_size = event.data.dyn_size;
+
+  std::vector<uint8_t> unwound_stack;
+  auto unwind = [this, &unwound_stack](
+                    pid_t /*pid*/, unwindstack::Maps* /*maps*/,
+                    const std::array<uint64_t, PERF_REG_X86_64_MAX>& /*perf_regs*/,
+                    absl::Span<const StackSliceView> stack_slices, bool /*offline_memory_only*/,
+                    size_t /*max_frames*/) {
+    unwound_stack.assign(stack_slices[0].data(), stack_slices[0].data() + stack_slices[0].size());
+    return LibunwindstackResult{
+        {TestFixture::kFrame1}, {}, unwindstack::ErrorCode::ERROR_NONE};
+  };
+
+  // Expectations on the unwinder of the worker are verified when the pool is destroyed.
+  StackUnwindingWorkerPool pool{
+      1, [] { return std::make_unique<::testing::NiceMock<MockLibunwindstackMaps>>(); },
+      [&unwind] {
+        auto unwinder = std::make_unique<MockLibunwindstackUnwinder>();
+        if constexpr (kIsStackSample) {
+          EXPECT_CALL(*unwinder, Unwind).Times(1).WillOnce(unwind);
+        } else {
+          EXPECT_CALL(*unwinder, Unwind).Times(0);
+        }
+        return unwinder;
+      }};
+  this->visitor_.SetStackUnwindingWorkerPool(&pool);
+
+  EXPECT_CALL(this->return_address_manager_, PatchSample).Times(1).WillOnce(::testing::Return());
+  if constexpr (kIsStackSample) {
+    EXPECT_CALL(this->maps_, Get).Times(0);
+    EXPECT_CALL(this->unwinder_, Unwind).Times(0);
+  } else {
+    EXPECT_CALL(this->maps_, Get).Times(1).WillOnce(::testing::Return(nullptr));
+    EXPECT_CALL(this->unwinder_, Unwind).Times(1).WillOnce(unwind);
+  }
+
+  bool callstack_sent = false;
+  if constexpr (kIsStackSample) {
+    EXPECT_CALL(this->listener_, OnCallstackSample)
+        .Times(1)
+        .WillOnce(::testing::Assign(&callstack_sent, true));
+  } else {
+    EXPECT_CALL(this->listener_, OnThreadStateSliceCallstack)
+        .Times(1)
+        .WillOnce(::testing::Assign(&callstack_sent, true));
+  }
+  EXPECT_CALL(this->listener_, OnAddressInfo).Times(1);
+
+  std::atomic<uint64_t> unwinding_errors = 0;
+  std::atomic<uint64_t> discarded_samples_in_uretprobes_counter = 0;
+  this->visitor_.SetUnwindErrorsAndDiscardedSamplesCounters(
+      &unwinding_errors, &discarded_samples_in_uretprobes_counter);
+
+  PerfEvent{std::move(event)}.Accept(&this->visitor_);
+
+  // ThreadStateSliceCallstacks have to reach the listener before the ThreadStateSlices they belong
+  // to, so only callstack samples wait for the pool.
+  EXPECT_EQ(callstack_sent, !kIsStackSample);
+  pool.WaitForAndProcessAllRequests();
+  EXPECT_TRUE(callstack_sent);
+
+  // The stack is unwound as it was in the event, even though the event is gone by now.
+  EXPECT_EQ(unwound_stack.size(), dyn_size);
+  EXPECT_THAT(unwound_stack, ::testing::Each(kStackByte));
+
+  EXPECT_EQ(unwinding_errors, 0);
+  EXPECT_EQ(discarded_samples_in_uretprobes_counter, 0);
+}
+
 REGISTER_TYPED_TEST_SUITE_P(
     UprobesUnwindingVisitorDwarfUnwindingTest,
     VisitValidStackSampleWithoutUprobesSendsCompleteCallstackAndAddressInfos,
@@ -1798,7 +1878,8 @@ REGISTER_TYPED_TEST_SUITE_P(
     VisitStackSampleWithinUserSpaceInstrumentationTrampolineAndLibrarySendsInUserSpaceInstrumentationCallstack,
     VisitStackSampleWithinUserSpaceInstrumentationTrampolineSendsInUserSpaceInstrumentationCallstack,
     VisitTwoValidStackSamplesSendsAddressInfosOnlyOnce,
-    VisitValidStackSampleWithNullptrMapInfosSendsCompleteCallstackAndAddressInfosWithoutModuleName);
+    VisitValidStackSampleWithNullptrMapInfosSendsCompleteCallstackAndAddressInfosWithoutModuleName,
+    VisitWithStackUnwindingWorkerPoolOffloadsOnlyStackSamples);
 
 template <typename T, typename U>
 struct DwarfUnwindingTestType {
@@ -14,6 +14,10 @@ class TracerListener {
   virtual ~TracerListener() = default;
   virtual void OnSchedulingSlice(orbit_grpc_protos::SchedulingSlice scheduling_slice) = 0;
   virtual void OnCallstackSample(orbit_grpc_protos::FullCallstackSample callstack_sample) = 0;
+  // The callstack_id of the CallstackSample refers to an InternedCallstack that was already passed
+  // to OnInternedCallstack. The same holds for the callstack_id of a ThreadStateSliceCallstack.
+  virtual void OnInternedCallstackSample(orbit_grpc_protos::CallstackSample callstack_sample) = 0;
+  virtual void OnInternedCallstack(orbit_grpc_protos::InternedCallstack interned_callstack) = 0;
   virtual void OnThreadStateSliceCallstack(
       orbit_grpc_protos::ThreadStateSliceCallstack callstack) = 0;
   virtual void OnFunctionCall(orbit_grpc_protos::FunctionCall function_call) = 0;
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/container/flat_hash_map.h>
 #include <absl/container/flat_hash_set.h>
 #include <absl/hash/hash.h>
 #include <absl/strings/match.h>
@@ -95,6 +96,30 @@ class BufferTracerListener : public orbit_linux_tracing::TracerListener {
     }
   }
 
+  // The tests only look at FullCallstackSamples, so samples of interned callstacks are converted
+  // back to FullCallstackSamples.
+  void OnInternedCallstackSample(orbit_grpc_protos::CallstackSample callstack_sample) override {
+    orbit_grpc_protos::ProducerCaptureEvent event;
+    orbit_grpc_protos::FullCallstackSample* full_callstack_sample =
+        event.mutable_full_callstack_sample();
+    full_callstack_sample->set_pid(callstack_sample.pid());
+    full_callstack_sample->set_tid(callstack_sample.tid());
+    full_callstack_sample->set_timestamp_ns(callstack_sample.timestamp_ns());
+    {
+      absl::MutexLock lock{&events_mutex_};
+      auto callstack_it = interned_callstacks_.find(callstack_sample.callstack_id());
+      ORBIT_CHECK(callstack_it != interned_callstacks_.end());
+      *full_callstack_sample->mutable_callstack() = callstack_it->second;
+      events_.emplace_back(std::move(event));
+    }
+  }
+
+  void OnInternedCallstack(orbit_grpc_protos::InternedCallstack interned_callstack) override {
+    absl::MutexLock lock{&events_mutex_};
+    interned_callstacks_.emplace(interned_callstack.key(),
+                                 std::move(*interned_callstack.mutable_intern()));
+  }
+
   void OnFunctionCall(orbit_grpc_protos::FunctionCall function_call) override {
     orbit_grpc_protos::ProducerCaptureEvent event;
     *event.mutable_function_call() = std::move(function_call);
@@ -242,6 +267,7 @@ class BufferTracerListener : public orbit_linux_tracing::TracerListener {
 
  private:
   std::vector<orbit_grpc_protos::ProducerCaptureEvent> events_;
+  absl::flat_hash_map<uint64_t, orbit_grpc_protos::Callstack> interned_callstacks_;
   absl::Mutex events_mutex_;
 
   bool one_scheduling_slice_received_ = false;
@@ -499,21 +525,8 @@ void VerifyNoWarningInstrumentingWithUprobesEvents(
   }
 }
 
-TEST(LinuxTracingIntegrationTest, SchedulingSlices) {
-  if (!CheckIsRunningAsRoot()) {
-    GTEST_SKIP();
-  }
-  LinuxTracingIntegrationTestFixture fixture;
-
-  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
-      TraceAndGetEvents(&fixture, PuppetConstants::kSleepCommand);
-
-  VerifyOrderOfAllEvents(events);
-
-  VerifyNoLostOrDiscardedEvents(events);
-
-  VerifyNoWarningInstrumentingWithUprobesEvents(events);
-
+void VerifySchedulingSlicesOfPuppet(
+    absl::Span<const orbit_grpc_protos::ProducerCaptureEvent> events, uint32_t pid) {
   uint64_t scheduling_slice_count = 0;
   uint64_t last_out_timestamp_ns = 0;
   for (const auto& event : events) {
@@ -522,7 +535,7 @@ TEST(LinuxTracingIntegrationTest, SchedulingSlices) {
     }
 
     const orbit_grpc_protos::SchedulingSlice& scheduling_slice = event.scheduling_slice();
-    if (scheduling_slice.pid() != fixture.GetPuppetPid()) {
+    if (scheduling_slice.pid() != pid) {
       continue;
     }
 
@@ -542,6 +555,70 @@ TEST(LinuxTracingIntegrationTest, SchedulingSlices) {
   EXPECT_GE(scheduling_slice_count, PuppetConstants::kSleepCount - 1);
 }
 
+TEST(LinuxTracingIntegrationTest, SchedulingSlices) {
+  if (!CheckIsRunningAsRoot()) {
+    GTEST_SKIP();
+  }
+  LinuxTracingIntegrationTestFixture fixture;
+
+  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
+      TraceAndGetEvents(&fixture, PuppetConstants::kSleepCommand);
+
+  VerifyOrderOfAllEvents(events);
+
+  VerifyNoLostOrDiscardedEvents(events);
+
+  VerifyNoWarningInstrumentingWithUprobesEvents(events);
+
+  VerifySchedulingSlicesOfPuppet(events, fixture.GetPuppetPid());
+}
+
+TEST(LinuxTracingIntegrationTest, SchedulingSlicesWithEventDrivenRingBufferReading) {
+  if (!CheckIsRunningAsRoot()) {
+    GTEST_SKIP();
+  }
+  LinuxTracingIntegrationTestFixture fixture;
+
+  orbit_grpc_protos::CaptureOptions capture_options = fixture.BuildDefaultCaptureOptions();
+  capture_options.set_event_driven_ring_buffer_reading(true);
+
+  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
+      TraceAndGetEvents(&fixture, PuppetConstants::kSleepCommand, capture_options);
+
+  VerifyOrderOfAllEvents(events);
+
+  VerifyNoLostOrDiscardedEvents(events);
+
+  VerifyNoWarningInstrumentingWithUprobesEvents(events);
+
+  // A sleeping puppet produces too few events to reach the wakeup watermark, so this also verifies
+  // that ring buffers are read when epoll_wait times out.
+  VerifySchedulingSlicesOfPuppet(events, fixture.GetPuppetPid());
+}
+
+// Only has an effect on machines with more than one cpu. PerfEventProcessor still has to receive
+// the events of all ring buffers, and sort them, even though they are read on multiple threads.
+TEST(LinuxTracingIntegrationTest, SchedulingSlicesWithMultipleRingBufferReaderThreads) {
+  if (!CheckIsRunningAsRoot()) {
+    GTEST_SKIP();
+  }
+  LinuxTracingIntegrationTestFixture fixture;
+
+  orbit_grpc_protos::CaptureOptions capture_options = fixture.BuildDefaultCaptureOptions();
+  capture_options.set_ring_buffer_reader_thread_count(4);
+
+  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
+      TraceAndGetEvents(&fixture, PuppetConstants::kSleepCommand, capture_options);
+
+  VerifyOrderOfAllEvents(events);
+
+  VerifyNoLostOrDiscardedEvents(events);
+
+  VerifyNoWarningInstrumentingWithUprobesEvents(events);
+
+  VerifySchedulingSlicesOfPuppet(events, fixture.GetPuppetPid());
+}
+
 void VerifyFunctionCallsOfOuterAndInnerFunction(
     absl::Span<const orbit_grpc_protos::ProducerCaptureEvent> events, uint32_t pid,
     uint64_t outer_function_id, uint64_t inner_function_id) {
@@ -583,6 +660,32 @@ TEST(LinuxTracingIntegrationTest, FunctionCalls) {
                                              kInnerFunctionId);
 }
 
+TEST(LinuxTracingIntegrationTest, FunctionCallsWithEventDrivenRingBufferReading) {
+  if (!CheckIsRunningAsRoot()) {
+    GTEST_SKIP();
+  }
+  LinuxTracingIntegrationTestFixture fixture;
+
+  orbit_grpc_protos::CaptureOptions capture_options = fixture.BuildDefaultCaptureOptions();
+  capture_options.set_event_driven_ring_buffer_reading(true);
+  constexpr uint64_t kOuterFunctionId = 1;
+  constexpr uint64_t kInnerFunctionId = 2;
+  AddPuppetOuterAndInnerFunctionToCaptureOptions(&capture_options, fixture.GetPuppetPidNative(),
+                                                 kOuterFunctionId, kInnerFunctionId);
+
+  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
+      TraceAndGetEvents(&fixture, PuppetConstants::kCallOuterFunctionCommand, capture_options);
+
+  VerifyOrderOfAllEvents(events);
+
+  VerifyNoLostOrDiscardedEvents(events);
+
+  VerifyNoWarningInstrumentingWithUprobesEvents(events);
+
+  VerifyFunctionCallsOfOuterAndInnerFunction(events, fixture.GetPuppetPid(), kOuterFunctionId,
+                                             kInnerFunctionId);
+}
+
 std::pair<std::pair<uint64_t, uint64_t>, std::pair<uint64_t, uint64_t>>
 GetOuterAndInnerFunctionVirtualAddressRanges(pid_t pid) {
   const orbit_grpc_protos::ModuleInfo& module_info = GetExecutableBinaryModuleInfo(pid);
@@ -843,6 +946,50 @@ TEST(LinuxTracingIntegrationTest, CallstackSamplesTogetherWithFunctionCalls) {
       inner_function_virtual_address_range, sampling_rate, &address_infos_received);
 }
 
+TEST(LinuxTracingIntegrationTest,
+     CallstackSamplesTogetherWithFunctionCallsWithMultipleRingBufferReaderThreads) {
+  if (!CheckIsRunningAsRoot()) {
+    GTEST_SKIP();
+  }
+  LinuxTracingIntegrationTestFixture fixture;
+
+  const auto& [outer_function_virtual_address_range, inner_function_virtual_address_range] =
+      GetOuterAndInnerFunctionVirtualAddressRanges(fixture.GetPuppetPidNative());
+  const std::filesystem::path& executable_path =
+      GetExecutableBinaryPath(fixture.GetPuppetPidNative());
+
+  orbit_grpc_protos::CaptureOptions capture_options = fixture.BuildDefaultCaptureOptions();
+  capture_options.set_ring_buffer_reader_thread_count(4);
+  constexpr uint64_t kOuterFunctionId = 1;
+  constexpr uint64_t kInnerFunctionId = 2;
+  AddPuppetOuterAndInnerFunctionToCaptureOptions(&capture_options, fixture.GetPuppetPidNative(),
+                                                 kOuterFunctionId, kInnerFunctionId);
+  const double sampling_rate = capture_options.samples_per_second();
+
+  std::vector<orbit_grpc_protos::ProducerCaptureEvent> events =
+      TraceAndGetEvents(&fixture, PuppetConstants::kCallOuterFunctionCommand, capture_options);
+
+  VerifyOrderOfAllEvents(events);
+
+  VerifyNoLostOrDiscardedEvents(events);
+
+  VerifyNoWarningInstrumentingWithUprobesEvents(events);
+
+  // The uprobes and uretprobes of a function call can be recorded on different cpus, hence be read
+  // by different threads.
+  VerifyFunctionCallsOfOuterAndInnerFunction(events, fixture.GetPuppetPid(), kOuterFunctionId,
+                                             kInnerFunctionId);
+
+  absl::flat_hash_set<uint64_t> address_infos_received =
+      VerifyAndGetAddressInfosWithOuterAndInnerFunction(events, executable_path,
+                                                        outer_function_virtual_address_range,
+                                                        inner_function_virtual_address_range);
+
+  VerifyCallstackSamplesWithOuterAndInnerFunctionForDwarfUnwinding(
+      events, fixture.GetPuppetPid(), outer_function_virtual_address_range,
+      inner_function_virtual_address_range, sampling_rate, &address_infos_received);
+}
+
 void VerifyNoAddressInfos(absl::Span<const orbit_grpc_protos::ProducerCaptureEvent> events) {
   for (const auto& event : events) {
     EXPECT_NE(event.event_case(), orbit_grpc_protos::ProducerCaptureEvent::kFullAddressInfo);
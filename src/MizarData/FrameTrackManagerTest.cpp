@@ -18,7 +18,7 @@
 
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeInfo.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 #include "MizarBase/Time.h"
 #include "MizarData/FrameTrack.h"
@@ -29,7 +29,7 @@
 
 using ::orbit_client_data::ScopeId;
 using ::orbit_client_data::ScopeInfo;
-using ::orbit_client_protos::TimerInfo;
+using ::orbit_client_data::TimerInfo;
 using ::orbit_grpc_protos::PresentEvent;
 using ::orbit_mizar_base::TimestampNs;
 using ::orbit_test_utils::MakeMap;
@@ -23,6 +23,7 @@
 #include "ClientData/ProcessData.h"
 #include "ClientData/ScopeInfo.h"
 #include "ClientData/ThreadTrackDataProvider.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientSymbols/QSettingsBasedStorageManager.h"
 #include "GrpcProtos/symbol.pb.h"
 #include "MizarBase/AbsoluteAddress.h"
@@ -84,7 +85,7 @@ void MizarData::OnCaptureStarted(const orbit_grpc_protos::CaptureStarted& captur
       std::make_unique<orbit_client_data::ModuleManager>(module_identifier_provider_.get());
 }
 
-void MizarData::OnTimer(const orbit_client_protos::TimerInfo& timer_info) {
+void MizarData::OnTimer(const orbit_client_data::TimerInfo& timer_info) {
   const std::optional<ScopeId> scope_id = GetCaptureData().ProvideScopeId(timer_info);
   if (!scope_id.has_value()) return;
 
@@ -28,8 +28,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/LinuxAddressInfo.h"
 #include "ClientData/ScopeInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "MizarBase/AbsoluteAddress.h"
@@ -8,6 +8,7 @@
 #include <absl/algorithm/container.h>
 #include <absl/functional/bind_front.h>
 
+#include "ClientData/TimerInfo.h"
 #include "MizarBase/Time.h"
 #include "MizarData/FrameTrack.h"
 #include "MizarData/MizarDataProvider.h"
@@ -30,8 +30,8 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "MizarBase/AbsoluteAddress.h"
@@ -95,7 +95,7 @@ class MizarData : public orbit_capture_client::AbstractCaptureListener<MizarData
     LoadSymbolsForAllModules();
   }
 
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
 
   void OnModuleUpdate(uint64_t /*timestamp_ns*/,
                       orbit_grpc_protos::ModuleInfo module_info) override {
@@ -22,7 +22,6 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/CallstackEvent.h"
 #include "ClientData/ScopeId.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "MizarBase/AbsoluteAddress.h"
 #include "MizarBase/SampledFunctionId.h"
@@ -17,7 +17,7 @@
 #include "ApiInterface/Orbit.h"
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleAndFunctionLookup.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitGl/GlUtils.h"
@@ -29,7 +29,7 @@
 #include "OrbitGl/TimeGraphLayout.h"
 #include "OrbitGl/Viewport.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using orbit_gl::PrimitiveAssembler;
 using orbit_gl::TextRenderer;
 
@@ -78,14 +78,14 @@ AsyncTrack::AsyncTrack(CaptureViewElement* parent,
           TicksToDuration(timer_info->start(), timer_info->end())));
 }
 
-void AsyncTrack::OnTimer(const orbit_client_protos::TimerInfo& timer_info) {
+void AsyncTrack::OnTimer(const orbit_client_data::TimerInfo& timer_info) {
   // Find the first row that that can receive the new timeslice with no overlap.
   // If none of the existing rows works, add a new row.
   uint32_t depth = 0;
   while (max_span_time_by_depth_[depth] > timer_info.start()) ++depth;
   max_span_time_by_depth_[depth] = timer_info.end();
 
-  orbit_client_protos::TimerInfo new_timer_info = timer_info;
+  orbit_client_data::TimerInfo new_timer_info = timer_info;
   new_timer_info.set_depth(depth);
   TimerTrack::OnTimer(new_timer_info);
 }
@@ -0,0 +1,106 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/BatcherShard.h"
+
+#include <optional>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+#include "OrbitGl/TranslationStack.h"
+
+namespace orbit_gl {
+
+BatcherShard::BatcherShard(Batcher* target) : Batcher(target->GetBatcherId()), target_(target) {
+  ORBIT_CHECK(target_ != nullptr);
+}
+
+void BatcherShard::AddLine(Vec2 from, Vec2 to, float z, const Color& color,
+                           const Color& picking_color,
+                           std::unique_ptr<PickingUserData> user_data) {
+  Primitive line{PrimitiveType::kLine, {from, to}, {color, color}, z, picking_color,
+                 std::move(user_data), 0};
+  AddPrimitive(std::move(line), z);
+}
+
+void BatcherShard::AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+                          const Color& picking_color, std::unique_ptr<PickingUserData> user_data) {
+  Primitive primitive{PrimitiveType::kBox, box.vertices, colors, z, picking_color,
+                      std::move(user_data), 0};
+  AddPrimitive(std::move(primitive), z);
+}
+
+void BatcherShard::AddTriangle(const Triangle& triangle, float z,
+                               const std::array<Color, 3>& colors, const Color& picking_color,
+                               std::unique_ptr<PickingUserData> user_data) {
+  Primitive primitive{PrimitiveType::kTriangle,
+                      {triangle.vertices[0], triangle.vertices[1], triangle.vertices[2]},
+                      {colors[0], colors[1], colors[2]},
+                      z,
+                      picking_color,
+                      std::move(user_data),
+                      0};
+  AddPrimitive(std::move(primitive), z);
+}
+
+void BatcherShard::ResetElements() {
+  primitives_.clear();
+  render_group_names_.clear();
+  current_render_group_ = BatchRenderGroupId();
+}
+
+uint32_t BatcherShard::GetNumElements() const { return primitives_.size(); }
+
+void BatcherShard::DrawRenderGroup(const BatchRenderGroupId& /*group*/, bool /*picking*/) {
+  ORBIT_UNREACHABLE();
+}
+
+void BatcherShard::MergeIntoTarget() {
+  const std::string target_render_group_name = target_->GetCurrentRenderGroupName();
+  std::optional<size_t> render_group_index;
+  for (Primitive& primitive : primitives_) {
+    if (primitive.render_group_index != render_group_index) {
+      render_group_index = primitive.render_group_index;
+      target_->SetCurrentRenderGroupName(render_group_names_[primitive.render_group_index]);
+    }
+
+    const Color picking_color = target_->RemapPickingColor(primitive.picking_color);
+    const std::array<Vec2, 4>& vertices = primitive.vertices;
+    const std::array<Color, 4>& colors = primitive.colors;
+    switch (primitive.type) {
+      case PrimitiveType::kLine:
+        target_->AddLine(vertices[0], vertices[1], primitive.z, colors[0], picking_color,
+                         std::move(primitive.user_data));
+        break;
+      case PrimitiveType::kBox:
+        target_->AddBox(Quad{vertices}, primitive.z, colors, picking_color,
+                        std::move(primitive.user_data));
+        break;
+      case PrimitiveType::kTriangle:
+        target_->AddTriangle(Triangle{vertices[0], vertices[1], vertices[2]}, primitive.z,
+                             {colors[0], colors[1], colors[2]}, picking_color,
+                             std::move(primitive.user_data));
+        break;
+    }
+  }
+  target_->SetCurrentRenderGroupName(target_render_group_name);
+  ResetElements();
+}
+
+Vec2 BatcherShard::Translate(const Vec2& vertex, float z) const {
+  return translations_.TranslateXYZ({vertex, z}).xy;
+}
+
+void BatcherShard::AddPrimitive(Primitive primitive, float z) {
+  for (Vec2& vertex : primitive.vertices) vertex = Translate(vertex, z);
+  primitive.z = translations_.TranslateXYZ({Vec2(0.f, 0.f), z}).z;
+
+  if (render_group_names_.empty() || render_group_names_.back() != current_render_group_.name) {
+    render_group_names_.push_back(current_render_group_.name);
+  }
+  primitive.render_group_index = render_group_names_.size() - 1;
+  primitives_.push_back(std::move(primitive));
+}
+
+}  // namespace orbit_gl
@@ -0,0 +1,99 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <GteVector.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ClientData/TimerInfo.h"
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/BatcherInterface.h"
+#include "OrbitGl/BatcherShard.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/OpenGlBatcher.h"
+#include "OrbitGl/PickingManager.h"
+
+namespace orbit_gl {
+
+namespace {
+
+const Color kColor{255, 0, 0, 255};
+
+[[nodiscard]] Color GetPickingColor(const Batcher& batcher, PickingType type) {
+  return PickingId::ToColor(type, batcher.GetNumElements(), batcher.GetBatcherId());
+}
+
+}  // namespace
+
+using orbit_client_data::TimerInfo;
+using testing::UnorderedElementsAre;
+
+TEST(BatcherShard, StoresPrimitivesUntilMerged) {
+  OpenGlBatcher target(BatcherId::kTimeGraph);
+  BatcherShard shard(&target);
+  EXPECT_EQ(shard.GetBatcherId(), BatcherId::kTimeGraph);
+
+  shard.AddLine({0, 0}, {1, 1}, 0.f, kColor, GetPickingColor(shard, PickingType::kLine), nullptr);
+  shard.AddBox(MakeBox({0, 0}, {1, 1}), 0.f, {kColor, kColor, kColor, kColor},
+               GetPickingColor(shard, PickingType::kBox), nullptr);
+  shard.AddTriangle(Triangle({0, 0}, {1, 0}, {0, 1}), 0.f, {kColor, kColor, kColor},
+                    GetPickingColor(shard, PickingType::kTriangle), nullptr);
+  EXPECT_EQ(shard.GetNumElements(), 3);
+  EXPECT_EQ(target.GetNumElements(), 0);
+
+  shard.MergeIntoTarget();
+  EXPECT_EQ(shard.GetNumElements(), 0);
+  EXPECT_EQ(target.GetNumElements(), 3);
+}
+
+TEST(BatcherShard, MergesIntoTheRenderGroupsOfThePrimitives) {
+  OpenGlBatcher target(BatcherId::kTimeGraph);
+  target.SetCurrentRenderGroupName("container");
+  BatcherShard shard(&target);
+  shard.SetCurrentRenderGroupName("container");
+
+  shard.PushTranslation(0, 0, 1.f);
+  shard.AddLine({0, 0}, {1, 1}, 0.f, kColor, GetPickingColor(shard, PickingType::kLine), nullptr);
+  shard.SetCurrentRenderGroupName("container|track");
+  shard.AddLine({0, 0}, {1, 1}, 0.5f, kColor, GetPickingColor(shard, PickingType::kLine), nullptr);
+  shard.PopTranslation();
+
+  // Primitives are translated again by the target, relative to its translation when merging.
+  target.PushTranslation(0, 0, 2.f);
+  shard.MergeIntoTarget();
+  target.PopTranslation();
+
+  EXPECT_THAT(target.GetNonEmptyRenderGroups(),
+              UnorderedElementsAre(BatchRenderGroupId{"container", 3.f},
+                                   BatchRenderGroupId{"container|track", 3.5f}));
+  EXPECT_EQ(target.GetCurrentRenderGroupName(), "container");
+}
+
+TEST(BatcherShard, RemapsPickingColorsAndUserData) {
+  OpenGlBatcher target(BatcherId::kTimeGraph);
+  TimerInfo target_timer_info;
+  target.AddBox(MakeBox({0, 0}, {1, 1}), 0.f, {kColor, kColor, kColor, kColor},
+                GetPickingColor(target, PickingType::kBox),
+                std::make_unique<PickingUserData>(&target_timer_info));
+
+  BatcherShard shard(&target);
+  TimerInfo shard_timer_info;
+  shard.AddBox(MakeBox({0, 0}, {1, 1}), 0.f, {kColor, kColor, kColor, kColor},
+               GetPickingColor(shard, PickingType::kBox),
+               std::make_unique<PickingUserData>(&shard_timer_info));
+  shard.MergeIntoTarget();
+
+  const PickingId merged_id = PickingId::Create(PickingType::kBox, 1, BatcherId::kTimeGraph);
+  ASSERT_NE(target.GetUserData(merged_id), nullptr);
+  EXPECT_EQ(target.GetUserData(merged_id)->timer_info_, &shard_timer_info);
+  // User data is looked up in the target, also when queried through the shard.
+  EXPECT_EQ(shard.GetUserData(merged_id), target.GetUserData(merged_id));
+}
+
+}  // namespace orbit_gl
@@ -10,12 +10,16 @@
 #include <absl/strings/str_format.h>
 #include <absl/types/span.h>
 
+#include <cstddef>
 #include <memory>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "ClientData/CallstackInfo.h"
 #include "ClientData/ModuleAndFunctionLookup.h"
 #include "Introspection/Introspection.h"
+#include "OrbitBase/TaskGroup.h"
 #include "OrbitBase/ThreadConstants.h"
 
 using orbit_client_data::CallstackInfo;
@@ -28,84 +32,139 @@ using orbit_client_data::ThreadSampleData;
 CallTreeNode::~CallTreeNode() = default;
 
 const std::vector<const CallTreeNode*>& CallTreeNode::children() const {
-  if (children_cache_.has_value()) {
-    return *children_cache_;
+  static const std::vector<const CallTreeNode*> kNoChildren;
+  if (children_ == nullptr) {
+    return kNoChildren;
+  }
+  if (children_->cache.has_value()) {
+    return *children_->cache;
   }
 
-  children_cache_.emplace();
-  for (const auto& tid_and_thread : thread_children_) {
-    children_cache_->push_back(tid_and_thread.second.get());
+  std::vector<const CallTreeNode*>& cache = children_->cache.emplace();
+  cache.reserve(child_count());
+  for (const auto& tid_and_thread : children_->threads) {
+    cache.push_back(tid_and_thread.second.get());
   }
-  for (const auto& address_and_functions : function_children_) {
-    children_cache_->push_back(address_and_functions.second.get());
+  for (const auto& address_and_functions : children_->functions) {
+    cache.push_back(address_and_functions.second.get());
   }
-  if (unwind_errors_child_ != nullptr) {
-    children_cache_->push_back(unwind_errors_child_.get());
+  if (children_->unwind_errors != nullptr) {
+    cache.push_back(children_->unwind_errors.get());
   }
 
-  for (const auto& error_type_and_unwind_error : unwind_error_type_children_) {
-    children_cache_->push_back(error_type_and_unwind_error.second.get());
+  for (const auto& error_type_and_unwind_error : children_->unwind_error_types) {
+    cache.push_back(error_type_and_unwind_error.second.get());
   }
 
-  return *children_cache_;
+  return cache;
+}
+
+CallTreeNode::Children& CallTreeNode::GetOrCreateChildren() {
+  if (children_ == nullptr) {
+    children_ = std::make_unique<Children>();
+  }
+  children_->cache.reset();
+  return *children_;
 }
 
 CallTreeThread* CallTreeNode::GetThreadOrNull(uint32_t thread_id) {
-  auto thread_it = thread_children_.find(thread_id);
-  if (thread_it == thread_children_.end()) {
+  if (children_ == nullptr) return nullptr;
+  auto thread_it = children_->threads.find(thread_id);
+  if (thread_it == children_->threads.end()) {
     return nullptr;
   }
   return thread_it->second.get();
 }
 
 CallTreeThread* CallTreeNode::AddAndGetThread(uint32_t thread_id, std::string thread_name) {
-  const auto& [it, inserted] = thread_children_.try_emplace(
+  const auto& [it, inserted] = GetOrCreateChildren().threads.try_emplace(
       thread_id, std::make_unique<CallTreeThread>(thread_id, std::move(thread_name), this));
   ORBIT_CHECK(inserted);
-  children_cache_.reset();
   return it->second.get();
 }
 
 CallTreeFunction* CallTreeNode::GetFunctionOrNull(uint64_t function_absolute_address) {
-  auto function_it = function_children_.find(function_absolute_address);
-  if (function_it == function_children_.end()) {
+  if (children_ == nullptr) return nullptr;
+  auto function_it = children_->functions.find(function_absolute_address);
+  if (function_it == children_->functions.end()) {
     return nullptr;
   }
   return function_it->second.get();
 }
 
 CallTreeFunction* CallTreeNode::AddAndGetFunction(uint64_t function_absolute_address) {
-  const auto& [it, inserted] = function_children_.try_emplace(
+  const auto& [it, inserted] = GetOrCreateChildren().functions.try_emplace(
       function_absolute_address,
       std::make_unique<CallTreeFunction>(function_absolute_address, this));
   ORBIT_CHECK(inserted);
-  children_cache_.reset();
   return it->second.get();
 }
 
 CallTreeUnwindErrorType* CallTreeNode::GetUnwindErrorTypeOrNull(CallstackType type) {
-  auto unwind_error_it = unwind_error_type_children_.find(type);
-  if (unwind_error_it == unwind_error_type_children_.end()) {
+  if (children_ == nullptr) return nullptr;
+  auto unwind_error_it = children_->unwind_error_types.find(type);
+  if (unwind_error_it == children_->unwind_error_types.end()) {
     return nullptr;
   }
   return unwind_error_it->second.get();
 }
 
 CallTreeUnwindErrorType* CallTreeNode::AddAndGetUnwindErrorType(CallstackType type) {
-  const auto& [it, inserted] = unwind_error_type_children_.try_emplace(
+  const auto& [it, inserted] = GetOrCreateChildren().unwind_error_types.try_emplace(
       type, std::make_unique<CallTreeUnwindErrorType>(this, type));
   ORBIT_CHECK(inserted);
-  children_cache_.reset();
   return it->second.get();
 }
 
-CallTreeUnwindErrors* CallTreeNode::GetUnwindErrorsOrNull() { return unwind_errors_child_.get(); }
+CallTreeUnwindErrors* CallTreeNode::GetUnwindErrorsOrNull() {
+  if (children_ == nullptr) return nullptr;
+  return children_->unwind_errors.get();
+}
 
 CallTreeUnwindErrors* CallTreeNode::AddAndGetUnwindErrors() {
-  ORBIT_CHECK(unwind_errors_child_ == nullptr);
-  unwind_errors_child_ = std::make_unique<CallTreeUnwindErrors>(this);
-  children_cache_.reset();
-  return unwind_errors_child_.get();
+  Children& children = GetOrCreateChildren();
+  ORBIT_CHECK(children.unwind_errors == nullptr);
+  children.unwind_errors = std::make_unique<CallTreeUnwindErrors>(this);
+  return children.unwind_errors.get();
+}
+
+template <typename Key, typename Node>
+void CallTreeNode::MergeChildrenFrom(
+    absl::flat_hash_map<Key, std::unique_ptr<Node>>& children,
+    absl::flat_hash_map<Key, std::unique_ptr<Node>>& other_children) {
+  for (auto& [key, other_child] : other_children) {
+    auto [it, inserted] = children.try_emplace(key, std::move(other_child));
+    if (inserted) {
+      static_cast<CallTreeNode*>(it->second.get())->parent_ = this;
+    } else {
+      it->second->MergeFrom(std::move(*other_child));
+    }
+  }
+}
+
+void CallTreeNode::MergeFrom(CallTreeNode&& other) {
+  sample_count_ += other.sample_count_;
+  exclusive_callstack_events_.insert(exclusive_callstack_events_.end(),
+                                     other.exclusive_callstack_events_.begin(),
+                                     other.exclusive_callstack_events_.end());
+  other.sample_count_ = 0;
+  other.exclusive_callstack_events_.clear();
+  if (other.children_ == nullptr) return;
+
+  Children& children = GetOrCreateChildren();
+  Children& other_children = *other.children_;
+  MergeChildrenFrom(children.threads, other_children.threads);
+  MergeChildrenFrom(children.functions, other_children.functions);
+  MergeChildrenFrom(children.unwind_error_types, other_children.unwind_error_types);
+  if (other_children.unwind_errors != nullptr) {
+    if (children.unwind_errors != nullptr) {
+      children.unwind_errors->MergeFrom(std::move(*other_children.unwind_errors));
+    } else {
+      children.unwind_errors = std::move(other_children.unwind_errors);
+      static_cast<CallTreeNode*>(children.unwind_errors.get())->parent_ = this;
+    }
+  }
+  other.children_.reset();
 }
 
 std::string CallTreeFunction::RetrieveFunctionName(
@@ -211,42 +270,83 @@ static void AddUnwindErrorToTopDownThread(
   return thread_node;
 }
 
+// Creates the root of a call tree from one shard per ThreadSampleData, created in parallel by
+// `create_shard` and merged in the order of the ThreadSampleData.
+template <typename CreateShard>
+[[nodiscard]] static std::unique_ptr<CallTreeRoot> CreateCallTreeRootFromShards(
+    const PostProcessedSamplingData& post_processed_sampling_data, CreateShard&& create_shard) {
+  const std::vector<const ThreadSampleData*> thread_sample_datas =
+      post_processed_sampling_data.GetSortedThreadSampleData();
+  std::vector<std::unique_ptr<CallTreeRoot>> shards(thread_sample_datas.size());
+  {
+    orbit_base::TaskGroup task_group;
+    for (size_t i = 0; i < thread_sample_datas.size(); ++i) {
+      task_group.AddTask([&create_shard, &shard = shards[i],
+                          thread_sample_data = thread_sample_datas[i]]() {
+        ORBIT_SCOPE("CreateCallTreeShard");
+        shard = create_shard(*thread_sample_data);
+      });
+    }
+    task_group.Wait();
+  }
+
+  ORBIT_SCOPE("MergeCallTreeShards");
+  auto root = std::make_unique<CallTreeRoot>();
+  for (std::unique_ptr<CallTreeRoot>& shard : shards) {
+    root->MergeFrom(std::move(*shard));
+  }
+  return root;
+}
+
+[[nodiscard]] static std::unique_ptr<CallTreeRoot> CreateTopDownShard(
+    const PostProcessedSamplingData& post_processed_sampling_data,
+    const ThreadSampleData& thread_sample_data, std::string_view process_name,
+    const absl::flat_hash_map<uint32_t, std::string>& thread_names) {
+  auto shard_root = std::make_unique<CallTreeRoot>();
+  const uint32_t tid = thread_sample_data.thread_id;
+
+  for (const auto& [callstack_id, callstack_events] :
+       thread_sample_data.sampled_callstack_id_to_events) {
+    uint64_t sample_count = callstack_events.size();
+
+    // Don't count samples from the all-thread case again.
+    if (tid != orbit_base::kAllProcessThreadsTid) {
+      shard_root->IncreaseSampleCount(sample_count);
+    }
+
+    CallTreeThread* thread_node =
+        GetOrCreateThreadNode(shard_root.get(), tid, process_name, thread_names);
+    thread_node->IncreaseSampleCount(sample_count);
+
+    const CallstackInfo& resolved_callstack =
+        post_processed_sampling_data.GetResolvedCallstack(callstack_id);
+    if (resolved_callstack.type() == CallstackType::kComplete) {
+      AddCallstackToTopDownThread(thread_node, resolved_callstack, callstack_events);
+    } else {
+      AddUnwindErrorToTopDownThread(thread_node, resolved_callstack, callstack_events);
+    }
+  }
+  return shard_root;
+}
+
 std::unique_ptr<CallTreeView> CallTreeView::CreateTopDownViewFromPostProcessedSamplingData(
     const PostProcessedSamplingData& post_processed_sampling_data,
     const ModuleManager* module_manager, const CaptureData* capture_data) {
   ORBIT_SCOPE_FUNCTION;
   ORBIT_SCOPED_TIMED_LOG("CreateTopDownViewFromPostProcessedSamplingData");
 
-  auto top_down_view_root = std::make_unique<CallTreeRoot>();
   const std::string& process_name = capture_data->process_name();
   const absl::flat_hash_map<uint32_t, std::string>& thread_names = capture_data->thread_names();
 
-  for (const ThreadSampleData* thread_sample_data :
-       post_processed_sampling_data.GetSortedThreadSampleData()) {
-    const uint32_t tid = thread_sample_data->thread_id;
-
-    for (const auto& [callstack_id, callstack_events] :
-         thread_sample_data->sampled_callstack_id_to_events) {
-      uint64_t sample_count = callstack_events.size();
-
-      // Don't count samples from the all-thread case again.
-      if (tid != orbit_base::kAllProcessThreadsTid) {
-        top_down_view_root->IncreaseSampleCount(sample_count);
-      }
-
-      CallTreeThread* thread_node =
-          GetOrCreateThreadNode(top_down_view_root.get(), tid, process_name, thread_names);
-      thread_node->IncreaseSampleCount(sample_count);
-
-      const CallstackInfo& resolved_callstack =
-          post_processed_sampling_data.GetResolvedCallstack(callstack_id);
-      if (resolved_callstack.type() == CallstackType::kComplete) {
-        AddCallstackToTopDownThread(thread_node, resolved_callstack, callstack_events);
-      } else {
-        AddUnwindErrorToTopDownThread(thread_node, resolved_callstack, callstack_events);
-      }
-    }
-  }
+  // Each thread has its own subtree in the top-down view, so the shards don't overlap below the
+  // root.
+  std::unique_ptr<CallTreeRoot> top_down_view_root = CreateCallTreeRootFromShards(
+      post_processed_sampling_data,
+      [&post_processed_sampling_data, &process_name,
+       &thread_names](const ThreadSampleData& thread_sample_data) {
+        return CreateTopDownShard(post_processed_sampling_data, thread_sample_data, process_name,
+                                  thread_names);
+      });
   return absl::WrapUnique<CallTreeView>(
       new CallTreeView(std::move(top_down_view_root), module_manager, capture_data));
 }
@@ -286,45 +386,55 @@ AddUnwindErrorToBottomUpViewAndReturnUnwindErrorTypeNode(CallTreeRoot* bottom_up
   return unwind_error_type_node;
 }
 
+[[nodiscard]] static std::unique_ptr<CallTreeRoot> CreateBottomUpShard(
+    const PostProcessedSamplingData& post_processed_sampling_data,
+    const ThreadSampleData& thread_sample_data, std::string_view process_name,
+    const absl::flat_hash_map<uint32_t, std::string>& thread_names) {
+  auto shard_root = std::make_unique<CallTreeRoot>();
+  const uint32_t tid = thread_sample_data.thread_id;
+  if (tid == orbit_base::kAllProcessThreadsTid) {
+    return shard_root;
+  }
+
+  for (const auto& [callstack_id, callstack_events] :
+       thread_sample_data.sampled_callstack_id_to_events) {
+    uint64_t sample_count = callstack_events.size();
+    shard_root->IncreaseSampleCount(sample_count);
+
+    const CallstackInfo& resolved_callstack =
+        post_processed_sampling_data.GetResolvedCallstack(callstack_id);
+    CallTreeNode* last_node{};
+    if (resolved_callstack.type() == CallstackType::kComplete) {
+      last_node = AddReversedCallstackToBottomUpViewAndReturnLastFunction(
+          shard_root.get(), resolved_callstack, sample_count);
+    } else {
+      last_node = AddUnwindErrorToBottomUpViewAndReturnUnwindErrorTypeNode(
+          shard_root.get(), resolved_callstack, sample_count);
+    }
+    CallTreeThread* thread_node = GetOrCreateThreadNode(last_node, tid, process_name, thread_names);
+    thread_node->IncreaseSampleCount(sample_count);
+    thread_node->AddExclusiveCallstackEvents(callstack_events);
+  }
+  return shard_root;
+}
+
 std::unique_ptr<CallTreeView> CallTreeView::CreateBottomUpViewFromPostProcessedSamplingData(
     const PostProcessedSamplingData& post_processed_sampling_data,
     const ModuleManager* module_manager, const CaptureData* capture_data) {
   ORBIT_SCOPE_FUNCTION;
   ORBIT_SCOPED_TIMED_LOG("CreateBottomUpViewFromPostProcessedSamplingData");
 
-  auto bottom_up_view_root = std::make_unique<CallTreeRoot>();
   const std::string& process_name = capture_data->process_name();
   const absl::flat_hash_map<uint32_t, std::string>& thread_names = capture_data->thread_names();
 
-  for (const ThreadSampleData* thread_sample_data :
-       post_processed_sampling_data.GetSortedThreadSampleData()) {
-    const uint32_t tid = thread_sample_data->thread_id;
-    if (tid == orbit_base::kAllProcessThreadsTid) {
-      continue;
-    }
-
-    for (const auto& [callstack_id, callstack_events] :
-         thread_sample_data->sampled_callstack_id_to_events) {
-      uint64_t sample_count = callstack_events.size();
-      bottom_up_view_root->IncreaseSampleCount(sample_count);
-
-      const CallstackInfo& resolved_callstack =
-          post_processed_sampling_data.GetResolvedCallstack(callstack_id);
-      CallTreeNode* last_node{};
-      if (resolved_callstack.type() == CallstackType::kComplete) {
-        last_node = AddReversedCallstackToBottomUpViewAndReturnLastFunction(
-            bottom_up_view_root.get(), resolved_callstack, sample_count);
-      } else {
-        last_node = AddUnwindErrorToBottomUpViewAndReturnUnwindErrorTypeNode(
-            bottom_up_view_root.get(), resolved_callstack, sample_count);
-      }
-      CallTreeThread* thread_node =
-          GetOrCreateThreadNode(last_node, tid, process_name, thread_names);
-      thread_node->IncreaseSampleCount(sample_count);
-      thread_node->AddExclusiveCallstackEvents(callstack_events);
-    }
-  }
-
+  // The shards of the threads overlap wherever threads share frames, and are merged node by node.
+  std::unique_ptr<CallTreeRoot> bottom_up_view_root = CreateCallTreeRootFromShards(
+      post_processed_sampling_data,
+      [&post_processed_sampling_data, &process_name,
+       &thread_names](const ThreadSampleData& thread_sample_data) {
+        return CreateBottomUpShard(post_processed_sampling_data, thread_sample_data, process_name,
+                                   thread_names);
+      });
   return absl::WrapUnique<CallTreeView>(
       new CallTreeView(std::move(bottom_up_view_root), module_manager, capture_data));
 }
@@ -0,0 +1,104 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ClientData/CallstackEvent.h"
+#include "ClientData/CallstackType.h"
+#include "OrbitGl/CallTreeView.h"
+
+using orbit_client_data::CallstackEvent;
+using orbit_client_data::CallstackType;
+
+namespace {
+
+constexpr uint32_t kThreadId = 42;
+constexpr uint32_t kOtherThreadId = 43;
+constexpr uint64_t kOuterFunction = 0x10;
+constexpr uint64_t kInnerFunction = 0x20;
+constexpr uint64_t kOtherInnerFunction = 0x30;
+
+// Adds `thread_id` -> `outer_function` -> `inner_function` with `sample_count` samples to `root`.
+void AddSamples(CallTreeRoot& root, uint32_t thread_id, uint64_t outer_function,
+                uint64_t inner_function, uint64_t sample_count) {
+  root.IncreaseSampleCount(sample_count);
+  CallTreeThread* thread = root.GetThreadOrNull(thread_id);
+  if (thread == nullptr) thread = root.AddAndGetThread(thread_id, "thread");
+  thread->IncreaseSampleCount(sample_count);
+  CallTreeFunction* outer = thread->GetFunctionOrNull(outer_function);
+  if (outer == nullptr) outer = thread->AddAndGetFunction(outer_function);
+  outer->IncreaseSampleCount(sample_count);
+  CallTreeFunction* inner = outer->GetFunctionOrNull(inner_function);
+  if (inner == nullptr) inner = outer->AddAndGetFunction(inner_function);
+  inner->IncreaseSampleCount(sample_count);
+  inner->AddExclusiveCallstackEvents(
+      std::vector<CallstackEvent>(sample_count, CallstackEvent{1, 1, thread_id}));
+}
+
+}  // namespace
+
+TEST(CallTreeNode, LeavesHaveNoChildren) {
+  CallTreeRoot root;
+  EXPECT_EQ(root.child_count(), 0);
+  EXPECT_EQ(root.thread_count(), 0);
+  EXPECT_TRUE(root.children().empty());
+  EXPECT_EQ(root.GetThreadOrNull(kThreadId), nullptr);
+  EXPECT_EQ(root.GetFunctionOrNull(kOuterFunction), nullptr);
+  EXPECT_EQ(root.GetUnwindErrorsOrNull(), nullptr);
+  EXPECT_EQ(root.GetUnwindErrorTypeOrNull(CallstackType::kDwarfUnwindingError), nullptr);
+}
+
+TEST(CallTreeNode, MergeFromMergesCommonNodesAndMovesOthers) {
+  CallTreeRoot root;
+  AddSamples(root, kThreadId, kOuterFunction, kInnerFunction, 2);
+  // Populate the cache of the children, which the merge has to invalidate.
+  EXPECT_EQ(root.children().size(), 1);
+
+  CallTreeRoot other;
+  AddSamples(other, kThreadId, kOuterFunction, kInnerFunction, 3);
+  AddSamples(other, kThreadId, kOuterFunction, kOtherInnerFunction, 4);
+  AddSamples(other, kOtherThreadId, kOuterFunction, kInnerFunction, 5);
+  other.AddAndGetUnwindErrors()->IncreaseSampleCount(1);
+
+  root.MergeFrom(std::move(other));
+
+  EXPECT_EQ(other.sample_count(), 0);
+  EXPECT_EQ(other.child_count(), 0);
+
+  EXPECT_EQ(root.sample_count(), 14);
+  EXPECT_EQ(root.thread_count(), 2);
+  EXPECT_EQ(root.child_count(), 3);
+  EXPECT_EQ(root.children().size(), 3);
+  ASSERT_NE(root.GetUnwindErrorsOrNull(), nullptr);
+  EXPECT_EQ(root.GetUnwindErrorsOrNull()->sample_count(), 1);
+  EXPECT_EQ(root.GetUnwindErrorsOrNull()->parent(), &root);
+
+  CallTreeThread* thread = root.GetThreadOrNull(kThreadId);
+  ASSERT_NE(thread, nullptr);
+  EXPECT_EQ(thread->sample_count(), 9);
+  CallTreeFunction* outer = thread->GetFunctionOrNull(kOuterFunction);
+  ASSERT_NE(outer, nullptr);
+  EXPECT_EQ(outer->sample_count(), 9);
+  EXPECT_EQ(outer->children().size(), 2);
+
+  CallTreeFunction* inner = outer->GetFunctionOrNull(kInnerFunction);
+  ASSERT_NE(inner, nullptr);
+  EXPECT_EQ(inner->sample_count(), 5);
+  EXPECT_EQ(inner->GetExclusiveSampleCount(), 5);
+
+  CallTreeFunction* other_inner = outer->GetFunctionOrNull(kOtherInnerFunction);
+  ASSERT_NE(other_inner, nullptr);
+  EXPECT_EQ(other_inner->sample_count(), 4);
+  EXPECT_EQ(other_inner->parent(), outer);
+
+  CallTreeThread* other_thread = root.GetThreadOrNull(kOtherThreadId);
+  ASSERT_NE(other_thread, nullptr);
+  EXPECT_EQ(other_thread->sample_count(), 5);
+  EXPECT_EQ(other_thread->parent(), &root);
+}
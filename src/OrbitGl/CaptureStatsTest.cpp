@@ -13,7 +13,7 @@
 #include <utility>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Result.h"
 #include "OrbitGl/CaptureStats.h"
 #include "OrbitGl/SchedulingStats.h"
@@ -25,7 +25,7 @@ TEST(CaptureStats, NullCaptureWindow) {
 }
 
 TEST(SchedulingStats, ZeroSchedulingScopes) {
-  std::vector<const orbit_client_protos::TimerInfo*> scheduling_scopes;
+  std::vector<const orbit_client_data::TimerInfo*> scheduling_scopes;
   SchedulingStats::ThreadNameProvider thread_name_provider = [](uint32_t thread_id) {
     return std::to_string(thread_id);
   };
@@ -40,11 +40,10 @@ TEST(SchedulingStats, ZeroSchedulingScopes) {
 }
 
 TEST(SchedulingStats, SchedulingStats) {
-  std::list<orbit_client_protos::TimerInfo>
-      scope_buffer;  // Use a list as we need pointer stability.
+  std::list<orbit_client_data::TimerInfo> scope_buffer;  // Use a list as we need pointer stability.
   auto create_scope = [&scope_buffer](uint32_t pid, uint32_t tid, int32_t cpu, uint64_t start_ns,
                                       uint64_t end_ns) {
-    orbit_client_protos::TimerInfo timer_info;
+    orbit_client_data::TimerInfo timer_info;
     timer_info.set_start(start_ns);
     timer_info.set_end(end_ns);
     timer_info.set_thread_id(tid);
@@ -53,7 +52,7 @@ TEST(SchedulingStats, SchedulingStats) {
     return &scope_buffer.emplace_back(std::move(timer_info));
   };
 
-  std::vector<const orbit_client_protos::TimerInfo*> scopes;
+  std::vector<const orbit_client_data::TimerInfo*> scopes;
   SchedulingStats::ThreadNameProvider thread_name_provider = [](uint32_t thread_id) {
     return std::to_string(thread_id);
   };
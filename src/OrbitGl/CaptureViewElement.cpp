@@ -55,15 +55,25 @@ void CaptureViewElement::UpdatePrimitives(PrimitiveAssembler& primitive_assemble
 
   DoUpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
 
+  std::vector<CaptureViewElement*> children;
   for (CaptureViewElement* child : GetChildrenVisibleInViewport()) {
-    if (child->ShouldBeRendered()) {
-      child->UpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
-    }
+    if (child->ShouldBeRendered()) children.push_back(child);
   }
+  UpdateChildrenPrimitives(children, primitive_assembler, text_renderer, min_tick, max_tick,
+                           picking_mode);
 
   PostRender(std::move(previous_groups), primitive_assembler, text_renderer);
 }
 
+void CaptureViewElement::UpdateChildrenPrimitives(const std::vector<CaptureViewElement*>& children,
+                                                  PrimitiveAssembler& primitive_assembler,
+                                                  TextRenderer& text_renderer, uint64_t min_tick,
+                                                  uint64_t max_tick, PickingMode picking_mode) {
+  for (CaptureViewElement* child : children) {
+    child->UpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
+  }
+}
+
 CaptureViewElement::EventResult CaptureViewElement::OnMouseWheel(
     const Vec2& /*mouse_pos*/, int /*delta*/, const ModifierKeys& /*modifiers*/) {
   return EventResult::kIgnored;
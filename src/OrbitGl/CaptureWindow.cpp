@@ -32,7 +32,7 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/DataManager.h"
 #include "ClientData/ThreadStateSliceInfo.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitAccessibility/AccessibleInterface.h"
 #include "OrbitAccessibility/AccessibleWidgetBridge.h"
@@ -94,7 +94,7 @@ class AccessibleCaptureWindow : public AccessibleWidgetBridge {
   CaptureWindow* window_;
 };
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 CaptureWindow::CaptureWindow(
     OrbitApp* app, orbit_capture_client::CaptureControlInterface* capture_control_interface,
@@ -214,7 +214,7 @@ void CaptureWindow::HandlePickedElement(PickingMode picking_mode, PickingId pick
   if (picking_mode == PickingMode::kClick) {
     background_clicked_ = false;
     const orbit_gl::PickingUserData* user_data = batcher.GetUserData(picking_id);
-    const orbit_client_protos::TimerInfo* timer_info =
+    const orbit_client_data::TimerInfo* timer_info =
         (user_data == nullptr ? nullptr : user_data->timer_info_);
     if (timer_info != nullptr) {
       SelectTimer(timer_info);
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "ApiInterface/Orbit.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitGl/GlCanvas.h"
 #include "OrbitGl/GlUtils.h"
@@ -24,7 +25,7 @@
 
 using orbit_client_data::CaptureData;
 using orbit_client_data::FunctionInfo;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_gl::PrimitiveAssembler;
 using orbit_gl::TextRenderer;
@@ -99,7 +100,7 @@ float FrameTrack::GetDynamicBoxHeight(const TimerInfo& timer_info) const {
   return static_cast<float>(ratio) * GetAverageBoxHeight();
 }
 
-Color FrameTrack::GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
+Color FrameTrack::GetTimerColor(const orbit_client_data::TimerInfo& timer_info,
                                 bool /*is_selected*/, bool /*is_highlighted*/,
                                 const internal::DrawData& /*draw_data*/) const {
   Vec4 min_color(76.f, 175.f, 80.f, 255.f);
@@ -180,7 +181,7 @@ std::string FrameTrack::GetTooltip() const {
 
 std::string FrameTrack::GetBoxTooltip(const PrimitiveAssembler& primitive_assembler,
                                       PickingId id) const {
-  const orbit_client_protos::TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
+  const orbit_client_data::TimerInfo* timer_info = primitive_assembler.GetTimerInfo(id);
   if (timer_info == nullptr) {
     return "";
   }
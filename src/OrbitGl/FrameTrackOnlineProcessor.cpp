@@ -11,12 +11,13 @@
 #include <utility>
 
 #include "ClientData/CaptureData.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitGl/TimeGraph.h"
 
 namespace orbit_gl {
 
 void CreateFrameTrackTimer(uint64_t function_id, uint64_t start_ns, uint64_t end_ns, int frame_id,
-                           orbit_client_protos::TimerInfo* timer_info) {
+                           orbit_client_data::TimerInfo* timer_info) {
   // TID is meaningless for this timer (start and end can be on two different threads).
   constexpr const int32_t kUnusedThreadId = -1;
   timer_info->set_thread_id(kUnusedThreadId);
@@ -25,7 +26,7 @@ void CreateFrameTrackTimer(uint64_t function_id, uint64_t start_ns, uint64_t end
   timer_info->set_end(end_ns);
   // We use user_data_key to keep track of the frame number.
   timer_info->set_user_data_key(frame_id);
-  timer_info->set_type(orbit_client_protos::TimerInfo::kFrame);
+  timer_info->set_type(orbit_client_data::TimerInfo::kFrame);
 }
 
 FrameTrackOnlineProcessor::FrameTrackOnlineProcessor(
@@ -39,7 +40,7 @@ FrameTrackOnlineProcessor::FrameTrackOnlineProcessor(
   }
 }
 
-void FrameTrackOnlineProcessor::ProcessTimer(const orbit_client_protos::TimerInfo& timer_info) {
+void FrameTrackOnlineProcessor::ProcessTimer(const orbit_client_data::TimerInfo& timer_info) {
   uint64_t function_id = timer_info.function_id();
 
   if (!current_frame_track_function_ids_.contains(function_id)) {
@@ -52,7 +53,7 @@ void FrameTrackOnlineProcessor::ProcessTimer(const orbit_client_protos::TimerInf
   }
 
   if (previous_timestamp_ns < timer_info.start()) {
-    orbit_client_protos::TimerInfo frame_timer;
+    orbit_client_data::TimerInfo frame_timer;
     CreateFrameTrackTimer(function_id, previous_timestamp_ns, timer_info.start(),
                           current_frame_index_++, &frame_timer);
     time_graph_->ProcessTimer(frame_timer);
@@ -11,7 +11,7 @@
 #include <memory>
 #include <optional>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitGl/GlUtils.h"
@@ -20,7 +20,7 @@
 #include "OrbitGl/TimeGraph.h"
 #include "OrbitGl/TimeGraphLayout.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using orbit_gl::PrimitiveAssembler;
 
 GpuDebugMarkerTrack::GpuDebugMarkerTrack(CaptureViewElement* parent,
@@ -11,7 +11,7 @@
 #include <optional>
 
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/ThreadConstants.h"
@@ -22,7 +22,7 @@
 #include "OrbitGl/TimeGraphLayout.h"
 
 using orbit_client_data::TimerChain;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using orbit_gl::PrimitiveAssembler;
 
 constexpr const char* kSwQueueString = "sw queue";
@@ -54,7 +54,7 @@ std::string GpuSubmissionTrack::GetTooltip() const {
          "submissions";
 }
 
-void GpuSubmissionTrack::OnTimer(const orbit_client_protos::TimerInfo& timer_info) {
+void GpuSubmissionTrack::OnTimer(const orbit_client_data::TimerInfo& timer_info) {
   // In case of having command buffer timers, we need to double the depth of the GPU timers (as we
   // are drawing the corresponding command buffer timers below them). Therefore, we watch out for
   // those timers.
@@ -277,7 +277,7 @@ std::string GpuSubmissionTrack::GetHwExecutionTooltip(const TimerInfo& timer_inf
 }
 
 std::string GpuSubmissionTrack::GetCommandBufferTooltip(
-    const orbit_client_protos::TimerInfo& timer_info) const {
+    const orbit_client_data::TimerInfo& timer_info) const {
   return absl::StrFormat(
       "<b>Command Buffer Execution</b><br/>"
       "<i>At `vkBeginCommandBuffer` and `vkEndCommandBuffer` `vkCmdWriteTimestamp`s have been "
@@ -10,7 +10,7 @@
 #include <memory>
 
 #include "ClientData/CaptureData.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/OrbitApp.h"
@@ -18,7 +18,7 @@
 #include "OrbitGl/Viewport.h"
 #include "StringManager/StringManager.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 namespace orbit_gl {
 
@@ -26,9 +26,9 @@
 #include "ClientData/PageFaultsInfo.h"
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TracepointEventInfo.h"
 #include "ClientData/TracepointInfo.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "GrpcProtos/module.pb.h"
 #include "OrbitBase/Logging.h"
@@ -48,6 +48,12 @@ void HandleCaptureEvent(const orbit_api::ApiScopeStart& scope_start,
   api_event_processor->ProcessApiScopeStart(api_event);
 }
 
+// Introspection doesn't intern scope names, see orbit_introspection::IntrospectionListener.
+void HandleCaptureEvent(const orbit_api::ApiInternedScopeStart& /*interned_scope_start*/,
+                        orbit_capture_client::ApiEventProcessor* /*api_event_processor*/) {
+  ORBIT_UNREACHABLE();
+}
+
 void HandleCaptureEvent(const orbit_api::ApiScopeStop& scope_stop,
                         orbit_capture_client::ApiEventProcessor* api_event_processor) {
   orbit_grpc_protos::ApiScopeStop api_event;
@@ -62,6 +68,11 @@ void HandleCaptureEvent(const orbit_api::ApiScopeStartAsync& scope_start_async,
   api_event_processor->ProcessApiScopeStartAsync(api_event);
 }
 
+void HandleCaptureEvent(const orbit_api::ApiInternedScopeStartAsync& /*interned_scope_start_async*/,
+                        orbit_capture_client::ApiEventProcessor* /*api_event_processor*/) {
+  ORBIT_UNREACHABLE();
+}
+
 void HandleCaptureEvent(const orbit_api::ApiScopeStopAsync& scope_stop_async,
                         orbit_capture_client::ApiEventProcessor* api_event_processor) {
   orbit_grpc_protos::ApiScopeStopAsync api_event;
@@ -133,7 +144,7 @@ class IntrospectionCaptureListener : public orbit_capture_client::CaptureListene
   }
 
  private:
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override {
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override {
     introspection_window_->GetTimeGraph()->ProcessTimer(timer_info);
   }
 
@@ -28,13 +28,9 @@ void MockTextRenderer::Clear() {
   num_add_text_calls_ = 0;
 }
 
-void MockTextRenderer::AddText(const char* text, float x, float y, float z,
-                               TextFormatting formatting) {
-  return AddText(text, x, y, z, formatting, nullptr, nullptr);
-}
-
-void MockTextRenderer::AddText(const char* text, float x, float y, float z,
-                               TextFormatting formatting, Vec2* out_text_pos, Vec2* out_text_size) {
+void MockTextRenderer::DoAddText(const char* text, float x, float y, float z,
+                                 TextFormatting formatting, Vec2* out_text_pos,
+                                 Vec2* out_text_size) {
   float text_width = GetStringWidth(text, formatting.font_size);
   if (formatting.max_size > 0) {
     text_width = std::min(text_width, formatting.max_size);
@@ -81,10 +77,10 @@ void MockTextRenderer::AddText(const char* text, float x, float y, float z,
   }
 }
 
-float MockTextRenderer::AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
-                                                        TextFormatting formatting,
-                                                        size_t /*trailing_chars_length*/) {
-  AddText(text, x, y, z, formatting);
+float MockTextRenderer::DoAddTextTrailingCharsPrioritized(const char* text, float x, float y,
+                                                          float z, TextFormatting formatting,
+                                                          size_t /*trailing_chars_length*/) {
+  DoAddText(text, x, y, z, formatting, nullptr, nullptr);
   return GetStringWidth(text, formatting.font_size);
 }
 
@@ -59,13 +59,13 @@
 #include "ClientData/ScopeStats.h"
 #include "ClientData/ScopeStatsCollection.h"
 #include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimestampIntervalSet.h"
 #include "ClientData/TracepointCustom.h"
 #include "ClientData/UserDefinedCaptureData.h"
 #include "ClientFlags/ClientFlags.h"
 #include "ClientModel/CaptureSerializer.h"
 #include "ClientModel/SamplingDataPostProcessor.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "ClientProtos/preset.pb.h"
 #include "ClientProtos/user_defined_capture_info.pb.h"
 #include "ClientServices/TracepointServiceClient.h"
@@ -147,9 +147,9 @@ using orbit_client_data::TimerChain;
 using orbit_client_data::TracepointInfoSet;
 using orbit_client_data::UserDefinedCaptureData;
 
+using orbit_client_data::TimerInfo;
 using orbit_client_protos::PresetInfo;
 using orbit_client_protos::PresetModule;
-using orbit_client_protos::TimerInfo;
 
 using orbit_client_services::CrashManager;
 using orbit_client_services::TracepointServiceClient;
@@ -277,6 +277,9 @@ OrbitApp::OrbitApp(orbit_gl::MainWindowInterface* main_window,
   module_manager_ =
       std::make_unique<orbit_client_data::ModuleManager>(&module_identifier_provider_);
   manual_instrumentation_manager_ = std::make_unique<ManualInstrumentationManager>();
+  thread_track_timer_processor_ = std::make_unique<orbit_capture_client::ShardedTimerProcessor>(
+      orbit_capture_client::ShardedTimerProcessor::GetDefaultNumberOfShards(),
+      [this](const TimerInfo& timer_info) { GetMutableTimeGraph()->ProcessTimer(timer_info); });
 
   QObject::connect(
       &update_after_symbol_loading_throttle_, &orbit_qt_utils::Throttle::Triggered,
@@ -290,6 +293,8 @@ OrbitApp::OrbitApp(orbit_gl::MainWindowInterface* main_window,
 
 OrbitApp::~OrbitApp() {
   AbortCapture();
+  // Processes the pending timers while the time graph still exists.
+  thread_track_timer_processor_.reset();
   RequestSymbolDownloadStop(module_manager_->GetAllModuleData(), false);
   thread_pool_->ShutdownAndWait();
 }
@@ -420,6 +425,7 @@ void OrbitApp::OnCaptureStarted(const orbit_grpc_protos::CaptureStarted& capture
 }
 
 Future<void> OrbitApp::OnCaptureComplete() {
+  thread_track_timer_processor_->Flush();
   GetMutableCaptureData().OnCaptureComplete();
 
   GetMutableCaptureData().ComputeVirtualAddressOfInstrumentedFunctionsIfNecessary(*module_manager_);
@@ -491,7 +497,12 @@ Future<void> OrbitApp::OnCaptureFailed(ErrorMessage error_message) {
 void OrbitApp::OnTimer(const TimerInfo& timer_info) {
   GetMutableCaptureData().UpdateScopeStats(timer_info);
 
-  GetMutableTimeGraph()->ProcessTimer(timer_info);
+  // The tracks of the other timers are not per thread, so they can't be sharded by thread id.
+  if (timer_info.type() == TimerInfo::kNone || timer_info.type() == TimerInfo::kApiScope) {
+    thread_track_timer_processor_->ProcessTimer(timer_info);
+  } else {
+    GetMutableTimeGraph()->ProcessTimer(timer_info);
+  }
   frame_track_online_processor_.ProcessTimer(timer_info);
 }
 
@@ -1000,6 +1011,7 @@ void OrbitApp::StopIntrospection() {
 }
 
 void OrbitApp::RequestUpdatePrimitives() {
+  ++primitives_state_version_;
   if (capture_window_ != nullptr) {
     capture_window_->RequestUpdatePrimitives();
   }
@@ -1129,13 +1141,14 @@ orbit_data_views::PresetLoadState OrbitApp::GetPresetLoadState(const PresetFile&
 }
 
 Future<ErrorMessageOr<CaptureListener::CaptureOutcome>> OrbitApp::LoadCaptureFromFile(
-    const std::filesystem::path& file_path) {
+    const std::filesystem::path& file_path,
+    std::optional<orbit_capture_client::CaptureTimeRange> time_range) {
   if (capture_window_ != nullptr) {
     capture_window_->set_draw_help(false);
   }
   ClearCapture();
   auto load_future = thread_pool_->Schedule(
-      [this, file_path]() -> ErrorMessageOr<CaptureListener::CaptureOutcome> {
+      [this, file_path, time_range]() -> ErrorMessageOr<CaptureListener::CaptureOutcome> {
         capture_loading_cancellation_requested_ = false;
 
         OUTCOME_TRY(const std::unique_ptr<CaptureFile> capture_file,
@@ -1149,7 +1162,8 @@ Future<ErrorMessageOr<CaptureListener::CaptureOutcome>> OrbitApp::LoadCaptureFro
                                                }};
 
         ErrorMessageOr<CaptureListener::CaptureOutcome> load_result =
-            LoadCapture(this, capture_file.get(), &capture_loading_cancellation_requested_);
+            LoadCapture(this, capture_file.get(), &capture_loading_cancellation_requested_,
+                        time_range);
 
         if (load_result.has_value() && load_result.value() == CaptureOutcome::kComplete) {
           OnCaptureComplete();
@@ -1387,6 +1401,7 @@ void OrbitApp::StartCapture() {
   options.record_return_values = absl::GetFlag(FLAGS_show_return_values);
   options.record_arguments = false;
   options.enable_auto_frame_track = data_manager_->enable_auto_frame_track();
+  options.compress_capture_responses = absl::GetFlag(FLAGS_compress_capture_stream);
   options.thread_state_change_callstack_collection =
       data_manager_->thread_state_change_callstack_collection();
 
@@ -1445,6 +1460,9 @@ void OrbitApp::AbortCapture() {
 void OrbitApp::ClearCapture() {
   ORBIT_SCOPE_FUNCTION;
 
+  // The pending timers would otherwise be inserted into the time graph that is about to be cleared.
+  thread_track_timer_processor_->Flush();
+
   ClearSamplingRelatedViews();
   if (capture_window_ != nullptr) {
     capture_window_->ClearTimeGraph();
@@ -2246,11 +2264,11 @@ void OrbitApp::set_hovered_thread_state_slice(
   data_manager_->set_hovered_thread_state_slice(thread_state_slice);
 }
 
-const orbit_client_protos::TimerInfo* OrbitApp::selected_timer() const {
+const orbit_client_data::TimerInfo* OrbitApp::selected_timer() const {
   return data_manager_->selected_timer();
 }
 
-void OrbitApp::SelectTimer(const orbit_client_protos::TimerInfo* timer_info) {
+void OrbitApp::SelectTimer(const orbit_client_data::TimerInfo* timer_info) {
   if (timer_info != nullptr && !IsTimerActive(*timer_info) &&
       timer_info->type() != TimerInfo::kCoreActivity)
     return;
@@ -2273,14 +2291,14 @@ void OrbitApp::DeselectTimer() {
 }
 
 std::optional<ScopeId> OrbitApp::GetScopeIdToHighlight() const {
-  const orbit_client_protos::TimerInfo* timer_info = selected_timer();
+  const orbit_client_data::TimerInfo* timer_info = selected_timer();
 
   if (timer_info == nullptr) return GetHighlightedScopeId();
   return ProvideScopeId(*timer_info);
 }
 
 uint64_t OrbitApp::GetGroupIdToHighlight() const {
-  const orbit_client_protos::TimerInfo* timer_info = selected_timer();
+  const orbit_client_data::TimerInfo* timer_info = selected_timer();
 
   uint64_t selected_group_id =
       timer_info != nullptr ? timer_info->group_id() : data_manager_->highlighted_group_id();
@@ -2377,6 +2395,8 @@ void OrbitApp::UpdateAfterSymbolLoading() {
 
 void OrbitApp::UpdateAfterSymbolLoadingThrottled() {
   ORBIT_SCOPE_FUNCTION;
+  // Sampled addresses can belong to different functions with the new symbols.
+  if (HasCaptureData()) GetCaptureData().GetFunctionAddressCache().Clear();
   update_after_symbol_loading_throttle_.Fire();
 }
 
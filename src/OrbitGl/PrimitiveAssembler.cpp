@@ -14,8 +14,10 @@
 #include <cmath>
 #include <utility>
 
+#include "ClientData/TimerInfo.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/Geometry.h"
+#include "OrbitGl/PrimitiveCache.h"
 
 namespace orbit_gl {
 
@@ -24,7 +26,7 @@ void PrimitiveAssembler::AddLine(const Vec2& from, const Vec2& to, float z, cons
   Color picking_color =
       PickingId::ToColor(PickingType::kLine, batcher_->GetNumElements(), GetBatcherId());
 
-  batcher_->AddLine(from, to, z, color, picking_color, std::move(user_data));
+  AddLineToBatcher(from, to, z, color, picking_color, std::move(user_data));
 }
 
 void PrimitiveAssembler::AddLine(const Vec2& from, const Vec2& to, float z, const Color& color,
@@ -33,7 +35,7 @@ void PrimitiveAssembler::AddLine(const Vec2& from, const Vec2& to, float z, cons
 
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
 
-  batcher_->AddLine(from, to, z, color, picking_color, nullptr);
+  AddLineToBatcher(from, to, z, color, picking_color, nullptr);
 }
 
 void PrimitiveAssembler::AddVerticalLine(const Vec2& pos, float size, float z, const Color& color,
@@ -47,14 +49,14 @@ void PrimitiveAssembler::AddVerticalLine(const Vec2& pos, float size, float z, c
 
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
 
-  batcher_->AddLine(pos, pos + Vec2(0, size), z, color, picking_color, nullptr);
+  AddLineToBatcher(pos, pos + Vec2(0, size), z, color, picking_color, nullptr);
 }
 
 void PrimitiveAssembler::AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
                                 std::unique_ptr<PickingUserData> user_data) {
   Color picking_color =
       PickingId::ToColor(PickingType::kBox, batcher_->GetNumElements(), GetBatcherId());
-  batcher_->AddBox(box, z, colors, picking_color, std::move(user_data));
+  AddBoxToBatcher(box, z, colors, picking_color, std::move(user_data));
 }
 
 void PrimitiveAssembler::AddBox(const Quad& box, float z, const Color& color,
@@ -72,7 +74,7 @@ void PrimitiveAssembler::AddBox(const Quad& box, float z, const Color& color,
   std::array<Color, 4> colors;
   colors.fill(color);
 
-  batcher_->AddBox(box, z, colors, picking_color, nullptr);
+  AddBoxToBatcher(box, z, colors, picking_color, nullptr);
 }
 
 void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z,
@@ -186,7 +188,7 @@ void PrimitiveAssembler::AddShadedBox(const Vec2& pos, const Vec2& size, float z
   GetBoxGradientColors(color, &colors, shading_direction);
   Color picking_color = picking_manager_->GetPickableColor(pickable, GetBatcherId());
   Quad box = MakeBox(pos, size);
-  batcher_->AddBox(box, z, colors, picking_color, nullptr);
+  AddBoxToBatcher(box, z, colors, picking_color, nullptr);
 }
 
 void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Color& color,
@@ -211,7 +213,7 @@ void PrimitiveAssembler::AddTriangle(const Triangle& triangle, float z, const Co
                                      std::unique_ptr<PickingUserData> user_data) {
   std::array<Color, 3> colors;
   colors.fill(color);
-  batcher_->AddTriangle(triangle, z, colors, picking_color, std::move(user_data));
+  AddTriangleToBatcher(triangle, z, colors, picking_color, std::move(user_data));
 }
 
 // Draw a shaded trapezium with two sides parallel to the x-axis or y-axis.
@@ -224,11 +226,11 @@ void PrimitiveAssembler::AddShadedTrapezium(const Quad& trapezium, float z, cons
       PickingId::ToColor(PickingType::kTriangle, batcher_->GetNumElements(), GetBatcherId());
   Triangle triangle_1{trapezium.vertices[0], trapezium.vertices[3], trapezium.vertices[1]};
   std::array<Color, 3> colors_1{colors[0], colors[1], colors[2]};
-  batcher_->AddTriangle(triangle_1, z, colors_1, picking_color,
-                        std::make_unique<PickingUserData>(*user_data));
+  AddTriangleToBatcher(triangle_1, z, colors_1, picking_color,
+                       std::make_unique<PickingUserData>(*user_data));
   Triangle triangle_2{trapezium.vertices[3], trapezium.vertices[2], trapezium.vertices[1]};
   std::array<Color, 3> colors_2{colors[1], colors[2], colors[3]};
-  batcher_->AddTriangle(triangle_2, z, colors_2, picking_color, std::move(user_data));
+  AddTriangleToBatcher(triangle_2, z, colors_2, picking_color, std::move(user_data));
 }
 
 void PrimitiveAssembler::AddCircle(const Vec2& position, float radius, float z,
@@ -347,7 +349,36 @@ void PrimitiveAssembler::GetBoxGradientColors(const Color& color, std::array<Col
 
 void PrimitiveAssembler::StartNewFrame() { batcher_->ResetElements(); }
 
-const orbit_client_protos::TimerInfo* PrimitiveAssembler::GetTimerInfo(PickingId id) const {
+void PrimitiveAssembler::AddLineToBatcher(const Vec2& from, const Vec2& to, float z,
+                                          const Color& color, const Color& picking_color,
+                                          std::unique_ptr<PickingUserData> user_data) {
+  if (recording_cache_ != nullptr) {
+    recording_cache_->RecordLine(from, to, z, color, picking_color, user_data.get());
+  }
+  batcher_->AddLine(from, to, z, color, picking_color, std::move(user_data));
+}
+
+void PrimitiveAssembler::AddBoxToBatcher(const Quad& box, float z,
+                                         const std::array<Color, 4>& colors,
+                                         const Color& picking_color,
+                                         std::unique_ptr<PickingUserData> user_data) {
+  if (recording_cache_ != nullptr) {
+    recording_cache_->RecordBox(box, z, colors, picking_color, user_data.get());
+  }
+  batcher_->AddBox(box, z, colors, picking_color, std::move(user_data));
+}
+
+void PrimitiveAssembler::AddTriangleToBatcher(const Triangle& triangle, float z,
+                                              const std::array<Color, 3>& colors,
+                                              const Color& picking_color,
+                                              std::unique_ptr<PickingUserData> user_data) {
+  if (recording_cache_ != nullptr) {
+    recording_cache_->RecordTriangle(triangle, z, colors, picking_color, user_data.get());
+  }
+  batcher_->AddTriangle(triangle, z, colors, picking_color, std::move(user_data));
+}
+
+const orbit_client_data::TimerInfo* PrimitiveAssembler::GetTimerInfo(PickingId id) const {
   const PickingUserData* data = GetUserData(id);
 
   if (data != nullptr && data->timer_info_ != nullptr) {
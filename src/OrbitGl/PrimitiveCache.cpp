@@ -0,0 +1,146 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/PrimitiveCache.h"
+
+#include <cmath>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_gl {
+
+namespace {
+
+// Maximum difference, in world units, between the recorded and the current width of the recorded
+// time range for the zoom level to be considered unchanged.
+constexpr float kMaxWorldWidthDifference = 0.5f;
+
+[[nodiscard]] std::unique_ptr<PickingUserData> CopyUserData(const PickingUserData* user_data) {
+  if (user_data == nullptr) return nullptr;
+  return std::make_unique<PickingUserData>(*user_data);
+}
+
+[[nodiscard]] Vec2 Translate(const Vec2& point, const Vec2& offset) {
+  return Vec2(point[0] + offset[0], point[1] + offset[1]);
+}
+
+}  // namespace
+
+void PrimitiveCache::StartRecording(PrimitiveAssembler& primitive_assembler,
+                                    TextRenderer& text_renderer,
+                                    const TimelineInfoInterface& timeline_info,
+                                    uint64_t state_hash, uint64_t min_tick, uint64_t max_tick,
+                                    float pos_y) {
+  Clear();
+  state_hash_ = state_hash;
+  min_tick_ = min_tick;
+  max_tick_ = max_tick;
+  min_tick_world_x_ = timeline_info.GetWorldFromTick(min_tick);
+  max_tick_world_x_ = timeline_info.GetWorldFromTick(max_tick);
+  pos_y_ = pos_y;
+
+  primitive_assembler.recording_cache_ = this;
+  text_renderer.recording_cache_ = this;
+}
+
+void PrimitiveCache::StopRecording(PrimitiveAssembler& primitive_assembler,
+                                   TextRenderer& text_renderer) {
+  ORBIT_CHECK(primitive_assembler.recording_cache_ == this);
+  ORBIT_CHECK(text_renderer.recording_cache_ == this);
+  primitive_assembler.recording_cache_ = nullptr;
+  text_renderer.recording_cache_ = nullptr;
+  has_recording_ = true;
+}
+
+bool PrimitiveCache::TryReplay(PrimitiveAssembler& primitive_assembler,
+                               TextRenderer& text_renderer,
+                               const TimelineInfoInterface& timeline_info, uint64_t state_hash,
+                               uint64_t min_tick, uint64_t max_tick, float pos_y) const {
+  if (!has_recording_ || state_hash != state_hash_) return false;
+  if (min_tick < min_tick_ || max_tick > max_tick_) return false;
+
+  const float min_tick_world_x = timeline_info.GetWorldFromTick(min_tick_);
+  const float max_tick_world_x = timeline_info.GetWorldFromTick(max_tick_);
+  if (std::abs((max_tick_world_x - min_tick_world_x) - (max_tick_world_x_ - min_tick_world_x_)) >
+      kMaxWorldWidthDifference) {
+    return false;
+  }
+
+  // The horizontal offset is rounded to whole pixels, so that all primitives move together and
+  // their positions are floored the same way as when they were recorded.
+  const Vec2 offset(std::round(min_tick_world_x - min_tick_world_x_), pos_y - pos_y_);
+
+  Batcher* batcher = primitive_assembler.batcher_;
+  for (const RecordedLine& line : lines_) {
+    batcher->AddLine(Translate(line.line.start_point, offset),
+                     Translate(line.line.end_point, offset), line.z, line.color,
+                     batcher->RemapPickingColor(line.picking_color),
+                     CopyUserData(line.user_data.get()));
+  }
+  for (const RecordedBox& box : boxes_) {
+    Quad translated_box = box.box;
+    for (Vec2& vertex : translated_box.vertices) vertex = Translate(vertex, offset);
+    batcher->AddBox(translated_box, box.z, box.colors,
+                    batcher->RemapPickingColor(box.picking_color),
+                    CopyUserData(box.user_data.get()));
+  }
+  for (const RecordedTriangle& triangle : triangles_) {
+    Triangle translated_triangle = triangle.triangle;
+    for (Vec2& vertex : translated_triangle.vertices) vertex = Translate(vertex, offset);
+    batcher->AddTriangle(translated_triangle, triangle.z, triangle.colors,
+                         batcher->RemapPickingColor(triangle.picking_color),
+                         CopyUserData(triangle.user_data.get()));
+  }
+
+  for (const RecordedText& text : texts_) {
+    if (text.trailing_chars_length.has_value()) {
+      text_renderer.AddTextTrailingCharsPrioritized(text.text.c_str(), text.x + offset[0],
+                                                    text.y + offset[1], text.z, text.formatting,
+                                                    text.trailing_chars_length.value());
+    } else {
+      text_renderer.AddText(text.text.c_str(), text.x + offset[0], text.y + offset[1], text.z,
+                            text.formatting);
+    }
+  }
+
+  return true;
+}
+
+void PrimitiveCache::Clear() {
+  lines_.clear();
+  boxes_.clear();
+  triangles_.clear();
+  texts_.clear();
+  has_recording_ = false;
+}
+
+bool PrimitiveCache::IsEmpty() const {
+  return lines_.empty() && boxes_.empty() && triangles_.empty() && texts_.empty();
+}
+
+void PrimitiveCache::RecordLine(const Vec2& from, const Vec2& to, float z, const Color& color,
+                                const Color& picking_color, const PickingUserData* user_data) {
+  lines_.push_back(RecordedLine{Line{from, to}, z, color, picking_color, CopyUserData(user_data)});
+}
+
+void PrimitiveCache::RecordBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+                               const Color& picking_color, const PickingUserData* user_data) {
+  boxes_.push_back(RecordedBox{box, z, colors, picking_color, CopyUserData(user_data)});
+}
+
+void PrimitiveCache::RecordTriangle(const Triangle& triangle, float z,
+                                    const std::array<Color, 3>& colors, const Color& picking_color,
+                                    const PickingUserData* user_data) {
+  triangles_.push_back(
+      RecordedTriangle{triangle, z, colors, picking_color, CopyUserData(user_data)});
+}
+
+void PrimitiveCache::RecordText(const char* text, float x, float y, float z,
+                                const TextRenderer::TextFormatting& formatting,
+                                std::optional<size_t> trailing_chars_length) {
+  texts_.push_back(RecordedText{text, x, y, z, formatting, trailing_chars_length});
+}
+
+}  // namespace orbit_gl
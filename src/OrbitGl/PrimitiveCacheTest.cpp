@@ -0,0 +1,165 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <GteVector.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/MockBatcher.h"
+#include "OrbitGl/MockTextRenderer.h"
+#include "OrbitGl/MockTimelineInfo.h"
+#include "OrbitGl/PrimitiveAssembler.h"
+#include "OrbitGl/PrimitiveCache.h"
+#include "OrbitGl/TextRenderer.h"
+
+namespace orbit_gl {
+
+namespace {
+
+constexpr float kWorldWidth = 1000.f;
+constexpr uint64_t kStateHash = 42;
+constexpr uint64_t kTimerStartTick = 1000;
+constexpr uint64_t kTimerEndTick = 2000;
+constexpr float kTimerY = 10.f;
+constexpr float kTimerHeight = 20.f;
+const Color kColor{255, 0, 0, 255};
+
+class PrimitiveCacheTest : public testing::Test {
+ protected:
+  PrimitiveCacheTest()
+      : timeline_info_(kWorldWidth),
+        primitive_assembler_(&batcher_, &state_manager_, /*picking_manager=*/nullptr) {
+    timeline_info_.SetMinMax(0, 10'000);
+  }
+
+  // Adds a box and a text for a timer in [kTimerStartTick, kTimerEndTick] while recording the
+  // range [min_tick, max_tick].
+  void Record(uint64_t min_tick, uint64_t max_tick, float pos_y) {
+    cache_.StartRecording(primitive_assembler_, text_renderer_, timeline_info_, kStateHash,
+                          min_tick, max_tick, pos_y);
+    const auto [pos_x, size_x] =
+        timeline_info_.GetBoxPosXAndWidthFromTicks(kTimerStartTick, kTimerEndTick);
+    primitive_assembler_.AddBox(MakeBox({pos_x, pos_y + kTimerY}, {size_x, kTimerHeight}), 0.f,
+                                kColor);
+    text_renderer_.AddText("timer", pos_x, pos_y + kTimerY, 0.f, {});
+    cache_.StopRecording(primitive_assembler_, text_renderer_);
+  }
+
+  void StartNewFrame() {
+    primitive_assembler_.StartNewFrame();
+    text_renderer_.Clear();
+  }
+
+  [[nodiscard]] bool TryReplay(uint64_t min_tick, uint64_t max_tick, float pos_y,
+                               uint64_t state_hash = kStateHash) {
+    return cache_.TryReplay(primitive_assembler_, text_renderer_, timeline_info_, state_hash,
+                            min_tick, max_tick, pos_y);
+  }
+
+  // Whether the box added in the current frame is exactly the one of the timer at (x, y), and the
+  // text starts at the top left corner of it.
+  [[nodiscard]] bool IsTimerAt(float x, float y) const {
+    const float width = timeline_info_.GetWorldFromTick(kTimerEndTick) -
+                        timeline_info_.GetWorldFromTick(kTimerStartTick);
+    const Vec2 text_area_size{kWorldWidth, kWorldWidth};
+    return batcher_.IsEverythingInsideRectangle({x, y + kTimerY}, {width, kTimerHeight}) &&
+           !batcher_.IsEverythingInsideRectangle({x + 1, y + kTimerY}, {width, kTimerHeight}) &&
+           text_renderer_.IsTextInsideRectangle({x, y + kTimerY}, text_area_size) &&
+           !text_renderer_.IsTextInsideRectangle({x + 1, y + kTimerY}, text_area_size);
+  }
+
+  MockTimelineInfo timeline_info_;
+  MockBatcher batcher_;
+  BatchRenderGroupStateManager state_manager_;
+  PrimitiveAssembler primitive_assembler_;
+  MockTextRenderer text_renderer_;
+  PrimitiveCache cache_;
+};
+
+}  // namespace
+
+TEST_F(PrimitiveCacheTest, RecordsWhatIsAddedWhileRecording) {
+  EXPECT_TRUE(cache_.IsEmpty());
+  EXPECT_FALSE(TryReplay(0, 10'000, 0.f));
+
+  Record(0, 10'000, 0.f);
+  EXPECT_FALSE(cache_.IsEmpty());
+  EXPECT_EQ(batcher_.GetNumBoxes(), 1);
+  EXPECT_EQ(text_renderer_.GetNumAddTextCalls(), 1);
+
+  // Primitives added after StopRecording are not recorded.
+  primitive_assembler_.AddBox(MakeBox({0.f, 0.f}, {1.f, 1.f}), 0.f, kColor);
+
+  StartNewFrame();
+  EXPECT_TRUE(TryReplay(0, 10'000, 0.f));
+  EXPECT_EQ(batcher_.GetNumBoxes(), 1);
+  EXPECT_EQ(text_renderer_.GetNumAddTextCalls(), 1);
+  EXPECT_TRUE(IsTimerAt(100.f, 0.f));
+
+  cache_.Clear();
+  EXPECT_TRUE(cache_.IsEmpty());
+  EXPECT_FALSE(TryReplay(0, 10'000, 0.f));
+}
+
+TEST_F(PrimitiveCacheTest, ReplayIsTranslatedWhenPanning) {
+  timeline_info_.SetMinMax(0, 5'000);
+  Record(0, 10'000, 0.f);
+  ASSERT_TRUE(IsTimerAt(200.f, 0.f));
+
+  // Panning by 500 ticks, a tenth of the visible range, moves everything 100 units to the left.
+  timeline_info_.SetMinMax(500, 5'500);
+  StartNewFrame();
+  ASSERT_TRUE(TryReplay(500, 5'500, 0.f));
+  EXPECT_EQ(batcher_.GetNumBoxes(), 1);
+  EXPECT_EQ(text_renderer_.GetNumAddTextCalls(), 1);
+  EXPECT_TRUE(IsTimerAt(100.f, 0.f));
+}
+
+TEST_F(PrimitiveCacheTest, ReplayIsTranslatedWhenScrolling) {
+  Record(0, 10'000, 0.f);
+
+  StartNewFrame();
+  ASSERT_TRUE(TryReplay(0, 10'000, 50.f));
+  EXPECT_TRUE(IsTimerAt(100.f, 50.f));
+}
+
+TEST_F(PrimitiveCacheTest, NoReplayOutsideOfTheRecordedRange) {
+  timeline_info_.SetMinMax(2'000, 4'000);
+  Record(1'000, 5'000, 0.f);
+
+  StartNewFrame();
+  EXPECT_TRUE(TryReplay(1'000, 3'000, 0.f));
+  StartNewFrame();
+  EXPECT_FALSE(TryReplay(500, 2'500, 0.f));
+  EXPECT_FALSE(TryReplay(4'000, 6'000, 0.f));
+  EXPECT_EQ(batcher_.GetNumElements(), 0);
+  EXPECT_EQ(text_renderer_.GetNumAddTextCalls(), 0);
+}
+
+TEST_F(PrimitiveCacheTest, NoReplayWhenTheStateChanges) {
+  Record(0, 10'000, 0.f);
+
+  StartNewFrame();
+  EXPECT_FALSE(TryReplay(0, 10'000, 0.f, kStateHash + 1));
+  EXPECT_EQ(batcher_.GetNumElements(), 0);
+}
+
+TEST_F(PrimitiveCacheTest, NoReplayWhenZooming) {
+  timeline_info_.SetMinMax(0, 5'000);
+  Record(0, 10'000, 0.f);
+
+  timeline_info_.SetMinMax(0, 4'000);
+  StartNewFrame();
+  EXPECT_FALSE(TryReplay(0, 4'000, 0.f));
+
+  timeline_info_.SetMinMax(0, 5'000);
+  timeline_info_.SetWorldWidth(kWorldWidth / 2);
+  EXPECT_FALSE(TryReplay(0, 5'000, 0.f));
+  EXPECT_EQ(batcher_.GetNumElements(), 0);
+}
+
+}  // namespace orbit_gl
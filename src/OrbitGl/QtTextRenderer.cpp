@@ -128,13 +128,9 @@ std::vector<BatchRenderGroupId> QtTextRenderer::GetRenderGroups() const {
   return result;
 };
 
-void QtTextRenderer::AddText(const char* text, float x, float y, float z,
-                             TextFormatting formatting) {
-  AddText(text, x, y, z, formatting, nullptr, nullptr);
-}
-
-void QtTextRenderer::AddText(const char* text, float x, float y, float z, TextFormatting formatting,
-                             Vec2* out_text_pos, Vec2* out_text_size) {
+void QtTextRenderer::DoAddText(const char* text, float x, float y, float z,
+                               TextFormatting formatting, Vec2* out_text_pos,
+                               Vec2* out_text_size) {
   if (out_text_pos != nullptr) {
     (*out_text_pos)[0] = (*out_text_pos)[1] = 0.f;
   }
@@ -185,9 +181,9 @@ void QtTextRenderer::AddText(const char* text, float x, float y, float z, TextFo
   }
 }
 
-float QtTextRenderer::AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
-                                                      TextFormatting formatting,
-                                                      size_t trailing_chars_length) {
+float QtTextRenderer::DoAddTextTrailingCharsPrioritized(const char* text, float x, float y,
+                                                        float z, TextFormatting formatting,
+                                                        size_t trailing_chars_length) {
   // Early-out: If we can't fit a single char, there's no use to do all the expensive
   // calculations below - this is a major bottleneck in some cases
   if (formatting.max_size >= 0 && GetMinimumTextWidth(formatting.font_size) > formatting.max_size) {
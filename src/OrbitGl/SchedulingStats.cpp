@@ -9,10 +9,10 @@
 
 #include <algorithm>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Sort.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 static constexpr double kNsToMs = 1 / 1000000.0;
 
@@ -21,7 +21,7 @@ SchedulingStats::SchedulingStats(absl::Span<const TimerInfo* const> scheduling_s
                                  uint64_t end_ns)
     : time_range_ms_(static_cast<double>(end_ns - start_ns) * kNsToMs) {
   // Iterate on every scope in the selected range to compute stats.
-  for (const orbit_client_protos::TimerInfo* timer_info : scheduling_scopes) {
+  for (const orbit_client_data::TimerInfo* timer_info : scheduling_scopes) {
     uint64_t clipped_start_ns = std::max(start_ns, timer_info->start());
     uint64_t clipped_end_ns = std::min(end_ns, timer_info->end());
     uint64_t timer_duration_ns = clipped_end_ns - clipped_start_ns;
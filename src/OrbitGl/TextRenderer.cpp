@@ -0,0 +1,30 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/TextRenderer.h"
+
+#include <optional>
+
+#include "OrbitGl/PrimitiveCache.h"
+
+namespace orbit_gl {
+
+void TextRenderer::AddText(const char* text, float x, float y, float z, TextFormatting formatting,
+                           Vec2* out_text_pos, Vec2* out_text_size) {
+  if (recording_cache_ != nullptr) {
+    recording_cache_->RecordText(text, x, y, z, formatting, std::nullopt);
+  }
+  DoAddText(text, x, y, z, formatting, out_text_pos, out_text_size);
+}
+
+float TextRenderer::AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                                    TextFormatting formatting,
+                                                    size_t trailing_chars_length) {
+  if (recording_cache_ != nullptr) {
+    recording_cache_->RecordText(text, x, y, z, formatting, trailing_chars_length);
+  }
+  return DoAddTextTrailingCharsPrioritized(text, x, y, z, formatting, trailing_chars_length);
+}
+
+}  // namespace orbit_gl
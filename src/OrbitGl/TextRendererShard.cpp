@@ -0,0 +1,90 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "OrbitGl/TextRendererShard.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "OrbitBase/Logging.h"
+#include "OrbitGl/TranslationStack.h"
+
+namespace orbit_gl {
+
+TextRendererShard::TextRendererShard(TextRenderer* target, absl::Mutex* target_mutex)
+    : target_(target), target_mutex_(target_mutex) {
+  ORBIT_CHECK(target_ != nullptr);
+  ORBIT_CHECK(target_mutex_ != nullptr);
+}
+
+void TextRendererShard::Clear() {
+  texts_.clear();
+  current_render_group_ = BatchRenderGroupId();
+}
+
+void TextRendererShard::DrawRenderGroup(QPainter* /*painter*/,
+                                        BatchRenderGroupStateManager& /*manager*/,
+                                        const BatchRenderGroupId& /*group*/) {
+  ORBIT_UNREACHABLE();
+}
+
+float TextRendererShard::GetStringWidth(const char* text, uint32_t font_size) {
+  absl::MutexLock lock(target_mutex_);
+  return target_->GetStringWidth(text, font_size);
+}
+
+float TextRendererShard::GetStringHeight(const char* text, uint32_t font_size) {
+  absl::MutexLock lock(target_mutex_);
+  return target_->GetStringHeight(text, font_size);
+}
+
+float TextRendererShard::GetMinimumTextWidth(uint32_t font_size) {
+  absl::MutexLock lock(target_mutex_);
+  return target_->GetMinimumTextWidth(font_size);
+}
+
+void TextRendererShard::MergeIntoTarget() {
+  const std::string target_render_group_name = target_->GetCurrentRenderGroupName();
+  for (const StoredText& text : texts_) {
+    target_->SetCurrentRenderGroupName(text.render_group_name);
+    const auto& [xy, z] = text.position;
+    if (text.trailing_chars_length.has_value()) {
+      target_->AddTextTrailingCharsPrioritized(text.text.c_str(), xy[0], xy[1], z,
+                                               text.formatting,
+                                               text.trailing_chars_length.value());
+    } else {
+      target_->AddText(text.text.c_str(), xy[0], xy[1], z, text.formatting);
+    }
+  }
+  target_->SetCurrentRenderGroupName(target_render_group_name);
+  Clear();
+}
+
+void TextRendererShard::DoAddText(const char* text, float x, float y, float z,
+                                  TextFormatting formatting, Vec2* out_text_pos,
+                                  Vec2* out_text_size) {
+  const LayeredVec2 position = translations_.TranslateXYZ({{x, y}, z});
+  if (out_text_pos != nullptr) *out_text_pos = position.xy;
+  if (out_text_size != nullptr) {
+    *out_text_size = Vec2(GetEstimatedWidth(text, formatting),
+                          GetStringHeight(text, formatting.font_size));
+  }
+  texts_.push_back(
+      StoredText{text, position, formatting, std::nullopt, current_render_group_.name});
+}
+
+float TextRendererShard::DoAddTextTrailingCharsPrioritized(const char* text, float x, float y,
+                                                           float z, TextFormatting formatting,
+                                                           size_t trailing_chars_length) {
+  texts_.push_back(StoredText{text, translations_.TranslateXYZ({{x, y}, z}), formatting,
+                              trailing_chars_length, current_render_group_.name});
+  return GetEstimatedWidth(text, formatting);
+}
+
+float TextRendererShard::GetEstimatedWidth(const char* text, const TextFormatting& formatting) {
+  const float width = GetStringWidth(text, formatting.font_size);
+  return formatting.max_size >= 0.f ? std::min(width, formatting.max_size) : width;
+}
+
+}  // namespace orbit_gl
@@ -5,6 +5,7 @@
 #include "OrbitGl/ThreadTrack.h"
 
 #include <GteVector.h>
+#include <absl/hash/hash.h>
 #include <absl/strings/str_format.h>
 
 #include <algorithm>
@@ -19,7 +20,7 @@
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ModuleAndFunctionLookup.h"
 #include "ClientData/ScopeId.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/ThreadConstants.h"
@@ -45,7 +46,10 @@ using orbit_gl::PickingUserData;
 using orbit_gl::PrimitiveAssembler;
 using orbit_gl::TextRenderer;
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
+
+// Part of the visible time range added to each side of it when recording primitives to the cache.
+constexpr double kPrimitiveCachePaddingRatio = 0.5;
 
 ThreadTrack::ThreadTrack(CaptureViewElement* parent,
                          const orbit_gl::TimelineInfoInterface* timeline_info,
@@ -381,13 +385,12 @@ void ThreadTrack::OnTimer(const TimerInfo& timer_info) {
 // this has no effect. When zoomed  out, many events will be discarded quickly.
 void ThreadTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
                                      TextRenderer& text_renderer, uint64_t min_tick,
-                                     uint64_t max_tick, PickingMode /*picking_mode*/) {
+                                     uint64_t max_tick, PickingMode picking_mode) {
   // TODO(b/203181055): The parent class already provides an implementation, but this is completely
   // ignored because ThreadTrack uses the ScopeTree, and TimerTrack doesn't.
   // TimerTrack::DoUpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick,
   // picking_mode);
   ORBIT_SCOPE_WITH_COLOR("ThreadTrack::DoUpdatePrimitives", kOrbitColorYellow);
-  visible_timer_count_ = 0;
 
   const internal::DrawData draw_data =
       GetDrawData(min_tick, max_tick, GetPos()[0] + header_->GetWidth(),
@@ -396,12 +399,59 @@ void ThreadTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
                   app_->GetGroupIdToHighlight(), app_->GetHistogramSelectionRange());
 
   uint64_t resolution_in_pixels = draw_data.viewport->WorldToScreen({draw_data.track_width, 0})[0];
+
+  if (picking_mode != PickingMode::kNone) {
+    visible_timer_count_ = 0;
+    AddTimerPrimitives(primitive_assembler, text_renderer, draw_data, resolution_in_pixels,
+                       min_tick, max_tick);
+    return;
+  }
+
+  const uint64_t state_hash = GetPrimitiveCacheStateHash(draw_data);
+  if (primitive_cache_.TryReplay(primitive_assembler, text_renderer, *timeline_info_, state_hash,
+                                 min_tick, max_tick, GetPos()[1])) {
+    return;
+  }
+
+  // Add the timers of a time range wider than the visible one, so that the recorded primitives can
+  // be replayed while panning. The resolution is scaled accordingly to keep the same level of
+  // detail. The recorded range doesn't extend before the start of the capture, as ticks before it
+  // don't have a world position.
+  const uint64_t visible_range = max_tick - min_tick;
+  const auto padding = static_cast<uint64_t>(visible_range * kPrimitiveCachePaddingRatio);
+  const uint64_t capture_start_tick = timeline_info_->GetTickFromUs(0);
+  const uint64_t padding_before =
+      min_tick > capture_start_tick ? std::min(padding, min_tick - capture_start_tick) : 0;
+  const uint64_t recorded_min_tick = min_tick - padding_before;
+  const uint64_t recorded_max_tick = max_tick + padding;
+  const uint64_t recorded_resolution_in_pixels =
+      visible_range == 0 ? resolution_in_pixels
+                         : static_cast<uint64_t>(static_cast<double>(resolution_in_pixels) *
+                                                 (recorded_max_tick - recorded_min_tick) /
+                                                 visible_range);
+
+  visible_timer_count_ = 0;
+  primitive_cache_.StartRecording(primitive_assembler, text_renderer, *timeline_info_, state_hash,
+                                  recorded_min_tick, recorded_max_tick, GetPos()[1]);
+  AddTimerPrimitives(primitive_assembler, text_renderer, draw_data, recorded_resolution_in_pixels,
+                     recorded_min_tick, recorded_max_tick);
+  primitive_cache_.StopRecording(primitive_assembler, text_renderer);
+}
+
+void ThreadTrack::AddTimerPrimitives(PrimitiveAssembler& primitive_assembler,
+                                     TextRenderer& text_renderer,
+                                     const internal::DrawData& draw_data,
+                                     uint64_t resolution_in_pixels, uint64_t min_tick,
+                                     uint64_t max_tick) {
   for (uint32_t depth = 0; depth < GetDepth(); depth++) {
     float world_timer_y = GetYFromDepth(depth);
 
     for (const TimerInfo* timer_info : thread_track_data_provider_->GetTimersAtDepthDiscretized(
              thread_id_, depth, resolution_in_pixels, min_tick, max_tick)) {
-      ++visible_timer_count_;
+      // Timers outside of the visible range are only added to be cached.
+      if (timer_info->end() >= draw_data.min_tick && timer_info->start() <= draw_data.max_tick) {
+        ++visible_timer_count_;
+      }
 
       Color color = GetTimerColor(*timer_info, draw_data);
       std::unique_ptr<PickingUserData> user_data =
@@ -425,3 +475,21 @@ void ThreadTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
     }
   }
 }
+
+uint64_t ThreadTrack::GetPrimitiveCacheStateHash(const internal::DrawData& draw_data) const {
+  const std::optional<orbit_client_data::TimeRange> active_time_range =
+      app_->GetActiveTimeRangeForTid(thread_id_);
+  const std::optional<orbit_statistics::HistogramSelectionRange>& histogram_selection_range =
+      draw_data.histogram_selection_range;
+  return absl::HashOf(
+      app_->GetPrimitivesStateVersion(), thread_track_data_provider_->GetNumberOfTimers(thread_id_),
+      GetDepth(), GetPos()[0], draw_data.track_start_x, draw_data.track_width, draw_data.z,
+      draw_data.is_collapsed, GetHeightAboveTimers(), GetDefaultBoxHeight(),
+      layout_->GetFontSize(), layout_->GetTextOffset(), draw_data.selected_timer,
+      draw_data.highlighted_scope_id, draw_data.highlighted_group_id,
+      histogram_selection_range.has_value(),
+      histogram_selection_range.has_value() ? histogram_selection_range->min_duration : 0,
+      histogram_selection_range.has_value() ? histogram_selection_range->max_duration : 0,
+      active_time_range.has_value(), active_time_range.has_value() ? active_time_range->start : 0,
+      active_time_range.has_value() ? active_time_range->end : 0);
+}
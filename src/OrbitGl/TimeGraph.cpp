@@ -18,6 +18,7 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/ScopeInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientFlags/ClientFlags.h"
 #include "GrpcProtos/Constants.h"
 #include "Introspection/Introspection.h"
@@ -43,7 +44,7 @@ using orbit_capture_client::CaptureEventProcessor;
 
 using orbit_client_data::CaptureData;
 using orbit_client_data::TimerChain;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_gl::Button;
 using orbit_gl::CGroupAndProcessMemoryTrack;
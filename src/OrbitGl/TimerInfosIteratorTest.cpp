@@ -12,10 +12,10 @@
 #include <vector>
 
 #include "ClientData/TimerChain.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitGl/TimerInfosIterator.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 TEST(TimerInfosIterator, Access) {
   std::vector<std::shared_ptr<orbit_client_data::TimerChain>> chains;
@@ -20,9 +20,8 @@
 
 #include "ApiInterface/Orbit.h"
 #include "ClientData/ScopeId.h"
-#include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientFlags/ClientFlags.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Typedef.h"
@@ -35,9 +34,8 @@
 #include "OrbitGl/Viewport.h"
 
 using orbit_client_data::ScopeId;
-using orbit_client_data::TimerChain;
 using orbit_client_data::TimerData;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 using orbit_gl::PickingUserData;
 using orbit_gl::PrimitiveAssembler;
@@ -98,7 +96,7 @@ std::string TimerTrack::GetDisplayTime(const TimerInfo& timer) {
 }
 
 void TimerTrack::DrawTimesliceText(TextRenderer& text_renderer,
-                                   const orbit_client_protos::TimerInfo& timer, float min_x,
+                                   const orbit_client_data::TimerInfo& timer, float min_x,
                                    Vec2 box_pos, Vec2 box_size) {
   std::string timeslice_text = GetTimesliceText(timer);
 
@@ -289,7 +287,6 @@ void TimerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
 
   draw_data.z = GlCanvas::kZValueBox;
 
-  std::vector<const orbit_client_data::TimerChain*> chains = timer_data_->GetChains();
   draw_data.selected_timer = app_->selected_timer();
   draw_data.highlighted_scope_id = app_->GetScopeIdToHighlight();
   draw_data.highlighted_group_id = app_->GetGroupIdToHighlight();
@@ -304,38 +301,38 @@ void TimerTrack::DoUpdatePrimitives(PrimitiveAssembler& primitive_assembler,
   draw_data.min_timegraph_tick = timeline_info_->GetTickFromUs(timeline_info_->GetMinTimeUs());
   draw_data.histogram_selection_range = app_->GetHistogramSelectionRange();
 
-  for (const TimerChain* chain : chains) {
-    ORBIT_CHECK(chain != nullptr);
+  // Only request the timers that can be distinguished on screen: this keeps the cost proportional
+  // to the number of pixels instead of the number of timers in the visible range.
+  const uint32_t resolution_in_pixels = viewport_->WorldToScreen({GetWidth(), 0})[0];
+
+  for (uint32_t depth = 0; depth < timer_data_->GetDepth(); ++depth) {
     // In order to draw overlaps correctly, we need for every text box to be drawn (current),
     // its previous and next text box. In order to avoid looking ahead for the next text (which is
     // error-prone), we are doing just one traversal of the text boxes, while keeping track of the
     // previous two timers, thus the currents iteration value being the "next" textbox.
     // Note: This will require us to draw the last timer after the traversal of the text boxes.
     // Also note: The draw method will take care of nullptr's being passed into (first iteration).
-    const orbit_client_protos::TimerInfo* prev_timer_info = nullptr;
-    const orbit_client_protos::TimerInfo* current_timer_info = nullptr;
-    const orbit_client_protos::TimerInfo* next_timer_info = nullptr;
+    const orbit_client_data::TimerInfo* prev_timer_info = nullptr;
+    const orbit_client_data::TimerInfo* current_timer_info = nullptr;
+    const orbit_client_data::TimerInfo* next_timer_info = nullptr;
 
     // We have to reset this when we go to the next depth, as otherwise we
     // would miss drawing events that should be drawn.
     uint64_t min_ignore = std::numeric_limits<uint64_t>::max();
     uint64_t max_ignore = std::numeric_limits<uint64_t>::min();
-    for (const orbit_client_data::TimerBlock& block : *chain) {
-      if (!block.Intersects(min_tick, max_tick)) continue;
-
-      for (size_t k = 0; k < block.size(); ++k) {
-        // The current index (k) points to the "next" text box and we want to draw the text box
-        // from the previous iteration ("current").
-        next_timer_info = &block[k];
-
-        if (DrawTimer(text_renderer, prev_timer_info, next_timer_info, draw_data,
-                      current_timer_info, &min_ignore, &max_ignore)) {
-          ++visible_timer_count_;
-        }
-
-        prev_timer_info = current_timer_info;
-        current_timer_info = next_timer_info;
+    for (const TimerInfo* timer_info : timer_data_->GetTimersAtDepthDiscretized(
+             depth, resolution_in_pixels, min_tick, max_tick)) {
+      // The current timer points to the "next" text box and we want to draw the text box from the
+      // previous iteration ("current").
+      next_timer_info = timer_info;
+
+      if (DrawTimer(text_renderer, prev_timer_info, next_timer_info, draw_data, current_timer_info,
+                    &min_ignore, &max_ignore)) {
+        ++visible_timer_count_;
       }
+
+      prev_timer_info = current_timer_info;
+      current_timer_info = next_timer_info;
     }
 
     // We still need to draw the last timer.
@@ -385,8 +382,8 @@ internal::DrawData TimerTrack::GetDrawData(
     uint64_t min_tick, uint64_t max_tick, float track_pos_x, float track_width,
     PrimitiveAssembler* primitive_assembler, const orbit_gl::TimelineInfoInterface* timeline_info,
     const orbit_gl::Viewport* viewport, bool is_collapsed,
-    const orbit_client_protos::TimerInfo* selected_timer,
-    std::optional<ScopeId> highlighted_scope_id, uint64_t highlighted_group_id,
+    const orbit_client_data::TimerInfo* selected_timer, std::optional<ScopeId> highlighted_scope_id,
+    uint64_t highlighted_group_id,
     std::optional<orbit_statistics::HistogramSelectionRange> histogram_selection_range) {
   internal::DrawData draw_data{};
   draw_data.min_tick = min_tick;
@@ -6,6 +6,7 @@
 
 #include <GteVector.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/flags/flag.h>
 #include <absl/hash/hash.h>
 #include <absl/strings/str_format.h>
 #include <absl/time/time.h>
@@ -15,19 +16,26 @@
 #include <cmath>
 #include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 
+#include "ApiInterface/Orbit.h"
 #include "ClientData/CallstackType.h"
 #include "ClientData/CaptureData.h"
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ScopeId.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimestampIntervalSet.h"
+#include "ClientFlags/ClientFlags.h"
 #include "DisplayFormats/DisplayFormats.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitBase/Sort.h"
+#include "OrbitBase/TaskGroup.h"
+#include "OrbitBase/ThreadPool.h"
 #include "OrbitGl/AccessibleCaptureViewElement.h"
 #include "OrbitGl/BatcherInterface.h"
 #include "OrbitGl/CoreMath.h"
@@ -42,11 +50,19 @@
 
 namespace orbit_gl {
 
+namespace {
+// With fewer tracks, scheduling them on the thread pool costs more than it saves.
+constexpr size_t kMinTracksToUpdatePrimitivesInParallel = 4;
+// Idle threads of the pool that updates the primitives of the tracks are kept for this long, so
+// that they are reused across frames while the capture view is redrawn.
+constexpr absl::Duration kTrackPrimitivesThreadTtl = absl::Seconds(1);
+}  // namespace
+
 using orbit_client_data::CaptureData;
 using orbit_client_data::FunctionInfo;
 using orbit_client_data::ModuleManager;
 using orbit_client_data::ScopeId;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 using orbit_grpc_protos::InstrumentedFunction;
 
 TrackContainer::TrackContainer(CaptureViewElement* parent, TimelineInfoInterface* timeline_info,
@@ -376,7 +392,7 @@ const TimerInfo* TrackContainer::FindDown(const TimerInfo& from) {
 }
 
 void TrackContainer::SetIteratorOverlayData(
-    const absl::flat_hash_map<uint64_t, const orbit_client_protos::TimerInfo*>& iterator_timer_info,
+    const absl::flat_hash_map<uint64_t, const orbit_client_data::TimerInfo*>& iterator_timer_info,
     const absl::flat_hash_map<uint64_t, ScopeId>& iterator_id_to_function_scope_id) {
   iterator_timer_info_ = iterator_timer_info;
   iterator_id_to_function_scope_id_ = iterator_id_to_function_scope_id;
@@ -456,6 +472,75 @@ void TrackContainer::DoDraw(PrimitiveAssembler& primitive_assembler, TextRendere
   DrawOverlay(primitive_assembler, text_renderer, draw_context.picking_mode);
 }
 
+void TrackContainer::UpdateChildrenPrimitives(const std::vector<CaptureViewElement*>& children,
+                                              PrimitiveAssembler& primitive_assembler,
+                                              TextRenderer& text_renderer, uint64_t min_tick,
+                                              uint64_t max_tick, PickingMode picking_mode) {
+  if (!absl::GetFlag(FLAGS_parallel_track_primitives) ||
+      children.size() < kMinTracksToUpdatePrimitivesInParallel) {
+    CaptureViewElement::UpdateChildrenPrimitives(children, primitive_assembler, text_renderer,
+                                                 min_tick, max_tick, picking_mode);
+    return;
+  }
+  ORBIT_SCOPE_FUNCTION;
+
+  // The default thread pool is also used to load captures and to post-process them, which can keep
+  // all of its threads busy for a long time. A frame must not wait behind that work, hence the
+  // tracks are updated on a thread pool of their own.
+  if (track_primitives_thread_pool_ == nullptr) {
+    const size_t number_of_logical_cores = std::max(std::thread::hardware_concurrency(), 1u);
+    track_primitives_thread_pool_ =
+        orbit_base::ThreadPool::Create(/*thread_pool_min_size=*/1,
+                                       /*thread_pool_max_size=*/number_of_logical_cores,
+                                       /*thread_ttl=*/kTrackPrimitivesThreadTtl);
+  }
+
+  // Tracks only add primitives to their own render groups, so each track is updated into its own
+  // shard on the thread pool. The shards are merged in the order of the tracks, which results in
+  // the same primitives, picking ids and texts as updating the tracks one after the other.
+  if (track_primitives_shards_batcher_ != primitive_assembler.GetBatcher() ||
+      track_primitives_shards_text_renderer_ != &text_renderer) {
+    track_primitives_shards_.clear();
+    track_primitives_shards_batcher_ = primitive_assembler.GetBatcher();
+    track_primitives_shards_text_renderer_ = &text_renderer;
+  }
+  while (track_primitives_shards_.size() < children.size()) {
+    track_primitives_shards_.push_back(std::make_unique<TrackPrimitivesShard>(
+        primitive_assembler, text_renderer, &text_renderer_mutex_));
+  }
+
+  BatchRenderGroupStateManager* render_group_state_manager =
+      primitive_assembler.GetRenderGroupManager();
+  const std::string batcher_render_group_name = primitive_assembler.GetCurrentRenderGroupName();
+  const std::string text_render_group_name = text_renderer.GetCurrentRenderGroupName();
+  {
+    orbit_base::TaskGroup task_group{track_primitives_thread_pool_.get()};
+    for (size_t i = 0; i < children.size(); ++i) {
+      TrackPrimitivesShard& shard = *track_primitives_shards_[i];
+      shard.batcher.SetCurrentRenderGroupName(batcher_render_group_name);
+      shard.text_renderer.SetCurrentRenderGroupName(text_render_group_name);
+      for (const std::string& group_name : {batcher_render_group_name, text_render_group_name}) {
+        shard.render_group_state_manager.SetGroupState(
+            group_name, render_group_state_manager->GetGroupState(group_name));
+      }
+
+      task_group.AddTask([&shard, child = children[i], min_tick, max_tick, picking_mode] {
+        UpdateChildPrimitives(child, shard.primitive_assembler, shard.text_renderer, min_tick,
+                              max_tick, picking_mode);
+      });
+    }
+    task_group.Wait();
+  }
+
+  // Text layout stays on this thread.
+  for (size_t i = 0; i < children.size(); ++i) {
+    TrackPrimitivesShard& shard = *track_primitives_shards_[i];
+    render_group_state_manager->SetGroupStates(shard.render_group_state_manager);
+    shard.batcher.MergeIntoTarget();
+    shard.text_renderer.MergeIntoTarget();
+  }
+}
+
 void TrackContainer::UpdateVerticalScrollUsingRatio(float ratio) {
   float range = std::max(0.f, GetVisibleTracksTotalHeight() - GetHeight());
   float new_scrolling_offset = ratio * range;
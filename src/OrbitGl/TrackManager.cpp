@@ -26,6 +26,7 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/CaptureData.h"
 #include "ClientData/ThreadTrackDataProvider.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientFlags/ClientFlags.h"
 #include "OrbitBase/Append.h"
 #include "OrbitBase/Logging.h"
@@ -40,7 +41,7 @@
 #include "StringManager/StringManager.h"
 
 using orbit_client_data::CallstackData;
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 namespace orbit_gl {
 
@@ -423,7 +424,7 @@ void TrackManager::RestoreAllTrackTypesVisibility(
   visible_track_list_needs_update_ = true;
 }
 
-bool TrackManager::IteratableType(orbit_client_protos::TimerInfo_Type type) {
+bool TrackManager::IteratableType(orbit_client_data::TimerInfo::Type type) {
   switch (type) {
     case TimerInfo::kNone:
     case TimerInfo::kApiScope:
@@ -436,7 +437,7 @@ bool TrackManager::IteratableType(orbit_client_protos::TimerInfo_Type type) {
   }
 }
 
-bool TrackManager::FunctionIteratableType(orbit_client_protos::TimerInfo_Type type) {
+bool TrackManager::FunctionIteratableType(orbit_client_data::TimerInfo::Type type) {
   switch (type) {
     case TimerInfo::kNone:
     case TimerInfo::kApiScope:
@@ -462,9 +463,6 @@ Track* TrackManager::GetOrCreateTrackFromTimerInfo(const TimerInfo& timer_info)
       return GetOrCreateGpuTrack(timer_info.timeline_hash());
     case TimerInfo::kApiScopeAsync:
       return GetOrCreateAsyncTrack(timer_info.api_scope_name());
-    case orbit_client_protos::TimerInfo_Type_TimerInfo_Type_INT_MIN_SENTINEL_DO_NOT_USE_:
-    case orbit_client_protos::TimerInfo_Type_TimerInfo_Type_INT_MAX_SENTINEL_DO_NOT_USE_:
-      ORBIT_UNREACHABLE();
   }
   return nullptr;
 }
@@ -482,6 +480,14 @@ SchedulerTrack* TrackManager::GetOrCreateSchedulerTrack() {
 }
 
 ThreadTrack* TrackManager::GetOrCreateThreadTrack(uint32_t tid) {
+  // This is called for every timer, possibly from several threads: only take the exclusive lock
+  // when the track doesn't exist yet.
+  {
+    absl::ReaderMutexLock lock(&mutex_);
+    if (auto it = thread_tracks_.find(tid); it != thread_tracks_.end() && it->second != nullptr) {
+      return it->second.get();
+    }
+  }
   absl::WriterMutexLock lock(&mutex_);
   return GetOrCreateThreadTrackInternal(tid);
 }
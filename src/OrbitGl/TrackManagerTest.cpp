@@ -10,7 +10,7 @@
 #include <vector>
 
 #include "ClientData/CaptureData.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitGl/SchedulerTrack.h"
 #include "OrbitGl/StaticTimeGraphLayout.h"
 #include "OrbitGl/ThreadTrack.h"
@@ -18,7 +18,7 @@
 #include "OrbitGl/TrackManager.h"
 #include "OrbitGl/TrackTestData.h"
 
-using orbit_client_protos::TimerInfo;
+using orbit_client_data::TimerInfo;
 
 namespace orbit_gl {
 
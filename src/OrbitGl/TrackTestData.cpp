@@ -16,6 +16,7 @@
 #include "ClientData/CallstackType.h"
 #include "ClientData/LinuxAddressInfo.h"
 #include "ClientData/ModuleIdentifierProvider.h"
+#include "ClientData/TimerInfo.h"
 #include "GrpcProtos/capture.pb.h"
 
 using orbit_client_data::CallstackType;
@@ -60,8 +61,8 @@ std::unique_ptr<CaptureData> TrackTestData::GenerateTestCaptureData() {
   return capture_data;
 }
 
-std::vector<orbit_client_protos::TimerInfo> TrackTestData::GenerateTimers() {
-  using orbit_client_protos::TimerInfo;
+std::vector<orbit_client_data::TimerInfo> TrackTestData::GenerateTimers() {
+  using orbit_client_data::TimerInfo;
 
   TimerInfo timer;
   timer.set_start(0);
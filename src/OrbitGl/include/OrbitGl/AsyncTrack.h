@@ -15,8 +15,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
@@ -44,7 +44,7 @@ class AsyncTrack final : public TimerTrack {
   [[nodiscard]] Type GetType() const override { return Type::kAsyncTrack; };
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
                                           PickingId id) const override;
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
   [[nodiscard]] float GetHeight() const override;
 
  protected:
@@ -53,8 +53,8 @@ class AsyncTrack final : public TimerTrack {
                           uint64_t max_tick, PickingMode picking_mode) override;
   [[nodiscard]] float GetDefaultBoxHeight() const override;
   [[nodiscard]] std::string GetTimesliceText(
-      const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
+      const orbit_client_data::TimerInfo& timer) const override;
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer_info,
                                     bool is_selected, bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
 
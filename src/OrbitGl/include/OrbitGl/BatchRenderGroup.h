@@ -109,6 +109,13 @@ class BatchRenderGroupStateManager {
     group_name_to_state_[group_name] = state;
   }
 
+  // Sets the states of all the groups of `other`, e.g., of a manager used on another thread.
+  void SetGroupStates(const BatchRenderGroupStateManager& other) {
+    for (const auto& [group_name, state] : other.group_name_to_state_) {
+      group_name_to_state_[group_name] = state;
+    }
+  }
+
  private:
   absl::flat_hash_map<std::string, BatchRenderGroupState> group_name_to_state_;
 };
@@ -31,6 +31,15 @@ class Batcher : public BatcherInterface {
   void PushTranslation(float x, float y, float z = 0.f) { translations_.PushTranslation(x, y, z); }
   void PopTranslation() { translations_.PopTranslation(); }
 
+  // Picking color for a primitive that was recorded elsewhere and is added to this batcher now.
+  // Colors that encode the index of the primitive in a batcher are recomputed for the index the
+  // primitive gets in this one. Colors of Pickables are kept.
+  [[nodiscard]] Color RemapPickingColor(const Color& recorded_picking_color) const {
+    const PickingId id = PickingId::FromColor(recorded_picking_color);
+    if (id.type == PickingType::kPickable) return recorded_picking_color;
+    return PickingId::ToColor(id.type, GetNumElements(), batcher_id_);
+  }
+
   struct Statistics {
     size_t reserved_memory = 0;
     uint32_t draw_calls = 0;
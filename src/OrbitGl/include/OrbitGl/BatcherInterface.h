@@ -5,7 +5,7 @@
 #ifndef ORBIT_GL_BATCHER_INTERFACE_H_
 #define ORBIT_GL_BATCHER_INTERFACE_H_
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/Geometry.h"
 #include "OrbitGl/PickingManager.h"
@@ -14,11 +14,11 @@ namespace orbit_gl {
 
 struct PickingUserData {
   using TooltipCallback = std::function<std::string(PickingId)>;
-  const orbit_client_protos::TimerInfo* timer_info_;
+  const orbit_client_data::TimerInfo* timer_info_;
   TooltipCallback generate_tooltip_;
   const void* custom_data_ = nullptr;
 
-  explicit PickingUserData(const orbit_client_protos::TimerInfo* timer_info = nullptr,
+  explicit PickingUserData(const orbit_client_data::TimerInfo* timer_info = nullptr,
                            TooltipCallback generate_tooltip = nullptr)
       : timer_info_(timer_info), generate_tooltip_(std::move(generate_tooltip)) {}
 };
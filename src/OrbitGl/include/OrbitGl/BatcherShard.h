@@ -0,0 +1,85 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_BATCHER_SHARD_H_
+#define ORBIT_GL_BATCHER_SHARD_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/Batcher.h"
+#include "OrbitGl/BatcherInterface.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/PickingManager.h"
+
+namespace orbit_gl {
+
+// Batcher that only stores primitives, so that they can be added to a target Batcher later on.
+// This allows to create the primitives of independent elements (e.g., tracks) in parallel, each
+// one into its own shard, and to merge the shards into the target in a deterministic order.
+//
+// Primitives are stored with the translations of the shard applied, but not floored, and are
+// translated again by the target when merged. Picking colors are recomputed when merging, and user
+// data queried through the shard (e.g., by tooltip callbacks) is the one of the target.
+class BatcherShard : public Batcher {
+ public:
+  explicit BatcherShard(Batcher* target);
+
+  void AddLine(Vec2 from, Vec2 to, float z, const Color& color, const Color& picking_color,
+               std::unique_ptr<PickingUserData> user_data) override;
+  void AddBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+              const Color& picking_color, std::unique_ptr<PickingUserData> user_data) override;
+  void AddTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
+                   const Color& picking_color, std::unique_ptr<PickingUserData> user_data) override;
+
+  void ResetElements() override;
+  [[nodiscard]] uint32_t GetNumElements() const override;
+
+  [[nodiscard]] std::vector<BatchRenderGroupId> GetNonEmptyRenderGroups() const override {
+    return {};
+  }
+  void DrawRenderGroup(const BatchRenderGroupId& group, bool picking) override;
+
+  [[nodiscard]] Statistics GetStatistics() const override { return {}; }
+  [[nodiscard]] const PickingUserData* GetUserData(PickingId id) const override {
+    return target_->GetUserData(id);
+  }
+
+  // Adds all the primitives to the target, in the order they were added to the shard, and resets
+  // the shard. Each primitive goes to the render group it was added to, relative to the current
+  // translation of the target.
+  void MergeIntoTarget();
+
+ private:
+  enum class PrimitiveType { kLine, kBox, kTriangle };
+
+  struct Primitive {
+    PrimitiveType type;
+    // Only the first 2 (for lines) or 3 (for triangles) vertices and colors are used.
+    std::array<Vec2, 4> vertices;
+    std::array<Color, 4> colors;
+    float z;
+    Color picking_color;
+    std::unique_ptr<PickingUserData> user_data;
+    size_t render_group_index;
+  };
+
+  [[nodiscard]] Vec2 Translate(const Vec2& vertex, float z) const;
+  void AddPrimitive(Primitive primitive, float z);
+
+  Batcher* target_;
+  std::vector<Primitive> primitives_;
+  // Names of the render groups used by the primitives, in the order they were set.
+  std::vector<std::string> render_group_names_;
+};
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_BATCHER_SHARD_H_
@@ -41,11 +41,14 @@ class CallTreeNode {
   [[nodiscard]] const CallTreeNode* parent() const { return parent_; }
 
   [[nodiscard]] uint64_t child_count() const {
-    return thread_children_.size() + function_children_.size() +
-           unwind_error_type_children_.size() + (unwind_errors_child_ != nullptr ? 1 : 0);
+    if (children_ == nullptr) return 0;
+    return children_->threads.size() + children_->functions.size() +
+           children_->unwind_error_types.size() + (children_->unwind_errors != nullptr ? 1 : 0);
   }
 
-  [[nodiscard]] uint64_t thread_count() const { return thread_children_.size(); }
+  [[nodiscard]] uint64_t thread_count() const {
+    return children_ != nullptr ? children_->threads.size() : 0;
+  }
 
   [[nodiscard]] const std::vector<const CallTreeNode*>& children() const;
 
@@ -103,20 +106,37 @@ class CallTreeNode {
     return exclusive_callstack_events_;
   }
 
+  // Adds the sample counts, the exclusive callstack events and the children of `other`, which has
+  // to be a node of the same kind built from other samples, to this node. Children that only exist
+  // in `other` are moved over as whole subtrees, the others are merged recursively. `other` is left
+  // empty.
+  void MergeFrom(CallTreeNode&& other);
+
  private:
-  absl::flat_hash_map<uint32_t, std::unique_ptr<CallTreeThread>> thread_children_{};
-  absl::flat_hash_map<uint64_t, std::unique_ptr<CallTreeFunction>> function_children_{};
-  absl::flat_hash_map<orbit_client_data::CallstackType, std::unique_ptr<CallTreeUnwindErrorType>>
-      unwind_error_type_children_{};
-  std::unique_ptr<CallTreeUnwindErrors> unwind_errors_child_;
+  // Only allocated for nodes that have children, as most nodes of a call tree are leaves.
+  struct Children {
+    absl::flat_hash_map<uint32_t, std::unique_ptr<CallTreeThread>> threads;
+    absl::flat_hash_map<uint64_t, std::unique_ptr<CallTreeFunction>> functions;
+    absl::flat_hash_map<orbit_client_data::CallstackType, std::unique_ptr<CallTreeUnwindErrorType>>
+        unwind_error_types;
+    std::unique_ptr<CallTreeUnwindErrors> unwind_errors;
+
+    // Filled lazily when children() is called, invalidated when children are invalidated.
+    std::optional<std::vector<const CallTreeNode*>> cache;
+  };
+
+  [[nodiscard]] Children& GetOrCreateChildren();
+
+  template <typename Key, typename Node>
+  void MergeChildrenFrom(absl::flat_hash_map<Key, std::unique_ptr<Node>>& children,
+                         absl::flat_hash_map<Key, std::unique_ptr<Node>>& other_children);
+
+  std::unique_ptr<Children> children_;
 
   CallTreeNode* parent_;
   uint64_t sample_count_ = 0;
   // Note that we are copying the CallstackEvents into the tree.
   std::vector<orbit_client_data::CallstackEvent> exclusive_callstack_events_{};
-
-  // Filled lazily when children() is called, invalidated when children are invalidated.
-  mutable std::optional<std::vector<const CallTreeNode*>> children_cache_{};
 };
 
 class CallTreeFunction : public CallTreeNode {
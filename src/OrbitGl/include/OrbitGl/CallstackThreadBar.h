@@ -14,7 +14,6 @@
 #include "ClientData/CallstackType.h"
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
@@ -156,6 +156,19 @@ class CaptureViewElement : public Pickable, public AccessibleInterfaceProvider {
                                   TextRenderer& /*text_renderer*/, uint64_t /*min_tick*/,
                                   uint64_t /*max_tick*/, PickingMode /*picking_mode*/) {}
 
+  // Calls UpdatePrimitives on `children`, in order. Elements with many independent children can
+  // override this, e.g., to update them in parallel.
+  virtual void UpdateChildrenPrimitives(const std::vector<CaptureViewElement*>& children,
+                                        PrimitiveAssembler& primitive_assembler,
+                                        TextRenderer& text_renderer, uint64_t min_tick,
+                                        uint64_t max_tick, PickingMode picking_mode);
+  static void UpdateChildPrimitives(CaptureViewElement* child,
+                                    PrimitiveAssembler& primitive_assembler,
+                                    TextRenderer& text_renderer, uint64_t min_tick,
+                                    uint64_t max_tick, PickingMode picking_mode) {
+    child->UpdatePrimitives(primitive_assembler, text_renderer, min_tick, max_tick, picking_mode);
+  }
+
   virtual void DoUpdateLayout() {}
 
   [[nodiscard]] bool ContainsPoint(const Vec2& pos) const;
@@ -16,8 +16,8 @@
 
 #include "CaptureClient/AppInterface.h"
 #include "ClientData/CaptureData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitAccessibility/AccessibleInterface.h"
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/Batcher.h"
@@ -82,7 +82,7 @@ class CaptureWindow : public GlCanvas, public orbit_gl::CaptureWindowDebugInterf
 
   void RenderHelpUi();
   void RenderSelectionOverlay();
-  void SelectTimer(const orbit_client_protos::TimerInfo* timer_info);
+  void SelectTimer(const orbit_client_data::TimerInfo* timer_info);
 
   [[nodiscard]] virtual std::string GetHelpText() const;
   [[nodiscard]] virtual bool ShouldAutoZoom() const;
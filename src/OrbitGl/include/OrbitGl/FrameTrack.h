@@ -17,8 +17,8 @@
 #include "ClientData/ModuleManager.h"
 #include "ClientData/ScopeStats.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
@@ -51,16 +51,15 @@ class FrameTrack : public TimerTrack {
     return GetCappedMaximumToAverageRatio() > 0.f;
   }
 
-  [[nodiscard]] float GetYFromTimer(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  [[nodiscard]] float GetYFromTimer(const orbit_client_data::TimerInfo& timer_info) const override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
 
   [[nodiscard]] float GetDefaultBoxHeight() const override;
   [[nodiscard]] float GetDynamicBoxHeight(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+      const orbit_client_data::TimerInfo& timer_info) const override;
 
   [[nodiscard]] std::string GetTimesliceText(
-      const orbit_client_protos::TimerInfo& timer) const override;
+      const orbit_client_data::TimerInfo& timer) const override;
   [[nodiscard]] std::string GetTooltip() const override;
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
                                           PickingId id) const override;
@@ -73,7 +72,7 @@ class FrameTrack : public TimerTrack {
   void DoDraw(orbit_gl::PrimitiveAssembler& primitive_assembler,
               orbit_gl::TextRenderer& text_renderer, const DrawContext& draw_context) override;
 
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer_info,
                                     bool is_selected, bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
   [[nodiscard]] float GetHeight() const override;
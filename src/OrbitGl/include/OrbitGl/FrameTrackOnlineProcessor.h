@@ -12,8 +12,8 @@
 #include <cstdint>
 
 #include "ClientData/CaptureData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitGl/TimeGraph.h"
 #include "absl/container/flat_hash_map.h"
@@ -22,7 +22,7 @@
 namespace orbit_gl {
 
 void CreateFrameTrackTimer(uint64_t function_id, uint64_t start_ns, uint64_t end_ns, int frame_id,
-                           orbit_client_protos::TimerInfo* timer_info);
+                           orbit_client_data::TimerInfo* timer_info);
 
 // FrameTrackOnlineProcessor is used to create frame track timers during a capture.
 class FrameTrackOnlineProcessor {
@@ -30,7 +30,7 @@ class FrameTrackOnlineProcessor {
   FrameTrackOnlineProcessor() = default;
   FrameTrackOnlineProcessor(const orbit_client_data::CaptureData& capture_data,
                             TimeGraph* time_graph);
-  void ProcessTimer(const orbit_client_protos::TimerInfo& timer_info);
+  void ProcessTimer(const orbit_client_data::TimerInfo& timer_info);
 
   void AddFrameTrack(uint64_t function_id);
   void RemoveFrameTrack(uint64_t function_id);
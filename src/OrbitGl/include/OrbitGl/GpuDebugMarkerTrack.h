@@ -14,8 +14,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
@@ -55,12 +55,12 @@ class GpuDebugMarkerTrack final : public TimerTrack {
   [[nodiscard]] bool IsCollapsible() const override { return GetDepth() > 1; }
 
   [[nodiscard]] float GetYFromDepth(uint32_t depth) const override;
-  [[nodiscard]] bool TimerFilter(const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer, bool is_selected,
+  [[nodiscard]] bool TimerFilter(const orbit_client_data::TimerInfo& timer) const override;
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer, bool is_selected,
                                     bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
   [[nodiscard]] std::string GetTimesliceText(
-      const orbit_client_protos::TimerInfo& timer) const override;
+      const orbit_client_data::TimerInfo& timer) const override;
 
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
                                           PickingId id) const override;
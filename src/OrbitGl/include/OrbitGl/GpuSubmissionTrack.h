@@ -14,8 +14,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
@@ -54,15 +54,14 @@ class GpuSubmissionTrack : public TimerTrack {
   [[nodiscard]] std::string GetTooltip() const override;
   [[nodiscard]] float GetHeight() const override;
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& timer_info) const override;
 
-  [[nodiscard]] float GetYFromTimer(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+  [[nodiscard]] float GetYFromTimer(const orbit_client_data::TimerInfo& timer_info) const override;
 
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
 
   [[nodiscard]] bool IsCollapsible() const override {
     return GetDepth() > 1 || has_vulkan_layer_command_buffer_timers_;
@@ -72,14 +71,14 @@ class GpuSubmissionTrack : public TimerTrack {
   }
 
  protected:
-  [[nodiscard]] bool IsTimerActive(const orbit_client_protos::TimerInfo& timer) const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer, bool is_selected,
+  [[nodiscard]] bool IsTimerActive(const orbit_client_data::TimerInfo& timer) const override;
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer, bool is_selected,
                                     bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
-  [[nodiscard]] bool TimerFilter(const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] bool TimerFilter(const orbit_client_data::TimerInfo& timer) const override;
 
   [[nodiscard]] std::string GetTimesliceText(
-      const orbit_client_protos::TimerInfo& timer) const override;
+      const orbit_client_data::TimerInfo& timer) const override;
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
                                           PickingId id) const override;
 
@@ -89,14 +88,12 @@ class GpuSubmissionTrack : public TimerTrack {
   Track* parent_;
 
   bool has_vulkan_layer_command_buffer_timers_ = false;
-  [[nodiscard]] std::string GetSwQueueTooltip(
-      const orbit_client_protos::TimerInfo& timer_info) const;
-  [[nodiscard]] std::string GetHwQueueTooltip(
-      const orbit_client_protos::TimerInfo& timer_info) const;
+  [[nodiscard]] std::string GetSwQueueTooltip(const orbit_client_data::TimerInfo& timer_info) const;
+  [[nodiscard]] std::string GetHwQueueTooltip(const orbit_client_data::TimerInfo& timer_info) const;
   [[nodiscard]] std::string GetHwExecutionTooltip(
-      const orbit_client_protos::TimerInfo& timer_info) const;
+      const orbit_client_data::TimerInfo& timer_info) const;
   [[nodiscard]] std::string GetCommandBufferTooltip(
-      const orbit_client_protos::TimerInfo& timer_info) const;
+      const orbit_client_data::TimerInfo& timer_info) const;
 };
 
 #endif  // ORBIT_GL_GPU_SUBMISSION_TRACK_H_
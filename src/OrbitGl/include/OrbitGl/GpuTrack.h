@@ -17,8 +17,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/GpuDebugMarkerTrack.h"
 #include "OrbitGl/GpuSubmissionTrack.h"
@@ -52,17 +52,17 @@ class GpuTrack : public Track {
                     orbit_client_data::TimerData* marker_timer_data,
                     orbit_string_manager::StringManager* string_manager);
 
-  virtual void OnTimer(const orbit_client_protos::TimerInfo& timer_info);
+  virtual void OnTimer(const orbit_client_data::TimerInfo& timer_info);
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& timer_info) const override;
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetUp(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetDown(
+      const orbit_client_data::TimerInfo& timer_info) const override;
 
   [[nodiscard]] std::string GetName() const override {
     return string_manager_->Get(timeline_hash_).value_or(std::to_string(timeline_hash_));
@@ -20,8 +20,8 @@
 
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/MultivariateTimeSeries.h"
@@ -64,20 +64,20 @@ class GraphTrack : public Track {
   }
 
   // These are not supported in GraphTracks
-  const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetUp(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetDown(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
 
@@ -16,8 +16,8 @@
 #include "ClientData/FunctionInfo.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "DataViews/LiveFunctionsDataView.h"
 #include "DataViews/LiveFunctionsInterface.h"
 #include "absl/container/flat_hash_map.h"
@@ -65,7 +65,7 @@ class LiveFunctionsController : public orbit_data_views::LiveFunctionsInterface
   orbit_data_views::LiveFunctionsDataView live_functions_data_view_;
 
   absl::flat_hash_map<uint64_t, ScopeId> iterator_id_to_scope_id_;
-  absl::flat_hash_map<uint64_t, const orbit_client_protos::TimerInfo*> current_timer_infos_;
+  absl::flat_hash_map<uint64_t, const orbit_client_data::TimerInfo*> current_timer_infos_;
 
   std::function<void(uint64_t, const orbit_client_data::FunctionInfo*)> add_iterator_callback_;
 
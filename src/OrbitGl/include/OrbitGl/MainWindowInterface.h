@@ -16,7 +16,7 @@
 #include "ClientData/ModuleData.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeStatsCollection.h"
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "CodeReport/CodeReport.h"
 #include "CodeReport/DisassemblyReport.h"
 #include "DataViews/DataViewType.h"
@@ -64,7 +64,7 @@ class MainWindowInterface {
       std::filesystem::path path_on_instance, std::filesystem::path local_path,
       orbit_base::StopToken stop_token) = 0;
   virtual void OnCaptureCleared() = 0;
-  virtual void OnTimerSelectionChanged(const orbit_client_protos::TimerInfo* timer_info) = 0;
+  virtual void OnTimerSelectionChanged(const orbit_client_data::TimerInfo* timer_info) = 0;
   virtual void OnSetClipboard(std::string_view text) = 0;
   virtual void RefreshDataView(orbit_data_views::DataViewType type) = 0;
   virtual void SelectLiveTab() = 0;
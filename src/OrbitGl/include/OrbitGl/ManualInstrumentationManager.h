@@ -15,7 +15,6 @@
 #include <string>
 
 #include "ClientData/ApiStringEvent.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "StringManager/StringManager.h"
 
 // Wrapper around a StringManager that holds the association from the id of an async time span to
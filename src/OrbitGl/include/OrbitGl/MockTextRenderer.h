@@ -38,14 +38,6 @@ class MockTextRenderer : public TextRenderer {
     return {render_groups_.begin(), render_groups_.end()};
   }
 
-  void AddText(const char* text, float x, float y, float z, TextFormatting formatting) override;
-  void AddText(const char* text, float x, float y, float z, TextFormatting formatting,
-               Vec2* out_text_pos, Vec2* out_text_size) override;
-
-  float AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
-                                        TextFormatting formatting,
-                                        size_t trailing_chars_length) override;
-
   [[nodiscard]] float GetStringWidth(const char* text, uint32_t font_size) override;
   [[nodiscard]] float GetStringHeight(const char* text, uint32_t font_size) override;
 
@@ -61,6 +53,13 @@ class MockTextRenderer : public TextRenderer {
   [[nodiscard]] bool IsTextInsideRectangle(const Vec2& start, const Vec2& size) const;
   [[nodiscard]] bool IsTextBetweenZLayers(float z_layer_min, float z_layer_max) const;
 
+ protected:
+  void DoAddText(const char* text, float x, float y, float z, TextFormatting formatting,
+                 Vec2* out_text_pos, Vec2* out_text_size) override;
+  float DoAddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                          TextFormatting formatting,
+                                          size_t trailing_chars_length) override;
+
  private:
   void AdjustDrawingBoundaries(Vec2 point);
 
@@ -31,6 +31,8 @@
 #include "CaptureClient/AppInterface.h"
 #include "CaptureClient/CaptureClient.h"
 #include "CaptureClient/CaptureListener.h"
+#include "CaptureClient/LoadCapture.h"
+#include "CaptureClient/ShardedTimerProcessor.h"
 #include "CaptureFileInfo/Manager.h"
 #include "ClientData/ApiStringEvent.h"
 #include "ClientData/ApiTrackValue.h"
@@ -53,8 +55,8 @@
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadStateSliceInfo.h"
 #include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/WineSyscallHandlingMethod.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "ClientProtos/preset.pb.h"
 #include "ClientServices/CrashManager.h"
 #include "ClientServices/ProcessManager.h"
@@ -124,7 +126,8 @@ class OrbitApp final : public DataViewFactory,
   ErrorMessageOr<void> OnSavePreset(std::string_view file_name);
   ErrorMessageOr<void> OnLoadPreset(std::string_view file_name);
   orbit_base::Future<ErrorMessageOr<CaptureOutcome>> LoadCaptureFromFile(
-      const std::filesystem::path& file_path);
+      const std::filesystem::path& file_path,
+      std::optional<orbit_capture_client::CaptureTimeRange> time_range = std::nullopt);
 
   orbit_base::Future<ErrorMessageOr<void>> MoveCaptureFile(const std::filesystem::path& src,
                                                            const std::filesystem::path& dest);
@@ -163,7 +166,7 @@ class OrbitApp final : public DataViewFactory,
                         std::optional<std::filesystem::path> file_path,
                         absl::flat_hash_set<uint64_t> frame_track_function_ids) override;
   void OnCaptureFinished(const orbit_grpc_protos::CaptureFinished& capture_finished) override;
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
   void OnCgroupAndProcessMemoryInfo(
       const orbit_client_data::CgroupAndProcessMemoryInfo& cgroup_and_process_memory_info) override;
   void OnPageFaultsInfo(const orbit_client_data::PageFaultsInfo& page_faults_info) override;
@@ -387,11 +390,15 @@ class OrbitApp final : public DataViewFactory,
   [[nodiscard]] bool IsFunctionSelected(uint64_t absolute_address) const;
 
   void SetVisibleScopeIds(absl::flat_hash_set<ScopeId> visible_scope_ids) override;
-  [[nodiscard]] bool IsTimerActive(const orbit_client_protos::TimerInfo& timer) const;
+  [[nodiscard]] bool IsTimerActive(const orbit_client_data::TimerInfo& timer) const;
   // Returns the time range for which thread_id is active. If the entire thread is inactive, it will
   // return nullopt.
   std::optional<orbit_client_data::TimeRange> GetActiveTimeRangeForTid(
       orbit_client_data::ThreadID thread_id) const;
+  // Incremented every time primitives are requested to be updated because of a change in the state
+  // of the app (selection, visible scopes, symbols, ...). Tracks that cache their primitives use it
+  // to know when the cached ones are outdated.
+  [[nodiscard]] uint64_t GetPrimitivesStateVersion() const { return primitives_state_version_; }
 
   [[nodiscard]] std::optional<ScopeId> GetHighlightedScopeId() const override;
   void SetHighlightedScopeId(std::optional<ScopeId> highlighted_scope_id) override;
@@ -409,8 +416,8 @@ class OrbitApp final : public DataViewFactory,
   void set_hovered_thread_state_slice(
       std::optional<orbit_client_data::ThreadStateSliceInfo> thread_state_slice);
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* selected_timer() const;
-  void SelectTimer(const orbit_client_protos::TimerInfo* timer_info);
+  [[nodiscard]] const orbit_client_data::TimerInfo* selected_timer() const;
+  void SelectTimer(const orbit_client_data::TimerInfo* timer_info);
   void DeselectTimer() override;
 
   [[nodiscard]] std::optional<ScopeId> GetScopeIdToHighlight() const;
@@ -602,6 +609,9 @@ class OrbitApp final : public DataViewFactory,
   std::unique_ptr<orbit_client_data::ProcessData> process_ = nullptr;
 
   orbit_gl::FrameTrackOnlineProcessor frame_track_online_processor_;
+  // Inserts the timers of thread tracks, which is the most expensive part of processing a timer,
+  // on worker threads sharded by thread id.
+  std::unique_ptr<orbit_capture_client::ShardedTimerProcessor> thread_track_timer_processor_;
 
   orbit_capture_file_info::Manager capture_file_info_manager_{};
 
@@ -619,6 +629,8 @@ class OrbitApp final : public DataViewFactory,
   std::array<std::atomic<bool>, static_cast<size_t>(orbit_data_views::DataViewType::kAll)>
       refresh_callback_disabled_;
   std::atomic<bool> is_loading_all_symbols_ = false;
+
+  uint64_t primitives_state_version_ = 0;
 };
 
 #endif  // ORBIT_GL_APP_H_
@@ -16,8 +16,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/PageFaultsInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/BasicPageFaultsTrack.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/MajorPageFaultsTrack.h"
@@ -68,20 +68,20 @@ class PageFaultsTrack : public Track {
     minor_page_faults_track_->AddValuesAndUpdateAnnotations(timestamp_ns, values);
   }
 
-  const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetUp(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
-  const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& /*info*/) const override {
+  const orbit_client_data::TimerInfo* GetDown(
+      const orbit_client_data::TimerInfo& /*info*/) const override {
     return nullptr;
   }
   [[nodiscard]] uint64_t GetMinTime() const override;
@@ -109,6 +109,11 @@ struct PickingId {
     return Color(color_values[0], color_values[1], color_values[2], color_values[3]);
   }
 
+  [[nodiscard]] static PickingId FromColor(const Color& color) {
+    return FromPixelValue(
+        absl::bit_cast<uint32_t>(std::array<uint8_t, 4>{color[0], color[1], color[2], color[3]}));
+  }
+
   uint32_t element_id;
   PickingType type;
   BatcherId batcher_id;
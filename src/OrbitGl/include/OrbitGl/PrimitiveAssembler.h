@@ -17,7 +17,7 @@
 #include <utility>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/Logging.h"
 #include "OrbitGl/BatchRenderGroup.h"
 #include "OrbitGl/Batcher.h"
@@ -28,6 +28,8 @@
 
 namespace orbit_gl {
 
+class PrimitiveCache;
+
 enum class ShadingDirection { kLeftToRight, kRightToLeft, kTopToBottom, kBottomToTop };
 
 /**
@@ -135,12 +137,13 @@ class PrimitiveAssembler {
   }
 
   [[nodiscard]] BatchRenderGroupStateManager* GetRenderGroupManager() { return state_manager_; }
+  [[nodiscard]] Batcher* GetBatcher() const { return batcher_; }
 
   [[nodiscard]] PickingManager* GetPickingManager() const { return picking_manager_; }
   [[nodiscard]] const PickingUserData* GetUserData(PickingId id) const {
     return batcher_->GetUserData(id);
   }
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetTimerInfo(PickingId id) const;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetTimerInfo(PickingId id) const;
 
   static constexpr uint32_t kNumArcSides = 16;
 
@@ -155,6 +158,15 @@ class PrimitiveAssembler {
                    const Color& picking_color,
                    std::unique_ptr<PickingUserData> user_data = nullptr);
 
+  // All primitives go through these methods to the batcher, so that they can be recorded.
+  void AddLineToBatcher(const Vec2& from, const Vec2& to, float z, const Color& color,
+                        const Color& picking_color, std::unique_ptr<PickingUserData> user_data);
+  void AddBoxToBatcher(const Quad& box, float z, const std::array<Color, 4>& colors,
+                       const Color& picking_color, std::unique_ptr<PickingUserData> user_data);
+  void AddTriangleToBatcher(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
+                            const Color& picking_color,
+                            std::unique_ptr<PickingUserData> user_data);
+
   static void GetBoxGradientColors(
       const Color& color, std::array<Color, 4>* colors,
       ShadingDirection shading_direction = ShadingDirection::kLeftToRight);
@@ -162,8 +174,12 @@ class PrimitiveAssembler {
   Batcher* batcher_;
   BatchRenderGroupStateManager* state_manager_;
   PickingManager* picking_manager_;
+  // Set by PrimitiveCache while it records the primitives of an element.
+  PrimitiveCache* recording_cache_ = nullptr;
 
   std::vector<Vec2> circle_points;
+
+  friend class PrimitiveCache;
 };
 
 }  // namespace orbit_gl
@@ -0,0 +1,119 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_PRIMITIVE_CACHE_H_
+#define ORBIT_GL_PRIMITIVE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "OrbitGl/BatcherInterface.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/Geometry.h"
+#include "OrbitGl/PrimitiveAssembler.h"
+#include "OrbitGl/TextRenderer.h"
+#include "OrbitGl/TimelineInfoInterface.h"
+
+namespace orbit_gl {
+
+// Stores the primitives and texts that an element adds in DoUpdatePrimitives for a time range, so
+// that they can be added again on later frames without being recomputed.
+//
+// The recording is valid as long as the state of the element (identified by `state_hash`, which
+// has to cover data, layout and selection) and the zoom level stay the same, and the visible time
+// range is inside the recorded one. Panning horizontally or scrolling vertically then only
+// translates the recorded primitives. Recording a time range wider than the visible one makes the
+// recording usable for more frames while panning.
+class PrimitiveCache {
+ public:
+  // Starts recording everything added to `primitive_assembler` and `text_renderer` until
+  // StopRecording is called. Any previous recording is discarded. `pos_y` is the vertical position
+  // of the element, used to translate the recording when the element moves vertically.
+  void StartRecording(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer,
+                      const TimelineInfoInterface& timeline_info, uint64_t state_hash,
+                      uint64_t min_tick, uint64_t max_tick, float pos_y);
+  void StopRecording(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer);
+
+  // Adds the recorded primitives and texts again, translated to the current position of the
+  // recorded time range, if the recording can be used for [min_tick, max_tick]. Returns false, and
+  // adds nothing, otherwise.
+  [[nodiscard]] bool TryReplay(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer,
+                               const TimelineInfoInterface& timeline_info, uint64_t state_hash,
+                               uint64_t min_tick, uint64_t max_tick, float pos_y) const;
+
+  void Clear();
+
+  [[nodiscard]] bool IsEmpty() const;
+
+ private:
+  struct RecordedLine {
+    Line line;
+    float z;
+    Color color;
+    Color picking_color;
+    std::unique_ptr<PickingUserData> user_data;
+  };
+
+  struct RecordedBox {
+    Quad box;
+    float z;
+    std::array<Color, 4> colors;
+    Color picking_color;
+    std::unique_ptr<PickingUserData> user_data;
+  };
+
+  struct RecordedTriangle {
+    Triangle triangle;
+    float z;
+    std::array<Color, 3> colors;
+    Color picking_color;
+    std::unique_ptr<PickingUserData> user_data;
+  };
+
+  struct RecordedText {
+    std::string text;
+    float x;
+    float y;
+    float z;
+    TextRenderer::TextFormatting formatting;
+    std::optional<size_t> trailing_chars_length;
+  };
+
+  friend class PrimitiveAssembler;
+  friend class TextRenderer;
+
+  void RecordLine(const Vec2& from, const Vec2& to, float z, const Color& color,
+                  const Color& picking_color, const PickingUserData* user_data);
+  void RecordBox(const Quad& box, float z, const std::array<Color, 4>& colors,
+                 const Color& picking_color, const PickingUserData* user_data);
+  void RecordTriangle(const Triangle& triangle, float z, const std::array<Color, 3>& colors,
+                      const Color& picking_color, const PickingUserData* user_data);
+  void RecordText(const char* text, float x, float y, float z,
+                  const TextRenderer::TextFormatting& formatting,
+                  std::optional<size_t> trailing_chars_length);
+
+  std::vector<RecordedLine> lines_;
+  std::vector<RecordedBox> boxes_;
+  std::vector<RecordedTriangle> triangles_;
+  std::vector<RecordedText> texts_;
+
+  bool has_recording_ = false;
+  uint64_t state_hash_ = 0;
+  uint64_t min_tick_ = 0;
+  uint64_t max_tick_ = 0;
+  // World x-coordinates of min_tick_ and max_tick_ when recording.
+  float min_tick_world_x_ = 0.f;
+  float max_tick_world_x_ = 0.f;
+  float pos_y_ = 0.f;
+};
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_PRIMITIVE_CACHE_H_
@@ -35,18 +35,17 @@ class QtTextRenderer : public TextRenderer {
   void DrawRenderGroup(QPainter* painter, BatchRenderGroupStateManager& manager,
                        const BatchRenderGroupId& group) override;
 
-  void AddText(const char* text, float x, float y, float z, TextFormatting formatting) override;
-  void AddText(const char* text, float x, float y, float z, TextFormatting formatting,
-               Vec2* out_text_pos, Vec2* out_text_size) override;
-
-  float AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
-                                        TextFormatting formatting,
-                                        size_t trailing_chars_length) override;
-
   [[nodiscard]] float GetStringWidth(const char* text, uint32_t font_size) override;
   [[nodiscard]] float GetStringHeight(const char* text, uint32_t font_size) override;
   [[nodiscard]] float GetMinimumTextWidth(uint32_t font_size) override;
 
+ protected:
+  void DoAddText(const char* text, float x, float y, float z, TextFormatting formatting,
+                 Vec2* out_text_pos, Vec2* out_text_size) override;
+  float DoAddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                          TextFormatting formatting,
+                                          size_t trailing_chars_length) override;
+
  private:
   using CharacterWidthLookup = std::array<int, 256>;
 
@@ -21,7 +21,6 @@
 #include "ClientData/CallstackData.h"
 #include "ClientData/CallstackType.h"
 #include "ClientData/PostProcessedSamplingData.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "DataViews/CallstackDataView.h"
 #include "DataViews/SamplingReportDataView.h"
 #include "DataViews/SamplingReportInterface.h"
@@ -14,8 +14,8 @@
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
@@ -38,7 +38,7 @@ class SchedulerTrack final : public TimerTrack {
                           const orbit_client_data::CaptureData* capture_data,
                           orbit_client_data::TimerData* timer_data);
   ~SchedulerTrack() override = default;
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
 
   [[nodiscard]] std::string GetName() const override { return "Scheduler"; }
   [[nodiscard]] std::string GetLabel() const override {
@@ -52,15 +52,15 @@ class SchedulerTrack final : public TimerTrack {
 
   [[nodiscard]] float GetDefaultBoxHeight() const override { return layout_->GetTextCoresHeight(); }
   [[nodiscard]] float GetYFromDepth(uint32_t depth) const override;
-  [[nodiscard]] std::vector<const orbit_client_protos::TimerInfo*> GetScopesInRange(
+  [[nodiscard]] std::vector<const orbit_client_data::TimerInfo*> GetScopesInRange(
       uint64_t start_ns, uint64_t end_ns) const;
 
  protected:
   void DoUpdatePrimitives(orbit_gl::PrimitiveAssembler& primitive_assembler,
                           orbit_gl::TextRenderer& text_renderer, uint64_t min_tick,
                           uint64_t max_tick, PickingMode picking_mode) override;
-  [[nodiscard]] bool IsTimerActive(const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
+  [[nodiscard]] bool IsTimerActive(const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer_info,
                                     bool is_selected, bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
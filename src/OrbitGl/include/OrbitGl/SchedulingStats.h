@@ -13,7 +13,7 @@
 #include <string>
 #include <vector>
 
-#include "ClientProtos/capture_data.pb.h"
+#include "ClientData/TimerInfo.h"
 #include "OrbitBase/ThreadConstants.h"
 
 class CaptureData;
@@ -28,7 +28,7 @@ class SchedulingStats {
   using ThreadNameProvider = std::function<std::string(int32_t)>;
 
   SchedulingStats() = delete;
-  SchedulingStats(absl::Span<const orbit_client_protos::TimerInfo* const> scheduling_scopes,
+  SchedulingStats(absl::Span<const orbit_client_data::TimerInfo* const> scheduling_scopes,
                   const ThreadNameProvider& thread_name_provider, uint64_t start_ns,
                   uint64_t end_ns);
 
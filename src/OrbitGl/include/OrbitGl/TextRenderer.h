@@ -5,12 +5,24 @@
 #ifndef ORBIT_GL_TEXT_RENDERER_H_
 #define ORBIT_GL_TEXT_RENDERER_H_
 
+#include <stddef.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+
 #include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
 #include "OrbitGl/TextRendererInterface.h"
+#include "OrbitGl/TranslationStack.h"
 #include "OrbitGl/Viewport.h"
 
 namespace orbit_gl {
 
+class PrimitiveCache;
+
+// Implementations provide the DoAddXXX methods. The public AddXXX methods forward to them and also
+// record the texts while a PrimitiveCache is recording.
 class TextRenderer : public TextRendererInterface {
  public:
   void SetViewport(Viewport* viewport) { viewport_ = viewport; }
@@ -25,11 +37,32 @@ class TextRenderer : public TextRendererInterface {
     return current_render_group_.name;
   }
 
+  void AddText(const char* text, float x, float y, float z, TextFormatting formatting) final {
+    AddText(text, x, y, z, formatting, nullptr, nullptr);
+  }
+  void AddText(const char* text, float x, float y, float z, TextFormatting formatting,
+               Vec2* out_text_pos, Vec2* out_text_size) final;
+  float AddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                        TextFormatting formatting,
+                                        size_t trailing_chars_length) final;
+
  protected:
+  virtual void DoAddText(const char* text, float x, float y, float z, TextFormatting formatting,
+                         Vec2* out_text_pos, Vec2* out_text_size) = 0;
+  virtual float DoAddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                                  TextFormatting formatting,
+                                                  size_t trailing_chars_length) = 0;
+
   Viewport* viewport_ = nullptr;
 
   TranslationStack translations_;
   BatchRenderGroupId current_render_group_;
+
+ private:
+  // Set by PrimitiveCache while it records the texts of an element.
+  PrimitiveCache* recording_cache_ = nullptr;
+
+  friend class PrimitiveCache;
 };
 
 }  // namespace orbit_gl
@@ -0,0 +1,73 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef ORBIT_GL_TEXT_RENDERER_SHARD_H_
+#define ORBIT_GL_TEXT_RENDERER_SHARD_H_
+
+#include <absl/synchronization/mutex.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <QPainter>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/CoreMath.h"
+#include "OrbitGl/TextRenderer.h"
+
+namespace orbit_gl {
+
+// TextRenderer that only stores texts, so that they can be added to a target TextRenderer later on,
+// on the thread that owns the target. See BatcherShard.
+//
+// Text is only laid out when merged into the target. The measuring methods forward to the target,
+// serialized by `target_mutex`, which has to be shared by all the shards of the same target. The
+// position and size returned by AddText and AddTextTrailingCharsPrioritized are estimates.
+class TextRendererShard : public TextRenderer {
+ public:
+  explicit TextRendererShard(TextRenderer* target, absl::Mutex* target_mutex);
+
+  void Init() override {}
+  void Clear() override;
+
+  [[nodiscard]] std::vector<BatchRenderGroupId> GetRenderGroups() const override { return {}; }
+  void DrawRenderGroup(QPainter* painter, BatchRenderGroupStateManager& manager,
+                       const BatchRenderGroupId& group) override;
+
+  [[nodiscard]] float GetStringWidth(const char* text, uint32_t font_size) override;
+  [[nodiscard]] float GetStringHeight(const char* text, uint32_t font_size) override;
+  [[nodiscard]] float GetMinimumTextWidth(uint32_t font_size) override;
+
+  // Adds all the texts to the target, in the order they were added to the shard, and clears the
+  // shard.
+  void MergeIntoTarget();
+
+ protected:
+  void DoAddText(const char* text, float x, float y, float z, TextFormatting formatting,
+                 Vec2* out_text_pos, Vec2* out_text_size) override;
+  float DoAddTextTrailingCharsPrioritized(const char* text, float x, float y, float z,
+                                          TextFormatting formatting,
+                                          size_t trailing_chars_length) override;
+
+ private:
+  struct StoredText {
+    std::string text;
+    LayeredVec2 position;
+    TextFormatting formatting;
+    std::optional<size_t> trailing_chars_length;
+    std::string render_group_name;
+  };
+
+  [[nodiscard]] float GetEstimatedWidth(const char* text, const TextFormatting& formatting);
+
+  TextRenderer* target_;
+  absl::Mutex* target_mutex_;
+  std::vector<StoredText> texts_;
+};
+
+}  // namespace orbit_gl
+
+#endif  // ORBIT_GL_TEXT_RENDERER_SHARD_H_
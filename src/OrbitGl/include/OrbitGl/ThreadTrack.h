@@ -18,12 +18,13 @@
 #include "ClientData/ScopeId.h"
 #include "ClientData/ThreadTrackDataProvider.h"
 #include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/CallstackThreadBar.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
+#include "OrbitGl/PrimitiveCache.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/TextRenderer.h"
 #include "OrbitGl/ThreadStateBar.h"
@@ -70,16 +71,16 @@ class ThreadTrack final : public TimerTrack {
   }
   [[nodiscard]] std::string GetTooltip() const override;
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetUp(
+      const orbit_client_data::TimerInfo& timer_info) const override;
+  [[nodiscard]] const orbit_client_data::TimerInfo* GetDown(
+      const orbit_client_data::TimerInfo& timer_info) const override;
 
-  void OnTimer(const orbit_client_protos::TimerInfo& timer_info) override;
+  void OnTimer(const orbit_client_data::TimerInfo& timer_info) override;
   [[nodiscard]] float GetYFromDepth(uint32_t depth) const override;
 
   void SelectTrack() override;
@@ -103,17 +104,17 @@ class ThreadTrack final : public TimerTrack {
                           uint64_t max_tick, PickingMode picking_mode) override;
 
   [[nodiscard]] int64_t GetThreadId() const { return thread_id_; }
-  [[nodiscard]] bool IsTimerActive(const orbit_client_protos::TimerInfo& timer) const override;
+  [[nodiscard]] bool IsTimerActive(const orbit_client_data::TimerInfo& timer) const override;
   [[nodiscard]] bool IsTrackSelected() const override;
 
   [[nodiscard]] float GetDefaultBoxHeight() const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer, bool is_selected,
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer, bool is_selected,
                                     bool is_highlighted,
                                     const internal::DrawData& draw_data) const override;
-  [[nodiscard]] Color GetTimerColor(const orbit_client_protos::TimerInfo& timer_info,
+  [[nodiscard]] Color GetTimerColor(const orbit_client_data::TimerInfo& timer_info,
                                     const internal::DrawData& draw_data);
   [[nodiscard]] std::string GetTimesliceText(
-      const orbit_client_protos::TimerInfo& timer) const override;
+      const orbit_client_data::TimerInfo& timer) const override;
   [[nodiscard]] std::string GetBoxTooltip(const orbit_gl::PrimitiveAssembler& primitive_assembler,
                                           PickingId id) const override;
 
@@ -122,6 +123,13 @@ class ThreadTrack final : public TimerTrack {
 
   void UpdatePositionOfSubtracks() override;
 
+  void AddTimerPrimitives(orbit_gl::PrimitiveAssembler& primitive_assembler,
+                          orbit_gl::TextRenderer& text_renderer,
+                          const internal::DrawData& draw_data, uint64_t resolution_in_pixels,
+                          uint64_t min_tick, uint64_t max_tick);
+  // Hash of everything, except the visible time range, that the primitives of the timers depend on.
+  [[nodiscard]] uint64_t GetPrimitiveCacheStateHash(const internal::DrawData& draw_data) const;
+
   int64_t thread_id_;
 
   std::shared_ptr<orbit_gl::ThreadStateBar> thread_state_bar_;
@@ -129,6 +137,8 @@ class ThreadTrack final : public TimerTrack {
   std::shared_ptr<orbit_gl::TracepointThreadBar> tracepoint_bar_;
 
   orbit_client_data::ThreadTrackDataProvider* thread_track_data_provider_;
+
+  orbit_gl::PrimitiveCache primitive_cache_;
 };
 
 #endif  // ORBIT_GL_THREAD_TRACK_H_
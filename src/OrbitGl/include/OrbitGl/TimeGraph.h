@@ -24,8 +24,8 @@
 #include "ClientData/SystemMemoryInfo.h"
 #include "ClientData/ThreadTrackDataProvider.h"
 #include "ClientData/TimerChain.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitAccessibility/AccessibleInterface.h"
 #include "OrbitGl/AccessibleInterfaceProvider.h"
 #include "OrbitGl/BatchRenderGroup.h"
@@ -66,7 +66,7 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
                        orbit_gl::TextRenderer& text_renderer, PickingMode& picking_mode);
 
   // TODO(b/214282122): Move Process Timers function outside the UI.
-  void ProcessTimer(const orbit_client_protos::TimerInfo& timer_info);
+  void ProcessTimer(const orbit_client_data::TimerInfo& timer_info);
   void ProcessCgroupAndProcessMemoryInfo(
       const orbit_client_data::CgroupAndProcessMemoryInfo& cgroup_and_process_memory_info);
   void ProcessPageFaultsInfo(const orbit_client_data::PageFaultsInfo& page_faults_info);
@@ -111,7 +111,7 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
   void UpdateCaptureMinMaxTimestamps();
 
   void ZoomAll();
-  void Zoom(const orbit_client_protos::TimerInfo& timer_info);
+  void Zoom(const orbit_client_data::TimerInfo& timer_info);
   void Zoom(uint64_t min, uint64_t max);
   void ZoomTime(int zoom_delta, double center_time_ratio) override;
   void SetMinMax(double min_time_us, double max_time_us);
@@ -125,28 +125,27 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
   void HorizontallyMoveIntoView(VisibilityType vis_type, uint64_t min, uint64_t max,
                                 double distance = 0.3);
   void HorizontallyMoveIntoView(VisibilityType vis_type,
-                                const orbit_client_protos::TimerInfo& timer_info,
+                                const orbit_client_data::TimerInfo& timer_info,
                                 double distance = 0.3);
 
   [[nodiscard]] double GetTime(double ratio) const;
 
   enum class JumpScope { kSameDepth, kSameThread, kSameFunction, kSameThreadSameFunction };
   enum class JumpDirection { kPrevious, kNext, kTop, kDown };
-  void JumpToNeighborTimer(const orbit_client_protos::TimerInfo* from, JumpDirection jump_direction,
+  void JumpToNeighborTimer(const orbit_client_data::TimerInfo* from, JumpDirection jump_direction,
                            JumpScope jump_scope);
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindPreviousScopeTimer(
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindPreviousScopeTimer(
       ScopeId scope_id, uint64_t current_time,
       std::optional<uint32_t> thread_id = std::nullopt) const;
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindNextScopeTimer(
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindNextScopeTimer(
       ScopeId scope_id, uint64_t current_time,
       std::optional<uint32_t> thread_id = std::nullopt) const;
   [[nodiscard]] std::vector<const orbit_client_data::TimerChain*> GetAllThreadTrackTimerChains()
       const;
-  [[nodiscard]] std::pair<const orbit_client_protos::TimerInfo*,
-                          const orbit_client_protos::TimerInfo*>
+  [[nodiscard]] std::pair<const orbit_client_data::TimerInfo*, const orbit_client_data::TimerInfo*>
   GetMinMaxTimerForScope(ScopeId scope_id) const;
 
-  void SelectAndZoom(const orbit_client_protos::TimerInfo* timer_info);
+  void SelectAndZoom(const orbit_client_data::TimerInfo* timer_info);
   [[nodiscard]] double GetCaptureTimeSpanUs() const;
 
   enum class RedrawType { kNone, kDraw, kUpdatePrimitives };
@@ -202,7 +201,7 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
 
   [[nodiscard]] std::unique_ptr<orbit_accessibility::AccessibleInterface>
   CreateAccessibleInterface() override;
-  void ProcessAsyncTimer(const orbit_client_protos::TimerInfo& timer_info) const;
+  void ProcessAsyncTimer(const orbit_client_data::TimerInfo& timer_info) const;
 
   std::shared_ptr<orbit_gl::GlSlider> horizontal_slider_;
   std::shared_ptr<orbit_gl::GlSlider> vertical_slider_;
@@ -217,7 +216,7 @@ class TimeGraph : public orbit_gl::CaptureViewElement, public orbit_gl::Timeline
   void UpdateHorizontalScroll(float ratio);
   void UpdateHorizontalZoom(float normalized_start, float normalized_end);
 
-  void SelectAndMakeVisible(const orbit_client_protos::TimerInfo* timer_info);
+  void SelectAndMakeVisible(const orbit_client_data::TimerInfo* timer_info);
   [[nodiscard]] bool IsFullyVisible(uint64_t min, uint64_t max) const;
   [[nodiscard]] bool IsPartlyVisible(uint64_t min, uint64_t max) const;
   [[nodiscard]] bool IsVisible(VisibilityType vis_type, uint64_t min, uint64_t max) const;
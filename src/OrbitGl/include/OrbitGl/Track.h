@@ -18,8 +18,8 @@
 #include "ClientData/ModuleManager.h"
 #include "ClientData/TimerChain.h"
 #include "ClientData/TimerData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "Containers/BlockChain.h"
 #include "GteVector.h"
 #include "OrbitAccessibility/AccessibleInterface.h"
@@ -117,17 +117,17 @@ class Track : public orbit_gl::CaptureViewElement,
   }
 
   // Must be overriden by child class for sensible behavior.
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetLeft(
-      const orbit_client_protos::TimerInfo& /*timer_info*/) const = 0;
+  [[nodiscard]] virtual const orbit_client_data::TimerInfo* GetLeft(
+      const orbit_client_data::TimerInfo& /*timer_info*/) const = 0;
   // Must be overriden by child class for sensible behavior.
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetRight(
-      const orbit_client_protos::TimerInfo& /*timer_info*/) const = 0;
+  [[nodiscard]] virtual const orbit_client_data::TimerInfo* GetRight(
+      const orbit_client_data::TimerInfo& /*timer_info*/) const = 0;
   // Must be overriden by child class for sensible behavior.
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetUp(
-      const orbit_client_protos::TimerInfo& /*timer_info*/) const = 0;
+  [[nodiscard]] virtual const orbit_client_data::TimerInfo* GetUp(
+      const orbit_client_data::TimerInfo& /*timer_info*/) const = 0;
   // Must be overriden by child class for sensible behavior.
-  [[nodiscard]] virtual const orbit_client_protos::TimerInfo* GetDown(
-      const orbit_client_protos::TimerInfo& /*timer_info*/) const = 0;
+  [[nodiscard]] virtual const orbit_client_data::TimerInfo* GetDown(
+      const orbit_client_data::TimerInfo& /*timer_info*/) const = 0;
 
  protected:
   void DoDraw(orbit_gl::PrimitiveAssembler& primitive_assembler,
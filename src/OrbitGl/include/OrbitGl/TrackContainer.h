@@ -7,6 +7,7 @@
 
 #include <ClientData/CaptureData.h>
 #include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
 
 #include <cstdint>
 #include <memory>
@@ -18,14 +19,19 @@
 #include "ClientData/ModuleManager.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ThreadStateSliceInfo.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitAccessibility/AccessibleInterface.h"
+#include "OrbitBase/ThreadPool.h"
+#include "OrbitGl/BatchRenderGroup.h"
+#include "OrbitGl/Batcher.h"
+#include "OrbitGl/BatcherShard.h"
 #include "OrbitGl/CaptureViewElement.h"
 #include "OrbitGl/CoreMath.h"
 #include "OrbitGl/PickingManager.h"
 #include "OrbitGl/PrimitiveAssembler.h"
 #include "OrbitGl/TextRenderer.h"
+#include "OrbitGl/TextRendererShard.h"
 #include "OrbitGl/TimeGraphLayout.h"
 #include "OrbitGl/TimelineInfoInterface.h"
 #include "OrbitGl/Track.h"
@@ -52,25 +58,24 @@ class TrackContainer final : public CaptureViewElement {
   [[nodiscard]] TrackManager* GetTrackManager() { return track_manager_.get(); }
 
   void VerticalZoom(float real_ratio, float mouse_screen_y_position);
-  void VerticallyMoveIntoView(const orbit_client_protos::TimerInfo& timer_info);
+  void VerticallyMoveIntoView(const orbit_client_data::TimerInfo& timer_info);
   void VerticallyMoveIntoView(const Track& track);
 
   void SetThreadFilter(std::string_view filter);
 
   [[nodiscard]] int GetNumVisiblePrimitives() const;
 
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindPrevious(
-      const orbit_client_protos::TimerInfo& from);
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindNext(
-      const orbit_client_protos::TimerInfo& from);
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindTop(
-      const orbit_client_protos::TimerInfo& from);
-  [[nodiscard]] const orbit_client_protos::TimerInfo* FindDown(
-      const orbit_client_protos::TimerInfo& from);
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindPrevious(
+      const orbit_client_data::TimerInfo& from);
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindNext(
+      const orbit_client_data::TimerInfo& from);
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindTop(
+      const orbit_client_data::TimerInfo& from);
+  [[nodiscard]] const orbit_client_data::TimerInfo* FindDown(
+      const orbit_client_data::TimerInfo& from);
 
   void SetIteratorOverlayData(
-      const absl::flat_hash_map<uint64_t, const orbit_client_protos::TimerInfo*>&
-          iterator_timer_info,
+      const absl::flat_hash_map<uint64_t, const orbit_client_data::TimerInfo*>& iterator_timer_info,
       const absl::flat_hash_map<uint64_t, ScopeId>& iterator_id_to_function_scope_id);
   void UpdateVerticalScrollUsingRatio(float ratio);
   [[nodiscard]] float GetVerticalScrollingOffset() const { return vertical_scrolling_offset_; }
@@ -89,6 +94,10 @@ class TrackContainer final : public CaptureViewElement {
   void DoUpdateLayout() override;
   void DoDraw(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer,
               const DrawContext& draw_context) override;
+  void UpdateChildrenPrimitives(const std::vector<CaptureViewElement*>& children,
+                                PrimitiveAssembler& primitive_assembler,
+                                TextRenderer& text_renderer, uint64_t min_tick, uint64_t max_tick,
+                                PickingMode picking_mode) override;
 
   void UpdateTracksPosition();
 
@@ -108,8 +117,24 @@ class TrackContainer final : public CaptureViewElement {
   void DrawIncompleteDataIntervals(PrimitiveAssembler& primitive_assembler,
                                    PickingMode picking_mode);
 
+  // Primitives and texts of a track updated on a worker thread, before they are merged into the
+  // PrimitiveAssembler and TextRenderer of the frame.
+  struct TrackPrimitivesShard {
+    TrackPrimitivesShard(PrimitiveAssembler& primitive_assembler, TextRenderer& text_renderer,
+                         absl::Mutex* text_renderer_mutex)
+        : batcher(primitive_assembler.GetBatcher()),
+          primitive_assembler(&batcher, &render_group_state_manager,
+                              primitive_assembler.GetPickingManager()),
+          text_renderer(&text_renderer, text_renderer_mutex) {}
+
+    BatcherShard batcher;
+    BatchRenderGroupStateManager render_group_state_manager;
+    PrimitiveAssembler primitive_assembler;
+    TextRendererShard text_renderer;
+  };
+
   // First member is id.
-  absl::flat_hash_map<uint64_t, const orbit_client_protos::TimerInfo*> iterator_timer_info_;
+  absl::flat_hash_map<uint64_t, const orbit_client_data::TimerInfo*> iterator_timer_info_;
   absl::flat_hash_map<uint64_t, ScopeId> iterator_id_to_function_scope_id_;
 
   float vertical_scrolling_offset_ = 0;
@@ -122,6 +147,16 @@ class TrackContainer final : public CaptureViewElement {
   const TimelineInfoInterface* timeline_info_;
 
   OrbitApp* app_ = nullptr;
+
+  // Shards are kept across frames, as tooltip callbacks created while updating the primitives of a
+  // track refer to the PrimitiveAssembler they were given.
+  std::vector<std::unique_ptr<TrackPrimitivesShard>> track_primitives_shards_;
+  const Batcher* track_primitives_shards_batcher_ = nullptr;
+  const TextRenderer* track_primitives_shards_text_renderer_ = nullptr;
+  absl::Mutex text_renderer_mutex_;
+  // Only created once tracks are updated in parallel. No task is pending outside of
+  // UpdateChildrenPrimitives.
+  std::shared_ptr<orbit_base::ThreadPool> track_primitives_thread_pool_;
 };
 
 }  // namespace orbit_gl
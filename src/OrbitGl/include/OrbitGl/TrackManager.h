@@ -25,8 +25,8 @@
 
 #include "ClientData/CaptureData.h"
 #include "ClientData/ModuleManager.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "OrbitGl/AsyncTrack.h"
 #include "OrbitGl/CGroupAndProcessMemoryTrack.h"
 #include "OrbitGl/FrameTrack.h"
@@ -69,10 +69,10 @@ class TrackManager {
 
   [[nodiscard]] std::pair<uint64_t, uint64_t> GetTracksMinMaxTimestamps() const;
 
-  [[nodiscard]] static bool IteratableType(orbit_client_protos::TimerInfo_Type type);
-  [[nodiscard]] static bool FunctionIteratableType(orbit_client_protos::TimerInfo_Type type);
+  [[nodiscard]] static bool IteratableType(orbit_client_data::TimerInfo::Type type);
+  [[nodiscard]] static bool FunctionIteratableType(orbit_client_data::TimerInfo::Type type);
 
-  Track* GetOrCreateTrackFromTimerInfo(const orbit_client_protos::TimerInfo& timer_info);
+  Track* GetOrCreateTrackFromTimerInfo(const orbit_client_data::TimerInfo& timer_info);
   SchedulerTrack* GetOrCreateSchedulerTrack();
   ThreadTrack* GetOrCreateThreadTrack(uint32_t tid);
   [[nodiscard]] std::optional<ThreadTrack*> GetThreadTrack(uint32_t tid) const;
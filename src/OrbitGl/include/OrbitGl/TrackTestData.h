@@ -12,8 +12,8 @@
 #include <vector>
 
 #include "ClientData/CaptureData.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 
 namespace orbit_gl {
 
@@ -31,7 +31,7 @@ struct TrackTestData {
   static constexpr const char* kTimerOnlyThreadName = "timer only thread";
 
   static std::unique_ptr<orbit_client_data::CaptureData> GenerateTestCaptureData();
-  static std::vector<orbit_client_protos::TimerInfo> GenerateTimers();
+  static std::vector<orbit_client_data::TimerInfo> GenerateTimers();
 };
 
 }  // namespace orbit_gl
@@ -33,6 +33,10 @@ class TranslationStack {
     const float result_z = input.z + current_translation_.z;
     return {{std::floor(result_shape[0]), std::floor(result_shape[1])}, result_z};
   }
+  // Same as above without flooring, for primitives that are translated again later.
+  [[nodiscard]] LayeredVec2 TranslateXYZ(const LayeredVec2& input) const {
+    return {input.xy + current_translation_.xy, input.z + current_translation_.z};
+  }
 
  private:
   std::vector<LayeredVec2> translation_stack_;
@@ -44,8 +44,8 @@
 #include "ClientData/PostProcessedSamplingData.h"
 #include "ClientData/ScopeId.h"
 #include "ClientData/ScopeStatsCollection.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/TimerTrackDataIdManager.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "CodeReport/CodeReport.h"
 #include "CodeReport/DisassemblyReport.h"
 #include "DataViews/DataView.h"
@@ -190,6 +190,7 @@ class OrbitMainWindow final : public QMainWindow, public orbit_gl::MainWindowInt
 
   void on_actionToggle_Capture_triggered();
   void on_actionOpen_Capture_triggered();
+  void on_actionOpen_Capture_Time_Range_triggered();
   void on_actionRename_Capture_File_triggered();
   void on_actionCaptureOptions_triggered();
   void on_actionHelp_toggled(bool checked);
@@ -204,12 +205,13 @@ class OrbitMainWindow final : public QMainWindow, public orbit_gl::MainWindowInt
 
   void on_actionSymbolLocationsDialog_triggered();
 
-  void OnTimerSelectionChanged(const orbit_client_protos::TimerInfo* timer_info) override;
+  void OnTimerSelectionChanged(const orbit_client_data::TimerInfo* timer_info) override;
 
   // TODO(https://github.com/google/orbit/issues/4589): Remove redundant "private" once slots is not
   // needed anymore above.
  private:  // NOLINT(readability-redundant-access-specifiers)
   void UpdateFilePath(const std::filesystem::path& file_path);
+  [[nodiscard]] QString GetOpenCaptureFileName();
   void StartMainTimer();
   void SetupCaptureToolbar();
   void SetupMainWindow();
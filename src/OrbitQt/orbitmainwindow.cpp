@@ -26,6 +26,7 @@
 #include <QGraphicsOpacityEffect>
 #include <QGridLayout>
 #include <QHBoxLayout>
+#include <QInputDialog>
 #include <QIODevice>
 #include <QLabel>
 #include <QLineEdit>
@@ -60,7 +61,10 @@
 #include <QVariant>
 #include <QWidget>
 #include <Qt>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>
 #include <initializer_list>
 #include <limits>
@@ -79,9 +83,9 @@
 #include "ClientData/ModulePathAndBuildId.h"
 #include "ClientData/ProcessData.h"
 #include "ClientData/ScopeId.h"
+#include "ClientData/TimerInfo.h"
 #include "ClientData/WineSyscallHandlingMethod.h"
 #include "ClientFlags/ClientFlags.h"
-#include "ClientProtos/capture_data.pb.h"
 #include "ClientServices/ProcessManager.h"
 #include "ClientSymbols/QSettingsBasedStorageManager.h"
 #include "CodeReport/DisassemblyReport.h"
@@ -175,6 +179,36 @@ constexpr int kHintFramePosX = 21;
 constexpr int kHintFramePosY = 62;
 constexpr int kHintFrameWidth = 140;
 constexpr int kHintFrameHeight = 45;
+
+// Returns the window of time set with --load_capture_start_ms and --load_capture_end_ms, or
+// std::nullopt if neither flag is set.
+[[nodiscard]] ErrorMessageOr<std::optional<orbit_capture_client::CaptureTimeRange>>
+GetLoadCaptureTimeRangeFromFlags() {
+  const std::optional<uint64_t> start_ms = absl::GetFlag(FLAGS_load_capture_start_ms);
+  const std::optional<uint64_t> end_ms = absl::GetFlag(FLAGS_load_capture_end_ms);
+  if (!start_ms.has_value() && !end_ms.has_value()) {
+    return std::optional<orbit_capture_client::CaptureTimeRange>{};
+  }
+
+  constexpr uint64_t kNsPerMs = 1'000'000;
+  constexpr uint64_t kMaxMs = std::numeric_limits<uint64_t>::max() / kNsPerMs;
+  if (start_ms.value_or(0) > kMaxMs || end_ms.value_or(0) > kMaxMs) {
+    return ErrorMessage{
+        absl::StrFormat("The time range to load cannot extend beyond %u ms after the start of the "
+                        "capture.",
+                        kMaxMs)};
+  }
+  if (start_ms.has_value() && end_ms.has_value() && start_ms.value() > end_ms.value()) {
+    return ErrorMessage{absl::StrFormat(
+        "The start of the time range to load (%u ms) is after its end (%u ms).", start_ms.value(),
+        end_ms.value())};
+  }
+
+  const uint64_t start_ns = start_ms.value_or(0) * kNsPerMs;
+  const uint64_t end_ns =
+      end_ms.has_value() ? end_ms.value() * kNsPerMs : std::numeric_limits<uint64_t>::max();
+  return std::make_optional(orbit_capture_client::CaptureTimeRange{start_ns, end_ns});
+}
 }  // namespace
 
 OrbitMainWindow::OrbitMainWindow(TargetConfiguration target_configuration,
@@ -639,6 +673,7 @@ void OrbitMainWindow::UpdateCaptureStateDependentWidgets() {
   ui->actionToggle_Capture->setIcon(is_capturing ? icon_stop_capture_ : icon_start_capture_);
   ui->actionCaptureOptions->setEnabled(!is_capturing);
   ui->actionOpen_Capture->setEnabled(!is_capturing);
+  ui->actionOpen_Capture_Time_Range->setEnabled(!is_capturing);
   ui->actionRename_Capture_File->setEnabled(!is_capturing &&
                                             target_label_->GetFilePath().has_value());
   ui->actionOpen_Preset->setEnabled(!is_capturing && is_connected_);
@@ -1367,7 +1402,7 @@ void OrbitMainWindow::on_actionIntrospection_triggered() {
   introspection_widget_->show();
 }
 
-void OrbitMainWindow::OnTimerSelectionChanged(const orbit_client_protos::TimerInfo* timer_info) {
+void OrbitMainWindow::OnTimerSelectionChanged(const orbit_client_data::TimerInfo* timer_info) {
   std::optional<int> selected_row(std::nullopt);
   const auto live_functions_controller = ui->liveFunctions->GetLiveFunctionsController();
   orbit_data_views::LiveFunctionsDataView* live_functions_data_view = nullptr;
@@ -1394,14 +1429,18 @@ void OrbitMainWindow::OnTimerSelectionChanged(const orbit_client_protos::TimerIn
   ui->liveFunctions->OnRowSelected(selected_row);
 }
 
-void OrbitMainWindow::on_actionOpen_Capture_triggered() {
+QString OrbitMainWindow::GetOpenCaptureFileName() {
   QString capture_dir;
   ErrorMessageOr<std::filesystem::path> capture_dir_or_error = orbit_paths::CreateOrGetCaptureDir();
   if (capture_dir_or_error.has_value()) {
     capture_dir = QString::fromStdString(capture_dir_or_error.value().string());
   }
 
-  QString file = QFileDialog::getOpenFileName(this, "Open capture...", capture_dir, "*.orbit");
+  return QFileDialog::getOpenFileName(this, "Open capture...", capture_dir, "*.orbit");
+}
+
+void OrbitMainWindow::on_actionOpen_Capture_triggered() {
+  QString file = GetOpenCaptureFileName();
   if (file.isEmpty()) {
     return;
   }
@@ -1412,6 +1451,33 @@ void OrbitMainWindow::on_actionOpen_Capture_triggered() {
   QProcess::startDetached(orbit_executable, arguments << file << command_line_flags_);
 }
 
+void OrbitMainWindow::on_actionOpen_Capture_Time_Range_triggered() {
+  QString file = GetOpenCaptureFileName();
+  if (file.isEmpty()) {
+    return;
+  }
+
+  constexpr double kMaxSeconds = 1e6;
+  constexpr int kDecimals = 3;
+  bool ok = false;
+  const double start_seconds = QInputDialog::getDouble(
+      this, "Open capture time range", "Start (seconds after capture start):", 0, 0, kMaxSeconds,
+      kDecimals, &ok);
+  if (!ok) return;
+  const double end_seconds = QInputDialog::getDouble(
+      this, "Open capture time range", "End (seconds after capture start):", start_seconds + 10,
+      start_seconds, kMaxSeconds, kDecimals, &ok);
+  if (!ok) return;
+
+  QString orbit_executable =
+      QString::fromStdString(orbit_base::GetExecutablePath().generic_string());
+  QStringList arguments;
+  arguments << file << command_line_flags_
+            << QString("--load_capture_start_ms=%1").arg(std::llround(start_seconds * 1000))
+            << QString("--load_capture_end_ms=%1").arg(std::llround(end_seconds * 1000));
+  QProcess::startDetached(orbit_executable, arguments);
+}
+
 void OrbitMainWindow::on_actionRename_Capture_File_triggered() {
   ORBIT_CHECK(target_label_->GetFilePath().has_value());
   const std::filesystem::path& current_file_path = target_label_->GetFilePath().value();
@@ -1452,6 +1518,17 @@ void OrbitMainWindow::on_actionRename_Capture_File_triggered() {
 }
 
 void OrbitMainWindow::OpenCapture(std::string_view filepath) {
+  ErrorMessageOr<std::optional<orbit_capture_client::CaptureTimeRange>> time_range_or_error =
+      GetLoadCaptureTimeRangeFromFlags();
+  if (time_range_or_error.has_error()) {
+    QMessageBox::critical(this, "Error while loading capture",
+                          QString::fromStdString(time_range_or_error.error().message()));
+    Exit(kEndSessionReturnCode);
+    return;
+  }
+  const std::optional<orbit_capture_client::CaptureTimeRange>& time_range =
+      time_range_or_error.value();
+
   auto* loading_capture_dialog =
       new QProgressDialog("Waiting for the capture to be loaded...", nullptr, 0, 0, this, Qt::Tool);
   loading_capture_dialog->setWindowTitle("Loading capture");
@@ -1468,7 +1545,7 @@ void OrbitMainWindow::OpenCapture(std::string_view filepath) {
   loading_capture_dialog->setCancelButton(loading_capture_cancel_button);
   loading_capture_dialog->show();
 
-  app_->LoadCaptureFromFile(filepath).Then(
+  app_->LoadCaptureFromFile(filepath, time_range).Then(
       &main_thread_executor_,
       [this, loading_capture_dialog](ErrorMessageOr<CaptureListener::CaptureOutcome> result) {
         loading_capture_dialog->close();
@@ -0,0 +1,235 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
+
+#include <absl/strings/str_format.h>
+
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "ApiInterface/Orbit.h"
+#include "OrbitBase/Logging.h"
+#include "OrbitBase/ThreadUtils.h"
+
+using orbit_capture_file::CaptureFileOutputStream;
+using orbit_grpc_protos::ClientCaptureEvent;
+
+namespace orbit_producer_event_processor {
+
+namespace {
+
+// Events are written at least this often, so that little is lost if the service goes away.
+constexpr absl::Duration kWriteTimeInterval = absl::Milliseconds(100);
+// Events are written earlier when this many are buffered.
+constexpr size_t kWriteEventCountInterval = 10'000;
+// How many names are tried for the first file of a capture, if files with the same name exist.
+constexpr uint32_t kMaxFirstFileAttempts = 100;
+
+// Returns whether later events can refer to `event`, so that it has to be repeated at the start of
+// each file for the file to be loadable on its own.
+[[nodiscard]] bool IsPreambleEvent(const ClientCaptureEvent& event) {
+  switch (event.event_case()) {
+    case ClientCaptureEvent::kAddressInfo:
+    case ClientCaptureEvent::kCaptureStarted:
+    case ClientCaptureEvent::kClockResolutionEvent:
+    case ClientCaptureEvent::kInternedCallstack:
+    case ClientCaptureEvent::kInternedString:
+    case ClientCaptureEvent::kInternedTracepointInfo:
+    case ClientCaptureEvent::kModulesSnapshot:
+    case ClientCaptureEvent::kModuleUpdateEvent:
+    case ClientCaptureEvent::kThreadName:
+    case ClientCaptureEvent::kThreadNamesSnapshot:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Ends a file that the capture continues in the next one.
+[[nodiscard]] ClientCaptureEvent CreateFileContinuedCaptureFinishedEvent() {
+  ClientCaptureEvent event;
+  event.mutable_capture_finished()->set_status(orbit_grpc_protos::CaptureFinished::kSuccessful);
+  return event;
+}
+
+}  // namespace
+
+CaptureFileClientCaptureEventCollector::CaptureFileClientCaptureEventCollector(Options options)
+    : options_{std::move(options)}, capture_start_time_{absl::Now()} {}
+
+ErrorMessageOr<std::unique_ptr<CaptureFileClientCaptureEventCollector>>
+CaptureFileClientCaptureEventCollector::Create(Options options) {
+  std::error_code error;
+  std::filesystem::create_directories(options.directory, error);
+  if (error) {
+    return ErrorMessage{absl::StrFormat("Unable to create directory \"%s\": %s",
+                                        options.directory.string(), error.message())};
+  }
+
+  // The constructor is private, hence no std::make_unique.
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector{
+      new CaptureFileClientCaptureEventCollector(std::move(options))};
+  collector->writer_thread_ = std::thread{[collector = collector.get()] {
+    collector->WriterThread();
+  }};
+  return collector;
+}
+
+void CaptureFileClientCaptureEventCollector::AddEvent(ClientCaptureEvent&& event) {
+  absl::MutexLock lock{&mutex_};
+  if (stop_requested_) {
+    return;
+  }
+  events_being_buffered_.push_back(std::move(event));
+}
+
+void CaptureFileClientCaptureEventCollector::StopAndWait() {
+  ORBIT_CHECK(writer_thread_.joinable());
+  {
+    absl::MutexLock lock{&mutex_};
+    stop_requested_ = true;
+  }
+  writer_thread_.join();
+}
+
+CaptureFileClientCaptureEventCollector::~CaptureFileClientCaptureEventCollector() {
+  ORBIT_CHECK(!writer_thread_.joinable());
+}
+
+ErrorMessageOr<void> CaptureFileClientCaptureEventCollector::CloseCurrentFile() {
+  if (output_stream_ == nullptr || !output_stream_->IsOpen()) return outcome::success();
+  return output_stream_->Close();
+}
+
+std::filesystem::path CaptureFileClientCaptureEventCollector::GetFilePath(
+    size_t file_index) const {
+  return options_.directory / absl::StrFormat("%s_%03u.orbit", file_name_prefix_, file_index);
+}
+
+ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>>
+CaptureFileClientCaptureEventCollector::CreateFirstFile() {
+  const std::string start_time =
+      absl::FormatTime("%Y_%m_%d_%H_%M_%S", capture_start_time_, absl::LocalTimeZone());
+  // Captures started in the same second would get the same file names. As files are only created
+  // if they don't exist yet, the first free name of a first file claims its prefix for the capture.
+  for (uint32_t attempt = 0;; ++attempt) {
+    file_name_prefix_ = attempt == 0 ? absl::StrFormat("capture_%s", start_time)
+                                     : absl::StrFormat("capture_%s_%u", start_time, attempt);
+    std::filesystem::path file_path = GetFilePath(0);
+    ErrorMessageOr<std::unique_ptr<CaptureFileOutputStream>> output_stream_or_error =
+        CaptureFileOutputStream::Create(file_path,
+                                        CaptureFileOutputStream::Format::kBlockCompressed);
+    if (output_stream_or_error.has_value()) {
+      return std::move(output_stream_or_error.value());
+    }
+
+    std::error_code error;
+    if (attempt + 1 >= kMaxFirstFileAttempts || !std::filesystem::exists(file_path, error)) {
+      return output_stream_or_error.error();
+    }
+  }
+}
+
+ErrorMessageOr<void> CaptureFileClientCaptureEventCollector::OpenNextFile() {
+  if (output_stream_ != nullptr && output_stream_->IsOpen()) {
+    // Without a CaptureFinished event, the capture section of the file would have no end.
+    OUTCOME_TRY(output_stream_->WriteCaptureEvent(CreateFileContinuedCaptureFinishedEvent()));
+    OUTCOME_TRY(CloseCurrentFile());
+  }
+
+  if (file_paths_.empty()) {
+    OUTCOME_TRY(output_stream_, CreateFirstFile());
+  } else {
+    OUTCOME_TRY(output_stream_,
+                CaptureFileOutputStream::Create(GetFilePath(file_paths_.size()),
+                                                CaptureFileOutputStream::Format::kBlockCompressed));
+  }
+  std::filesystem::path file_path = GetFilePath(file_paths_.size());
+  ORBIT_LOG("Writing capture to \"%s\"", file_path.string());
+  file_paths_.push_back(std::move(file_path));
+  current_file_start_time_ = absl::Now();
+
+  for (const ClientCaptureEvent& event : preamble_events_) {
+    OUTCOME_TRY(output_stream_->WriteCaptureEvent(event));
+  }
+  current_file_size_bytes_ = preamble_size_bytes_;
+  current_file_preamble_size_bytes_ = preamble_size_bytes_;
+  return outcome::success();
+}
+
+bool CaptureFileClientCaptureEventCollector::IsFileFull() const {
+  const uint64_t new_events_size_bytes =
+      current_file_size_bytes_ - current_file_preamble_size_bytes_;
+  // Without any event besides the preamble, a new file would not be any smaller.
+  if (new_events_size_bytes == 0) return false;
+  return (options_.max_file_size_bytes > 0 &&
+          current_file_size_bytes_ >= options_.max_file_size_bytes &&
+          new_events_size_bytes >= current_file_preamble_size_bytes_) ||
+         absl::Now() - current_file_start_time_ >= options_.max_file_duration;
+}
+
+ErrorMessageOr<void> CaptureFileClientCaptureEventCollector::WriteEvent(
+    const ClientCaptureEvent& event) {
+  // The CaptureFinished event of the capture ends the current file, so it never starts a new one.
+  if (output_stream_ == nullptr ||
+      (IsFileFull() && event.event_case() != ClientCaptureEvent::kCaptureFinished)) {
+    OUTCOME_TRY(OpenNextFile());
+  }
+
+  OUTCOME_TRY(output_stream_->WriteCaptureEvent(event));
+  const uint64_t event_size_bytes = event.ByteSizeLong();
+  current_file_size_bytes_ += event_size_bytes;
+
+  const bool files_are_rotated = options_.max_file_size_bytes > 0 ||
+                                 options_.max_file_duration != absl::InfiniteDuration();
+  if (files_are_rotated && IsPreambleEvent(event)) {
+    preamble_events_.push_back(event);
+    preamble_size_bytes_ += event_size_bytes;
+    // The event is repeated in the next file, so it doesn't count towards the new events.
+    current_file_preamble_size_bytes_ += event_size_bytes;
+  }
+  return outcome::success();
+}
+
+void CaptureFileClientCaptureEventCollector::WriterThread() {
+  orbit_base::SetCurrentThreadName("CaptureFileWrite");
+
+  bool stopped = false;
+  while (!stopped) {
+    ORBIT_SCOPE("CaptureFileWriter iteration");
+
+    mutex_.LockWhenWithTimeout(
+        absl::Condition(
+            +[](CaptureFileClientCaptureEventCollector* self)
+                 ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
+                   return self->events_being_buffered_.size() >= kWriteEventCountInterval ||
+                          self->stop_requested_;
+                 },
+            this),
+        kWriteTimeInterval);
+    stopped = stop_requested_;
+    // Double buffering: the events are written while new ones are buffered.
+    events_being_buffered_.swap(events_to_write_);
+    mutex_.Unlock();
+
+    for (const ClientCaptureEvent& event : events_to_write_) {
+      if (write_failed_) break;
+      ErrorMessageOr<void> result = WriteEvent(event);
+      if (result.has_error()) {
+        ORBIT_ERROR("Writing capture to file: %s", result.error().message());
+        write_failed_ = true;
+      }
+    }
+    events_to_write_.clear();
+  }
+
+  ErrorMessageOr<void> result = CloseCurrentFile();
+  if (result.has_error()) {
+    ORBIT_ERROR("Closing capture file: %s", result.error().message());
+  }
+}
+
+}  // namespace orbit_producer_event_processor
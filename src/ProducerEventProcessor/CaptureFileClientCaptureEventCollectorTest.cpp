@@ -0,0 +1,290 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdint.h>
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CaptureFile/CaptureFile.h"
+#include "CaptureFile/ProtoSectionInputStream.h"
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Result.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
+#include "TestUtils/TemporaryDirectory.h"
+#include "TestUtils/TestUtils.h"
+
+using orbit_capture_file::CaptureFile;
+using orbit_capture_file::ProtoSectionInputStream;
+using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_test_utils::HasNoError;
+
+namespace orbit_producer_event_processor {
+
+namespace {
+
+constexpr uint64_t kInternedStringKey = 42;
+constexpr const char* kInternedString = "interned";
+
+[[nodiscard]] ClientCaptureEvent CreateCaptureStartedEvent() {
+  ClientCaptureEvent event;
+  event.mutable_capture_started()->set_process_id(1);
+  return event;
+}
+
+[[nodiscard]] ClientCaptureEvent CreateInternedStringEvent() {
+  ClientCaptureEvent event;
+  event.mutable_interned_string()->set_key(kInternedStringKey);
+  event.mutable_interned_string()->set_intern(kInternedString);
+  return event;
+}
+
+[[nodiscard]] ClientCaptureEvent CreateSchedulingSliceEvent(uint64_t out_timestamp_ns) {
+  ClientCaptureEvent event;
+  event.mutable_scheduling_slice()->set_pid(1);
+  event.mutable_scheduling_slice()->set_tid(2);
+  event.mutable_scheduling_slice()->set_core(3);
+  event.mutable_scheduling_slice()->set_duration_ns(4);
+  event.mutable_scheduling_slice()->set_out_timestamp_ns(out_timestamp_ns);
+  return event;
+}
+
+[[nodiscard]] ClientCaptureEvent CreateCaptureFinishedEvent() {
+  ClientCaptureEvent event;
+  event.mutable_capture_finished()->set_status(orbit_grpc_protos::CaptureFinished::kSuccessful);
+  return event;
+}
+
+class CaptureFileClientCaptureEventCollectorTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    auto temporary_dir_or_error = orbit_test_utils::TemporaryDirectory::Create();
+    ASSERT_THAT(temporary_dir_or_error, HasNoError());
+    temporary_dir_ = std::move(temporary_dir_or_error.value());
+  }
+
+  [[nodiscard]] std::filesystem::path GetCaptureDirectory() const {
+    return temporary_dir_->GetDirectoryPath() / "captures";
+  }
+
+  static void VerifyPreamble(ProtoSectionInputStream* input_stream) {
+    ClientCaptureEvent event;
+    ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+    ASSERT_EQ(event.event_case(), ClientCaptureEvent::kCaptureStarted);
+    EXPECT_EQ(event.capture_started().process_id(), 1);
+
+    ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+    ASSERT_EQ(event.event_case(), ClientCaptureEvent::kInternedString);
+    EXPECT_EQ(event.interned_string().key(), kInternedStringKey);
+    EXPECT_EQ(event.interned_string().intern(), kInternedString);
+  }
+
+ private:
+  std::optional<orbit_test_utils::TemporaryDirectory> temporary_dir_;
+};
+
+}  // namespace
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, WritesAllEventsToOneFile) {
+  constexpr uint64_t kSchedulingSliceCount = 1000;
+
+  auto collector_or_error =
+      CaptureFileClientCaptureEventCollector::Create({.directory = GetCaptureDirectory()});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+
+  collector->AddEvent(CreateCaptureStartedEvent());
+  collector->AddEvent(CreateInternedStringEvent());
+  for (uint64_t i = 0; i < kSchedulingSliceCount; ++i) {
+    collector->AddEvent(CreateSchedulingSliceEvent(i));
+  }
+  collector->AddEvent(CreateCaptureFinishedEvent());
+  collector->StopAndWait();
+
+  ASSERT_EQ(collector->file_paths().size(), 1);
+  auto capture_file_or_error = CaptureFile::OpenForReadWrite(collector->file_paths()[0]);
+  ASSERT_THAT(capture_file_or_error, HasNoError());
+  std::unique_ptr<ProtoSectionInputStream> input_stream =
+      capture_file_or_error.value()->CreateCaptureSectionInputStream();
+
+  VerifyPreamble(input_stream.get());
+  for (uint64_t i = 0; i < kSchedulingSliceCount; ++i) {
+    ClientCaptureEvent event;
+    ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+    ASSERT_EQ(event.event_case(), ClientCaptureEvent::kSchedulingSlice);
+    EXPECT_EQ(event.scheduling_slice().out_timestamp_ns(), i);
+  }
+  ClientCaptureEvent event;
+  ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+  EXPECT_EQ(event.event_case(), ClientCaptureEvent::kCaptureFinished);
+}
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, RotatedFilesStartWithPreamble) {
+  constexpr uint64_t kSchedulingSliceCount = 10'000;
+
+  auto collector_or_error = CaptureFileClientCaptureEventCollector::Create(
+      {.directory = GetCaptureDirectory(), .max_file_size_bytes = 16 * 1024});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+
+  collector->AddEvent(CreateCaptureStartedEvent());
+  collector->AddEvent(CreateInternedStringEvent());
+  for (uint64_t i = 0; i < kSchedulingSliceCount; ++i) {
+    collector->AddEvent(CreateSchedulingSliceEvent(i));
+  }
+  collector->AddEvent(CreateCaptureFinishedEvent());
+  collector->StopAndWait();
+
+  const std::vector<std::filesystem::path>& file_paths = collector->file_paths();
+  ASSERT_GT(file_paths.size(), 1);
+
+  // Every file ends with a CaptureFinished event, and the scheduling slices continue where those of
+  // the previous file ended.
+  uint64_t expected_out_timestamp_ns = 0;
+  for (const std::filesystem::path& file_path : file_paths) {
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(file_path);
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+    std::unique_ptr<ProtoSectionInputStream> input_stream =
+        capture_file_or_error.value()->CreateCaptureSectionInputStream();
+
+    VerifyPreamble(input_stream.get());
+    const uint64_t first_out_timestamp_ns = expected_out_timestamp_ns;
+    while (true) {
+      ClientCaptureEvent event;
+      ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+      if (event.event_case() == ClientCaptureEvent::kCaptureFinished) break;
+      ASSERT_EQ(event.event_case(), ClientCaptureEvent::kSchedulingSlice);
+      EXPECT_EQ(event.scheduling_slice().out_timestamp_ns(), expected_out_timestamp_ns);
+      ++expected_out_timestamp_ns;
+    }
+    EXPECT_GT(expected_out_timestamp_ns, first_out_timestamp_ns);
+  }
+  EXPECT_EQ(expected_out_timestamp_ns, kSchedulingSliceCount);
+}
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, FilesHoldAtLeastAsManyNewEventsAsPreamble) {
+  constexpr uint64_t kSchedulingSliceCount = 1000;
+
+  auto collector_or_error = CaptureFileClientCaptureEventCollector::Create(
+      {.directory = GetCaptureDirectory(), .max_file_size_bytes = 1024});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+
+  collector->AddEvent(CreateCaptureStartedEvent());
+  // On its own, the preamble exceeds the maximum file size.
+  ClientCaptureEvent large_interned_string;
+  large_interned_string.mutable_interned_string()->set_key(kInternedStringKey);
+  large_interned_string.mutable_interned_string()->set_intern(std::string(2048, 'a'));
+  const uint64_t preamble_size_bytes = CreateCaptureStartedEvent().ByteSizeLong() +
+                                       large_interned_string.ByteSizeLong();
+  collector->AddEvent(std::move(large_interned_string));
+  for (uint64_t i = 0; i < kSchedulingSliceCount; ++i) {
+    collector->AddEvent(CreateSchedulingSliceEvent(i));
+  }
+  collector->AddEvent(CreateCaptureFinishedEvent());
+  collector->StopAndWait();
+
+  const std::vector<std::filesystem::path>& file_paths = collector->file_paths();
+  ASSERT_GT(file_paths.size(), 1);
+  for (const std::filesystem::path& file_path : file_paths) {
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(file_path);
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+    std::unique_ptr<ProtoSectionInputStream> input_stream =
+        capture_file_or_error.value()->CreateCaptureSectionInputStream();
+
+    uint64_t scheduling_slices_size_bytes = 0;
+    ClientCaptureEvent event;
+    do {
+      ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+      if (event.event_case() == ClientCaptureEvent::kSchedulingSlice) {
+        scheduling_slices_size_bytes += event.ByteSizeLong();
+      }
+    } while (event.event_case() != ClientCaptureEvent::kCaptureFinished);
+    if (file_path != file_paths.back()) {
+      EXPECT_GE(scheduling_slices_size_bytes, preamble_size_bytes);
+    }
+  }
+}
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, NoFileIsCreatedWithoutEvents) {
+  auto collector_or_error =
+      CaptureFileClientCaptureEventCollector::Create({.directory = GetCaptureDirectory()});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+  collector->StopAndWait();
+
+  EXPECT_TRUE(collector->file_paths().empty());
+  EXPECT_TRUE(std::filesystem::is_empty(GetCaptureDirectory()));
+}
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, EventsAfterStopAreDropped) {
+  auto collector_or_error =
+      CaptureFileClientCaptureEventCollector::Create({.directory = GetCaptureDirectory()});
+  ASSERT_THAT(collector_or_error, HasNoError());
+  std::unique_ptr<CaptureFileClientCaptureEventCollector> collector =
+      std::move(collector_or_error.value());
+
+  collector->AddEvent(CreateCaptureStartedEvent());
+  collector->AddEvent(CreateInternedStringEvent());
+  collector->AddEvent(CreateCaptureFinishedEvent());
+  collector->StopAndWait();
+  collector->AddEvent(CreateSchedulingSliceEvent(0));
+
+  ASSERT_EQ(collector->file_paths().size(), 1);
+  auto capture_file_or_error = CaptureFile::OpenForReadWrite(collector->file_paths()[0]);
+  ASSERT_THAT(capture_file_or_error, HasNoError());
+  std::unique_ptr<ProtoSectionInputStream> input_stream =
+      capture_file_or_error.value()->CreateCaptureSectionInputStream();
+  VerifyPreamble(input_stream.get());
+  ClientCaptureEvent event;
+  ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+  EXPECT_EQ(event.event_case(), ClientCaptureEvent::kCaptureFinished);
+}
+
+TEST_F(CaptureFileClientCaptureEventCollectorTest, CapturesStartedTogetherWriteDifferentFiles) {
+  constexpr size_t kCollectorCount = 3;
+
+  // The collectors are all created before any of them writes, so that they likely get the same
+  // start time.
+  std::vector<std::unique_ptr<CaptureFileClientCaptureEventCollector>> collectors;
+  for (size_t i = 0; i < kCollectorCount; ++i) {
+    auto collector_or_error =
+        CaptureFileClientCaptureEventCollector::Create({.directory = GetCaptureDirectory()});
+    ASSERT_THAT(collector_or_error, HasNoError());
+    collectors.push_back(std::move(collector_or_error.value()));
+  }
+
+  std::set<std::filesystem::path> file_paths;
+  for (const std::unique_ptr<CaptureFileClientCaptureEventCollector>& collector : collectors) {
+    collector->AddEvent(CreateCaptureStartedEvent());
+    collector->AddEvent(CreateInternedStringEvent());
+    collector->AddEvent(CreateCaptureFinishedEvent());
+    collector->StopAndWait();
+
+    ASSERT_EQ(collector->file_paths().size(), 1);
+    file_paths.insert(collector->file_paths()[0]);
+    auto capture_file_or_error = CaptureFile::OpenForReadWrite(collector->file_paths()[0]);
+    ASSERT_THAT(capture_file_or_error, HasNoError());
+    std::unique_ptr<ProtoSectionInputStream> input_stream =
+        capture_file_or_error.value()->CreateCaptureSectionInputStream();
+    VerifyPreamble(input_stream.get());
+    ClientCaptureEvent event;
+    ASSERT_THAT(input_stream->ReadMessage(&event), HasNoError());
+    EXPECT_EQ(event.event_case(), ClientCaptureEvent::kCaptureFinished);
+  }
+  EXPECT_EQ(file_paths.size(), kCollectorCount);
+}
+
+}  // namespace orbit_producer_event_processor
@@ -22,6 +22,20 @@ using orbit_grpc_protos::ClientCaptureEvent;
 
 namespace orbit_producer_event_processor {
 
+namespace {
+
+// Events are sent at least this often, so that the capture on the client looks live.
+constexpr absl::Duration kSendTimeInterval = absl::Milliseconds(20);
+
+// We group several ClientCaptureEvents in a single CaptureResponse to avoid sending countless
+// tiny messages. But we also want to avoid huge messages, which:
+// - would cause the capture on the client to jump forward in time in few big steps and not look
+//   live anymore;
+// - could exceed the maximum gRPC message size.
+constexpr int kMaxEventsPerCaptureResponse = 10'000;
+
+}  // namespace
+
 static void InitializeArenaOfCaptureResponses(
     std::unique_ptr<google::protobuf::Arena>* arena_of_capture_responses,
     std::unique_ptr<char[]>* initial_block_of_arena) {
@@ -37,9 +51,16 @@ static void InitializeArenaOfCaptureResponses(
 
 GrpcClientCaptureEventCollector::GrpcClientCaptureEventCollector(
     grpc::ServerReaderWriterInterface<orbit_grpc_protos::CaptureResponse,
-                                      orbit_grpc_protos::CaptureRequest>* reader_writer)
-    : reader_writer_{reader_writer} {
+                                      orbit_grpc_protos::CaptureRequest>* reader_writer,
+    SendEventCountThresholdBounds send_event_count_threshold_bounds)
+    : reader_writer_{reader_writer},
+      send_event_count_threshold_bounds_{send_event_count_threshold_bounds},
+      send_event_count_threshold_{send_event_count_threshold_bounds.initial} {
   ORBIT_CHECK(reader_writer_ != nullptr);
+  ORBIT_CHECK(send_event_count_threshold_bounds_.min > 0);
+  ORBIT_CHECK(send_event_count_threshold_bounds_.min <= send_event_count_threshold_bounds_.initial);
+  ORBIT_CHECK(send_event_count_threshold_bounds_.initial <= send_event_count_threshold_bounds_.max);
+  ORBIT_CHECK(send_event_count_threshold_bounds_.max < kMaxEventsPerCaptureResponse);
 
   InitializeArenaOfCaptureResponses(&arena_of_capture_responses_being_built_,
                                     &initial_block_of_first_arena_);
@@ -54,13 +75,23 @@ void GrpcClientCaptureEventCollector::AddEvent(ClientCaptureEvent&& event) {
   if (stop_requested_) {
     return;
   }
+  // Note that, as `event` is not allocated on the Arena, this copies the event.
+  GetCaptureResponseBeingBuilt()->mutable_capture_events()->Add(std::move(event));
+}
+
+void GrpcClientCaptureEventCollector::EmplaceEvent(
+    absl::FunctionRef<void(ClientCaptureEvent*)> fill_event) {
+  absl::MutexLock lock{&mutex_};
+  if (stop_requested_) {
+    // Still let `fill_event` hand over ownership of what it would add to the event.
+    ClientCaptureEvent discarded_event;
+    fill_event(&discarded_event);
+    return;
+  }
+  fill_event(GetCaptureResponseBeingBuilt()->add_capture_events());
+}
 
-  // We group several ClientCaptureEvents in a single CaptureResponse to avoid sending countless
-  // tiny messages. But we also want to avoid huge messages, which:
-  // - would cause the capture on the client to jump forward in time in few big steps and not look
-  //   live anymore;
-  // - could exceed the maximum gRPC message size.
-  static constexpr int kMaxEventsPerCaptureResponse = 10'000;
+CaptureResponse* GrpcClientCaptureEventCollector::GetCaptureResponseBeingBuilt() {
   if (capture_responses_being_built_.empty() ||
       capture_responses_being_built_.back()->capture_events_size() ==
           kMaxEventsPerCaptureResponse) {
@@ -68,7 +99,7 @@ void GrpcClientCaptureEventCollector::AddEvent(ClientCaptureEvent&& event) {
         arena_of_capture_responses_being_built_.get());
     capture_responses_being_built_.push_back(capture_response);
   }
-  capture_responses_being_built_.back()->mutable_capture_events()->Add(std::move(event));
+  return capture_responses_being_built_.back();
 }
 
 void GrpcClientCaptureEventCollector::StopAndWait() {
@@ -95,9 +126,38 @@ GrpcClientCaptureEventCollector::~GrpcClientCaptureEventCollector() {
   }
 }
 
+void GrpcClientCaptureEventCollector::SetUpCompression(
+    grpc::ServerContext* context, const orbit_grpc_protos::CaptureOptions& capture_options) {
+  ORBIT_CHECK(context != nullptr);
+  if (!capture_options.compress_capture_responses()) return;
+  ORBIT_LOG("Compressing CaptureResponses with gzip");
+  context->set_compression_algorithm(GRPC_COMPRESS_GZIP);
+}
+
+int GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+    int threshold, SendEventCountThresholdBounds bounds, size_t capture_responses_sent,
+    absl::Duration write_duration) {
+  if (capture_responses_sent > 1 || write_duration > kSendTimeInterval) {
+    return std::min(2 * threshold, bounds.max);
+  }
+  if (write_duration < kSendTimeInterval / 4) {
+    return std::max(threshold - threshold / 4, bounds.min);
+  }
+  return threshold;
+}
+
+void GrpcClientCaptureEventCollector::UpdateSendEventCountThreshold(
+    size_t capture_responses_sent, absl::Duration write_duration) {
+  absl::MutexLock lock{&mutex_};
+  send_event_count_threshold_ =
+      ComputeNextSendEventCountThreshold(send_event_count_threshold_,
+                                         send_event_count_threshold_bounds_,
+                                         capture_responses_sent, write_duration);
+  ORBIT_INT("Send event count threshold", send_event_count_threshold_);
+}
+
 void GrpcClientCaptureEventCollector::SenderThread() {
   orbit_base::SetCurrentThreadName("SenderThread");
-  constexpr absl::Duration kSendTimeInterval = absl::Milliseconds(20);
 
   bool stopped = false;
   while (!stopped) {
@@ -106,14 +166,9 @@ void GrpcClientCaptureEventCollector::SenderThread() {
     mutex_.LockWhenWithTimeout(
         absl::Condition(
             +[](GrpcClientCaptureEventCollector* self) ABSL_EXCLUSIVE_LOCKS_REQUIRED(self->mutex_) {
-              // This should be lower than (not equal to) kMaxEventsPerCaptureResponse in AddEvent
-              // as a few more ClientCaptureEvents are likely to arrive after the condition becomes
-              // true.
-              constexpr int kSendEventCountInterval = 5000;
-
               return (self->capture_responses_being_built_.size() == 1 &&
                       self->capture_responses_being_built_.back()->capture_events_size() >=
-                          kSendEventCountInterval) ||
+                          self->send_event_count_threshold_) ||
                      self->capture_responses_being_built_.size() > 1 || self->stop_requested_;
             },
             this),
@@ -134,11 +189,12 @@ void GrpcClientCaptureEventCollector::SenderThread() {
 
     uint64_t number_of_events_sent = 0;
     uint64_t number_of_bytes_sent = 0;
+    const absl::Time write_start = absl::Now();
 
-    // Note that usually we only have one CaptureResponse to send because kSendEventCountInterval is
-    // quite lower than kMaxEventsPerCaptureResponse. But we can have more than one if new events
-    // come faster than `reader_writer_->Write` executes, which can for example happen if the client
-    // is a bit unresponsive.
+    // Note that usually we only have one CaptureResponse to send because
+    // send_event_count_threshold_ is lower than kMaxEventsPerCaptureResponse. But we can have more
+    // than one if new events come faster than `reader_writer_->Write` executes, which can for
+    // example happen if the client is a bit unresponsive.
     for (CaptureResponse* capture_response : capture_responses_to_send_) {
       // Record statistics on event count and byte size for this CaptureResponse.
       int capture_response_event_count = capture_response->capture_events_size();
@@ -157,6 +213,7 @@ void GrpcClientCaptureEventCollector::SenderThread() {
         reader_writer_->Write(*capture_response);
       }
     }
+    UpdateSendEventCountThreshold(capture_responses_to_send_.size(), absl::Now() - write_start);
 
     // Record statistics on event count and byte size for this entire iteration.
     {
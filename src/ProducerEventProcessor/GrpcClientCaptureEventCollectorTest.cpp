@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/strings/str_format.h>
+#include <absl/time/time.h>
 #include <gmock/gmock.h>
 #include <grpcpp/grpcpp.h>
 #include <gtest/gtest.h>
@@ -10,9 +12,13 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <string>
 #include <thread>
+#include <utility>
+#include <vector>
 
 #include "GrpcProtos/capture.pb.h"
+#include "GrpcProtos/services.grpc.pb.h"
 #include "GrpcProtos/services.pb.h"
 #include "OrbitBase/Logging.h"
 #include "ProducerEventProcessor/GrpcClientCaptureEventCollector.h"
@@ -20,6 +26,7 @@
 using orbit_grpc_protos::CaptureRequest;
 using orbit_grpc_protos::CaptureResponse;
 using orbit_grpc_protos::ClientCaptureEvent;
+using orbit_grpc_protos::SchedulingSlice;
 
 namespace orbit_producer_event_processor {
 
@@ -69,6 +76,16 @@ class GrpcClientCaptureEventCollectorTest : public testing::Test {
     }
   }
 
+  void EmplaceSchedulingSlices(uint64_t event_count) {
+    for (uint64_t i = 0; i < event_count; ++i) {
+      auto scheduling_slice = std::make_unique<SchedulingSlice>();
+      scheduling_slice->set_tid(static_cast<int32_t>(i));
+      collector_.EmplaceEvent([&scheduling_slice](ClientCaptureEvent* event) {
+        event->set_allocated_scheduling_slice(scheduling_slice.release());
+      });
+    }
+  }
+
   void CallStopAndWaitEarly() {
     ORBIT_CHECK(!stop_and_wait_called_);
     collector_.StopAndWait();
@@ -81,8 +98,14 @@ class GrpcClientCaptureEventCollectorTest : public testing::Test {
   // We leave some margin to account for delays in scheduling.
   static constexpr std::chrono::milliseconds kWaitAllCaptureResponsesSentDuration{50};
 
+  // The send event count threshold is pinned, so that the number of CaptureResponses doesn't
+  // depend on how fast the mock writes them.
+  static constexpr int kSendEventCountThreshold = 5'000;
+
  private:
-  GrpcClientCaptureEventCollector collector_{&mock_reader_writer_};
+  GrpcClientCaptureEventCollector collector_{
+      &mock_reader_writer_,
+      {kSendEventCountThreshold, kSendEventCountThreshold, kSendEventCountThreshold}};
   bool stop_and_wait_called_ = false;
 };
 
@@ -105,12 +128,28 @@ TEST_F(GrpcClientCaptureEventCollectorTest, AllEventsAreSent) {
   EXPECT_EQ(actual_event_count, kEventCount);
 }
 
+TEST_F(GrpcClientCaptureEventCollectorTest, EmplacedEventsAreSent) {
+  std::vector<int32_t> actual_tids;
+  EXPECT_CALL(mock_reader_writer_, OnCaptureResponse)
+      .Times(testing::Between(1, 2))
+      .WillRepeatedly([&actual_tids](const CaptureResponse& capture_response) {
+        for (const ClientCaptureEvent& event : capture_response.capture_events()) {
+          ASSERT_EQ(event.event_case(), ClientCaptureEvent::kSchedulingSlice);
+          actual_tids.push_back(event.scheduling_slice().tid());
+        }
+      });
+
+  EmplaceSchedulingSlices(3);
+  CallStopAndWaitEarly();
+  EXPECT_THAT(actual_tids, testing::ElementsAre(0, 1, 2));
+}
+
 TEST_F(GrpcClientCaptureEventCollectorTest, ManyEventsAreSplitAcrossMultipleCaptureResponses) {
   std::atomic<uint64_t> actual_event_count = 0;
   EXPECT_CALL(mock_reader_writer_, OnCaptureResponse)
-      // This depends on the values of kSendEventCountInterval (5000) in
-      // GrpcClientCaptureEventCollector::SenderThread, and of
-      // kMaxEventsPerCaptureResponse (10000) in GrpcClientCaptureEventCollector::AddEvent.
+      // This depends on the value of kSendEventCountThreshold (5000), and of
+      // kMaxEventsPerCaptureResponse (10000) in
+      // GrpcClientCaptureEventCollector::GetCaptureResponseBeingBuilt.
       // So expect seven CaptureResponse, the first six of which with ~5000 events. But there could
       // be fewer CaptureResponses as they can fit up to 10000 events.
       .Times(testing::Between(4, 7))
@@ -157,4 +196,178 @@ TEST_F(GrpcClientCaptureEventCollectorTest, AllCaptureResponsesSentShortlyAfterS
   EXPECT_EQ(actual_event_count, kEventCount);
 }
 
+TEST(GrpcClientCaptureEventCollector, SendEventCountThresholdGrowsWhenCaptureResponsesQueueUp) {
+  constexpr GrpcClientCaptureEventCollector::SendEventCountThresholdBounds kBounds{1'000, 2'000,
+                                                                                  9'000};
+  EXPECT_EQ(GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+                2'000, kBounds, /*capture_responses_sent=*/2, absl::ZeroDuration()),
+            4'000);
+  EXPECT_EQ(GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+                4'000, kBounds, /*capture_responses_sent=*/3, absl::ZeroDuration()),
+            8'000);
+}
+
+TEST(GrpcClientCaptureEventCollector, SendEventCountThresholdGrowsWhenWritingIsSlow) {
+  constexpr GrpcClientCaptureEventCollector::SendEventCountThresholdBounds kBounds{1'000, 2'000,
+                                                                                  9'000};
+  EXPECT_EQ(GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+                2'000, kBounds, /*capture_responses_sent=*/1, absl::Milliseconds(100)),
+            4'000);
+}
+
+TEST(GrpcClientCaptureEventCollector, SendEventCountThresholdShrinksWhenWritingIsFast) {
+  constexpr GrpcClientCaptureEventCollector::SendEventCountThresholdBounds kBounds{1'000, 2'000,
+                                                                                  9'000};
+  EXPECT_EQ(GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+                8'000, kBounds, /*capture_responses_sent=*/1, absl::ZeroDuration()),
+            6'000);
+}
+
+TEST(GrpcClientCaptureEventCollector, SendEventCountThresholdStaysWithinBounds) {
+  constexpr GrpcClientCaptureEventCollector::SendEventCountThresholdBounds kBounds{1'000, 2'000,
+                                                                                  9'000};
+  int threshold = kBounds.initial;
+  for (int i = 0; i < 10; ++i) {
+    threshold = GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+        threshold, kBounds, /*capture_responses_sent=*/2, absl::Milliseconds(100));
+    EXPECT_LE(threshold, kBounds.max);
+  }
+  EXPECT_EQ(threshold, kBounds.max);
+
+  for (int i = 0; i < 20; ++i) {
+    threshold = GrpcClientCaptureEventCollector::ComputeNextSendEventCountThreshold(
+        threshold, kBounds, /*capture_responses_sent=*/1, absl::ZeroDuration());
+    EXPECT_GE(threshold, kBounds.min);
+  }
+  EXPECT_EQ(threshold, kBounds.min);
+}
+
+namespace {
+
+// Streams kLoopbackEventCount InternedStrings through a GrpcClientCaptureEventCollector, set up
+// according to the CaptureOptions of the first CaptureRequest.
+class LoopbackCaptureService final : public orbit_grpc_protos::CaptureService::Service {
+ public:
+  static constexpr uint64_t kLoopbackEventCount = 20'000;
+  static constexpr size_t kInternSize = 100;
+
+  grpc::Status Capture(
+      grpc::ServerContext* context,
+      grpc::ServerReaderWriter<CaptureResponse, CaptureRequest>* reader_writer) override {
+    CaptureRequest capture_request;
+    if (!reader_writer->Read(&capture_request)) {
+      return {grpc::StatusCode::INVALID_ARGUMENT, "Missing CaptureRequest"};
+    }
+    GrpcClientCaptureEventCollector::SetUpCompression(context, capture_request.capture_options());
+
+    GrpcClientCaptureEventCollector collector{reader_writer};
+    for (uint64_t key = 0; key < kLoopbackEventCount; ++key) {
+      ClientCaptureEvent event;
+      event.mutable_interned_string()->set_key(key);
+      event.mutable_interned_string()->set_intern(std::string(kInternSize, 'a'));
+      collector.AddEvent(std::move(event));
+    }
+    collector.StopAndWait();
+    return grpc::Status::OK;
+  }
+};
+
+class GrpcClientCaptureEventCollectorLoopbackTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    grpc::ServerBuilder builder;
+    int port = 0;
+    builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+    builder.RegisterService(&service_);
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(server_, nullptr);
+    ASSERT_NE(port, 0);
+    const std::string server_address = absl::StrFormat("127.0.0.1:%d", port);
+    channel_ = grpc::CreateChannel(server_address, grpc::InsecureChannelCredentials());
+
+    // A client that doesn't support gzip fails the call when it receives a gzip-encoded message.
+    grpc::ChannelArguments channel_arguments;
+    channel_arguments.SetInt(GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET,
+                             1u << GRPC_COMPRESS_NONE);
+    channel_without_gzip_ = grpc::CreateCustomChannel(
+        server_address, grpc::InsecureChannelCredentials(), channel_arguments);
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  struct CaptureResult {
+    std::vector<uint64_t> keys;
+    grpc::Status status;
+  };
+
+  // Runs a capture over the loopback connection and returns the keys of the received events.
+  [[nodiscard]] std::vector<uint64_t> RunCapture(bool compress_capture_responses) {
+    CaptureResult result = RunCaptureOnChannel(channel_, compress_capture_responses);
+    EXPECT_TRUE(result.status.ok()) << result.status.error_message();
+    return std::move(result.keys);
+  }
+
+  [[nodiscard]] static CaptureResult RunCaptureOnChannel(
+      const std::shared_ptr<grpc::Channel>& channel, bool compress_capture_responses) {
+    std::unique_ptr<orbit_grpc_protos::CaptureService::Stub> stub =
+        orbit_grpc_protos::CaptureService::NewStub(channel);
+    grpc::ClientContext context;
+    std::unique_ptr<grpc::ClientReaderWriter<CaptureRequest, CaptureResponse>> reader_writer =
+        stub->Capture(&context);
+
+    CaptureRequest capture_request;
+    capture_request.mutable_capture_options()->set_compress_capture_responses(
+        compress_capture_responses);
+    EXPECT_TRUE(reader_writer->Write(capture_request));
+    EXPECT_TRUE(reader_writer->WritesDone());
+
+    CaptureResult result;
+    CaptureResponse capture_response;
+    while (reader_writer->Read(&capture_response)) {
+      for (const ClientCaptureEvent& event : capture_response.capture_events()) {
+        EXPECT_EQ(event.event_case(), ClientCaptureEvent::kInternedString);
+        EXPECT_EQ(event.interned_string().intern().size(), LoopbackCaptureService::kInternSize);
+        result.keys.push_back(event.interned_string().key());
+      }
+    }
+    result.status = reader_writer->Finish();
+    return result;
+  }
+
+  static void ExpectAllKeysInOrder(const std::vector<uint64_t>& keys) {
+    ASSERT_EQ(keys.size(), LoopbackCaptureService::kLoopbackEventCount);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      EXPECT_EQ(keys[i], i);
+    }
+  }
+
+  LoopbackCaptureService service_;
+  std::unique_ptr<grpc::Server> server_;
+  std::shared_ptr<grpc::Channel> channel_;
+  std::shared_ptr<grpc::Channel> channel_without_gzip_;
+};
+
+}  // namespace
+
+TEST_F(GrpcClientCaptureEventCollectorLoopbackTest, UncompressedCaptureResponsesAreReceived) {
+  ExpectAllKeysInOrder(RunCapture(/*compress_capture_responses=*/false));
+}
+
+TEST_F(GrpcClientCaptureEventCollectorLoopbackTest, CompressedCaptureResponsesAreReceived) {
+  ExpectAllKeysInOrder(RunCapture(/*compress_capture_responses=*/true));
+}
+
+TEST_F(GrpcClientCaptureEventCollectorLoopbackTest, CaptureResponsesAreGzipEncodedOnlyIfRequested) {
+  CaptureResult uncompressed_result =
+      RunCaptureOnChannel(channel_without_gzip_, /*compress_capture_responses=*/false);
+  EXPECT_TRUE(uncompressed_result.status.ok()) << uncompressed_result.status.error_message();
+  ExpectAllKeysInOrder(uncompressed_result.keys);
+
+  // The client rejecting the CaptureResponses shows that they arrive gzip-encoded.
+  CaptureResult compressed_result =
+      RunCaptureOnChannel(channel_without_gzip_, /*compress_capture_responses=*/true);
+  EXPECT_EQ(compressed_result.status.error_code(), grpc::StatusCode::UNIMPLEMENTED);
+  EXPECT_THAT(compressed_result.status.error_message(), testing::HasSubstr("gzip"));
+}
+
 }  // namespace orbit_producer_event_processor
@@ -4,13 +4,21 @@
 
 #include "ProducerEventProcessor/ProducerEventProcessor.h"
 
+#include <absl/base/thread_annotations.h>
 #include <absl/container/flat_hash_map.h>
 #include <absl/hash/hash.h>
 #include <absl/meta/type_traits.h>
 #include <absl/synchronization/mutex.h>
+#include <absl/types/span.h>
 #include <google/protobuf/stubs/port.h>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -72,30 +80,86 @@ namespace orbit_producer_event_processor {
 
 namespace {
 
-template <typename T>
+using CallstackView = std::pair<absl::Span<const uint64_t>, Callstack::CallstackType>;
+using TracepointView = std::pair<std::string_view, std::string_view>;
+
+// The entries stored by InternPool are built from the corresponding views only when a new entry is
+// added. Lookups only need the view, so that interning an entry that already exists doesn't copy
+// it.
+[[nodiscard]] std::string MakeInternPoolEntry(std::string_view view) { return std::string{view}; }
+
+[[nodiscard]] std::pair<std::string, std::string> MakeInternPoolEntry(const TracepointView& view) {
+  return {std::string{view.first}, std::string{view.second}};
+}
+
+[[nodiscard]] std::pair<std::vector<uint64_t>, Callstack::CallstackType> MakeInternPoolEntry(
+    const CallstackView& view) {
+  return {{view.first.begin(), view.first.end()}, view.second};
+}
+
+// Assigns ids to entries of type T, which are looked up through views of type ViewT. The pool is
+// split into shards, each with its own mutex, chosen by the hash of the entry. This way producers
+// interning different entries concurrently rarely contend on the same lock. The hash is computed
+// once per lookup and stored with the entry, so that neither lookups nor rehashing hash entries
+// again. Ids are unique across shards.
+template <typename T, typename ViewT>
 class InternPool final {
  public:
   InternPool() = default;
 
   // Return pair of <id, assigned>, where assigned is true if the entry was assigned a new id
   // and false if returning id for already existing entry.
-  std::pair<uint64_t, bool> GetOrAssignId(const T& entry) {
-    absl::MutexLock lock(&entry_to_id_mutex_);
-    auto it = entry_to_id_.find(entry);
-    if (it != entry_to_id_.end()) {
+  std::pair<uint64_t, bool> GetOrAssignId(const ViewT& entry) {
+    const size_t hash = absl::Hash<ViewT>{}(entry);
+    Shard& shard = shards_[hash >> (std::numeric_limits<size_t>::digits - kNumShardsLog2)];
+
+    absl::MutexLock lock(&shard.mutex);
+    auto it = shard.entry_to_id.find(HashedView{hash, entry});
+    if (it != shard.entry_to_id.end()) {
       return std::make_pair(it->second, false);
     }
 
-    uint64_t new_id = id_counter_++;
-    auto [unused_it, inserted] = entry_to_id_.insert_or_assign(entry, new_id);
+    uint64_t new_id = id_counter_.fetch_add(1, std::memory_order_relaxed);
+    auto [unused_it, inserted] =
+        shard.entry_to_id.try_emplace(HashedEntry{hash, MakeInternPoolEntry(entry)}, new_id);
     ORBIT_CHECK(inserted);
     return std::make_pair(new_id, true);
   }
 
  private:
-  uint64_t id_counter_ = 1;  // 0 is reserved for invalid_id
-  absl::flat_hash_map<T, uint64_t> entry_to_id_;
-  absl::Mutex entry_to_id_mutex_;
+  struct HashedEntry {
+    size_t hash;
+    T entry;
+  };
+  struct HashedView {
+    size_t hash;
+    ViewT entry;
+  };
+
+  // Transparent, so that the maps can be queried with a HashedView.
+  struct PrecomputedHash {
+    using is_transparent = void;
+    size_t operator()(const HashedEntry& entry) const { return entry.hash; }
+    size_t operator()(const HashedView& view) const { return view.hash; }
+  };
+  struct EntryEq {
+    using is_transparent = void;
+    template <typename Lhs, typename Rhs>
+    bool operator()(const Lhs& lhs, const Rhs& rhs) const {
+      return lhs.hash == rhs.hash && ViewT{lhs.entry} == ViewT{rhs.entry};
+    }
+  };
+
+  struct Shard {
+    absl::Mutex mutex;
+    absl::flat_hash_map<HashedEntry, uint64_t, PrecomputedHash, EntryEq> entry_to_id
+        ABSL_GUARDED_BY(mutex);
+  };
+
+  static constexpr int kNumShardsLog2 = 4;
+
+  std::atomic<uint64_t> id_counter_{1};  // 0 is reserved for invalid_id
+  std::array<Shard, 1 << kNumShardsLog2> shards_;
 };
 
 class ProducerEventProcessorImpl : public ProducerEventProcessor {
@@ -109,8 +173,10 @@ class ProducerEventProcessorImpl : public ProducerEventProcessor {
  private:
   // Please keep the declarations here and the definitions below of these Process... methods
   // alphabetically ordered as in the definition of the ProducerCaptureEvent message.
-  void ProcessApiScopeStartAndTransferOwnership(ApiScopeStart* api_scope_start);
-  void ProcessApiScopeStartAsyncAndTransferOwnership(ApiScopeStartAsync* api_scope_start_async);
+  void ProcessApiScopeStartAndTransferOwnership(uint64_t producer_id,
+                                                ApiScopeStart* api_scope_start);
+  void ProcessApiScopeStartAsyncAndTransferOwnership(uint64_t producer_id,
+                                                     ApiScopeStartAsync* api_scope_start_async);
   void ProcessApiScopeStopAndTransferOwnership(ApiScopeStop* api_scope_stop);
   void ProcessApiScopeStopAsyncAndTransferOwnership(ApiScopeStopAsync* api_scope_stop_async);
   void ProcessApiStringEventAndTransferOwnership(ApiStringEvent* api_string_event);
@@ -156,7 +222,8 @@ class ProducerEventProcessorImpl : public ProducerEventProcessor {
   void ProcessThreadNameAndTransferOwnership(ThreadName* thread_name);
   void ProcessThreadNamesSnapshotAndTransferOwnership(ThreadNamesSnapshot* thread_names_snapshot);
   void ProcessThreadStateSliceAndTransferOwnership(ThreadStateSlice* thread_state_slice);
-  void ProcessThreadStateSliceCallstack(ThreadStateSliceCallstack* thread_state_slice_callstack);
+  void ProcessThreadStateSliceCallstack(uint64_t producer_id,
+                                        ThreadStateSliceCallstack* thread_state_slice_callstack);
   void ProcessWarningEventAndTransferOwnership(WarningEvent* warning_event);
   void ProcessWarningInstrumentingWithUprobesEventAndTransferOwnership(
       WarningInstrumentingWithUprobesEvent* warning_event);
@@ -164,13 +231,25 @@ class ProducerEventProcessorImpl : public ProducerEventProcessor {
       WarningInstrumentingWithUserSpaceInstrumentationEvent* warning_event);
 
   void SendInternedStringEvent(uint64_t key, std::string value);
+
+  // Returns the key of the InternedString sent to the client for the producer's InternedString
+  // with key `producer_key`, or std::nullopt if the producer hasn't sent that InternedString.
+  [[nodiscard]] std::optional<uint64_t> TranslateProducerInternedStringKey(
+      uint64_t producer_id, uint64_t producer_key) const;
+
+  // Translates the key of the name of an ApiScopeStart or ApiScopeStartAsync. If the producer
+  // hasn't sent the name, the key is cleared, so that the scope gets an empty name.
+  template <typename ApiScopeStartT>
+  void TranslateApiScopeNameKey(uint64_t producer_id, ApiScopeStartT* api_scope_start) const;
+
   void MergeThreadStateSliceWithCallstackAndTransferOwnership(ThreadStateSlice* thread_state_slice);
 
   ClientCaptureEventCollector* client_capture_event_collector_;
 
-  InternPool<std::pair<std::vector<uint64_t>, Callstack::CallstackType>> callstack_pool_;
-  InternPool<std::string> string_pool_;
-  InternPool<std::pair<std::string, std::string>> tracepoint_pool_;
+  InternPool<std::pair<std::vector<uint64_t>, Callstack::CallstackType>, CallstackView>
+      callstack_pool_;
+  InternPool<std::string, std::string_view> string_pool_;
+  InternPool<std::pair<std::string, std::string>, TracepointView> tracepoint_pool_;
 
   // These are mapping InternStrings and InternedCallstacks from producer ids
   // to client ids:
@@ -213,9 +292,9 @@ void ProducerEventProcessorImpl::MergeThreadStateSliceWithCallstackAndTransferOw
     ORBIT_ERROR("Missing callstack for thread state slice waiting for it");
     thread_state_slice->set_switch_out_or_wakeup_callstack_status(ThreadStateSlice::kNoCallstack);
     thread_state_slice->set_switch_out_or_wakeup_callstack_id(0);
-    ClientCaptureEvent event;
-    event.set_allocated_thread_state_slice(thread_state_slice);
-    client_capture_event_collector_->AddEvent(std::move(event));
+    client_capture_event_collector_->EmplaceEvent([thread_state_slice](ClientCaptureEvent* event) {
+      event->set_allocated_thread_state_slice(thread_state_slice);
+    });
     return;
   }
 
@@ -226,86 +305,90 @@ void ProducerEventProcessorImpl::MergeThreadStateSliceWithCallstackAndTransferOw
   thread_state_slice_tid_and_begin_timestamp_to_callstack_id_.erase(
       thread_state_slice_callstack_it);
 
-  ClientCaptureEvent event;
-  event.set_allocated_thread_state_slice(thread_state_slice);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([thread_state_slice](ClientCaptureEvent* event) {
+    event->set_allocated_thread_state_slice(thread_state_slice);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiScopeStartAndTransferOwnership(
-    ApiScopeStart* api_scope_start) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_scope_start(api_scope_start);
-  client_capture_event_collector_->AddEvent(std::move(event));
+    uint64_t producer_id, ApiScopeStart* api_scope_start) {
+  TranslateApiScopeNameKey(producer_id, api_scope_start);
+
+  client_capture_event_collector_->EmplaceEvent([api_scope_start](ClientCaptureEvent* event) {
+    event->set_allocated_api_scope_start(api_scope_start);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiScopeStartAsyncAndTransferOwnership(
-    ApiScopeStartAsync* api_scope_start_async) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_scope_start_async(api_scope_start_async);
-  client_capture_event_collector_->AddEvent(std::move(event));
+    uint64_t producer_id, ApiScopeStartAsync* api_scope_start_async) {
+  TranslateApiScopeNameKey(producer_id, api_scope_start_async);
+
+  client_capture_event_collector_->EmplaceEvent([api_scope_start_async](ClientCaptureEvent* event) {
+    event->set_allocated_api_scope_start_async(api_scope_start_async);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiScopeStopAndTransferOwnership(
     ApiScopeStop* api_scope_stop) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_scope_stop(api_scope_stop);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_scope_stop](ClientCaptureEvent* event) {
+    event->set_allocated_api_scope_stop(api_scope_stop);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiScopeStopAsyncAndTransferOwnership(
     ApiScopeStopAsync* api_scope_stop_async) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_scope_stop_async(api_scope_stop_async);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_scope_stop_async](ClientCaptureEvent* event) {
+    event->set_allocated_api_scope_stop_async(api_scope_stop_async);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiStringEventAndTransferOwnership(
     ApiStringEvent* api_string_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_string_event(api_string_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_string_event](ClientCaptureEvent* event) {
+    event->set_allocated_api_string_event(api_string_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackDoubleAndTransferOwnership(
     ApiTrackDouble* api_track_double) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_double(api_track_double);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_double](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_double(api_track_double);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackFloatAndTransferOwnership(
     ApiTrackFloat* api_track_float) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_float(api_track_float);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_float](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_float(api_track_float);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackIntAndTransferOwnership(
     ApiTrackInt* api_track_int) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_int(api_track_int);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_int](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_int(api_track_int);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackInt64AndTransferOwnership(
     ApiTrackInt64* api_track_int64) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_int64(api_track_int64);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_int64](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_int64(api_track_int64);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackUintAndTransferOwnership(
     ApiTrackUint* api_track_uint) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_uint(api_track_uint);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_uint](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_uint(api_track_uint);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessApiTrackUint64AndTransferOwnership(
     ApiTrackUint64* api_track_uint64) {
-  ClientCaptureEvent event;
-  event.set_allocated_api_track_uint64(api_track_uint64);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([api_track_uint64](ClientCaptureEvent* event) {
+    event->set_allocated_api_track_uint64(api_track_uint64);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessCallstackSampleAndTransferOwnership(
@@ -317,9 +400,9 @@ void ProducerEventProcessorImpl::ProcessCallstackSampleAndTransferOwnership(
   ORBIT_CHECK(it != producer_interned_callstack_id_to_client_callstack_id_.end());
   callstack_sample->set_callstack_id(it->second);
 
-  ClientCaptureEvent event;
-  event.set_allocated_callstack_sample(callstack_sample);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([callstack_sample](ClientCaptureEvent* event) {
+    event->set_allocated_callstack_sample(callstack_sample);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessCaptureFinishedAndTransferOwnership(
@@ -331,52 +414,55 @@ void ProducerEventProcessorImpl::ProcessCaptureFinishedAndTransferOwnership(
         "Some saved callstacks for thread state slices are left not merged to any slice after the "
         "capture finished.");
   }
-  ClientCaptureEvent event;
-  event.set_allocated_capture_finished(capture_finished);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([capture_finished](ClientCaptureEvent* event) {
+    event->set_allocated_capture_finished(capture_finished);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessCaptureStartedAndTransferOwnership(
     CaptureStarted* capture_started) {
-  ClientCaptureEvent event;
-  event.set_allocated_capture_started(capture_started);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([capture_started](ClientCaptureEvent* event) {
+    event->set_allocated_capture_started(capture_started);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessClockResolutionEventAndTransferOwnership(
     ClockResolutionEvent* clock_resolution_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_clock_resolution_event(clock_resolution_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [clock_resolution_event](ClientCaptureEvent* event) {
+        event->set_allocated_clock_resolution_event(clock_resolution_event);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessErrorEnablingOrbitApiEventAndTransferOwnership(
     ErrorEnablingOrbitApiEvent* error_enabling_orbit_api_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_error_enabling_orbit_api_event(error_enabling_orbit_api_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [error_enabling_orbit_api_event](ClientCaptureEvent* event) {
+        event->set_allocated_error_enabling_orbit_api_event(error_enabling_orbit_api_event);
+      });
 }
 
 void ProducerEventProcessorImpl::
     ProcessErrorEnablingUserSpaceInstrumentationEventAndTransferOwnership(
         ErrorEnablingUserSpaceInstrumentationEvent* error_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_error_enabling_user_space_instrumentation_event(error_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([error_event](ClientCaptureEvent* event) {
+    event->set_allocated_error_enabling_user_space_instrumentation_event(error_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessErrorsWithPerfEventOpenEventAndTransferOwnership(
     ErrorsWithPerfEventOpenEvent* errors_with_perf_event_open_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_errors_with_perf_event_open_event(errors_with_perf_event_open_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [errors_with_perf_event_open_event](ClientCaptureEvent* event) {
+        event->set_allocated_errors_with_perf_event_open_event(errors_with_perf_event_open_event);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessFullCallstackSample(
     FullCallstackSample* full_callstack_sample) {
   const Callstack& callstack = full_callstack_sample->callstack();
-  std::pair<std::vector<uint64_t>, Callstack::CallstackType> callstack_data{
-      {callstack.pcs().begin(), callstack.pcs().end()}, callstack.type()};
+  CallstackView callstack_data{absl::MakeConstSpan(callstack.pcs().data(), callstack.pcs().size()),
+                               callstack.type()};
   auto [callstack_id, assigned] = callstack_pool_.GetOrAssignId(callstack_data);
 
   if (assigned) {
@@ -387,13 +473,14 @@ void ProducerEventProcessorImpl::ProcessFullCallstackSample(
     client_capture_event_collector_->AddEvent(std::move(interned_callstack_event));
   }
 
-  ClientCaptureEvent callstack_sample_event;
-  CallstackSample* callstack_sample = callstack_sample_event.mutable_callstack_sample();
-  callstack_sample->set_pid(full_callstack_sample->pid());
-  callstack_sample->set_tid(full_callstack_sample->tid());
-  callstack_sample->set_timestamp_ns(full_callstack_sample->timestamp_ns());
-  callstack_sample->set_callstack_id(callstack_id);
-  client_capture_event_collector_->AddEvent(std::move(callstack_sample_event));
+  client_capture_event_collector_->EmplaceEvent(
+      [full_callstack_sample, callstack_id = callstack_id](ClientCaptureEvent* event) {
+        CallstackSample* callstack_sample = event->mutable_callstack_sample();
+        callstack_sample->set_pid(full_callstack_sample->pid());
+        callstack_sample->set_tid(full_callstack_sample->tid());
+        callstack_sample->set_timestamp_ns(full_callstack_sample->timestamp_ns());
+        callstack_sample->set_callstack_id(callstack_id);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessFullAddressInfo(FullAddressInfo* full_address_info) {
@@ -455,36 +542,37 @@ void ProducerEventProcessorImpl::ProcessFullTracepointEvent(
     client_capture_event_collector_->AddEvent(std::move(event));
   }
 
-  ClientCaptureEvent event;
-  TracepointEvent* tracepoint_event = event.mutable_tracepoint_event();
-  tracepoint_event->set_pid(full_tracepoint_event->pid());
-  tracepoint_event->set_tid(full_tracepoint_event->tid());
-  tracepoint_event->set_timestamp_ns(full_tracepoint_event->timestamp_ns());
-  tracepoint_event->set_cpu(full_tracepoint_event->cpu());
-  tracepoint_event->set_tracepoint_info_key(tracepoint_key);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [full_tracepoint_event, tracepoint_key = tracepoint_key](ClientCaptureEvent* event) {
+        TracepointEvent* tracepoint_event = event->mutable_tracepoint_event();
+        tracepoint_event->set_pid(full_tracepoint_event->pid());
+        tracepoint_event->set_tid(full_tracepoint_event->tid());
+        tracepoint_event->set_timestamp_ns(full_tracepoint_event->timestamp_ns());
+        tracepoint_event->set_cpu(full_tracepoint_event->cpu());
+        tracepoint_event->set_tracepoint_info_key(tracepoint_key);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessFunctionCallAndTransferOwnership(
     FunctionCall* function_call) {
-  ClientCaptureEvent event;
-  event.set_allocated_function_call(function_call);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([function_call](ClientCaptureEvent* event) {
+    event->set_allocated_function_call(function_call);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessGpuQueueSubmissionAndTransferOwnership(
     uint64_t producer_id, GpuQueueSubmission* gpu_queue_submission) {
   // Translate debug marker keys
   for (GpuDebugMarker& mutable_marker : *gpu_queue_submission->mutable_completed_markers()) {
-    auto it = producer_interned_string_id_to_client_string_id_.find(
-        {producer_id, mutable_marker.text_key()});
-    ORBIT_CHECK(it != producer_interned_string_id_to_client_string_id_.end());
-    mutable_marker.set_text_key(it->second);
+    std::optional<uint64_t> client_key =
+        TranslateProducerInternedStringKey(producer_id, mutable_marker.text_key());
+    ORBIT_CHECK(client_key.has_value());
+    mutable_marker.set_text_key(client_key.value());
   }
 
-  ClientCaptureEvent event;
-  event.set_allocated_gpu_queue_submission(gpu_queue_submission);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([gpu_queue_submission](ClientCaptureEvent* event) {
+    event->set_allocated_gpu_queue_submission(gpu_queue_submission);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessInternedCallstack(uint64_t producer_id,
@@ -493,9 +581,9 @@ void ProducerEventProcessorImpl::ProcessInternedCallstack(uint64_t producer_id,
   ORBIT_CHECK(!producer_interned_callstack_id_to_client_callstack_id_.contains(
       {producer_id, interned_callstack->key()}));
 
-  std::pair<std::vector<uint64_t>, Callstack::CallstackType> callstack_data{
-      {interned_callstack->intern().pcs().begin(), interned_callstack->intern().pcs().end()},
-      interned_callstack->intern().type()};
+  const Callstack& callstack = interned_callstack->intern();
+  CallstackView callstack_data{absl::MakeConstSpan(callstack.pcs().data(), callstack.pcs().size()),
+                               callstack.type()};
   auto [interned_callstack_id, assigned] = callstack_pool_.GetOrAssignId(callstack_data);
 
   producer_interned_callstack_id_to_client_callstack_id_.insert_or_assign(
@@ -535,64 +623,67 @@ void ProducerEventProcessorImpl::ProcessInternedString(uint64_t producer_id,
 
 void ProducerEventProcessorImpl::ProcessLostPerfRecordsEventAndTransferOwnership(
     LostPerfRecordsEvent* lost_perf_records_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_lost_perf_records_event(lost_perf_records_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [lost_perf_records_event](ClientCaptureEvent* event) {
+        event->set_allocated_lost_perf_records_event(lost_perf_records_event);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessMemoryUsageEventAndTransferOwnership(
     MemoryUsageEvent* memory_usage_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_memory_usage_event(memory_usage_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([memory_usage_event](ClientCaptureEvent* event) {
+    event->set_allocated_memory_usage_event(memory_usage_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessModulesSnapshotAndTransferOwnership(
     ModulesSnapshot* modules_snapshot) {
-  ClientCaptureEvent event;
-  event.set_allocated_modules_snapshot(modules_snapshot);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([modules_snapshot](ClientCaptureEvent* event) {
+    event->set_allocated_modules_snapshot(modules_snapshot);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessModuleUpdateEventAndTransferOwnership(
     orbit_grpc_protos::ModuleUpdateEvent* module_update_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_module_update_event(module_update_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([module_update_event](ClientCaptureEvent* event) {
+    event->set_allocated_module_update_event(module_update_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessOutOfOrderEventsDiscardedEventAndTransferOwnership(
     OutOfOrderEventsDiscardedEvent* out_of_order_events_discarded_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_out_of_order_events_discarded_event(out_of_order_events_discarded_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent(
+      [out_of_order_events_discarded_event](ClientCaptureEvent* event) {
+        event->set_allocated_out_of_order_events_discarded_event(
+            out_of_order_events_discarded_event);
+      });
 }
 
 void ProducerEventProcessorImpl::ProcessPresentEventAndTransferOwnership(
     PresentEvent* present_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_present_event(present_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([present_event](ClientCaptureEvent* event) {
+    event->set_allocated_present_event(present_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessSchedulingSliceAndTransferOwnership(
     SchedulingSlice* scheduling_slice) {
-  ClientCaptureEvent event;
-  event.set_allocated_scheduling_slice(scheduling_slice);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([scheduling_slice](ClientCaptureEvent* event) {
+    event->set_allocated_scheduling_slice(scheduling_slice);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessThreadNameAndTransferOwnership(ThreadName* thread_name) {
-  ClientCaptureEvent event;
-  event.set_allocated_thread_name(thread_name);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([thread_name](ClientCaptureEvent* event) {
+    event->set_allocated_thread_name(thread_name);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessThreadNamesSnapshotAndTransferOwnership(
     ThreadNamesSnapshot* thread_names_snapshot) {
-  ClientCaptureEvent event;
-  event.set_allocated_thread_names_snapshot(thread_names_snapshot);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([thread_names_snapshot](ClientCaptureEvent* event) {
+    event->set_allocated_thread_names_snapshot(thread_names_snapshot);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessThreadStateSliceAndTransferOwnership(
@@ -601,9 +692,9 @@ void ProducerEventProcessorImpl::ProcessThreadStateSliceAndTransferOwnership(
               ThreadStateSlice::kCallstackSet);
   if (thread_state_slice->switch_out_or_wakeup_callstack_status() ==
       ThreadStateSlice::kNoCallstack) {
-    ClientCaptureEvent event;
-    event.set_allocated_thread_state_slice(thread_state_slice);
-    client_capture_event_collector_->AddEvent(std::move(event));
+    client_capture_event_collector_->EmplaceEvent([thread_state_slice](ClientCaptureEvent* event) {
+      event->set_allocated_thread_state_slice(thread_state_slice);
+    });
     return;
   }
   MergeThreadStateSliceWithCallstackAndTransferOwnership(thread_state_slice);
@@ -611,24 +702,36 @@ void ProducerEventProcessorImpl::ProcessThreadStateSliceAndTransferOwnership(
 
 void ProducerEventProcessorImpl::ProcessWarningEventAndTransferOwnership(
     WarningEvent* warning_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_warning_event(warning_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([warning_event](ClientCaptureEvent* event) {
+    event->set_allocated_warning_event(warning_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessWarningInstrumentingWithUprobesEventAndTransferOwnership(
     WarningInstrumentingWithUprobesEvent* warning_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_warning_instrumenting_with_uprobes_event(warning_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([warning_event](ClientCaptureEvent* event) {
+    event->set_allocated_warning_instrumenting_with_uprobes_event(warning_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessThreadStateSliceCallstack(
-    ThreadStateSliceCallstack* thread_state_slice_callstack) {
+    uint64_t producer_id, ThreadStateSliceCallstack* thread_state_slice_callstack) {
+  if (!thread_state_slice_callstack->has_callstack()) {
+    // The producer has interned the callstack itself: translate the producer id to the client id.
+    auto it = producer_interned_callstack_id_to_client_callstack_id_.find(
+        {producer_id, thread_state_slice_callstack->callstack_id()});
+    // TODO(b/180235290): replace with error message
+    ORBIT_CHECK(it != producer_interned_callstack_id_to_client_callstack_id_.end());
+    thread_state_slice_tid_and_begin_timestamp_to_callstack_id_[{
+        thread_state_slice_callstack->thread_state_slice_tid(),
+        thread_state_slice_callstack->timestamp_ns()}] = it->second;
+    return;
+  }
+
   const Callstack& callstack = thread_state_slice_callstack->callstack();
 
-  std::pair<std::vector<uint64_t>, Callstack::CallstackType> callstack_data{
-      {callstack.pcs().begin(), callstack.pcs().end()}, callstack.type()};
+  CallstackView callstack_data{absl::MakeConstSpan(callstack.pcs().data(), callstack.pcs().size()),
+                               callstack.type()};
   auto [callstack_id, assigned] = callstack_pool_.GetOrAssignId(callstack_data);
 
   if (assigned) {
@@ -649,9 +752,9 @@ void ProducerEventProcessorImpl::ProcessThreadStateSliceCallstack(
 void ProducerEventProcessorImpl::
     ProcessWarningInstrumentingWithUserSpaceInstrumentationEventAndTransferOwnership(
         WarningInstrumentingWithUserSpaceInstrumentationEvent* warning_event) {
-  ClientCaptureEvent event;
-  event.set_allocated_warning_instrumenting_with_user_space_instrumentation_event(warning_event);
-  client_capture_event_collector_->AddEvent(std::move(event));
+  client_capture_event_collector_->EmplaceEvent([warning_event](ClientCaptureEvent* event) {
+    event->set_allocated_warning_instrumenting_with_user_space_instrumentation_event(warning_event);
+  });
 }
 
 void ProducerEventProcessorImpl::ProcessEvent(uint64_t producer_id, ProducerCaptureEvent&& event) {
@@ -659,10 +762,11 @@ void ProducerEventProcessorImpl::ProcessEvent(uint64_t producer_id, ProducerCapt
   // message.
   switch (event.event_case()) {
     case ProducerCaptureEvent::kApiScopeStart:
-      ProcessApiScopeStartAndTransferOwnership(event.release_api_scope_start());
+      ProcessApiScopeStartAndTransferOwnership(producer_id, event.release_api_scope_start());
       break;
     case ProducerCaptureEvent::kApiScopeStartAsync:
-      ProcessApiScopeStartAsyncAndTransferOwnership(event.release_api_scope_start_async());
+      ProcessApiScopeStartAsyncAndTransferOwnership(producer_id,
+                                                    event.release_api_scope_start_async());
       break;
     case ProducerCaptureEvent::kApiScopeStop:
       ProcessApiScopeStopAndTransferOwnership(event.release_api_scope_stop());
@@ -776,7 +880,7 @@ void ProducerEventProcessorImpl::ProcessEvent(uint64_t producer_id, ProducerCapt
       ProcessThreadStateSliceAndTransferOwnership(event.release_thread_state_slice());
       break;
     case ProducerCaptureEvent::kThreadStateSliceCallstack:
-      ProcessThreadStateSliceCallstack(event.mutable_thread_state_slice_callstack());
+      ProcessThreadStateSliceCallstack(producer_id, event.mutable_thread_state_slice_callstack());
       break;
     case ProducerCaptureEvent::kWarningEvent:
       ProcessWarningEventAndTransferOwnership(event.release_warning_event());
@@ -794,6 +898,29 @@ void ProducerEventProcessorImpl::ProcessEvent(uint64_t producer_id, ProducerCapt
   }
 }
 
+std::optional<uint64_t> ProducerEventProcessorImpl::TranslateProducerInternedStringKey(
+    uint64_t producer_id, uint64_t producer_key) const {
+  auto it = producer_interned_string_id_to_client_string_id_.find({producer_id, producer_key});
+  if (it == producer_interned_string_id_to_client_string_id_.end()) return std::nullopt;
+  return it->second;
+}
+
+template <typename ApiScopeStartT>
+void ProducerEventProcessorImpl::TranslateApiScopeNameKey(uint64_t producer_id,
+                                                          ApiScopeStartT* api_scope_start) const {
+  if (api_scope_start->name_key() == 0) return;
+  std::optional<uint64_t> client_key =
+      TranslateProducerInternedStringKey(producer_id, api_scope_start->name_key());
+  if (!client_key.has_value()) {
+    ORBIT_ERROR("Producer %u didn't send the name of Orbit API scope with key %u", producer_id,
+                api_scope_start->name_key());
+    // Without a key, the name is taken from the encoded name, which is empty.
+    api_scope_start->set_name_key(0);
+    return;
+  }
+  api_scope_start->set_name_key(client_key.value());
+}
+
 void ProducerEventProcessorImpl::SendInternedStringEvent(uint64_t key, std::string value) {
   ClientCaptureEvent event;
   InternedString* interned_string = event.mutable_interned_string();
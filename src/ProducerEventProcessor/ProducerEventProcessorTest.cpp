@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <absl/container/flat_hash_map.h>
+#include <absl/synchronization/mutex.h>
 #include <gmock/gmock.h>
 #include <google/protobuf/stubs/port.h>
 #include <google/protobuf/util/message_differencer.h>
@@ -12,6 +14,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -771,6 +774,62 @@ TEST(ProducerEventProcessor, FullCallstackSamplesSameCallstack) {
   EXPECT_EQ(callstack_sample2.callstack_id(), interned_callstack1.key());
 }
 
+TEST(ProducerEventProcessor, FullCallstackSamplesFromConcurrentProducers) {
+  MockClientCaptureEventCollector collector;
+  auto producer_event_processor = ProducerEventProcessor::Create(&collector);
+
+  absl::Mutex mutex;
+  absl::flat_hash_map<uint64_t, uint64_t> callstack_key_to_first_pc;
+  std::vector<CallstackSample> callstack_samples;
+  EXPECT_CALL(collector, AddEvent).WillRepeatedly(Invoke([&](ClientCaptureEvent&& event) {
+    absl::MutexLock lock(&mutex);
+    if (event.event_case() == ClientCaptureEvent::kInternedCallstack) {
+      const InternedCallstack& interned_callstack = event.interned_callstack();
+      EXPECT_NE(interned_callstack.key(), orbit_grpc_protos::kInvalidInternId);
+      ASSERT_EQ(interned_callstack.intern().pcs_size(), 2);
+      auto [unused_it, inserted] = callstack_key_to_first_pc.try_emplace(
+          interned_callstack.key(), interned_callstack.intern().pcs(0));
+      EXPECT_TRUE(inserted);
+    } else {
+      ASSERT_EQ(event.event_case(), ClientCaptureEvent::kCallstackSample);
+      callstack_samples.push_back(event.callstack_sample());
+    }
+  }));
+
+  constexpr int kNumProducers = 4;
+  constexpr int kNumSamplesPerProducer = 1000;
+  constexpr uint64_t kNumCallstacks = 50;
+  std::vector<std::thread> producers;
+  for (int producer_index = 0; producer_index < kNumProducers; ++producer_index) {
+    producers.emplace_back([&producer_event_processor, producer_index] {
+      for (int i = 0; i < kNumSamplesPerProducer; ++i) {
+        ProducerCaptureEvent event;
+        FullCallstackSample* full_callstack_sample = event.mutable_full_callstack_sample();
+        full_callstack_sample->set_pid(kPid1);
+        full_callstack_sample->set_tid(producer_index);
+        full_callstack_sample->set_timestamp_ns(i);
+        Callstack* callstack = full_callstack_sample->mutable_callstack();
+        callstack->add_pcs(i % kNumCallstacks);
+        callstack->add_pcs(42);
+        callstack->set_type(Callstack::kComplete);
+        producer_event_processor->ProcessEvent(producer_index, std::move(event));
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+
+  absl::MutexLock lock(&mutex);
+  EXPECT_EQ(callstack_key_to_first_pc.size(), kNumCallstacks);
+  ASSERT_EQ(callstack_samples.size(), kNumProducers * kNumSamplesPerProducer);
+  for (const CallstackSample& callstack_sample : callstack_samples) {
+    auto it = callstack_key_to_first_pc.find(callstack_sample.callstack_id());
+    ASSERT_NE(it, callstack_key_to_first_pc.end());
+    EXPECT_EQ(it->second, callstack_sample.timestamp_ns() % kNumCallstacks);
+  }
+}
+
 TEST(ProducerEventProcessor, FullTracepointEventsDifferentTracepoints) {
   MockClientCaptureEventCollector collector;
   auto producer_event_processor = ProducerEventProcessor::Create(&collector);
@@ -1509,6 +1568,63 @@ TEST(ProducerEventProcessor, MergingThreadStateSliceWithCallstack) {
                           ClientCaptureEventsTheadStateSliceEq(expected_thread_state_slice2)));
 }
 
+TEST(ProducerEventProcessor, MergingThreadStateSliceWithCallstackInternedByProducer) {
+  MockClientCaptureEventCollector collector;
+  auto producer_event_processor = ProducerEventProcessor::Create(&collector);
+
+  constexpr uint64_t kProducerCallstackKey = 7;
+
+  ProducerCaptureEvent interned_callstack_event;
+  InternedCallstack* interned_callstack = interned_callstack_event.mutable_interned_callstack();
+  interned_callstack->set_key(kProducerCallstackKey);
+  interned_callstack->mutable_intern()->add_pcs(1);
+  interned_callstack->mutable_intern()->add_pcs(2);
+  interned_callstack->mutable_intern()->set_type(Callstack::kComplete);
+
+  ProducerCaptureEvent thread_state_slice_callstack_event;
+  ThreadStateSliceCallstack* thread_state_slice_callstack =
+      thread_state_slice_callstack_event.mutable_thread_state_slice_callstack();
+  thread_state_slice_callstack->set_thread_state_slice_tid(kTid1);
+  thread_state_slice_callstack->set_timestamp_ns(kTimestampNs1 - kDurationNs1);
+  thread_state_slice_callstack->set_callstack_id(kProducerCallstackKey);
+
+  ProducerCaptureEvent thread_state_slice_event;
+  ThreadStateSlice* thread_state_slice = thread_state_slice_event.mutable_thread_state_slice();
+  thread_state_slice->set_pid(kPid1);
+  thread_state_slice->set_tid(kTid1);
+  thread_state_slice->set_thread_state(ThreadStateSlice::kRunnable);
+  thread_state_slice->set_duration_ns(kDurationNs1);
+  thread_state_slice->set_end_timestamp_ns(kTimestampNs1);
+  thread_state_slice->set_switch_out_or_wakeup_callstack_status(
+      ThreadStateSlice::kWaitingForCallstack);
+  thread_state_slice->set_switch_out_or_wakeup_callstack_id(0);
+  ThreadStateSlice expected_thread_state_slice = *thread_state_slice;
+
+  std::vector<ClientCaptureEvent> actual_client_capture_events;
+  EXPECT_CALL(collector, AddEvent)
+      .Times(2)
+      .WillRepeatedly(Invoke([&actual_client_capture_events](ClientCaptureEvent&& event) {
+        actual_client_capture_events.push_back(std::move(event));
+      }));
+
+  producer_event_processor->ProcessEvent(orbit_grpc_protos::kLinuxTracingProducerId,
+                                         std::move(interned_callstack_event));
+  producer_event_processor->ProcessEvent(orbit_grpc_protos::kLinuxTracingProducerId,
+                                         std::move(thread_state_slice_callstack_event));
+  producer_event_processor->ProcessEvent(orbit_grpc_protos::kLinuxTracingProducerId,
+                                         std::move(thread_state_slice_event));
+
+  ASSERT_EQ(actual_client_capture_events.size(), 2);
+  ASSERT_EQ(actual_client_capture_events[0].event_case(), ClientCaptureEvent::kInternedCallstack);
+  const uint64_t client_callstack_key = actual_client_capture_events[0].interned_callstack().key();
+
+  expected_thread_state_slice.set_switch_out_or_wakeup_callstack_status(
+      ThreadStateSlice::kCallstackSet);
+  expected_thread_state_slice.set_switch_out_or_wakeup_callstack_id(client_callstack_key);
+  EXPECT_THAT(actual_client_capture_events[1],
+              ClientCaptureEventsTheadStateSliceEq(expected_thread_state_slice));
+}
+
 TEST(ProducerEventProcessor,
      MergingThreadStateSliceWithCallstackFailsGracefullyWhenNoCallstackWasSeen) {
   MockClientCaptureEventCollector collector;
@@ -1933,6 +2049,69 @@ TEST(ProducerEventProcessor, ApiScopeStart) {
   EXPECT_TRUE(MessageDifferencer::Equivalent(api_scope_start_copy, actual_event));
 }
 
+TEST(ProducerEventProcessor, ApiScopeStartAndApiScopeStartAsyncWithNameKey) {
+  MockClientCaptureEventCollector collector;
+  auto producer_event_processor = ProducerEventProcessor::Create(&collector);
+
+  std::vector<ClientCaptureEvent> client_capture_events;
+  EXPECT_CALL(collector, AddEvent)
+      .Times(3)
+      .WillRepeatedly(Invoke([&client_capture_events](ClientCaptureEvent&& event) {
+        client_capture_events.push_back(std::move(event));
+      }));
+
+  producer_event_processor->ProcessEvent(kDefaultProducerId,
+                                         CreateInternedStringEvent(kKey1, "scope name"));
+
+  ProducerCaptureEvent api_scope_start_event;
+  ApiScopeStart* api_scope_start = api_scope_start_event.mutable_api_scope_start();
+  api_scope_start->set_pid(kPid1);
+  api_scope_start->set_tid(kTid1);
+  api_scope_start->set_timestamp_ns(kTimestampNs1);
+  api_scope_start->set_name_key(kKey1);
+  producer_event_processor->ProcessEvent(kDefaultProducerId, std::move(api_scope_start_event));
+
+  ProducerCaptureEvent api_scope_start_async_event;
+  ApiScopeStartAsync* api_scope_start_async =
+      api_scope_start_async_event.mutable_api_scope_start_async();
+  api_scope_start_async->set_pid(kPid1);
+  api_scope_start_async->set_tid(kTid1);
+  api_scope_start_async->set_timestamp_ns(kTimestampNs1);
+  api_scope_start_async->set_name_key(kKey1);
+  producer_event_processor->ProcessEvent(kDefaultProducerId,
+                                         std::move(api_scope_start_async_event));
+
+  ASSERT_EQ(client_capture_events.size(), 3);
+  ASSERT_EQ(client_capture_events[0].event_case(), ClientCaptureEvent::kInternedString);
+  const uint64_t client_key = client_capture_events[0].interned_string().key();
+  EXPECT_EQ(client_capture_events[0].interned_string().intern(), "scope name");
+
+  ASSERT_EQ(client_capture_events[1].event_case(), ClientCaptureEvent::kApiScopeStart);
+  EXPECT_EQ(client_capture_events[1].api_scope_start().name_key(), client_key);
+  EXPECT_EQ(client_capture_events[1].api_scope_start().timestamp_ns(), kTimestampNs1);
+  ASSERT_EQ(client_capture_events[2].event_case(), ClientCaptureEvent::kApiScopeStartAsync);
+  EXPECT_EQ(client_capture_events[2].api_scope_start_async().name_key(), client_key);
+}
+
+TEST(ProducerEventProcessor, ApiScopeStartWithUnknownNameKeyGetsEmptyName) {
+  MockClientCaptureEventCollector collector;
+  auto producer_event_processor = ProducerEventProcessor::Create(&collector);
+  ClientCaptureEvent client_capture_event;
+  EXPECT_CALL(collector, AddEvent).Times(1).WillOnce(SaveArg<0>(&client_capture_event));
+
+  ProducerCaptureEvent api_scope_start_event;
+  ApiScopeStart* api_scope_start = api_scope_start_event.mutable_api_scope_start();
+  api_scope_start->set_pid(kPid1);
+  api_scope_start->set_tid(kTid1);
+  api_scope_start->set_timestamp_ns(kTimestampNs1);
+  api_scope_start->set_name_key(kKey1);
+  producer_event_processor->ProcessEvent(kDefaultProducerId, std::move(api_scope_start_event));
+
+  ASSERT_EQ(client_capture_event.event_case(), ClientCaptureEvent::kApiScopeStart);
+  EXPECT_EQ(client_capture_event.api_scope_start().name_key(), 0);
+  EXPECT_EQ(client_capture_event.api_scope_start().timestamp_ns(), kTimestampNs1);
+}
+
 TEST(ProducerEventProcessor, ApiScopeStop) {
   ProducerCaptureEvent producer_capture_event;
   ApiScopeStop* api_scope_stop = producer_capture_event.mutable_api_scope_stop();
@@ -0,0 +1,110 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CAPTURE_EVENT_PROCESSOR_CAPTURE_FILE_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
+#define CAPTURE_EVENT_PROCESSOR_CAPTURE_FILE_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
+
+#include <absl/base/thread_annotations.h>
+#include <absl/synchronization/mutex.h>
+#include <absl/time/time.h>
+#include <stdint.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CaptureFile/CaptureFileOutputStream.h"
+#include "GrpcProtos/capture.pb.h"
+#include "OrbitBase/Result.h"
+#include "ProducerEventProcessor/ClientCaptureEventCollector.h"
+
+namespace orbit_producer_event_processor {
+
+// This class receives the ClientCaptureEvents emitted by a ProducerEventProcessor and writes them
+// to capture files in a local directory, instead of sending them to the client. This allows long,
+// unattended captures whose files are fetched and loaded later.
+//
+// Events are buffered and written on a background thread, which creates the first file when the
+// first event arrives. A capture can be split across several files, by size or by time. Each file
+// starts with the events that later events refer to, e.g., CaptureStarted, interned strings and
+// callstacks, and module and thread names, and ends with a CaptureFinished event, so every file
+// can be loaded on its own.
+//
+// Note that the events repeated at the start of each file are kept in memory for the whole
+// capture, as any later event can refer to them. They grow with the number of distinct strings,
+// callstacks and modules, not with the length of the capture.
+class CaptureFileClientCaptureEventCollector final : public ClientCaptureEventCollector {
+ public:
+  struct Options {
+    // The directory the capture files are written to. It is created if it doesn't exist.
+    std::filesystem::path directory;
+    // A new file is started when the events written to the current one, including the repeated
+    // ones at its start, exceed this size (uncompressed). Zero means no limit. So that the repeated
+    // events don't cause a new file for every few events when they grow large, a file is only
+    // considered full once it also holds at least as many bytes of new events, hence files can
+    // exceed this size by up to the size of the repeated events.
+    uint64_t max_file_size_bytes = 0;
+    // A new file is started when the current one has been written to for this long.
+    absl::Duration max_file_duration = absl::InfiniteDuration();
+  };
+
+  // Creates the directory and starts the writer thread.
+  [[nodiscard]] static ErrorMessageOr<std::unique_ptr<CaptureFileClientCaptureEventCollector>>
+  Create(Options options);
+
+  void AddEvent(orbit_grpc_protos::ClientCaptureEvent&& event) override;
+
+  // Writes the remaining events and closes the current file.
+  void StopAndWait() override;
+
+  ~CaptureFileClientCaptureEventCollector() override;
+
+  // The paths of the files written, in order. Empty if no event was added. Only call this after
+  // StopAndWait.
+  [[nodiscard]] const std::vector<std::filesystem::path>& file_paths() const {
+    return file_paths_;
+  }
+
+ private:
+  explicit CaptureFileClientCaptureEventCollector(Options options);
+
+  [[nodiscard]] std::filesystem::path GetFilePath(size_t file_index) const;
+  // Creates the first file of the capture, with a name that no file in the directory has yet.
+  [[nodiscard]] ErrorMessageOr<std::unique_ptr<orbit_capture_file::CaptureFileOutputStream>>
+  CreateFirstFile();
+  [[nodiscard]] ErrorMessageOr<void> OpenNextFile();
+  [[nodiscard]] ErrorMessageOr<void> CloseCurrentFile();
+  [[nodiscard]] ErrorMessageOr<void> WriteEvent(const orbit_grpc_protos::ClientCaptureEvent& event);
+  [[nodiscard]] bool IsFileFull() const;
+
+  void WriterThread();
+
+  Options options_;
+  absl::Time capture_start_time_;
+
+  absl::Mutex mutex_;
+  bool stop_requested_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<orbit_grpc_protos::ClientCaptureEvent> events_being_buffered_ ABSL_GUARDED_BY(mutex_);
+  std::thread writer_thread_;
+
+  // Only accessed by the writer thread, once it is started.
+  std::vector<orbit_grpc_protos::ClientCaptureEvent> events_to_write_;
+  std::unique_ptr<orbit_capture_file::CaptureFileOutputStream> output_stream_;
+  std::vector<std::filesystem::path> file_paths_;
+  // The names of all files of the capture start with this, followed by the index of the file.
+  std::string file_name_prefix_;
+  uint64_t current_file_size_bytes_ = 0;
+  uint64_t current_file_preamble_size_bytes_ = 0;
+  absl::Time current_file_start_time_;
+  // The events that are repeated at the start of each new file. Only kept if files are rotated.
+  std::vector<orbit_grpc_protos::ClientCaptureEvent> preamble_events_;
+  uint64_t preamble_size_bytes_ = 0;
+  bool write_failed_ = false;
+};
+
+}  // namespace orbit_producer_event_processor
+
+#endif  // CAPTURE_EVENT_PROCESSOR_CAPTURE_FILE_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
@@ -5,6 +5,10 @@
 #ifndef CAPTURE_EVENT_PROCESSOR_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
 #define CAPTURE_EVENT_PROCESSOR_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
 
+#include <absl/functional/function_ref.h>
+
+#include <utility>
+
 #include "GrpcProtos/capture.pb.h"
 
 namespace orbit_producer_event_processor {
@@ -15,6 +19,18 @@ class ClientCaptureEventCollector {
  public:
   virtual ~ClientCaptureEventCollector() = default;
   virtual void AddEvent(orbit_grpc_protos::ClientCaptureEvent&& event) = 0;
+
+  // Adds the ClientCaptureEvent that `fill_event` writes into the given empty event. Collectors
+  // that batch events in their own messages can construct the event in place, instead of allocating
+  // a separate ClientCaptureEvent and then copying it. As `fill_event` might run while the
+  // collector holds a lock, it should only fill or hand over fields.
+  virtual void EmplaceEvent(
+      absl::FunctionRef<void(orbit_grpc_protos::ClientCaptureEvent*)> fill_event) {
+    orbit_grpc_protos::ClientCaptureEvent event;
+    fill_event(&event);
+    AddEvent(std::move(event));
+  }
+
   virtual void StopAndWait() = 0;
 };
 
@@ -6,11 +6,14 @@
 #define CAPTURE_EVENT_PROCESSOR_GRPC_CLIENT_CAPTURE_EVENT_COLLECTOR_H_
 
 #include <absl/base/thread_annotations.h>
+#include <absl/functional/function_ref.h>
 #include <absl/synchronization/mutex.h>
+#include <absl/time/time.h>
 #include <google/protobuf/arena.h>
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/impl/codegen/sync_stream.h>
 #include <grpcpp/support/sync_stream.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <memory>
@@ -27,25 +30,71 @@ namespace orbit_producer_event_processor {
 // sends them to the client buffered in CaptureResponses.
 class GrpcClientCaptureEventCollector final : public ClientCaptureEventCollector {
  public:
+  // When the CaptureResponse being built reaches the send event count threshold, it is sent
+  // without waiting for the send interval to elapse. The threshold starts at `initial` and adapts
+  // to the connection between `min` and `max`, see ComputeNextSendEventCountThreshold.
+  struct SendEventCountThresholdBounds {
+    int min;
+    int initial;
+    int max;
+  };
+
+  // The maximum should be lower than (not equal to) the maximum number of events per
+  // CaptureResponse (10000), as a few more ClientCaptureEvents are likely to arrive after the
+  // threshold is reached.
+  static constexpr SendEventCountThresholdBounds kDefaultSendEventCountThresholdBounds{
+      1'000, 5'000, 9'000};
+
   explicit GrpcClientCaptureEventCollector(
       grpc::ServerReaderWriterInterface<orbit_grpc_protos::CaptureResponse,
-                                        orbit_grpc_protos::CaptureRequest>* reader_writer);
+                                        orbit_grpc_protos::CaptureRequest>* reader_writer,
+      SendEventCountThresholdBounds send_event_count_threshold_bounds =
+          kDefaultSendEventCountThresholdBounds);
 
   void AddEvent(orbit_grpc_protos::ClientCaptureEvent&& event) override;
 
+  // Builds the event directly in the Arena of the CaptureResponses being built. Submessages that
+  // `fill_event` hands over with set_allocated_* are owned by the Arena instead of being copied.
+  void EmplaceEvent(
+      absl::FunctionRef<void(orbit_grpc_protos::ClientCaptureEvent*)> fill_event) override;
+
   void StopAndWait() override;
 
   ~GrpcClientCaptureEventCollector() override;
 
+  // Sets up the call of `context` so that the CaptureResponses sent to the client are compressed,
+  // if `capture_options` request so. As the compression algorithm is announced in the initial
+  // metadata of the call, this has to be called before the first CaptureResponse is sent.
+  static void SetUpCompression(grpc::ServerContext* context,
+                               const orbit_grpc_protos::CaptureOptions& capture_options);
+
+  // Returns the send event count threshold to use after `capture_responses_sent` CaptureResponses
+  // were written in `write_duration` with threshold `threshold`. Grows the threshold when the
+  // connection can't keep up, i.e., when CaptureResponses queued up or writing them took longer
+  // than the send interval, so that fewer, larger messages are sent, which also compress better.
+  // Shrinks it again when writing is fast, so that the capture on the client stays live.
+  [[nodiscard]] static int ComputeNextSendEventCountThreshold(
+      int threshold, SendEventCountThresholdBounds bounds, size_t capture_responses_sent,
+      absl::Duration write_duration);
+
  private:
+  // Returns the CaptureResponse the next event should be added to, creating a new one if needed.
+  [[nodiscard]] orbit_grpc_protos::CaptureResponse* GetCaptureResponseBeingBuilt()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   void SenderThread();
 
+  void UpdateSendEventCountThreshold(size_t capture_responses_sent, absl::Duration write_duration);
+
   grpc::ServerReaderWriterInterface<orbit_grpc_protos::CaptureResponse,
                                     orbit_grpc_protos::CaptureRequest>* reader_writer_;
   absl::Mutex mutex_;
   std::thread sender_thread_;
   bool stop_requested_ ABSL_GUARDED_BY(mutex_) = false;
 
+  const SendEventCountThresholdBounds send_event_count_threshold_bounds_;
+  int send_event_count_threshold_ ABSL_GUARDED_BY(mutex_);
+
   std::unique_ptr<char[]> initial_block_of_first_arena_;
   std::unique_ptr<char[]> initial_block_of_second_arena_;
   std::unique_ptr<google::protobuf::Arena> arena_of_capture_responses_being_built_
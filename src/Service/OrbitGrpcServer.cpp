@@ -10,10 +10,13 @@
 #include <stdint.h>
 
 #include <limits>
+#include <optional>
 #include <string>
 #include <utility>
 
 #include "CaptureServiceBase/CaptureStartStopListener.h"
+#include "OrbitBase/Logging.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
 
 #ifdef __linux
 
@@ -39,7 +42,10 @@ class OrbitGrpcServerImpl final : public OrbitGrpcServer {
   OrbitGrpcServerImpl(const OrbitGrpcServerImpl&) = delete;
   OrbitGrpcServerImpl& operator=(OrbitGrpcServerImpl&) = delete;
 
-  [[nodiscard]] bool Init(std::string_view server_address, bool dev_mode);
+  [[nodiscard]] bool Init(
+      std::string_view server_address, bool dev_mode,
+      std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+          capture_file_options);
 
   void Shutdown() override;
   void Wait() override;
@@ -63,9 +69,20 @@ class OrbitGrpcServerImpl final : public OrbitGrpcServer {
   std::unique_ptr<grpc::Server> server_;
 };
 
-bool OrbitGrpcServerImpl::Init(std::string_view server_address, bool dev_mode) {
+bool OrbitGrpcServerImpl::Init(
+    std::string_view server_address, bool dev_mode,
+    std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+        capture_file_options) {
   grpc::EnableDefaultHealthCheckService(true);
 
+#ifdef __linux
+  capture_service_.SetCaptureFileOptions(std::move(capture_file_options));
+#else
+  if (capture_file_options.has_value()) {
+    ORBIT_ERROR("Writing captures to files on the target is not supported on this platform");
+  }
+#endif
+
   grpc::ServerBuilder builder;
 
   // Increase maximum receive size for unbounded "CaptureOptions" message.
@@ -103,11 +120,13 @@ void OrbitGrpcServerImpl::RemoveCaptureStartStopListener(
 
 }  // namespace
 
-std::unique_ptr<OrbitGrpcServer> OrbitGrpcServer::Create(std::string_view server_address,
-                                                         bool dev_mode) {
+std::unique_ptr<OrbitGrpcServer> OrbitGrpcServer::Create(
+    std::string_view server_address, bool dev_mode,
+    std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+        capture_file_options) {
   std::unique_ptr<OrbitGrpcServerImpl> server_impl = std::make_unique<OrbitGrpcServerImpl>();
 
-  if (!server_impl->Init(server_address, dev_mode)) {
+  if (!server_impl->Init(server_address, dev_mode, std::move(capture_file_options))) {
     return nullptr;
   }
 
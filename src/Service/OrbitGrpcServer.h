@@ -6,10 +6,12 @@
 #define ORBIT_SERVICE_ORBIT_GRPC_SERVER_H_
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 
 #include "CaptureServiceBase/CaptureStartStopListener.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
 
 namespace orbit_service {
 
@@ -34,9 +36,12 @@ class OrbitGrpcServer {
       orbit_capture_service_base::CaptureStartStopListener* listener) = 0;
 
   // Creates a server listening specified address and registers all
-  // necessary services.
-  [[nodiscard]] static std::unique_ptr<OrbitGrpcServer> Create(std::string_view server_address,
-                                                               bool dev_mode);
+  // necessary services. If `capture_file_options` is set, captures are written to capture files on
+  // this machine instead of being sent to the client (only supported on Linux).
+  [[nodiscard]] static std::unique_ptr<OrbitGrpcServer> Create(
+      std::string_view server_address, bool dev_mode,
+      std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+          capture_file_options);
 };
 
 }  // namespace orbit_service
@@ -13,8 +13,10 @@
 #include <chrono>
 #include <cstdio>
 #include <memory>
+#include <optional>
 #include <string>
 #include <thread>
+#include <utility>
 
 #include "OrbitBase/ExecuteCommand.h"
 #include "OrbitBase/Logging.h"
@@ -113,11 +115,14 @@ bool IsSshConnectionAlive(std::chrono::time_point<std::chrono::steady_clock> las
              .count() < timeout_in_seconds;
 }
 
-ErrorMessageOr<std::unique_ptr<OrbitGrpcServer>> CreateGrpcServer(uint16_t grpc_port,
-                                                                  bool dev_mode) {
+ErrorMessageOr<std::unique_ptr<OrbitGrpcServer>> CreateGrpcServer(
+    uint16_t grpc_port, bool dev_mode,
+    std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+        capture_file_options) {
   std::string grpc_address = absl::StrFormat("127.0.0.1:%d", grpc_port);
   ORBIT_LOG("Starting gRPC server at %s", grpc_address);
-  std::unique_ptr<OrbitGrpcServer> grpc_server = OrbitGrpcServer::Create(grpc_address, dev_mode);
+  std::unique_ptr<OrbitGrpcServer> grpc_server =
+      OrbitGrpcServer::Create(grpc_address, dev_mode, std::move(capture_file_options));
   if (grpc_server == nullptr) {
     return ErrorMessage{"Unable to start gRPC server."};
   }
@@ -140,7 +145,7 @@ ErrorMessageOr<void> OrbitService::Run(std::atomic<bool>* exit_requested) {
 #endif
 
   OUTCOME_TRY(std::unique_ptr<OrbitGrpcServer> grpc_server,
-              CreateGrpcServer(grpc_port_, dev_mode_));
+              CreateGrpcServer(grpc_port_, dev_mode_, capture_file_options_));
 
   std::unique_ptr<ProducerSideServer> producer_side_server;
   if (start_producer_side_server_) {
@@ -16,15 +16,20 @@
 
 #include "GrpcProtos/capture.pb.h"
 #include "OrbitBase/Result.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
 
 namespace orbit_service {
 
 class OrbitService {
  public:
-  explicit OrbitService(uint16_t grpc_port, bool start_producer_side_server, bool dev_mode)
+  explicit OrbitService(
+      uint16_t grpc_port, bool start_producer_side_server, bool dev_mode,
+      std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+          capture_file_options = std::nullopt)
       : grpc_port_{grpc_port},
         start_producer_side_server_{start_producer_side_server},
-        dev_mode_{dev_mode} {}
+        dev_mode_{dev_mode},
+        capture_file_options_{std::move(capture_file_options)} {}
 
   ErrorMessageOr<void> Run(std::atomic<bool>* exit_requested);
 
@@ -34,6 +39,8 @@ class OrbitService {
   uint16_t grpc_port_;
   bool start_producer_side_server_;
   bool dev_mode_;
+  std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+      capture_file_options_;
 
   std::optional<std::chrono::time_point<std::chrono::steady_clock>> last_stdin_message_ =
       std::nullopt;
@@ -7,15 +7,18 @@
 #include <absl/flags/usage.h>
 #include <absl/flags/usage_config.h>
 #include <absl/strings/string_view.h>
+#include <absl/time/time.h>
 
 #include <atomic>
 #include <csignal>
 #include <cstdint>
 #include <cstdio>
 #include <filesystem>
+#include <optional>
 #include <string>
 #include <system_error>
 #include <tuple>
+#include <utility>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -25,6 +28,7 @@
 #include "OrbitBase/Result.h"
 #include "OrbitService.h"
 #include "OrbitVersion/OrbitVersion.h"
+#include "ProducerEventProcessor/CaptureFileClientCaptureEventCollector.h"
 
 #ifdef _WIN32
 #include "OrbitBase/ExecutablePath.h"
@@ -39,6 +43,16 @@ ABSL_FLAG(bool, producer_side_server, true,
 
 ABSL_FLAG(bool, devmode, false, "Enable developer mode");
 
+ABSL_FLAG(std::string, capture_file_dir, "",
+          "Write captures to .orbit files in this directory instead of sending them to the client "
+          "(Linux only)");
+ABSL_FLAG(uint64_t, capture_file_max_size_mb, 0,
+          "With --capture_file_dir, start a new file when the current one exceeds this size; 0 "
+          "means no limit");
+ABSL_FLAG(absl::Duration, capture_file_max_duration, absl::InfiniteDuration(),
+          "With --capture_file_dir, start a new file when the current one has been written to for "
+          "this long, e.g., 10m");
+
 namespace {
 
 std::atomic<bool> exit_requested;
@@ -107,8 +121,20 @@ int main(int argc, char** argv) {
   const bool start_producer_side_server = absl::GetFlag(FLAGS_producer_side_server);
   const bool dev_mode = absl::GetFlag(FLAGS_devmode);
 
+  std::optional<orbit_producer_event_processor::CaptureFileClientCaptureEventCollector::Options>
+      capture_file_options;
+  if (!absl::GetFlag(FLAGS_capture_file_dir).empty()) {
+    constexpr uint64_t kBytesPerMegabyte = 1024 * 1024;
+    capture_file_options.emplace();
+    capture_file_options->directory = absl::GetFlag(FLAGS_capture_file_dir);
+    capture_file_options->max_file_size_bytes =
+        absl::GetFlag(FLAGS_capture_file_max_size_mb) * kBytesPerMegabyte;
+    capture_file_options->max_file_duration = absl::GetFlag(FLAGS_capture_file_max_duration);
+  }
+
   exit_requested = false;
-  orbit_service::OrbitService service{grpc_port, start_producer_side_server, dev_mode};
+  orbit_service::OrbitService service{grpc_port, start_producer_side_server, dev_mode,
+                                      std::move(capture_file_options)};
   auto result = service.Run(&exit_requested);
 
   if (!result.has_error()) return 0;
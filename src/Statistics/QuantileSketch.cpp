@@ -0,0 +1,95 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "Statistics/QuantileSketch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+#include "OrbitBase/Logging.h"
+
+namespace orbit_statistics {
+
+QuantileSketch::QuantileSketch(double relative_accuracy)
+    : relative_accuracy_{relative_accuracy},
+      gamma_{(1.0 + relative_accuracy) / (1.0 - relative_accuracy)},
+      log_gamma_{std::log(gamma_)} {
+  ORBIT_CHECK(relative_accuracy > 0.0 && relative_accuracy < 1.0);
+}
+
+void QuantileSketch::Add(uint64_t value) {
+  ++count_;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  if (value == 0) {
+    ++zero_count_;
+    return;
+  }
+  AddToBucket(ValueToBucketIndex(value), 1);
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+  ORBIT_CHECK(relative_accuracy_ == other.relative_accuracy_);
+  if (other.count_ == 0) return;
+
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  zero_count_ += other.zero_count_;
+  for (size_t i = 0; i < other.bucket_counts_.size(); ++i) {
+    if (other.bucket_counts_[i] == 0) continue;
+    AddToBucket(other.first_bucket_index_ + static_cast<int32_t>(i), other.bucket_counts_[i]);
+  }
+}
+
+std::optional<uint64_t> QuantileSketch::GetQuantile(double quantile) const {
+  if (count_ == 0) return std::nullopt;
+  ORBIT_CHECK(quantile >= 0.0 && quantile <= 1.0);
+
+  const auto rank = static_cast<uint64_t>(quantile * static_cast<double>(count_ - 1));
+  // The exact min and max are known, which makes the extreme quantiles exact.
+  if (rank == 0) return min_;
+  if (rank == count_ - 1) return max_;
+  if (rank < zero_count_) return 0;
+
+  uint64_t cumulative_count = zero_count_;
+  for (size_t i = 0; i < bucket_counts_.size(); ++i) {
+    cumulative_count += bucket_counts_[i];
+    if (cumulative_count > rank) {
+      const uint64_t value = BucketIndexToValue(first_bucket_index_ + static_cast<int32_t>(i));
+      return std::clamp(value, min_, max_);
+    }
+  }
+  return max_;
+}
+
+int32_t QuantileSketch::ValueToBucketIndex(uint64_t value) const {
+  return static_cast<int32_t>(std::ceil(std::log(static_cast<double>(value)) / log_gamma_));
+}
+
+uint64_t QuantileSketch::BucketIndexToValue(int32_t index) const {
+  // The value with the same relative distance to both boundaries of the bucket.
+  const double value = 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+  if (value >= static_cast<double>(std::numeric_limits<uint64_t>::max())) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return static_cast<uint64_t>(value + 0.5);
+}
+
+void QuantileSketch::AddToBucket(int32_t index, uint64_t count) {
+  if (bucket_counts_.empty()) {
+    first_bucket_index_ = index;
+    bucket_counts_.push_back(0);
+  } else if (index < first_bucket_index_) {
+    bucket_counts_.insert(bucket_counts_.begin(), first_bucket_index_ - index, 0);
+    first_bucket_index_ = index;
+  } else if (index >= first_bucket_index_ + static_cast<int32_t>(bucket_counts_.size())) {
+    bucket_counts_.resize(index - first_bucket_index_ + 1, 0);
+  }
+  bucket_counts_[index - first_bucket_index_] += count;
+}
+
+}  // namespace orbit_statistics
@@ -0,0 +1,115 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <gtest/gtest.h>
+#include <stddef.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "Statistics/QuantileSketch.h"
+
+namespace orbit_statistics {
+
+namespace {
+
+constexpr std::array<double, 7> kQuantiles{0.0, 0.01, 0.25, 0.5, 0.95, 0.99, 1.0};
+
+[[nodiscard]] uint64_t GetExactQuantile(const std::vector<uint64_t>& sorted_values,
+                                        double quantile) {
+  return sorted_values[static_cast<size_t>(quantile *
+                                           static_cast<double>(sorted_values.size() - 1))];
+}
+
+void ExpectQuantilesWithinRelativeAccuracy(const QuantileSketch& sketch,
+                                           std::vector<uint64_t> values) {
+  std::sort(values.begin(), values.end());
+  for (double quantile : kQuantiles) {
+    const std::optional<uint64_t> estimate = sketch.GetQuantile(quantile);
+    ASSERT_TRUE(estimate.has_value());
+    const auto exact = static_cast<double>(GetExactQuantile(values, quantile));
+    EXPECT_LE(std::abs(static_cast<double>(estimate.value()) - exact),
+              sketch.relative_accuracy() * exact + 1.0)
+        << "quantile " << quantile;
+  }
+}
+
+}  // namespace
+
+TEST(QuantileSketch, Empty) {
+  const QuantileSketch sketch;
+  EXPECT_EQ(sketch.count(), 0);
+  EXPECT_EQ(sketch.GetQuantile(0.5), std::nullopt);
+}
+
+TEST(QuantileSketch, SingleValueAndZeros) {
+  QuantileSketch sketch;
+  sketch.Add(0);
+  sketch.Add(0);
+  sketch.Add(1000);
+  EXPECT_EQ(sketch.count(), 3);
+  EXPECT_EQ(sketch.min(), 0);
+  EXPECT_EQ(sketch.max(), 1000);
+  EXPECT_EQ(sketch.GetQuantile(0.0), 0);
+  EXPECT_EQ(sketch.GetQuantile(0.5), 0);
+  EXPECT_EQ(sketch.GetQuantile(1.0), 1000);
+}
+
+TEST(QuantileSketch, QuantilesAreWithinRelativeAccuracy) {
+  std::mt19937 random_engine{42};
+  // Durations spanning several orders of magnitude, like timer durations.
+  std::lognormal_distribution<double> distribution{10.0, 3.0};
+  std::vector<uint64_t> values;
+  for (double relative_accuracy : {0.01, 0.05}) {
+    QuantileSketch sketch{relative_accuracy};
+    values.clear();
+    for (size_t i = 0; i < 100'000; ++i) {
+      const auto value = static_cast<uint64_t>(distribution(random_engine));
+      values.push_back(value);
+      sketch.Add(value);
+    }
+    EXPECT_EQ(sketch.count(), values.size());
+    ExpectQuantilesWithinRelativeAccuracy(sketch, values);
+  }
+}
+
+TEST(QuantileSketch, MergeIsEquivalentToAddingAllValues) {
+  std::mt19937 random_engine{42};
+  std::uniform_int_distribution<uint64_t> small_distribution{1, 1'000};
+  std::uniform_int_distribution<uint64_t> large_distribution{1'000'000, 1'000'000'000};
+  QuantileSketch small_values_sketch;
+  QuantileSketch large_values_sketch;
+  std::vector<uint64_t> values;
+  for (size_t i = 0; i < 10'000; ++i) {
+    values.push_back(small_distribution(random_engine));
+    small_values_sketch.Add(values.back());
+    values.push_back(large_distribution(random_engine));
+    large_values_sketch.Add(values.back());
+  }
+
+  QuantileSketch merged_sketch;
+  merged_sketch.Merge(large_values_sketch);
+  merged_sketch.Merge(QuantileSketch{});
+  merged_sketch.Merge(small_values_sketch);
+  EXPECT_EQ(merged_sketch.count(), values.size());
+  EXPECT_EQ(merged_sketch.min(), *std::min_element(values.begin(), values.end()));
+  EXPECT_EQ(merged_sketch.max(), *std::max_element(values.begin(), values.end()));
+  ExpectQuantilesWithinRelativeAccuracy(merged_sketch, values);
+}
+
+TEST(QuantileSketch, HandlesExtremeValues) {
+  QuantileSketch sketch;
+  sketch.Add(1);
+  sketch.Add(std::numeric_limits<uint64_t>::max());
+  EXPECT_EQ(sketch.GetQuantile(0.0), 1);
+  EXPECT_EQ(sketch.GetQuantile(1.0), std::numeric_limits<uint64_t>::max());
+}
+
+}  // namespace orbit_statistics
@@ -0,0 +1,64 @@
+// Copyright (c) 2023 The Orbit Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef STATISTICS_QUANTILE_SKETCH_H_
+#define STATISTICS_QUANTILE_SKETCH_H_
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace orbit_statistics {
+
+// A mergeable sketch of a data set of `uint64_t` values that answers quantile queries with a
+// bounded relative error (DDSketch, Masson et al., 2019). Values are counted in buckets whose
+// boundaries grow geometrically, so the memory used only depends on the ratio between the largest
+// and the smallest value, not on the number of values: a few kilobytes cover nanoseconds to hours
+// with a 1% relative error.
+class QuantileSketch {
+ public:
+  static constexpr double kDefaultRelativeAccuracy = 0.01;
+
+  // `relative_accuracy` must be in (0, 1).
+  explicit QuantileSketch(double relative_accuracy = kDefaultRelativeAccuracy);
+
+  void Add(uint64_t value);
+  // Both sketches must have the same relative accuracy.
+  void Merge(const QuantileSketch& other);
+
+  // Returns a value within `relative_accuracy` of the `quantile`-quantile of the values added so
+  // far, with `quantile` in [0, 1]: the value at index floor(quantile * (count - 1)) of the sorted
+  // values. Returns std::nullopt if the sketch is empty.
+  [[nodiscard]] std::optional<uint64_t> GetQuantile(double quantile) const;
+
+  [[nodiscard]] uint64_t count() const { return count_; }
+  [[nodiscard]] uint64_t min() const { return min_; }
+  [[nodiscard]] uint64_t max() const { return max_; }
+  [[nodiscard]] double relative_accuracy() const { return relative_accuracy_; }
+
+ private:
+  [[nodiscard]] int32_t ValueToBucketIndex(uint64_t value) const;
+  [[nodiscard]] uint64_t BucketIndexToValue(int32_t index) const;
+  void AddToBucket(int32_t index, uint64_t count);
+
+  double relative_accuracy_;
+  double gamma_;
+  double log_gamma_;
+
+  // Count of the zero values, which don't fit in any geometric bucket.
+  uint64_t zero_count_ = 0;
+  // bucket_counts_[i] is the count of the bucket with index `first_bucket_index_ + i`, which holds
+  // the values in (gamma^(index-1), gamma^index].
+  std::vector<uint64_t> bucket_counts_;
+  int32_t first_bucket_index_ = 0;
+
+  uint64_t count_ = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = std::numeric_limits<uint64_t>::min();
+};
+
+}  // namespace orbit_statistics
+
+#endif  // STATISTICS_QUANTILE_SKETCH_H_
@@ -82,7 +82,11 @@ class LockFreeUserSpaceInstrumentationEventProducer
     : public orbit_capture_event_producer::LockFreeBufferCaptureEventProducer<
           FunctionEntryExitVariant> {
  public:
-  LockFreeUserSpaceInstrumentationEventProducer() {
+  // Events are buffered per thread and never dropped, so that FunctionEntry and FunctionExit events
+  // always come in pairs.
+  LockFreeUserSpaceInstrumentationEventProducer()
+      : LockFreeBufferCaptureEventProducer{
+            orbit_capture_event_producer::PerThreadRingBufferOptions{}} {
     BuildAndStart(orbit_producer_side_channel::CreateProducerSideChannel());
   }
 
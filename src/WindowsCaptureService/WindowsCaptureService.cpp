@@ -24,7 +24,7 @@ using orbit_grpc_protos::CaptureRequest;
 using orbit_grpc_protos::CaptureResponse;
 
 grpc::Status WindowsCaptureService::Capture(
-    grpc::ServerContext*,
+    grpc::ServerContext* context,
     grpc::ServerReaderWriter<CaptureResponse, CaptureRequest>* reader_writer) {
   orbit_base::SetCurrentThreadName("WinCS::Capture");
 
@@ -44,6 +44,8 @@ grpc::Status WindowsCaptureService::Capture(
       grpc_start_stop_capture_request_waiter{reader_writer};
   const CaptureOptions& capture_options =
       grpc_start_stop_capture_request_waiter.WaitForStartCaptureRequest();
+  orbit_producer_event_processor::GrpcClientCaptureEventCollector::SetUpCompression(
+      context, capture_options);
 
   if (capture_options.enable_api()) {
     EnableApiInTracee(capture_options);